@@ -201,6 +201,14 @@ class MS_API Model {
   /// \return The vector of output MSTensor.
   inline std::vector<MSTensor> GetOutputsByNodeName(const std::string &node_name);
 
+  /// \brief Obtains the activation arena size planned at Build. Only valid for Lite.
+  ///
+  /// \param[out] planned_size Define bytes of the arena shared by all planned tensors.
+  /// \param[out] naive_size Define bytes needed if every planned tensor had its own memory.
+  ///
+  /// \return Status, kLiteNotSupport if the graph is not statically planned.
+  Status GetMemoryPlanInfo(size_t *planned_size, size_t *naive_size) const;
+
   /// \brief Bind GLTexture2D object to cl Memory.
   ///
   /// \param[in] inputGlTexture The input GLTexture id for Model.
@@ -0,0 +1,85 @@
+/**
+ * Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+ * Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "backend/kernel_compiler/cpu/allreduce_cpu_kernel.h"
+#include <map>
+#include "runtime/hardware/cpu/ms_collective_comm_lib.h"
+#include "utils/ms_utils.h"
+
+namespace luojianet_ms {
+namespace kernel {
+namespace {
+using device::cpu::MsCollectiveCommLib;
+constexpr size_t kAllReduceInputsNum = 1;
+constexpr size_t kAllReduceOutputsNum = 1;
+constexpr auto kAttrOp = "op";
+constexpr auto kAttrGroup = "group";
+// The default world groups of the front end, which stand for the global group of the host library on CPU.
+constexpr auto kHcclWorldGroup = "hccl_world_group";
+constexpr auto kNcclWorldGroup = "nccl_world_group";
+
+const std::map<std::string, device::CollectiveOpReduceType> kReduceOpMap = {
+  {"sum", device::CollectiveOpReduceType::Reduce_Sum},
+  {"max", device::CollectiveOpReduceType::Reduce_Max},
+  {"min", device::CollectiveOpReduceType::Reduce_Min},
+  {"prod", device::CollectiveOpReduceType::Reduce_Prod}};
+}  // namespace
+
+void AllReduceCPUKernel::InitKernel(const CNodePtr &kernel_node) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  kernel_name_ = AnfAlgo::GetCNodeName(kernel_node);
+  if (common::CheckUseMPI()) {
+    MS_LOG(EXCEPTION) << "For '" << kernel_name_
+                      << "', the CPU kernel runs on the LuoJiaNet collective communication library, "
+                         "but this process is launched by OpenMPI.";
+  }
+  size_t input_num = AnfAlgo::GetInputTensorNum(kernel_node);
+  CHECK_KERNEL_INPUTS_NUM(input_num, kAllReduceInputsNum, kernel_name_);
+  dtype_ = AnfAlgo::GetInputDeviceDataType(kernel_node, 0);
+
+  auto op = AnfAlgo::GetNodeAttr<std::string>(kernel_node, kAttrOp);
+  auto iter = kReduceOpMap.find(op);
+  if (iter == kReduceOpMap.end()) {
+    MS_LOG(EXCEPTION) << "For '" << kernel_name_ << "', the 'op' should be one of sum, max, min and prod, but got "
+                      << op;
+  }
+  reduce_op_ = iter->second;
+
+  group_name_ = AnfAlgo::GetNodeAttr<std::string>(kernel_node, kAttrGroup);
+  if (group_name_.empty() || group_name_ == kHcclWorldGroup || group_name_ == kNcclWorldGroup) {
+    group_name_ = MsCollectiveCommLib::GetInstance().global_group_name();
+  }
+}
+
+bool AllReduceCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs, const std::vector<kernel::AddressPtr> &,
+                                const std::vector<kernel::AddressPtr> &outputs) {
+  CHECK_KERNEL_INPUTS_NUM(inputs.size(), kAllReduceInputsNum, kernel_name_);
+  CHECK_KERNEL_OUTPUTS_NUM(outputs.size(), kAllReduceOutputsNum, kernel_name_);
+  auto type_size = GetTypeByte(TypeIdToType(dtype_));
+  if (type_size == 0) {
+    MS_LOG(ERROR) << "For '" << kernel_name_ << "', the data type " << TypeIdLabel(dtype_) << " is invalid.";
+    return false;
+  }
+  size_t count = inputs[0]->size / type_size;
+  if (count == 0) {
+    return true;
+  }
+  return MsCollectiveCommLib::GetInstance().AllReduce(inputs[0]->addr, outputs[0]->addr, count, dtype_, reduce_op_,
+                                                      group_name_);
+}
+}  // namespace kernel
+}  // namespace luojianet_ms
@@ -0,0 +1,56 @@
+/**
+ * Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+ * Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LUOJIANET_MS_CCSRC_BACKEND_KERNEL_COMPILER_CPU_ALLREDUCE_CPU_KERNEL_H_
+#define LUOJIANET_MS_CCSRC_BACKEND_KERNEL_COMPILER_CPU_ALLREDUCE_CPU_KERNEL_H_
+
+#include <vector>
+#include <string>
+#include "backend/kernel_compiler/cpu/cpu_kernel.h"
+#include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
+#include "runtime/hardware/collective/collective_communication_lib.h"
+
+namespace luojianet_ms {
+namespace kernel {
+// AllReduce on the host, which runs the ring AllReduce of the LuoJiaNet collective communication library over the
+// cluster built by distributed::Initialize. Processes launched by OpenMPI are not supported.
+class AllReduceCPUKernel : public CPUKernel {
+ public:
+  AllReduceCPUKernel() = default;
+  ~AllReduceCPUKernel() override = default;
+
+  void InitKernel(const CNodePtr &kernel_node) override;
+
+  bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
+              const std::vector<AddressPtr> &outputs) override;
+
+ private:
+  TypeId dtype_{kNumberTypeFloat32};
+  device::CollectiveOpReduceType reduce_op_{device::CollectiveOpReduceType::Reduce_Sum};
+  std::string group_name_;
+};
+
+MS_REG_CPU_KERNEL(AllReduce, KernelAttr().AddInputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat32),
+                  AllReduceCPUKernel);
+MS_REG_CPU_KERNEL(AllReduce, KernelAttr().AddInputAttr(kNumberTypeFloat16).AddOutputAttr(kNumberTypeFloat16),
+                  AllReduceCPUKernel);
+MS_REG_CPU_KERNEL(AllReduce, KernelAttr().AddInputAttr(kNumberTypeInt32).AddOutputAttr(kNumberTypeInt32),
+                  AllReduceCPUKernel);
+}  // namespace kernel
+}  // namespace luojianet_ms
+
+#endif  // LUOJIANET_MS_CCSRC_BACKEND_KERNEL_COMPILER_CPU_ALLREDUCE_CPU_KERNEL_H_
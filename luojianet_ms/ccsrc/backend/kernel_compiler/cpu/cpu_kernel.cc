@@ -188,10 +188,11 @@ ActorThreadPool *GetActorMgrInnerThreadPool() {
 // Use threadpool of mindrt
 void ParallelLaunch(const CTask &task, size_t count, float block_size, Content content) {
   auto thread_pool = GetActorMgrInnerThreadPool();
-  size_t kernel_thread_num = thread_pool->GetKernelThreadNum();
-  if (kernel_thread_num == 0) {
+  if (thread_pool->GetKernelThreadNum() == 0) {
     MS_LOG(EXCEPTION) << "Actor inner pool has been init, but kernel thread is 0!";
   }
+  // Kernel actors running in parallel branches may only own a part of the kernel threads.
+  size_t kernel_thread_num = thread_pool->GetKernelThreadNumOfCurrentThread();
 
   size_t thread_num = count < block_size * kernel_thread_num ? std::ceil(count / block_size) : kernel_thread_num;
   size_t once_compute_size = (count + thread_num - 1) / thread_num;
@@ -238,6 +239,67 @@ void ParallelLaunchAutoSearch(const CTask &task, size_t count, Content content,
   }
 }
 
+void SortKeyUtils::ParallelSort(uint64_t *keys, uint64_t *buffer, size_t size) {
+  MS_EXCEPTION_IF_NULL(keys);
+  MS_EXCEPTION_IF_NULL(buffer);
+  size_t block_num = GetActorMgrInnerThreadPool()->GetKernelThreadNumOfCurrentThread();
+  block_num = std::max<size_t>(1, std::min(block_num, size));
+  auto block_begin = [size, block_num](size_t block) { return size * block / block_num; };
+  auto sort_task = [keys, &block_begin](size_t start, size_t end) {
+    for (size_t i = start; i < end; ++i) {
+      std::sort(keys + block_begin(i), keys + block_begin(i + 1));
+    }
+  };
+  ParallelLaunch(sort_task, block_num, 1);
+
+  // Each round merges the neighbouring runs of width blocks into the other array.
+  uint64_t *src = keys;
+  uint64_t *dst = buffer;
+  for (size_t width = 1; width < block_num; width *= 2) {
+    size_t run_width = width * 2;
+    auto merge_task = [src, dst, width, run_width, block_num, &block_begin](size_t start, size_t end) {
+      for (size_t i = start; i < end; ++i) {
+        size_t first = block_begin(i * run_width);
+        size_t middle = block_begin(std::min(i * run_width + width, block_num));
+        size_t last = block_begin(std::min((i + 1) * run_width, block_num));
+        (void)std::merge(src + first, src + middle, src + middle, src + last, dst + first);
+      }
+    };
+    ParallelLaunch(merge_task, (block_num + run_width - 1) / run_width, 1);
+    std::swap(src, dst);
+  }
+  if (src != keys) {
+    auto copy_task = [src, keys, &block_begin](size_t start, size_t end) {
+      (void)std::copy(src + block_begin(start), src + block_begin(end), keys + block_begin(start));
+    };
+    ParallelLaunch(copy_task, block_num, 1);
+  }
+}
+
+void SortKeyUtils::ParallelSelect(uint64_t *keys, uint64_t *buffer, size_t size, size_t k) {
+  MS_EXCEPTION_IF_NULL(keys);
+  MS_EXCEPTION_IF_NULL(buffer);
+  k = std::min(k, size);
+  size_t block_num = GetActorMgrInnerThreadPool()->GetKernelThreadNumOfCurrentThread();
+  // Every block holds k keys at least.
+  block_num = std::min(block_num, k == 0 ? size : size / k);
+  if (block_num <= 1) {
+    (void)std::copy(keys, keys + size, buffer);
+    std::nth_element(buffer, buffer + k, buffer + size);
+    return;
+  }
+  auto block_begin = [size, block_num](size_t block) { return size * block / block_num; };
+  auto select_task = [keys, buffer, k, &block_begin](size_t start, size_t end) {
+    for (size_t i = start; i < end; ++i) {
+      uint64_t *block = keys + block_begin(i);
+      std::nth_element(block, block + k, keys + block_begin(i + 1));
+      (void)std::copy(block, block + k, buffer + i * k);
+    }
+  };
+  ParallelLaunch(select_task, block_num, 1);
+  std::nth_element(buffer, buffer + k, buffer + block_num * k);
+}
+
 std::vector<size_t> CPUKernelUtils::FlatShapeByAxis(const std::vector<size_t> &shape, int axis) {
   if (axis < 0) {
     axis = axis + SizeToInt(shape.size());
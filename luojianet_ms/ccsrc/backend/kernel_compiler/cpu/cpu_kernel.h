@@ -18,6 +18,8 @@
 #ifndef LUOJIANET_MS_CCSRC_BACKEND_KERNEL_COMPILER_CPU_CPU_KERNEL_H_
 #define LUOJIANET_MS_CCSRC_BACKEND_KERNEL_COMPILER_CPU_CPU_KERNEL_H_
 
+#include <cstdint>
+#include <cstring>
 #include <functional>
 #include <memory>
 #include <numeric>
@@ -223,6 +225,38 @@ class TransposeIterator {
   size_t pos_{0};
 };
 
+// The sort key packs the order preserving bits of value in the high half and the index in the low half, so sorting the
+// keys orders the values and keeps the equal values in index order as the stable sort does. The contiguous integer
+// keys are cheaper to compare and move than the indices compared through the input.
+class SortKeyUtils {
+ public:
+  static constexpr size_t kMaxIndex = UINT32_MAX;
+
+  template <typename T>
+  static inline uint64_t Pack(T value, size_t index, bool descending) {
+    float float_value = static_cast<float>(value);
+    // The negative zero is equal to the positive zero in comparison.
+    float_value = float_value == 0.0f ? 0.0f : float_value;
+    uint32_t bits;
+    (void)memcpy(&bits, &float_value, sizeof(bits));
+    bits = (bits & kSignBit) != 0 ? ~bits : (bits | kSignBit);
+    bits = descending ? ~bits : bits;
+    return (static_cast<uint64_t>(bits) << kIndexBits) | static_cast<uint32_t>(index);
+  }
+  static inline size_t Index(uint64_t key) { return static_cast<size_t>(static_cast<uint32_t>(key)); }
+
+  // Sort the blocks of keys with the kernel threads, then merge the sorted blocks pairwise, and the buffer holds the
+  // same size as keys.
+  static void ParallelSort(uint64_t *keys, uint64_t *buffer, size_t size);
+  // Move the smallest k keys to the front of buffer in any order. Every block selects its own smallest k keys with the
+  // kernel threads, which must contain the smallest k keys of all, and the buffer holds the same size as keys.
+  static void ParallelSelect(uint64_t *keys, uint64_t *buffer, size_t size, size_t k);
+
+ private:
+  static constexpr uint32_t kSignBit = 0x80000000U;
+  static constexpr size_t kIndexBits = 32;
+};
+
 ActorThreadPool *GetActorMgrInnerThreadPool();
 void ParallelLaunch(const CTask &task, size_t count, float block_size = 128.0, Content content = nullptr);
 void ParallelLaunchAutoSearch(const CTask &task, size_t count, Content content,
@@ -0,0 +1,132 @@
+/**
+ * Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+ * Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "backend/kernel_compiler/cpu/group_norm_cpu_kernel.h"
+#include <algorithm>
+#include <cmath>
+#include "backend/kernel_compiler/common_utils.h"
+#include "runtime/device/cpu/cpu_device_address.h"
+
+namespace luojianet_ms {
+namespace kernel {
+namespace {
+constexpr size_t kGroupNormInputsNum = 3;
+constexpr size_t kGroupNormOutputsNum = 3;
+constexpr size_t kGroupNormMinDim = 2;
+}  // namespace
+
+void GroupNormCPUKernel::InitKernel(const CNodePtr &kernel_node) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  kernel_name_ = AnfAlgo::GetCNodeName(kernel_node);
+  dtype_ = AnfAlgo::GetInputDeviceDataType(kernel_node, 0);
+  std::vector<size_t> x_shape = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 0);
+  auto num_groups = AnfAlgo::GetNodeAttr<int64_t>(kernel_node, "num_groups");
+  eps_ = AnfAlgo::GetNodeAttr<float>(kernel_node, "epsilon");
+  if (x_shape.size() < kGroupNormMinDim) {
+    MS_LOG(EXCEPTION) << "For '" << kernel_name_ << "', the dimension of 'input_x' should be at least 2, but got "
+                      << Vector2Str(x_shape);
+  }
+  batch_ = x_shape[0];
+  channel_ = x_shape[1];
+  for (size_t i = kGroupNormMinDim; i < x_shape.size(); i++) {
+    spatial_size_ *= x_shape[i];
+  }
+  if (num_groups <= 0 || channel_ % LongToSize(num_groups) != 0) {
+    MS_LOG(EXCEPTION) << "For '" << kernel_name_ << "', the channel of 'input_x' should be divided by 'num_groups', "
+                      << "but got channel: " << channel_ << ", num_groups: " << num_groups;
+  }
+  num_groups_ = LongToSize(num_groups);
+  channel_per_group_ = channel_ / num_groups_;
+  if (batch_ == 0 || spatial_size_ == 0) {
+    MS_LOG(EXCEPTION) << "For '" << kernel_name_ << "', the shape of 'input_x' should not be empty, but got "
+                      << Vector2Str(x_shape);
+  }
+}
+
+bool GroupNormCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs, const std::vector<kernel::AddressPtr> &,
+                                const std::vector<kernel::AddressPtr> &outputs) {
+  CHECK_KERNEL_INPUTS_NUM(inputs.size(), kGroupNormInputsNum, kernel_name_);
+  CHECK_KERNEL_OUTPUTS_NUM(outputs.size(), kGroupNormOutputsNum, kernel_name_);
+  if (dtype_ == kNumberTypeFloat16) {
+    LaunchKernel<float16>(inputs, outputs);
+  } else if (dtype_ == kNumberTypeFloat32) {
+    LaunchKernel<float>(inputs, outputs);
+  } else {
+    MS_LOG(EXCEPTION) << "For '" << kernel_name_ << "', the dtype of 'input_x' should be float16 or float32, but got "
+                      << dtype_;
+  }
+  return true;
+}
+
+template <typename T>
+void GroupNormCPUKernel::LaunchKernel(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &outputs) {
+  size_t f_size = sizeof(T);
+  if (inputs[1]->size != f_size * channel_ || inputs[2]->size != f_size * channel_) {
+    MS_LOG(EXCEPTION) << "For '" << kernel_name_ << "', the product of gamma and beta's shape must be " << channel_;
+  }
+  size_t group_num = batch_ * num_groups_;
+  if (outputs[1]->size != f_size * group_num || outputs[2]->size != f_size * group_num) {
+    MS_LOG(EXCEPTION) << "For '" << kernel_name_ << "', the product of mean and var's shape must be " << group_num;
+  }
+  const auto *x = reinterpret_cast<T *>(inputs[0]->addr);
+  const auto *gamma = reinterpret_cast<T *>(inputs[1]->addr);
+  const auto *beta = reinterpret_cast<T *>(inputs[2]->addr);
+  auto *y = reinterpret_cast<T *>(outputs[0]->addr);
+  auto *mean = reinterpret_cast<T *>(outputs[1]->addr);
+  auto *var = reinterpret_cast<T *>(outputs[2]->addr);
+  const size_t group_size = channel_per_group_ * spatial_size_;
+  // each group is contiguous in NCHW, one pass gathers its statistics and a second one applies the folded
+  // per channel scale and shift, so every element is read twice and written once
+  auto task = [this, x, gamma, beta, y, mean, var, group_size](size_t start, size_t end) {
+    for (size_t i = start; i < end; ++i) {
+      const T *group_x = x + i * group_size;
+      T *group_y = y + i * group_size;
+      double sum = 0.0;
+      double square_sum = 0.0;
+      for (size_t c = 0; c < channel_per_group_; ++c) {
+        const T *src = group_x + c * spatial_size_;
+        float channel_sum = 0.0f;
+        float channel_square_sum = 0.0f;
+        for (size_t j = 0; j < spatial_size_; ++j) {
+          auto value = static_cast<float>(src[j]);
+          channel_sum += value;
+          channel_square_sum += value * value;
+        }
+        sum += channel_sum;
+        square_sum += channel_square_sum;
+      }
+      double group_mean = sum / group_size;
+      double group_var = std::max(square_sum / group_size - group_mean * group_mean, 0.0);
+      auto rstd = static_cast<float>(1.0 / std::sqrt(group_var + eps_));
+      size_t channel_offset = (i % num_groups_) * channel_per_group_;
+      for (size_t c = 0; c < channel_per_group_; ++c) {
+        auto scale = rstd * static_cast<float>(gamma[channel_offset + c]);
+        auto shift = static_cast<float>(beta[channel_offset + c]) - static_cast<float>(group_mean) * scale;
+        const T *src = group_x + c * spatial_size_;
+        T *dst = group_y + c * spatial_size_;
+        for (size_t j = 0; j < spatial_size_; ++j) {
+          dst[j] = static_cast<T>(static_cast<float>(src[j]) * scale + shift);
+        }
+      }
+      mean[i] = static_cast<T>(group_mean);
+      var[i] = static_cast<T>(group_var);
+    }
+  };
+  ParallelLaunchAutoSearch(task, group_num, this, &parallel_search_info_);
+}
+}  // namespace kernel
+}  // namespace luojianet_ms
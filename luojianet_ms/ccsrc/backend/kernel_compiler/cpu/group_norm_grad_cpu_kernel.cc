@@ -0,0 +1,167 @@
+/**
+ * Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+ * Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "backend/kernel_compiler/cpu/group_norm_grad_cpu_kernel.h"
+#include <cmath>
+#include "backend/kernel_compiler/common_utils.h"
+#include "runtime/device/cpu/cpu_device_address.h"
+
+namespace luojianet_ms {
+namespace kernel {
+namespace {
+constexpr size_t kGroupNormGradInputsNum = 5;
+constexpr size_t kGroupNormGradOutputsNum = 3;
+constexpr size_t kGroupNormGradWorkspaceNum = 2;
+constexpr size_t kGroupNormGradMinDim = 2;
+}  // namespace
+
+void GroupNormGradCPUKernel::InitKernel(const CNodePtr &kernel_node) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  kernel_name_ = AnfAlgo::GetCNodeName(kernel_node);
+  dtype_ = AnfAlgo::GetInputDeviceDataType(kernel_node, 0);
+  std::vector<size_t> x_shape = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 0);
+  auto num_groups = AnfAlgo::GetNodeAttr<int64_t>(kernel_node, "num_groups");
+  eps_ = AnfAlgo::GetNodeAttr<float>(kernel_node, "epsilon");
+  if (x_shape.size() < kGroupNormGradMinDim) {
+    MS_LOG(EXCEPTION) << "For '" << kernel_name_ << "', the dimension of 'input_x' should be at least 2, but got "
+                      << Vector2Str(x_shape);
+  }
+  batch_ = x_shape[0];
+  channel_ = x_shape[1];
+  for (size_t i = kGroupNormGradMinDim; i < x_shape.size(); i++) {
+    spatial_size_ *= x_shape[i];
+  }
+  if (num_groups <= 0 || channel_ % LongToSize(num_groups) != 0) {
+    MS_LOG(EXCEPTION) << "For '" << kernel_name_ << "', the channel of 'input_x' should be divided by 'num_groups', "
+                      << "but got channel: " << channel_ << ", num_groups: " << num_groups;
+  }
+  num_groups_ = LongToSize(num_groups);
+  channel_per_group_ = channel_ / num_groups_;
+  if (batch_ == 0 || spatial_size_ == 0) {
+    MS_LOG(EXCEPTION) << "For '" << kernel_name_ << "', the shape of 'input_x' should not be empty, but got "
+                      << Vector2Str(x_shape);
+  }
+}
+
+void GroupNormGradCPUKernel::InitInputOutputSize(const CNodePtr &kernel_node) {
+  CPUKernel::InitInputOutputSize(kernel_node);
+  // sum(dy * x) and sum(dy) of every (n, c), shared by dx and the parameter gradients
+  (void)workspace_size_list_.emplace_back(batch_ * channel_ * sizeof(float));
+  (void)workspace_size_list_.emplace_back(batch_ * channel_ * sizeof(float));
+}
+
+bool GroupNormGradCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
+                                    const std::vector<kernel::AddressPtr> &workspace,
+                                    const std::vector<kernel::AddressPtr> &outputs) {
+  CHECK_KERNEL_INPUTS_NUM(inputs.size(), kGroupNormGradInputsNum, kernel_name_);
+  CHECK_KERNEL_OUTPUTS_NUM(outputs.size(), kGroupNormGradOutputsNum, kernel_name_);
+  if (workspace.size() != kGroupNormGradWorkspaceNum) {
+    MS_LOG(EXCEPTION) << "For '" << kernel_name_ << "', the number of workspaces should be "
+                      << kGroupNormGradWorkspaceNum << ", but got " << workspace.size();
+  }
+  if (dtype_ == kNumberTypeFloat16) {
+    LaunchKernel<float16>(inputs, workspace, outputs);
+  } else if (dtype_ == kNumberTypeFloat32) {
+    LaunchKernel<float>(inputs, workspace, outputs);
+  } else {
+    MS_LOG(EXCEPTION) << "For '" << kernel_name_ << "', the dtype of 'input_x' should be float16 or float32, but got "
+                      << dtype_;
+  }
+  return true;
+}
+
+template <typename T>
+void GroupNormGradCPUKernel::LaunchKernel(const std::vector<AddressPtr> &inputs,
+                                          const std::vector<AddressPtr> &workspace,
+                                          const std::vector<AddressPtr> &outputs) {
+  const auto *x = reinterpret_cast<T *>(inputs[0]->addr);
+  const auto *dy = reinterpret_cast<T *>(inputs[1]->addr);
+  const auto *var = reinterpret_cast<T *>(inputs[2]->addr);
+  const auto *mean = reinterpret_cast<T *>(inputs[3]->addr);
+  const auto *gamma = reinterpret_cast<T *>(inputs[4]->addr);
+  auto *dx = reinterpret_cast<T *>(outputs[0]->addr);
+  auto *dg = reinterpret_cast<T *>(outputs[1]->addr);
+  auto *db = reinterpret_cast<T *>(outputs[2]->addr);
+  auto *ds_buf = reinterpret_cast<float *>(workspace[0]->addr);
+  auto *db_buf = reinterpret_cast<float *>(workspace[1]->addr);
+  const size_t group_size = channel_per_group_ * spatial_size_;
+
+  // dx = gamma * rstd * dy + a * x + b per group, where a and b only depend on the per channel sums of the group
+  auto task1 = [this, x, dy, var, mean, gamma, dx, ds_buf, db_buf, group_size](size_t start, size_t end) {
+    for (size_t i = start; i < end; ++i) {
+      const T *group_x = x + i * group_size;
+      const T *group_dy = dy + i * group_size;
+      size_t channel_offset = (i % num_groups_) * channel_per_group_;
+      float *group_ds = ds_buf + i * channel_per_group_;
+      float *group_db = db_buf + i * channel_per_group_;
+      double sum_dy_gamma = 0.0;
+      double sum_dyx_gamma = 0.0;
+      for (size_t c = 0; c < channel_per_group_; ++c) {
+        const T *src_x = group_x + c * spatial_size_;
+        const T *src_dy = group_dy + c * spatial_size_;
+        float ds = 0.0f;
+        float dsum = 0.0f;
+        for (size_t j = 0; j < spatial_size_; ++j) {
+          auto dy_value = static_cast<float>(src_dy[j]);
+          ds += dy_value * static_cast<float>(src_x[j]);
+          dsum += dy_value;
+        }
+        group_ds[c] = ds;
+        group_db[c] = dsum;
+        auto g = static_cast<double>(gamma[channel_offset + c]);
+        sum_dyx_gamma += g * ds;
+        sum_dy_gamma += g * dsum;
+      }
+      auto group_mean = static_cast<double>(mean[i]);
+      double rstd = 1.0 / std::sqrt(static_cast<double>(var[i]) + eps_);
+      double a = (sum_dy_gamma * group_mean - sum_dyx_gamma) * rstd * rstd * rstd / group_size;
+      auto b = static_cast<float>(-a * group_mean - sum_dy_gamma * rstd / group_size);
+      auto a_f = static_cast<float>(a);
+      for (size_t c = 0; c < channel_per_group_; ++c) {
+        auto scale = static_cast<float>(rstd) * static_cast<float>(gamma[channel_offset + c]);
+        const T *src_x = group_x + c * spatial_size_;
+        const T *src_dy = group_dy + c * spatial_size_;
+        T *dst = dx + i * group_size + c * spatial_size_;
+        for (size_t j = 0; j < spatial_size_; ++j) {
+          dst[j] = static_cast<T>(scale * static_cast<float>(src_dy[j]) + a_f * static_cast<float>(src_x[j]) + b);
+        }
+      }
+    }
+  };
+  ParallelLaunchAutoSearch(task1, batch_ * num_groups_, this, &parallel_search_info_);
+
+  // parameter gradients reduce the small (n, c) sums over the batch
+  auto task2 = [this, var, mean, dg, db, ds_buf, db_buf](size_t start, size_t end) {
+    for (size_t c = start; c < end; ++c) {
+      size_t group = c / channel_per_group_;
+      float dgamma = 0.0f;
+      float dbeta = 0.0f;
+      for (size_t n = 0; n < batch_; ++n) {
+        size_t stat_index = n * num_groups_ + group;
+        auto rstd = static_cast<float>(1.0 / std::sqrt(static_cast<double>(var[stat_index]) + eps_));
+        size_t index = n * channel_ + c;
+        dgamma += (ds_buf[index] - static_cast<float>(mean[stat_index]) * db_buf[index]) * rstd;
+        dbeta += db_buf[index];
+      }
+      dg[c] = static_cast<T>(dgamma);
+      db[c] = static_cast<T>(dbeta);
+    }
+  };
+  ParallelLaunchAutoSearch(task2, channel_, this, &param_search_info_);
+}
+}  // namespace kernel
+}  // namespace luojianet_ms
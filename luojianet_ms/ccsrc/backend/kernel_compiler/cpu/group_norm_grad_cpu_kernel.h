@@ -0,0 +1,59 @@
+/**
+ * Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+ * Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LUOJIANET_MS_CCSRC_BACKEND_KERNEL_COMPILER_CPU_GROUP_NORM_GRAD_CPU_KERNEL_H_
+#define LUOJIANET_MS_CCSRC_BACKEND_KERNEL_COMPILER_CPU_GROUP_NORM_GRAD_CPU_KERNEL_H_
+
+#include <memory>
+#include <vector>
+#include "backend/kernel_compiler/cpu/cpu_kernel.h"
+#include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
+
+namespace luojianet_ms {
+namespace kernel {
+class GroupNormGradCPUKernel : public CPUKernel {
+ public:
+  GroupNormGradCPUKernel() = default;
+  ~GroupNormGradCPUKernel() override = default;
+
+  void InitKernel(const CNodePtr &kernel_node) override;
+
+  bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
+              const std::vector<AddressPtr> &outputs) override;
+
+ private:
+  void InitInputOutputSize(const CNodePtr &kernel_node) override;
+
+  template <typename T>
+  void LaunchKernel(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
+                    const std::vector<AddressPtr> &outputs);
+
+  TypeId dtype_{kTypeUnknown};
+  float eps_{1e-5};
+  size_t batch_{1};
+  size_t channel_{1};
+  size_t num_groups_{1};
+  size_t channel_per_group_{1};
+  size_t spatial_size_{1};
+  // the parameter gradient pass runs over channels and tunes its block size apart from the dx pass
+  ParallelSearchInfo param_search_info_;
+};
+
+MS_REG_CPU_KERNEL(GroupNormGrad, KernelAttr(), GroupNormGradCPUKernel);
+}  // namespace kernel
+}  // namespace luojianet_ms
+#endif  // LUOJIANET_MS_CCSRC_BACKEND_KERNEL_COMPILER_CPU_GROUP_NORM_GRAD_CPU_KERNEL_H_
@@ -96,6 +96,10 @@ void Conv2dGradInputCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   }
   dnnl::memory::dims padding_l{int_padding_l[0], int_padding_l[1]};
   dnnl::memory::dims padding_r{int_padding_r[0], int_padding_r[1]};
+  if (IsBf16ComputeEnabled(kernel_node) &&
+      InitBf16Primitive(src_desc, weights_desc, dst_desc, strides, dilates, padding_l, padding_r)) {
+    return;
+  }
   dnnl::convolution_forward::desc forward_desc =
     dnnl::convolution_forward::desc(dnnl::prop_kind::forward_training, dnnl::algorithm::convolution_auto, src_desc,
                                     weights_desc, dst_desc, strides, dilates, padding_l, padding_r);
@@ -114,6 +118,35 @@ void Conv2dGradInputCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   AddArgument(DNNL_ARG_WEIGHTS, weights_desc);
 }
 
+bool Conv2dGradInputCPUKernel::InitBf16Primitive(const dnnl::memory::desc &src_desc,
+                                                 const dnnl::memory::desc &weights_desc,
+                                                 const dnnl::memory::desc &dst_desc, const dnnl::memory::dims &strides,
+                                                 const dnnl::memory::dims &dilates, const dnnl::memory::dims &padding_l,
+                                                 const dnnl::memory::dims &padding_r) {
+  try {
+    const auto &engine = MKLKernelEngine::Get().engine();
+    auto forward_desc = dnnl::convolution_forward::desc(
+      dnnl::prop_kind::forward_training, dnnl::algorithm::convolution_auto, Bf16MemDesc(src_desc),
+      Bf16MemDesc(weights_desc), Bf16MemDesc(dst_desc), strides, dilates, padding_l, padding_r);
+    auto forward_prim_desc = dnnl::convolution_forward::primitive_desc(forward_desc, engine);
+    auto backward_desc =
+      dnnl::convolution_backward_data::desc(dnnl::algorithm::convolution_auto, src_desc, Bf16MemDesc(weights_desc),
+                                            Bf16MemDesc(dst_desc), strides, dilates, padding_l, padding_r);
+    auto backward_prim_desc = dnnl::convolution_backward_data::primitive_desc(backward_desc, engine, forward_prim_desc);
+    if (!IsOptimizedImpl(backward_prim_desc)) {
+      return false;
+    }
+    primitive_ = std::make_shared<dnnl::convolution_backward_data>(backward_prim_desc);
+    AddArgument(DNNL_ARG_DIFF_SRC, src_desc);
+    AddBf16Argument(DNNL_ARG_DIFF_DST, dst_desc, backward_prim_desc.diff_dst_desc());
+    AddBf16Argument(DNNL_ARG_WEIGHTS, weights_desc, backward_prim_desc.weights_desc());
+  } catch (const dnnl::error &e) {
+    MS_LOG(INFO) << "Create bfloat16 " << kernel_name_ << " failed, use float32 instead: " << e.what();
+    return false;
+  }
+  return true;
+}
+
 bool Conv2dGradInputCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
                                       const std::vector<kernel::AddressPtr> &,
                                       const std::vector<kernel::AddressPtr> &outputs) {
@@ -33,6 +33,12 @@ class Conv2dGradInputCPUKernel : public MKLCPUKernel {
 
   bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
               const std::vector<AddressPtr> &outputs) override;
+
+ private:
+  bool InitBf16Primitive(const dnnl::memory::desc &src_desc, const dnnl::memory::desc &weights_desc,
+                         const dnnl::memory::desc &dst_desc, const dnnl::memory::dims &strides,
+                         const dnnl::memory::dims &dilates, const dnnl::memory::dims &padding_l,
+                         const dnnl::memory::dims &padding_r);
 };
 
 MS_REG_CPU_KERNEL(
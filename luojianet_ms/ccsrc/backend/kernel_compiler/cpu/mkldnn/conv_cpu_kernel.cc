@@ -104,6 +104,10 @@ void ConvCPUKernel::InitKernel(const CNodePtr &kernel_node) {
     (void)padding_l.emplace_back(int_padding_l[i]);
     (void)padding_r.emplace_back(int_padding_r[i]);
   }
+  if (IsBf16ComputeEnabled(kernel_node) &&
+      InitBf16Primitive(src_desc, weights_desc, dst_desc, strides, dilates, padding_l, padding_r)) {
+    return;
+  }
   dnnl::convolution_forward::desc desc =
     dnnl::convolution_forward::desc(dnnl::prop_kind::forward_training, dnnl::algorithm::convolution_auto, src_desc,
                                     weights_desc, dst_desc, strides, dilates, padding_l, padding_r);
@@ -115,6 +119,29 @@ void ConvCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   AddArgument(DNNL_ARG_DST, dst_desc);
 }
 
+bool ConvCPUKernel::InitBf16Primitive(const dnnl::memory::desc &src_desc, const dnnl::memory::desc &weights_desc,
+                                      const dnnl::memory::desc &dst_desc, const dnnl::memory::dims &strides,
+                                      const dnnl::memory::dims &dilates, const dnnl::memory::dims &padding_l,
+                                      const dnnl::memory::dims &padding_r) {
+  try {
+    auto desc = dnnl::convolution_forward::desc(dnnl::prop_kind::forward_training, dnnl::algorithm::convolution_auto,
+                                                Bf16MemDesc(src_desc), Bf16MemDesc(weights_desc), dst_desc, strides,
+                                                dilates, padding_l, padding_r);
+    auto prim_desc = dnnl::convolution_forward::primitive_desc(desc, MKLKernelEngine::Get().engine());
+    if (!IsOptimizedImpl(prim_desc)) {
+      return false;
+    }
+    primitive_ = std::make_shared<dnnl::convolution_forward>(prim_desc);
+    AddBf16Argument(DNNL_ARG_SRC, src_desc, prim_desc.src_desc());
+    AddBf16Argument(DNNL_ARG_WEIGHTS, weights_desc, prim_desc.weights_desc());
+    AddArgument(DNNL_ARG_DST, dst_desc);
+  } catch (const dnnl::error &e) {
+    MS_LOG(INFO) << "Create bfloat16 " << kernel_name_ << " failed, use float32 instead: " << e.what();
+    return false;
+  }
+  return true;
+}
+
 bool ConvCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs, const std::vector<kernel::AddressPtr> &,
                            const std::vector<kernel::AddressPtr> &outputs) {
   CHECK_KERNEL_INPUTS_NUM(inputs.size(), kConvInputsNum, kernel_name_);
@@ -81,6 +81,9 @@ void MatMulCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   dnnl::memory::desc src_md(src_dims, dnnl::memory::data_type::f32, a_strides);
   dnnl::memory::desc weights_md(weights_dims, dnnl::memory::data_type::f32, b_strides);
   dnnl::memory::desc dst_md(dst_dims, dnnl::memory::data_type::f32, o_strides);
+  if (IsBf16ComputeEnabled(kernel_node) && InitBf16Primitive(src_md, weights_md, dst_md)) {
+    return;
+  }
   dnnl::matmul::desc matmul_desc(src_md, weights_md, dst_md);
   dnnl::matmul::primitive_desc prim_desc(matmul_desc, MKLKernelEngine::Get().engine());
   primitive_ = std::make_shared<dnnl::matmul>(prim_desc);
@@ -90,6 +93,25 @@ void MatMulCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   AddArgument(DNNL_ARG_DST, dst_md);
 }
 
+bool MatMulCPUKernel::InitBf16Primitive(const dnnl::memory::desc &src_desc, const dnnl::memory::desc &weights_desc,
+                                        const dnnl::memory::desc &dst_desc) {
+  try {
+    dnnl::matmul::desc matmul_desc(Bf16MemDesc(src_desc), Bf16MemDesc(weights_desc), dst_desc);
+    dnnl::matmul::primitive_desc prim_desc(matmul_desc, MKLKernelEngine::Get().engine());
+    if (!IsOptimizedImpl(prim_desc)) {
+      return false;
+    }
+    primitive_ = std::make_shared<dnnl::matmul>(prim_desc);
+    AddBf16Argument(DNNL_ARG_SRC, src_desc, prim_desc.src_desc());
+    AddBf16Argument(DNNL_ARG_WEIGHTS, weights_desc, prim_desc.weights_desc());
+    AddArgument(DNNL_ARG_DST, dst_desc);
+  } catch (const dnnl::error &e) {
+    MS_LOG(INFO) << "Create bfloat16 " << kernel_name_ << " failed, use float32 instead: " << e.what();
+    return false;
+  }
+  return true;
+}
+
 bool MatMulCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs, const std::vector<kernel::AddressPtr> &,
                              const std::vector<kernel::AddressPtr> &outputs) {
   CHECK_KERNEL_INPUTS_NUM(inputs.size(), kMatMulInputsNum, kernel_name_);
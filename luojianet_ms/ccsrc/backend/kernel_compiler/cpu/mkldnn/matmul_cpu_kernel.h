@@ -33,6 +33,10 @@ class MatMulCPUKernel : public MKLCPUKernel {
 
   bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
               const std::vector<AddressPtr> &outputs) override;
+
+ private:
+  bool InitBf16Primitive(const dnnl::memory::desc &src_desc, const dnnl::memory::desc &weights_desc,
+                         const dnnl::memory::desc &dst_desc);
 };
 MS_REG_CPU_KERNEL(
   MatMul,
@@ -144,13 +144,43 @@ void MKLCPUKernel::AddArgument(int arg_key, const dnnl::memory::desc &mem_desc,
 }
 
 void MKLCPUKernel::SetArgumentHandle(int arg_key, void *ptr) {
+  auto src_iter = bf16_sources_.find(arg_key);
+  if (src_iter != bf16_sources_.end()) {
+    src_iter->second.set_data_handle(ptr);
+    return;
+  }
   auto arg_iter = arguments_.find(arg_key);
   if (arg_iter != arguments_.end()) {
     arg_iter->second.set_data_handle(ptr);
   }
 }
 
-void MKLCPUKernel::ExecutePrimitive() { MKLKernelEngine::Get().Execute(primitive_, arguments_); }
+void MKLCPUKernel::ExecutePrimitive() {
+  for (auto &src : bf16_sources_) {
+    Reorder(&src.second, &arguments_[src.first]);
+  }
+  MKLKernelEngine::Get().Execute(primitive_, arguments_);
+}
+
+bool MKLCPUKernel::IsBf16ComputeEnabled(const CNodePtr &kernel_node) const {
+  return AnfAlgo::HasNodeAttr(kAttrCpuBf16, kernel_node) && AnfAlgo::GetNodeAttr<bool>(kernel_node, kAttrCpuBf16);
+}
+
+dnnl::memory::desc MKLCPUKernel::Bf16MemDesc(const dnnl::memory::desc &desc) const {
+  return dnnl::memory::desc(desc.dims(), dnnl::memory::data_type::bf16, dnnl::memory::format_tag::any);
+}
+
+bool MKLCPUKernel::IsOptimizedImpl(const dnnl::primitive_desc_base &prim_desc) const {
+  std::string impl = prim_desc.impl_info_str();
+  MS_LOG(INFO) << "bfloat16 implementation of " << kernel_name_ << ": " << impl;
+  return impl.rfind("ref", 0) != 0;
+}
+
+void MKLCPUKernel::AddBf16Argument(int arg_key, const dnnl::memory::desc &f32_desc,
+                                   const dnnl::memory::desc &bf16_desc) {
+  bf16_sources_[arg_key] = MKLKernelEngine::Get().CreateMemory(f32_desc);
+  AddArgument(arg_key, bf16_desc, true);
+}
 
 void MKLCPUKernel::Reorder(dnnl::memory *src_mem, dnnl::memory *dst_mem) {
   MKLKernelEngine::Get().Reorder(src_mem, dst_mem);
@@ -49,7 +49,18 @@ class MKLCPUKernel : public CPUKernel {
   }
   void Reorder(dnnl::memory *src_mem, dnnl::memory *dst_mem);
 
+  // bfloat16 compute keeps float32 inputs, outputs and accumulation, only the operands are rounded to bfloat16.
+  // It is enabled per node by the cpu_bf16 attr, which the O1 amp level sets on the primitives of the network.
+  bool IsBf16ComputeEnabled(const CNodePtr &kernel_node) const;
+  // bfloat16 desc with the dims of desc and the layout left to the primitive
+  dnnl::memory::desc Bf16MemDesc(const dnnl::memory::desc &desc) const;
+  // Reference implementations of bfloat16 primitives are slower than the float32 ones, callers fall back on them.
+  bool IsOptimizedImpl(const dnnl::primitive_desc_base &prim_desc) const;
+  // The float32 buffer bound to arg_key at launch is reordered into a bfloat16 buffer of bf16_desc before execution.
+  void AddBf16Argument(int arg_key, const dnnl::memory::desc &f32_desc, const dnnl::memory::desc &bf16_desc);
+
   std::unordered_map<int, dnnl::memory> arguments_;
+  std::unordered_map<int, dnnl::memory> bf16_sources_;
   std::shared_ptr<dnnl::primitive> primitive_{nullptr};
 };
 }  // namespace kernel
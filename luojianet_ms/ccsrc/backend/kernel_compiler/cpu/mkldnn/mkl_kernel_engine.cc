@@ -16,6 +16,10 @@
  */
 
 #include "backend/kernel_compiler/cpu/mkldnn/mkl_kernel_engine.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include "backend/kernel_compiler/cpu/cpu_kernel.h"
 #include "utils/log_adapter.h"
 #include "dnnl.hpp"
 
@@ -24,8 +28,24 @@ namespace kernel {
 void MKLKernelEngine::Execute(const std::shared_ptr<dnnl::primitive> &primitive,
                               const std::unordered_map<int, dnnl::memory> &arguments) {
   MS_EXCEPTION_IF_NULL(primitive);
+#ifdef _OPENMP
+  // The kernel of parallel branches only owns a part of the kernel threads, and its omp team is shrunk to the same.
+  auto thread_pool = GetActorMgrInnerThreadPool();
+  auto thread_num = thread_pool->GetKernelThreadNumOfCurrentThread();
+  auto max_thread_num = omp_get_max_threads();
+  bool limit_threads = thread_num < thread_pool->GetKernelThreadNum() && SizeToInt(thread_num) < max_thread_num;
+  if (limit_threads) {
+    omp_set_num_threads(SizeToInt(thread_num));
+  }
+  primitive->execute(stream_, arguments);
+  (void)stream_.wait();
+  if (limit_threads) {
+    omp_set_num_threads(max_thread_num);
+  }
+#else
   primitive->execute(stream_, arguments);
   (void)stream_.wait();
+#endif
 }
 
 dnnl::memory MKLKernelEngine::CreateMemory(const dnnl::memory::desc &mem_desc, bool alloc) {
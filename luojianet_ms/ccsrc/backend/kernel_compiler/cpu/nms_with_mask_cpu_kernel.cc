@@ -16,184 +16,170 @@
  */
 
 #include "backend/kernel_compiler/cpu/nms_with_mask_cpu_kernel.h"
+#include <cmath>
+#include "backend/kernel_compiler/cpu/nnacl/fp32/nms_fp32.h"
 #include "runtime/device/cpu/cpu_device_address.h"
 
 namespace luojianet_ms {
 namespace kernel {
-uint32_t NmsRoundUpPower2(int v) {
-  constexpr uint32_t ONE = 1, TWO = 2, FOUR = 4, EIGHT = 8, SIXTEEN = 16;
-  v--;
-  uint32_t value = IntToUint(v);
-  value |= value >> ONE;
-  value |= value >> TWO;
-  value |= value >> FOUR;
-  value |= value >> EIGHT;
-  value |= value >> SIXTEEN;
-  value++;
-  return value;
-}
-
-template <typename T>
-void Swap(T *lhs, T *rhs) {
-  T tmp = lhs[0];
-  lhs[0] = rhs[0];
-  rhs[0] = tmp;
-}
-
-// Sorting function based on BitonicSort from TopK kernel
-template <typename T>
-void NMSWithMaskCPUKernel<T>::NmsBitonicSortByKeyKernel(const int inner, const size_t ceil_power2, const T *input,
-                                                        T *data_buff, int *index_buff, int box_size) {
-  auto task1 = [this, &data_buff, &index_buff, &input, inner, box_size](int start, int end) {
-    for (int i = start; i < end; i++) {
-      data_buff[i] = (i < inner) ? input[(i * box_size) + 4] : std::numeric_limits<T>::max();
-      index_buff[i] = i;
-    }
-  };
-  ParallelLaunchAutoSearch(task1, ceil_power2, this, &parallel_search_info_);
-
-  for (size_t i = 2; i <= ceil_power2; i <<= 1) {
-    for (size_t j = (i >> 1); j > 0; j >>= 1) {
-      auto task2 = [&](size_t start, size_t end) {
-        for (size_t tid = start; tid < end; tid++) {
-          size_t tid_comp = tid ^ j;
-          if (tid_comp > tid) {
-            if ((tid & i) == 0) {
-              if (data_buff[tid] > data_buff[tid_comp]) {
-                Swap(&data_buff[tid], &data_buff[tid_comp]);
-                Swap(&index_buff[tid], &index_buff[tid_comp]);
-              }
-            } else {
-              if (data_buff[tid] < data_buff[tid_comp]) {
-                Swap(&data_buff[tid], &data_buff[tid_comp]);
-                Swap(&index_buff[tid], &index_buff[tid_comp]);
-              }
-            }
-          }
+namespace {
+constexpr size_t kNmsGridMaxDim = 64;
+constexpr size_t kNmsBatchedRank = 3;
+
+// kept boxes bucketed by the grid cells they cover, so a candidate only meets kept boxes lying near it.
+// boxes are stored per coordinate to let NmsOverlapped compare one candidate against a cell in simd lanes.
+class NmsGrid {
+ public:
+  NmsGrid(float min_x, float min_y, float cell_w, float cell_h, size_t cols, size_t rows)
+      : min_x_(min_x), min_y_(min_y), cell_w_(cell_w), cell_h_(cell_h), cols_(cols), rows_(rows), cells_(cols * rows) {}
+  ~NmsGrid() = default;
+
+  bool Overlapped(const float *box, float area, float iou_threshold) const {
+    size_t col_begin, col_end, row_begin, row_end;
+    CellRange(box, &col_begin, &col_end, &row_begin, &row_end);
+    for (size_t row = row_begin; row <= row_end; ++row) {
+      for (size_t col = col_begin; col <= col_end; ++col) {
+        const auto &cell = cells_[row * cols_ + col];
+        if (!cell.area.empty() && NmsOverlapped(cell.x0.data(), cell.y0.data(), cell.x1.data(), cell.y1.data(),
+                                                cell.area.data(), SizeToInt(cell.area.size()), box, area,
+                                                iou_threshold)) {
+          return true;
         }
-      };
-      ParallelLaunchAutoSearch(task2, ceil_power2, this, &parallel_search_info_);
+      }
     }
+    return false;
   }
-}
 
-// Initialize per row mask array to all true
-template <typename T>
-void NMSWithMaskCPUKernel<T>::MaskInit(size_t numSq, bool *row_mask) {
-  auto task = [this, &row_mask](int start, int end) {
-    for (int mat_pos = start; mat_pos < end; mat_pos++) {
-      row_mask[mat_pos] = true;
-    }
-  };
-  ParallelLaunchAutoSearch(task, numSq, this, &parallel_search_info_);
-}
-
-// copy data from input to output array sorted by indices returned from bitonic sort
-// flips boxes if asked to,  default - false -> if (x1/y1 > x2/y2)
-template <typename T>
-void NMSWithMaskCPUKernel<T>::PopulateOutput(const T *data_in, T *data_out, const int *index_buff, const int num,
-                                             int box_size, bool flip_mode) {
-  auto task = [this, &index_buff, &data_in, &data_out, flip_mode, num, box_size](int start, int end) {
-    for (int box_num = start; box_num < end; box_num++) {
-      int correct_index = index_buff[(num - 1) - box_num];  // flip the array around
-      int correct_arr_start = correct_index * box_size;
-      int current_arr_start = box_num * box_size;
-      if (flip_mode) {  // flip boxes
-        // check x
-        if (data_in[correct_arr_start + X0] > data_in[correct_arr_start + X1]) {
-          data_out[current_arr_start + X0] = data_in[correct_arr_start + X1];
-          data_out[current_arr_start + X1] = data_in[correct_arr_start + X0];
-        } else {
-          data_out[current_arr_start + X0] = data_in[correct_arr_start + X0];
-          data_out[current_arr_start + X1] = data_in[correct_arr_start + X1];
-        }
-        // check y
-        if (data_in[correct_arr_start + Y0] > data_in[correct_arr_start + Y1]) {
-          data_out[current_arr_start + Y0] = data_in[correct_arr_start + Y1];
-          data_out[current_arr_start + Y1] = data_in[correct_arr_start + Y0];
-        } else {
-          data_out[current_arr_start + Y0] = data_in[correct_arr_start + Y0];
-          data_out[current_arr_start + Y1] = data_in[correct_arr_start + Y1];
-        }
-        data_out[current_arr_start + SCORE] = data_in[correct_arr_start + SCORE];
-      } else {  // default behaviour, don't flip
-        for (int x = 0; x < box_size; x++) {
-          data_out[current_arr_start + x] = data_in[correct_arr_start + x];
-        }
+  void Add(const float *box, float area) {
+    size_t col_begin, col_end, row_begin, row_end;
+    CellRange(box, &col_begin, &col_end, &row_begin, &row_end);
+    for (size_t row = row_begin; row <= row_end; ++row) {
+      for (size_t col = col_begin; col <= col_end; ++col) {
+        auto &cell = cells_[row * cols_ + col];
+        cell.x0.push_back(box[X0]);
+        cell.y0.push_back(box[Y0]);
+        cell.x1.push_back(box[X1]);
+        cell.y1.push_back(box[Y1]);
+        cell.area.push_back(area);
       }
     }
+  }
+
+ private:
+  struct Cell {
+    std::vector<float> x0;
+    std::vector<float> y0;
+    std::vector<float> x1;
+    std::vector<float> y1;
+    std::vector<float> area;
   };
-  ParallelLaunchAutoSearch(task, IntToSize(num), this, &parallel_search_info_);
-}
 
-// populated return mask (init to all true) and return index array
-template <typename T>
-void NMSWithMaskCPUKernel<T>::Preprocess(const int num, int *sel_idx, bool *sel_boxes) {
-  auto task = [this, &sel_idx, &sel_boxes](int start, int end) {
-    for (int box_num = start; box_num < end; box_num++) {
-      sel_idx[box_num] = box_num;
-      sel_boxes[box_num] = true;
+  static size_t ToCell(float pos, float origin, float cell_size, size_t dim) {
+    float index = std::floor((pos - origin) / cell_size);
+    if (!(index > 0.0f)) {
+      return 0;
     }
-  };
-  ParallelLaunchAutoSearch(task, IntToSize(num), this, &parallel_search_info_);
+    return index >= static_cast<float>(dim - 1) ? dim - 1 : static_cast<size_t>(index);
+  }
+
+  void CellRange(const float *box, size_t *col_begin, size_t *col_end, size_t *row_begin, size_t *row_end) const {
+    *col_begin = ToCell(std::min(box[X0], box[X1]), min_x_, cell_w_, cols_);
+    *col_end = std::max(*col_begin, ToCell(std::max(box[X0], box[X1]), min_x_, cell_w_, cols_));
+    *row_begin = ToCell(std::min(box[Y0], box[Y1]), min_y_, cell_h_, rows_);
+    *row_end = std::max(*row_begin, ToCell(std::max(box[Y0], box[Y1]), min_y_, cell_h_, rows_));
+  }
+
+  float min_x_;
+  float min_y_;
+  float cell_w_;
+  float cell_h_;
+  size_t cols_;
+  size_t rows_;
+  std::vector<Cell> cells_;
+};
+
+size_t GridDim(float extent, float cell_size) {
+  if (!(extent > 0.0f) || !(cell_size > 0.0f) || !std::isfinite(extent / cell_size)) {
+    return 1;
+  }
+  auto dim = static_cast<size_t>(std::ceil(extent / cell_size));
+  return std::max(static_cast<size_t>(1), std::min(dim, kNmsGridMaxDim));
 }
+}  // namespace
 
 template <typename T>
-bool NMSWithMaskCPUKernel<T>::IouDecision(const T *output, int box_A_start, int box_B_start, float IOU_value) {
-  constexpr int X1_OFFSET = 0;
-  constexpr int Y1_OFFSET = 1;
-  constexpr int X2_OFFSET = 2;
-  constexpr int Y2_OFFSET = 3;
-  T x_1 = std::max(output[box_A_start + X1_OFFSET], output[box_B_start + X1_OFFSET]);
-  T y_1 = std::max(output[box_A_start + Y1_OFFSET], output[box_B_start + Y1_OFFSET]);
-  T x_2 = std::min(output[box_A_start + X2_OFFSET], output[box_B_start + X2_OFFSET]);
-  T y_2 = std::min(output[box_A_start + Y2_OFFSET], output[box_B_start + Y2_OFFSET]);
-  T width = std::max(x_2 - x_1, T(0));  // in case of no overlap
-  T height = std::max(y_2 - y_1, T(0));
-
-  T area1 = (output[box_A_start + X2_OFFSET] - output[box_A_start + X1_OFFSET]) *
-            (output[box_A_start + Y2_OFFSET] - output[box_A_start + Y1_OFFSET]);
-  T area2 = (output[box_B_start + X2_OFFSET] - output[box_B_start + X1_OFFSET]) *
-            (output[box_B_start + Y2_OFFSET] - output[box_B_start + Y1_OFFSET]);
-
-  T combined_area = area1 + area2;
-  return !(((width * height) / (combined_area - (width * height))) > static_cast<T>(IOU_value));
+void NMSWithMaskCPUKernel<T>::SortByScore(const T *input, int *index_buff) const {
+  for (int i = 0; i < num_input_; ++i) {
+    index_buff[i] = i;
+  }
+  std::stable_sort(index_buff, index_buff + num_input_, [input](int lhs, int rhs) {
+    return input[lhs * box_size_ + SCORE] > input[rhs * box_size_ + SCORE];
+  });
 }
 
-// Run parallel NMS pass
-// Every position in the row_mask array is updated wit correct IOU decision after being init to all True
+// copy data from input to output array sorted by indices returned from the sort
 template <typename T>
-void NMSWithMaskCPUKernel<T>::NmsPass(const int num, const float IOU_value, const T *output, int box_size,
-                                      bool *row_mask) {
-  auto task = [this, &row_mask, &output, num, box_size, IOU_value](int start, int end) {
-    for (int mask_index = start; mask_index < end; mask_index++) {
-      int box_i = mask_index / num;                // row in 2d row_mask array
-      int box_j = mask_index % num;                // col in 2d row_mask array
-      if (box_j > box_i) {                         // skip when box_j index lower/equal to box_i - will remain true
-        int box_i_start_index = box_i * box_size;  // adjust starting indices
-        int box_j_start_index = box_j * box_size;
-        row_mask[mask_index] = IouDecision(output, box_i_start_index, box_j_start_index, IOU_value);
-      }
+void NMSWithMaskCPUKernel<T>::PopulateOutput(const T *data_in, T *data_out, const int *index_buff) const {
+  for (int box_num = 0; box_num < num_input_; box_num++) {
+    int correct_arr_start = index_buff[box_num] * box_size_;
+    int current_arr_start = box_num * box_size_;
+    for (int x = 0; x < box_size_; x++) {
+      data_out[current_arr_start + x] = data_in[correct_arr_start + x];
     }
-  };
-  ParallelLaunchAutoSearch(task, IntToSize(num * num), this, &parallel_search_info_);
+  }
 }
 
-// Reduce pass runs on 1 block to allow thread sync
 template <typename T>
-void NMSWithMaskCPUKernel<T>::ReducePass(const int num, bool *sel_boxes, const bool *row_mask) {
-  // loop over every box in order of high to low confidence score
-  for (int i = 0; i < num - 1; ++i) {
-    if (!sel_boxes[i]) {
+void NMSWithMaskCPUKernel<T>::NmsSweep(const T *output, bool *sel_boxes) const {
+  size_t num = IntToSize(num_input_);
+  std::vector<float> boxes(num * (box_size_ - 1));
+  std::vector<float> areas(num);
+  float min_x = 0.0f;
+  float min_y = 0.0f;
+  float max_x = 0.0f;
+  float max_y = 0.0f;
+  double sum_w = 0.0;
+  double sum_h = 0.0;
+  for (size_t i = 0; i < num; ++i) {
+    float *box = boxes.data() + i * (box_size_ - 1);
+    for (int j = X0; j <= Y1; ++j) {
+      box[j] = static_cast<float>(output[i * box_size_ + j]);
+    }
+    areas[i] = (box[X1] - box[X0]) * (box[Y1] - box[Y0]);
+    min_x = i == 0 ? std::min(box[X0], box[X1]) : std::min({min_x, box[X0], box[X1]});
+    min_y = i == 0 ? std::min(box[Y0], box[Y1]) : std::min({min_y, box[Y0], box[Y1]});
+    max_x = i == 0 ? std::max(box[X0], box[X1]) : std::max({max_x, box[X0], box[X1]});
+    max_y = i == 0 ? std::max(box[Y0], box[Y1]) : std::max({max_y, box[Y0], box[Y1]});
+    sum_w += std::fabs(box[X1] - box[X0]);
+    sum_h += std::fabs(box[Y1] - box[Y0]);
+  }
+  // cells about the size of an average box; boxes that do not intersect have iou 0, so the grid can only be
+  // used when that never exceeds the threshold
+  size_t cols = 1;
+  size_t rows = 1;
+  float cell_w = max_x - min_x;
+  float cell_h = max_y - min_y;
+  if (iou_value_ >= 0.0f && num > 0) {
+    cols = GridDim(max_x - min_x, static_cast<float>(sum_w / num));
+    rows = GridDim(max_y - min_y, static_cast<float>(sum_h / num));
+    cell_w = (max_x - min_x) / cols;
+    cell_h = (max_y - min_y) / rows;
+  }
+  NmsGrid grid(min_x, min_y, cell_w, cell_h, cols, rows);
+  size_t max_output = max_output_size_ < 0 ? num : LongToSize(max_output_size_);
+  size_t kept = 0;
+  for (size_t i = 0; i < num; ++i) {
+    // once enough boxes are kept the rest are dropped without comparing
+    if (kept >= max_output) {
+      sel_boxes[i] = false;
       continue;
     }
-    // every thread handles a different set of boxes (per all boxes in order)
-    auto task = [this, &sel_boxes, &row_mask, i, num](int start, int end) {
-      for (int j = start; j < end; j++) {
-        sel_boxes[j] = sel_boxes[j] && row_mask[i * num + j];
-      }
-    };
-    ParallelLaunchAutoSearch(task, IntToSize(num), this, &parallel_search_info_);
+    const float *box = boxes.data() + i * (box_size_ - 1);
+    sel_boxes[i] = !grid.Overlapped(box, areas[i], iou_value_);
+    if (sel_boxes[i]) {
+      grid.Add(box, areas[i]);
+      ++kept;
+    }
   }
 }
 
@@ -202,6 +188,9 @@ void NMSWithMaskCPUKernel<T>::InitKernel(const CNodePtr &kernel_node) {
   MS_EXCEPTION_IF_NULL(kernel_node);
   kernel_name_ = AnfAlgo::GetCNodeName(kernel_node);
   iou_value_ = AnfAlgo::GetNodeAttr<float>(kernel_node, "iou_threshold");
+  if (AnfAlgo::HasNodeAttr("max_output_size", kernel_node)) {
+    max_output_size_ = AnfAlgo::GetNodeAttr<int64_t>(kernel_node, "max_output_size");
+  }
   size_t input_num = AnfAlgo::GetInputTensorNum(kernel_node);
   if (input_num != INPUT_NUM) {
     MS_LOG(ERROR) << "For '" << kernel_name_ << "', the number of inputs should be 1, but got " << input_num
@@ -219,12 +208,12 @@ template <typename T>
 void NMSWithMaskCPUKernel<T>::InitInputOutputSize(const CNodePtr &kernel_node) {
   CPUKernel::InitInputOutputSize(kernel_node);
   auto input_shape = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, 0);
-  num_input_ = SizeToInt(input_shape[0]);  //  Get N values in  [N, 5] data.
-  ceil_power_2 = static_cast<size_t>(NmsRoundUpPower2(num_input_));
+  //  Get N values in [N, 5] data, or in [B, N, 5] data where each of the B slices, e.g. the boxes of one class,
+  //  is suppressed on its own
+  batch_ = input_shape.size() == kNmsBatchedRank ? input_shape[0] : 1;
+  num_input_ = SizeToInt(input_shape[input_shape.size() - 2]);
 
-  workspace_size_list_.push_back(ceil_power_2 * sizeof(T));                           //  data buff
-  workspace_size_list_.push_back(ceil_power_2 * sizeof(int));                         //  index buff
-  workspace_size_list_.push_back(IntToSize(num_input_ * num_input_) * sizeof(bool));  //  mask list
+  workspace_size_list_.push_back(batch_ * IntToSize(num_input_) * sizeof(int));  //  index buff
 }
 
 template <typename T>
@@ -232,20 +221,23 @@ bool NMSWithMaskCPUKernel<T>::Launch(const std::vector<kernel::AddressPtr> &inpu
                                      const std::vector<kernel::AddressPtr> &workspace,
                                      const std::vector<kernel::AddressPtr> &outputs) {
   auto input = reinterpret_cast<T *>(inputs[0]->addr);
-  auto data_buff = reinterpret_cast<T *>(workspace[DATA_BUFF]->addr);
   auto index_buff = reinterpret_cast<int *>(workspace[INDEX_BUFF]->addr);
-  auto row_mask = reinterpret_cast<bool *>(workspace[ROW_MASK]->addr);
   auto output = reinterpret_cast<T *>(outputs[OUTPUT]->addr);
   auto sel_idx = reinterpret_cast<int *>(outputs[SEL_IDX]->addr);
   auto sel_boxes = reinterpret_cast<bool *>(outputs[SEL_BOXES]->addr);
 
-  NmsBitonicSortByKeyKernel(num_input_, ceil_power_2, input, data_buff, index_buff, box_size_);
-  size_t total_val = IntToSize(num_input_ * num_input_);
-  MaskInit(total_val, row_mask);
-  PopulateOutput(input, output, index_buff, num_input_, box_size_, false);
-  Preprocess(num_input_, sel_idx, sel_boxes);
-  NmsPass(num_input_, iou_value_, output, box_size_, row_mask);
-  ReducePass(num_input_, sel_boxes, row_mask);
+  size_t num = IntToSize(num_input_);
+  auto task = [this, input, index_buff, output, sel_idx, sel_boxes, num](size_t start, size_t end) {
+    for (size_t b = start; b < end; ++b) {
+      SortByScore(input + b * num * box_size_, index_buff + b * num);
+      PopulateOutput(input + b * num * box_size_, output + b * num * box_size_, index_buff + b * num);
+      for (size_t i = 0; i < num; ++i) {
+        sel_idx[b * num + i] = SizeToInt(i);
+      }
+      NmsSweep(output + b * num * box_size_, sel_boxes + b * num);
+    }
+  };
+  ParallelLaunchAutoSearch(task, batch_, this, &parallel_search_info_);
   return true;
 }
 }  // namespace kernel
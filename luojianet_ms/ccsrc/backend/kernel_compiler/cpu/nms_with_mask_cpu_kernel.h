@@ -18,7 +18,6 @@
 #define LUOJIANET_MS_CCSRC_BACKEND_KERNEL_COMPILER_CPU_NMS_WITH_MASK_CPU_KERNEL_H_
 #include <vector>
 #include <algorithm>
-#include <limits>
 #include "backend/kernel_compiler/cpu/cpu_kernel.h"
 #include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
 
@@ -45,27 +44,19 @@ class NMSWithMaskCPUKernel : public CPUKernel {
   void InitInputOutputSize(const CNodePtr &kernel_node) override;
 
  private:
-  void NmsBitonicSortByKeyKernel(const int inner, const size_t ceil_power2, const T *input, T *data_buff,
-                                 int *index_buff, int box_size);
+  void SortByScore(const T *input, int *index_buff) const;
 
-  void MaskInit(size_t numSq, bool *row_mask);
+  void PopulateOutput(const T *data_in, T *data_out, const int *index_buff) const;
 
-  void PopulateOutput(const T *data_in, T *data_out, const int *index_buff, const int num, int box_size,
-                      bool flip_mode);
-
-  void Preprocess(const int num, int *sel_idx, bool *sel_boxes);
-
-  bool IouDecision(const T *output, int box_A_start, int box_B_start, float IOU_value);
-
-  void NmsPass(const int num, const float IOU_value, const T *output, int box_size, bool *row_mask);
-
-  void ReducePass(const int num, bool *sel_boxes, const bool *row_mask);
+  // greedy sweep over boxes already sorted by score, a box is kept unless a kept box overlaps it above the threshold
+  void NmsSweep(const T *output, bool *sel_boxes) const;
 
+  size_t batch_{1};
   int num_input_{0};
   float iou_value_{0.0};
-  size_t ceil_power_2{0};
+  int64_t max_output_size_{-1};
   static const int box_size_ = 5;  //  pre_defined box width
-  enum workspace_list_ { DATA_BUFF, INDEX_BUFF, ROW_MASK };
+  enum workspace_list_ { INDEX_BUFF };
   enum output_list_ { OUTPUT, SEL_IDX, SEL_BOXES };
 };
 
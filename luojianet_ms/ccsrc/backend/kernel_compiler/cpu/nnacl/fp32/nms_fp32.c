@@ -0,0 +1,76 @@
+/**
+ * Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+ * Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "nnacl/fp32/nms_fp32.h"
+#include "nnacl/intrinsics/ms_simd_instructions.h"
+
+bool NmsOverlapped(const float *x0, const float *y0, const float *x1, const float *y1, const float *area, int num,
+                   const float *box, float box_area, float iou_threshold) {
+  int index = 0;
+#if defined(ENABLE_AVX)
+  MS_FLOAT32X8 box_x0_8 = MS_MOV256_F32(box[0]);
+  MS_FLOAT32X8 box_y0_8 = MS_MOV256_F32(box[1]);
+  MS_FLOAT32X8 box_x1_8 = MS_MOV256_F32(box[2]);
+  MS_FLOAT32X8 box_y1_8 = MS_MOV256_F32(box[3]);
+  MS_FLOAT32X8 box_area_8 = MS_MOV256_F32(box_area);
+  MS_FLOAT32X8 threshold_8 = MS_MOV256_F32(iou_threshold);
+  MS_FLOAT32X8 zero_8 = MS_MOV256_F32(0.0f);
+  for (; index <= num - C8NUM; index += C8NUM) {
+    MS_FLOAT32X8 width = MS_SUB256_F32(MS_MIN256_F32(box_x1_8, MS_LD256_F32(x1 + index)),
+                                       MS_MAX256_F32(box_x0_8, MS_LD256_F32(x0 + index)));
+    MS_FLOAT32X8 height = MS_SUB256_F32(MS_MIN256_F32(box_y1_8, MS_LD256_F32(y1 + index)),
+                                        MS_MAX256_F32(box_y0_8, MS_LD256_F32(y0 + index)));
+    MS_FLOAT32X8 inter = MS_MUL256_F32(MS_MAX256_F32(width, zero_8), MS_MAX256_F32(height, zero_8));
+    MS_FLOAT32X8 iou =
+      MS_DIV256_F32(inter, MS_SUB256_F32(MS_ADD256_F32(box_area_8, MS_LD256_F32(area + index)), inter));
+    if (_mm256_movemask_ps(MS_CMP256_F32(iou, threshold_8, _CMP_GT_OQ)) != 0) {
+      return true;
+    }
+  }
+#endif
+
+#if defined(ENABLE_SSE) || defined(ENABLE_ARM)
+  MS_FLOAT32X4 box_x0 = MS_MOVQ_F32(box[0]);
+  MS_FLOAT32X4 box_y0 = MS_MOVQ_F32(box[1]);
+  MS_FLOAT32X4 box_x1 = MS_MOVQ_F32(box[2]);
+  MS_FLOAT32X4 box_y1 = MS_MOVQ_F32(box[3]);
+  MS_FLOAT32X4 box_area_4 = MS_MOVQ_F32(box_area);
+  MS_FLOAT32X4 threshold = MS_MOVQ_F32(iou_threshold);
+  MS_FLOAT32X4 zero = MS_MOVQ_F32(0.0f);
+  MS_FLOAT32X4 one = MS_MOVQ_F32(1.0f);
+  for (; index <= num - C4NUM; index += C4NUM) {
+    MS_FLOAT32X4 width =
+      MS_SUBQ_F32(MS_MINQ_F32(box_x1, MS_LDQ_F32(x1 + index)), MS_MAXQ_F32(box_x0, MS_LDQ_F32(x0 + index)));
+    MS_FLOAT32X4 height =
+      MS_SUBQ_F32(MS_MINQ_F32(box_y1, MS_LDQ_F32(y1 + index)), MS_MAXQ_F32(box_y0, MS_LDQ_F32(y0 + index)));
+    MS_FLOAT32X4 inter = MS_MULQ_F32(MS_MAXQ_F32(width, zero), MS_MAXQ_F32(height, zero));
+    MS_FLOAT32X4 iou = MS_DIVQ_F32(inter, MS_SUBQ_F32(MS_ADDQ_F32(box_area_4, MS_LDQ_F32(area + index)), inter));
+    MS_FLOAT32X4 hit = MS_BLENDQ_F32(zero, one, MS_CMPGTQ_F32(iou, threshold));
+    if (MS_F32X4_GETI(hit, 0) + MS_F32X4_GETI(hit, 1) + MS_F32X4_GETI(hit, 2) + MS_F32X4_GETI(hit, 3) > 0.0f) {
+      return true;
+    }
+  }
+#endif
+  for (; index < num; ++index) {
+    float width = MSMIN(box[2], x1[index]) - MSMAX(box[0], x0[index]);
+    float height = MSMIN(box[3], y1[index]) - MSMAX(box[1], y0[index]);
+    float inter = MSMAX(width, 0.0f) * MSMAX(height, 0.0f);
+    if (inter / (box_area + area[index] - inter) > iou_threshold) {
+      return true;
+    }
+  }
+  return false;
+}
@@ -0,0 +1,33 @@
+/**
+ * Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+ * Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LUOJIANET_MS_NNACL_FP32_NMS_FP32_H_
+#define LUOJIANET_MS_NNACL_FP32_NMS_FP32_H_
+
+#include "nnacl/op_base.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// whether box overlaps any of the num boxes stored as separate coordinate arrays with iou above iou_threshold
+bool NmsOverlapped(const float *x0, const float *y0, const float *x1, const float *y1, const float *area, int num,
+                   const float *box, float box_area, float iou_threshold);
+#ifdef __cplusplus
+}
+#endif
+
+#endif  //  LUOJIANET_MS_NNACL_FP32_NMS_FP32_H_
@@ -196,6 +196,42 @@ int InterpRow(const float *src_line, float *linear_output, int new_width, const
   return 0;
 }
 
+int InterpRowGather(const float *src_line, float *linear_output, int new_width, const float *x_left_weights,
+                    const int *x_lefts, const int *x_rights) {
+  int w = 0;
+#if defined(ENABLE_AVX) && defined(__AVX2__)
+  MS_FLOAT32X8 one_8 = MS_MOV256_F32(1.0f);
+  for (; w <= new_width - C8NUM; w += C8NUM) {
+    MS_FLOAT32X8 left =
+      _mm256_i32gather_ps(src_line, _mm256_loadu_si256((const __m256i *)(x_lefts + w)), sizeof(float));
+    MS_FLOAT32X8 right =
+      _mm256_i32gather_ps(src_line, _mm256_loadu_si256((const __m256i *)(x_rights + w)), sizeof(float));
+    MS_FLOAT32X8 left_w_8 = MS_LD256_F32(x_left_weights + w);
+    MS_FLOAT32X8 right_w_8 = MS_SUB256_F32(one_8, left_w_8);
+    MS_FLOAT32X8 interp_value = MS_ADD256_F32(MS_MUL256_F32(left, left_w_8), MS_MUL256_F32(right, right_w_8));
+    MS_ST256_F32(linear_output + w, interp_value);
+  }
+#endif
+#if defined(ENABLE_NEON) || defined(ENABLE_SSE)
+  MS_FLOAT32X4 one = MS_MOVQ_F32(1.0f);
+  for (; w <= new_width - C4NUM; w += C4NUM) {
+    float left_data[C4NUM] = {src_line[x_lefts[w]], src_line[x_lefts[w + 1]], src_line[x_lefts[w + 2]],
+                              src_line[x_lefts[w + 3]]};
+    float right_data[C4NUM] = {src_line[x_rights[w]], src_line[x_rights[w + 1]], src_line[x_rights[w + 2]],
+                               src_line[x_rights[w + 3]]};
+    MS_FLOAT32X4 left_w = MS_LDQ_F32(x_left_weights + w);
+    MS_FLOAT32X4 right_w = MS_SUBQ_F32(one, left_w);
+    MS_FLOAT32X4 interp_value =
+      MS_ADDQ_F32(MS_MULQ_F32(MS_LDQ_F32(left_data), left_w), MS_MULQ_F32(MS_LDQ_F32(right_data), right_w));
+    MS_STQ_F32(linear_output + w, interp_value);
+  }
+#endif
+  for (; w < new_width; w++) {
+    linear_output[w] = src_line[x_lefts[w]] * x_left_weights[w] + src_line[x_rights[w]] * (1.0f - x_left_weights[w]);
+  }
+  return 0;
+}
+
 int InterpCol(const float *bottom_line, const float *top_line, float *output, int new_width, float y_bottom_weight,
               int in_c) {
   int w;
@@ -42,6 +42,16 @@ int ResizeBilinear(const float *input_data, float *output_data, const int *input
                    const float *y_bottom_weights, const float *x_left_weights, float *line0, float *line1,
                    const int h_begin, const int h_end);
 
+// Row pass of an NCHW ResizeBilinear: x_lefts and x_rights index the elements of src_line, which are gathered into
+// SIMD lanes with the x_left_weights of the neighbouring output elements.
+int InterpRowGather(const float *src_line, float *linear_output, int new_width, const float *x_left_weights,
+                    const int *x_lefts, const int *x_rights);
+
+// Column pass of ResizeBilinear. NCHW callers pass new_width = 1 and in_c = width, so that it is vectorized along the
+// width.
+int InterpCol(const float *bottom_line, const float *top_line, float *output, int new_width, float y_bottom_weight,
+              int in_c);
+
 int ResizeBicubic(const float *input_data, float *output_data, const int *input_shape, const int *output_shape,
                   const int *y_tops, const int *x_lefts, const float *y_weights, const float *x_weights,
                   float *line_buffer, const int h_begin, const int h_end);
@@ -19,6 +19,10 @@
 #include "runtime/device/cpu/cpu_device_address.h"
 #include "runtime/device/cpu/mpi/mpi_interface.h"
 #include "ir/primitive.h"
+#include "utils/ms_utils.h"
+#if !defined(_WIN32)
+#include "runtime/hardware/cpu/ms_collective_comm_lib.h"
+#endif
 
 namespace luojianet_ms {
 namespace kernel {
@@ -46,6 +50,27 @@ void ReduceScatterCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   } else {
     MS_LOG(EXCEPTION) << "For '" << kernel_name_ << "', the 'group' should be not null, but got empty value.";
   }
+
+  use_mpi_ = common::CheckUseMPI();
+#if !defined(_WIN32)
+  if (!use_mpi_) {
+    if (op_type_ != kMPIOpTypeSum) {
+      MS_LOG(EXCEPTION) << "For '" << kernel_name_ << "', only 'sum' is supported without OpenMPI, but got "
+                        << op_type_;
+    }
+    auto &comm_lib = device::cpu::MsCollectiveCommLib::GetInstance();
+    bool is_global_group = ranks_group_.size() == comm_lib.global_rank_size();
+    for (size_t i = 0; i < ranks_group_.size() && is_global_group; i++) {
+      is_global_group = ranks_group_[i] == SizeToInt(i);
+    }
+    if (!is_global_group) {
+      MS_LOG(EXCEPTION) << "For '" << kernel_name_
+                        << "', only the global group is supported without OpenMPI, but got a group of "
+                        << ranks_group_.size() << " ranks.";
+    }
+    group_name_ = comm_lib.global_group_name();
+  }
+#endif
 }
 
 bool ReduceScatterCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
@@ -56,6 +81,13 @@ bool ReduceScatterCPUKernel::Launch(const std::vector<kernel::AddressPtr> &input
   auto *input_addr = reinterpret_cast<float *>(inputs[0]->addr);
   auto *output_addr = reinterpret_cast<float *>(outputs[0]->addr);
   auto output_data_num = outputs[0]->size / sizeof(float);
+#if !defined(_WIN32)
+  if (!use_mpi_) {
+    return device::cpu::MsCollectiveCommLib::GetInstance().ReduceScatter(
+      input_addr, output_addr, output_data_num, kNumberTypeFloat32, device::CollectiveOpReduceType::Reduce_Sum,
+      group_name_);
+  }
+#endif
   return MPIReduceScatter(input_addr, output_addr, ranks_group_, output_data_num, op_type_);
 }
 }  // namespace kernel
@@ -38,6 +38,10 @@ class ReduceScatterCPUKernel : public CPUKernel {
  private:
   std::string op_type_;
   std::vector<int> ranks_group_;
+  // Whether the process is launched by OpenMPI. Otherwise the ring ReduceScatter of the LuoJiaNet collective
+  // communication library is used, which supports the global group only.
+  bool use_mpi_{true};
+  std::string group_name_;
 };
 
 MS_REG_CPU_KERNEL(_HostReduceScatter, KernelAttr().AddInputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat32),
@@ -18,6 +18,7 @@
 #include "backend/kernel_compiler/cpu/resize_bilinear_cpu_kernel.h"
 #include "runtime/device/cpu/cpu_device_address.h"
 #include "backend/kernel_compiler/common_utils.h"
+#include "backend/kernel_compiler/cpu/nnacl/fp32/resize_fp32.h"
 
 namespace luojianet_ms {
 namespace kernel {
@@ -26,6 +27,7 @@ constexpr size_t kResizeBilinearInputsNum = 1;
 constexpr size_t kResizeBilinearOutputsNum = 1;
 constexpr size_t kResizeBilinearInputsShapeSize = 4;
 constexpr size_t kResizeBilinearAttrSize = 2;
+constexpr size_t kCachedLineNum = 2;
 }  // namespace
 
 void ResizeBilinearCPUKernel::InitKernel(const CNodePtr &kernel_node) {
@@ -49,6 +51,27 @@ void ResizeBilinearCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   size_t out_width = size_[1];
   height_scale = Scaling(in_height, out_height, align_corners_);
   width_scale = Scaling(in_width, out_width, align_corners_);
+
+  std::vector<CachedInterpolation> ys(out_height + 1);
+  std::vector<CachedInterpolation> xs(out_width + 1);
+  ComputeInterpolationWeights(out_height, in_height, height_scale, ys.data());
+  ComputeInterpolationWeights(out_width, in_width, width_scale, xs.data());
+  y_bottoms_.resize(out_height);
+  y_tops_.resize(out_height);
+  y_bottom_weights_.resize(out_height);
+  for (size_t h = 0; h < out_height; ++h) {
+    y_bottoms_[h] = SizeToInt(ys[h].lower);
+    y_tops_[h] = SizeToInt(ys[h].upper);
+    y_bottom_weights_[h] = 1.0f - ys[h].lerp;
+  }
+  x_lefts_.resize(out_width);
+  x_rights_.resize(out_width);
+  x_left_weights_.resize(out_width);
+  for (size_t w = 0; w < out_width; ++w) {
+    x_lefts_[w] = SizeToInt(xs[w].lower);
+    x_rights_[w] = SizeToInt(xs[w].upper);
+    x_left_weights_[w] = 1.0f - xs[w].lerp;
+  }
 }
 
 bool ResizeBilinearCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
@@ -57,99 +80,88 @@ bool ResizeBilinearCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inpu
   CHECK_KERNEL_INPUTS_NUM(inputs.size(), kResizeBilinearInputsNum, kernel_name_);
   CHECK_KERNEL_OUTPUTS_NUM(outputs.size(), kResizeBilinearOutputsNum, kernel_name_);
   if (dtype_ == kNumberTypeFloat16) {
-    return LaunchKernel<float16, float16>(inputs, outputs);
+    return LaunchKernel<float16>(inputs, outputs);
   } else if (dtype_ == kNumberTypeFloat32) {
-    return LaunchKernel<float, float>(inputs, outputs);
+    return LaunchKernel<float>(inputs, outputs);
   } else {
     MS_LOG(EXCEPTION) << "For '" << kernel_name_ << "', the dtype of input should be float16 or float32, but got "
                       << TypeIdLabel(dtype_);
   }
 }
 
-template <typename T1, typename T2>
+template <typename T>
 bool ResizeBilinearCPUKernel::LaunchKernel(const std::vector<AddressPtr> &inputs,
-                                           const std::vector<AddressPtr> &outputs) const {
-  auto *output_addr_T2 = reinterpret_cast<T2 *>(outputs[0]->addr);
-  float *float_input_addr = NULL;
-  float *float_output_addr = NULL;
-  if (dtype_ == kNumberTypeFloat16) {
-    auto *input_addr_T1 = reinterpret_cast<T1 *>(inputs[0]->addr);
-    size_t input_mem_size = inputs[0]->size / sizeof(T1) * sizeof(float);
-    float_input_addr = reinterpret_cast<float *>(malloc(input_mem_size));
-    if (float_input_addr == NULL) {
-      MS_LOG(ERROR) << "For '" << kernel_name_ << "', malloc memory failed.";
-      return false;
-    }
-    for (size_t i = 0; i < ((inputs[0]->size) / sizeof(T1)); ++i) {
-      float_input_addr[i] = static_cast<float>(input_addr_T1[i]);
-    }
-
-    size_t output_mem_size = outputs[0]->size / sizeof(T2) * sizeof(float);
-    float_output_addr = reinterpret_cast<float *>(malloc(output_mem_size));
-    if (float_output_addr == NULL) {
-      free(float_input_addr);
-      MS_LOG(ERROR) << "For '" << kernel_name_ << "', malloc memory failed.";
-      return false;
-    }
-  } else if (dtype_ == kNumberTypeFloat32) {
-    float_input_addr = reinterpret_cast<float *>(inputs[0]->addr);
-    float_output_addr = reinterpret_cast<float *>(outputs[0]->addr);
-  } else {
-    MS_LOG(EXCEPTION) << "For '" << kernel_name_ << "', the dtype of input should be float16 or float32, but got "
-                      << TypeIdLabel(dtype_);
-  }
-
-  size_t batch_size = shape_[0];
-  size_t channel = shape_[1];
+                                           const std::vector<AddressPtr> &outputs) {
+  auto *input_addr = reinterpret_cast<T *>(inputs[0]->addr);
+  auto *output_addr = reinterpret_cast<T *>(outputs[0]->addr);
+  size_t plane_num = shape_[0] * shape_[1];
   size_t in_height = shape_[2];
   size_t in_width = shape_[3];
-  size_t out_height = size_[0];
-  size_t out_width = size_[1];
-  size_t out_hw_size = out_height * out_width;
+  size_t out_height = LongToSize(size_[0]);
+  size_t out_width = LongToSize(size_[1]);
   size_t in_hw_size = in_height * in_width;
-  size_t bhwc_size = in_hw_size * channel * batch_size;
 
   if (out_height == in_height && out_width == in_width) {
-    for (size_t i = 0; i < bhwc_size; ++i) {
-      float_output_addr[i] = static_cast<float>(float_input_addr[i]);
+    if (memcpy_s(output_addr, outputs[0]->size, input_addr, inputs[0]->size) != EOK) {
+      MS_LOG(EXCEPTION) << "For '" << kernel_name_ << "', memcpy failed.";
     }
+    return true;
   }
 
-  std::vector<CachedInterpolation> ys(out_height + 1);
-  std::vector<CachedInterpolation> xs(out_width + 1);
-  ComputeInterpolationWeights(out_height, in_height, height_scale, ys.data());
-  ComputeInterpolationWeights(out_width, in_width, width_scale, xs.data());
-
-  float *cur_input_addr = float_input_addr;
-  float *cur_output_addr = float_output_addr;
-  for (size_t b = 0; b < batch_size; ++b) {
-    for (size_t c = 0; c < channel; ++c) {
-      for (size_t h = 0; h < out_height; ++h) {
-        const float *ys_input_lower_ptr = cur_input_addr + ys[h].lower * in_width;
-        const float *ys_input_upper_ptr = cur_input_addr + ys[h].upper * in_width;
-        const float ys_lerp = static_cast<float>(ys[h].lerp);
+  // Every task resizes a range of output rows of all N * C planes. The input rows interpolated along the width are
+  // cached, so upsampling reads and interpolates each input row once per task instead of once per output row.
+  auto task = [this, input_addr, output_addr, in_height, in_width, out_height, out_width, in_hw_size](size_t start,
+                                                                                                      size_t end) {
+    std::vector<float> lines(out_width * kCachedLineNum);
+    float *line_ptr[kCachedLineNum] = {lines.data(), lines.data() + out_width};
+    int64_t line_key[kCachedLineNum] = {-1, -1};
+    std::vector<float> src_row;
+    std::vector<float> dst_row;
+    if constexpr (!std::is_same_v<T, float>) {
+      src_row.resize(in_width);
+      dst_row.resize(out_width);
+    }
+    auto get_line = [&](size_t plane, int row, int64_t keep) -> const float * {
+      int64_t key = SizeToLong(plane * in_height) + row;
+      for (size_t k = 0; k < kCachedLineNum; ++k) {
+        if (line_key[k] == key) {
+          return line_ptr[k];
+        }
+      }
+      // Replace the slot which is not used by the other row of the current output row.
+      size_t slot = (keep >= 0 && line_key[0] == keep) ? 1 : 0;
+      const T *src = input_addr + plane * in_hw_size + IntToSize(row) * in_width;
+      const float *src_line = nullptr;
+      if constexpr (std::is_same_v<T, float>) {
+        src_line = src;
+      } else {
+        for (size_t w = 0; w < in_width; ++w) {
+          src_row[w] = static_cast<float>(src[w]);
+        }
+        src_line = src_row.data();
+      }
+      (void)InterpRowGather(src_line, line_ptr[slot], SizeToInt(out_width), x_left_weights_.data(), x_lefts_.data(),
+                            x_rights_.data());
+      line_key[slot] = key;
+      return line_ptr[slot];
+    };
+    for (size_t i = start; i < end; ++i) {
+      size_t plane = i / out_height;
+      size_t h = i % out_height;
+      const float *bottom = get_line(plane, y_bottoms_[h], -1);
+      const float *top = get_line(plane, y_tops_[h], SizeToLong(plane * in_height) + y_bottoms_[h]);
+      T *dst = output_addr + i * out_width;
+      if constexpr (std::is_same_v<T, float>) {
+        (void)InterpCol(bottom, top, dst, 1, y_bottom_weights_[h], SizeToInt(out_width));
+      } else {
+        (void)InterpCol(bottom, top, dst_row.data(), 1, y_bottom_weights_[h], SizeToInt(out_width));
         for (size_t w = 0; w < out_width; ++w) {
-          const size_t xs_lower = xs[w].lower;
-          const size_t xs_upper = xs[w].upper;
-          const float xs_lerp = static_cast<float>(xs[w].lerp);
-          const float top_left(ys_input_lower_ptr[xs_lower]);
-          const float top_right(ys_input_lower_ptr[xs_upper]);
-          const float bottom_left(ys_input_upper_ptr[xs_lower]);
-          const float bottom_right(ys_input_upper_ptr[xs_upper]);
-          cur_output_addr[h * out_width + w] =
-            ComputeLerp(top_left, top_right, bottom_left, bottom_right, xs_lerp, ys_lerp);
-          output_addr_T2[h * out_width + w] = static_cast<T2>(cur_output_addr[h * out_width + w]);
+          dst[w] = static_cast<T>(dst_row[w]);
         }
       }
-      output_addr_T2 += out_hw_size;
-      cur_input_addr += in_hw_size;
-      cur_output_addr += out_hw_size;
     }
-  }
-  if (dtype_ == kNumberTypeFloat16) {
-    free(float_input_addr);
-    free(float_output_addr);
-  }
+  };
+  ParallelLaunchAutoSearch(task, plane_num * out_height, this, &parallel_search_info_);
   return true;
 }
 }  // namespace kernel
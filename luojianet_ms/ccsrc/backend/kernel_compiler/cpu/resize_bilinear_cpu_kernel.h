@@ -22,6 +22,7 @@
 #include <unordered_map>
 #include <vector>
 #include <algorithm>
+#include <type_traits>
 #include "backend/kernel_compiler/cpu/cpu_kernel.h"
 #include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
 
@@ -38,8 +39,8 @@ class ResizeBilinearCPUKernel : public CPUKernel {
               const std::vector<AddressPtr> &outputs) override;
 
  private:
-  template <typename T1, typename T2>
-  bool LaunchKernel(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &outputs) const;
+  template <typename T>
+  bool LaunchKernel(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &outputs);
 
   TypeId dtype_{kTypeUnknown};
   bool align_corners_{false};
@@ -47,6 +48,13 @@ class ResizeBilinearCPUKernel : public CPUKernel {
   float width_scale{1.0};
   std::vector<int64_t> size_;
   std::vector<size_t> shape_;
+  // Interpolation indices and weights of the output rows and columns, in the layout of nnacl resize.
+  std::vector<int> y_bottoms_;
+  std::vector<int> y_tops_;
+  std::vector<float> y_bottom_weights_;
+  std::vector<int> x_lefts_;
+  std::vector<int> x_rights_;
+  std::vector<float> x_left_weights_;
 };
 
 MS_REG_CPU_KERNEL(ResizeBilinear, KernelAttr().AddInputAttr(kNumberTypeFloat16).AddOutputAttr(kNumberTypeFloat16),
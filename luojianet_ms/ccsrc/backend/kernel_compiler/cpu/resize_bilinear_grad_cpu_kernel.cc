@@ -50,6 +50,19 @@ void ResizeBilinearGradCPUKernel::InitKernel(const CNodePtr &kernel_node) {
   size_t out_width = size_[3];
   height_scale = Scaling(out_height, in_height, align_corners_);
   width_scale = Scaling(out_width, in_width, align_corners_);
+
+  ys_.resize(in_height + 1);
+  xs_.resize(in_width + 1);
+  ComputeInterpolationWeights(in_height, out_height, height_scale, ys_.data());
+  ComputeInterpolationWeights(in_width, out_width, width_scale, xs_.data());
+  row_begin_.assign(out_height, in_height);
+  row_end_.assign(out_height, 0);
+  for (size_t h = 0; h < in_height; ++h) {
+    for (size_t row : {ys_[h].lower, ys_[h].upper}) {
+      row_begin_[row] = std::min(row_begin_[row], h);
+      row_end_[row] = std::max(row_end_[row], h + 1);
+    }
+  }
 }
 
 bool ResizeBilinearGradCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
@@ -69,99 +82,61 @@ bool ResizeBilinearGradCPUKernel::Launch(const std::vector<kernel::AddressPtr> &
 
 template <typename T>
 bool ResizeBilinearGradCPUKernel::LaunchKernel(const std::vector<AddressPtr> &inputs,
-                                               const std::vector<AddressPtr> &outputs) const {
+                                               const std::vector<AddressPtr> &outputs) {
+  auto *dloss_addr = reinterpret_cast<T *>(inputs[0]->addr);
   auto *output_addr = reinterpret_cast<T *>(outputs[0]->addr);
-  if (memset_s(output_addr, outputs[0]->size, 0, outputs[0]->size) != EOK) {
-    MS_LOG(EXCEPTION) << "For '" << kernel_name_ << "', output buffer memset failed.";
-  }
-  float *float_dloss_addr = NULL;
-  float *float_output_addr = NULL;
-  if (dtype_ == kNumberTypeFloat16) {
-    auto *input_addr_T = reinterpret_cast<T *>(inputs[0]->addr);
-    size_t input_mem_size = inputs[0]->size / sizeof(T) * sizeof(float);
-    float_dloss_addr = reinterpret_cast<float *>(malloc(input_mem_size));
-    if (float_dloss_addr == NULL) {
-      MS_LOG(ERROR) << "For '" << kernel_name_ << "', malloc memory failed.";
-      return false;
-    }
-    for (size_t i = 0; i < ((inputs[0]->size) / sizeof(T)); ++i) {
-      float_dloss_addr[i] = static_cast<float>(input_addr_T[i]);
-    }
-
-    size_t output_mem_size = outputs[0]->size / sizeof(T) * sizeof(float);
-    float_output_addr = reinterpret_cast<float *>(malloc(output_mem_size));
-    if (float_output_addr == NULL) {
-      free(float_dloss_addr);
-      MS_LOG(ERROR) << "For '" << kernel_name_ << "', malloc memory failed.";
-      return false;
-    }
-    size_t memset_size = outputs[0]->size / sizeof(T) * sizeof(float);
-    if (memset_s(float_output_addr, memset_size, 0, memset_size) != EOK) {
-      free(float_dloss_addr);
-      free(float_output_addr);
-      MS_LOG(EXCEPTION) << "For '" << kernel_name_ << "', output buffer memset failed.";
-    }
-  } else if (dtype_ == kNumberTypeFloat32) {
-    float_dloss_addr = reinterpret_cast<float *>(inputs[0]->addr);
-    float_output_addr = reinterpret_cast<float *>(outputs[0]->addr);
-  } else {
-    MS_LOG(EXCEPTION) << "For '" << kernel_name_ << "', the dtype of input should be float16 or float32, but got "
-                      << TypeIdLabel(dtype_);
-  }
-
-  size_t batch_size = shape_[0];
-  size_t channel = shape_[1];
   size_t in_height = shape_[2];
   size_t in_width = shape_[3];
   size_t out_height = size_[2];
   size_t out_width = size_[3];
-  size_t out_hw_size = out_height * out_width;
+  size_t plane_num = size_[0] * size_[1];
   size_t in_hw_size = in_height * in_width;
 
-  float *cur_dloss_addr = float_dloss_addr;
-  float *cur_output_addr = float_output_addr;
-  for (size_t b = 0; b < batch_size; ++b) {
-    for (size_t c = 0; c < channel; ++c) {
-      for (size_t h = 0; h < in_height; ++h) {
-        const float in_y = static_cast<float>(h) * height_scale;
-        const size_t top_y_index = std::max(static_cast<size_t>(floorf(in_y)), static_cast<size_t>(0));
-        const size_t bottom_y_index = std::min(static_cast<size_t>(ceilf(in_y)), out_height - 1);
-        const float y_lerp = in_y - floorf(in_y);
-        const float inverse_y_lerp = 1.0 - y_lerp;
+  // Every task owns a range of dx rows and gathers the dout rows which flow into them, so the tasks never write to
+  // the same row and the whole dx needs neither a memset nor a float copy.
+  auto task = [this, dloss_addr, output_addr, in_height, in_width, out_height, out_width, in_hw_size](size_t start,
+                                                                                                      size_t end) {
+    std::vector<float> acc_row;
+    if constexpr (!std::is_same_v<T, float>) {
+      acc_row.resize(out_width);
+    }
+    for (size_t i = start; i < end; ++i) {
+      size_t plane = i / out_height;
+      size_t row = i % out_height;
+      T *dst = output_addr + i * out_width;
+      float *acc = nullptr;
+      if constexpr (std::is_same_v<T, float>) {
+        acc = dst;
+      } else {
+        acc = acc_row.data();
+      }
+      (void)std::fill(acc, acc + out_width, 0.0f);
+      for (size_t h = row_begin_[row]; h < row_end_[row]; ++h) {
+        float y_weight = 0.0f;
+        if (ys_[h].lower == row) {
+          y_weight += 1.0f - ys_[h].lerp;
+        }
+        if (ys_[h].upper == row) {
+          y_weight += ys_[h].lerp;
+        }
+        if (y_weight == 0.0f) {
+          continue;
+        }
+        const T *dloss = dloss_addr + plane * in_hw_size + h * in_width;
         for (size_t w = 0; w < in_width; ++w) {
-          const float in_x = static_cast<float>(w) * width_scale;
-          const size_t left_x_index = std::max(static_cast<size_t>(floorf(in_x)), static_cast<size_t>(0));
-          const size_t right_x_index = std::min(static_cast<size_t>(ceilf(in_x)), out_width - 1);
-          const float x_lerp = in_x - floorf(in_x);
-          const float inverse_x_lerp = 1.0 - x_lerp;
-          cur_output_addr[top_y_index * out_width + left_x_index] +=
-            cur_dloss_addr[h * in_width + w] * static_cast<float>(inverse_y_lerp * inverse_x_lerp);
-          cur_output_addr[top_y_index * out_width + right_x_index] +=
-            cur_dloss_addr[h * in_width + w] * static_cast<float>(inverse_y_lerp * x_lerp);
-          cur_output_addr[bottom_y_index * out_width + left_x_index] +=
-            cur_dloss_addr[h * in_width + w] * static_cast<float>(y_lerp * inverse_x_lerp);
-          cur_output_addr[bottom_y_index * out_width + right_x_index] +=
-            cur_dloss_addr[h * in_width + w] * static_cast<float>(y_lerp * x_lerp);
-
-          output_addr[top_y_index * out_width + left_x_index] =
-            static_cast<T>(cur_output_addr[top_y_index * out_width + left_x_index]);
-          output_addr[top_y_index * out_width + right_x_index] =
-            static_cast<T>(cur_output_addr[top_y_index * out_width + right_x_index]);
-          output_addr[bottom_y_index * out_width + left_x_index] =
-            static_cast<T>(cur_output_addr[bottom_y_index * out_width + left_x_index]);
-          output_addr[bottom_y_index * out_width + right_x_index] =
-            static_cast<T>(cur_output_addr[bottom_y_index * out_width + right_x_index]);
+          const float value = static_cast<float>(dloss[w]) * y_weight;
+          acc[xs_[w].lower] += value * (1.0f - xs_[w].lerp);
+          acc[xs_[w].upper] += value * xs_[w].lerp;
+        }
+      }
+      if constexpr (!std::is_same_v<T, float>) {
+        for (size_t w = 0; w < out_width; ++w) {
+          dst[w] = static_cast<T>(acc[w]);
         }
       }
-      output_addr += out_hw_size;
-      cur_dloss_addr += in_hw_size;
-      cur_output_addr += out_hw_size;
     }
-  }
-  if (dtype_ == kNumberTypeFloat16) {
-    free(float_dloss_addr);
-    free(float_output_addr);
-  }
+  };
+  ParallelLaunchAutoSearch(task, plane_num * out_height, this, &parallel_search_info_);
   return true;
 }
 }  // namespace kernel
@@ -22,8 +22,10 @@
 #include <unordered_map>
 #include <vector>
 #include <algorithm>
+#include <type_traits>
 #include "backend/kernel_compiler/cpu/cpu_kernel.h"
 #include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
+#include "backend/kernel_compiler/common_utils.h"
 
 namespace luojianet_ms {
 namespace kernel {
@@ -39,7 +41,7 @@ class ResizeBilinearGradCPUKernel : public CPUKernel {
 
  private:
   template <typename T>
-  bool LaunchKernel(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &outputs) const;
+  bool LaunchKernel(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &outputs);
 
   TypeId dtype_{kTypeUnknown};
   bool align_corners_{false};
@@ -47,6 +49,12 @@ class ResizeBilinearGradCPUKernel : public CPUKernel {
   float width_scale{1.0};
   std::vector<size_t> size_;
   std::vector<size_t> shape_;
+  // Interpolation of every row and column of dout in x.
+  std::vector<CachedInterpolation> ys_;
+  std::vector<CachedInterpolation> xs_;
+  // The rows of dout in [row_begin_[r], row_end_[r]) are the only ones that flow into row r of dx.
+  std::vector<size_t> row_begin_;
+  std::vector<size_t> row_end_;
 };
 
 MS_REG_CPU_KERNEL(
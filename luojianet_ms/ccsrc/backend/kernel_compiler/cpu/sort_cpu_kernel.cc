@@ -15,10 +15,14 @@
  * limitations under the License.
  */
 #include "backend/kernel_compiler/cpu/sort_cpu_kernel.h"
-#include "common/thread_pool.h"
+#include <algorithm>
 
 namespace luojianet_ms {
 namespace kernel {
+namespace {
+constexpr size_t kParallelSortMinSize = 32768;
+}  // namespace
+
 template <typename T>
 void SortCpuKernel<T>::InitKernel(const CNodePtr &kernel_node) {
   MS_EXCEPTION_IF_NULL(kernel_node);
@@ -45,14 +49,24 @@ void SortCpuKernel<T>::InitKernel(const CNodePtr &kernel_node) {
   }
 
   axisIterator_.Init(input_shape, axis_t);
+  if (axisIterator_.AxisSize() > SortKeyUtils::kMaxIndex) {
+    MS_LOG(EXCEPTION) << "For '" << kernel_name_ << "', the size of the sorted axis should be no more than "
+                      << SortKeyUtils::kMaxIndex << ", but got " << axisIterator_.AxisSize();
+  }
+  size_t slice_num = axisIterator_.OuterSize() * axisIterator_.InnerSize();
+  parallel_in_slice_ = axisIterator_.AxisSize() >= kParallelSortMinSize &&
+                       slice_num < GetActorMgrInnerThreadPool()->GetKernelThreadNum();
 }
 
 template <typename T>
 void SortCpuKernel<T>::InitInputOutputSize(const CNodePtr &kernel_node) {
   CPUKernel::InitInputOutputSize(kernel_node);
   size_t element_size = axisIterator_.OuterSize() * axisIterator_.InnerSize() * axisIterator_.AxisSize();
-  // id
-  (void)workspace_size_list_.emplace_back((sizeof(size_t) * element_size));
+  // sort keys
+  (void)workspace_size_list_.emplace_back((sizeof(uint64_t) * element_size));
+  // merge buffer of one slice
+  size_t buffer_size = parallel_in_slice_ ? axisIterator_.AxisSize() : 1;
+  (void)workspace_size_list_.emplace_back((sizeof(uint64_t) * buffer_size));
 }
 
 template <typename T>
@@ -70,7 +84,8 @@ bool SortCpuKernel<T>::Launch(const std::vector<AddressPtr> &inputs, const std::
     MS_LOG(EXCEPTION) << "For '" << kernel_name_ << "', the memory size of inputs error.";
   }
   auto input = reinterpret_cast<T *>(inputs[0]->addr);
-  auto ids_addr = reinterpret_cast<size_t *>(workspace[0]->addr);
+  auto keys_addr = reinterpret_cast<uint64_t *>(workspace[0]->addr);
+  auto buffer = reinterpret_cast<uint64_t *>(workspace[1]->addr);
   auto output = reinterpret_cast<T *>(outputs[0]->addr);
   auto indices = reinterpret_cast<int *>(outputs[1]->addr);
 
@@ -81,40 +96,47 @@ bool SortCpuKernel<T>::Launch(const std::vector<AddressPtr> &inputs, const std::
                       << outputs[0]->size << " and the memory size of input " << inputs[0]->size;
   }
 
-  std::function<bool(size_t, size_t)> comparator;
-  if (descending_) {
-    comparator = [&input](size_t index_1, size_t index_2) { return input[index_1] > input[index_2]; };
-  } else {
-    comparator = [&input](size_t index_1, size_t index_2) { return input[index_1] < input[index_2]; };
-  }
-
-  std::vector<common::Task> tasks;
-  tasks.reserve(axisIterator_.OuterSize() * axisIterator_.InnerSize());
-  for (size_t i = 0; i < axisIterator_.OuterSize(); ++i) {
-    for (size_t j = 0; j < axisIterator_.InnerSize(); ++j) {
-      auto task = [this, i, j, ids_addr, input, indices, output, &comparator]() {
-        AxisIterator iter(axisIterator_);
-        iter.SetOffset(i, j);
-
-        size_t offset = (i * iter.InnerSize() + j) * iter.AxisSize();
-        size_t *idx = ids_addr + offset;
-        for (size_t k = 0; k < iter.AxisSize(); ++k) {
-          idx[k] = iter.GetPos(k);
-        }
-
-        std::stable_sort(idx, idx + iter.AxisSize(), comparator);
+  // The slice is the elements along the axis, and its keys are contiguous in the workspace.
+  const size_t axis_size = axisIterator_.AxisSize();
+  auto pack_keys = [this, input, keys_addr, axis_size](size_t slice, size_t start, size_t end) {
+    AxisIterator iter(axisIterator_);
+    iter.SetOffset(slice / iter.InnerSize(), slice % iter.InnerSize());
+    uint64_t *keys = keys_addr + slice * axis_size;
+    for (size_t k = start; k < end; ++k) {
+      keys[k] = SortKeyUtils::Pack(input[iter.GetPos(k)], k, descending_);
+    }
+  };
+  auto unpack_keys = [this, input, output, indices, keys_addr, axis_size](size_t slice, size_t start, size_t end) {
+    AxisIterator iter(axisIterator_);
+    iter.SetOffset(slice / iter.InnerSize(), slice % iter.InnerSize());
+    const uint64_t *keys = keys_addr + slice * axis_size;
+    for (size_t k = start; k < end; ++k) {
+      const auto index = SortKeyUtils::Index(keys[k]);
+      const auto pos = iter.GetPos(k);
+      indices[pos] = SizeToInt(index);
+      output[pos] = input[iter.GetPos(index)];
+    }
+  };
 
-        for (size_t k = 0; k < iter.AxisSize(); ++k) {
-          const auto index = iter.GetPos(k);
-          indices[index] = iter.RevertPos(idx[k]);
-          output[index] = input[idx[k]];
-        }
-        return common::SUCCESS;
-      };
-      (void)tasks.emplace_back(task);
+  size_t slice_num = axisIterator_.OuterSize() * axisIterator_.InnerSize();
+  if (parallel_in_slice_) {
+    for (size_t slice = 0; slice < slice_num; ++slice) {
+      ParallelLaunch([&pack_keys, slice](size_t start, size_t end) { pack_keys(slice, start, end); }, axis_size);
+      SortKeyUtils::ParallelSort(keys_addr + slice * axis_size, buffer, axis_size);
+      ParallelLaunch([&unpack_keys, slice](size_t start, size_t end) { unpack_keys(slice, start, end); }, axis_size);
     }
+    return true;
   }
-  (void)common::ThreadPool::GetInstance().SyncRun(tasks);
+
+  auto task = [&pack_keys, &unpack_keys, keys_addr, axis_size](size_t start, size_t end) {
+    for (size_t slice = start; slice < end; ++slice) {
+      pack_keys(slice, 0, axis_size);
+      uint64_t *keys = keys_addr + slice * axis_size;
+      std::sort(keys, keys + axis_size);
+      unpack_keys(slice, 0, axis_size);
+    }
+  };
+  ParallelLaunchAutoSearch(task, slice_num, this, &parallel_search_info_);
   return true;
 }
 }  // namespace kernel
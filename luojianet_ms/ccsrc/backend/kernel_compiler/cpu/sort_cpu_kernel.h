@@ -38,6 +38,8 @@ class SortCpuKernel : public CPUKernel {
  private:
   AxisIterator axisIterator_{};
   bool descending_{false};
+  // The huge slices are few, so they are sorted one by one and each with all the kernel threads.
+  bool parallel_in_slice_{false};
 };
 
 MS_REG_CPU_KERNEL_T(
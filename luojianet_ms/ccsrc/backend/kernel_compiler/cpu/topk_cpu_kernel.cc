@@ -18,13 +18,13 @@
 #include "backend/kernel_compiler/cpu/topk_cpu_kernel.h"
 #include <algorithm>
 #include "runtime/device/cpu/cpu_device_address.h"
-#include "common/thread_pool.h"
 
 namespace luojianet_ms {
 namespace kernel {
 namespace {
 constexpr size_t kTopKInputsNum = 2;
 constexpr size_t kTopKOutputsNum = 2;
+constexpr size_t kParallelTopKMinSize = 32768;
 }  // namespace
 
 template <typename T>
@@ -42,7 +42,8 @@ void TopKCPUKernel::LaunchKernel(const std::vector<AddressPtr> &inputs, const st
   }
   auto input = reinterpret_cast<T *>(inputs[0]->addr);
   int k = reinterpret_cast<int *>(inputs[1]->addr)[0];
-  auto workspace = reinterpret_cast<size_t *>(workspaces[0]->addr);
+  auto keys_addr = reinterpret_cast<uint64_t *>(workspaces[0]->addr);
+  auto buffer = reinterpret_cast<uint64_t *>(workspaces[1]->addr);
   auto output = reinterpret_cast<T *>(outputs[0]->addr);
   auto indices = reinterpret_cast<int *>(outputs[1]->addr);
   if (k < 1) {
@@ -53,41 +54,60 @@ void TopKCPUKernel::LaunchKernel(const std::vector<AddressPtr> &inputs, const st
     MS_LOG(EXCEPTION) << "For '" << kernel_name_ << "', address size of output error.";
   }
 
-  const std::function<bool(size_t, size_t)> comparator = [input](size_t index_1, size_t index_2) {
-    return input[index_1] > input[index_2];
+  // The descending keys put the larger value first, and the smaller index first among the equal values.
+  auto pack_keys = [this, input, keys_addr](size_t slice, size_t start, size_t end) {
+    auto base_input = slice * inner_size_;
+    for (size_t j = start; j < end; ++j) {
+      keys_addr[base_input + j] = SortKeyUtils::Pack(input[base_input + j], j, true);
+    }
   };
+  auto write_output = [this, input, output, indices, k_num](size_t slice, const uint64_t *selected) {
+    auto base_input = slice * inner_size_;
+    auto base_output = slice * k_num;
+    for (size_t j = 0; j < k_num; ++j) {
+      auto index = SortKeyUtils::Index(selected[j]);
+      indices[base_output + j] = SizeToInt(index);
+      output[base_output + j] = input[base_input + index];
+    }
+  };
+  // fall back to sort all when most of the slice is selected
+  constexpr float fraction = 0.5;
+  const bool sort_all = sorted_ && k_num > static_cast<size_t>(inner_size_ * fraction);
 
-  std::vector<common::Task> tasks;
-  tasks.reserve(outer_size_);
-  for (size_t i = 0; i < outer_size_; ++i) {
-    (void)tasks.emplace_back([this, i, k_num, &comparator, input, workspace, indices, output]() {
-      size_t *idx = workspace + i * inner_size_;
-      auto base_input = i * inner_size_;
-      std::iota(idx, idx + inner_size_, base_input);
-
+  if (parallel_in_slice_) {
+    for (size_t i = 0; i < outer_size_; ++i) {
+      ParallelLaunch([&pack_keys, i](size_t start, size_t end) { pack_keys(i, start, end); }, inner_size_);
+      uint64_t *keys = keys_addr + i * inner_size_;
+      if (sort_all) {
+        SortKeyUtils::ParallelSort(keys, buffer, inner_size_);
+        write_output(i, keys);
+        continue;
+      }
+      SortKeyUtils::ParallelSelect(keys, buffer, inner_size_, k_num);
       if (sorted_) {
-        constexpr float fraction = 0.5;
-        const size_t threshold = inner_size_ * fraction;
-        // fall back to stable_sort
-        if (k_num > threshold) {
-          std::stable_sort(idx, idx + inner_size_, comparator);
-        } else {
-          std::nth_element(idx, idx + SizeToLong(k_num), idx + inner_size_, comparator);
-          std::stable_sort(idx, idx + SizeToLong(k_num), comparator);
-        }
-      } else {
-        std::nth_element(idx, idx + SizeToLong(k_num), idx + inner_size_, comparator);
+        std::sort(buffer, buffer + k_num);
       }
+      write_output(i, buffer);
+    }
+    return;
+  }
 
-      auto base_output = i * k_num;
-      for (size_t j = 0; j < k_num; ++j) {
-        indices[base_output + j] = SizeToInt(idx[j]) - SizeToInt(base_input);
-        output[base_output + j] = input[idx[j]];
+  auto task = [this, &pack_keys, &write_output, keys_addr, k_num, sort_all](size_t start, size_t end) {
+    for (size_t i = start; i < end; ++i) {
+      pack_keys(i, 0, inner_size_);
+      uint64_t *keys = keys_addr + i * inner_size_;
+      if (sort_all) {
+        std::sort(keys, keys + inner_size_);
+      } else {
+        std::nth_element(keys, keys + k_num, keys + inner_size_);
+        if (sorted_) {
+          std::sort(keys, keys + k_num);
+        }
       }
-      return common::SUCCESS;
-    });
-  }
-  (void)common::ThreadPool::GetInstance().SyncRun(tasks);
+      write_output(i, keys);
+    }
+  };
+  ParallelLaunchAutoSearch(task, outer_size_, this, &parallel_search_info_);
 }
 
 void TopKCPUKernel::InitKernel(const CNodePtr &kernel_node) {
@@ -102,14 +122,24 @@ void TopKCPUKernel::InitKernel(const CNodePtr &kernel_node) {
     outer_size_ *= x_shape_[i];
   }
   inner_size_ = x_shape_[x_shape_.size() - 1];
+  if (inner_size_ > SortKeyUtils::kMaxIndex) {
+    MS_LOG(EXCEPTION) << "For '" << kernel_name_ << "', the size of the last dimension should be no more than "
+                      << SortKeyUtils::kMaxIndex << ", but got " << inner_size_;
+  }
   sorted_ = AnfAlgo::GetNodeAttr<bool>(kernel_node, "sorted");
   dtype_ = AnfAlgo::GetInputDeviceDataType(kernel_node, 0);
+  parallel_in_slice_ =
+    inner_size_ >= kParallelTopKMinSize && outer_size_ < GetActorMgrInnerThreadPool()->GetKernelThreadNum();
 }
 
 void TopKCPUKernel::InitInputOutputSize(const CNodePtr &kernel_node) {
   CPUKernel::InitInputOutputSize(kernel_node);
   size_t element_size = outer_size_ * inner_size_;
-  (void)workspace_size_list_.emplace_back((sizeof(size_t) * element_size));
+  // sort keys
+  (void)workspace_size_list_.emplace_back((sizeof(uint64_t) * element_size));
+  // selection buffer of one slice
+  size_t buffer_size = parallel_in_slice_ ? inner_size_ : 1;
+  (void)workspace_size_list_.emplace_back((sizeof(uint64_t) * buffer_size));
 }
 
 bool TopKCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
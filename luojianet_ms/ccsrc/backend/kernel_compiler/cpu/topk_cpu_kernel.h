@@ -42,6 +42,8 @@ class TopKCPUKernel : public CPUKernel {
   size_t outer_size_{1};
   size_t inner_size_{1};
   bool sorted_{false};
+  // The huge slices are few, so they are selected one by one and each with all the kernel threads.
+  bool parallel_in_slice_{false};
   TypeId dtype_{kTypeUnknown};
 };
 
@@ -111,6 +111,21 @@ std::vector<PrimitivePtr> GraphKernelCluster::GetClusterableOpList() {
     {kCPUDevice, OpLevel_0, prim::kPrimLessEqual},
   };
   const auto &flags = GraphKernelFlags::GetInstance();
+  // the compare and logical ops on cpu are clustered only when the chain fusion is enabled
+  if (flags.enable_cpu_chain_fusion) {
+    std::vector<OpWithLevel> cpu_chain_ops = {
+      {kCPUDevice, OpLevel_0, prim::kPrimFloor},
+      {kCPUDevice, OpLevel_0, prim::kPrimGreater},
+      {kCPUDevice, OpLevel_0, prim::kPrimGreaterEqual},
+      {kCPUDevice, OpLevel_0, prim::kPrimLogicalAnd},
+      {kCPUDevice, OpLevel_0, prim::kPrimLogicalOr},
+      {kCPUDevice, OpLevel_0, prim::kPrimNotEqual},
+      {kCPUDevice, OpLevel_1, prim::kPrimReduceMin},
+      {kCPUDevice, OpLevel_0, prim::kPrimSign},
+    };
+    (void)clusterable_ops_with_level.insert(clusterable_ops_with_level.end(), cpu_chain_ops.begin(),
+                                            cpu_chain_ops.end());
+  }
   return GkUtils::GetValidOps(clusterable_ops_with_level, flags.fusion_ops_level, flags.enable_cluster_ops_only,
                               flags.enable_cluster_ops, flags.disable_cluster_ops);
 }
@@ -89,6 +89,29 @@ std::vector<PrimitivePtr> GetExpandOps() {
     {kCPUDevice, OpLevel_1, prim::kPrimAdam},
   };
   const auto &flags = GraphKernelFlags::GetInstance();
+  // the activation, softmax and loss ops on cpu are expanded only when their chain fusion is enabled
+  if (flags.enable_cpu_chain_fusion) {
+    std::vector<OpWithLevel> cpu_chain_ops = {
+      {kCPUDevice, OpLevel_0, prim::kPrimDropoutGrad},
+      {kCPUDevice, OpLevel_0, prim::kPrimIdentityMath},
+      {kCPUDevice, OpLevel_1, prim::kPrimLayerNorm},
+      {kCPUDevice, OpLevel_1, prim::kPrimLayerNormGrad},
+      {kCPUDevice, OpLevel_0, prim::kPrimLogSoftmax},
+      {kCPUDevice, OpLevel_0, prim::kPrimLogSoftmaxGrad},
+      {kCPUDevice, OpLevel_1, prim::kPrimReduceMean},
+      {kCPUDevice, OpLevel_0, prim::kPrimReluGrad},
+      {kCPUDevice, OpLevel_0, prim::kPrimSigmoid},
+      {kCPUDevice, OpLevel_0, prim::kPrimSigmoidGrad},
+      {kCPUDevice, OpLevel_0, prim::kPrimSigmoidCrossEntropyWithLogits},
+      {kCPUDevice, OpLevel_0, prim::kPrimSigmoidCrossEntropyWithLogitsGrad},
+      {kCPUDevice, OpLevel_1, prim::kPrimSoftmax},
+      {kCPUDevice, OpLevel_1, prim::kPrimSoftmaxCrossEntropyWithLogits},
+      {kCPUDevice, OpLevel_0, prim::kPrimSquaredDifference},
+      {kCPUDevice, OpLevel_0, prim::kPrimSqueeze},
+      {kCPUDevice, OpLevel_0, prim::kPrimTanhGrad},
+    };
+    (void)expand_ops_with_level.insert(expand_ops_with_level.end(), cpu_chain_ops.begin(), cpu_chain_ops.end());
+  }
   return GkUtils::GetValidOps(expand_ops_with_level, flags.fusion_ops_level, flags.enable_expand_ops_only,
                               flags.enable_expand_ops, flags.disable_expand_ops);
 }
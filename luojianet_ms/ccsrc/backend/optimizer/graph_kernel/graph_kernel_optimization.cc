@@ -127,8 +127,9 @@ PassManagerPtr GraphKernelOptimizer::HighLevelOpt1() const {
   pm->AddPass(std::make_shared<GraphKernelCSE>(), OptLevel_2);
 
   // Eliminate unnecessary transform ops
-  auto level = GetPassLevelByFlag(GraphKernelFlags::GetInstance().enable_trans_op_optimize);
-  pm->AddPass(std::make_shared<TransformOpOptimizer>(), level, is_gpu);
+  const auto &flags = GraphKernelFlags::GetInstance();
+  auto level = GetPassLevelByFlag(flags.enable_trans_op_optimize);
+  pm->AddPass(std::make_shared<TransformOpOptimizer>(), level, is_gpu || (is_cpu && flags.enable_cpu_chain_fusion));
   return pm;
 }
 
@@ -125,6 +125,12 @@ DeviceMemPtr DynamicMemPoolBestFit::FindIdleMemBuf(size_t size, bool from_persis
   return nullptr;
 }
 
+void DynamicMemPoolBestFit::ResetUsedMemPeakStatistics() {
+  std::lock_guard<std::mutex> locker(mutex_);
+  common_mem_->mps_.used_mem_peak_size_ = common_mem_->mps_.total_used_mem_size_;
+  persistent_mem_->mps_.used_mem_peak_size_ = persistent_mem_->mps_.total_used_mem_size_;
+}
+
 size_t DynamicMemPoolBestFit::MemAllocUnitSize(bool from_persistent_mem) const {
   return from_persistent_mem ? persistent_mem_->unit_size_ : common_mem_->unit_size_;
 }
@@ -0,0 +1,203 @@
+/**
+ * Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+ * Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "debug/data_dump/e2e_dump_writer.h"
+#include <cstring>
+#include <fstream>
+
+#include "debug/common.h"
+#include "debug/data_dump/dump_json_parser.h"
+#include "debug/data_dump/npy_header.h"
+#include "utils/utils.h"
+
+namespace luojianet_ms {
+E2eDumpWriter::~E2eDumpWriter() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  job_cv_.notify_all();
+  for (auto &writer : writers_) {
+    if (writer.joinable()) {
+      writer.join();
+    }
+  }
+}
+
+void E2eDumpWriter::Start() {
+  ring_ = std::unique_ptr<char[]>(new char[ring_size_]);
+  for (size_t i = 0; i < writer_num_; ++i) {
+    (void)writers_.emplace_back(&E2eDumpWriter::WriterLoop, this);
+  }
+}
+
+bool E2eDumpWriter::DumpToFile(const std::string &filename, const void *data, size_t len, const ShapeVector &shape,
+                               TypeId type) {
+  if (filename.empty() || data == nullptr || len == 0) {
+    MS_LOG(ERROR) << "Incorrect parameter.";
+    return false;
+  }
+  std::string npy_header = GenerateNpyHeader(shape, type);
+  if (npy_header.empty()) {
+    return true;
+  }
+  size_t size = npy_header.size() + len;
+  if (size > ring_size_) {
+    MS_LOG(INFO) << "The tensor of " << len << " bytes is larger than the dump buffer, dump it synchronously.";
+    return DumpJsonParser::DumpToFile(filename, data, len, shape, type);
+  }
+  // create the directory on the calling thread, so the caller knows a bad dump path at once
+  auto file_path = Common::CreatePrefixPath(filename + ".npy");
+  if (!file_path.has_value()) {
+    MS_LOG(ERROR) << "CreatePrefixPath failed.";
+    return false;
+  }
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (writers_.empty()) {
+    Start();
+  }
+  size_t reserved_begin = 0;
+  size_t offset = 0;
+  // back-pressure, wait for the writers when the ring is full
+  room_cv_.wait(lock, [this, size, &reserved_begin, &offset]() { return TryReserve(size, &reserved_begin, &offset); });
+  auto job =
+    std::make_shared<DumpJob>(DumpJob{num_submitted_++, file_path.value(), reserved_begin, offset, size, false});
+  jobs_.push_back(job);
+  lock.unlock();
+
+  // the room is owned by the job until it is done, so the copy doesn't need the lock
+  char *dest = ring_.get() + offset;
+  (void)memcpy(dest, npy_header.data(), npy_header.size());
+  (void)memcpy(dest + npy_header.size(), data, len);
+
+  lock.lock();
+  pending_.push_back(job);
+  lock.unlock();
+  job_cv_.notify_one();
+  return true;
+}
+
+bool E2eDumpWriter::TryReserve(size_t size, size_t *reserved_begin, size_t *offset) {
+  if (used_ == ring_size_) {
+    return false;
+  }
+  if (head_ >= tail_) {
+    if (ring_size_ - head_ >= size) {
+      *reserved_begin = head_;
+      *offset = head_;
+      used_ += size;
+      head_ += size;
+    } else if (tail_ >= size) {
+      // the end of the ring is too small, skip it and start from the beginning
+      *reserved_begin = head_;
+      *offset = 0;
+      used_ += ring_size_ - head_ + size;
+      head_ = size;
+    } else {
+      return false;
+    }
+  } else if (tail_ - head_ >= size) {
+    *reserved_begin = head_;
+    *offset = head_;
+    used_ += size;
+    head_ += size;
+  } else {
+    return false;
+  }
+  if (head_ == ring_size_) {
+    head_ = 0;
+  }
+  return true;
+}
+
+void E2eDumpWriter::Release() {
+  while (!jobs_.empty() && jobs_.front()->done) {
+    const auto &job = jobs_.front();
+    size_t padding = job->offset >= job->reserved_begin ? job->offset - job->reserved_begin
+                                                        : ring_size_ - job->reserved_begin;
+    used_ -= padding + job->size;
+    jobs_.pop_front();
+  }
+  if (jobs_.empty()) {
+    // start over from the beginning to have the largest contiguous room
+    head_ = 0;
+    tail_ = 0;
+  } else {
+    tail_ = jobs_.front()->reserved_begin;
+  }
+}
+
+void E2eDumpWriter::WriterLoop() {
+  while (true) {
+    std::shared_ptr<DumpJob> job;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      job_cv_.wait(lock, [this]() { return stop_ || !pending_.empty(); });
+      // the pending files are still saved when stopping
+      if (pending_.empty()) {
+        return;
+      }
+      job = pending_.front();
+      pending_.pop_front();
+    }
+    bool ret = WriteFile(*job);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!ret) {
+        failed_files_.push_back(job->file_path);
+      }
+      job->done = true;
+      Release();
+    }
+    room_cv_.notify_all();
+    done_cv_.notify_all();
+  }
+}
+
+bool E2eDumpWriter::WriteFile(const DumpJob &job) {
+  const std::string &file_path = job.file_path;
+  ChangeFileMode(file_path, S_IWUSR);
+  std::ofstream fd(file_path, std::ios::out | std::ios::trunc | std::ios::binary);
+  if (!fd.is_open()) {
+    MS_LOG(ERROR) << "Open file " << file_path << " failed." << ErrnoToString(errno);
+    return false;
+  }
+  (void)fd.write(ring_.get() + job.offset, SizeToLong(job.size));
+  if (fd.bad()) {
+    fd.close();
+    MS_LOG(ERROR) << "Write mem to file " << file_path << " failed.";
+    return false;
+  }
+  fd.close();
+  ChangeFileMode(file_path, S_IRUSR);
+  return true;
+}
+
+bool E2eDumpWriter::Flush() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  done_cv_.wait(lock, [this]() { return jobs_.empty(); });
+  if (failed_files_.empty()) {
+    return true;
+  }
+  for (const auto &file : failed_files_) {
+    MS_LOG(ERROR) << "Save dump file " << file << " failed.";
+  }
+  failed_files_.clear();
+  return false;
+}
+}  // namespace luojianet_ms
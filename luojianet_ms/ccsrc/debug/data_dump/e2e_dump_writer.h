@@ -0,0 +1,98 @@
+/**
+ * Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+ * Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LUOJIANET_MS_LUOJIANET_MS_CCSRC_DEBUG_DATA_DUMP_E2E_DUMP_WRITER_H_
+#define LUOJIANET_MS_LUOJIANET_MS_CCSRC_DEBUG_DATA_DUMP_E2E_DUMP_WRITER_H_
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "utils/ms_utils.h"
+#include "luojianet_ms/core/utils/shape_utils.h"
+#include "luojianet_ms/core/ir/dtype/type_id.h"
+
+namespace luojianet_ms {
+// Writes the e2e dump files in background threads. The tensor is copied together with its npy header into a ring
+// buffer on the calling thread, and the writer threads save each file with one sequential write. The caller is
+// blocked when the ring buffer is full, until the writers have released enough room. The files are written while
+// the kernels of the step are running, and the step waits for all of them in Flush before it returns.
+class E2eDumpWriter {
+ public:
+  static constexpr size_t kDefaultRingSize = 256 << 20;
+  static constexpr size_t kDefaultWriterNum = 2;
+
+  static E2eDumpWriter &GetInstance() {
+    static E2eDumpWriter instance;
+    return instance;
+  }
+
+  explicit E2eDumpWriter(size_t ring_size = kDefaultRingSize, size_t writer_num = kDefaultWriterNum)
+      : ring_size_(ring_size), writer_num_(writer_num) {}
+  ~E2eDumpWriter();
+
+  // Save the tensor to filename.npy in background, a tensor larger than the ring buffer is saved synchronously.
+  // Return false if the parameters are invalid or the directory of the file can't be created, the errors of
+  // writing the file in background are reported by Flush.
+  bool DumpToFile(const std::string &filename, const void *data, size_t len, const ShapeVector &shape, TypeId type);
+
+  // Wait for all the submitted files to be saved, return false if any of them failed since the last flush.
+  bool Flush();
+
+ private:
+  struct DumpJob {
+    uint64_t seq;
+    std::string file_path;
+    size_t reserved_begin;  // where the room of the job starts in the ring, including the padding before offset
+    size_t offset;          // where the content of the file starts in the ring
+    size_t size;
+    bool done;
+  };
+
+  DISABLE_COPY_AND_ASSIGN(E2eDumpWriter)
+
+  void Start();
+  void WriterLoop();
+  // Reserve size bytes of contiguous room in the ring, return false if there is not enough room now
+  bool TryReserve(size_t size, size_t *reserved_begin, size_t *offset);
+  // Release the room of the leading jobs which are done
+  void Release();
+  bool WriteFile(const DumpJob &job);
+
+  std::mutex mutex_;
+  std::condition_variable room_cv_;  // notified when room is released in the ring
+  std::condition_variable job_cv_;   // notified when a job is added or the writer is stopping
+  std::condition_variable done_cv_;  // notified when a job is done
+  const size_t ring_size_;
+  const size_t writer_num_;
+  std::unique_ptr<char[]> ring_;
+  size_t head_{0};  // where the next job is put
+  size_t tail_{0};  // where the oldest job in the ring starts
+  size_t used_{0};  // bytes in use, including the padding at the end of the ring
+  std::deque<std::shared_ptr<DumpJob>> jobs_;     // jobs in the ring, in the order of submission
+  std::deque<std::shared_ptr<DumpJob>> pending_;  // jobs not taken by the writers yet
+  uint64_t num_submitted_{0};
+  std::vector<std::string> failed_files_;  // files failed to be saved since the last flush
+  bool stop_{false};
+  std::vector<std::thread> writers_;
+};
+}  // namespace luojianet_ms
+#endif  // LUOJIANET_MS_LUOJIANET_MS_CCSRC_DEBUG_DATA_DUMP_E2E_DUMP_WRITER_H_
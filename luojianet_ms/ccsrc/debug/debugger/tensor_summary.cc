@@ -109,6 +109,7 @@ TensorSummary<T>::TensorSummary(const void *current_tensor_ptr, const void *cons
       inf_count_(0),
       nan_count_(0),
       zero_count_(0),
+      value_count_(0),
       epsilon_(1.0e-9),
       mean_sd_cal_enabled_(false) {}
 
@@ -200,8 +201,12 @@ void TensorSummary<T>::TensorStatistics(DbgDataType dtype_value) {
     num_elements_ += cur_summary.num_elements_;
     min_ = std::min(min_, cur_summary.min_);
     max_ = std::max(max_, cur_summary.max_);
-    double avg_delta = cur_summary.avg_ - avg_;
-    avg_ += avg_delta * (cur_summary.num_elements_ / num_elements_);
+    // the avg of a chunk is taken over its finite elements only, weight it by them
+    value_count_ += cur_summary.value_count_;
+    if (cur_summary.value_count_ > 0) {
+      double avg_delta = cur_summary.avg_ - avg_;
+      avg_ += avg_delta * static_cast<double>(cur_summary.value_count_) / value_count_;
+    }
     neg_zero_count_ += cur_summary.neg_zero_count_;
     pos_zero_count_ += cur_summary.pos_zero_count_;
     neg_inf_count_ += cur_summary.neg_inf_count_;
@@ -214,35 +219,45 @@ void TensorSummary<T>::TensorStatistics(DbgDataType dtype_value) {
 
 template <typename T>
 void TensorSummary<T>::TensorStatisticsSingleThread() {
-  MeanCalculator mean_calc = MeanCalculator();
+  // The counters and the sum are kept in locals and the loop has no data dependent branches, so NaN/Inf heavy tensors
+  // don't mispredict. Without -ffast-math the compiler still doesn't vectorize the double sum and min/max.
+  uint32_t pos_inf_count = 0;
+  uint32_t neg_inf_count = 0;
+  uint32_t nan_count = 0;
+  uint32_t zero_count = 0;
+  uint32_t neg_count = 0;
+  uint32_t pos_count = 0;
+  uint32_t value_count = 0;
+  double sum = 0.0;
+  double min_value = min_;
+  double max_value = max_;
   for (size_t i = 0; i < num_elements_; ++i) {
     auto current_value = static_cast<double>(current_tensor_ptr_[i]);
-    if (std::isinf(current_value)) {
-      if (current_value > 0) {
-        pos_inf_count_ += 1;
-      } else {
-        neg_inf_count_ += 1;
-      }
-    }
-    if (current_value == 0) {
-      zero_count_ += 1;
-    }
-    if (std::isnan(current_value)) {
-      nan_count_ += 1;
-    }
-    if (!(std::isnan(current_value) || std::isinf(current_value))) {
-      // only considering tensor elements with value
-      if (std::signbit(current_value) && !(current_value == 0)) {
-        neg_zero_count_ += 1;
-      } else if (!(current_value == 0)) {
-        pos_zero_count_ += 1;
-      }
-      max_ = std::max(max_, current_value);
-      min_ = std::min(min_, current_value);
-      mean_calc.ProcessElement(current_value);
-    }
+    // only considering tensor elements with value, x - x is nan for both inf and nan
+    bool is_nan = current_value != current_value;
+    bool is_finite = (current_value - current_value) == 0;
+    bool is_inf = !is_nan && !is_finite;
+    pos_inf_count += static_cast<uint32_t>(is_inf && current_value > 0);
+    neg_inf_count += static_cast<uint32_t>(is_inf && current_value < 0);
+    nan_count += static_cast<uint32_t>(is_nan);
+    zero_count += static_cast<uint32_t>(current_value == 0);
+    neg_count += static_cast<uint32_t>(is_finite && current_value < 0);
+    pos_count += static_cast<uint32_t>(is_finite && current_value > 0);
+    value_count += static_cast<uint32_t>(is_finite);
+    sum += is_finite ? current_value : 0.0;
+    min_value = (is_finite && current_value < min_value) ? current_value : min_value;
+    max_value = (is_finite && current_value > max_value) ? current_value : max_value;
   }
-  avg_ = mean_calc.GetMean();
+  pos_inf_count_ += pos_inf_count;
+  neg_inf_count_ += neg_inf_count;
+  nan_count_ += nan_count;
+  zero_count_ += zero_count;
+  neg_zero_count_ += neg_count;
+  pos_zero_count_ += pos_count;
+  value_count_ += value_count;
+  min_ = min_value;
+  max_ = max_value;
+  avg_ = value_count > 0 ? sum / value_count : 0.0;
 }
 
 template <typename T>
@@ -153,6 +153,7 @@ class TensorSummary : public ITensorSummary {
   uint32_t inf_count_;
   uint32_t nan_count_;
   uint32_t zero_count_;
+  uint32_t value_count_;  // number of the finite elements, which the avg is taken over
   double epsilon_;
   bool mean_sd_cal_enabled_;
   VarianceAndMeanCalculator current_mean_variance_;
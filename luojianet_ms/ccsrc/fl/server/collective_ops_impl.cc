@@ -16,10 +16,56 @@
  */
 
 #include "fl/server/collective_ops_impl.h"
+#include <algorithm>
 
 namespace luojianet_ms {
 namespace fl {
 namespace server {
+namespace {
+template <typename T>
+void ReduceData(T *dst, const T *src, size_t count, CollectiveReduceType reduce_type) {
+  // Keep the switch out of the loops so that every loop is a plain elementwise loop the compiler can vectorize.
+  switch (reduce_type) {
+    case CollectiveReduceType::kSum:
+      for (size_t i = 0; i < count; i++) {
+        dst[i] += src[i];
+      }
+      break;
+    case CollectiveReduceType::kMax:
+      for (size_t i = 0; i < count; i++) {
+        dst[i] = std::max(dst[i], src[i]);
+      }
+      break;
+    case CollectiveReduceType::kMin:
+      for (size_t i = 0; i < count; i++) {
+        dst[i] = std::min(dst[i], src[i]);
+      }
+      break;
+    case CollectiveReduceType::kProd:
+      for (size_t i = 0; i < count; i++) {
+        dst[i] *= src[i];
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+// Split count elements into rank_size chunks, the first (count % rank_size) chunks get one more element.
+void SplitChunks(size_t count, uint32_t rank_size, std::vector<size_t> *chunk_sizes,
+                 std::vector<size_t> *chunk_offset) {
+  size_t chunk_size = count / rank_size;
+  size_t remainder_size = count % rank_size;
+  size_t offset = 0;
+  for (size_t i = 0; i < rank_size; i++) {
+    size_t size = i < remainder_size ? chunk_size + 1 : chunk_size;
+    chunk_sizes->push_back(size);
+    chunk_offset->push_back(offset);
+    offset += size;
+  }
+}
+}  // namespace
+
 void CollectiveOpsImpl::Initialize(const std::shared_ptr<ps::core::ServerNode> &server_node) {
   MS_EXCEPTION_IF_NULL(server_node);
   server_node_ = server_node;
@@ -413,6 +459,178 @@ bool CollectiveOpsImpl::Broadcast(const void *sendbuff, void *const recvbuff, si
   return Broadcast<T>(sendbuff, recvbuff, count, root, group_info);
 }
 
+bool CollectiveOpsImpl::InitGroupComm(const std::shared_ptr<ps::core::AbstractNode> &node,
+                                      const CommunicationGroupInfo &group_info) {
+  node_ = node;
+  node_role_ = node_->role();
+  rank_id_ = node_->rank_id();
+  rank_size_ = group_info.size;
+  if (rank_size_ == 0) {
+    MS_LOG(ERROR) << "Rank size should not be 0.";
+    return false;
+  }
+  if (group_info.group_to_global_ranks.size() != rank_size_ || group_info.global_to_group_ranks.count(rank_id_) == 0) {
+    MS_LOG(ERROR) << "The process of rank " << rank_id_ << " is not in the group of size " << rank_size_;
+    return false;
+  }
+  return true;
+}
+
+template <typename T>
+bool CollectiveOpsImpl::RingPass(T *buff, const std::vector<size_t> &chunk_sizes,
+                                 const std::vector<size_t> &chunk_offset, size_t first_send_chunk, bool reduce,
+                                 CollectiveReduceType reduce_type, const CommunicationGroupInfo &group_info) {
+  MS_ERROR_IF_NULL_W_RET_VAL(node_, false);
+  MS_ERROR_IF_NULL_W_RET_VAL(buff, false);
+  const auto &group_to_global_ranks = group_info.group_to_global_ranks;
+  uint32_t group_rank = group_info.global_to_group_ranks.at(rank_id_);
+  uint32_t send_to_rank = group_to_global_ranks.at((group_rank + 1) % rank_size_);
+  uint32_t recv_from_rank = group_to_global_ranks.at((group_rank - 1 + rank_size_) % rank_size_);
+  size_t segment_size = std::max(kRingSegmentBytes / sizeof(T), static_cast<size_t>(1));
+  MS_LOG(DEBUG) << "Ring pass rank_size:" << rank_size_ << ", group_rank:" << group_rank
+                << ", chunk_sizes:" << chunk_sizes << ", send_to_rank:" << send_to_rank
+                << ", recv_from_rank:" << recv_from_rank << ", reduce:" << reduce;
+
+  std::vector<uint64_t> send_req_ids;
+  // Step 0 sends the whole first chunk. Every later step forwards the segments received in the previous step one by
+  // one, so the ring works as a pipeline instead of waiting for complete chunks.
+  T *first_chunk = buff + chunk_offset[first_send_chunk];
+  for (size_t pos = 0; pos < chunk_sizes[first_send_chunk]; pos += segment_size) {
+    size_t num = std::min(segment_size, chunk_sizes[first_send_chunk] - pos);
+    send_req_ids.push_back(node_->CollectiveSendAsync(node_role_, send_to_rank, first_chunk + pos, num * sizeof(T)));
+  }
+  for (size_t i = 0; i < rank_size_ - 1; i++) {
+    size_t recv_chunk_index = (first_send_chunk + rank_size_ - 1 - i) % rank_size_;
+    T *recv_chunk = buff + chunk_offset[recv_chunk_index];
+    bool forward = i + 2 < rank_size_;
+    for (size_t pos = 0; pos < chunk_sizes[recv_chunk_index]; pos += segment_size) {
+      size_t num = std::min(segment_size, chunk_sizes[recv_chunk_index] - pos);
+      std::shared_ptr<std::vector<unsigned char>> recv_str;
+      auto recv_req_id = node_->CollectiveReceiveAsync(node_role_, recv_from_rank, &recv_str);
+      if (!node_->CollectiveWait(recv_req_id, kCollectiveCommTimeout)) {
+        MS_LOG(ERROR) << "CollectiveWait " << recv_req_id << " failed.";
+        return false;
+      }
+      if (recv_str == nullptr || recv_str->size() != num * sizeof(T)) {
+        MS_LOG(ERROR) << "The received segment of chunk " << recv_chunk_index << " should have " << num * sizeof(T)
+                      << " bytes.";
+        return false;
+      }
+      if (reduce) {
+        ReduceData(recv_chunk + pos, reinterpret_cast<const T *>(recv_str->data()), num, reduce_type);
+      } else {
+        int ret = memcpy_s(recv_chunk + pos, num * sizeof(T), recv_str->data(), recv_str->size());
+        if (ret != 0) {
+          MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")";
+          return false;
+        }
+      }
+      if (forward) {
+        send_req_ids.push_back(node_->CollectiveSendAsync(node_role_, send_to_rank, recv_chunk + pos, num * sizeof(T)));
+      }
+    }
+  }
+  for (auto send_req_id : send_req_ids) {
+    if (!node_->Wait(send_req_id, kCollectiveCommTimeout)) {
+      MS_LOG(ERROR) << "CollectiveWait " << send_req_id << " failed.";
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename T>
+bool CollectiveOpsImpl::AllReduce(const void *sendbuff, void *recvbuff, size_t count, CollectiveReduceType reduce_type,
+                                  const std::shared_ptr<ps::core::AbstractNode> &node,
+                                  const CommunicationGroupInfo &group_info) {
+  std::unique_lock<std::mutex> lock(mtx_);
+  MS_ERROR_IF_NULL_W_RET_VAL(node, false);
+  MS_ERROR_IF_NULL_W_RET_VAL(recvbuff, false);
+  MS_ERROR_IF_NULL_W_RET_VAL(sendbuff, false);
+  if (!InitGroupComm(node, group_info)) {
+    return false;
+  }
+  if (recvbuff != sendbuff) {
+    int ret = memcpy_s(recvbuff, count * sizeof(T), sendbuff, count * sizeof(T));
+    if (ret != 0) {
+      MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")";
+      return false;
+    }
+  }
+  if (rank_size_ == 1) {
+    MS_LOG(DEBUG) << "Rank size is 1. Do nothing.";
+    return true;
+  }
+
+  std::vector<size_t> chunk_sizes;
+  std::vector<size_t> chunk_offset;
+  SplitChunks(count, rank_size_, &chunk_sizes, &chunk_offset);
+  T *output_buff = reinterpret_cast<T *>(recvbuff);
+  uint32_t group_rank = group_info.global_to_group_ranks.at(rank_id_);
+  MS_LOG(DEBUG) << "Start Ring ReduceScatter of AllReduce, count:" << count;
+  if (!RingPass<T>(output_buff, chunk_sizes, chunk_offset, group_rank, true, reduce_type, group_info)) {
+    return false;
+  }
+  // The process holds the reduced chunk (group_rank + 1) now, gather the others around the ring.
+  MS_LOG(DEBUG) << "Start Ring AllGather of AllReduce.";
+  if (!RingPass<T>(output_buff, chunk_sizes, chunk_offset, (group_rank + 1) % rank_size_, false, reduce_type,
+                   group_info)) {
+    return false;
+  }
+  MS_LOG(DEBUG) << "End Ring AllReduce.";
+  return true;
+}
+
+template <typename T>
+bool CollectiveOpsImpl::ReduceScatter(const void *sendbuff, void *recvbuff, size_t recv_count,
+                                      CollectiveReduceType reduce_type,
+                                      const std::shared_ptr<ps::core::AbstractNode> &node,
+                                      const CommunicationGroupInfo &group_info) {
+  std::unique_lock<std::mutex> lock(mtx_);
+  MS_ERROR_IF_NULL_W_RET_VAL(node, false);
+  MS_ERROR_IF_NULL_W_RET_VAL(recvbuff, false);
+  MS_ERROR_IF_NULL_W_RET_VAL(sendbuff, false);
+  if (!InitGroupComm(node, group_info)) {
+    return false;
+  }
+  if (rank_size_ == 1) {
+    int ret = memcpy_s(recvbuff, recv_count * sizeof(T), sendbuff, recv_count * sizeof(T));
+    if (ret != 0) {
+      MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")";
+      return false;
+    }
+    return true;
+  }
+
+  // The ring reduces in place, so work on a copy and keep the input untouched.
+  size_t count = recv_count * rank_size_;
+  std::unique_ptr<T[]> work_buff = std::make_unique<T[]>(count);
+  MS_EXCEPTION_IF_NULL(work_buff);
+  int ret = memcpy_s(work_buff.get(), count * sizeof(T), sendbuff, count * sizeof(T));
+  if (ret != 0) {
+    MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")";
+    return false;
+  }
+  std::vector<size_t> chunk_sizes(rank_size_, recv_count);
+  std::vector<size_t> chunk_offset;
+  for (size_t i = 0; i < rank_size_; i++) {
+    chunk_offset.push_back(i * recv_count);
+  }
+  // Start one chunk behind, so that the pass ends with the process holding the chunk of its own group rank.
+  uint32_t group_rank = group_info.global_to_group_ranks.at(rank_id_);
+  if (!RingPass<T>(work_buff.get(), chunk_sizes, chunk_offset, (group_rank + rank_size_ - 1) % rank_size_, true,
+                   reduce_type, group_info)) {
+    return false;
+  }
+  ret = memcpy_s(recvbuff, recv_count * sizeof(T), work_buff.get() + chunk_offset[group_rank], recv_count * sizeof(T));
+  if (ret != 0) {
+    MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")";
+    return false;
+  }
+  MS_LOG(DEBUG) << "End Ring ReduceScatter.";
+  return true;
+}
+
 bool CollectiveOpsImpl::ReInitForScaling() {
   // If CollectiveOpsImpl is not initialized yet but the scaling event is triggered, do not throw exception.
   if (server_node_ == nullptr) {
@@ -474,6 +692,32 @@ template bool CollectiveOpsImpl::Broadcast<int>(const void *sendbuff, void *recv
                                                 const CommunicationGroupInfo &group_info);
 template bool CollectiveOpsImpl::Broadcast<char>(const void *sendbuff, void *recvbuff, size_t count, uint32_t root,
                                                  const CommunicationGroupInfo &group_info);
+
+template bool CollectiveOpsImpl::AllReduce<float>(const void *sendbuff, void *recvbuff, size_t count,
+                                                  CollectiveReduceType reduce_type,
+                                                  const std::shared_ptr<ps::core::AbstractNode> &node,
+                                                  const CommunicationGroupInfo &group_info);
+template bool CollectiveOpsImpl::AllReduce<float16>(const void *sendbuff, void *recvbuff, size_t count,
+                                                    CollectiveReduceType reduce_type,
+                                                    const std::shared_ptr<ps::core::AbstractNode> &node,
+                                                    const CommunicationGroupInfo &group_info);
+template bool CollectiveOpsImpl::AllReduce<int>(const void *sendbuff, void *recvbuff, size_t count,
+                                                CollectiveReduceType reduce_type,
+                                                const std::shared_ptr<ps::core::AbstractNode> &node,
+                                                const CommunicationGroupInfo &group_info);
+
+template bool CollectiveOpsImpl::ReduceScatter<float>(const void *sendbuff, void *recvbuff, size_t recv_count,
+                                                      CollectiveReduceType reduce_type,
+                                                      const std::shared_ptr<ps::core::AbstractNode> &node,
+                                                      const CommunicationGroupInfo &group_info);
+template bool CollectiveOpsImpl::ReduceScatter<float16>(const void *sendbuff, void *recvbuff, size_t recv_count,
+                                                        CollectiveReduceType reduce_type,
+                                                        const std::shared_ptr<ps::core::AbstractNode> &node,
+                                                        const CommunicationGroupInfo &group_info);
+template bool CollectiveOpsImpl::ReduceScatter<int>(const void *sendbuff, void *recvbuff, size_t recv_count,
+                                                    CollectiveReduceType reduce_type,
+                                                    const std::shared_ptr<ps::core::AbstractNode> &node,
+                                                    const CommunicationGroupInfo &group_info);
 }  // namespace server
 }  // namespace fl
 }  // namespace luojianet_ms
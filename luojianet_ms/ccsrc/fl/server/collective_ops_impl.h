@@ -27,6 +27,7 @@
 #include "ps/ps_context.h"
 #include "ps/core/server_node.h"
 #include "fl/server/common.h"
+#include "base/float16.h"
 
 namespace luojianet_ms {
 namespace fl {
@@ -34,6 +35,13 @@ namespace server {
 // The timeout for server collective communication in case of network jitter.
 constexpr uint32_t kCollectiveCommTimeout = 30;
 
+// The ring collectives send every chunk in segments of this size, so reducing a received segment overlaps with the
+// transfer of the next one and the segment is forwarded to the next rank as soon as it is reduced.
+constexpr size_t kRingSegmentBytes = 1 << 20;
+
+// The reduce operations supported by the group collectives.
+enum class CollectiveReduceType { kSum = 0, kMax, kMin, kProd };
+
 // The collective communication groups which are composed of multiple processes. Refer to MPI_Group.
 struct CommunicationGroupInfo {
   // This group's rank size.
@@ -75,6 +83,17 @@ class CollectiveOpsImpl {
   bool Broadcast(const void *sendbuff, void *recvbuff, size_t count, uint32_t root,
                  const std::shared_ptr<ps::core::AbstractNode> &node, const CommunicationGroupInfo &group_info);
 
+  // Chunked and pipelined ring AllReduce within the specified group.
+  template <typename T>
+  bool AllReduce(const void *sendbuff, void *recvbuff, size_t count, CollectiveReduceType reduce_type,
+                 const std::shared_ptr<ps::core::AbstractNode> &node, const CommunicationGroupInfo &group_info);
+
+  // Chunked and pipelined ring ReduceScatter within the specified group. The sendbuff holds recv_count elements for
+  // every process of the group, the process with group rank i gets the i-th slice of the reduced data.
+  template <typename T>
+  bool ReduceScatter(const void *sendbuff, void *recvbuff, size_t recv_count, CollectiveReduceType reduce_type,
+                     const std::shared_ptr<ps::core::AbstractNode> &node, const CommunicationGroupInfo &group_info);
+
   // Reinitialize the ring for collective communication after scaling operations are done.
   bool ReInitForScaling();
 
@@ -107,6 +126,17 @@ class CollectiveOpsImpl {
   bool Broadcast(const void *sendbuff, void *recvbuff, size_t count, uint32_t root,
                  const CommunicationGroupInfo &group_info);
 
+  // Initialize the collective communication parameters of the group collectives.
+  bool InitGroupComm(const std::shared_ptr<ps::core::AbstractNode> &node, const CommunicationGroupInfo &group_info);
+
+  // One pass around the ring of the group. In step i the process sends chunk (first_send_chunk - i) and receives chunk
+  // (first_send_chunk - i - 1), which it reduces into buff when reduce is true or stores otherwise. After the pass,
+  // the process holds the complete chunk (first_send_chunk + 1). Chunks are indexed by group rank.
+  template <typename T>
+  bool RingPass(T *buff, const std::vector<size_t> &chunk_sizes, const std::vector<size_t> &chunk_offset,
+                size_t first_send_chunk, bool reduce, CollectiveReduceType reduce_type,
+                const CommunicationGroupInfo &group_info);
+
   std::shared_ptr<ps::core::ServerNode> server_node_;
   uint32_t rank_id_;
   uint32_t server_num_;
@@ -117,6 +117,9 @@ using UploadData = std::map<std::string, Address>;
 
 constexpr auto kWeight = "weight";
 constexpr auto kNewWeight = "new_weight";
+constexpr auto kNewWeightFp16 = "new_weight_fp16";
+constexpr auto kNewWeightInt8 = "new_weight_int8";
+constexpr auto kQuantParam = "quant_param";
 constexpr auto kAccumulation = "accum";
 constexpr auto kLearningRate = "lr";
 constexpr auto kGradient = "grad";
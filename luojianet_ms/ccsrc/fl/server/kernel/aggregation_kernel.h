@@ -65,6 +65,11 @@ class AggregationKernel : public CPUKernel {
     return;
   }
 
+  // Some kernels accumulate the data uploaded by workers straight from the request, which saves copying it to the
+  // inputs first and allows compressed uploads. For example, FedAvgKernel.
+  virtual bool SupportUploadData() const { return false; }
+  virtual bool LaunchWithUploadData(const UploadData &) { return false; }
+
   // Reinitialize aggregation kernel after scaling operations are done.
   virtual bool ReInitForScaling() { return true; }
 
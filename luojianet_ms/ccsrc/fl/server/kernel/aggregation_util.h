@@ -0,0 +1,91 @@
+/**
+ * Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+ * Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LUOJIANET_MS_CCSRC_FL_SERVER_KERNEL_AGGREGATION_UTIL_H_
+#define LUOJIANET_MS_CCSRC_FL_SERVER_KERNEL_AGGREGATION_UTIL_H_
+
+#include <cstdint>
+#include "base/float16.h"
+#include "backend/kernel_compiler/cpu/cpu_kernel.h"
+
+namespace luojianet_ms {
+namespace fl {
+namespace server {
+namespace kernel {
+using luojianet_ms::kernel::CPUKernelUtils;
+
+// The element number of each task when an aggregation is split over the thread pool. It's large enough to amortize
+// the scheduling, and each task runs a plain loop which the compiler vectorizes.
+constexpr float kAggregationBlockSize = 32768.0;
+
+// Run the task over [0, count) in blocks on the thread pool.
+inline void ParallelAggregate(const CTask &task, size_t count) {
+  if (count == 0) {
+    return;
+  }
+  CPUKernelUtils::ParallelFor(task, count, kAggregationBlockSize);
+}
+
+// dst[i] += src[i]
+template <typename T>
+void AccumulateData(T *dst, const T *src, size_t count) {
+  auto task = [dst, src](size_t start, size_t end) {
+    for (size_t i = start; i < end; i++) {
+      dst[i] += src[i];
+    }
+  };
+  ParallelAggregate(task, count);
+}
+
+// dst[i] += src[i], with the float16 data uploaded by the client converted on the fly.
+template <typename T>
+void AccumulateFp16Data(T *dst, const float16 *src, size_t count) {
+  auto task = [dst, src](size_t start, size_t end) {
+    for (size_t i = start; i < end; i++) {
+      dst[i] += static_cast<T>(static_cast<float>(src[i]));
+    }
+  };
+  ParallelAggregate(task, count);
+}
+
+// dst[i] += (src[i] - zero_point) * scale, with the int8 data uploaded by the client dequantized on the fly.
+template <typename T>
+void AccumulateInt8Data(T *dst, const int8_t *src, size_t count, float scale, int32_t zero_point) {
+  auto task = [dst, src, scale, zero_point](size_t start, size_t end) {
+    for (size_t i = start; i < end; i++) {
+      dst[i] += static_cast<T>(static_cast<float>(static_cast<int32_t>(src[i]) - zero_point) * scale);
+    }
+  };
+  ParallelAggregate(task, count);
+}
+
+// dst[i] /= divisor
+template <typename T, typename S>
+void DivideData(T *dst, size_t count, S divisor) {
+  T value = static_cast<T>(divisor);
+  auto task = [dst, value](size_t start, size_t end) {
+    for (size_t i = start; i < end; i++) {
+      dst[i] /= value;
+    }
+  };
+  ParallelAggregate(task, count);
+}
+}  // namespace kernel
+}  // namespace server
+}  // namespace fl
+}  // namespace luojianet_ms
+#endif  // LUOJIANET_MS_CCSRC_FL_SERVER_KERNEL_AGGREGATION_UTIL_H_
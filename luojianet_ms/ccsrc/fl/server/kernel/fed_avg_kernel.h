@@ -29,6 +29,7 @@
 #include "fl/server/distributed_count_service.h"
 #include "fl/server/local_meta_store.h"
 #include "fl/server/kernel/aggregation_kernel.h"
+#include "fl/server/kernel/aggregation_util.h"
 #include "fl/server/kernel/aggregation_kernel_factory.h"
 
 namespace luojianet_ms {
@@ -103,9 +104,7 @@ class FedAvgKernel : public AggregationKernel {
         return;
       }
       LocalMetaStore::GetInstance().put_value(kCtxFedAvgTotalDataSize, data_size_addr[0]);
-      for (size_t i = 0; i < weight_size / sizeof(T); i++) {
-        weight_addr[i] /= data_size_addr[0];
-      }
+      DivideData(weight_addr, weight_size / sizeof(T), data_size_addr[0]);
       done_ = true;
       return;
     };
@@ -138,16 +137,78 @@ class FedAvgKernel : public AggregationKernel {
     MS_LOG(INFO) << "Iteration: " << LocalMetaStore::GetInstance().curr_iter_num() << " launching FedAvgKernel for "
                  << name_ << " new data size is " << new_data_size_addr[0] << ", current total data size is "
                  << data_size_addr[0];
-    for (size_t i = 0; i < inputs[2]->size / sizeof(T); i++) {
-      weight_addr[i] += new_weight_addr[i];
-    }
+    AccumulateData(weight_addr, new_weight_addr, inputs[2]->size / sizeof(T));
     data_size_addr[0] += new_data_size_addr[0];
     lock.unlock();
+    return CountAccumulation();
+  }
 
-    accum_count_++;
-    participated_ = true;
-    return DistributedCountService::GetInstance().Count(
-      name_, std::to_string(DistributedCountService::GetInstance().local_rank()) + "_" + std::to_string(accum_count_));
+  bool SupportUploadData() const override { return true; }
+
+  // Accumulate the new weight straight from the request of the client as it arrives. The weight could be uploaded in
+  // float32, float16 or int8, the compressed ones are dequantized in the accumulation.
+  bool LaunchWithUploadData(const UploadData &upload_data) override {
+    MS_ERROR_IF_NULL_W_RET_VAL(weight_addr_, false);
+    MS_ERROR_IF_NULL_W_RET_VAL(data_size_addr_, false);
+    MS_ERROR_IF_NULL_W_RET_VAL(weight_addr_->addr, false);
+    MS_ERROR_IF_NULL_W_RET_VAL(data_size_addr_->addr, false);
+    auto new_data_size = upload_data.find(kNewDataSize);
+    if (new_data_size == upload_data.end() || new_data_size->second.addr == nullptr ||
+        new_data_size->second.size != sizeof(S)) {
+      MS_LOG(ERROR) << "The new data size for " << name_ << " is invalid.";
+      return false;
+    }
+    size_t count = weight_addr_->size / sizeof(T);
+    std::function<void(T *)> accumulate;
+    auto new_weight = upload_data.find(kNewWeight);
+    auto new_weight_fp16 = upload_data.find(kNewWeightFp16);
+    auto new_weight_int8 = upload_data.find(kNewWeightInt8);
+    if (new_weight != upload_data.end()) {
+      if (!CheckUploadWeight(new_weight->second, count * sizeof(T))) {
+        return false;
+      }
+      auto src = reinterpret_cast<const T *>(new_weight->second.addr);
+      accumulate = [src, count](T *weight) { AccumulateData(weight, src, count); };
+    } else if (new_weight_fp16 != upload_data.end()) {
+      if (!CheckUploadWeight(new_weight_fp16->second, count * sizeof(float16))) {
+        return false;
+      }
+      auto src = reinterpret_cast<const float16 *>(new_weight_fp16->second.addr);
+      accumulate = [src, count](T *weight) { AccumulateFp16Data(weight, src, count); };
+    } else if (new_weight_int8 != upload_data.end()) {
+      auto quant_param = upload_data.find(kQuantParam);
+      if (!CheckUploadWeight(new_weight_int8->second, count * sizeof(int8_t))) {
+        return false;
+      }
+      if (quant_param == upload_data.end() || quant_param->second.addr == nullptr ||
+          quant_param->second.size != sizeof(schema::QuantParam)) {
+        MS_LOG(ERROR) << "The quant param of the int8 weight for " << name_ << " is invalid.";
+        return false;
+      }
+      auto src = reinterpret_cast<const int8_t *>(new_weight_int8->second.addr);
+      auto param = reinterpret_cast<const schema::QuantParam *>(quant_param->second.addr);
+      float scale = param->scale();
+      int32_t zero_point = param->zero_point();
+      accumulate = [src, count, scale, zero_point](T *weight) {
+        AccumulateInt8Data(weight, src, count, scale, zero_point);
+      };
+    } else {
+      MS_LOG(ERROR) << "The new weight for " << name_ << " is not uploaded.";
+      return false;
+    }
+
+    std::unique_lock<std::mutex> lock(weight_mutex_);
+    if (accum_count_ == 0) {
+      ClearWeightAndDataSize();
+    }
+    S *data_size_addr = reinterpret_cast<S *>(data_size_addr_->addr);
+    MS_LOG(INFO) << "Iteration: " << LocalMetaStore::GetInstance().curr_iter_num() << " launching FedAvgKernel for "
+                 << name_ << " new data size is " << *reinterpret_cast<const S *>(new_data_size->second.addr)
+                 << ", current total data size is " << data_size_addr[0];
+    accumulate(reinterpret_cast<T *>(weight_addr_->addr));
+    data_size_addr[0] += *reinterpret_cast<const S *>(new_data_size->second.addr);
+    lock.unlock();
+    return CountAccumulation();
   }
 
   void Reset() override {
@@ -191,6 +252,22 @@ class FedAvgKernel : public AggregationKernel {
     return;
   }
 
+  bool CountAccumulation() {
+    accum_count_++;
+    participated_ = true;
+    return DistributedCountService::GetInstance().Count(
+      name_, std::to_string(DistributedCountService::GetInstance().local_rank()) + "_" + std::to_string(accum_count_));
+  }
+
+  bool CheckUploadWeight(const Address &new_weight, size_t expected_size) const {
+    if (new_weight.addr == nullptr || new_weight.size != expected_size) {
+      MS_LOG(ERROR) << "The uploaded weight for " << name_ << " is " << new_weight.size << " bytes, but "
+                    << expected_size << " bytes are expected.";
+      return false;
+    }
+    return true;
+  }
+
   // In some cases, the Launch method is not called and the weights involved in AllReduce should be set to 0.
   void ClearWeightAndDataSize() {
     MS_ERROR_IF_NULL_WO_RET_VAL(weight_addr_);
@@ -256,12 +256,30 @@ std::map<std::string, UploadData> UpdateModelKernel::ParseFeatureMap(
   auto fbs_feature_map = update_model_req->feature_map();
   MS_ERROR_IF_NULL_W_RET_VAL(fbs_feature_map, feature_map);
   for (uint32_t i = 0; i < fbs_feature_map->size(); i++) {
-    std::string weight_full_name = fbs_feature_map->Get(i)->weight_fullname()->str();
-    float *weight_data = const_cast<float *>(fbs_feature_map->Get(i)->data()->data());
-    size_t weight_size = fbs_feature_map->Get(i)->data()->size() * sizeof(float);
+    auto fbs_feature = fbs_feature_map->Get(i);
+    MS_ERROR_IF_NULL_W_RET_VAL(fbs_feature->weight_fullname(), {});
+    std::string weight_full_name = fbs_feature->weight_fullname()->str();
+    // The data is accumulated straight from the request, the compressed one is dequantized on the fly.
     UploadData upload_data;
-    upload_data[kNewWeight].addr = weight_data;
-    upload_data[kNewWeight].size = weight_size;
+    if (fbs_feature->data() != nullptr && fbs_feature->data()->size() != 0) {
+      upload_data[kNewWeight].addr = const_cast<float *>(fbs_feature->data()->data());
+      upload_data[kNewWeight].size = fbs_feature->data()->size() * sizeof(float);
+    } else if (fbs_feature->data_fp16() != nullptr && fbs_feature->data_fp16()->size() != 0) {
+      upload_data[kNewWeightFp16].addr = const_cast<uint16_t *>(fbs_feature->data_fp16()->data());
+      upload_data[kNewWeightFp16].size = fbs_feature->data_fp16()->size() * sizeof(uint16_t);
+    } else if (fbs_feature->data_int8() != nullptr && fbs_feature->data_int8()->size() != 0) {
+      if (fbs_feature->quant_param() == nullptr) {
+        MS_LOG(ERROR) << "The quant_param of int8 weight " << weight_full_name << " is not set.";
+        return {};
+      }
+      upload_data[kNewWeightInt8].addr = const_cast<int8_t *>(fbs_feature->data_int8()->data());
+      upload_data[kNewWeightInt8].size = fbs_feature->data_int8()->size() * sizeof(int8_t);
+      upload_data[kQuantParam].addr = const_cast<schema::QuantParam *>(fbs_feature->quant_param());
+      upload_data[kQuantParam].size = sizeof(schema::QuantParam);
+    } else {
+      MS_LOG(ERROR) << "The data of weight " << weight_full_name << " is empty.";
+      return {};
+    }
     feature_map[weight_full_name] = upload_data;
   }
   return feature_map;
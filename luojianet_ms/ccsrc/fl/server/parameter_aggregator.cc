@@ -112,6 +112,31 @@ bool ParameterAggregator::LaunchAggregators() {
   return true;
 }
 
+bool ParameterAggregator::AggregateUploadData(const UploadData &upload_data) {
+  bool support_upload_data =
+    !aggregation_kernel_parameters_.empty() &&
+    std::all_of(aggregation_kernel_parameters_.begin(), aggregation_kernel_parameters_.end(),
+                [](const auto &aggregator_with_params) {
+                  return aggregator_with_params.first != nullptr && aggregator_with_params.first->SupportUploadData();
+                });
+  if (!support_upload_data) {
+    if (upload_data.count(kNewWeightFp16) != 0 || upload_data.count(kNewWeightInt8) != 0) {
+      MS_LOG(ERROR) << "The compressed upload data is not supported by the aggregation kernels.";
+      return false;
+    }
+    return UpdateData(upload_data) && LaunchAggregators();
+  }
+  for (auto &aggregator_with_params : aggregation_kernel_parameters_) {
+    std::shared_ptr<kernel::AggregationKernel> aggr_kernel = aggregator_with_params.first;
+    if (!aggr_kernel->LaunchWithUploadData(upload_data)) {
+      MS_LOG(ERROR) << "Launching aggregation kernel " << typeid(aggr_kernel.get()).name()
+                    << " with the upload data failed.";
+      return false;
+    }
+  }
+  return true;
+}
+
 AddressPtr ParameterAggregator::GetWeight() {
   if (memory_register_ == nullptr) {
     MS_LOG(ERROR)
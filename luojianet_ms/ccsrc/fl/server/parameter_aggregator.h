@@ -79,6 +79,10 @@ class ParameterAggregator {
   // Launch aggregators/optimizers of this ParameterAggregator in order.
   bool LaunchAggregators();
 
+  // Aggregate the data uploaded by a worker. If all the aggregation kernels support it, the data is accumulated
+  // straight from the upload, otherwise it's copied by UpdateData and then LaunchAggregators is called.
+  bool AggregateUploadData(const UploadData &upload_data);
+
   // Different from the method Pull, this method simply returns the weight of this ParameterAggregator without causing
   // any change of status.
   AddressPtr GetWeight();
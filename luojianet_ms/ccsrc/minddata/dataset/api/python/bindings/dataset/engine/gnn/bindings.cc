@@ -109,6 +109,14 @@ PYBIND_REGISTER(
              THROW_IF_ERROR(g.RandomWalk(node_list, meta_path, step_home_param, step_away_param, default_node, &out));
              return out;
            })
+      .def("save_graph_store",
+           [](gnn::GraphData &g, const std::string &file_name) {
+             auto graph_impl = dynamic_cast<gnn::GraphDataImpl *>(&g);
+             if (graph_impl == nullptr) {
+               THROW_IF_ERROR(Status(StatusCode::kMDUnexpectedError, "Graph store can only be saved in local mode."));
+             }
+             THROW_IF_ERROR(graph_impl->SaveGraphStore(file_name));
+           })
       .def("stop", [](gnn::GraphData &g) { THROW_IF_ERROR(g.Stop()); });
 
     (void)py::class_<gnn::GraphDataServer, std::shared_ptr<gnn::GraphDataServer>>(*m, "GraphDataServer")
@@ -247,6 +247,14 @@ class ConfigManager {
   // @param interval - autotune interval in steps
   void set_autotune_interval(int64_t interval) { autotune_interval_ = interval; }
 
+  // setter function
+  // @param path - the json file to save the tuned config to at the end of autotune, empty for not saving
+  void set_autotune_config_path(const std::string &path) { autotune_config_path_ = path; }
+
+  // getter function
+  // @return - the json file to save the tuned config to
+  std::string autotune_config_path() { return autotune_config_path_; }
+
  private:
   int32_t num_parallel_workers_;
   int32_t worker_connector_size_;
@@ -272,6 +280,7 @@ class ConfigManager {
   bool auto_offload_;
   bool enable_autotune_;
   int64_t autotune_interval_;
+  std::string autotune_config_path_;
   // Private helper function that takes a nlohmann json format and populates the settings
   // @param j - The json nlohmann json info
   Status FromJson(const nlohmann::json &j);
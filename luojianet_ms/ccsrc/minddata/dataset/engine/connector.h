@@ -17,10 +17,12 @@
 #ifndef LUOJIANET_MS_CCSRC_MINDDATA_DATASET_ENGINE_CONNECTOR_H_
 #define LUOJIANET_MS_CCSRC_MINDDATA_DATASET_ENGINE_CONNECTOR_H_
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
+#include "minddata/dataset/engine/perf/span_recorder.h"
 #include "minddata/dataset/util/task_manager.h"
 #include "minddata/dataset/util/queue.h"
 #include "minddata/dataset/util/services.h"
@@ -100,8 +102,8 @@ class Connector {
     {
       MS_ASSERT(worker_id < num_consumers_);
       std::unique_lock<std::mutex> lk(m_);
-      RETURN_IF_NOT_OK(cv_.Wait(&lk, [this, worker_id]() { return expect_consumer_ == worker_id; }));
-      RETURN_IF_NOT_OK(queues_[pop_from_]->PopFront(result));
+      RETURN_IF_NOT_OK(WaitForConsumer(&lk, worker_id));
+      RETURN_IF_NOT_OK(PopFromQueue(result));
       pop_from_ = (pop_from_ + 1) % num_producers_;
       out_buffers_count_++;
       expect_consumer_ = (expect_consumer_ + 1) % num_consumers_;
@@ -119,7 +121,11 @@ class Connector {
   Status Push(int32_t worker_id, const T &el) noexcept {
     MS_ASSERT(worker_id < static_cast<int32_t>(queues_.size()));
     MS_ASSERT(queues_[worker_id] != nullptr);
-    return (queues_[worker_id]->Add(el));
+    uint64_t blocked_us = queues_[worker_id]->push_blocked_time();
+    RETURN_IF_NOT_OK(queues_[worker_id]->Add(el));
+    blocked_us = queues_[worker_id]->push_blocked_time() - blocked_us;
+    SpanRecorder::GetInstance().RecordBlocked(SpanCategory::kPushBlocked, "Push", blocked_us);
+    return Status::OK();
   }
 
   auto out_rows_count() const { return out_buffers_count_.load(); }
@@ -132,7 +138,11 @@ class Connector {
   virtual Status Push(int32_t worker_id, T &&el) noexcept {
     MS_ASSERT(worker_id < static_cast<int32_t>(queues_.size()));
     MS_ASSERT(queues_[worker_id] != nullptr);
-    return (queues_[worker_id]->Add(std::forward<T>(el)));
+    uint64_t blocked_us = queues_[worker_id]->push_blocked_time();
+    RETURN_IF_NOT_OK(queues_[worker_id]->Add(std::forward<T>(el)));
+    blocked_us = queues_[worker_id]->push_blocked_time() - blocked_us;
+    SpanRecorder::GetInstance().RecordBlocked(SpanCategory::kPushBlocked, "Push", blocked_us);
+    return Status::OK();
   }
 
   // Resets the internal index tracking of the queue so that it can be used again with new inputs,
@@ -175,6 +185,19 @@ class Connector {
     return capacity;
   }
 
+  // Total time in microseconds the producers have been blocked because the connector is full.
+  uint64_t push_blocked_time() const {
+    uint64_t blocked_us = 0;
+    for (size_t i = 0; i < queues_.size(); ++i) {
+      blocked_us += queues_[i]->push_blocked_time();
+    }
+    return blocked_us;
+  }
+
+  // Total time in microseconds the consumers have been blocked, either because the connector is empty or because
+  // it is not their turn to pop.
+  uint64_t pop_blocked_time() const { return pop_blocked_us_.load(std::memory_order_relaxed); }
+
   // Register the internal resources with Task group for interruption service.
   // @param vg
   // @return
@@ -187,6 +210,30 @@ class Connector {
   }
 
  protected:
+  // Wait until it is the turn of the worker to pop, must be called when holding m_.
+  Status WaitForConsumer(std::unique_lock<std::mutex> *lk, int32_t worker_id) {
+    auto is_my_turn = [this, worker_id]() { return expect_consumer_ == worker_id; };
+    if (is_my_turn()) {
+      return cv_.Wait(lk, is_my_turn);
+    }
+    uint64_t start_us = SpanRecorder::NowUs();
+    Status rc = cv_.Wait(lk, is_my_turn);
+    uint64_t blocked_us = SpanRecorder::NowUs() - start_us;
+    (void)pop_blocked_us_.fetch_add(blocked_us, std::memory_order_relaxed);
+    SpanRecorder::GetInstance().RecordBlocked(SpanCategory::kPopBlocked, "Pop", blocked_us);
+    return rc;
+  }
+
+  // Pop from the queue of pop_from_, must be called when holding m_.
+  Status PopFromQueue(T *result) {
+    uint64_t blocked_us = queues_[pop_from_]->pop_blocked_time();
+    RETURN_IF_NOT_OK(queues_[pop_from_]->PopFront(result));
+    blocked_us = queues_[pop_from_]->pop_blocked_time() - blocked_us;
+    (void)pop_blocked_us_.fetch_add(blocked_us, std::memory_order_relaxed);
+    SpanRecorder::GetInstance().RecordBlocked(SpanCategory::kPopBlocked, "Pop", blocked_us);
+    return Status::OK();
+  }
+
   std::string my_name_;
 
   // A list of Queues that are thread safe.
@@ -205,6 +252,7 @@ class Connector {
   std::mutex m_;
   CondVar cv_;
   std::atomic<std::int64_t> out_buffers_count_ = 0;
+  std::atomic<uint64_t> pop_blocked_us_ = 0;
 };
 }  // namespace dataset
 }  // namespace luojianet_ms
@@ -271,6 +271,23 @@ class DatasetOp : public std::enable_shared_from_this<DatasetOp> {
     return ChildOpConnectorCapacity();
   }
 
+  // \brief Getter function
+  // \return time in microseconds the producers have been blocked on the output connector, 0 for inlined op
+  uint64_t ConnectorPushBlockedTime() const {
+    return out_connector_ == nullptr ? 0 : out_connector_->push_blocked_time();
+  }
+
+  // \brief Getter function
+  // \return time in microseconds the consumers have been blocked on the output connector, 0 for inlined op
+  uint64_t ConnectorPopBlockedTime() const {
+    return out_connector_ == nullptr ? 0 : out_connector_->pop_blocked_time();
+  }
+
+  // \brief Getter function
+  // \return time in microseconds the workers have been blocked on their input and output queues, summed over all
+  //     the workers ever launched, 0 for non-ParallelOps
+  virtual uint64_t WorkerBlockedTime() const { return 0; }
+
   // \brief Getter function
   // \return connector size of child op
   int32_t ChildOpConnectorSize(int32_t child_index = 0) const { return child_[child_index]->ConnectorSize(); }
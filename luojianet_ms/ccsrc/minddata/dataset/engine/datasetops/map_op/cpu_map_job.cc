@@ -19,6 +19,7 @@
 #include <string>
 #include <utility>
 #include "minddata/dataset/engine/datasetops/map_op/cpu_map_job.h"
+#include "minddata/dataset/engine/perf/span_recorder.h"
 
 namespace luojianet_ms {
 namespace dataset {
@@ -36,12 +37,18 @@ CpuMapJob::~CpuMapJob() = default;
 Status CpuMapJob::Run(std::vector<TensorRow> in, std::vector<TensorRow> *out) {
   RETURN_UNEXPECTED_IF_NULL(out);
   int32_t num_rows = in.size();
+  SpanRecorder &recorder = SpanRecorder::GetInstance();
   for (int32_t row = 0; row < num_rows; row++) {
     TensorRow input_row = in[row];
     TensorRow result_row;
     for (size_t i = 0; i < ops_.size(); i++) {
-      // Call compute function for cpu
+      // Call compute function for cpu, and record it as a span of the worker if the recorder is started
+      bool record_span = recorder.enabled();
+      uint64_t start_us = record_span ? SpanRecorder::NowUs() : 0;
       Status rc = ops_[i]->Compute(input_row, &result_row);
+      if (record_span) {
+        recorder.Record(SpanCategory::kCompute, ops_[i]->Name(), start_us, SpanRecorder::NowUs());
+      }
       if (rc.IsError()) {
         RETURN_IF_NOT_OK(RebuildMapErrorMsg(input_row, i, &rc));
       }
@@ -26,6 +26,7 @@
 #include "minddata/dataset/core/global_context.h"
 
 #include "minddata/dataset/engine/datasetops/map_op/cpu_map_job.h"
+#include "minddata/dataset/engine/perf/span_recorder.h"
 #include "minddata/dataset/kernels/tensor_op.h"
 #include "minddata/dataset/util/log_adapter.h"
 #include "minddata/dataset/util/task_manager.h"
@@ -73,7 +74,10 @@ void MapOp::Print(std::ostream &out, bool show_all) const {
 Status MapOp::FetchNextWork(uint32_t worker_id, TensorRow *row, std::vector<std::shared_ptr<MapJob>> *job_list) {
   std::unique_ptr<MapWorkerJob> worker_job;
   // Fetch the next worker job and TensorRow
+  uint64_t blocked_us = worker_in_queues_[worker_id]->pop_blocked_time();
   RETURN_IF_NOT_OK(worker_in_queues_[worker_id]->PopFront(&worker_job));
+  blocked_us = worker_in_queues_[worker_id]->pop_blocked_time() - blocked_us;
+  SpanRecorder::GetInstance().RecordBlocked(SpanCategory::kPopBlocked, "Pop", blocked_us);
   // Extract the TensorRow and job list from the map worker job.
   *row = std::move(worker_job->tensor_row);
   *job_list = std::move(worker_job->jobs);
@@ -198,7 +202,10 @@ Status MapOp::WorkerEntry(int32_t worker_id) {
       // Perform the compute function of TensorOp(s) and store the result in new_tensor_table.
       RETURN_IF_NOT_OK(WorkerCompute(in_row, &out_row, job_list));
       // Push the row onto the connector for next operator to consume.
+      uint64_t blocked_us = worker_out_queues_[worker_id]->push_blocked_time();
       RETURN_IF_NOT_OK(worker_out_queues_[worker_id]->EmplaceBack(std::move(out_row)));
+      blocked_us = worker_out_queues_[worker_id]->push_blocked_time() - blocked_us;
+      SpanRecorder::GetInstance().RecordBlocked(SpanCategory::kPushBlocked, "Push", blocked_us);
     }
     // Fetch next data row and map job list
     RETURN_IF_NOT_OK(FetchNextWork(worker_id, &in_row, &job_list));
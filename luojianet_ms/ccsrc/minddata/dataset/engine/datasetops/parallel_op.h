@@ -20,6 +20,7 @@
 #include <algorithm>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -82,6 +83,18 @@ class ParallelOp : public DatasetOp {
 
   int32_t NumWorkers() const override { return num_workers_; }
 
+  uint64_t WorkerBlockedTime() const override {
+    std::lock_guard<std::mutex> guard(worker_queues_mux_);
+    uint64_t blocked_time = removed_blocked_time_;
+    for (size_t i = 0; i < worker_in_queues_.size(); ++i) {
+      blocked_time += worker_in_queues_[i]->pop_blocked_time();
+    }
+    for (size_t i = 0; i < worker_out_queues_.size(); ++i) {
+      blocked_time += worker_out_queues_[i]->push_blocked_time();
+    }
+    return blocked_time;
+  }
+
  protected:
   /// Interface for derived classes to implement. All derived classes must provide the entry
   /// function with the main execution loop for worker threads.
@@ -92,8 +105,11 @@ class ParallelOp : public DatasetOp {
   /// \return Status The status code returned
   virtual Status RegisterAndLaunchThreads() {
     RETURN_UNEXPECTED_IF_NULL(tree_);
-    worker_in_queues_.Init(num_workers_, worker_connector_size_);
-    worker_out_queues_.Init(num_workers_, worker_connector_size_);
+    {
+      std::lock_guard<std::mutex> guard(worker_queues_mux_);
+      worker_in_queues_.Init(num_workers_, worker_connector_size_);
+      worker_out_queues_.Init(num_workers_, worker_connector_size_);
+    }
 
     // Registers QueueList and individual Queues for interrupt services
     RETURN_IF_NOT_OK(worker_in_queues_.Register(tree_->AllTasks()));
@@ -169,8 +185,11 @@ class ParallelOp : public DatasetOp {
     // wait for workers to process the current rows
     RETURN_IF_NOT_OK(WaitForWorkers());
     for (int32_t i = 0; i < num_new_workers; i++) {
-      worker_in_queues_.AddQueue(tree_->AllTasks());
-      worker_out_queues_.AddQueue(tree_->AllTasks());
+      {
+        std::lock_guard<std::mutex> guard(worker_queues_mux_);
+        RETURN_IF_NOT_OK(worker_in_queues_.AddQueue(tree_->AllTasks()));
+        RETURN_IF_NOT_OK(worker_out_queues_.AddQueue(tree_->AllTasks()));
+      }
       Task *new_task;
       RETURN_IF_NOT_OK(tree_->AllTasks()->CreateAsyncTask(
         Name() + "::WorkerEntry", std::bind(&ParallelOp::WorkerEntry, this, num_workers_), &new_task, id()));
@@ -194,7 +213,12 @@ class ParallelOp : public DatasetOp {
     for (int32_t i = 0; i < num_workers; i++) {
       RETURN_IF_NOT_OK(SendQuitFlagToWorker(num_workers_ - 1));
       RETURN_IF_NOT_OK(worker_tasks_[num_workers_ - 1]->Join());
-      RETURN_IF_NOT_OK(worker_in_queues_.RemoveLastQueue());
+      {
+        std::lock_guard<std::mutex> guard(worker_queues_mux_);
+        // keep the blocked time of the removed worker, so that the total never goes backwards
+        removed_blocked_time_ += worker_in_queues_[worker_in_queues_.size() - 1]->pop_blocked_time();
+        RETURN_IF_NOT_OK(worker_in_queues_.RemoveLastQueue());
+      }
       worker_tasks_.pop_back();
       num_workers_--;
       MS_LOG(INFO) << "Worker ID " << num_workers_ << " is requested to be removed in operator: " << NameWithID()
@@ -236,6 +260,12 @@ class ParallelOp : public DatasetOp {
   QueueList<T> worker_in_queues_;
   /// queues to hold the output from workers
   QueueList<S> worker_out_queues_;
+
+ private:
+  /// guards the worker queue lists against being resized while WorkerBlockedTime is reading them
+  mutable std::mutex worker_queues_mux_;
+  /// blocked time of the input queues of the removed workers
+  uint64_t removed_blocked_time_ = 0;
 };
 }  // namespace dataset
 }  // namespace luojianet_ms
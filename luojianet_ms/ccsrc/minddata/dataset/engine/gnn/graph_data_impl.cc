@@ -17,14 +17,18 @@
 #include "minddata/dataset/engine/gnn/graph_data_impl.h"
 
 #include <algorithm>
+#include <atomic>
 #include <functional>
 #include <iterator>
+#include <limits>
 #include <numeric>
+#include <random>
 #include <utility>
 
 #include "minddata/dataset/core/tensor_shape.h"
 #include "minddata/dataset/engine/gnn/graph_loader.h"
 #include "minddata/dataset/util/random.h"
+#include "minddata/dataset/util/task_manager.h"
 namespace luojianet_ms {
 namespace dataset {
 namespace gnn {
@@ -34,7 +38,8 @@ GraphDataImpl::GraphDataImpl(std::string dataset_file, int32_t num_workers, bool
       num_workers_(num_workers),
       rnd_(GetRandomDevice()),
       random_walk_(this),
-      server_mode_(server_mode) {
+      server_mode_(server_mode),
+      graph_store_(std::make_unique<GraphStore>()) {
   rnd_.seed(GetSeed());
   MS_LOG(INFO) << "num_workers:" << num_workers;
 }
@@ -119,14 +124,13 @@ Status GraphDataImpl::GetNodesFromEdges(const std::vector<EdgeIdType> &edge_list
   std::vector<std::vector<NodeIdType>> node_list;
   node_list.reserve(edge_list.size());
   for (const auto &edge_id : edge_list) {
-    auto itr = edge_id_map_.find(edge_id);
-    if (itr == edge_id_map_.end()) {
+    StoreIndexType edge = graph_store_->FindEdge(edge_id);
+    if (edge == kInvalidStoreIndex) {
       std::string err_msg = "Invalid edge id:" + std::to_string(edge_id);
       RETURN_STATUS_UNEXPECTED(err_msg);
     } else {
-      std::pair<std::shared_ptr<Node>, std::shared_ptr<Node>> nodes;
-      RETURN_IF_NOT_OK(itr->second->GetNode(&nodes));
-      node_list.push_back({nodes.first->id(), nodes.second->id()});
+      node_list.push_back({graph_store_->NodeId(graph_store_->EdgeSrc(edge)),
+                           graph_store_->NodeId(graph_store_->EdgeDst(edge))});
     }
   }
   RETURN_IF_NOT_OK(CreateTensorByVector<NodeIdType>(node_list, DataType(DataType::DE_INT32), out));
@@ -144,11 +148,17 @@ Status GraphDataImpl::GetEdgesFromNodes(const std::vector<std::pair<NodeIdType,
   edge_list.reserve(node_list.size());
 
   for (const auto &node_id : node_list) {
-    std::shared_ptr<Node> src_node;
-    RETURN_IF_NOT_OK(GetNodeByNodeId(node_id.first, &src_node));
+    StoreIndexType src_node;
+    RETURN_IF_NOT_OK(GetNodeIndex(node_id.first, &src_node));
 
-    EdgeIdType edge_id;
-    src_node->GetEdgeByAdjNodeId(node_id.second, &edge_id);
+    EdgeIdType edge_id = -1;
+    StoreIndexType edge = graph_store_->FindEdgeByNodes(src_node, graph_store_->FindNode(node_id.second));
+    if (edge != kInvalidStoreIndex) {
+      edge_id = graph_store_->EdgeId(edge);
+    } else {
+      MS_LOG(WARNING) << "Number " << node_id.second << " node is not adjacent to number " << node_id.first
+                      << " node.";
+    }
 
     std::vector<EdgeIdType> connection_edge = {edge_id};
     edge_list.emplace_back(std::move(connection_edge));
@@ -173,16 +183,14 @@ Status GraphDataImpl::GetAllNeighbors(const std::vector<NodeIdType> &node_list,
   // Collect information of adjacent table
   neighbors.resize(node_list.size());
   for (size_t i = 0; i < node_list.size(); ++i) {
-    std::shared_ptr<Node> node;
-    RETURN_IF_NOT_OK(GetNodeByNodeId(node_list[i], &node));
     if (format == OutputFormat::kNormal) {
-      RETURN_IF_NOT_OK(node->GetAllNeighbors(neighbor_type, &neighbors[i]));
+      RETURN_IF_NOT_OK(GetNeighborIds(node_list[i], neighbor_type, false, &neighbors[i]));
       max_neighbor_num = max_neighbor_num > neighbors[i].size() ? max_neighbor_num : neighbors[i].size();
     } else if (format == OutputFormat::kCoo) {
-      RETURN_IF_NOT_OK(node->GetAllNeighbors(neighbor_type, &neighbors[i], true));
+      RETURN_IF_NOT_OK(GetNeighborIds(node_list[i], neighbor_type, true, &neighbors[i]));
       total_edge_num += neighbors[i].size();
     } else {
-      RETURN_IF_NOT_OK(node->GetAllNeighbors(neighbor_type, &neighbors[i], true));
+      RETURN_IF_NOT_OK(GetNeighborIds(node_list[i], neighbor_type, true, &neighbors[i]));
       total_edge_num += neighbors[i].size();
       if (i < node_list.size() - 1) {
         offset_table[i + 1] = total_edge_num;
@@ -258,55 +266,112 @@ Status GraphDataImpl::GetSampledNeighbors(const std::vector<NodeIdType> &node_li
   for (const auto &type : neighbor_types) {
     RETURN_IF_NOT_OK(CheckNeighborType(type));
   }
+  CHECK_FAIL_RETURN_UNEXPECTED(strategy == SamplingStrategy::kRandom || strategy == SamplingStrategy::kEdgeWeight,
+                               "Invalid strategy");
   RETURN_UNEXPECTED_IF_NULL(out);
-  std::vector<std::vector<NodeIdType>> neighbors_vec(node_list.size());
-  for (size_t node_idx = 0; node_idx < node_list.size(); ++node_idx) {
-    std::shared_ptr<Node> input_node;
-    RETURN_IF_NOT_OK(GetNodeByNodeId(node_list[node_idx], &input_node));
-    neighbors_vec[node_idx].emplace_back(node_list[node_idx]);
-    std::vector<NodeIdType> input_list = {node_list[node_idx]};
-    for (size_t i = 0; i < neighbor_nums.size(); ++i) {
-      std::vector<NodeIdType> neighbors;
-      neighbors.reserve(input_list.size() * neighbor_nums[i]);
-      for (const auto &node_id : input_list) {
-        if (node_id == kDefaultNodeId) {
-          for (int32_t j = 0; j < neighbor_nums[i]; ++j) {
-            neighbors.emplace_back(kDefaultNodeId);
+  std::vector<StoreIndexType> input_nodes(node_list.size());
+  for (size_t i = 0; i < node_list.size(); ++i) {
+    RETURN_IF_NOT_OK(GetNodeIndex(node_list[i], &input_nodes[i]));
+  }
+
+  // Each row is the input node followed by the neighbors sampled at every hop
+  size_t row_size = 1;
+  size_t hop_size = 1;
+  for (const auto &num : neighbor_nums) {
+    CHECK_FAIL_RETURN_UNEXPECTED(hop_size <= std::numeric_limits<int32_t>::max() / static_cast<size_t>(num),
+                                 "The number of sampled neighbors is too large.");
+    hop_size *= num;
+    row_size += hop_size;
+  }
+  std::shared_ptr<Tensor> tensor;
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(
+    TensorShape({static_cast<dsize_t>(node_list.size()), static_cast<dsize_t>(row_size)}),
+    DataType(DataType::DE_INT32), &tensor));
+  NodeIdType *result = &(*tensor->begin<NodeIdType>());
+
+  auto sample_rows = [&](size_t begin, size_t end, std::mt19937 *rng) -> Status {
+    std::vector<StoreIndexType> row(row_size);
+    std::vector<uint32_t> positions;
+    for (size_t i = begin; i < end; ++i) {
+      row[0] = input_nodes[i];
+      size_t input_begin = 0;
+      size_t input_end = 1;
+      for (size_t hop = 0; hop < neighbor_nums.size(); ++hop) {
+        size_t output = input_end;
+        for (size_t k = input_begin; k < input_end; ++k) {
+          if (row[k] == kInvalidStoreIndex) {
+            std::fill_n(row.begin() + output, neighbor_nums[hop], kInvalidStoreIndex);
+          } else {
+            RETURN_IF_NOT_OK(SampleNeighbors(row[k], neighbor_types[hop], neighbor_nums[hop], strategy, rng,
+                                             &positions, row.data() + output));
           }
-        } else {
-          std::shared_ptr<Node> node;
-          RETURN_IF_NOT_OK(GetNodeByNodeId(node_id, &node));
-          std::vector<NodeIdType> out;
-          RETURN_IF_NOT_OK(node->GetSampledNeighbors(neighbor_types[i], neighbor_nums[i], strategy, &out));
-          neighbors.insert(neighbors.end(), out.begin(), out.end());
+          output += neighbor_nums[hop];
         }
+        input_begin = input_end;
+        input_end = output;
+      }
+      NodeIdType *out_row = result + i * row_size;
+      for (size_t k = 0; k < row_size; ++k) {
+        out_row[k] = row[k] == kInvalidStoreIndex ? kDefaultNodeId : graph_store_->NodeId(row[k]);
       }
-      neighbors_vec[node_idx].insert(neighbors_vec[node_idx].end(), neighbors.begin(), neighbors.end());
-      input_list = std::move(neighbors);
     }
-  }
-  RETURN_IF_NOT_OK(CreateTensorByVector<NodeIdType>(neighbors_vec, DataType(DataType::DE_INT32), out));
+    return Status::OK();
+  };
+  RETURN_IF_NOT_OK(ParallelForBlocks(node_list.size(), num_workers_, sample_rows));
+  tensor->Squeeze();
+  *out = std::move(tensor);
   return Status::OK();
 }
 
-Status GraphDataImpl::NegativeSample(const std::vector<NodeIdType> &data, const std::vector<NodeIdType> shuffled_ids,
-                                     size_t *start_index, const std::unordered_set<NodeIdType> &exclude_data,
-                                     int32_t samples_num, std::vector<NodeIdType> *out_samples) {
-  CHECK_FAIL_RETURN_UNEXPECTED(!data.empty(), "Input data is empty.");
-  RETURN_UNEXPECTED_IF_NULL(start_index);
+Status GraphDataImpl::NegativeSample(NodeIdType id, const std::vector<NodeIdType> &candidates,
+                                     NodeType neg_neighbor_type, int32_t samples_num, std::mt19937 *rng,
+                                     NodeIdType *out_samples) {
+  RETURN_UNEXPECTED_IF_NULL(rng);
   RETURN_UNEXPECTED_IF_NULL(out_samples);
-  size_t index = *start_index;
-  for (size_t i = index; i < shuffled_ids.size(); ++i) {
-    ++index;
-    if (exclude_data.find(data[shuffled_ids[i]]) != exclude_data.end()) {
-      continue;
+  // The node itself and its neighbors are excluded
+  std::vector<NodeIdType> exclude_nodes;
+  RETURN_IF_NOT_OK(GetNeighborIds(id, neg_neighbor_type, false, &exclude_nodes));
+  std::sort(exclude_nodes.begin(), exclude_nodes.end());
+  exclude_nodes.erase(std::unique(exclude_nodes.begin(), exclude_nodes.end()), exclude_nodes.end());
+  if (candidates.size() <= exclude_nodes.size()) {
+    MS_LOG(DEBUG) << "There are no negative neighbors. node_id:" << id << " neg_neighbor_type:" << neg_neighbor_type;
+    // If there are no negative neighbors, they are filled with kDefaultNodeId
+    std::fill_n(out_samples, samples_num, kDefaultNodeId);
+    return Status::OK();
+  }
+  auto is_excluded = [&exclude_nodes](NodeIdType node) {
+    return std::binary_search(exclude_nodes.begin(), exclude_nodes.end(), node);
+  };
+
+  // Draw from all the candidates and reject the excluded ones when they are only a small part of candidates
+  const size_t kMaxRejectionSamples = 64;
+  size_t num_samples = static_cast<size_t>(samples_num);
+  if (num_samples <= kMaxRejectionSamples && candidates.size() >= 2 * (exclude_nodes.size() + num_samples)) {
+    std::uniform_int_distribution<size_t> distribution(0, candidates.size() - 1);
+    int32_t num = 0;
+    while (num < samples_num) {
+      NodeIdType node = candidates[distribution(*rng)];
+      if (!is_excluded(node) && std::find(out_samples, out_samples + num, node) == out_samples + num) {
+        out_samples[num++] = node;
+      }
     }
-    out_samples->emplace_back(data[shuffled_ids[i]]);
-    if (out_samples->size() >= samples_num) {
-      break;
+    return Status::OK();
+  }
+
+  // Otherwise take the candidates without replacement, and start over when all of them are taken
+  std::vector<NodeIdType> negative_nodes;
+  negative_nodes.reserve(candidates.size());
+  std::copy_if(candidates.begin(), candidates.end(), std::back_inserter(negative_nodes),
+               [&is_excluded](NodeIdType node) { return !is_excluded(node); });
+  CHECK_FAIL_RETURN_UNEXPECTED(!negative_nodes.empty(), "There are no negative neighbors to sample.");
+  int32_t num = 0;
+  while (num < samples_num) {
+    for (size_t i = 0; i < negative_nodes.size() && num < samples_num; ++i) {
+      std::uniform_int_distribution<size_t> distribution(i, negative_nodes.size() - 1);
+      std::swap(negative_nodes[i], negative_nodes[distribution(*rng)]);
+      out_samples[num++] = negative_nodes[i];
     }
   }
-  *start_index = index;
   return Status::OK();
 }
 
@@ -316,50 +381,30 @@ Status GraphDataImpl::GetNegSampledNeighbors(const std::vector<NodeIdType> &node
   RETURN_IF_NOT_OK(CheckSamplesNum(samples_num));
   RETURN_IF_NOT_OK(CheckNeighborType(neg_neighbor_type));
   RETURN_UNEXPECTED_IF_NULL(out);
+  for (const auto &id : node_list) {
+    StoreIndexType node;
+    RETURN_IF_NOT_OK(GetNodeIndex(id, &node));
+  }
 
+  // Each row is the input node followed by its negative neighbors
   const std::vector<NodeIdType> &all_nodes = node_type_map_[neg_neighbor_type];
-  std::vector<NodeIdType> shuffled_id(all_nodes.size());
-  std::iota(shuffled_id.begin(), shuffled_id.end(), 0);
-  std::shuffle(shuffled_id.begin(), shuffled_id.end(), rnd_);
-  size_t start_index = 0;
-  bool need_shuffle = false;
-
-  std::vector<std::vector<NodeIdType>> neg_neighbors_vec;
-  neg_neighbors_vec.resize(node_list.size());
-  for (size_t node_idx = 0; node_idx < node_list.size(); ++node_idx) {
-    std::shared_ptr<Node> node;
-    RETURN_IF_NOT_OK(GetNodeByNodeId(node_list[node_idx], &node));
-    std::vector<NodeIdType> neighbors;
-    RETURN_IF_NOT_OK(node->GetAllNeighbors(neg_neighbor_type, &neighbors));
-    std::unordered_set<NodeIdType> exclude_nodes;
-    (void)std::transform(neighbors.begin(), neighbors.end(),
-                         std::insert_iterator<std::unordered_set<NodeIdType>>(exclude_nodes, exclude_nodes.begin()),
-                         [](const NodeIdType node) { return node; });
-    neg_neighbors_vec[node_idx].emplace_back(node->id());
-    if (all_nodes.size() > exclude_nodes.size()) {
-      while (neg_neighbors_vec[node_idx].size() < samples_num + 1) {
-        RETURN_IF_NOT_OK(NegativeSample(all_nodes, shuffled_id, &start_index, exclude_nodes, samples_num + 1,
-                                        &neg_neighbors_vec[node_idx]));
-        if (start_index >= shuffled_id.size()) {
-          start_index = start_index % shuffled_id.size();
-          need_shuffle = true;
-        }
-      }
-    } else {
-      MS_LOG(DEBUG) << "There are no negative neighbors. node_id:" << node->id()
-                    << " neg_neighbor_type:" << neg_neighbor_type;
-      // If there are no negative neighbors, they are filled with kDefaultNodeId
-      for (int32_t i = 0; i < samples_num; ++i) {
-        neg_neighbors_vec[node_idx].emplace_back(kDefaultNodeId);
-      }
-    }
-    if (need_shuffle) {
-      std::shuffle(shuffled_id.begin(), shuffled_id.end(), rnd_);
-      start_index = 0;
-      need_shuffle = false;
+  size_t row_size = static_cast<size_t>(samples_num) + 1;
+  std::shared_ptr<Tensor> tensor;
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(
+    TensorShape({static_cast<dsize_t>(node_list.size()), static_cast<dsize_t>(row_size)}),
+    DataType(DataType::DE_INT32), &tensor));
+  NodeIdType *result = &(*tensor->begin<NodeIdType>());
+  auto sample_rows = [&](size_t begin, size_t end, std::mt19937 *rng) -> Status {
+    for (size_t i = begin; i < end; ++i) {
+      NodeIdType *row = result + i * row_size;
+      row[0] = node_list[i];
+      RETURN_IF_NOT_OK(NegativeSample(node_list[i], all_nodes, neg_neighbor_type, samples_num, rng, row + 1));
     }
-  }
-  RETURN_IF_NOT_OK(CreateTensorByVector<NodeIdType>(neg_neighbors_vec, DataType(DataType::DE_INT32), out));
+    return Status::OK();
+  };
+  RETURN_IF_NOT_OK(ParallelForBlocks(node_list.size(), num_workers_, sample_rows));
+  tensor->Squeeze();
+  *out = std::move(tensor);
   return Status::OK();
 }
 
@@ -367,10 +412,10 @@ Status GraphDataImpl::RandomWalk(const std::vector<NodeIdType> &node_list, const
                                  float step_home_param, float step_away_param, NodeIdType default_node,
                                  std::shared_ptr<Tensor> *out) {
   RETURN_UNEXPECTED_IF_NULL(out);
-  RETURN_IF_NOT_OK(random_walk_.Build(node_list, meta_path, step_home_param, step_away_param, default_node));
-  std::vector<std::vector<NodeIdType>> walks;
-  RETURN_IF_NOT_OK(random_walk_.SimulateWalk(&walks));
-  RETURN_IF_NOT_OK(CreateTensorByVector<NodeIdType>({walks}, DataType(DataType::DE_INT32), out));
+  std::unique_lock<std::mutex> lock(random_walk_mutex_);
+  RETURN_IF_NOT_OK(
+    random_walk_.Build(node_list, meta_path, step_home_param, step_away_param, default_node, 1, num_workers_));
+  RETURN_IF_NOT_OK(random_walk_.SimulateWalk(out));
   return Status::OK();
 }
 
@@ -418,20 +463,25 @@ Status GraphDataImpl::GetNodeFeature(const std::shared_ptr<Tensor> &nodes,
     std::shared_ptr<Tensor> fea_tensor;
     RETURN_IF_NOT_OK(Tensor::CreateEmpty(shape, default_feature->Value()->type(), &fea_tensor));
 
-    dsize_t index = 0;
-    for (auto node_itr = nodes->begin<NodeIdType>(); node_itr != nodes->end<NodeIdType>(); ++node_itr) {
-      std::shared_ptr<Feature> feature;
-      if (*node_itr == kDefaultNodeId) {
-        feature = default_feature;
-      } else {
-        std::shared_ptr<Node> node;
-
-        if (!GetNodeByNodeId(*node_itr, &node).IsOk() || !node->GetFeatures(f_type, &feature).IsOk()) {
+    const FeatureColumn *column = graph_store_->GetNodeFeatureColumn(f_type);
+    if (column != nullptr) {
+      RETURN_IF_NOT_OK(CopyFeatureRows(*column, nodes, true, default_feature->Value(), fea_tensor));
+    } else {
+      dsize_t index = 0;
+      for (auto node_itr = nodes->begin<NodeIdType>(); node_itr != nodes->end<NodeIdType>(); ++node_itr) {
+        std::shared_ptr<Feature> feature;
+        if (*node_itr == kDefaultNodeId) {
           feature = default_feature;
+        } else {
+          std::shared_ptr<Node> node;
+
+          if (!GetNodeByNodeId(*node_itr, &node).IsOk() || !node->GetFeatures(f_type, &feature).IsOk()) {
+            feature = default_feature;
+          }
         }
+        RETURN_IF_NOT_OK(fea_tensor->InsertTensor({index}, feature->Value()));
+        index++;
       }
-      RETURN_IF_NOT_OK(fea_tensor->InsertTensor({index}, feature->Value()));
-      index++;
     }
 
     TensorShape reshape(nodes->shape());
@@ -508,16 +558,21 @@ Status GraphDataImpl::GetEdgeFeature(const std::shared_ptr<Tensor> &edges,
     std::shared_ptr<Tensor> fea_tensor;
     RETURN_IF_NOT_OK(Tensor::CreateEmpty(shape, default_feature->Value()->type(), &fea_tensor));
 
-    dsize_t index = 0;
-    for (auto edge_itr = edges->begin<EdgeIdType>(); edge_itr != edges->end<EdgeIdType>(); ++edge_itr) {
-      std::shared_ptr<Edge> edge;
-      std::shared_ptr<Feature> feature;
+    const FeatureColumn *column = graph_store_->GetEdgeFeatureColumn(f_type);
+    if (column != nullptr) {
+      RETURN_IF_NOT_OK(CopyFeatureRows(*column, edges, false, default_feature->Value(), fea_tensor));
+    } else {
+      dsize_t index = 0;
+      for (auto edge_itr = edges->begin<EdgeIdType>(); edge_itr != edges->end<EdgeIdType>(); ++edge_itr) {
+        std::shared_ptr<Edge> edge;
+        std::shared_ptr<Feature> feature;
 
-      if (!GetEdgeByEdgeId(*edge_itr, &edge).IsOk() || !edge->GetFeatures(f_type, &feature).IsOk()) {
-        feature = default_feature;
+        if (!GetEdgeByEdgeId(*edge_itr, &edge).IsOk() || !edge->GetFeatures(f_type, &feature).IsOk()) {
+          feature = default_feature;
+        }
+        RETURN_IF_NOT_OK(fea_tensor->InsertTensor({index}, feature->Value()));
+        index++;
       }
-      RETURN_IF_NOT_OK(fea_tensor->InsertTensor({index}, feature->Value()));
-      index++;
     }
 
     TensorShape reshape(edges->shape());
@@ -566,8 +621,49 @@ Status GraphDataImpl::GetEdgeFeatureSharedMemory(const std::shared_ptr<Tensor> &
   return Status::OK();
 }
 
+Status GraphDataImpl::CopyFeatureRows(const FeatureColumn &column, const std::shared_ptr<Tensor> &ids, bool is_node,
+                                      const std::shared_ptr<Tensor> &default_value,
+                                      const std::shared_ptr<Tensor> &out) {
+  size_t row_bytes = column.row_bytes();
+  CHECK_FAIL_RETURN_UNEXPECTED(column.type() == default_value->type() &&
+                                 row_bytes == static_cast<size_t>(default_value->SizeInBytes()) &&
+                                 out->SizeInBytes() == static_cast<dsize_t>(ids->Size() * row_bytes),
+                               "The feature column doesn't match the default feature.");
+  if (row_bytes == 0) {
+    return Status::OK();
+  }
+  uchar *dst = nullptr;
+  TensorShape remaining = TensorShape::CreateScalar();
+  RETURN_IF_NOT_OK(out->StartAddrOfIndex({0}, &dst, &remaining));
+  for (auto itr = ids->begin<NodeIdType>(); itr != ids->end<NodeIdType>(); ++itr) {
+    StoreIndexType index = kInvalidStoreIndex;
+    if (!is_node) {
+      index = graph_store_->FindEdge(*itr);
+    } else if (*itr != kDefaultNodeId) {
+      index = graph_store_->FindNode(*itr);
+    }
+    const uchar *src = column.HasRow(index) ? column.Row(index) : default_value->GetBuffer();
+    CHECK_FAIL_RETURN_UNEXPECTED(memcpy_s(dst, row_bytes, src, row_bytes) == EOK, "Failed to copy feature.");
+    dst += row_bytes;
+  }
+  return Status::OK();
+}
+
 Status GraphDataImpl::Init() {
-  RETURN_IF_NOT_OK(LoadNodeAndEdge());
+  if (GraphStore::IsGraphStoreFile(dataset_file_)) {
+    RETURN_IF_NOT_OK(LoadGraphStore());
+  } else {
+    RETURN_IF_NOT_OK(LoadNodeAndEdge());
+  }
+  return Status::OK();
+}
+
+Status GraphDataImpl::SaveGraphStore(const std::string &file_name) {
+  CHECK_FAIL_RETURN_UNEXPECTED(!server_mode_ && node_id_map_.empty() && edge_id_map_.empty(),
+                               "Failed to save graph store, the features are not stored in columns.");
+  CHECK_FAIL_RETURN_UNEXPECTED(file_name != dataset_file_, "Failed to save graph store, " + file_name +
+                                                             " is the dataset file being used.");
+  RETURN_IF_NOT_OK(graph_store_->Save(file_name));
   return Status::OK();
 }
 
@@ -635,6 +731,41 @@ Status GraphDataImpl::LoadNodeAndEdge() {
   return Status::OK();
 }
 
+Status GraphDataImpl::LoadGraphStore() {
+  CHECK_FAIL_RETURN_UNEXPECTED(!server_mode_,
+                               "Graph store file can't be used in server mode, please use the mindrecord file.");
+  RETURN_IF_NOT_OK(graph_store_->Load(dataset_file_));
+  for (size_t i = 0; i < graph_store_->NumNodes(); ++i) {
+    node_type_map_[graph_store_->GetNodeType(i)].push_back(graph_store_->NodeId(i));
+  }
+  for (size_t i = 0; i < graph_store_->NumEdges(); ++i) {
+    edge_type_map_[graph_store_->GetEdgeType(i)].push_back(graph_store_->EdgeId(i));
+  }
+  for (const auto &itr : graph_store_->node_features()) {
+    for (size_t i = 0; i < graph_store_->NumNodes(); ++i) {
+      if (itr.second.HasRow(i)) {
+        (void)node_feature_map_[graph_store_->GetNodeType(i)].insert(itr.first);
+      }
+    }
+    std::shared_ptr<Tensor> zero_tensor;
+    RETURN_IF_NOT_OK(Tensor::CreateEmpty(itr.second.shape(), itr.second.type(), &zero_tensor));
+    RETURN_IF_NOT_OK(zero_tensor->Zero());
+    default_node_feature_map_[itr.first] = std::make_shared<Feature>(itr.first, zero_tensor);
+  }
+  for (const auto &itr : graph_store_->edge_features()) {
+    for (size_t i = 0; i < graph_store_->NumEdges(); ++i) {
+      if (itr.second.HasRow(i)) {
+        (void)edge_feature_map_[graph_store_->GetEdgeType(i)].insert(itr.first);
+      }
+    }
+    std::shared_ptr<Tensor> zero_tensor;
+    RETURN_IF_NOT_OK(Tensor::CreateEmpty(itr.second.shape(), itr.second.type(), &zero_tensor));
+    RETURN_IF_NOT_OK(zero_tensor->Zero());
+    default_edge_feature_map_[itr.first] = std::make_shared<Feature>(itr.first, zero_tensor);
+  }
+  return Status::OK();
+}
+
 Status GraphDataImpl::GetNodeByNodeId(NodeIdType id, std::shared_ptr<Node> *node) {
   RETURN_UNEXPECTED_IF_NULL(node);
   auto itr = node_id_map_.find(id);
@@ -659,6 +790,116 @@ Status GraphDataImpl::GetEdgeByEdgeId(EdgeIdType id, std::shared_ptr<Edge> *edge
   return Status::OK();
 }
 
+Status GraphDataImpl::GetNodeIndex(NodeIdType id, StoreIndexType *index) {
+  RETURN_UNEXPECTED_IF_NULL(index);
+  *index = graph_store_->FindNode(id);
+  if (*index == kInvalidStoreIndex) {
+    std::string err_msg = "Invalid node id:" + std::to_string(id);
+    RETURN_STATUS_UNEXPECTED(err_msg);
+  }
+  return Status::OK();
+}
+
+Status GraphDataImpl::GetNeighborIds(NodeIdType id, NodeType neighbor_type, bool exclude_itself,
+                                     std::vector<NodeIdType> *out_neighbors) {
+  RETURN_UNEXPECTED_IF_NULL(out_neighbors);
+  StoreIndexType node;
+  RETURN_IF_NOT_OK(GetNodeIndex(id, &node));
+  GraphStore::NeighborRange range = graph_store_->GetNeighbors(node, neighbor_type);
+  std::vector<NodeIdType> neighbors;
+  neighbors.reserve(range.size + 1);
+  if (!exclude_itself) {
+    neighbors.emplace_back(id);
+  }
+  for (size_t i = 0; i < range.size; ++i) {
+    neighbors.emplace_back(graph_store_->NodeId(range.nodes[i]));
+  }
+  *out_neighbors = std::move(neighbors);
+  return Status::OK();
+}
+
+Status GraphDataImpl::SampleNeighbors(StoreIndexType node, NodeType neighbor_type, int32_t samples_num,
+                                      SamplingStrategy strategy, std::mt19937 *rng, std::vector<uint32_t> *positions,
+                                      StoreIndexType *out_neighbors) {
+  RETURN_UNEXPECTED_IF_NULL(rng);
+  RETURN_UNEXPECTED_IF_NULL(positions);
+  RETURN_UNEXPECTED_IF_NULL(out_neighbors);
+  GraphStore::NeighborRange range = graph_store_->GetNeighbors(node, neighbor_type);
+  if (range.size == 0) {
+    MS_LOG(DEBUG) << "There are no neighbors. node_id:" << graph_store_->NodeId(node)
+                  << " neighbor_type:" << neighbor_type;
+    // If there are no neighbors, they are filled with kInvalidStoreIndex, which is output as kDefaultNodeId
+    std::fill_n(out_neighbors, samples_num, kInvalidStoreIndex);
+    return Status::OK();
+  }
+  if (strategy == SamplingStrategy::kRandom) {
+    // Take the neighbors without replacement by partial shuffle, and start over when all of them are taken
+    int32_t num = 0;
+    while (num < samples_num) {
+      positions->resize(range.size);
+      std::iota(positions->begin(), positions->end(), 0);
+      for (size_t i = 0; i < range.size && num < samples_num; ++i) {
+        std::uniform_int_distribution<size_t> distribution(i, range.size - 1);
+        std::swap((*positions)[i], (*positions)[distribution(*rng)]);
+        out_neighbors[num++] = range.nodes[(*positions)[i]];
+      }
+    }
+  } else if (strategy == SamplingStrategy::kEdgeWeight) {
+    std::vector<WeightType> weights(range.size);
+    for (size_t i = 0; i < range.size; ++i) {
+      weights[i] = graph_store_->EdgeWeight(range.edges[i]);
+    }
+    std::discrete_distribution<NodeIdType> discrete_dist(weights.begin(), weights.end());
+    for (int32_t i = 0; i < samples_num; ++i) {
+      out_neighbors[i] = range.nodes[discrete_dist(*rng)];
+    }
+  } else {
+    RETURN_STATUS_UNEXPECTED("Invalid strategy");
+  }
+  return Status::OK();
+}
+
+Status GraphDataImpl::ParallelForBlocks(size_t num_rows, int32_t num_workers,
+                                        const std::function<Status(size_t, size_t, std::mt19937 *)> &func) {
+  uint32_t seed = 0;
+  {
+    std::unique_lock<std::mutex> lock(rnd_mutex_);
+    seed = static_cast<uint32_t>(rnd_());
+  }
+  size_t num_blocks = (num_rows + kSampleBlockSize - 1) / kSampleBlockSize;
+  auto run_block = [&](size_t block) -> Status {
+    std::seed_seq seq{seed, static_cast<uint32_t>(block)};
+    std::mt19937 rng(seq);
+    size_t begin = block * kSampleBlockSize;
+    return func(begin, std::min(begin + kSampleBlockSize, num_rows), &rng);
+  };
+  size_t num_threads = std::min(static_cast<size_t>(std::max(num_workers, 1)), num_blocks);
+  if (num_threads <= 1) {
+    for (size_t block = 0; block < num_blocks; ++block) {
+      RETURN_IF_NOT_OK(run_block(block));
+    }
+    return Status::OK();
+  }
+
+  // The workers take the blocks in turn until all of them are done
+  std::atomic<size_t> next_block(0);
+  auto worker = [&]() -> Status {
+    TaskManager::FindMe()->Post();
+    for (size_t block = next_block++; block < num_blocks; block = next_block++) {
+      RETURN_IF_NOT_OK(run_block(block));
+    }
+    return Status::OK();
+  };
+  TaskGroup vg;
+  for (size_t i = 0; i < num_threads; ++i) {
+    RETURN_IF_NOT_OK(vg.CreateAsyncTask("GraphSampler", worker));
+  }
+  // wait for threads to finish and check its return code
+  RETURN_IF_NOT_OK(vg.join_all(Task::WaitFlag::kBlocking));
+  RETURN_IF_NOT_OK(vg.GetTaskErrorIfAny());
+  return Status::OK();
+}
+
 GraphDataImpl::RandomWalkBase::RandomWalkBase(GraphDataImpl *graph)
     : graph_(graph), step_home_param_(1.0), step_away_param_(1.0), default_node_(-1), num_walks_(1), num_workers_(1) {}
 
@@ -667,7 +908,12 @@ Status GraphDataImpl::RandomWalkBase::Build(const std::vector<NodeIdType> &node_
                                             float step_away_param, const NodeIdType default_node, int32_t num_walks,
                                             int32_t num_workers) {
   CHECK_FAIL_RETURN_UNEXPECTED(!node_list.empty(), "Input node_list is empty.");
+  std::vector<StoreIndexType> node_index_list(node_list.size());
+  for (size_t i = 0; i < node_list.size(); ++i) {
+    RETURN_IF_NOT_OK(graph_->GetNodeIndex(node_list[i], &node_index_list[i]));
+  }
   node_list_ = node_list;
+  node_index_list_ = std::move(node_index_list);
   if (meta_path.empty() || meta_path.size() > kMaxNumWalks) {
     std::string err_msg = "Failed, meta path required between 1 and " + std::to_string(kMaxNumWalks) +
                           ". The size of input path is " + std::to_string(meta_path.size());
@@ -695,6 +941,10 @@ Status GraphDataImpl::RandomWalkBase::Build(const std::vector<NodeIdType> &node_
     std::string err_msg = "Failed, num_workers parameter required to be greater than 0";
     RETURN_STATUS_UNEXPECTED(err_msg);
   }
+  // The alias tables depend on the hyper parameters
+  if (step_home_param != step_home_param_ || step_away_param != step_away_param_) {
+    ClearAliasTables();
+  }
   step_home_param_ = step_home_param;
   step_away_param_ = step_away_param;
   default_node_ = default_node;
@@ -703,100 +953,99 @@ Status GraphDataImpl::RandomWalkBase::Build(const std::vector<NodeIdType> &node_
   return Status::OK();
 }
 
-Status GraphDataImpl::RandomWalkBase::Node2vecWalk(const NodeIdType &start_node, std::vector<NodeIdType> *walk_path) {
+Status GraphDataImpl::RandomWalkBase::Node2vecWalk(StoreIndexType start_node, std::mt19937 *rng,
+                                                   NodeIdType *walk_path) {
+  RETURN_UNEXPECTED_IF_NULL(rng);
   RETURN_UNEXPECTED_IF_NULL(walk_path);
+  const GraphStore *store = graph_->graph_store_.get();
   // Simulate a random walk starting from start node.
-  auto walk = std::vector<NodeIdType>(1, start_node);  // walk is an vector
-  // walk simulate
-  while (walk.size() - 1 < meta_path_.size()) {
-    // current nodE
-    auto cur_node_id = walk.back();
-    std::shared_ptr<Node> cur_node;
-    RETURN_IF_NOT_OK(graph_->GetNodeByNodeId(cur_node_id, &cur_node));
-
-    // current neighbors
-    std::vector<NodeIdType> cur_neighbors;
-    RETURN_IF_NOT_OK(cur_node->GetAllNeighbors(meta_path_[walk.size() - 1], &cur_neighbors, true));
-    std::sort(cur_neighbors.begin(), cur_neighbors.end());
-
-    // break if no neighbors
-    if (cur_neighbors.empty()) {
-      break;
-    }
-
+  walk_path[0] = store->NodeId(start_node);
+  StoreIndexType prev_node = kInvalidStoreIndex;
+  StoreIndexType cur_node = start_node;
+  size_t walk_size = 1;
+  while (walk_size - 1 < meta_path_.size()) {
     // walk by the fist node, then by the previous 2 nodes
-    std::shared_ptr<StochasticIndex> stochastic_index;
-    if (walk.size() == 1) {
-      RETURN_IF_NOT_OK(GetNodeProbability(cur_node_id, meta_path_[0], &stochastic_index));
+    StoreIndexType next_node;
+    if (walk_size == 1) {
+      // All the neighbors of the start node have the same probability
+      GraphStore::NeighborRange range = store->GetNeighbors(cur_node, meta_path_[0]);
+      // break if no neighbors
+      if (range.size == 0) {
+        break;
+      }
+      std::uniform_int_distribution<size_t> distribution(0, range.size - 1);
+      next_node = range.nodes[distribution(*rng)];
     } else {
-      NodeIdType prev_node_id = walk[walk.size() - 2];
-      RETURN_IF_NOT_OK(GetEdgeProbability(prev_node_id, cur_node_id, walk.size() - 2, &stochastic_index));
+      std::shared_ptr<const AliasTable> alias_table;
+      RETURN_IF_NOT_OK(GetEdgeProbability(prev_node, cur_node, walk_size - 2, &alias_table));
+      // break if no neighbors
+      if (alias_table->neighbors.empty()) {
+        break;
+      }
+      next_node = alias_table->neighbors[WalkToNextNode(alias_table->stochastic_index, rng)];
     }
-    NodeIdType next_node_id = cur_neighbors[WalkToNextNode(*stochastic_index)];
-    walk.push_back(next_node_id);
+    walk_path[walk_size++] = store->NodeId(next_node);
+    prev_node = cur_node;
+    cur_node = next_node;
   }
 
-  while (walk.size() - 1 < meta_path_.size()) {
-    walk.push_back(default_node_);
-  }
-
-  *walk_path = std::move(walk);
+  std::fill(walk_path + walk_size, walk_path + meta_path_.size() + 1, default_node_);
   return Status::OK();
 }
 
-Status GraphDataImpl::RandomWalkBase::SimulateWalk(std::vector<std::vector<NodeIdType>> *walks) {
+Status GraphDataImpl::RandomWalkBase::SimulateWalk(std::shared_ptr<Tensor> *walks) {
   RETURN_UNEXPECTED_IF_NULL(walks);
-  for (int32_t i = 0; i < num_walks_; ++i) {
-    for (const auto &node : node_list_) {
-      std::vector<NodeIdType> walk;
-      RETURN_IF_NOT_OK(Node2vecWalk(node, &walk));
-      walks->push_back(walk);
+  // The walks from all the nodes are repeated num_walks times, and each walk is written into one row
+  size_t num_rows = node_index_list_.size() * num_walks_;
+  size_t row_size = meta_path_.size() + 1;
+  std::shared_ptr<Tensor> tensor;
+  RETURN_IF_NOT_OK(
+    Tensor::CreateEmpty(TensorShape({static_cast<dsize_t>(num_rows), static_cast<dsize_t>(row_size)}),
+                        DataType(DataType::DE_INT32), &tensor));
+  NodeIdType *result = &(*tensor->begin<NodeIdType>());
+  auto walk_rows = [&](size_t begin, size_t end, std::mt19937 *rng) -> Status {
+    for (size_t i = begin; i < end; ++i) {
+      RETURN_IF_NOT_OK(Node2vecWalk(node_index_list_[i % node_index_list_.size()], rng, result + i * row_size));
     }
-  }
-  return Status::OK();
-}
-
-Status GraphDataImpl::RandomWalkBase::GetNodeProbability(const NodeIdType &node_id, const NodeType &node_type,
-                                                         std::shared_ptr<StochasticIndex> *node_probability) {
-  RETURN_UNEXPECTED_IF_NULL(node_probability);
-  // Generate alias nodes
-  std::shared_ptr<Node> node;
-  RETURN_IF_NOT_OK(graph_->GetNodeByNodeId(node_id, &node));
-  std::vector<NodeIdType> neighbors;
-  RETURN_IF_NOT_OK(node->GetAllNeighbors(node_type, &neighbors, true));
-  std::sort(neighbors.begin(), neighbors.end());
-  auto non_normalized_probability = std::vector<float>(neighbors.size(), 1.0);
-  *node_probability =
-    std::make_shared<StochasticIndex>(GenerateProbability(Normalize<float>(non_normalized_probability)));
+    return Status::OK();
+  };
+  RETURN_IF_NOT_OK(graph_->ParallelForBlocks(num_rows, num_workers_, walk_rows));
+  tensor->Squeeze();
+  *walks = std::move(tensor);
   return Status::OK();
 }
 
-Status GraphDataImpl::RandomWalkBase::GetEdgeProbability(const NodeIdType &src, const NodeIdType &dst,
+Status GraphDataImpl::RandomWalkBase::GetEdgeProbability(StoreIndexType src, StoreIndexType dst,
                                                          uint32_t meta_path_index,
-                                                         std::shared_ptr<StochasticIndex> *edge_probability) {
+                                                         std::shared_ptr<const AliasTable> *edge_probability) {
   RETURN_UNEXPECTED_IF_NULL(edge_probability);
-  // Get the alias edge setup lists for a given edge.
-  std::shared_ptr<Node> src_node;
-  RETURN_IF_NOT_OK(graph_->GetNodeByNodeId(src, &src_node));
-  std::vector<NodeIdType> src_neighbors;
-  RETURN_IF_NOT_OK(src_node->GetAllNeighbors(meta_path_[meta_path_index], &src_neighbors, true));
-
-  std::shared_ptr<Node> dst_node;
-  RETURN_IF_NOT_OK(graph_->GetNodeByNodeId(dst, &dst_node));
-  std::vector<NodeIdType> dst_neighbors;
-  RETURN_IF_NOT_OK(dst_node->GetAllNeighbors(meta_path_[meta_path_index + 1], &dst_neighbors, true));
+  AliasKey key = {src, dst, meta_path_[meta_path_index], meta_path_[meta_path_index + 1]};
+  AliasShard &shard = alias_shards_[AliasKeyHash()(key) % kNumAliasShards];
+  {
+    std::unique_lock<std::mutex> lock(shard.mutex);
+    auto itr = shard.tables.find(key);
+    if (itr != shard.tables.end()) {
+      *edge_probability = itr->second;
+      return Status::OK();
+    }
+  }
 
+  // Get the alias edge setup lists for a given edge.
   CHECK_FAIL_RETURN_UNEXPECTED(step_home_param_ != 0, "Invalid data, step home parameter can't be zero.");
   CHECK_FAIL_RETURN_UNEXPECTED(step_away_param_ != 0, "Invalid data, step away parameter can't be zero.");
-  std::sort(dst_neighbors.begin(), dst_neighbors.end());
+  const GraphStore *store = graph_->graph_store_.get();
+  GraphStore::NeighborRange src_range = store->GetNeighbors(src, key.dst_type);
+  std::vector<StoreIndexType> src_neighbors(src_range.nodes, src_range.nodes + src_range.size);
+  std::sort(src_neighbors.begin(), src_neighbors.end());
+  GraphStore::NeighborRange dst_range = store->GetNeighbors(dst, key.neighbor_type);
+  auto alias_table = std::make_shared<AliasTable>();
+  alias_table->neighbors.assign(dst_range.nodes, dst_range.nodes + dst_range.size);
   std::vector<float> non_normalized_probability;
-  for (const auto &dst_nbr : dst_neighbors) {
+  non_normalized_probability.reserve(dst_range.size);
+  for (const auto &dst_nbr : alias_table->neighbors) {
     if (dst_nbr == src) {
       non_normalized_probability.push_back(1.0 / step_home_param_);  // replace 1.0 with G[dst][dst_nbr]['weight']
-      continue;
-    }
-    auto it = std::find(src_neighbors.begin(), src_neighbors.end(), dst_nbr);
-    if (it != src_neighbors.end()) {
+    } else if (std::binary_search(src_neighbors.begin(), src_neighbors.end(), dst_nbr)) {
       // stay close, this node connect both src and dst
       non_normalized_probability.push_back(1.0);  // replace 1.0 with G[dst][dst_nbr]['weight']
     } else {
@@ -804,25 +1053,38 @@ Status GraphDataImpl::RandomWalkBase::GetEdgeProbability(const NodeIdType &src,
       non_normalized_probability.push_back(1.0 / step_away_param_);  // replace 1.0 with G[dst][dst_nbr]['weight']
     }
   }
+  alias_table->stochastic_index = GenerateProbability(Normalize<float>(non_normalized_probability));
 
-  *edge_probability =
-    std::make_shared<StochasticIndex>(GenerateProbability(Normalize<float>(non_normalized_probability)));
+  std::unique_lock<std::mutex> lock(shard.mutex);
+  auto itr = shard.tables.find(key);
+  if (itr != shard.tables.end()) {
+    *edge_probability = itr->second;
+  } else {
+    if (shard.num_elements + alias_table->neighbors.size() <= kMaxAliasShardElements) {
+      shard.num_elements += alias_table->neighbors.size();
+      (void)shard.tables.emplace(key, alias_table);
+    }
+    *edge_probability = std::move(alias_table);
+  }
   return Status::OK();
 }
 
+void GraphDataImpl::RandomWalkBase::ClearAliasTables() {
+  for (auto &shard : alias_shards_) {
+    std::unique_lock<std::mutex> lock(shard.mutex);
+    shard.tables.clear();
+    shard.num_elements = 0;
+  }
+}
+
 StochasticIndex GraphDataImpl::RandomWalkBase::GenerateProbability(const std::vector<float> &probability) {
   uint32_t K = probability.size();
   std::vector<int32_t> switch_to_large_index(K, 0);
   std::vector<float> weight(K, .0);
   std::vector<int32_t> smaller;
   std::vector<int32_t> larger;
-  auto random_device = GetRandomDevice();
-  std::uniform_real_distribution<> distribution(-kGnnEpsilon, kGnnEpsilon);
-  float accumulate_threshold = 0.0;
   for (uint32_t i = 0; i < K; i++) {
-    float threshold_one = distribution(random_device);
-    accumulate_threshold += threshold_one;
-    weight[i] = i < K - 1 ? probability[i] * K + threshold_one : probability[i] * K - accumulate_threshold;
+    weight[i] = probability[i] * K;
     weight[i] < 1.0 ? smaller.push_back(i) : larger.push_back(i);
   }
 
@@ -835,21 +1097,27 @@ StochasticIndex GraphDataImpl::RandomWalkBase::GenerateProbability(const std::ve
     weight[large] = weight[large] + weight[small] - 1.0;
     weight[large] < 1.0 ? smaller.push_back(large) : larger.push_back(large);
   }
+  // The rest are left by rounding errors, which always keep themselves
+  for (auto i : smaller) {
+    weight[i] = 1.0;
+  }
+  for (auto i : larger) {
+    weight[i] = 1.0;
+  }
   return StochasticIndex(switch_to_large_index, weight);
 }
 
-uint32_t GraphDataImpl::RandomWalkBase::WalkToNextNode(const StochasticIndex &stochastic_index) {
-  auto switch_to_large_index = stochastic_index.first;
-  auto weight = stochastic_index.second;
+uint32_t GraphDataImpl::RandomWalkBase::WalkToNextNode(const StochasticIndex &stochastic_index, std::mt19937 *rng) {
+  const auto &switch_to_large_index = stochastic_index.first;
+  const auto &weight = stochastic_index.second;
   const uint32_t size_of_index = switch_to_large_index.size();
 
-  auto random_device = GetRandomDevice();
   std::uniform_real_distribution<> distribution(0.0, 1.0);
 
   // Generate random integer between [0, K)
-  uint32_t random_idx = std::floor(distribution(random_device) * size_of_index);
+  uint32_t random_idx = std::min(static_cast<uint32_t>(distribution(*rng) * size_of_index), size_of_index - 1);
 
-  if (distribution(random_device) < weight[random_idx]) {
+  if (distribution(*rng) < weight[random_idx]) {
     return random_idx;
   }
   return switch_to_large_index[random_idx];
@@ -858,7 +1126,7 @@ uint32_t GraphDataImpl::RandomWalkBase::WalkToNextNode(const StochasticIndex &st
 template <typename T>
 std::vector<float> GraphDataImpl::RandomWalkBase::Normalize(const std::vector<T> &non_normalized_probability) {
   float sum_probability =
-    1.0 * std::accumulate(non_normalized_probability.begin(), non_normalized_probability.end(), 0);
+    std::accumulate(non_normalized_probability.begin(), non_normalized_probability.end(), 0.0f);
   if (sum_probability < kGnnEpsilon) {
     sum_probability = 1.0;
   }
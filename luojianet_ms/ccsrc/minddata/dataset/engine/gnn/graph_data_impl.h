@@ -18,7 +18,11 @@
 #define LUOJIANET_MS_CCSRC_MINDDATA_DATASET_ENGINE_GNN_GRAPH_DATA_IMPL_H_
 
 #include <algorithm>
+#include <array>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <random>
 #include <string>
 #include <map>
 #include <unordered_map>
@@ -30,6 +34,7 @@
 #if !defined(_WIN32) && !defined(_WIN64)
 #include "minddata/dataset/engine/gnn/graph_shared_memory.h"
 #endif
+#include "minddata/dataset/engine/gnn/graph_store.h"
 #include "minddata/mindrecord/include/common/shard_utils.h"
 
 namespace luojianet_ms {
@@ -38,6 +43,8 @@ namespace gnn {
 
 const float kGnnEpsilon = 0.0001;
 const uint32_t kMaxNumWalks = 80;
+// Rows sampled with one random stream, the results don't depend on the number of workers
+const size_t kSampleBlockSize = 64;
 using StochasticIndex = std::pair<std::vector<int32_t>, std::vector<float>>;
 
 class GraphDataImpl : public GraphData {
@@ -161,6 +168,11 @@ class GraphDataImpl : public GraphData {
 
   Status Init() override;
 
+  // Save the graph store, which can be loaded much faster than mindrecord by passing it as dataset_file
+  // @param std::string &file_name - file to write
+  // @return Status The status code returned
+  Status SaveGraphStore(const std::string &file_name);
+
   Status Stop() override { return Status::OK(); }
 
   std::string GetDataSchema() { return data_schema_.dump(); }
@@ -183,26 +195,73 @@ class GraphDataImpl : public GraphData {
 
     ~RandomWalkBase() = default;
 
-    Status SimulateWalk(std::vector<std::vector<NodeIdType>> *walks);
+    // Walk from every node num_walks times, the walks are written into the rows of tensor
+    // @param std::shared_ptr<Tensor> *walks - Returned walks, one walk per row
+    // @return Status The status code returned
+    Status SimulateWalk(std::shared_ptr<Tensor> *walks);
 
    private:
-    Status Node2vecWalk(const NodeIdType &start_node, std::vector<NodeIdType> *walk_path);
-
-    Status GetNodeProbability(const NodeIdType &node_id, const NodeType &node_type,
-                              std::shared_ptr<StochasticIndex> *node_probability);
-
-    Status GetEdgeProbability(const NodeIdType &src, const NodeIdType &dst, uint32_t meta_path_index,
-                              std::shared_ptr<StochasticIndex> *edge_probability);
+    // Neighbors of dst reached from src with their alias table
+    struct AliasTable {
+      std::vector<StoreIndexType> neighbors;
+      StochasticIndex stochastic_index;
+    };
+
+    // Key of the alias table, the walk goes from src to dst with dst_type, and then to a neighbor with neighbor_type
+    struct AliasKey {
+      StoreIndexType src;
+      StoreIndexType dst;
+      NodeType dst_type;
+      NodeType neighbor_type;
+      bool operator==(const AliasKey &other) const {
+        return src == other.src && dst == other.dst && dst_type == other.dst_type &&
+               neighbor_type == other.neighbor_type;
+      }
+    };
+
+    struct AliasKeyHash {
+      size_t operator()(const AliasKey &key) const {
+        uint64_t value = (static_cast<uint64_t>(key.src) << 32) | key.dst;
+        uint64_t types = (static_cast<uint64_t>(static_cast<uint8_t>(key.dst_type)) << 8) |
+                         static_cast<uint8_t>(key.neighbor_type);
+        return std::hash<uint64_t>()(value ^ (types * 0x9E3779B97F4A7C15ULL));
+      }
+    };
+
+    // The alias tables are split into shards to reduce the lock contention between workers
+    struct AliasShard {
+      std::mutex mutex;
+      std::unordered_map<AliasKey, std::shared_ptr<const AliasTable>, AliasKeyHash> tables;
+      size_t num_elements{0};
+    };
+
+    Status Node2vecWalk(StoreIndexType start_node, std::mt19937 *rng, NodeIdType *walk_path);
+
+    // Get the alias table of edge, which is built at the first visit and reused by the later walks
+    // @param StoreIndexType src - index of the previous node
+    // @param StoreIndexType dst - index of the current node
+    // @param uint32_t meta_path_index - index of the step from src to dst in meta path
+    // @param std::shared_ptr<const AliasTable> *edge_probability - Returned alias table
+    // @return Status The status code returned
+    Status GetEdgeProbability(StoreIndexType src, StoreIndexType dst, uint32_t meta_path_index,
+                              std::shared_ptr<const AliasTable> *edge_probability);
+
+    void ClearAliasTables();
 
     static StochasticIndex GenerateProbability(const std::vector<float> &probability);
 
-    static uint32_t WalkToNextNode(const StochasticIndex &stochastic_index);
+    static uint32_t WalkToNextNode(const StochasticIndex &stochastic_index, std::mt19937 *rng);
 
     template <typename T>
     std::vector<float> Normalize(const std::vector<T> &non_normalized_probability);
 
+    static constexpr size_t kNumAliasShards = 64;
+    // Upper bound of the cached neighbors in a shard, tables built after it is reached are not cached
+    static constexpr size_t kMaxAliasShardElements = (1 << 24) / kNumAliasShards;
+
     GraphDataImpl *graph_;
     std::vector<NodeIdType> node_list_;
+    std::vector<StoreIndexType> node_index_list_;
     std::vector<NodeType> meta_path_;
     float step_home_param_;  // Return hyper parameter. Default is 1.0
     float step_away_param_;  // In out hyper parameter. Default is 1.0
@@ -210,12 +269,19 @@ class GraphDataImpl : public GraphData {
 
     int32_t num_walks_;    // Number of walks per source. Default is 1
     int32_t num_workers_;  // The number of worker threads. Default is 1
+
+    // Alias tables are kept between the walks with the same meta path and hyper parameters
+    std::array<AliasShard, kNumAliasShards> alias_shards_;
   };
 
   // Load graph data from mindrecord file
   // @return Status The status code returned
   Status LoadNodeAndEdge();
 
+  // Load graph data from graph store file
+  // @return Status The status code returned
+  Status LoadGraphStore();
+
   // Create Tensor By Vector
   // @param std::vector<std::vector<T>> &data -
   // @param DataType type -
@@ -256,15 +322,62 @@ class GraphDataImpl : public GraphData {
   // @return Status The status code returned
   Status GetEdgeByEdgeId(EdgeIdType id, std::shared_ptr<Edge> *edge);
 
-  // Negative sampling
-  // @param std::vector<NodeIdType> &input_data - The data set to be sampled
-  // @param std::unordered_set<NodeIdType> &exclude_data - Data to be excluded
-  // @param int32_t samples_num -
-  // @param std::vector<NodeIdType> *out_samples - Sampling results returned
+  // Find the index of node in graph store
+  // @param NodeIdType id -
+  // @param StoreIndexType *index - Returned index
+  // @return Status The status code returned
+  Status GetNodeIndex(NodeIdType id, StoreIndexType *index);
+
+  // Get the neighbors of a node
+  // @param NodeIdType id - node id
+  // @param NodeType neighbor_type - type of neighbors
+  // @param bool exclude_itself - whether the node itself is excluded from the head of neighbors
+  // @param std::vector<NodeIdType> *out_neighbors - Returned neighbors id
+  // @return Status The status code returned
+  Status GetNeighborIds(NodeIdType id, NodeType neighbor_type, bool exclude_itself,
+                        std::vector<NodeIdType> *out_neighbors);
+
+  // Sample the neighbors of a node, filled with kInvalidStoreIndex if there is no neighbor
+  // @param StoreIndexType node - index of node
+  // @param NodeType neighbor_type - type of neighbors
+  // @param int32_t samples_num - number of samples
+  // @param SamplingStrategy strategy - sampling strategy
+  // @param std::mt19937 *rng - random stream of the caller
+  // @param std::vector<uint32_t> *positions - scratch buffer of the caller
+  // @param StoreIndexType *out_neighbors - Returned samples_num indexes of sampled neighbors
+  // @return Status The status code returned
+  Status SampleNeighbors(StoreIndexType node, NodeType neighbor_type, int32_t samples_num, SamplingStrategy strategy,
+                         std::mt19937 *rng, std::vector<uint32_t> *positions, StoreIndexType *out_neighbors);
+
+  // Sample the negative neighbors of a node, filled with kDefaultNodeId if there is no negative neighbor
+  // @param NodeIdType id - node id
+  // @param std::vector<NodeIdType> &candidates - all nodes of the negative neighbor type
+  // @param NodeType neg_neighbor_type - type of negative neighbors
+  // @param int32_t samples_num - number of samples
+  // @param std::mt19937 *rng - random stream of the caller
+  // @param NodeIdType *out_samples - Returned samples_num ids of sampled negative neighbors
+  // @return Status The status code returned
+  Status NegativeSample(NodeIdType id, const std::vector<NodeIdType> &candidates, NodeType neg_neighbor_type,
+                        int32_t samples_num, std::mt19937 *rng, NodeIdType *out_samples);
+
+  // Split rows into blocks of kSampleBlockSize and run func on the blocks with the worker threads. Each block has its
+  // own random stream derived from rnd_, so the results are reproducible with the same seed.
+  // @param size_t num_rows - number of rows
+  // @param int32_t num_workers - max number of worker threads
+  // @param std::function func - called with the range [begin, end) of rows and the random stream of the block
+  // @return Status The status code returned
+  Status ParallelForBlocks(size_t num_rows, int32_t num_workers,
+                           const std::function<Status(size_t, size_t, std::mt19937 *)> &func);
+
+  // Copy the features of nodes or edges from the feature column
+  // @param FeatureColumn &column - feature column
+  // @param std::shared_ptr<Tensor> &ids - ids of nodes or edges
+  // @param bool is_node - whether ids are node ids
+  // @param std::shared_ptr<Tensor> &default_value - feature used when the node or the edge doesn't have one
+  // @param std::shared_ptr<Tensor> &out - feature tensor to fill, whose first dim is the number of ids
   // @return Status The status code returned
-  Status NegativeSample(const std::vector<NodeIdType> &data, const std::vector<NodeIdType> shuffled_ids,
-                        size_t *start_index, const std::unordered_set<NodeIdType> &exclude_data, int32_t samples_num,
-                        std::vector<NodeIdType> *out_samples);
+  Status CopyFeatureRows(const FeatureColumn &column, const std::shared_ptr<Tensor> &ids, bool is_node,
+                         const std::shared_ptr<Tensor> &default_value, const std::shared_ptr<Tensor> &out);
 
   Status CheckSamplesNum(NodeIdType samples_num);
 
@@ -273,13 +386,17 @@ class GraphDataImpl : public GraphData {
   std::string dataset_file_;
   int32_t num_workers_;  // The number of worker threads
   std::mt19937 rnd_;
+  std::mutex rnd_mutex_;  // Guards rnd_, which seeds the random streams of the parallel sampling
   RandomWalkBase random_walk_;
+  std::mutex random_walk_mutex_;  // Serializes the walks of concurrent requests, each walk runs in parallel
   mindrecord::json data_schema_;
   bool server_mode_;
 #if !defined(_WIN32) && !defined(_WIN64)
   std::unique_ptr<GraphSharedMemory> graph_shared_memory_;
 #endif
+  std::unique_ptr<GraphStore> graph_store_;  // Topology and the features in columns
   std::unordered_map<NodeType, std::vector<NodeIdType>> node_type_map_;
+  // Nodes and edges are only kept when their features are not in the columns of graph store
   std::unordered_map<NodeIdType, std::shared_ptr<Node>> node_id_map_;
 
   std::unordered_map<EdgeType, std::vector<EdgeIdType>> edge_type_map_;
@@ -45,41 +45,103 @@ GraphLoader::GraphLoader(GraphDataImpl *graph_impl, std::string mr_filepath, int
       optional_key_({{"weight", false}}) {}
 
 Status GraphLoader::GetNodesAndEdges() {
-  NodeIdMap *n_id_map = &graph_impl_->node_id_map_;
-  EdgeIdMap *e_id_map = &graph_impl_->edge_id_map_;
+  std::vector<std::shared_ptr<Node>> nodes;
+  std::vector<NodeIdType> node_ids;
+  std::vector<NodeType> node_types;
+  std::unordered_set<NodeIdType> node_id_set;
   for (std::deque<std::shared_ptr<Node>> &dq : n_deques_) {
     while (dq.empty() == false) {
       std::shared_ptr<Node> node_ptr = dq.front();
-      n_id_map->insert({node_ptr->id(), node_ptr});
-      graph_impl_->node_type_map_[node_ptr->type()].push_back(node_ptr->id());
       dq.pop_front();
+      if (!node_id_set.insert(node_ptr->id()).second) {
+        MS_LOG(WARNING) << "Duplicate node id:" << node_ptr->id() << ", only the first one is kept.";
+        continue;
+      }
+      node_ids.push_back(node_ptr->id());
+      node_types.push_back(node_ptr->type());
+      graph_impl_->node_type_map_[node_ptr->type()].push_back(node_ptr->id());
+      nodes.push_back(std::move(node_ptr));
     }
   }
 
+  std::vector<std::shared_ptr<Edge>> edges;
+  std::vector<EdgeIdType> edge_ids;
+  std::vector<EdgeType> edge_types;
+  std::vector<NodeIdType> src_ids;
+  std::vector<NodeIdType> dst_ids;
+  std::vector<WeightType> edge_weights;
+  std::unordered_set<EdgeIdType> edge_id_set;
   for (std::deque<std::shared_ptr<Edge>> &dq : e_deques_) {
     while (dq.empty() == false) {
       std::shared_ptr<Edge> edge_ptr = dq.front();
+      dq.pop_front();
+      if (!edge_id_set.insert(edge_ptr->id()).second) {
+        MS_LOG(WARNING) << "Duplicate edge id:" << edge_ptr->id() << ", only the first one is kept.";
+        continue;
+      }
       std::pair<std::shared_ptr<Node>, std::shared_ptr<Node>> p;
       RETURN_IF_NOT_OK(edge_ptr->GetNode(&p));
-      auto src_itr = n_id_map->find(p.first->id()), dst_itr = n_id_map->find(p.second->id());
-
-      CHECK_FAIL_RETURN_UNEXPECTED(src_itr != n_id_map->end(), "invalid src_id:" + std::to_string(src_itr->first));
-      CHECK_FAIL_RETURN_UNEXPECTED(dst_itr != n_id_map->end(), "invalid src_id:" + std::to_string(dst_itr->first));
-
-      RETURN_IF_NOT_OK(edge_ptr->SetNode({src_itr->second, dst_itr->second}));
-      RETURN_IF_NOT_OK(src_itr->second->AddNeighbor(dst_itr->second, edge_ptr->weight()));
-      RETURN_IF_NOT_OK(src_itr->second->AddAdjacent(dst_itr->second, edge_ptr));
-
-      e_id_map->insert({edge_ptr->id(), edge_ptr});  // add edge to edge_id_map_
+      edge_ids.push_back(edge_ptr->id());
+      edge_types.push_back(edge_ptr->type());
+      src_ids.push_back(p.first->id());
+      dst_ids.push_back(p.second->id());
+      edge_weights.push_back(edge_ptr->weight());
       graph_impl_->edge_type_map_[edge_ptr->type()].push_back(edge_ptr->id());
-      dq.pop_front();
+      edges.push_back(std::move(edge_ptr));
     }
   }
 
   for (auto &itr : graph_impl_->node_type_map_) itr.second.shrink_to_fit();
   for (auto &itr : graph_impl_->edge_type_map_) itr.second.shrink_to_fit();
 
+  // the topology is only kept in the store, the edges reference their nodes by id
+  graph_impl_->graph_store_ = std::make_unique<GraphStore>();
+  RETURN_IF_NOT_OK(graph_impl_->graph_store_->Build(std::move(node_ids), std::move(node_types), std::move(edge_ids),
+                                                    std::move(edge_types), src_ids, dst_ids,
+                                                    std::move(edge_weights)));
   MergeFeatureMaps();
+
+  // features in shared memory are offsets kept by the nodes and edges, the others are moved into columns
+  if (!graph_impl_->server_mode_) {
+    Status rc = BuildFeatureColumns(nodes, edges);
+    if (rc.IsOk()) {
+      return Status::OK();
+    }
+    MS_LOG(WARNING) << "Features are kept in nodes and edges, because they can't be stored in columns: " << rc;
+    graph_impl_->graph_store_->ClearFeatureColumns();
+  }
+  for (auto &node_ptr : nodes) {
+    graph_impl_->node_id_map_.insert({node_ptr->id(), node_ptr});
+  }
+  for (auto &edge_ptr : edges) {
+    graph_impl_->edge_id_map_.insert({edge_ptr->id(), edge_ptr});
+  }
+  return Status::OK();
+}
+
+Status GraphLoader::BuildFeatureColumns(const std::vector<std::shared_ptr<Node>> &nodes,
+                                        const std::vector<std::shared_ptr<Edge>> &edges) {
+  GraphStore *store = graph_impl_->graph_store_.get();
+  for (const auto &itr : graph_impl_->default_node_feature_map_) {
+    FeatureColumn *column = store->AddNodeFeatureColumn(itr.first);
+    RETURN_IF_NOT_OK(column->Init(itr.second->Value(), nodes.size()));
+    for (size_t i = 0; i < nodes.size(); ++i) {
+      std::shared_ptr<Feature> feature;
+      if (nodes[i]->GetFeatures(itr.first, &feature).IsOk()) {
+        RETURN_IF_NOT_OK(column->SetRow(static_cast<StoreIndexType>(i), feature->Value()));
+      }
+    }
+  }
+  for (const auto &itr : graph_impl_->default_edge_feature_map_) {
+    FeatureColumn *column = store->AddEdgeFeatureColumn(itr.first);
+    RETURN_IF_NOT_OK(column->Init(itr.second->Value(), edges.size()));
+    for (size_t i = 0; i < edges.size(); ++i) {
+      std::shared_ptr<Feature> feature;
+      if (edges[i]->GetFeatures(itr.first, &feature).IsOk()) {
+        RETURN_IF_NOT_OK(column->SetRow(static_cast<StoreIndexType>(i), feature->Value()));
+      }
+    }
+  }
   return Status::OK();
 }
 
@@ -33,6 +33,7 @@
 #if !defined(_WIN32) && !defined(_WIN64)
 #include "minddata/dataset/engine/gnn/graph_shared_memory.h"
 #endif
+#include "minddata/dataset/engine/gnn/graph_store.h"
 #include "minddata/dataset/engine/gnn/node.h"
 #include "minddata/dataset/util/status.h"
 #include "minddata/mindrecord/include/shard_reader.h"
@@ -65,8 +66,8 @@ class GraphLoader {
   Status InitAndLoad();
 
   // this function will query mindrecord and construct all nodes and edges
-  // nodes and edges are added to map without any connection. That's because there nodes and edges are read in
-  // random order. src_node and dst_node in Edge are node_id only with -1 as type.
+  // nodes and edges are read in random order, so the connections are built afterwards into the graph store.
+  // src_node and dst_node in Edge are node_id only with -1 as type.
   // features attached to each node and edge are expected to be filled correctly
   Status GetNodesAndEdges();
 
@@ -99,6 +100,13 @@ class GraphLoader {
   // merge NodeFeatureMap and EdgeFeatureMap of each worker into 1
   void MergeFeatureMaps();
 
+  // Copy the features of nodes and edges into the feature columns of graph store
+  // @param std::vector<std::shared_ptr<Node>> &nodes - nodes in the order of graph store
+  // @param std::vector<std::shared_ptr<Edge>> &edges - edges in the order of graph store
+  // @return Status - the status code
+  Status BuildFeatureColumns(const std::vector<std::shared_ptr<Node>> &nodes,
+                             const std::vector<std::shared_ptr<Edge>> &edges);
+
   GraphDataImpl *graph_impl_;
   std::string mr_path_;
   const int32_t num_workers_;
@@ -0,0 +1,491 @@
+/**
+ * Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+ * Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/gnn/graph_store.h"
+
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <set>
+
+#include "minddata/dataset/util/log_adapter.h"
+
+namespace luojianet_ms {
+namespace dataset {
+namespace gnn {
+namespace {
+// Graph store file, laid out as: header | sections.
+//  header  : magic(8 bytes) | version(uint32) | reserved(uint32)
+//  sections: arrays of nodes, edges, adjacency of every neighbor type and feature columns, every array is prefixed by
+//            its element number(uint64) and padded to a multiple of kGraphStoreAlignSize
+// The integers are in the byte order of host.
+constexpr char kGraphStoreMagic[] = {'L', 'J', 'G', 'S', 'T', 'O', 'R', 'E'};
+constexpr uint32_t kGraphStoreVersion = 1;
+constexpr size_t kGraphStoreAlignSize = 8;
+
+class StoreWriter {
+ public:
+  explicit StoreWriter(std::ofstream *out) : out_(out) {}
+  ~StoreWriter() = default;
+
+  template <typename T>
+  void WriteValue(const T &value) {
+    WriteBytes(&value, sizeof(T));
+  }
+
+  template <typename T>
+  void WriteArray(const StoreArray<T> &array) {
+    WriteArray(array.data(), array.size());
+  }
+
+  template <typename T>
+  void WriteArray(const T *data, size_t size) {
+    WriteValue<uint64_t>(size);
+    WriteBytes(data, size * sizeof(T));
+    const char zeros[kGraphStoreAlignSize] = {0};
+    WriteBytes(zeros, (kGraphStoreAlignSize - pos_ % kGraphStoreAlignSize) % kGraphStoreAlignSize);
+  }
+
+  void WriteBytes(const void *data, size_t size) {
+    if (size > 0) {
+      (void)out_->write(reinterpret_cast<const char *>(data), static_cast<std::streamsize>(size));
+      pos_ += size;
+    }
+  }
+
+ private:
+  std::ofstream *out_;
+  size_t pos_{0};
+};
+
+class StoreParser {
+ public:
+  StoreParser(const uchar *buf, size_t size, size_t pos) : buf_(buf), size_(size), pos_(pos) {}
+  ~StoreParser() = default;
+
+  template <typename T>
+  Status ReadValue(T *value) {
+    CHECK_FAIL_RETURN_UNEXPECTED(size_ - pos_ >= sizeof(T), "Invalid graph store file, the file is truncated.");
+    (void)memcpy(value, buf_ + pos_, sizeof(T));
+    pos_ += sizeof(T);
+    return Status::OK();
+  }
+
+  template <typename T>
+  Status ReadArray(StoreArray<T> *array) {
+    uint64_t size = 0;
+    RETURN_IF_NOT_OK(ReadValue(&size));
+    CHECK_FAIL_RETURN_UNEXPECTED(size <= (size_ - pos_) / sizeof(T), "Invalid graph store file, the file is truncated.");
+    array->View(reinterpret_cast<const T *>(buf_ + pos_), size);
+    pos_ += size * sizeof(T);
+    pos_ = std::min(size_, (pos_ + kGraphStoreAlignSize - 1) / kGraphStoreAlignSize * kGraphStoreAlignSize);
+    return Status::OK();
+  }
+
+  bool End() const { return pos_ == size_; }
+
+ private:
+  const uchar *buf_;
+  size_t size_;
+  size_t pos_;
+};
+
+template <typename T>
+bool IndexInRange(const StoreArray<StoreIndexType> &indices, T bound) {
+  return std::all_of(indices.data(), indices.data() + indices.size(),
+                     [bound](StoreIndexType index) { return index < bound; });
+}
+
+// Sort the ids and record where each id is, duplicate ids are rejected
+template <typename T>
+Status SortIds(const StoreArray<T> &ids, const std::string &name, StoreArray<T> *sorted_ids,
+               StoreArray<StoreIndexType> *sorted_index) {
+  std::vector<StoreIndexType> index(ids.size());
+  for (size_t i = 0; i < index.size(); ++i) {
+    index[i] = static_cast<StoreIndexType>(i);
+  }
+  std::sort(index.begin(), index.end(), [&ids](StoreIndexType a, StoreIndexType b) { return ids[a] < ids[b]; });
+  std::vector<T> sorted(ids.size());
+  for (size_t i = 0; i < index.size(); ++i) {
+    sorted[i] = ids[index[i]];
+    if (i > 0 && sorted[i] == sorted[i - 1]) {
+      RETURN_STATUS_UNEXPECTED("Duplicate " + name + " id:" + std::to_string(sorted[i]));
+    }
+  }
+  sorted_ids->Assign(std::move(sorted));
+  sorted_index->Assign(std::move(index));
+  return Status::OK();
+}
+
+template <typename T>
+StoreIndexType FindId(const StoreArray<T> &sorted_ids, const StoreArray<StoreIndexType> &sorted_index, T id) {
+  const T *begin = sorted_ids.data();
+  const T *end = begin + sorted_ids.size();
+  const T *itr = std::lower_bound(begin, end, id);
+  if (itr == end || *itr != id) {
+    return kInvalidStoreIndex;
+  }
+  return sorted_index[itr - begin];
+}
+
+void WriteColumns(const std::map<FeatureType, FeatureColumn> &columns, StoreWriter *writer) {
+  writer->WriteValue<uint64_t>(columns.size());
+  for (const auto &itr : columns) {
+    const FeatureColumn &column = itr.second;
+    writer->WriteValue<int64_t>(itr.first);
+    writer->WriteValue<int64_t>(column.type().value());
+    std::vector<dsize_t> dims = column.shape().AsVector();
+    writer->WriteArray(dims.data(), dims.size());
+    writer->WriteArray(column.Row(0), column.num_rows() * column.row_bytes());
+    std::vector<uint8_t> present(column.num_rows());
+    for (size_t i = 0; i < present.size(); ++i) {
+      present[i] = column.HasRow(static_cast<StoreIndexType>(i)) ? 1 : 0;
+    }
+    writer->WriteArray(present.data(), present.size());
+  }
+}
+}  // namespace
+
+Status FeatureColumn::Init(const std::shared_ptr<Tensor> &sample, size_t num_rows) {
+  RETURN_UNEXPECTED_IF_NULL(sample);
+  CHECK_FAIL_RETURN_UNEXPECTED(sample->type().IsNumeric(), "Feature of string can't be stored in column.");
+  dims_ = sample->shape().AsVector();
+  type_ = sample->type();
+  row_bytes_ = static_cast<size_t>(sample->SizeInBytes());
+  data_.Assign(std::vector<uchar>(num_rows * row_bytes_, 0));
+  present_.Assign(std::vector<uint8_t>(num_rows, 0));
+  return Status::OK();
+}
+
+Status FeatureColumn::SetRow(StoreIndexType row, const std::shared_ptr<Tensor> &value) {
+  RETURN_UNEXPECTED_IF_NULL(value);
+  CHECK_FAIL_RETURN_UNEXPECTED(row < present_.size(), "Row of feature column is out of range.");
+  CHECK_FAIL_RETURN_UNEXPECTED(value->type() == type_ && value->shape().AsVector() == dims_,
+                               "Feature " + value->shape().ToString() + " " + value->type().ToString() +
+                                 " doesn't match the column " + shape().ToString() + " " + type_.ToString());
+  if (row_bytes_ > 0) {
+    CHECK_FAIL_RETURN_UNEXPECTED(
+      memcpy_s(data_.mutable_data() + row * row_bytes_, row_bytes_, value->GetBuffer(), row_bytes_) == EOK,
+      "Failed to copy feature into column.");
+  }
+  present_.mutable_data()[row] = 1;
+  return Status::OK();
+}
+
+GraphStore::~GraphStore() { Release(); }
+
+void GraphStore::Release() {
+#if !defined(_WIN32) && !defined(_WIN64)
+  if (buf_ != nullptr && file_data_.empty()) {
+    (void)munmap(const_cast<uchar *>(buf_), buf_size_);
+  }
+#endif
+  file_data_.clear();
+  buf_ = nullptr;
+  buf_size_ = 0;
+  // The arrays may view the released memory
+  node_ids_ = StoreArray<NodeIdType>();
+  node_types_ = StoreArray<NodeType>();
+  sorted_node_ids_ = StoreArray<NodeIdType>();
+  sorted_node_index_ = StoreArray<StoreIndexType>();
+  edge_ids_ = StoreArray<EdgeIdType>();
+  edge_types_ = StoreArray<EdgeType>();
+  edge_src_ = StoreArray<StoreIndexType>();
+  edge_dst_ = StoreArray<StoreIndexType>();
+  edge_weights_ = StoreArray<WeightType>();
+  sorted_edge_ids_ = StoreArray<EdgeIdType>();
+  sorted_edge_index_ = StoreArray<StoreIndexType>();
+  adjacency_.clear();
+  ClearFeatureColumns();
+}
+
+Status GraphStore::Build(std::vector<NodeIdType> &&node_ids, std::vector<NodeType> &&node_types,
+                         std::vector<EdgeIdType> &&edge_ids, std::vector<EdgeType> &&edge_types,
+                         const std::vector<NodeIdType> &src_ids, const std::vector<NodeIdType> &dst_ids,
+                         std::vector<WeightType> &&edge_weights) {
+  CHECK_FAIL_RETURN_UNEXPECTED(node_ids.size() == node_types.size(), "The sizes of node ids and types are different.");
+  CHECK_FAIL_RETURN_UNEXPECTED(edge_ids.size() == edge_types.size() && edge_ids.size() == src_ids.size() &&
+                                 edge_ids.size() == dst_ids.size() && edge_ids.size() == edge_weights.size(),
+                               "The sizes of edge ids, types, nodes and weights are different.");
+  CHECK_FAIL_RETURN_UNEXPECTED(node_ids.size() < kInvalidStoreIndex && edge_ids.size() < kInvalidStoreIndex,
+                               "Too many nodes or edges for graph store.");
+  node_ids_.Assign(std::move(node_ids));
+  node_types_.Assign(std::move(node_types));
+  RETURN_IF_NOT_OK(SortIds(node_ids_, "node", &sorted_node_ids_, &sorted_node_index_));
+
+  edge_ids_.Assign(std::move(edge_ids));
+  edge_types_.Assign(std::move(edge_types));
+  edge_weights_.Assign(std::move(edge_weights));
+  RETURN_IF_NOT_OK(SortIds(edge_ids_, "edge", &sorted_edge_ids_, &sorted_edge_index_));
+
+  size_t num_nodes = node_ids_.size();
+  size_t num_edges = edge_ids_.size();
+  std::vector<StoreIndexType> src(num_edges);
+  std::vector<StoreIndexType> dst(num_edges);
+  std::set<NodeType> neighbor_types;
+  for (size_t i = 0; i < num_edges; ++i) {
+    src[i] = FindNode(src_ids[i]);
+    dst[i] = FindNode(dst_ids[i]);
+    CHECK_FAIL_RETURN_UNEXPECTED(src[i] != kInvalidStoreIndex, "Invalid src_id:" + std::to_string(src_ids[i]));
+    CHECK_FAIL_RETURN_UNEXPECTED(dst[i] != kInvalidStoreIndex, "Invalid dst_id:" + std::to_string(dst_ids[i]));
+    (void)neighbor_types.insert(node_types_[dst[i]]);
+  }
+  edge_src_.Assign(std::move(src));
+  edge_dst_.Assign(std::move(dst));
+
+  // Counting sort of the edges by src for each neighbor type, which keeps the loading order of the neighbors
+  adjacency_.clear();
+  for (NodeType type : neighbor_types) {
+    std::vector<uint64_t> offsets(num_nodes + 1, 0);
+    for (size_t i = 0; i < num_edges; ++i) {
+      if (node_types_[edge_dst_[i]] == type) {
+        ++offsets[edge_src_[i] + 1];
+      }
+    }
+    for (size_t i = 0; i < num_nodes; ++i) {
+      offsets[i + 1] += offsets[i];
+    }
+    std::vector<uint64_t> cursor(offsets.begin(), offsets.end() - 1);
+    std::vector<StoreIndexType> nodes(offsets.back());
+    std::vector<StoreIndexType> edges(offsets.back());
+    for (size_t i = 0; i < num_edges; ++i) {
+      if (node_types_[edge_dst_[i]] == type) {
+        uint64_t pos = cursor[edge_src_[i]]++;
+        nodes[pos] = edge_dst_[i];
+        edges[pos] = static_cast<StoreIndexType>(i);
+      }
+    }
+    Adjacency &adjacency = adjacency_[type];
+    adjacency.offsets.Assign(std::move(offsets));
+    adjacency.nodes.Assign(std::move(nodes));
+    adjacency.edges.Assign(std::move(edges));
+  }
+  return Status::OK();
+}
+
+StoreIndexType GraphStore::FindNode(NodeIdType id) const { return FindId(sorted_node_ids_, sorted_node_index_, id); }
+
+StoreIndexType GraphStore::FindEdge(EdgeIdType id) const { return FindId(sorted_edge_ids_, sorted_edge_index_, id); }
+
+GraphStore::NeighborRange GraphStore::GetNeighbors(StoreIndexType node, NodeType neighbor_type) const {
+  auto itr = adjacency_.find(neighbor_type);
+  if (itr == adjacency_.end() || node >= NumNodes()) {
+    return {nullptr, nullptr, 0};
+  }
+  const Adjacency &adjacency = itr->second;
+  uint64_t begin = adjacency.offsets[node];
+  uint64_t end = adjacency.offsets[node + 1];
+  return {adjacency.nodes.data() + begin, adjacency.edges.data() + begin, static_cast<size_t>(end - begin)};
+}
+
+StoreIndexType GraphStore::FindEdgeByNodes(StoreIndexType src, StoreIndexType dst) const {
+  StoreIndexType edge = kInvalidStoreIndex;
+  if (dst >= NumNodes()) {
+    return edge;
+  }
+  NeighborRange range = GetNeighbors(src, node_types_[dst]);
+  for (size_t i = 0; i < range.size; ++i) {
+    if (range.nodes[i] == dst && range.edges[i] < edge) {
+      edge = range.edges[i];
+    }
+  }
+  return edge;
+}
+
+const FeatureColumn *GraphStore::GetNodeFeatureColumn(FeatureType type) const {
+  auto itr = node_features_.find(type);
+  return itr == node_features_.end() ? nullptr : &itr->second;
+}
+
+const FeatureColumn *GraphStore::GetEdgeFeatureColumn(FeatureType type) const {
+  auto itr = edge_features_.find(type);
+  return itr == edge_features_.end() ? nullptr : &itr->second;
+}
+
+Status GraphStore::Save(const std::string &file_name) const {
+  std::ofstream out(file_name, std::ios::out | std::ios::trunc | std::ios::binary);
+  CHECK_FAIL_RETURN_UNEXPECTED(out.is_open(), "Failed to open graph store file: " + file_name);
+  StoreWriter writer(&out);
+  writer.WriteBytes(kGraphStoreMagic, sizeof(kGraphStoreMagic));
+  writer.WriteValue<uint32_t>(kGraphStoreVersion);
+  writer.WriteValue<uint32_t>(0);
+
+  writer.WriteArray(node_ids_);
+  writer.WriteArray(node_types_);
+  writer.WriteArray(sorted_node_ids_);
+  writer.WriteArray(sorted_node_index_);
+  writer.WriteArray(edge_ids_);
+  writer.WriteArray(edge_types_);
+  writer.WriteArray(edge_src_);
+  writer.WriteArray(edge_dst_);
+  writer.WriteArray(edge_weights_);
+  writer.WriteArray(sorted_edge_ids_);
+  writer.WriteArray(sorted_edge_index_);
+
+  writer.WriteValue<uint64_t>(adjacency_.size());
+  for (const auto &itr : adjacency_) {
+    writer.WriteValue<int64_t>(itr.first);
+    writer.WriteArray(itr.second.offsets);
+    writer.WriteArray(itr.second.nodes);
+    writer.WriteArray(itr.second.edges);
+  }
+  WriteColumns(node_features_, &writer);
+  WriteColumns(edge_features_, &writer);
+
+  out.close();
+  CHECK_FAIL_RETURN_UNEXPECTED(!out.fail(), "Failed to write graph store file: " + file_name);
+  return Status::OK();
+}
+
+bool GraphStore::IsGraphStoreFile(const std::string &file_name) {
+  std::ifstream in(file_name, std::ios::in | std::ios::binary);
+  if (!in.is_open()) {
+    return false;
+  }
+  char magic[sizeof(kGraphStoreMagic)] = {0};
+  (void)in.read(magic, sizeof(magic));
+  return in.gcount() == static_cast<std::streamsize>(sizeof(magic)) &&
+         memcmp(magic, kGraphStoreMagic, sizeof(magic)) == 0;
+}
+
+Status GraphStore::Load(const std::string &file_name) {
+  Release();
+  file_name_ = file_name;
+#if !defined(_WIN32) && !defined(_WIN64)
+  int fd = open(file_name.c_str(), O_RDONLY);
+  CHECK_FAIL_RETURN_UNEXPECTED(fd >= 0, "Failed to open graph store file: " + file_name);
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size == 0) {
+    (void)close(fd);
+    RETURN_STATUS_UNEXPECTED("Failed to get the size of graph store file: " + file_name);
+  }
+  void *addr = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+  (void)close(fd);
+  CHECK_FAIL_RETURN_UNEXPECTED(addr != MAP_FAILED, "Failed to map graph store file: " + file_name);
+  buf_ = static_cast<const uchar *>(addr);
+  buf_size_ = static_cast<size_t>(st.st_size);
+#else
+  std::ifstream in(file_name, std::ios::in | std::ios::binary | std::ios::ate);
+  CHECK_FAIL_RETURN_UNEXPECTED(in.is_open(), "Failed to open graph store file: " + file_name);
+  buf_size_ = static_cast<size_t>(in.tellg());
+  file_data_.resize((buf_size_ + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+  (void)in.seekg(0, std::ios::beg);
+  (void)in.read(reinterpret_cast<char *>(file_data_.data()), static_cast<std::streamsize>(buf_size_));
+  CHECK_FAIL_RETURN_UNEXPECTED(in.good(), "Failed to read graph store file: " + file_name);
+  buf_ = reinterpret_cast<const uchar *>(file_data_.data());
+#endif
+  Status rc = ParseFile();
+  if (rc.IsError()) {
+    Release();
+  }
+  return rc;
+}
+
+Status GraphStore::ParseFile() {
+  const std::string err_msg = "Invalid graph store file: " + file_name_;
+  constexpr size_t kHeaderSize = sizeof(kGraphStoreMagic) + 2 * sizeof(uint32_t);
+  CHECK_FAIL_RETURN_UNEXPECTED(buf_size_ >= kHeaderSize && memcmp(buf_, kGraphStoreMagic, sizeof(kGraphStoreMagic)) == 0,
+                               err_msg + ", the magic is wrong.");
+  StoreParser parser(buf_, buf_size_, sizeof(kGraphStoreMagic));
+  uint32_t version = 0;
+  uint32_t reserved = 0;
+  RETURN_IF_NOT_OK(parser.ReadValue(&version));
+  RETURN_IF_NOT_OK(parser.ReadValue(&reserved));
+  CHECK_FAIL_RETURN_UNEXPECTED(version == kGraphStoreVersion,
+                               err_msg + ", the version " + std::to_string(version) + " is not supported.");
+
+  RETURN_IF_NOT_OK(parser.ReadArray(&node_ids_));
+  RETURN_IF_NOT_OK(parser.ReadArray(&node_types_));
+  RETURN_IF_NOT_OK(parser.ReadArray(&sorted_node_ids_));
+  RETURN_IF_NOT_OK(parser.ReadArray(&sorted_node_index_));
+  RETURN_IF_NOT_OK(parser.ReadArray(&edge_ids_));
+  RETURN_IF_NOT_OK(parser.ReadArray(&edge_types_));
+  RETURN_IF_NOT_OK(parser.ReadArray(&edge_src_));
+  RETURN_IF_NOT_OK(parser.ReadArray(&edge_dst_));
+  RETURN_IF_NOT_OK(parser.ReadArray(&edge_weights_));
+  RETURN_IF_NOT_OK(parser.ReadArray(&sorted_edge_ids_));
+  RETURN_IF_NOT_OK(parser.ReadArray(&sorted_edge_index_));
+  size_t num_nodes = node_ids_.size();
+  size_t num_edges = edge_ids_.size();
+  CHECK_FAIL_RETURN_UNEXPECTED(node_types_.size() == num_nodes && sorted_node_ids_.size() == num_nodes &&
+                                 sorted_node_index_.size() == num_nodes && IndexInRange(sorted_node_index_, num_nodes),
+                               err_msg + ", the nodes are broken.");
+  CHECK_FAIL_RETURN_UNEXPECTED(edge_types_.size() == num_edges && edge_src_.size() == num_edges &&
+                                 edge_dst_.size() == num_edges && edge_weights_.size() == num_edges &&
+                                 sorted_edge_ids_.size() == num_edges && sorted_edge_index_.size() == num_edges &&
+                                 IndexInRange(edge_src_, num_nodes) && IndexInRange(edge_dst_, num_nodes) &&
+                                 IndexInRange(sorted_edge_index_, num_edges),
+                               err_msg + ", the edges are broken.");
+
+  uint64_t num_adjacency = 0;
+  RETURN_IF_NOT_OK(parser.ReadValue(&num_adjacency));
+  adjacency_.clear();
+  for (uint64_t i = 0; i < num_adjacency; ++i) {
+    int64_t type = 0;
+    RETURN_IF_NOT_OK(parser.ReadValue(&type));
+    Adjacency &adjacency = adjacency_[static_cast<NodeType>(type)];
+    RETURN_IF_NOT_OK(parser.ReadArray(&adjacency.offsets));
+    RETURN_IF_NOT_OK(parser.ReadArray(&adjacency.nodes));
+    RETURN_IF_NOT_OK(parser.ReadArray(&adjacency.edges));
+    const StoreArray<uint64_t> &offsets = adjacency.offsets;
+    bool valid = offsets.size() == num_nodes + 1 && offsets[0] == 0 && offsets[num_nodes] == adjacency.nodes.size() &&
+                 adjacency.edges.size() == adjacency.nodes.size() &&
+                 std::is_sorted(offsets.data(), offsets.data() + offsets.size()) &&
+                 IndexInRange(adjacency.nodes, num_nodes) && IndexInRange(adjacency.edges, num_edges);
+    CHECK_FAIL_RETURN_UNEXPECTED(valid, err_msg + ", the adjacency is broken.");
+  }
+
+  for (auto *columns : {&node_features_, &edge_features_}) {
+    size_t num_rows = columns == &node_features_ ? num_nodes : num_edges;
+    uint64_t num_columns = 0;
+    RETURN_IF_NOT_OK(parser.ReadValue(&num_columns));
+    columns->clear();
+    for (uint64_t i = 0; i < num_columns; ++i) {
+      int64_t feature_type = 0;
+      int64_t data_type = 0;
+      StoreArray<dsize_t> dims;
+      RETURN_IF_NOT_OK(parser.ReadValue(&feature_type));
+      RETURN_IF_NOT_OK(parser.ReadValue(&data_type));
+      RETURN_IF_NOT_OK(parser.ReadArray(&dims));
+      CHECK_FAIL_RETURN_UNEXPECTED(data_type > DataType::DE_UNKNOWN && data_type < DataType::DE_STRING,
+                                   err_msg + ", the feature type is broken.");
+      FeatureColumn &column = (*columns)[static_cast<FeatureType>(feature_type)];
+      column.type_ = DataType(static_cast<DataType::Type>(data_type));
+      column.dims_.assign(dims.data(), dims.data() + dims.size());
+      column.row_bytes_ = column.type_.SizeInBytes();
+      for (dsize_t dim : column.dims_) {
+        CHECK_FAIL_RETURN_UNEXPECTED(dim >= 0, err_msg + ", the feature shape is broken.");
+        column.row_bytes_ *= static_cast<size_t>(dim);
+      }
+      RETURN_IF_NOT_OK(parser.ReadArray(&column.data_));
+      RETURN_IF_NOT_OK(parser.ReadArray(&column.present_));
+      CHECK_FAIL_RETURN_UNEXPECTED(column.present_.size() == num_rows &&
+                                     column.data_.size() == num_rows * column.row_bytes_,
+                                   err_msg + ", the feature column is broken.");
+    }
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(parser.End(), err_msg + ", there is unknown data at the end of the file.");
+  return Status::OK();
+}
+}  // namespace gnn
+}  // namespace dataset
+}  // namespace luojianet_ms
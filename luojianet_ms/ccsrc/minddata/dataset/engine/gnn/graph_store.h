@@ -0,0 +1,237 @@
+/**
+ * Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+ * Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LUOJIANET_MS_CCSRC_MINDDATA_DATASET_ENGINE_GNN_GRAPH_STORE_H_
+#define LUOJIANET_MS_CCSRC_MINDDATA_DATASET_ENGINE_GNN_GRAPH_STORE_H_
+
+#include <limits>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "minddata/dataset/core/data_type.h"
+#include "minddata/dataset/core/tensor.h"
+#include "minddata/dataset/engine/gnn/edge.h"
+#include "minddata/dataset/engine/gnn/feature.h"
+#include "minddata/dataset/engine/gnn/node.h"
+#include "minddata/dataset/util/status.h"
+
+namespace luojianet_ms {
+namespace dataset {
+namespace gnn {
+
+// Position of a node or an edge in the store, nodes and edges keep the order they are loaded in.
+using StoreIndexType = uint32_t;
+constexpr StoreIndexType kInvalidStoreIndex = std::numeric_limits<StoreIndexType>::max();
+
+// Array which either owns its elements or views the elements in a mapped graph store file.
+template <typename T>
+class StoreArray {
+ public:
+  StoreArray() = default;
+  StoreArray(StoreArray &&other) noexcept { *this = std::move(other); }
+  StoreArray &operator=(StoreArray &&other) noexcept {
+    owned_ = std::move(other.owned_);
+    data_ = other.data_;
+    size_ = other.size_;
+    other.data_ = nullptr;
+    other.size_ = 0;
+    return *this;
+  }
+  StoreArray(const StoreArray &) = delete;
+  StoreArray &operator=(const StoreArray &) = delete;
+  ~StoreArray() = default;
+
+  void Assign(std::vector<T> &&values) {
+    owned_ = std::move(values);
+    data_ = owned_.data();
+    size_ = owned_.size();
+  }
+
+  void View(const T *data, size_t size) {
+    owned_.clear();
+    data_ = data;
+    size_ = size;
+  }
+
+  // Only available when the array owns its elements.
+  T *mutable_data() { return owned_.data(); }
+
+  const T *data() const { return data_; }
+  size_t size() const { return size_; }
+  const T &operator[](size_t i) const { return data_[i]; }
+
+ private:
+  std::vector<T> owned_;
+  const T *data_{nullptr};
+  size_t size_{0};
+};
+
+// Features of one type for all the nodes or all the edges, stored row by row in one block. A row is absent when the
+// node or the edge doesn't have the feature.
+class FeatureColumn {
+ public:
+  FeatureColumn() = default;
+  ~FeatureColumn() = default;
+
+  // @param std::shared_ptr<Tensor> &sample - a feature tensor giving the shape and type of every row
+  // @param size_t num_rows - number of nodes or edges
+  // @return Status The status code returned
+  Status Init(const std::shared_ptr<Tensor> &sample, size_t num_rows);
+
+  // Copy the feature into the row, fails when the shape or the type is different from the column
+  // @param StoreIndexType row - index of the node or the edge
+  // @param std::shared_ptr<Tensor> &value - feature value
+  // @return Status The status code returned
+  Status SetRow(StoreIndexType row, const std::shared_ptr<Tensor> &value);
+
+  bool HasRow(StoreIndexType row) const { return row < present_.size() && present_[row] != 0; }
+
+  const uchar *Row(StoreIndexType row) const { return data_.data() + row * row_bytes_; }
+
+  TensorShape shape() const { return TensorShape(dims_); }
+
+  const DataType &type() const { return type_; }
+
+  size_t row_bytes() const { return row_bytes_; }
+
+  size_t num_rows() const { return present_.size(); }
+
+ private:
+  friend class GraphStore;
+
+  std::vector<dsize_t> dims_;
+  DataType type_;
+  size_t row_bytes_{0};
+  StoreArray<uchar> data_;
+  StoreArray<uint8_t> present_;
+};
+
+// Compact storage of the graph. The adjacency is kept per neighbor node type in CSR form, that is the neighbors of the
+// node i are [offsets[i], offsets[i + 1]) of the neighbor arrays in the order the edges are loaded, and the features
+// are kept in columns. The store can be saved into a file and mapped back into memory without parsing.
+class GraphStore {
+ public:
+  // Neighbors of a node with one neighbor type, nodes[k] is reached through edges[k]
+  struct NeighborRange {
+    const StoreIndexType *nodes;
+    const StoreIndexType *edges;
+    size_t size;
+  };
+
+  GraphStore() = default;
+  ~GraphStore();
+  GraphStore(const GraphStore &) = delete;
+  GraphStore &operator=(const GraphStore &) = delete;
+
+  // Build the topology, the edge src and dst are node ids which must exist in node_ids
+  // @return Status The status code returned
+  Status Build(std::vector<NodeIdType> &&node_ids, std::vector<NodeType> &&node_types,
+               std::vector<EdgeIdType> &&edge_ids, std::vector<EdgeType> &&edge_types,
+               const std::vector<NodeIdType> &src_ids, const std::vector<NodeIdType> &dst_ids,
+               std::vector<WeightType> &&edge_weights);
+
+  // Save the store into file, it can be loaded by Load
+  // @param std::string &file_name - file to write
+  // @return Status The status code returned
+  Status Save(const std::string &file_name) const;
+
+  // Map the file written by Save into memory
+  // @param std::string &file_name - file to read
+  // @return Status The status code returned
+  Status Load(const std::string &file_name);
+
+  // Whether the file starts with the magic of graph store
+  static bool IsGraphStoreFile(const std::string &file_name);
+
+  size_t NumNodes() const { return node_ids_.size(); }
+  size_t NumEdges() const { return edge_ids_.size(); }
+
+  // @return StoreIndexType - index of the node, kInvalidStoreIndex if the node doesn't exist
+  StoreIndexType FindNode(NodeIdType id) const;
+  NodeIdType NodeId(StoreIndexType index) const { return node_ids_[index]; }
+  NodeType GetNodeType(StoreIndexType index) const { return node_types_[index]; }
+
+  // @return StoreIndexType - index of the edge, kInvalidStoreIndex if the edge doesn't exist
+  StoreIndexType FindEdge(EdgeIdType id) const;
+  EdgeIdType EdgeId(StoreIndexType index) const { return edge_ids_[index]; }
+  EdgeType GetEdgeType(StoreIndexType index) const { return edge_types_[index]; }
+  StoreIndexType EdgeSrc(StoreIndexType index) const { return edge_src_[index]; }
+  StoreIndexType EdgeDst(StoreIndexType index) const { return edge_dst_[index]; }
+  WeightType EdgeWeight(StoreIndexType index) const { return edge_weights_[index]; }
+
+  // Neighbors of the node whose type is neighbor_type, the range is empty if there is none
+  NeighborRange GetNeighbors(StoreIndexType node, NodeType neighbor_type) const;
+
+  // The first loaded edge from src to dst of any type
+  // @return StoreIndexType - index of the edge, kInvalidStoreIndex if the nodes are not adjacent
+  StoreIndexType FindEdgeByNodes(StoreIndexType src, StoreIndexType dst) const;
+
+  // Create an empty column, which replaces the existing column of the same type
+  FeatureColumn *AddNodeFeatureColumn(FeatureType type) { return &node_features_[type]; }
+  FeatureColumn *AddEdgeFeatureColumn(FeatureType type) { return &edge_features_[type]; }
+
+  // @return FeatureColumn* - nullptr if the feature is not stored in the column
+  const FeatureColumn *GetNodeFeatureColumn(FeatureType type) const;
+  const FeatureColumn *GetEdgeFeatureColumn(FeatureType type) const;
+
+  const std::map<FeatureType, FeatureColumn> &node_features() const { return node_features_; }
+  const std::map<FeatureType, FeatureColumn> &edge_features() const { return edge_features_; }
+
+  void ClearFeatureColumns() {
+    node_features_.clear();
+    edge_features_.clear();
+  }
+
+ private:
+  struct Adjacency {
+    StoreArray<uint64_t> offsets;
+    StoreArray<StoreIndexType> nodes;
+    StoreArray<StoreIndexType> edges;
+  };
+
+  Status ParseFile();
+  void Release();
+
+  StoreArray<NodeIdType> node_ids_;
+  StoreArray<NodeType> node_types_;
+  StoreArray<NodeIdType> sorted_node_ids_;
+  StoreArray<StoreIndexType> sorted_node_index_;
+
+  StoreArray<EdgeIdType> edge_ids_;
+  StoreArray<EdgeType> edge_types_;
+  StoreArray<StoreIndexType> edge_src_;
+  StoreArray<StoreIndexType> edge_dst_;
+  StoreArray<WeightType> edge_weights_;
+  StoreArray<EdgeIdType> sorted_edge_ids_;
+  StoreArray<StoreIndexType> sorted_edge_index_;
+
+  std::map<NodeType, Adjacency> adjacency_;
+  std::map<FeatureType, FeatureColumn> node_features_;
+  std::map<FeatureType, FeatureColumn> edge_features_;
+
+  // Memory of the loaded file
+  std::string file_name_;
+  const uchar *buf_{nullptr};
+  size_t buf_size_{0};
+  std::vector<uint64_t> file_data_;
+};
+}  // namespace gnn
+}  // namespace dataset
+}  // namespace luojianet_ms
+#endif  // LUOJIANET_MS_CCSRC_MINDDATA_DATASET_ENGINE_GNN_GRAPH_STORE_H_
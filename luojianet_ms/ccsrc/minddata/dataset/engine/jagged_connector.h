@@ -48,13 +48,13 @@ class JaggedConnector : public Connector<TensorRow> {
     {
       MS_ASSERT(worker_id < num_consumers_);
       std::unique_lock<std::mutex> lock(m_);
-      RETURN_IF_NOT_OK(cv_.Wait(&lock, [this, worker_id]() { return expect_consumer_ == worker_id; }));
+      RETURN_IF_NOT_OK(WaitForConsumer(&lock, worker_id));
       if (is_queue_finished_[pop_from_]) {
         std::string errMsg = "ERROR: popping from a finished queue in JaggedConnector";
         RETURN_STATUS_UNEXPECTED(errMsg);
       }
 
-      RETURN_IF_NOT_OK(queues_[pop_from_]->PopFront(result));
+      RETURN_IF_NOT_OK(PopFromQueue(result));
       if (result != nullptr && result->eoe()) {
         is_queue_finished_[pop_from_] = true;
       }
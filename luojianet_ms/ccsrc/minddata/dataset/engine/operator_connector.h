@@ -42,8 +42,26 @@ class OperatorConnector : public Queue<TensorRow> {
 
   Status PopFront(TensorRow *row) {
     out_rows_count_++;
-    return Queue::PopFront(row);
+    uint64_t blocked_us = pop_blocked_time();
+    RETURN_IF_NOT_OK(Queue::PopFront(row));
+    SpanRecorder::GetInstance().RecordBlocked(SpanCategory::kPopBlocked, "Pop", pop_blocked_time() - blocked_us);
+    return Status::OK();
   }
+
+  Status Add(const TensorRow &row) noexcept {
+    uint64_t blocked_us = push_blocked_time();
+    RETURN_IF_NOT_OK(Queue::Add(row));
+    SpanRecorder::GetInstance().RecordBlocked(SpanCategory::kPushBlocked, "Push", push_blocked_time() - blocked_us);
+    return Status::OK();
+  }
+
+  Status Add(TensorRow &&row) noexcept {
+    uint64_t blocked_us = push_blocked_time();
+    RETURN_IF_NOT_OK(Queue::Add(std::move(row)));
+    SpanRecorder::GetInstance().RecordBlocked(SpanCategory::kPushBlocked, "Push", push_blocked_time() - blocked_us);
+    return Status::OK();
+  }
+
   Status SendEOE() noexcept {
     TensorRow eoe = TensorRow(TensorRow::kFlagEOE);
     return Add(std::move(eoe));
@@ -17,14 +17,21 @@
 
 #include "minddata/dataset/engine/perf/auto_tune.h"
 
+#include <sys/stat.h>
 #include <algorithm>
+#include <cmath>
+#include <fstream>
 #include <functional>
 #include <memory>
+#include <string>
 #include <vector>
+#include <nlohmann/json.hpp>
 #ifndef ENABLE_ANDROID
 #include "minddata/dataset/engine/datasetops/source/nonmappable_leaf_op.h"
 #endif
 
+#include "utils/ms_utils.h"
+#include "minddata/dataset/util/path.h"
 #include "minddata/dataset/util/task_manager.h"
 
 namespace luojianet_ms {
@@ -33,6 +40,7 @@ AutoTune::AutoTune(TreeAdapter *tree_adap, ProfilingManager *profiling_mgr)
     : tree_adapter_(tree_adap),
       profiling_manager_(profiling_mgr),
       leaf_op_id_(-1),
+      counters_time_(0),
       cur_epoch_(1),
       skip_bool_(true),
       last_step_profiled_(0) {
@@ -72,6 +80,10 @@ Status AutoTune::Main() {
   MS_LOG(INFO) << "Dataset AutoTune thread is finished.";
   MS_LOG(INFO) << "Printing final tree configuration";
   PrintTreeConfiguration();
+  rc = SaveAutoTuneConfig();
+  if (rc.IsError()) {
+    MS_LOG(WARNING) << "Failed to save the tuned config of Dataset AutoTune: " << rc;
+  }
   MS_LOG(INFO) << "Suggest to set proper num_parallel_workers for each Operation or use global setting API: "
                << "luojianet_ms.dataset.config.set_num_parallel_workers";
   MS_LOG(INFO) << "Suggest to choose maximum prefetch_size from tuned result and set by global setting API: "
@@ -97,6 +109,11 @@ Status AutoTune::LaunchThread() {
     RETURN_IF_NOT_OK(profiling_manager_->Stop());
     return Status::OK();
   }
+  rc = LoadAutoTuneConfig();
+  if (rc.IsError()) {
+    MS_LOG(WARNING) << "Failed to load the tuned config of the previous run, Dataset AutoTune starts from the current "
+                    << "config: " << rc;
+  }
   RETURN_IF_NOT_OK(cv_.Register(tree_adapter_->AllTasks()->GetIntrpService()));
   RETURN_IF_NOT_OK(tree_adapter_->AllTasks()->CreateAsyncTask("AutoTune Thread", std::bind(&AutoTune::Main, this)));
   return Status::OK();
@@ -121,6 +138,81 @@ Status AutoTune::CollectOpsInfo() {
                                  "Non-sink pipeline, root node is a ParallelOp. Dataset AutoTune is not supported.");
   }
 
+  // the first read of the counters, the load is measured from now on
+  return UpdateOpsLoad();
+}
+
+Status AutoTune::SaveAutoTuneConfig() {
+  std::string file_path = GlobalContext::config_manager()->autotune_config_path();
+  if (file_path.empty()) {
+    return Status::OK();
+  }
+  nlohmann::json op_info = nlohmann::json::array();
+  for (const auto &op : ops_) {
+    if (op.second->inlined()) {
+      continue;
+    }
+    op_info.push_back({{"op_id", op.first},
+                       {"op_type", op.second->Name()},
+                       {"num_parallel_workers", op.second->NumWorkers()},
+                       {"prefetch_size", op.second->ConnectorCapacity()}});
+  }
+  nlohmann::json output;
+  output["remark"] = "The tuned config of the dataset pipeline by Dataset AutoTune.";
+  output["op_info"] = op_info;
+
+  // Discard the content of the file when opening.
+  std::ofstream os(file_path, std::ios::trunc);
+  CHECK_FAIL_RETURN_UNEXPECTED(os.is_open(), "Failed to open the AutoTune config file: " + file_path);
+  os << output.dump(2);
+  os.close();
+  if (chmod(common::SafeCStr(file_path), S_IRUSR | S_IWUSR) == -1) {
+    RETURN_STATUS_UNEXPECTED("Change file mode failed," + file_path);
+  }
+  MS_LOG(INFO) << "The tuned config of Dataset AutoTune is saved to " << file_path;
+  return Status::OK();
+}
+
+Status AutoTune::LoadAutoTuneConfig() {
+  std::string file_path = GlobalContext::config_manager()->autotune_config_path();
+  if (file_path.empty() || !Path(file_path).Exists()) {
+    return Status::OK();
+  }
+  // op_id -> (num_parallel_workers, prefetch_size)
+  std::map<int32_t, std::pair<int32_t, int32_t>> op_configs;
+  try {
+    std::ifstream in(file_path);
+    nlohmann::json js;
+    in >> js;
+    for (const auto &item : js.at("op_info")) {
+      auto op_id = item.at("op_id").get<int32_t>();
+      auto op_type = item.at("op_type").get<std::string>();
+      auto op = ops_.find(op_id);
+      if (op == ops_.end() || op->second->Name() != op_type || op->second->inlined()) {
+        MS_LOG(WARNING) << "The AutoTune config file: " << file_path << " was saved for a different pipeline, "
+                        << "it is ignored and will be overwritten.";
+        return Status::OK();
+      }
+      op_configs[op_id] = {item.at("num_parallel_workers").get<int32_t>(), item.at("prefetch_size").get<int32_t>()};
+    }
+  } catch (const std::exception &err) {
+    RETURN_STATUS_UNEXPECTED("Invalid file, failed to parse the AutoTune config file: " + file_path + ", " +
+                             err.what());
+  }
+
+  MS_LOG(INFO) << "Dataset AutoTune starts from the tuned config in " << file_path;
+  for (const auto &config : op_configs) {
+    int32_t op_id = config.first;
+    int32_t num_workers = ops_[op_id]->NumWorkers();
+    int32_t capacity = ops_[op_id]->ConnectorCapacity();
+    int32_t requested_workers = num_workers;
+    if (IsWorkerTunable(op_id) && config.second.first != num_workers) {
+      RETURN_IF_NOT_OK(RequestNumWorkerChange(op_id, num_workers, config.second.first, &requested_workers));
+    }
+    if (op_id != 0 && config.second.second != capacity) {
+      RETURN_IF_NOT_OK(RequestConnectorCapacityChange(op_id, capacity, config.second.second));
+    }
+  }
   return Status::OK();
 }
 
@@ -154,54 +246,70 @@ Status AutoTune::GetOpsCpuUtil(std::map<int32_t, double> *ops_cpu_util) {
   return Status::OK();
 }
 
-Status AutoTune::GetOpsQueueUtil(std::map<int32_t, double> *out_ops_queue_util,
-                                 std::map<int32_t, double> *in_ops_queue_util) {
-  // loop over all itr keys in the ops_ and get output_queue usage
-  for (auto itr = ops_.begin(); itr != ops_.end(); ++itr) {
-    if (itr->second->inlined()) {
-      (*out_ops_queue_util)[itr->first] = -1;
-      continue;
-    }
-    std::vector<int32_t> sizes;
-    if (mode_ == AutoTuneMode::kAutoTuneModeEpoch) {
-      RETURN_IF_NOT_OK(profiling_manager_->GetConnectorSizeByEpoch(itr->first, cur_epoch_, &sizes));
-    } else if (mode_ == AutoTuneMode::kAutoTuneModeStep) {
-      RETURN_IF_NOT_OK(
-        profiling_manager_->GetConnectorSizeByStep(itr->first, last_step_profiled_, cur_step_ - 1, &sizes));
-    }
-    double avg_size = Mean(sizes);
-    int64_t capacity = itr->second->ConnectorCapacity();
-    CHECK_FAIL_RETURN_UNEXPECTED(capacity != 0, "Capacity of connector should not be 0");
-    (*out_ops_queue_util)[itr->first] = avg_size / capacity;
-  }
-  for (auto itr = ops_.rbegin(); itr != ops_.rend(); ++itr) {
-    // assume that leaf op has 100% input queue util
-    if (itr->first + 1 == ops_.size()) {
-      (*in_ops_queue_util)[itr->first] = 1;
-      continue;
-    }
-    // input queue is the output queue of the child
-    (*in_ops_queue_util)[itr->first] = (*out_ops_queue_util)[itr->first + 1];
-    // if the child is an inlined op, use the prev known utilization
-    if ((*in_ops_queue_util)[itr->first] == -1) {
-      (*in_ops_queue_util)[itr->first] = (*in_ops_queue_util)[itr->first + 1];
-    }
+Status AutoTune::GetOpComputeTime(int32_t op_id, uint64_t *compute_time) {
+  if (mode_ == AutoTuneMode::kAutoTuneModeEpoch) {
+    RETURN_IF_NOT_OK(profiling_manager_->GetOpSpanTimeByEpoch(op_id, SpanCategory::kCompute, cur_epoch_, compute_time));
+  } else if (mode_ == AutoTuneMode::kAutoTuneModeStep) {
+    RETURN_IF_NOT_OK(profiling_manager_->GetOpSpanTimeByStep(op_id, SpanCategory::kCompute, last_step_profiled_,
+                                                             cur_step_ - 1, compute_time));
   }
+  return Status::OK();
+}
 
+Status AutoTune::UpdateOpsLoad() {
+  auto Diff = [](uint64_t end, uint64_t start) { return static_cast<double>(end > start ? end - start : 0); };
+  uint64_t now = SpanRecorder::NowUs();
+  double elapsed = Diff(now, counters_time_);
+  bool first_read = (counters_time_ == 0);
+  counters_time_ = now;
+  ops_load_.clear();
   for (const auto &op : ops_) {
-    if (op.second->inlined()) {
-      (*in_ops_queue_util)[op.first] = -1;
+    OpCounters counters;
+    counters.worker_blocked_time = op.second->WorkerBlockedTime();
+    counters.push_blocked_time = op.second->ConnectorPushBlockedTime();
+    counters.pop_blocked_time = op.second->ConnectorPopBlockedTime();
+    counters.num_workers = op.second->NumWorkers();
+    OpCounters last = ops_counters_[op.first];
+    ops_counters_[op.first] = counters;
+    if (first_read || elapsed <= 0) {
+      continue;
+    }
+    OpLoad load;
+    // the number of workers may have been changed in the iteration
+    double num_workers = (last.num_workers + counters.num_workers) / 2.0;
+    if (num_workers > 0) {
+      double blocked_workers = Diff(counters.worker_blocked_time, last.worker_blocked_time) / elapsed;
+      uint64_t compute_time = 0;
+      RETURN_IF_NOT_OK(GetOpComputeTime(op.first, &compute_time));
+      // the time on TensorOps is a lower bound in case the queues of the workers are not the only place to block
+      load.busy_workers = std::max(num_workers - blocked_workers, static_cast<double>(compute_time) / elapsed);
+      load.busy_workers = std::min(std::max(load.busy_workers, 0.0), num_workers);
     }
+    load.push_blocked = std::min(Diff(counters.push_blocked_time, last.push_blocked_time) / elapsed, 1.0);
+    load.pop_blocked = std::min(Diff(counters.pop_blocked_time, last.pop_blocked_time) / elapsed, 1.0);
+    ops_load_[op.first] = load;
   }
-
   return Status::OK();
 }
 
-Status AutoTune::GetOpsNumWorker(std::map<int32_t, int32_t> *ops_num_workers) {
-  for (const auto &op : ops_) {
-    (*ops_num_workers)[op.first] = op.second->NumWorkers();
+bool AutoTune::IsWorkerTunable(int32_t op_id) {
+  if (std::find(parallel_ops_ids_.begin(), parallel_ops_ids_.end(), op_id) == parallel_ops_ids_.end()) {
+    return false;
   }
-  return Status::OK();
+  // MindRecordOp and NonMappableDataset is not supported in AutoTune
+  if (ops_[op_id]->Name() == "MindRecordOp") {
+    return false;
+  }
+  // Skip python op
+  if (ops_[op_id]->Name() == "GeneratorOp" || ops_[op_id]->IsPython()) {
+    return false;
+  }
+#ifndef ENABLE_ANDROID
+  if (std::dynamic_pointer_cast<NonMappableLeafOp>(ops_[op_id]) != nullptr) {
+    return false;
+  }
+#endif
+  return true;
 }
 
 bool AutoTune::IsSink() {
@@ -250,7 +358,9 @@ Status AutoTune::RunIterationStep() {
     if (skip_bool_) {
       skip_bool_ = false;
       last_step_profiled_ = cur_step_;
-      return Status::OK();
+      // measure the load from the end of the warmup steps
+      counters_time_ = 0;
+      return UpdateOpsLoad();
     }
     MS_LOG(INFO) << "Run AutoTune at step#" << cur_step_;
     RETURN_IF_NOT_OK(RunIteration());
@@ -275,6 +385,7 @@ Status AutoTune::RecordPipelineTime() {
 
 Status AutoTune::RunIteration() {
   RETURN_IF_NOT_OK(RecordPipelineTime());
+  RETURN_IF_NOT_OK(UpdateOpsLoad());
   bool isBottleneck = false;
   RETURN_IF_NOT_OK(IsDSaBottleneck(&isBottleneck));
   if (isBottleneck) {
@@ -341,8 +452,8 @@ Status AutoTune::IsDSaBottleneck(bool *isBottleneck) {
   return Status::OK();
 }
 
-Status AutoTune::RequestNumWorkerChange(int32_t op_id, int32_t old_workers, int32_t *num_workers_requested) {
-  int32_t new_workers = old_workers + INCREMENT_WORKER;
+Status AutoTune::RequestNumWorkerChange(int32_t op_id, int32_t old_workers, int32_t new_workers,
+                                        int32_t *num_workers_requested) {
   new_workers = std::min(new_workers, max_workers_);
   new_workers = std::max(new_workers, MIN_NUM_WORKERS);
   RETURN_IF_NOT_OK(tree_modifier_->AddChangeRequest(op_id, std::make_shared<ChangeNumWorkersRequest>(new_workers)));
@@ -363,75 +474,129 @@ Status AutoTune::RequestConnectorCapacityChange(int32_t op_id, int32_t old_size,
 }
 
 Status AutoTune::Analyse() {
-  // collect stats
-  std::map<int32_t, int32_t> ops_num_workers;
-  RETURN_IF_NOT_OK(GetOpsNumWorker(&ops_num_workers));
-  std::map<int32_t, double> out_ops_queue_util;
-  std::map<int32_t, double> in_ops_queue_util;
-  RETURN_IF_NOT_OK(GetOpsQueueUtil(&out_ops_queue_util, &in_ops_queue_util));
-
+  if (ops_load_.empty()) {
+    MS_LOG(INFO) << "The load of the operators is not measured yet, skip this iteration.";
+    return Status::OK();
+  }
   std::map<int32_t, double> ops_cpu_util;
   RETURN_IF_NOT_OK(GetOpsCpuUtil(&ops_cpu_util));
+  std::map<int32_t, int32_t> ops_num_workers;
+  RETURN_IF_NOT_OK(AllocateWorkers(ops_cpu_util, &ops_num_workers));
+  return AllocateConnectors(ops_num_workers);
+}
 
-  // check parallel ops in loop
-  for (const auto &op_id : parallel_ops_ids_) {
-    // MindRecordOp and NonMappableDataset is not supported in AutoTune
-    if (ops_[op_id]->Name() == "MindRecordOp") {
+Status AutoTune::AllocateWorkers(const std::map<int32_t, double> &ops_cpu_util,
+                                 std::map<int32_t, int32_t> *ops_num_workers) {
+  // the load of an op in a balanced pipeline is in proportion to the time it takes to process a row, so are the
+  // workers it needs. The CPU cost of a worker is the share of its busy time on CPU.
+  double reserved_cpu = 0;
+  double total_cpu_demand = 0;
+  std::vector<int32_t> tunable_ops;
+  for (const auto &op : ops_) {
+    (*ops_num_workers)[op.first] = op.second->NumWorkers();
+    auto cpu_itr = ops_cpu_util.find(op.first);
+    double cpu = cpu_itr == ops_cpu_util.end() ? 0 : cpu_itr->second / TO_PERCENT;
+    if (!IsWorkerTunable(op.first)) {
+      reserved_cpu += cpu;
       continue;
     }
-    // Skip python op
-    if (ops_[op_id]->Name() == "GeneratorOp") {
+    OpLoad &load = ops_load_[op.first];
+    // the op is assumed CPU bound if its CPU utilization is not sampled
+    if (cpu > 0 && load.busy_workers > 0) {
+      load.cpu_ratio = std::min(std::max(cpu / load.busy_workers, static_cast<double>(MIN_CPU_RATIO)), 1.0);
+    }
+    total_cpu_demand += load.busy_workers * load.cpu_ratio;
+    tunable_ops.push_back(op.first);
+  }
+  if (tunable_ops.empty() || total_cpu_demand <= 0) {
+    return Status::OK();
+  }
+  double cpu_budget =
+    std::max(static_cast<double>(max_workers_) - reserved_cpu, static_cast<double>(tunable_ops.size()));
+  double scale = cpu_budget / total_cpu_demand;
+  MS_LOG(INFO) << "CPU budget of the tunable operators: " << cpu_budget << ", demand: " << total_cpu_demand;
+
+  for (const auto &op_id : tunable_ops) {
+    const OpLoad &load = ops_load_[op_id];
+    int32_t num_workers = (*ops_num_workers)[op_id];
+    CHECK_FAIL_RETURN_UNEXPECTED(num_workers != 0, "ParallelOp with num_workers=0");
+    double target = load.busy_workers * scale;
+    MS_LOG(DEBUG) << "Op (" << ops_[op_id]->NameWithID() << ") busy workers=" << load.busy_workers
+                  << ", cpu ratio=" << load.cpu_ratio << ", target workers=" << target;
+    if (std::abs(target - num_workers) < std::max(1.0, static_cast<double>(WORKER_CHANGE_THRESHOLD * num_workers))) {
       continue;
     }
-    if (ops_[op_id]->IsPython()) {
+    int32_t new_workers;
+    if (target > num_workers) {
+      // a bottleneck grows fast, so that the pipeline converges in a few iterations
+      new_workers = std::min(static_cast<int32_t>(std::round(target)), MAX_WORKER_GROWTH * num_workers + 1);
+      MS_LOG(WARNING) << "Op (" << ops_[op_id]->NameWithID() << ") is a bottleneck, " << load.busy_workers
+                      << " out of " << num_workers << " workers are busy.";
+    } else {
+      // shrink halfway only, in case the load of the iteration was lower than usual
+      new_workers = static_cast<int32_t>(std::ceil((num_workers + target) / 2));
+      MS_LOG(WARNING) << "Op (" << ops_[op_id]->NameWithID() << ") has idle workers, " << load.busy_workers
+                      << " out of " << num_workers << " workers are busy.";
+    }
+    if (new_workers != num_workers) {
+      RETURN_IF_NOT_OK(RequestNumWorkerChange(op_id, num_workers, new_workers, &(*ops_num_workers)[op_id]));
+    }
+  }
+  return Status::OK();
+}
+
+Status AutoTune::AllocateConnectors(const std::map<int32_t, int32_t> &ops_num_workers) {
+  int64_t total_capacity = 0;
+  // op_id -> (old capacity, new capacity)
+  std::map<int32_t, std::pair<int64_t, int64_t>> changes;
+  std::vector<int32_t> growing_ops;
+  for (const auto &op : ops_) {
+    if (op.second->inlined()) {
       continue;
     }
-#ifndef ENABLE_ANDROID
-    if (std::dynamic_pointer_cast<NonMappableLeafOp>(ops_[op_id]) != nullptr) {
+    int64_t capacity = op.second->ConnectorCapacity();
+    total_capacity += capacity;
+    // the output connector of the root is not consumed by any op
+    if (op.first == 0) {
       continue;
     }
-#endif
-
-    // op specifics
-    double output_queue_util = out_ops_queue_util[op_id];
-    double input_queue_util = in_ops_queue_util[op_id];
-
-    double cpu_util = ops_cpu_util[op_id];
-    int32_t num_workers = ops_num_workers[op_id];
-    CHECK_FAIL_RETURN_UNEXPECTED(num_workers != 0, "ParallelOp with num_workers=0");
-    // derived metrics
-    double queue_diff = input_queue_util - output_queue_util;
-    int64_t queue_capacity;
-    RETURN_IF_NOT_OK(GetOpConnectorCapacity(op_id, &queue_capacity));
-    int64_t new_queue_capacity = queue_capacity;
-
-    int32_t requested_workers = 0;
-
-    MS_LOG(DEBUG) << "Op (" << ops_[op_id]->NameWithID() << ") CPU=" << cpu_util / num_workers
-                  << ", in=" << input_queue_util << "out=" << output_queue_util;
-    // map decisions - queue
-    if (queue_diff > INPUT_OUTPUT_QUEUE_DIFF_THRESHOLD) {
-      MS_LOG(WARNING) << "Op (" << ops_[op_id]->NameWithID()
-                      << ") is slow, input connector utilization=" << input_queue_util
-                      << ", output connector utilization=" << output_queue_util << ", diff= " << queue_diff << " > "
-                      << INPUT_OUTPUT_QUEUE_DIFF_THRESHOLD << " threshold.";
-      RETURN_IF_NOT_OK(RequestNumWorkerChange(op_id, num_workers, &requested_workers));
-    } else if ((cpu_util / num_workers) > MAP_OP_WORKER_HIGH_THRESHOLD) {
-      MS_LOG(WARNING) << "Op (" << ops_[op_id]->NameWithID() << ") getting high average worker cpu utilization "
-                      << (cpu_util / num_workers) << "% > " << MAP_OP_WORKER_HIGH_THRESHOLD << "% threshold.";
-      RETURN_IF_NOT_OK(RequestNumWorkerChange(op_id, num_workers, &requested_workers));
+    const OpLoad &load = ops_load_[op.first];
+    // every worker should be able to put its row into the connector
+    int64_t new_capacity = std::max(static_cast<int64_t>(ops_num_workers.at(op.first)), capacity);
+    if (load.push_blocked > CONNECTOR_BLOCKED_HIGH_THRESHOLD && load.pop_blocked > CONNECTOR_BLOCKED_HIGH_THRESHOLD) {
+      // both sides wait for each other in turn, the rows come in bursts that a larger connector can absorb
+      growing_ops.push_back(op.first);
+    } else if (load.push_blocked > CONNECTOR_BLOCKED_HIGH_THRESHOLD &&
+               load.pop_blocked < CONNECTOR_BLOCKED_LOW_THRESHOLD) {
+      // the connector is always full and the consumer never waits for it, the prefetched rows only take memory
+      new_capacity = std::max(capacity - INCREMENT_QUEUE_SIZE, static_cast<int64_t>(ops_num_workers.at(op.first)));
     }
-    if ((cpu_util / num_workers) < MAP_OP_WORKER_LOW_THRESHOLD &&
-        ((input_queue_util < INPUT_QUEUE_LOW) || (-1 * queue_diff > INPUT_OUTPUT_QUEUE_DIFF_THRESHOLD))) {
-      MS_LOG(WARNING) << "Op (" << ops_[op_id]->NameWithID() << ") getting low average worker cpu utilization "
-                      << (cpu_util / num_workers) << "% < " << MAP_OP_WORKER_LOW_THRESHOLD << "% threshold.";
-      new_queue_capacity = queue_capacity + INCREMENT_QUEUE_SIZE;
+    new_capacity = std::min(std::max(new_capacity, static_cast<int64_t>(MIN_QUEUE_SIZE)),
+                            static_cast<int64_t>(MAX_QUEUE_SIZE));
+    changes[op.first] = {capacity, new_capacity};
+    total_capacity += new_capacity - capacity;
+  }
+  // the memory freed by shrinking goes to the most starved consumers first
+  std::sort(growing_ops.begin(), growing_ops.end(),
+            [this](int32_t a, int32_t b) { return ops_load_[a].pop_blocked > ops_load_[b].pop_blocked; });
+  for (const auto &op_id : growing_ops) {
+    auto &change = changes[op_id];
+    int64_t increment = std::min({INCREMENT_QUEUE_SIZE, MAX_QUEUE_SIZE - change.second,
+                                  MAX_TOTAL_QUEUE_SIZE - total_capacity});
+    if (increment > 0) {
+      change.second += increment;
+      total_capacity += increment;
     }
-    if (requested_workers == 0) {
-      requested_workers = num_workers;
+  }
+  for (const auto &change : changes) {
+    int64_t old_capacity = change.second.first;
+    int64_t new_capacity = change.second.second;
+    if (new_capacity != old_capacity) {
+      MS_LOG(DEBUG) << "Op (" << ops_[change.first]->NameWithID()
+                    << ") push blocked=" << ops_load_[change.first].push_blocked
+                    << ", pop blocked=" << ops_load_[change.first].pop_blocked;
+      RETURN_IF_NOT_OK(RequestConnectorCapacityChange(change.first, old_capacity, new_capacity));
     }
-    new_queue_capacity = std::max(new_queue_capacity, static_cast<int64_t>(requested_workers));
-    RETURN_IF_NOT_OK(RequestConnectorCapacityChange(op_id, queue_capacity, new_queue_capacity));
   }
   return Status::OK();
 }
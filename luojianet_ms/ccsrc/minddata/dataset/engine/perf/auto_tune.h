@@ -21,6 +21,7 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <string>
 #include <vector>
 #include "minddata/dataset/util/status.h"
 #include "minddata/dataset/util/log_adapter.h"
@@ -53,6 +54,14 @@ class AutoTune {
   /// \brief Helper to print the tree configuration
   void PrintTreeConfiguration();
 
+  /// Save the tuned config of the ops to the json file set by the user
+  /// \return Status object
+  Status SaveAutoTuneConfig();
+
+  /// Start from the tuned config of the previous run, if it was saved for the same pipeline
+  /// \return Status object
+  Status LoadAutoTuneConfig();
+
   /// Function to collect info from the tree
   /// \return Status code
   Status CollectOpsInfo();
@@ -96,21 +105,41 @@ class AutoTune {
   const int32_t MIN_NUM_WORKERS = 1;
   const int32_t MAX_QUEUE_SIZE = 128;
   const int32_t MIN_QUEUE_SIZE = 1;
+  // total capacity in rows of all the connectors, the memory budget of prefetching
+  const int32_t MAX_TOTAL_QUEUE_SIZE = 512;
   // Worker specifics
-  const int32_t INCREMENT_WORKER = 2;
-  const int32_t DECREMENT_WORKER = -1;
+  // a worker count moves to the target at most this many times of the current value in an iteration
+  const int32_t MAX_WORKER_GROWTH = 2;
+  // the worker count is not changed if the target is within this share of the current value
+  const float_t WORKER_CHANGE_THRESHOLD = 0.2;
+  // lower bound of the share of the busy time of a worker on CPU, the rest is waiting for I/O
+  const float_t MIN_CPU_RATIO = 0.1;
   // Queue Specifics
-  const float_t INPUT_QUEUE_LOW = 0.5;
   const float_t DEVICE_CONNECTOR_UTIL_THRESHOLD = 0.75;
-  const float_t LEAF_QUEUE_THRESHOLD = 0.9;
-  const float_t INPUT_OUTPUT_QUEUE_DIFF_THRESHOLD = 0.35;
   const int64_t INCREMENT_QUEUE_SIZE = 4;
-  // CPU Specifics
-  const float_t MAP_OP_WORKER_HIGH_THRESHOLD = 75;
-  const float_t MAP_OP_WORKER_LOW_THRESHOLD = 35;
+  // share of the time blocked on a connector above which the blocking side is considered waiting on the other side
+  const float_t CONNECTOR_BLOCKED_HIGH_THRESHOLD = 0.1;
+  // share of the time blocked on a connector below which the blocking side is considered never waiting
+  const float_t CONNECTOR_BLOCKED_LOW_THRESHOLD = 0.01;
   // Running mode specifics
   enum AutoTuneMode { kAutoTuneModeEpoch, kAutoTuneModeStep };
 
+  /// Counters of an operator, the load in an iteration is the difference between the two ends of it
+  struct OpCounters {
+    uint64_t worker_blocked_time = 0;  // time in microseconds all the workers were blocked on their queues
+    uint64_t push_blocked_time = 0;    // time in microseconds blocked on pushing to the output connector
+    uint64_t pop_blocked_time = 0;     // time in microseconds blocked on popping from the output connector
+    int32_t num_workers = 0;
+  };
+
+  /// Load of an operator in the last iteration
+  struct OpLoad {
+    double busy_workers = 0;  // average number of workers not blocked on their queues
+    double cpu_ratio = 1;     // share of the busy time of the workers on CPU, the rest is waiting for I/O
+    double push_blocked = 0;  // share of the time the producer of the output connector was blocked
+    double pop_blocked = 0;   // share of the time the consumer of the output connector was blocked
+  };
+
   /// Get the out connector capacity of the operator
   /// \param[in] op_id operator id
   /// \param[out] capacity the capacity of the connector
@@ -122,28 +151,45 @@ class AutoTune {
   /// \return Status code
   Status GetOpsCpuUtil(std::map<int32_t, double> *ops_cpu_util);
 
-  /// Get the queue utilization of each operator in the pipeline
-  /// \param[out] ops_queue_util map from op_id to output queue utilization
-  /// \param[out] ops_queue_util map from op_id to input queue utilization
-  /// \note inline ops would report -1 in both input and output queue utilization
+  /// Get the time the workers of the operator spent on running TensorOps in the current iteration
+  /// \param[in] op_id operator id
+  /// \param[out] compute_time time in microseconds
   /// \return Status code
-  Status GetOpsQueueUtil(std::map<int32_t, double> *out_ops_queue_util, std::map<int32_t, double> *in_ops_queue_util);
+  Status GetOpComputeTime(int32_t op_id, uint64_t *compute_time);
 
-  /// Get the number of workers for each operator in the pipeline
-  /// \param[out] ops_num_workers map from op_id to num_workers
+  /// Read the counters of the operators, and update the load of them since the counters were last read
   /// \return Status code
-  Status GetOpsNumWorker(std::map<int32_t, int32_t> *ops_num_workers);
+  Status UpdateOpsLoad();
+
+  /// Check if the number of workers of the operator can be changed by AutoTune
+  /// \param op_id operator ID
+  /// \return bool
+  bool IsWorkerTunable(int32_t op_id);
 
   /// Main AutoTune algorithm
   /// \return Status code
   Status Analyse();
 
+  /// Share the CPU budget among the tunable operators in proportion to their load, so that none of them is the
+  /// bottleneck. Workers waiting for I/O cost less CPU, so I/O bound operators get more workers for the budget.
+  /// \param ops_cpu_util map from op_id to cpu utilization
+  /// \param[out] ops_num_workers map from op_id to the number of workers after the change
+  /// \return Status code
+  Status AllocateWorkers(const std::map<int32_t, double> &ops_cpu_util, std::map<int32_t, int32_t> *ops_num_workers);
+
+  /// Size the connectors by the time their two sides were blocked, within the memory budget of prefetching
+  /// \param ops_num_workers map from op_id to the number of workers
+  /// \return Status code
+  Status AllocateConnectors(const std::map<int32_t, int32_t> &ops_num_workers);
+
   /// Send a ChangeRequest to the operator to update the number of workers
   /// \param op_id operator ID
   /// \param old_workers Old number of workers for logging purposes
-  /// \param new_workers new number of worker
+  /// \param new_workers new number of workers
+  /// \param[out] num_workers_requested the number of workers requested after clamping
   /// \return Status code
-  Status RequestNumWorkerChange(int32_t op_id, int32_t old_workers, int32_t *num_workers_requested);
+  Status RequestNumWorkerChange(int32_t op_id, int32_t old_workers, int32_t new_workers,
+                                int32_t *num_workers_requested);
 
   /// Send a ChangeRequest to the operator to update the connector capacity
   /// \param op_id operator ID
@@ -181,6 +227,12 @@ class AutoTune {
   std::vector<int32_t> parallel_ops_ids_;
   /// ID of the leaf op
   int32_t leaf_op_id_;
+  /// counters of the operators when they were last read
+  std::map<int32_t, OpCounters> ops_counters_;
+  /// time in microseconds when the counters were last read
+  uint64_t counters_time_;
+  /// load of the operators in the last iteration
+  std::map<int32_t, OpLoad> ops_load_;
   /// vector of pipeline time per epoch
   std::vector<double> avg_pipeline_times_;
 
@@ -39,9 +39,19 @@ Status ConnectorSize::Sample() {
   // Tree Iterator is in PostOrder (leaf first, e.g., 3,2,1)
   // reverse the order of the vector to get the root first.
   std::reverse(cur_row.begin(), cur_row.end());
+  // The blocked time is accumulated by the connectors, so only the latest one is kept
+  std::vector<uint64_t> push_blocked_time, pop_blocked_time;
+  for (auto &op : *tree_) {
+    push_blocked_time.push_back(op.ConnectorPushBlockedTime());
+    pop_blocked_time.push_back(op.ConnectorPopBlockedTime());
+  }
+  std::reverse(push_blocked_time.begin(), push_blocked_time.end());
+  std::reverse(pop_blocked_time.begin(), pop_blocked_time.end());
   std::lock_guard<std::mutex> guard(lock_);
   // Push new row of sample
   sample_table_.push_back(cur_row);
+  push_blocked_time_ = std::move(push_blocked_time);
+  pop_blocked_time_ = std::move(pop_blocked_time);
   (void)ts_.emplace_back(ProfilingTime::GetCurMilliSecond());
   return Status::OK();
 }
@@ -91,6 +101,10 @@ Status ConnectorSize::SaveToFile(const std::string &dir_path, const std::string
     auto &ops_data = output["op_info"];
     if (ops_data[idx]["metrics"].contains("output_queue") && ops_data[idx]["op_type"] != "DeviceQueueOp") {
       ops_data[idx]["metrics"]["output_queue"]["size"] = cur_queue_size;
+      if (idx < push_blocked_time_.size()) {
+        ops_data[idx]["metrics"]["output_queue"]["push_blocked_time"] = push_blocked_time_[idx];
+        ops_data[idx]["metrics"]["output_queue"]["pop_blocked_time"] = pop_blocked_time_[idx];
+      }
     }
   }
 
@@ -117,6 +131,8 @@ Status ConnectorSize::Init() {
 void ConnectorSize::Clear() {
   ts_.clear();
   sample_table_.clear();
+  push_blocked_time_.clear();
+  pop_blocked_time_.clear();
   initial_nodes_data.clear();
 }
 
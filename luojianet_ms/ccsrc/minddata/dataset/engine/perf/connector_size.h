@@ -74,9 +74,11 @@ class ConnectorSize : public Sampling {
 
  private:
   json initial_nodes_data;  // store data when execution tree is running. (all information for ops except sampled data)
-  ExecutionTree *tree_ = nullptr;          // ExecutionTree pointer
-  ConnectorSizeSampleTable sample_table_;  // Dataset structure to store all samples of connector size sampling
-  Timestamps ts_;                          // time of sample
+  ExecutionTree *tree_ = nullptr;            // ExecutionTree pointer
+  ConnectorSizeSampleTable sample_table_;    // Dataset structure to store all samples of connector size sampling
+  Timestamps ts_;                            // time of sample
+  std::vector<uint64_t> push_blocked_time_;  // time in microseconds blocked on pushing to the output connector
+  std::vector<uint64_t> pop_blocked_time_;   // time in microseconds blocked on popping from the output connector
   Path GetFileName(const std::string &dir_path, const std::string &rank_id) override;
 };
 
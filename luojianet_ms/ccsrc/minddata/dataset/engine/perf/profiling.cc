@@ -28,6 +28,7 @@
 #include "minddata/dataset/engine/perf/monitor.h"
 #include "minddata/dataset/engine/perf/connector_size.h"
 #include "minddata/dataset/engine/perf/cpu_sampler.h"
+#include "minddata/dataset/engine/perf/span_tracing.h"
 #include "minddata/dataset/engine/execution_tree.h"
 #include "minddata/dataset/engine/tree_adapter.h"
 #include "minddata/dataset/util/log_adapter.h"
@@ -247,6 +248,8 @@ Status ProfilingManager::RegisterTree(TreeAdapter *tree_adapter) {
   // Tracing node registration is the responsibility of the Consumer
   std::shared_ptr<Sampling> connector_size_sampling = std::make_shared<ConnectorSize>(tree_);
   RETURN_IF_NOT_OK(RegisterSamplingNode(connector_size_sampling));
+  std::shared_ptr<Sampling> span_tracing = std::make_shared<SpanTracing>(tree_);
+  RETURN_IF_NOT_OK(RegisterSamplingNode(span_tracing));
 
 #ifndef ENABLE_ANDROID
   std::shared_ptr<Sampling> cpu_sampler = std::make_shared<CpuSampler>(tree_);
@@ -497,6 +500,28 @@ Status ProfilingManager::GetConnectorSizeByTime(int32_t op_id, uint64_t start_ts
   return connector_node->GetOpConnectorSize(op_id, start_ts, end_ts, result);
 }
 
+Status ProfilingManager::GetOpSpanTimeByEpoch(int32_t op_id, SpanCategory category, int32_t epoch_num,
+                                              uint64_t *result) {
+  uint64_t start_ts = 0, end_ts = 0;
+  RETURN_IF_NOT_OK(EpochToTimeInterval(epoch_num, &start_ts, &end_ts));
+  return GetOpSpanTimeByTime(op_id, category, start_ts, end_ts, result);
+}
+
+Status ProfilingManager::GetOpSpanTimeByStep(int32_t op_id, SpanCategory category, int32_t start_step,
+                                             int32_t end_step, uint64_t *result) {
+  uint64_t start_ts = 0, end_ts = 0;
+  RETURN_IF_NOT_OK(StepToTimeInterval(start_step, end_step, &start_ts, &end_ts));
+  return GetOpSpanTimeByTime(op_id, category, start_ts, end_ts, result);
+}
+
+Status ProfilingManager::GetOpSpanTimeByTime(int32_t op_id, SpanCategory category, uint64_t start_ts,
+                                             uint64_t end_ts, uint64_t *result) {
+  std::shared_ptr<Sampling> node;
+  RETURN_IF_NOT_OK(GetSamplingNode(kSpanTracingName, &node));
+  auto span_node = std::dynamic_pointer_cast<SpanTracing>(node);
+  return span_node->GetOpSpanTime(op_id, category, start_ts, end_ts, result);
+}
+
 Status ProfilingManager::GetPipelineTimeByEpoch(int32_t epoch_num, std::vector<int32_t> *result) {
   uint32_t start_step = 0, end_step = 0;
   RETURN_IF_NOT_OK(EpochToStepInterval(epoch_num, &start_step, &end_step));
@@ -28,6 +28,7 @@
 #include "minddata/dataset/util/path.h"
 #include "minddata/dataset/util/status.h"
 #include "minddata/dataset/engine/perf/monitor.h"
+#include "minddata/dataset/engine/perf/span_recorder.h"
 
 namespace luojianet_ms {
 namespace dataset {
@@ -42,6 +43,7 @@ const char kDeviceQueueTracingName[] = "Device_Queue_Tracing";
 const char kDatasetIteratorTracingName[] = "Dataset_Iterator_Tracing";
 const char kConnectorSizeSamplingName[] = "Connector_Size_Sampling";
 const char kCpuSamplerName[] = "Cpu_Sampler";
+const char kSpanTracingName[] = "Span_Tracing";
 
 // Profiling is a class of basic unit of profiling action
 // This base class encapsulate the serialization output logic
@@ -64,10 +66,10 @@ class Profiling : std::enable_shared_from_this<Profiling> {
   virtual Status ChangeFileMode(const std::string &dir_path, const std::string &rank_id) = 0;
 
   // Start collecting data
-  Status Start();
+  virtual Status Start();
 
   // Stop collecting data
-  Status Stop();
+  virtual Status Stop();
 
   // Clear all collected data
   virtual void Clear() = 0;
@@ -299,6 +301,34 @@ class ProfilingManager {
   /// \return Status object with the error code
   Status GetConnectorSizeByTime(int32_t op_id, uint64_t start_ts, uint64_t end_ts, std::vector<int32_t> *result);
 
+  /// \brief API to get the time an MD operator spent in a category of spans
+  /// \param [in] op_id The id of the operator
+  /// \param [in] category The category of the spans
+  /// \param [in] epoch_num The epoch number for which results are requested
+  /// \param [out] result The time in microseconds
+  /// \return Status object with the error code
+  Status GetOpSpanTimeByEpoch(int32_t op_id, SpanCategory category, int32_t epoch_num, uint64_t *result);
+
+  /// \brief API to get the time an MD operator spent in a category of spans
+  /// \param [in] op_id The id of the operator
+  /// \param [in] category The category of the spans
+  /// \param [in] start_step The step interval start range
+  /// \param [in] end_step The step interval end range
+  /// \param [out] result The time in microseconds
+  /// \return Status object with the error code
+  Status GetOpSpanTimeByStep(int32_t op_id, SpanCategory category, int32_t start_step, int32_t end_step,
+                             uint64_t *result);
+
+  /// \brief API to get the time an MD operator spent in a category of spans
+  /// \param [in] op_id The id of the operator
+  /// \param [in] category The category of the spans
+  /// \param [in] start_ts The time interval start range in ms
+  /// \param [in] end_ts The time interval end range in ms
+  /// \param [out] result The time in microseconds
+  /// \return Status object with the error code
+  Status GetOpSpanTimeByTime(int32_t op_id, SpanCategory category, uint64_t start_ts, uint64_t end_ts,
+                             uint64_t *result);
+
   /// \brief API to get the connector size of DatasetIterator or DeviceQueueOp
   /// \param [in] epoch_num The epoch number for which results are requested
   /// \param [out] result A vector with connector size at each step
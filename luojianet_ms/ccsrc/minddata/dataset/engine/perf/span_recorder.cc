@@ -0,0 +1,160 @@
+/**
+ * Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+ * Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/perf/span_recorder.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+#include "minddata/dataset/util/task_manager.h"
+
+namespace luojianet_ms {
+namespace dataset {
+
+// Keeps the buffer of a thread, and marks it when the thread exits so that Clear can release it.
+struct ThreadBufferHolder {
+  std::shared_ptr<SpanRecorder::ThreadBuffer> buffer;
+  ~ThreadBufferHolder() {
+    if (buffer != nullptr) {
+      std::lock_guard<std::mutex> guard(buffer->mutex);
+      buffer->thread_exited = true;
+    }
+  }
+};
+
+namespace {
+thread_local ThreadBufferHolder g_span_buffer;
+}  // namespace
+
+SpanRecorder &SpanRecorder::GetInstance() {
+  static SpanRecorder instance;
+  return instance;
+}
+
+uint64_t SpanRecorder::NowUs() {
+  // because cpplint does not allow using namespace
+  using std::chrono::duration_cast;
+  using std::chrono::microseconds;
+  using std::chrono::steady_clock;
+  return static_cast<uint64_t>(duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
+void SpanRecorder::Start(uint32_t sample_interval) {
+  sample_interval_ = std::max(sample_interval, 1U);
+  enabled_ = true;
+}
+
+void SpanRecorder::Stop() { enabled_ = false; }
+
+std::shared_ptr<SpanRecorder::ThreadBuffer> SpanRecorder::GetThreadBuffer() {
+  if (g_span_buffer.buffer == nullptr) {
+    auto buffer = std::make_shared<ThreadBuffer>();
+    buffer->ring.resize(kSpanRingSize);
+    std::lock_guard<std::mutex> guard(mutex_);
+    buffers_.push_back(buffer);
+    g_span_buffer.buffer = std::move(buffer);
+  }
+  return g_span_buffer.buffer;
+}
+
+void SpanRecorder::Record(SpanCategory category, const std::string &name, uint64_t start_us, uint64_t end_us) {
+  if (!enabled()) {
+    return;
+  }
+  Task *task = TaskManager::FindMe();
+  if (task == nullptr || task->get_operator_id() < 0) {
+    return;
+  }
+  int32_t op_id = task->get_operator_id();
+  uint64_t duration_us = end_us > start_us ? end_us - start_us : 0;
+  auto buffer = GetThreadBuffer();
+  std::lock_guard<std::mutex> guard(buffer->mutex);
+  auto key = std::make_tuple(op_id, category, name);
+  auto itr = buffer->summaries.find(key);
+  if (itr == buffer->summaries.end()) {
+    itr = buffer->summaries.emplace(key, SpanSummary{op_id, category, name, 0, 0, 0}).first;
+  }
+  itr->second.count++;
+  itr->second.total_us += duration_us;
+  itr->second.max_us = std::max(itr->second.max_us, duration_us);
+
+  // Only the sampled spans are kept in the timeline
+  if (buffer->num_spans++ % sample_interval_.load(std::memory_order_relaxed) != 0) {
+    return;
+  }
+  SpanRecord &record = buffer->ring[buffer->num_records % kSpanRingSize];
+  record.op_id = op_id;
+  record.thread_id = static_cast<int32_t>(task->get_linux_id());
+  record.category = category;
+  record.start_us = start_us;
+  record.duration_us = duration_us;
+  size_t name_size = std::min(name.size(), kSpanNameSize - 1);
+  (void)std::memcpy(record.name, name.data(), name_size);
+  record.name[name_size] = '\0';
+  buffer->num_records++;
+}
+
+void SpanRecorder::Collect(std::vector<SpanRecord> *records, std::vector<SpanSummary> *summaries) {
+  std::map<std::tuple<int32_t, SpanCategory, std::string>, SpanSummary> merged;
+  std::lock_guard<std::mutex> guard(mutex_);
+  for (const auto &buffer : buffers_) {
+    std::lock_guard<std::mutex> buffer_guard(buffer->mutex);
+    if (records != nullptr) {
+      uint64_t num = std::min<uint64_t>(buffer->num_records, kSpanRingSize);
+      for (uint64_t i = buffer->num_records - num; i < buffer->num_records; ++i) {
+        records->push_back(buffer->ring[i % kSpanRingSize]);
+      }
+    }
+    for (const auto &item : buffer->summaries) {
+      auto itr = merged.find(item.first);
+      if (itr == merged.end()) {
+        (void)merged.emplace(item.first, item.second);
+      } else {
+        itr->second.count += item.second.count;
+        itr->second.total_us += item.second.total_us;
+        itr->second.max_us = std::max(itr->second.max_us, item.second.max_us);
+      }
+    }
+  }
+  if (records != nullptr) {
+    std::sort(records->begin(), records->end(),
+              [](const SpanRecord &a, const SpanRecord &b) { return a.start_us < b.start_us; });
+  }
+  if (summaries != nullptr) {
+    for (auto &item : merged) {
+      summaries->push_back(std::move(item.second));
+    }
+  }
+}
+
+void SpanRecorder::Clear() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  std::vector<std::shared_ptr<ThreadBuffer>> live_buffers;
+  for (const auto &buffer : buffers_) {
+    std::lock_guard<std::mutex> buffer_guard(buffer->mutex);
+    if (buffer->thread_exited) {
+      continue;
+    }
+    buffer->num_records = 0;
+    buffer->num_spans = 0;
+    buffer->summaries.clear();
+    live_buffers.push_back(buffer);
+  }
+  buffers_ = std::move(live_buffers);
+}
+}  // namespace dataset
+}  // namespace luojianet_ms
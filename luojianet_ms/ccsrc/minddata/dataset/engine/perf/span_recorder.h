@@ -0,0 +1,126 @@
+/**
+ * Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+ * Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LUOJIANET_MS_CCSRC_MINDDATA_DATASET_ENGINE_PERF_SPAN_RECORDER_H_
+#define LUOJIANET_MS_CCSRC_MINDDATA_DATASET_ENGINE_PERF_SPAN_RECORDER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace luojianet_ms {
+namespace dataset {
+
+// What a worker thread is doing during a span
+enum class SpanCategory : int32_t {
+  kCompute = 0,      // running a TensorOp
+  kPushBlocked = 1,  // waiting for room in the output connector
+  kPopBlocked = 2,   // waiting for data in the input connector
+};
+constexpr int32_t kNumSpanCategories = 3;
+
+// Max length of span name kept in the timeline, longer names are truncated
+constexpr size_t kSpanNameSize = 40;
+// Number of spans kept in the timeline of a thread, the oldest ones are overwritten
+constexpr size_t kSpanRingSize = 8192;
+// Default of how often the spans are kept in the timeline, one of every n spans of a thread
+constexpr uint32_t kDefaultSpanSampleInterval = 1;
+
+struct SpanRecord {
+  int32_t op_id;
+  int32_t thread_id;
+  SpanCategory category;
+  uint64_t start_us;
+  uint64_t duration_us;
+  char name[kSpanNameSize];
+};
+
+// Accumulated spans of one op with the same category and name, all the spans are counted regardless of sampling
+struct SpanSummary {
+  int32_t op_id;
+  SpanCategory category;
+  std::string name;
+  uint64_t count;
+  uint64_t total_us;
+  uint64_t max_us;
+};
+
+// SpanRecorder collects the spans of the pipeline threads. Every thread writes into its own ring buffer, so recording
+// doesn't contend with the other threads, and nothing is done except one atomic load when the recorder is stopped.
+// The op of a span is the operator id of the task running on the thread.
+class SpanRecorder {
+ public:
+  static SpanRecorder &GetInstance();
+
+  ~SpanRecorder() = default;
+
+  bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+  // Start recording
+  // @param sample_interval - one of every sample_interval spans of a thread is kept in the timeline
+  void Start(uint32_t sample_interval = kDefaultSpanSampleInterval);
+
+  void Stop();
+
+  // Record a span of the current thread, it is dropped if the thread doesn't run an op
+  void Record(SpanCategory category, const std::string &name, uint64_t start_us, uint64_t end_us);
+
+  // Record a span of the current thread which ends now, after being blocked for blocked_us
+  void RecordBlocked(SpanCategory category, const char *name, uint64_t blocked_us) {
+    if (blocked_us > 0 && enabled()) {
+      uint64_t end_us = NowUs();
+      Record(category, name, end_us - blocked_us, end_us);
+    }
+  }
+
+  // Get the spans in the timelines ordered by start time, and the summaries ordered by op, category and name
+  void Collect(std::vector<SpanRecord> *records, std::vector<SpanSummary> *summaries);
+
+  // Drop all the recorded spans
+  void Clear();
+
+  // Current time in microseconds of steady clock
+  static uint64_t NowUs();
+
+ private:
+  struct ThreadBuffer {
+    std::mutex mutex;  // only contends with Collect and Clear
+    std::vector<SpanRecord> ring;
+    uint64_t num_records = 0;
+    uint32_t num_spans = 0;
+    std::map<std::tuple<int32_t, SpanCategory, std::string>, SpanSummary> summaries;
+    bool thread_exited = false;
+  };
+
+  friend struct ThreadBufferHolder;
+
+  SpanRecorder() = default;
+
+  std::shared_ptr<ThreadBuffer> GetThreadBuffer();
+
+  std::atomic<bool> enabled_{false};
+  std::atomic<uint32_t> sample_interval_{kDefaultSpanSampleInterval};
+  std::mutex mutex_;
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers_;
+};
+}  // namespace dataset
+}  // namespace luojianet_ms
+#endif  // LUOJIANET_MS_CCSRC_MINDDATA_DATASET_ENGINE_PERF_SPAN_RECORDER_H_
@@ -0,0 +1,173 @@
+/**
+ * Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+ * Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/perf/span_tracing.h"
+
+#include <sys/stat.h>
+#include <algorithm>
+#include <fstream>
+
+#include "utils/ms_utils.h"
+#include "minddata/dataset/engine/execution_tree.h"
+#include "minddata/dataset/util/path.h"
+
+using json = nlohmann::json;
+namespace luojianet_ms {
+namespace dataset {
+namespace {
+std::string CategoryName(SpanCategory category) {
+  switch (category) {
+    case SpanCategory::kCompute:
+      return "compute";
+    case SpanCategory::kPushBlocked:
+      return "push_blocked";
+    case SpanCategory::kPopBlocked:
+      return "pop_blocked";
+    default:
+      return "unknown";
+  }
+}
+}  // namespace
+
+Status SpanTracing::Init() {
+  RETURN_UNEXPECTED_IF_NULL(tree_);
+  for (auto &node : *tree_) {
+    op_names_[node.id()] = node.NameWithID();
+  }
+  return Status::OK();
+}
+
+Status SpanTracing::Start() {
+  RETURN_IF_NOT_OK(Profiling::Start());
+  SpanRecorder::GetInstance().Start();
+  return Status::OK();
+}
+
+Status SpanTracing::Stop() {
+  RETURN_IF_NOT_OK(Profiling::Stop());
+  SpanRecorder::GetInstance().Stop();
+  return Status::OK();
+}
+
+Status SpanTracing::Sample() {
+  if (active_ == false) return Status::OK();
+  std::vector<SpanSummary> summaries;
+  SpanRecorder::GetInstance().Collect(nullptr, &summaries);
+  size_t num_ops = op_names_.empty() ? 0 : static_cast<size_t>(op_names_.rbegin()->first) + 1;
+  SpanTimeSample sample(num_ops, std::array<uint64_t, kNumSpanCategories>{});
+  for (const auto &summary : summaries) {
+    if (static_cast<size_t>(summary.op_id) < num_ops) {
+      sample[summary.op_id][static_cast<int32_t>(summary.category)] += summary.total_us;
+    }
+  }
+  std::lock_guard<std::mutex> guard(lock_);
+  sample_table_.push_back(std::move(sample));
+  (void)ts_.emplace_back(ProfilingTime::GetCurMilliSecond());
+  return Status::OK();
+}
+
+Status SpanTracing::GetOpSpanTime(int32_t op_id, SpanCategory category, uint64_t start_time, uint64_t end_time,
+                                  uint64_t *result) {
+  RETURN_UNEXPECTED_IF_NULL(result);
+  CHECK_FAIL_RETURN_UNEXPECTED(start_time < end_time,
+                               "Expected start_time < end_time. Got start_ts: " + std::to_string(start_time) +
+                                 " end_ts: " + std::to_string(end_time));
+  std::lock_guard<std::mutex> guard(lock_);
+  *result = 0;
+  // the time of the op is the difference between the first and the last sample in the range
+  auto first = std::lower_bound(ts_.begin(), ts_.end(), start_time);
+  auto last = std::upper_bound(ts_.begin(), ts_.end(), end_time);
+  if (std::distance(first, last) < 2) {
+    return Status::OK();
+  }
+  const auto &first_sample = sample_table_[std::distance(ts_.begin(), first)];
+  const auto &last_sample = sample_table_[std::distance(ts_.begin(), last) - 1];
+  CHECK_FAIL_RETURN_UNEXPECTED(op_id >= 0 && static_cast<size_t>(op_id) < last_sample.size(),
+                               "Invalid op_id: " + std::to_string(op_id));
+  auto index = static_cast<int32_t>(category);
+  *result = last_sample[op_id][index] - first_sample[op_id][index];
+  return Status::OK();
+}
+
+Status SpanTracing::SaveToFile(const std::string &dir_path, const std::string &rank_id) {
+  Path path = GetFileName(dir_path, rank_id);
+  // Remove the file if it exists (from prior profiling usage)
+  RETURN_IF_NOT_OK(path.Remove());
+  std::string file_path = path.ToString();
+
+  std::vector<SpanRecord> records;
+  std::vector<SpanSummary> summaries;
+  SpanRecorder::GetInstance().Collect(&records, &summaries);
+
+  // one process per op in the timelines
+  json events = json::array();
+  for (const auto &op : op_names_) {
+    events.push_back({{"name", "process_name"}, {"ph", "M"}, {"pid", op.first}, {"args", {{"name", op.second}}}});
+  }
+  for (const auto &record : records) {
+    events.push_back({{"name", record.name},
+                      {"cat", CategoryName(record.category)},
+                      {"ph", "X"},
+                      {"ts", record.start_us},
+                      {"dur", record.duration_us},
+                      {"pid", record.op_id},
+                      {"tid", record.thread_id}});
+  }
+  json summary = json::array();
+  for (const auto &item : summaries) {
+    summary.push_back({{"op_id", item.op_id},
+                       {"category", CategoryName(item.category)},
+                       {"name", item.name},
+                       {"count", item.count},
+                       {"total_us", item.total_us},
+                       {"max_us", item.max_us}});
+  }
+
+  json output;
+  output["traceEvents"] = events;
+  output["displayTimeUnit"] = "ms";
+  output["span_summary"] = summary;
+
+  // Discard the content of the file when opening.
+  std::ofstream os(file_path, std::ios::trunc);
+  os << output;
+  os.close();
+  return Status::OK();
+}
+
+Status SpanTracing::ChangeFileMode(const std::string &dir_path, const std::string &rank_id) {
+  Path path = GetFileName(dir_path, rank_id);
+  std::string file_path = path.ToString();
+  if (chmod(common::SafeCStr(file_path), S_IRUSR | S_IWUSR) == -1) {
+    std::string err_str = "Change file mode failed," + file_path;
+    return Status(StatusCode::kMDUnexpectedError, err_str);
+  }
+  return Status::OK();
+}
+
+void SpanTracing::Clear() {
+  SpanRecorder::GetInstance().Clear();
+  std::lock_guard<std::mutex> guard(lock_);
+  op_names_.clear();
+  sample_table_.clear();
+  ts_.clear();
+}
+
+Path SpanTracing::GetFileName(const std::string &dir_path, const std::string &rank_id) {
+  return Path(dir_path) / Path("dataset_trace_" + rank_id + ".json");
+}
+}  // namespace dataset
+}  // namespace luojianet_ms
@@ -0,0 +1,87 @@
+/**
+ * Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+ * Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef LUOJIANET_MS_CCSRC_MINDDATA_DATASET_ENGINE_PERF_SPAN_TRACING_H_
+#define LUOJIANET_MS_CCSRC_MINDDATA_DATASET_ENGINE_PERF_SPAN_TRACING_H_
+
+#include <array>
+#include <map>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "minddata/dataset/engine/perf/profiling.h"
+#include "minddata/dataset/engine/perf/span_recorder.h"
+
+namespace luojianet_ms {
+namespace dataset {
+class ExecutionTree;
+
+// Span tracing records what every worker of the ops is doing over time: running a TensorOp, or being blocked on the
+// input or output connector. The timelines are saved in the Chrome trace format, which can be opened by
+// chrome://tracing or Perfetto, with one process per op and one thread per worker.
+// The time each op spent in every category is also sampled periodically for the consumers like AutoTune.
+class SpanTracing : public Sampling {
+  // Accumulated time in microseconds of each op in every category, indexed by op id
+  using SpanTimeSample = std::vector<std::array<uint64_t, kNumSpanCategories>>;
+
+ public:
+  explicit SpanTracing(ExecutionTree *tree) : tree_(tree) {}
+
+  ~SpanTracing() override = default;
+
+  Status Init() override;
+
+  // Sample the accumulated time of each op from the span recorder
+  Status Sample() override;
+
+  std::string Name() const override { return kSpanTracingName; }
+
+  // Start the span recorder together with this node
+  Status Start() override;
+
+  // Stop the span recorder together with this node
+  Status Stop() override;
+
+  // Save the timelines and the summaries to file
+  // @return Status The status code returned
+  Status SaveToFile(const std::string &dir_path, const std::string &rank_id) override;
+
+  Status ChangeFileMode(const std::string &dir_path, const std::string &rank_id) override;
+
+  // Get the time the op spent in the category between the samples taken in the given time range
+  // @param op_id - id of the op
+  // @param category - the category of the spans
+  // @param start_time - start of the range in milliseconds
+  // @param end_time - end of the range in milliseconds
+  // @param result - time in microseconds
+  // @return Status The status code returned
+  Status GetOpSpanTime(int32_t op_id, SpanCategory category, uint64_t start_time, uint64_t end_time,
+                       uint64_t *result);
+
+  // Clear all collected data
+  void Clear() override;
+
+ private:
+  ExecutionTree *tree_ = nullptr;
+  std::map<int32_t, std::string> op_names_;  // name of the ops to show in the timelines, e.g. Map(2)
+  std::vector<SpanTimeSample> sample_table_;
+  std::vector<uint64_t> ts_;  // time of sample
+  Path GetFileName(const std::string &dir_path, const std::string &rank_id) override;
+};
+}  // namespace dataset
+}  // namespace luojianet_ms
+
+#endif  // LUOJIANET_MS_CCSRC_MINDDATA_DATASET_ENGINE_PERF_SPAN_TRACING_H_
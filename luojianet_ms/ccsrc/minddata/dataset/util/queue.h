@@ -19,6 +19,8 @@
 #define LUOJIANET_MS_CCSRC_MINDDATA_DATASET_UTIL_QUEUE_H_
 
 #include <atomic>
+#include <chrono>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -68,6 +70,12 @@ class Queue {
 
   bool empty() const { return head_ == tail_; }
 
+  // Total time in microseconds the producers have been blocked because the queue is full
+  uint64_t push_blocked_time() const { return push_blocked_us_.load(std::memory_order_relaxed); }
+
+  // Total time in microseconds the consumers have been blocked because the queue is empty
+  uint64_t pop_blocked_time() const { return pop_blocked_us_.load(std::memory_order_relaxed); }
+
   void Reset() {
     std::unique_lock<std::mutex> _lock(mux_);
     ResetQue();
@@ -78,7 +86,7 @@ class Queue {
   Status Add(const_reference ele) noexcept {
     std::unique_lock<std::mutex> _lock(mux_);
     // Block when full
-    Status rc = full_cv_.Wait(&_lock, [this]() -> bool { return (size() != capacity()); });
+    Status rc = WaitAndCount(&full_cv_, &_lock, [this]() -> bool { return (size() != capacity()); }, &push_blocked_us_);
     if (rc.IsOk()) {
       RETURN_IF_NOT_OK(AddWhileHoldingLock(ele));
       empty_cv_.NotifyAll();
@@ -92,7 +100,7 @@ class Queue {
   Status Add(T &&ele) noexcept {
     std::unique_lock<std::mutex> _lock(mux_);
     // Block when full
-    Status rc = full_cv_.Wait(&_lock, [this]() -> bool { return (size() != capacity()); });
+    Status rc = WaitAndCount(&full_cv_, &_lock, [this]() -> bool { return (size() != capacity()); }, &push_blocked_us_);
     if (rc.IsOk()) {
       RETURN_IF_NOT_OK(AddWhileHoldingLock(std::forward<T>(ele)));
       empty_cv_.NotifyAll();
@@ -107,7 +115,7 @@ class Queue {
   Status EmplaceBack(Ts &&... args) noexcept {
     std::unique_lock<std::mutex> _lock(mux_);
     // Block when full
-    Status rc = full_cv_.Wait(&_lock, [this]() -> bool { return (size() != capacity()); });
+    Status rc = WaitAndCount(&full_cv_, &_lock, [this]() -> bool { return (size() != capacity()); }, &push_blocked_us_);
     if (rc.IsOk()) {
       auto k = tail_++ % sz_;
       new (arr_[k]) T(std::forward<Ts>(args)...);
@@ -123,7 +131,7 @@ class Queue {
   Status PopFront(pointer p) {
     std::unique_lock<std::mutex> _lock(mux_);
     // Block when empty
-    Status rc = empty_cv_.Wait(&_lock, [this]() -> bool { return !empty(); });
+    Status rc = WaitAndCount(&empty_cv_, &_lock, [this]() -> bool { return !empty(); }, &pop_blocked_us_);
     if (rc.IsOk()) {
       RETURN_IF_NOT_OK(PopFrontWhileHoldingLock(p, true));
       full_cv_.NotifyAll();
@@ -197,6 +205,22 @@ class Queue {
   std::mutex mux_;
   CondVar empty_cv_;
   CondVar full_cv_;
+  std::atomic<uint64_t> push_blocked_us_{0};
+  std::atomic<uint64_t> pop_blocked_us_{0};
+
+  // Wait on the cv until pred holds, the time blocked is added to *blocked_us. Only the waits that actually block
+  // read the clock.
+  Status WaitAndCount(CondVar *cv, std::unique_lock<std::mutex> *lock, const std::function<bool()> &pred,
+                      std::atomic<uint64_t> *blocked_us) {
+    if (pred()) {
+      return cv->Wait(lock, pred);
+    }
+    auto start = std::chrono::steady_clock::now();
+    Status rc = cv->Wait(lock, pred);
+    auto blocked = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    (void)blocked_us->fetch_add(static_cast<uint64_t>(blocked.count()), std::memory_order_relaxed);
+    return rc;
+  }
 
   // Helper function for Add, must be called when holding a lock
   Status AddWhileHoldingLock(const_reference ele) {
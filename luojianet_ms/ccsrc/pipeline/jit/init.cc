@@ -337,11 +337,11 @@ PYBIND11_MODULE(_c_expression, m) {
     .def(py::init<const std::string &>())
     .def("GetFileName", &EventWriter::GetFileName, "Get the file name.")
     .def("Open", &EventWriter::Open, "Open the write file.")
-    .def("Write", &EventWriter::Write, "Write the serialize event.")
+    .def("Write", &EventWriter::Write, py::call_guard<py::gil_scoped_release>(), "Write the serialize event.")
     .def("EventCount", &EventWriter::GetWriteEventCount, "Write event count.")
-    .def("Flush", &EventWriter::Flush, "Flush the event.")
-    .def("Close", &EventWriter::Close, "Close the write.")
-    .def("Shut", &EventWriter::Shut, "Final close the write.");
+    .def("Flush", &EventWriter::Flush, py::call_guard<py::gil_scoped_release>(), "Flush the event.")
+    .def("Close", &EventWriter::Close, py::call_guard<py::gil_scoped_release>(), "Close the write.")
+    .def("Shut", &EventWriter::Shut, py::call_guard<py::gil_scoped_release>(), "Final close the write.");
 #endif  // ENABLE_SECURITY
 
   (void)py::class_<OpLib, std::shared_ptr<OpLib>>(m, "Oplib")
@@ -479,7 +479,19 @@ PYBIND11_MODULE(_c_expression, m) {
     .def("set_encrypt_type", &PSContext::set_encrypt_type,
          "Set encrypt type for federated learning secure aggregation.")
     .def("set_http_url_prefix", &PSContext::set_http_url_prefix, "Set http url prefix for http communication.")
-    .def("http_url_prefix", &PSContext::http_url_prefix, "http url prefix for http communication.");
+    .def("http_url_prefix", &PSContext::http_url_prefix, "http url prefix for http communication.")
+    .def("set_embedding_cache_size", &PSContext::set_embedding_cache_size,
+         "Set the row number of the host embedding cache on the worker.")
+    .def("embedding_cache_size", &PSContext::embedding_cache_size,
+         "Get the row number of the host embedding cache on the worker.")
+    .def("set_embedding_cache_policy", &PSContext::set_embedding_cache_policy,
+         "Set the eviction policy of the host embedding cache.")
+    .def("embedding_cache_policy", &PSContext::embedding_cache_policy,
+         "Get the eviction policy of the host embedding cache.")
+    .def("set_embedding_cache_staleness", &PSContext::set_embedding_cache_staleness,
+         "Set the staleness bound of the rows in the host embedding cache.")
+    .def("embedding_cache_staleness", &PSContext::embedding_cache_staleness,
+         "Get the staleness bound of the rows in the host embedding cache.");
 
   (void)m.def("_encrypt", &luojianet_ms::pipeline::PyEncrypt, "Encrypt the data.");
   (void)m.def("_decrypt", &luojianet_ms::pipeline::PyDecrypt, "Decrypt the data.");
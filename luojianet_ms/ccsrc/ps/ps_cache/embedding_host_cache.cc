@@ -0,0 +1,448 @@
+/**
+ * Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+ * Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ps/ps_cache/embedding_host_cache.h"
+#include <algorithm>
+#include <chrono>
+#include "utils/log_adapter.h"
+
+namespace luojianet_ms {
+namespace ps {
+namespace {
+constexpr uint64_t kEmptySlot = UINT64_MAX;
+constexpr uint64_t kSlotIdShift = 32;
+constexpr uint64_t kSlotRowMask = 0xFFFFFFFF;
+constexpr uint64_t kHashMultiplier = 0x9E3779B97F4A7C15;
+constexpr size_t kHashBits = 64;
+// The number of rows compared to select the victim of an eviction.
+constexpr size_t kEvictSamples = 8;
+// The interval of retrying the failed write-back, unless it's flushed.
+constexpr auto kWriteBackRetryInterval = std::chrono::milliseconds(100);
+
+uint64_t MakeSlot(int id, size_t row) {
+  return (static_cast<uint64_t>(static_cast<uint32_t>(id)) << kSlotIdShift) | static_cast<uint64_t>(row);
+}
+int SlotId(uint64_t slot) { return static_cast<int>(static_cast<uint32_t>(slot >> kSlotIdShift)); }
+size_t SlotRow(uint64_t slot) { return static_cast<size_t>(slot & kSlotRowMask); }
+}  // namespace
+
+std::unique_ptr<EmbeddingCachePolicy> CreateEmbeddingCachePolicy(const std::string &name) {
+  if (name == "LRU") {
+    return std::make_unique<LRUCachePolicy>();
+  }
+  if (name == "LFU") {
+    return std::make_unique<LFUCachePolicy>();
+  }
+  return nullptr;
+}
+
+EmbeddingHostCache::EmbeddingHostCache(size_t capacity, size_t embedding_size, size_t max_staleness,
+                                       std::unique_ptr<EmbeddingCachePolicy> policy, EmbeddingWriteBack write_back)
+    : capacity_(capacity),
+      embedding_size_(embedding_size),
+      max_staleness_(max_staleness),
+      policy_(std::move(policy)),
+      write_back_(std::move(write_back)) {
+  if (capacity_ == 0 || capacity_ > kSlotRowMask || embedding_size_ == 0) {
+    MS_LOG(EXCEPTION) << "Invalid embedding cache, capacity: " << capacity_ << ", embedding size: " << embedding_size_;
+  }
+  MS_EXCEPTION_IF_NULL(policy_);
+  // Keep the load factor of the hash table under 0.5 for short probes.
+  size_t log2_size = 1;
+  while ((static_cast<size_t>(1) << log2_size) < capacity_ * 2) {
+    ++log2_size;
+  }
+  table_size_ = static_cast<size_t>(1) << log2_size;
+  hash_shift_ = kHashBits - log2_size;
+  slots_ = std::make_unique<std::atomic<uint64_t>[]>(table_size_);
+  for (size_t i = 0; i < table_size_; ++i) {
+    slots_[i].store(kEmptySlot, std::memory_order_relaxed);
+  }
+  rows_ = std::make_unique<Row[]>(capacity_);
+  data_ = std::make_unique<std::atomic<float>[]>(capacity_ * embedding_size_);
+  free_rows_.reserve(capacity_);
+  for (size_t i = capacity_; i > 0; --i) {
+    free_rows_.push_back(i - 1);
+  }
+  protected_.resize(capacity_, false);
+  write_back_thread_ = std::thread(&EmbeddingHostCache::WriteBackLoop, this);
+}
+
+EmbeddingHostCache::~EmbeddingHostCache() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  write_back_cv_.notify_all();
+  if (write_back_thread_.joinable()) {
+    write_back_thread_.join();
+  }
+}
+
+size_t EmbeddingHostCache::Hash(int id) const {
+  return static_cast<size_t>((static_cast<uint64_t>(static_cast<uint32_t>(id)) * kHashMultiplier) >> hash_shift_);
+}
+
+size_t EmbeddingHostCache::FindRow(int id) const {
+  size_t mask = table_size_ - 1;
+  size_t index = Hash(id);
+  for (size_t probe = 0; probe < table_size_; ++probe) {
+    uint64_t slot = slots_[index].load(std::memory_order_acquire);
+    if (slot == kEmptySlot) {
+      return capacity_;
+    }
+    if (SlotId(slot) == id) {
+      return SlotRow(slot);
+    }
+    index = (index + 1) & mask;
+  }
+  return capacity_;
+}
+
+void EmbeddingHostCache::AddSlot(int id, size_t row) {
+  size_t mask = table_size_ - 1;
+  size_t index = Hash(id);
+  while (slots_[index].load(std::memory_order_relaxed) != kEmptySlot) {
+    index = (index + 1) & mask;
+  }
+  slots_[index].store(MakeSlot(id, row), std::memory_order_release);
+}
+
+// Backward shift deletion, so no tombstone is left in the table. A concurrent reader may miss an entry which is being
+// moved, the miss is checked again under the lock.
+void EmbeddingHostCache::EraseSlot(int id) {
+  size_t mask = table_size_ - 1;
+  size_t hole = Hash(id);
+  while (true) {
+    uint64_t slot = slots_[hole].load(std::memory_order_relaxed);
+    if (slot == kEmptySlot) {
+      return;
+    }
+    if (SlotId(slot) == id) {
+      break;
+    }
+    hole = (hole + 1) & mask;
+  }
+  size_t index = hole;
+  while (true) {
+    index = (index + 1) & mask;
+    uint64_t slot = slots_[index].load(std::memory_order_relaxed);
+    if (slot == kEmptySlot) {
+      break;
+    }
+    size_t home = Hash(SlotId(slot));
+    // The entry can't be moved to the hole if its home is cyclically in (hole, index].
+    bool in_range = hole <= index ? (home > hole && home <= index) : (home > hole || home <= index);
+    if (!in_range) {
+      slots_[hole].store(slot, std::memory_order_release);
+      hole = index;
+    }
+  }
+  slots_[hole].store(kEmptySlot, std::memory_order_release);
+}
+
+bool EmbeddingHostCache::ReadRow(int id, uint64_t tick, size_t step, float *output) {
+  if (id < 0) {
+    return false;
+  }
+  size_t row = FindRow(id);
+  if (row == capacity_) {
+    return false;
+  }
+  Row &cached = rows_[row];
+  uint32_t version = cached.version.load(std::memory_order_acquire);
+  if ((version & 1) != 0 || cached.id.load(std::memory_order_relaxed) != id) {
+    return false;
+  }
+  if (!cached.dirty.load(std::memory_order_relaxed) &&
+      step > cached.fetch_step.load(std::memory_order_relaxed) + max_staleness_) {
+    return false;
+  }
+  CopyRow(row, output);
+  std::atomic_thread_fence(std::memory_order_acquire);
+  if (cached.version.load(std::memory_order_relaxed) != version) {
+    return false;
+  }
+  cached.score.store(policy_->AccessScore(cached.score.load(std::memory_order_relaxed), tick),
+                     std::memory_order_relaxed);
+  return true;
+}
+
+void EmbeddingHostCache::WriteRow(size_t row, int id, const float *value, bool dirty) {
+  Row &cached = rows_[row];
+  uint32_t version = cached.version.load(std::memory_order_relaxed);
+  cached.version.store(version + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  std::atomic<float> *data = data_.get() + row * embedding_size_;
+  for (size_t i = 0; i < embedding_size_; ++i) {
+    data[i].store(value[i], std::memory_order_relaxed);
+  }
+  cached.id.store(id, std::memory_order_relaxed);
+  cached.dirty.store(dirty, std::memory_order_relaxed);
+  cached.fetch_step.store(step_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+  cached.version.store(version + 2, std::memory_order_release);
+}
+
+void EmbeddingHostCache::CopyRow(size_t row, float *output) const {
+  const std::atomic<float> *data = data_.get() + row * embedding_size_;
+  for (size_t i = 0; i < embedding_size_; ++i) {
+    output[i] = data[i].load(std::memory_order_relaxed);
+  }
+}
+
+std::vector<float> EmbeddingHostCache::RowValues(size_t row) const {
+  std::vector<float> values(embedding_size_);
+  CopyRow(row, values.data());
+  return values;
+}
+
+size_t EmbeddingHostCache::SelectVictim() {
+  // Sample the rows round robin, and take the one with the lowest score which isn't written by the current call.
+  for (size_t window = 0; window <= capacity_ / kEvictSamples; ++window) {
+    size_t victim = capacity_;
+    uint64_t victim_score = UINT64_MAX;
+    for (size_t i = 0; i < kEvictSamples; ++i) {
+      size_t row = evict_cursor_;
+      evict_cursor_ = (evict_cursor_ + 1) % capacity_;
+      uint64_t score = rows_[row].score.load(std::memory_order_relaxed);
+      if (!protected_[row] && score < victim_score) {
+        victim = row;
+        victim_score = score;
+      }
+    }
+    if (victim != capacity_) {
+      return victim;
+    }
+  }
+  return capacity_;
+}
+
+void EmbeddingHostCache::EvictRow(size_t row) {
+  Row &cached = rows_[row];
+  int id = cached.id.load(std::memory_order_relaxed);
+  if (cached.dirty.load(std::memory_order_relaxed)) {
+    pending_[id] = std::make_pair(++write_back_seq_, RowValues(row));
+    write_back_cv_.notify_one();
+  }
+  EraseSlot(id);
+  (void)eviction_count_.fetch_add(1, std::memory_order_relaxed);
+}
+
+size_t EmbeddingHostCache::AllocateRow(uint64_t tick) {
+  size_t row = capacity_;
+  if (!free_rows_.empty()) {
+    row = free_rows_.back();
+    free_rows_.pop_back();
+  } else {
+    row = SelectVictim();
+    if (row == capacity_) {
+      return capacity_;
+    }
+    EvictRow(row);
+  }
+  rows_[row].score.store(policy_->InitialScore(tick), std::memory_order_relaxed);
+  return row;
+}
+
+bool EmbeddingHostCache::PutRow(int id, const float *value, bool dirty, uint64_t tick) {
+  size_t row = FindRow(id);
+  if (row == capacity_) {
+    row = AllocateRow(tick);
+    if (row == capacity_) {
+      return false;
+    }
+    WriteRow(row, id, value, dirty);
+    AddSlot(id, row);
+  } else {
+    WriteRow(row, id, value, dirty);
+  }
+  if (!protected_[row]) {
+    protected_[row] = true;
+    protected_rows_.push_back(row);
+  }
+  return true;
+}
+
+void EmbeddingHostCache::ReleaseProtectedRows() {
+  for (auto row : protected_rows_) {
+    protected_[row] = false;
+  }
+  protected_rows_.clear();
+}
+
+void EmbeddingHostCache::Lookup(const int *ids, size_t count, float *output, std::vector<size_t> *miss_positions) {
+  MS_EXCEPTION_IF_NULL(ids);
+  MS_EXCEPTION_IF_NULL(output);
+  MS_EXCEPTION_IF_NULL(miss_positions);
+  miss_positions->clear();
+  uint64_t tick = tick_.fetch_add(1, std::memory_order_relaxed) + 1;
+  size_t step = step_.load(std::memory_order_relaxed);
+  std::vector<size_t> misses;
+  for (size_t i = 0; i < count; ++i) {
+    if (!ReadRow(ids[i], tick, step, output + i * embedding_size_)) {
+      misses.push_back(i);
+    }
+  }
+  if (!misses.empty()) {
+    // Check the misses again under the lock, the row could be moved by a writer, or be waiting for write-back.
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto pos : misses) {
+      float *row_output = output + pos * embedding_size_;
+      if (ReadRow(ids[pos], tick, step, row_output)) {
+        continue;
+      }
+      auto iter = pending_.find(ids[pos]);
+      if (iter != pending_.end()) {
+        const auto &value = iter->second.second;
+        (void)std::copy(value.begin(), value.end(), row_output);
+        (void)PutRow(ids[pos], value.data(), true, tick);
+        continue;
+      }
+      miss_positions->push_back(pos);
+    }
+    ReleaseProtectedRows();
+  }
+  (void)hit_count_.fetch_add(count - miss_positions->size(), std::memory_order_relaxed);
+  (void)miss_count_.fetch_add(miss_positions->size(), std::memory_order_relaxed);
+}
+
+void EmbeddingHostCache::Insert(const std::vector<int> &ids, const float *values) {
+  if (ids.empty()) {
+    return;
+  }
+  MS_EXCEPTION_IF_NULL(values);
+  uint64_t tick = tick_.fetch_add(1, std::memory_order_relaxed) + 1;
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (size_t i = 0; i < ids.size(); ++i) {
+    if (ids[i] < 0) {
+      continue;
+    }
+    // The row updated on the worker is newer than the one on the server.
+    size_t row = FindRow(ids[i]);
+    if (row != capacity_ && rows_[row].dirty.load(std::memory_order_relaxed)) {
+      continue;
+    }
+    if (pending_.count(ids[i]) != 0) {
+      continue;
+    }
+    if (!PutRow(ids[i], values + i * embedding_size_, false, tick)) {
+      break;
+    }
+  }
+  ReleaseProtectedRows();
+}
+
+void EmbeddingHostCache::Update(const std::vector<int> &ids, const float *values) {
+  if (ids.empty()) {
+    return;
+  }
+  MS_EXCEPTION_IF_NULL(values);
+  uint64_t tick = tick_.fetch_add(1, std::memory_order_relaxed) + 1;
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (size_t i = 0; i < ids.size(); ++i) {
+    if (ids[i] < 0) {
+      continue;
+    }
+    const float *value = values + i * embedding_size_;
+    if (!PutRow(ids[i], value, true, tick)) {
+      // More rows than the capacity are updated in one call, write back the rest directly.
+      pending_[ids[i]] = std::make_pair(++write_back_seq_, std::vector<float>(value, value + embedding_size_));
+      write_back_cv_.notify_one();
+    }
+  }
+  ReleaseProtectedRows();
+}
+
+bool EmbeddingHostCache::Flush() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  for (size_t row = 0; row < capacity_; ++row) {
+    Row &cached = rows_[row];
+    if (cached.dirty.load(std::memory_order_relaxed)) {
+      pending_[cached.id.load(std::memory_order_relaxed)] = std::make_pair(++write_back_seq_, RowValues(row));
+      cached.dirty.store(false, std::memory_order_relaxed);
+    }
+  }
+  // Wait until all the rows are sent, or an attempt started after this one fails.
+  uint64_t attempt = write_back_attempt_;
+  ++flush_waiters_;
+  write_back_cv_.notify_one();
+  flush_cv_.wait(lock, [this, attempt]() { return pending_.empty() || failed_write_back_attempt_ > attempt; });
+  --flush_waiters_;
+  return pending_.empty();
+}
+
+double EmbeddingHostCache::hit_rate() const {
+  uint64_t hits = hit_count();
+  uint64_t total = hits + miss_count();
+  return total == 0 ? 0.0 : static_cast<double>(hits) / total;
+}
+
+void EmbeddingHostCache::WriteBackLoop() {
+  bool retry = false;
+  while (true) {
+    std::vector<int> ids;
+    std::vector<uint64_t> seqs;
+    std::vector<float> values;
+    uint64_t attempt = 0;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      if (retry) {
+        (void)write_back_cv_.wait_for(lock, kWriteBackRetryInterval,
+                                      [this]() { return stop_ || flush_waiters_ > 0; });
+      }
+      write_back_cv_.wait(lock, [this]() { return stop_ || !pending_.empty(); });
+      // The pending rows are still written back when stopping.
+      if (pending_.empty()) {
+        return;
+      }
+      attempt = ++write_back_attempt_;
+      values.reserve(pending_.size() * embedding_size_);
+      for (const auto &item : pending_) {
+        ids.push_back(item.first);
+        seqs.push_back(item.second.first);
+        values.insert(values.end(), item.second.second.begin(), item.second.second.end());
+      }
+    }
+    // The rows stay in pending_ while being sent, so that a lookup of them doesn't go to the server.
+    bool ret = write_back_ == nullptr || write_back_(ids, values);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!ret) {
+        failed_write_back_attempt_ = attempt;
+        if (stop_) {
+          MS_LOG(ERROR) << "Writing back " << ids.size() << " embedding rows failed, they are dropped when stopping.";
+          pending_.clear();
+          return;
+        }
+        MS_LOG(ERROR) << "Writing back " << ids.size() << " embedding rows failed, they are kept to be retried.";
+      } else {
+        for (size_t i = 0; i < ids.size(); ++i) {
+          auto iter = pending_.find(ids[i]);
+          // Keep the row if it's evicted again with a newer value during the write-back.
+          if (iter != pending_.end() && iter->second.first == seqs[i]) {
+            (void)pending_.erase(iter);
+          }
+        }
+        (void)write_back_count_.fetch_add(ids.size(), std::memory_order_relaxed);
+      }
+    }
+    retry = !ret;
+    flush_cv_.notify_all();
+  }
+}
+}  // namespace ps
+}  // namespace luojianet_ms
@@ -0,0 +1,174 @@
+/**
+ * Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+ * Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LUOJIANET_MS_CCSRC_PS_PS_CACHE_EMBEDDING_HOST_CACHE_H_
+#define LUOJIANET_MS_CCSRC_PS_PS_CACHE_EMBEDDING_HOST_CACHE_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "utils/ms_utils.h"
+
+namespace luojianet_ms {
+namespace ps {
+// The eviction policy of EmbeddingHostCache. Each cached row has a score which is updated when the row is accessed,
+// and the row with the lowest score among the sampled candidates is evicted.
+class EmbeddingCachePolicy {
+ public:
+  EmbeddingCachePolicy() = default;
+  virtual ~EmbeddingCachePolicy() = default;
+  virtual uint64_t InitialScore(uint64_t tick) const = 0;
+  virtual uint64_t AccessScore(uint64_t score, uint64_t tick) const = 0;
+};
+
+// Least recently used, the score is the tick of the last access.
+class LRUCachePolicy : public EmbeddingCachePolicy {
+ public:
+  uint64_t InitialScore(uint64_t tick) const override { return tick; }
+  uint64_t AccessScore(uint64_t, uint64_t tick) const override { return tick; }
+};
+
+// Least frequently used, the score is the access count.
+class LFUCachePolicy : public EmbeddingCachePolicy {
+ public:
+  uint64_t InitialScore(uint64_t) const override { return 1; }
+  uint64_t AccessScore(uint64_t score, uint64_t) const override { return score + 1; }
+};
+
+// Create the policy by its name, "LRU" or "LFU". Returns nullptr for an unknown name.
+std::unique_ptr<EmbeddingCachePolicy> CreateEmbeddingCachePolicy(const std::string &name);
+
+// Send the rows updated on the worker back to the server.
+using EmbeddingWriteBack = std::function<bool(const std::vector<int> &ids, const std::vector<float> &values)>;
+
+// EmbeddingHostCache keeps the hot rows of an embedding table in host memory in front of the parameter server.
+// The ids are indexed by an open addressing hash table with linear probing, whose slots are atomic words, and every
+// row is guarded by a sequence lock. So lookups of cached rows don't take any lock. Inserts, updates and evictions
+// are serialized by a mutex.
+// The rows fetched from the server are reused for max_staleness steps at most. The rows updated on the worker are
+// always up to date, they are written back to the server asynchronously when they are evicted or flushed. The rows
+// which fail to be written back are kept and retried, and are served from the cache in the meantime.
+class EmbeddingHostCache {
+ public:
+  EmbeddingHostCache(size_t capacity, size_t embedding_size, size_t max_staleness,
+                     std::unique_ptr<EmbeddingCachePolicy> policy, EmbeddingWriteBack write_back);
+  ~EmbeddingHostCache();
+
+  // Copy the cached rows of ids to output, the positions of the ids which are missed are returned in miss_positions.
+  void Lookup(const int *ids, size_t count, float *output, std::vector<size_t> *miss_positions);
+
+  // Insert the rows fetched from the server, the rows updated on the worker are kept.
+  void Insert(const std::vector<int> &ids, const float *values);
+
+  // Overwrite the rows updated on the worker.
+  void Update(const std::vector<int> &ids, const float *values);
+
+  // Start a new step, which ages the rows fetched from the server.
+  void NextStep() { (void)step_.fetch_add(1, std::memory_order_relaxed); }
+
+  // Write back all the rows updated on the worker and wait for them to be sent. Returns false if a write-back fails,
+  // the failed rows are still kept for the retries.
+  bool Flush();
+
+  size_t embedding_size() const { return embedding_size_; }
+  uint64_t hit_count() const { return hit_count_.load(std::memory_order_relaxed); }
+  uint64_t miss_count() const { return miss_count_.load(std::memory_order_relaxed); }
+  uint64_t eviction_count() const { return eviction_count_.load(std::memory_order_relaxed); }
+  uint64_t write_back_count() const { return write_back_count_.load(std::memory_order_relaxed); }
+  double hit_rate() const;
+
+ private:
+  struct Row {
+    std::atomic<uint32_t> version{0};  // odd while the row is being written
+    std::atomic<int> id{-1};
+    std::atomic<uint64_t> score{0};
+    std::atomic<size_t> fetch_step{0};
+    std::atomic<bool> dirty{false};  // updated on the worker and not written back yet
+  };
+
+  size_t Hash(int id) const;
+  // Find the row of id in the hash table, returns capacity_ if not found.
+  size_t FindRow(int id) const;
+  void AddSlot(int id, size_t row);
+  void EraseSlot(int id);
+  // Copy the row of id to output if it's cached and valid, without taking the lock.
+  bool ReadRow(int id, uint64_t tick, size_t step, float *output);
+  void WriteRow(size_t row, int id, const float *value, bool dirty);
+  void CopyRow(size_t row, float *output) const;
+  std::vector<float> RowValues(size_t row) const;
+  // Get a free row, evict one if the cache is full. Returns capacity_ if no row could be evicted.
+  size_t AllocateRow(uint64_t tick);
+  size_t SelectVictim();
+  void EvictRow(size_t row);
+  // Put the row into the cache under the lock, returns false if no row is available.
+  bool PutRow(int id, const float *value, bool dirty, uint64_t tick);
+  void ReleaseProtectedRows();
+  void WriteBackLoop();
+
+  size_t capacity_;
+  size_t embedding_size_;
+  size_t max_staleness_;
+  std::unique_ptr<EmbeddingCachePolicy> policy_;
+  EmbeddingWriteBack write_back_;
+
+  size_t table_size_;
+  size_t hash_shift_;
+  std::unique_ptr<std::atomic<uint64_t>[]> slots_;
+  std::unique_ptr<Row[]> rows_;
+  // The values are read without the lock, so they are relaxed atomics, which are plain loads and stores on the
+  // common platforms.
+  std::unique_ptr<std::atomic<float>[]> data_;
+
+  std::atomic<uint64_t> tick_{0};
+  std::atomic<size_t> step_{0};
+
+  // The members below are guarded by mutex_.
+  std::mutex mutex_;
+  std::vector<size_t> free_rows_;
+  size_t evict_cursor_{0};
+  // The rows written by the current Insert or Update, which are not evicted by the same call.
+  std::vector<bool> protected_;
+  std::vector<size_t> protected_rows_;
+  // The evicted rows waiting for write-back, id to the sequence number and the values.
+  std::map<int, std::pair<uint64_t, std::vector<float>>> pending_;
+  uint64_t write_back_seq_{0};
+  // The number of the write-back attempts started, and the number of the last failed one.
+  uint64_t write_back_attempt_{0};
+  uint64_t failed_write_back_attempt_{0};
+  size_t flush_waiters_{0};
+  bool stop_{false};
+  std::condition_variable write_back_cv_;
+  std::condition_variable flush_cv_;
+  std::thread write_back_thread_;
+
+  std::atomic<uint64_t> hit_count_{0};
+  std::atomic<uint64_t> miss_count_{0};
+  std::atomic<uint64_t> eviction_count_{0};
+  std::atomic<uint64_t> write_back_count_{0};
+
+  DISABLE_COPY_AND_ASSIGN(EmbeddingHostCache)
+};
+}  // namespace ps
+}  // namespace luojianet_ms
+#endif  // LUOJIANET_MS_CCSRC_PS_PS_CACHE_EMBEDDING_HOST_CACHE_H_
@@ -477,5 +477,24 @@ void PSContext::set_server_password(const std::string &password) { server_passwo
 std::string PSContext::http_url_prefix() const { return http_url_prefix_; }
 
 void PSContext::set_http_url_prefix(const std::string &http_url_prefix) { http_url_prefix_ = http_url_prefix; }
+
+size_t PSContext::embedding_cache_size() const { return embedding_cache_size_; }
+
+void PSContext::set_embedding_cache_size(size_t embedding_cache_size) { embedding_cache_size_ = embedding_cache_size; }
+
+std::string PSContext::embedding_cache_policy() const { return embedding_cache_policy_; }
+
+void PSContext::set_embedding_cache_policy(const std::string &embedding_cache_policy) {
+  if (embedding_cache_policy != "LRU" && embedding_cache_policy != "LFU") {
+    MS_LOG(EXCEPTION) << "The embedding cache policy must be LRU or LFU, but got " << embedding_cache_policy;
+  }
+  embedding_cache_policy_ = embedding_cache_policy;
+}
+
+uint64_t PSContext::embedding_cache_staleness() const { return embedding_cache_staleness_; }
+
+void PSContext::set_embedding_cache_staleness(uint64_t embedding_cache_staleness) {
+  embedding_cache_staleness_ = embedding_cache_staleness;
+}
 }  // namespace ps
 }  // namespace luojianet_ms
@@ -212,6 +212,15 @@ class PSContext {
   std::string http_url_prefix() const;
   void set_http_url_prefix(const std::string &http_url_prefix);
 
+  size_t embedding_cache_size() const;
+  void set_embedding_cache_size(size_t embedding_cache_size);
+
+  std::string embedding_cache_policy() const;
+  void set_embedding_cache_policy(const std::string &embedding_cache_policy);
+
+  uint64_t embedding_cache_staleness() const;
+  void set_embedding_cache_staleness(uint64_t embedding_cache_staleness);
+
  private:
   PSContext()
       : ps_enabled_(false),
@@ -258,7 +267,10 @@ class PSContext {
         enable_ssl_(false),
         client_password_(""),
         server_password_(""),
-        http_url_prefix_("") {}
+        http_url_prefix_(""),
+        embedding_cache_size_(0),
+        embedding_cache_policy_("LRU"),
+        embedding_cache_staleness_(0) {}
   bool ps_enabled_;
   bool is_worker_;
   bool is_pserver_;
@@ -373,6 +385,14 @@ class PSContext {
   std::string server_password_;
   // http url prefix for http communication
   std::string http_url_prefix_;
+
+  // The row number of the host embedding cache of each embedding table on the worker, 0 means disabled.
+  size_t embedding_cache_size_;
+  // The eviction policy of the host embedding cache, "LRU" or "LFU".
+  std::string embedding_cache_policy_;
+  // The number of lookups a row fetched from the server is reused for by the host embedding cache. The updates of the
+  // other workers are not seen by the cached rows within this number of lookups.
+  uint64_t embedding_cache_staleness_;
 };
 }  // namespace ps
 }  // namespace luojianet_ms
@@ -21,6 +21,8 @@
 namespace luojianet_ms {
 namespace ps {
 constexpr int kRetryDuration = 2000;
+// The embedding table has the shape of (vocab_size, embedding_size) at least.
+constexpr size_t kEmbeddingTableDims = 2;
 
 void Worker::Run() {
   std::lock_guard<std::mutex> lock(running_mutex_);
@@ -251,6 +253,7 @@ bool Worker::InitPSEmbeddingTable(const size_t &key, const std::vector<size_t> &
     std::this_thread::sleep_for(std::chrono::milliseconds(kRetryDuration));
   }
 
+  InitEmbeddingHostCache(key, input_shape);
   return true;
 }
 
@@ -296,6 +299,120 @@ void Worker::InitPSParamAndOptim(const AnfNodePtr &input_node, const tensor::Ten
 bool Worker::DoPSEmbeddingLookup(const Key &key, const std::vector<int> &lookup_ids, std::vector<float> *lookup_result,
                                  int64_t cmd) {
   MS_EXCEPTION_IF_NULL(lookup_result);
+  if (cmd == kEmbeddingLookupCmd && !lookup_ids.empty()) {
+    auto cache = GetEmbeddingHostCache(key);
+    if (cache != nullptr && lookup_result->size() == lookup_ids.size() * cache->embedding_size()) {
+      return LookupEmbeddingWithCache(key, lookup_ids, lookup_result, cache);
+    }
+  }
+  return LookupEmbeddingFromServer(key, lookup_ids, lookup_result, cmd);
+}
+
+bool Worker::UpdateEmbeddingTable(const std::vector<Key> &keys, const std::vector<int> &lookup_ids,
+                                  const std::vector<float> &vals) {
+  if (!UpdateEmbeddingToServer(keys, lookup_ids, vals)) {
+    return false;
+  }
+  // The rows are written through to the server, so that the other workers see them at once. Only the read side is
+  // cached, with the values just sent.
+  if (keys.size() == 1) {
+    auto cache = GetEmbeddingHostCache(keys[0]);
+    if (cache != nullptr && vals.size() == lookup_ids.size() * cache->embedding_size()) {
+      cache->Insert(lookup_ids, vals.data());
+    }
+  }
+  return true;
+}
+
+void Worker::InitEmbeddingHostCache(const Key &key, const std::vector<size_t> &input_shape) {
+  auto context = PSContext::instance();
+  MS_EXCEPTION_IF_NULL(context);
+  size_t cache_size = context->embedding_cache_size();
+  if (cache_size == 0 || input_shape.size() < kEmbeddingTableDims) {
+    return;
+  }
+  size_t embedding_size =
+    std::accumulate(input_shape.begin() + 1, input_shape.end(), static_cast<size_t>(1), std::multiplies<size_t>());
+  if (embedding_size == 0) {
+    return;
+  }
+  auto write_back = [this, key](const std::vector<int> &ids, const std::vector<float> &values) {
+    return UpdateEmbeddingToServer({key}, ids, values);
+  };
+  auto cache =
+    std::make_shared<EmbeddingHostCache>(cache_size, embedding_size, context->embedding_cache_staleness(),
+                                         CreateEmbeddingCachePolicy(context->embedding_cache_policy()), write_back);
+  std::lock_guard<std::mutex> lock(embedding_cache_mutex_);
+  embedding_caches_[key] = cache;
+  MS_LOG(INFO) << "The host embedding cache of key " << key << " is created, size: " << cache_size
+               << ", policy: " << context->embedding_cache_policy()
+               << ", staleness: " << context->embedding_cache_staleness();
+}
+
+std::shared_ptr<EmbeddingHostCache> Worker::GetEmbeddingHostCache(const Key &key) {
+  std::lock_guard<std::mutex> lock(embedding_cache_mutex_);
+  auto iter = embedding_caches_.find(key);
+  return iter == embedding_caches_.end() ? nullptr : iter->second;
+}
+
+void Worker::FlushEmbeddingHostCaches() {
+  std::lock_guard<std::mutex> lock(embedding_cache_mutex_);
+  for (const auto &item : embedding_caches_) {
+    const auto &cache = item.second;
+    MS_EXCEPTION_IF_NULL(cache);
+    if (!cache->Flush()) {
+      MS_LOG(WARNING) << "Writing back the host embedding cache of key " << item.first << " failed.";
+    }
+    MS_LOG(INFO) << "The host embedding cache of key " << item.first << " hit rate: " << cache->hit_rate()
+                 << ", hits: " << cache->hit_count() << ", misses: " << cache->miss_count()
+                 << ", evictions: " << cache->eviction_count() << ", write-backs: " << cache->write_back_count();
+  }
+}
+
+bool Worker::LookupEmbeddingWithCache(const Key &key, const std::vector<int> &lookup_ids,
+                                      std::vector<float> *lookup_result,
+                                      const std::shared_ptr<EmbeddingHostCache> &cache) {
+  MS_EXCEPTION_IF_NULL(lookup_result);
+  MS_EXCEPTION_IF_NULL(cache);
+  cache->NextStep();
+  std::vector<size_t> miss_positions;
+  cache->Lookup(lookup_ids.data(), lookup_ids.size(), lookup_result->data(), &miss_positions);
+  if (miss_positions.empty()) {
+    return true;
+  }
+
+  // Fetch the distinct missed ids from the server in one request.
+  std::vector<int> miss_ids;
+  luojianet_ms::HashMap<int, size_t> miss_id_index;
+  for (auto pos : miss_positions) {
+    int id = lookup_ids[pos];
+    if (miss_id_index.count(id) == 0) {
+      miss_id_index[id] = miss_ids.size();
+      miss_ids.push_back(id);
+    }
+  }
+  size_t embedding_size = cache->embedding_size();
+  std::vector<float> miss_result(miss_ids.size() * embedding_size, 0);
+  if (!LookupEmbeddingFromServer(key, miss_ids, &miss_result, kEmbeddingLookupCmd)) {
+    return false;
+  }
+  cache->Insert(miss_ids, miss_result.data());
+
+  for (auto pos : miss_positions) {
+    size_t index = miss_id_index[lookup_ids[pos]];
+    auto ret = memcpy_s(lookup_result->data() + pos * embedding_size, embedding_size * sizeof(float),
+                        miss_result.data() + index * embedding_size, embedding_size * sizeof(float));
+    if (ret != 0) {
+      MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")";
+      return false;
+    }
+  }
+  return true;
+}
+
+bool Worker::LookupEmbeddingFromServer(const Key &key, const std::vector<int> &lookup_ids,
+                                       std::vector<float> *lookup_result, int64_t cmd) {
+  MS_EXCEPTION_IF_NULL(lookup_result);
   EmbeddingTableLookup embedding_table_lookup;
   embedding_table_lookup.set_key(key);
   *embedding_table_lookup.mutable_keys() = {lookup_ids.begin(), lookup_ids.end()};
@@ -390,8 +507,8 @@ bool Worker::DoPSEmbeddingLookup(const Key &key, const std::vector<int> &lookup_
   return true;
 }
 
-bool Worker::UpdateEmbeddingTable(const std::vector<Key> &keys, const std::vector<int> &lookup_ids,
-                                  const std::vector<float> &vals) {
+bool Worker::UpdateEmbeddingToServer(const std::vector<Key> &keys, const std::vector<int> &lookup_ids,
+                                     const std::vector<float> &vals) {
   KVMessage kvs;
   *kvs.mutable_keys() = {keys.begin(), keys.end()};
   *kvs.mutable_len() = {lookup_ids.begin(), lookup_ids.end()};
@@ -437,6 +554,7 @@ bool Worker::UpdateEmbeddingTable(const std::vector<Key> &keys, const std::vecto
 void Worker::Finalize() {
   if (running_) {
     MS_LOG(INFO) << "Worker starts finalizing...";
+    FlushEmbeddingHostCaches();
     KVMessage kvs;
     kvs.add_keys(0);
     kvs.add_values(0.0f);
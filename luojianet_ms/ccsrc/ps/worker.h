@@ -36,6 +36,7 @@
 #include "ps/constants.h"
 #include "utils/shape_utils.h"
 #include "ps/ps_cache/ps_data/ps_data_prefetch.h"
+#include "ps/ps_cache/embedding_host_cache.h"
 #include "ps/core/worker_node.h"
 #include "ps/embedding_table_shard_metadata.h"
 #include "proto/comm.pb.h"
@@ -109,6 +110,18 @@ class Worker {
   void PullData(const std::vector<Key> &keys, std::vector<float> *const vals, std::vector<int> *lens = nullptr,
                 int cmd = 0, int64_t priority = 0);
 
+  // Create the host embedding cache of the table if it's enabled in PSContext.
+  void InitEmbeddingHostCache(const Key &key, const std::vector<size_t> &input_shape);
+  std::shared_ptr<EmbeddingHostCache> GetEmbeddingHostCache(const Key &key);
+  // Write back the rows updated in the host embedding caches before finalizing.
+  void FlushEmbeddingHostCaches();
+  bool LookupEmbeddingWithCache(const Key &key, const std::vector<int> &lookup_ids, std::vector<float> *lookup_result,
+                                const std::shared_ptr<EmbeddingHostCache> &cache);
+  bool LookupEmbeddingFromServer(const Key &key, const std::vector<int> &lookup_ids, std::vector<float> *lookup_result,
+                                 int64_t cmd);
+  bool UpdateEmbeddingToServer(const std::vector<Key> &keys, const std::vector<int> &lookup_ids,
+                               const std::vector<float> &vals);
+
   void LookupIdPartitioner(const EmbeddingTableLookup &send, PartitionEmbeddingMessages *partition,
                            const std::map<int64_t, int64_t> &attrs);
 
@@ -148,6 +161,10 @@ class Worker {
   luojianet_ms::HashMap<Key, size_t> embedding_row_cnt_;
 
   luojianet_ms::HashMap<Key, std::shared_ptr<std::vector<EmbeddingTableShardMetadata>>> embedding_table_ranges_;
+
+  // The host embedding caches of the embedding tables in front of the servers.
+  std::mutex embedding_cache_mutex_;
+  luojianet_ms::HashMap<Key, std::shared_ptr<EmbeddingHostCache>> embedding_caches_;
 };
 }  // namespace ps
 }  // namespace luojianet_ms
@@ -0,0 +1,53 @@
+/**
+ * Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+ * Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "utils/checkpoint_file.h"
+#include "pybind11/stl.h"
+#include "pybind_api/api_register.h"
+
+namespace luojianet_ms {
+namespace py = pybind11;
+
+REGISTER_PYBIND_DEFINE(CheckpointReader_, ([](const py::module *m) {
+                         (void)m->def(
+                           "_save_checkpoint_file",
+                           [](const std::string &file_name, const std::vector<std::string> &names,
+                              const std::vector<tensor::TensorPtr> &tensors) {
+                             py::gil_scoped_release gil_release;
+                             SaveCheckpointFile(file_name, names, tensors);
+                           },
+                           "Save the tensors into the native checkpoint file.");
+                         (void)m->def("_is_native_checkpoint_file", &IsNativeCheckpointFile,
+                                      "Whether the file is a native checkpoint file.");
+                         (void)m->def(
+                           "_hash_tensors",
+                           [](const std::vector<tensor::TensorPtr> &tensors) {
+                             py::gil_scoped_release gil_release;
+                             return HashTensors(tensors);
+                           },
+                           "Compute the content hashes of the tensors.");
+                         (void)py::class_<CheckpointReader, std::shared_ptr<CheckpointReader>>(*m, "CheckpointReader_")
+                           .def(py::init<const std::string &>())
+                           .def("names", &CheckpointReader::names)
+                           .def("get_dtype", &CheckpointReader::GetDtype)
+                           .def("get_shape", &CheckpointReader::GetShape)
+                           .def("get_tensor", &CheckpointReader::GetTensor);
+                       }));
+}  // namespace luojianet_ms
@@ -20,7 +20,7 @@
 #include "runtime/device/convert_tensor_utils.h"
 #include "runtime/hardware/cpu/cpu_memory_pool.h"
 #ifndef ENABLE_SECURITY
-#include "debug/data_dump/dump_json_parser.h"
+#include "debug/data_dump/e2e_dump_writer.h"
 #endif
 
 namespace luojianet_ms {
@@ -48,7 +48,7 @@ bool CPUDeviceAddress::DumpMemToFile(const std::string &filepath, const std::str
   }
   std::string path = filepath + '.' + format_;
   MS_LOG(DEBUG) << "E2E Dump path is " << path;
-  ret = DumpJsonParser::DumpToFile(path, ptr_, size_, host_shape, host_type);
+  ret = E2eDumpWriter::GetInstance().DumpToFile(path, ptr_, size_, host_shape, host_type);
 #endif
   return ret;
 }
@@ -143,6 +143,17 @@ bool CPUDeviceAddress::SyncHostToDevice(const ShapeVector &, size_t size, TypeId
   }
   return true;
 }
+
+bool CPUDeviceAddress::SyncDeviceToDevice(const DeviceSync *src_device_addr) const {
+  MS_EXCEPTION_IF_NULL(src_device_addr);
+  auto src_address = dynamic_cast<const CPUDeviceAddress *>(src_device_addr);
+  if (src_address == nullptr) {
+    MS_LOG(ERROR) << "The source device address is not a cpu device address.";
+    return false;
+  }
+  // The source memory is host memory, so copy it as the host data of this address.
+  return src_address->SyncDeviceToHost(ShapeVector(), size_, type_id_, ptr_);
+}
 }  // namespace cpu
 }  // namespace device
 }  // namespace luojianet_ms
@@ -36,6 +36,7 @@
 #include "utils/profile.h"
 #include "utils/trace_base.h"
 #include "debug/data_dump/cpu_e2e_dump.h"
+#include "debug/data_dump/e2e_dump_writer.h"
 #include "debug/env_config_parser.h"
 #ifdef MEM_REUSE_DEBUG
 #include "backend/optimizer/mem_reuse/mem_reuse_checker.h"
@@ -504,6 +505,9 @@ bool CPUKernelRuntime::Run(const session::KernelGraph &kernel_graph, bool) {
     CPUE2eDump::DumpParameters(&kernel_graph, graph_id);
     CPUE2eDump::DumpConstants(&kernel_graph, graph_id);
   }
+  if (dump_json_parser.e2e_dump_enabled() && !E2eDumpWriter::GetInstance().Flush()) {
+    MS_LOG(EXCEPTION) << "Save the e2e dump files of graph " << graph_id << " failed.";
+  }
   if (graph_id == 0) {
     dump_json_parser.UpdateDumpIter();
   }
@@ -46,7 +46,9 @@ void MemoryManager::MallocSomasDynamicMem(const session::KernelGraph &graph) {
   }
 
   size_t total_allocated_size = somas_reuse_util_ptr->GetTotalMemSize();
-  MS_LOG(INFO) << "Graph " << graph.graph_id() << ": TotalSomasReuseDynamicSize [" << total_allocated_size << "]";
+  MS_LOG(INFO) << "Graph " << graph.graph_id() << ": TotalSomasReuseDynamicSize [" << total_allocated_size
+               << "], LowerBound [" << somas_reuse_util_ptr->GetLowerBound() << "], UpperBound ["
+               << somas_reuse_util_ptr->GetUpperBound() << "]";
   if (total_allocated_size > 0) {
     auto base_ptr = MallocDynamicMem(total_allocated_size, false);
     MS_LOG(INFO) << "Somas Reuse Memory Base Address [" << static_cast<void *>(base_ptr) << "], End Address ["
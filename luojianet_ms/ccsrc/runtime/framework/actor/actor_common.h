@@ -148,6 +148,7 @@ class ActorDispatcher {
   static void is_multi_thread_execution(bool is_multi_thread_execution) {
     is_multi_thread_execution_ = is_multi_thread_execution;
   }
+  static bool is_multi_thread_execution() { return is_multi_thread_execution_; }
 
   // The first five executions are for warm-up, the next five executions are statistics of multi thread execution time,
   // and the next next five executions are statistics of single thread execution time.
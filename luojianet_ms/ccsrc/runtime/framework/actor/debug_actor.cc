@@ -25,6 +25,7 @@
 #ifndef ENABLE_SECURITY
 #include "debug/data_dump/cpu_e2e_dump.h"
 #include "debug/data_dump/e2e_dump.h"
+#include "debug/data_dump/e2e_dump_writer.h"
 #endif
 #ifdef ENABLE_DEBUGGER
 #include "debug/debugger/debugger.h"
@@ -150,6 +151,10 @@ void DebugActor::DebugOnStepEnd(OpContext<DeviceTensor> *const op_context, const
     CPUE2eDump::DumpParametersData();
     CPUE2eDump::DumpConstantsData();
   }
+  if (DumpJsonParser::GetInstance().e2e_dump_enabled() && !E2eDumpWriter::GetInstance().Flush()) {
+    std::string error_info = "Save the e2e dump files failed.";
+    SET_OPCONTEXT_FAIL_RET_WITH_ERROR((*op_context), error_info);
+  }
 #endif
 
 #ifdef ENABLE_DEBUGGER
@@ -20,11 +20,38 @@
 #include "runtime/framework/actor/output_actor.h"
 #include "runtime/framework/actor/recorder_actor.h"
 #include "runtime/framework/actor/debug_actor.h"
+#include "mindrt/src/actor/actormgr.h"
 #include "mindrt/include/async/async.h"
 #include "utils/log_adapter.h"
 
 namespace luojianet_ms {
 namespace runtime {
+namespace {
+// Limit the kernel threads used by the cpu kernel launched in the current actor thread during the guard lifetime.
+class WorkerRangeGuard {
+ public:
+  WorkerRangeGuard(int begin, int end) {
+    // The single thread execution runs all the actors in one thread, and the kernels never run in parallel.
+    if (begin < 0 || !ActorDispatcher::is_multi_thread_execution()) {
+      return;
+    }
+    MS_EXCEPTION_IF_NULL(ActorMgr::GetActorMgrRef());
+    thread_pool_ = ActorMgr::GetActorMgrRef()->GetActorThreadPool();
+    if (thread_pool_ != nullptr) {
+      thread_pool_->SetWorkerRangeOfCurrentThread(begin, end);
+    }
+  }
+  ~WorkerRangeGuard() {
+    if (thread_pool_ != nullptr) {
+      thread_pool_->SetWorkerRangeOfCurrentThread(-1, -1);
+    }
+  }
+
+ private:
+  ActorThreadPool *thread_pool_{nullptr};
+};
+}  // namespace
+
 void KernelActor::Init() {
   // Check device contexts number.
   if (device_contexts_.size() != device::kDeviceContextsNumOne) {
@@ -193,6 +220,7 @@ void KernelActor::OnMemoryAllocFinish(OpContext<DeviceTensor> *const context) {
   PreLaunchKernel(context);
 
   try {
+    WorkerRangeGuard worker_range_guard(worker_begin_, worker_end_);
     auto ret = device_contexts_[0]->LaunchKernel(kernel_, launch_info_.inputs_, launch_info_.workspaces_,
                                                  launch_info_.outputs_, is_dynamic_shape_);
     if (!ret) {
@@ -75,6 +75,10 @@ class KernelActor : public DebugAwareActor {
   void OnDebugFinish(OpContext<DeviceTensor> *const context) override;
 
   const CNodePtr &kernel() const { return kernel_; }
+  void set_worker_range(int begin, int end) {
+    worker_begin_ = begin;
+    worker_end_ = end;
+  }
 
  protected:
   void Run(OpContext<DeviceTensor> *const context) override;
@@ -134,6 +138,11 @@ class KernelActor : public DebugAwareActor {
 
   // Cache output data by output index to modify the output data effectively.
   std::vector<std::vector<OpData<DeviceTensor> *>> output_data_by_output_index_;
+
+  // The kernel threads [worker_begin_, worker_end_) assigned by the scheduler to the cpu kernel launch, when the
+  // kernel may run together with the kernels of other branches. The negative value means using all kernel threads.
+  int worker_begin_{-1};
+  int worker_end_{-1};
 };
 
 using KernelActorPtr = std::shared_ptr<KernelActor>;
@@ -219,6 +219,9 @@ void CreateKernelWorkspaceDeviceAddress(const DeviceContext *device_context, con
     MS_EXCEPTION_IF_NULL(kernel_mod);
     auto workspace_sizes = kernel_mod->GetWorkspaceSizeList();
     for (size_t i = 0; i < workspace_sizes.size(); ++i) {
+      if (AnfAlgo::WorkspaceAddrExist(kernel, i)) {
+        continue;
+      }
       auto device_address = device_context->CreateDeviceAddress(nullptr, workspace_sizes[i], "", kTypeUnknown);
       MS_LOG(DEBUG) << "Create addr for node:" << AnfAlgo::GetNodeDebugString(kernel) << " addr:" << device_address;
       AnfAlgo::SetWorkspaceAddr(device_address, i, kernel.get());
@@ -571,6 +574,9 @@ void GraphCompiler::CreateDeviceAddress(const KernelGraphPtr &graph, const Devic
                                         bool is_gradient_out) const {
   CreateParameterDeviceAddress(device_context, graph);
   CreateValueNodeDeviceAddress(device_context, graph);
+  if (graph->is_executing_sink()) {
+    device_context->PlanGraphMemory(graph);
+  }
   CreateKernelOutputDeviceAddress(device_context, graph, is_gradient_out);
   CreateKernelWorkspaceDeviceAddress(device_context, graph);
   UpdateDeviceAddressForInplaceNode(graph);
@@ -16,6 +16,9 @@
  */
 
 #include "runtime/framework/graph_scheduler.h"
+#include <cmath>
+#include <functional>
+#include <numeric>
 #include "runtime/framework/actor/memory_manager_actor.h"
 #include "runtime/framework/actor/debug_actor.h"
 #include "runtime/framework/actor/recorder_actor.h"
@@ -167,6 +170,143 @@ void ClearNodeInfo(const KernelGraphPtr &graph) {
   }
 }
 
+// The cpu kernels cheaper than this are not worth owning a part of the kernel threads.
+constexpr size_t kPartitionKernelMinCost = 1 << 18;
+
+size_t ShapeSize(const std::vector<size_t> &shape) {
+  return std::accumulate(shape.begin(), shape.end(), static_cast<size_t>(1), std::multiplies<size_t>());
+}
+
+size_t MatrixSize(const std::vector<size_t> &shape) {
+  const size_t kMatrixDimNum = 2;
+  if (shape.size() < kMatrixDimNum) {
+    return ShapeSize(shape);
+  }
+  return shape[shape.size() - 1] * shape[shape.size() - kMatrixDimNum];
+}
+
+// Estimate the cost of cpu kernel by the multiply-accumulates of matmul and convolution, and by the output elements
+// number of the others.
+size_t EstimateKernelCost(const CNodePtr &kernel) {
+  MS_EXCEPTION_IF_NULL(kernel);
+  const size_t kWeightInputNum = 2;
+  if (AnfAlgo::IsDynamicShape(kernel) || (AnfAlgo::GetOutputTensorNum(kernel) == 0)) {
+    return 0;
+  }
+  const auto &output_shape = AnfAlgo::GetOutputInferShape(kernel, 0);
+  auto output_size = ShapeSize(output_shape);
+  if (AnfAlgo::GetInputTensorNum(kernel) < kWeightInputNum) {
+    return output_size;
+  }
+
+  const auto &kernel_name = AnfAlgo::GetCNodeName(kernel);
+  if ((kernel_name == kMatMulOpName) || (kernel_name == kBatchMatMulOpName)) {
+    // The matrices of inputs and output are m*k, k*n and m*n whether transposed or not.
+    auto output_matrix_size = MatrixSize(output_shape);
+    if (output_matrix_size == 0) {
+      return 0;
+    }
+    auto square_depth = static_cast<double>(MatrixSize(AnfAlgo::GetPrevNodeOutputInferShape(kernel, 0))) *
+                        MatrixSize(AnfAlgo::GetPrevNodeOutputInferShape(kernel, 1)) / output_matrix_size;
+    return output_size * static_cast<size_t>(std::sqrt(square_depth));
+  }
+
+  // The weight of convolution is [out_channel, in_channel / group, kernel_h, kernel_w], and every element with the out
+  // channel dim takes the multiply-accumulates of weight size / out_channel.
+  std::vector<size_t> channel_shape;
+  std::vector<size_t> weight_shape;
+  if (kernel_name == kConv2DOpName) {
+    channel_shape = output_shape;
+    weight_shape = AnfAlgo::GetPrevNodeOutputInferShape(kernel, 1);
+  } else if (kernel_name == kConv2DBackpropInputOpName) {
+    channel_shape = AnfAlgo::GetPrevNodeOutputInferShape(kernel, 0);
+    weight_shape = AnfAlgo::GetPrevNodeOutputInferShape(kernel, 1);
+  } else if (kernel_name == kConv2DBackpropFilterOpName) {
+    channel_shape = AnfAlgo::GetPrevNodeOutputInferShape(kernel, 0);
+    weight_shape = output_shape;
+  }
+  if (weight_shape.empty() || (weight_shape[0] == 0)) {
+    return output_size;
+  }
+  return ShapeSize(channel_shape) * (ShapeSize(weight_shape) / weight_shape[0]);
+}
+
+// Assign the disjoint kernel threads to the heavy cpu kernels which may run at the same time. The kernels in the same
+// depth of graph never depend on each other, so their actors can be ready together, such as the parallel branches of
+// network and the input and weight gradients of convolution. Every heavy kernel of the depth takes the kernel threads
+// in proportion to its cost, and its actor thread runs one part of the kernel too. The depth is a static estimate, so
+// kernels which don't actually run together may get fewer threads, and the partition is enabled only by setting the
+// environment variable MS_DEV_CPU_KERNEL_PARTITION=1.
+void PartitionKernelThreads(const KernelGraphPtr &graph, const std::vector<KernelActorPtr> &kernel_actors) {
+  MS_EXCEPTION_IF_NULL(graph);
+  if (common::GetEnv("MS_DEV_CPU_KERNEL_PARTITION") != "1") {
+    return;
+  }
+  MS_EXCEPTION_IF_NULL(ActorMgr::GetActorMgrRef());
+  auto thread_pool = ActorMgr::GetActorMgrRef()->GetActorThreadPool();
+  if (thread_pool == nullptr || thread_pool->GetKernelThreadNum() < 1) {
+    return;
+  }
+  auto kernel_thread_num = thread_pool->GetKernelThreadNum();
+
+  // The depth of kernel is the longest path from graph inputs, which passes the kernels without actor too.
+  luojianet_ms::HashMap<AnfNodePtr, size_t> kernel_depths;
+  for (const auto &kernel : graph->execution_order()) {
+    MS_EXCEPTION_IF_NULL(kernel);
+    size_t depth = 0;
+    for (size_t i = 0; i < AnfAlgo::GetInputTensorNum(kernel); ++i) {
+      const auto &input_node = AnfAlgo::GetPrevNodeOutput(kernel, i, true).first;
+      const auto &iter = kernel_depths.find(input_node);
+      if (iter != kernel_depths.end()) {
+        depth = std::max(depth, iter->second + 1);
+      }
+    }
+    kernel_depths[kernel] = depth;
+  }
+
+  std::map<size_t, std::vector<std::pair<size_t, KernelActor *>>> heavy_actors_by_depth;
+  for (const auto &kernel_actor : kernel_actors) {
+    MS_EXCEPTION_IF_NULL(kernel_actor);
+    auto cost = EstimateKernelCost(kernel_actor->kernel());
+    if (cost >= kPartitionKernelMinCost) {
+      (void)heavy_actors_by_depth[kernel_depths[kernel_actor->kernel()]].emplace_back(cost, kernel_actor.get());
+    }
+  }
+
+  for (auto &depth_actors : heavy_actors_by_depth) {
+    auto &heavy_actors = depth_actors.second;
+    if (heavy_actors.size() < 2) {
+      continue;
+    }
+    std::sort(heavy_actors.begin(), heavy_actors.end(),
+              [](const auto &lhs, const auto &rhs) { return lhs.first > rhs.first; });
+    double total_cost = 0;
+    for (const auto &heavy_actor : heavy_actors) {
+      total_cost += heavy_actor.first;
+    }
+    // The threads left by rounding down belong to the most costly kernel.
+    std::vector<size_t> thread_nums;
+    size_t assigned_num = 0;
+    for (const auto &heavy_actor : heavy_actors) {
+      auto thread_num = static_cast<size_t>(kernel_thread_num * (heavy_actor.first / total_cost));
+      (void)thread_nums.emplace_back(thread_num);
+      assigned_num += thread_num;
+    }
+    thread_nums[0] += kernel_thread_num - assigned_num;
+
+    size_t begin = 0;
+    for (size_t i = 0; i < heavy_actors.size(); ++i) {
+      auto kernel_actor = heavy_actors[i].second;
+      auto end = begin + thread_nums[i];
+      kernel_actor->set_worker_range(SizeToInt(begin), SizeToInt(end));
+      MS_LOG(INFO) << "The kernel actor: " << kernel_actor->GetAID().Name() << " of depth: " << depth_actors.first
+                   << " with cost: " << heavy_actors[i].first << " uses the kernel threads [" << begin << ", " << end
+                   << ").";
+      begin = end;
+    }
+  }
+}
+
 #if !defined(_WIN32) && !defined(_WIN64)
 void IntHandler(int, siginfo_t *, void *) {
   int this_pid = getpid();
@@ -376,6 +516,18 @@ void GraphScheduler::Run(ActorSet *const actor_set, const std::vector<DeviceCont
     thread_pool->SetSpinCountMaxValue();
   }
   ActorDispatcher::is_multi_thread_execution(actor_set->is_multi_thread_execution_);
+  // The memory peak of the first step is measured above the memory in use before it, such as the weights and the
+  // memory planned at compiling.
+  std::map<DeviceContext *, size_t> used_mem_before_first_step;
+  if (actor_set->execution_count_ == 0) {
+    for (auto &device_context : device_contexts) {
+      MS_EXCEPTION_IF_NULL(device_context);
+      if (used_mem_before_first_step.count(device_context) == 0) {
+        used_mem_before_first_step[device_context] = device_context->UsedMemStatistics();
+        device_context->ResetUsedMemPeakStatistics();
+      }
+    }
+  }
   double start_time = GetTime();
   ActorDispatcher::Send(actor_set->data_prepare_actor_->GetAID(), &DataPrepareActor::PrepareData, input_tensors,
                         &op_context);
@@ -412,6 +564,16 @@ void GraphScheduler::Run(ActorSet *const actor_set, const std::vector<DeviceCont
     }
   }
 
+  for (const auto &used_mem : used_mem_before_first_step) {
+    auto used_mem_peak = used_mem.first->UsedMemPeakStatistics();
+    if (used_mem_peak > 0) {
+      auto step_mem_peak = used_mem_peak > used_mem.second ? used_mem_peak - used_mem.second : 0;
+      MS_LOG(INFO) << "Actor set " << actor_set->name_ << " takes a measured memory peak of " << step_mem_peak
+                   << " bytes on " << used_mem.first->device_context_key().ToString() << " above the "
+                   << used_mem.second << " bytes in use before its first step.";
+    }
+  }
+
   double end_time = GetTime();
   const size_t kSecondsToMilliseconds = 1000;
   SetActorExecutionStrategy(actor_set, strategy, (end_time - start_time) * kSecondsToMilliseconds);
@@ -702,6 +864,7 @@ std::vector<KernelActorPtr> GraphScheduler::BuildKernelActor(const GraphCompiler
       strategy = (is_single_op_graph ? strategy : GraphExecutionStrategy::kPipeline);
     }
 
+    std::vector<KernelActorPtr> graph_kernel_actors;
     for (auto &kernel : execution_order) {
       MS_EXCEPTION_IF_NULL(kernel);
       if (IsKernelActor(kernel, graph_compiler_info.strategy_) && (!IsSkippedKernelActor(kernel))) {
@@ -709,9 +872,17 @@ std::vector<KernelActorPtr> GraphScheduler::BuildKernelActor(const GraphCompiler
                                                           memory_manager_aid_, debug_aid_, recorder_aid_, strategy);
         MS_EXCEPTION_IF_NULL(kernel_actor);
         InsertActor(kernel_actor.get());
-        (void)kernel_actors.emplace_back(kernel_actor);
+        (void)graph_kernel_actors.emplace_back(kernel_actor);
       }
     }
+
+    // The cpu kernels share the kernel threads of actor runtime.
+    MS_EXCEPTION_IF_NULL(device_context);
+    if ((strategy == GraphExecutionStrategy::kPipeline) &&
+        (device_context->GetDeviceAddressType() == device::DeviceAddressType::kCPU)) {
+      PartitionKernelThreads(graph, graph_kernel_actors);
+    }
+    (void)kernel_actors.insert(kernel_actors.end(), graph_kernel_actors.begin(), graph_kernel_actors.end());
   }
   return kernel_actors;
 }
@@ -16,6 +16,7 @@
  */
 
 #include "runtime/hardware/cpu/cpu_device_context.h"
+#include <algorithm>
 #include <string>
 #include "runtime/device/cpu/cpu_device_address.h"
 #include "runtime/device/cpu/cpu_memory_manager.h"
@@ -34,7 +35,14 @@
 #include "backend/optimizer/pass/erase_visit_attr.h"
 #include "backend/optimizer/graph_kernel/graph_kernel_optimization.h"
 #include "backend/session/anf_runtime_algorithm.h"
+#include "backend/optimizer/somas/somas.h"
+#include "common/trans.h"
+#include "debug/env_config_parser.h"
+#ifndef ENABLE_SECURITY
+#include "debug/data_dump/e2e_dump_writer.h"
+#endif
 #include "profiler/device/cpu/cpu_profiling.h"
+#include "utils/ms_utils.h"
 #if ((defined ENABLE_CPU) && (!defined _WIN32))
 #include "runtime/hardware/cpu/ms_collective_comm_lib.h"
 #endif
@@ -76,11 +84,16 @@ void CPUDeviceContext::Initialize() {
 }
 
 void CPUDeviceContext::Destroy() {
+#ifndef ENABLE_SECURITY
+  // Save the dump files still in flight
+  (void)E2eDumpWriter::GetInstance().Flush();
+#endif
   // Release memory.
   if (mem_manager_ != nullptr) {
     mem_manager_->FreeDeviceMemory();
     mem_manager_ = nullptr;
   }
+  graph_mem_arenas_.clear();
 }
 
 bool CPUDeviceContext::AllocateMemory(DeviceAddress *const &address, size_t size) const {
@@ -115,6 +128,12 @@ void CPUDeviceContext::FreeMemory(DeviceAddress *const &address) const {
   address->ptr_ = nullptr;
 }
 
+size_t CPUDeviceContext::UsedMemStatistics() const { return CPUMemoryPool::GetInstance().TotalUsedMemStatistics(); }
+
+size_t CPUDeviceContext::UsedMemPeakStatistics() const { return CPUMemoryPool::GetInstance().UsedMemPeakStatistics(); }
+
+void CPUDeviceContext::ResetUsedMemPeakStatistics() const { CPUMemoryPool::GetInstance().ResetUsedMemPeakStatistics(); }
+
 DeviceAddressPtr CPUDeviceContext::CreateDeviceAddress(void *const device_ptr, size_t device_size, const string &format,
                                                        TypeId type_id) const {
   return std::make_shared<CPUDeviceAddress>(device_ptr, device_size, format, type_id, device_context_key_.device_name_,
@@ -259,12 +278,185 @@ void CPUDeviceContext::UpdateDynamicShape(const CNodePtr &kernel) const {
   dynamic_kernel->UpdateArgs();
 }
 
+namespace {
+// The somas plan reuses memory by the lifetimes in execution order, so the planned graph is launched kernel by kernel
+// in that order instead of by the kernel actors. It is enabled by MS_DEV_CPU_SOMAS=1 in graph mode.
+bool IsSomasPlanEnabled() {
+  auto ms_context = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(ms_context);
+  if (ms_context->get_param<int>(MS_CTX_EXECUTION_MODE) != kGraphMode || common::GetEnv("MS_DEV_CPU_SOMAS") != "1") {
+    return false;
+  }
+  if (!EnvConfigParser::GetInstance().GetSysMemreuse()) {
+    return false;
+  }
+#ifndef ENABLE_SECURITY
+  // The e2e dump needs the outputs of every kernel alive after the step.
+  if (DumpJsonParser::GetInstance().e2e_dump_enabled()) {
+    return false;
+  }
+#endif
+  return true;
+}
+
+bool IsSomasPlanSupported(const KernelGraphPtr &graph) {
+  MS_EXCEPTION_IF_NULL(graph);
+  if (graph->is_dynamic_shape()) {
+    return false;
+  }
+  const auto &kernels = graph->execution_order();
+  return std::none_of(kernels.begin(), kernels.end(), [](const CNodePtr &kernel) {
+    return AnfAlgo::IsControlOpExecInBackend(kernel) || AnfAlgo::IsDynamicShape(kernel) ||
+           AnfAlgo::GetCNodeName(kernel) == kGetNextOpName;
+  });
+}
+
+kernel::AddressPtr FetchLaunchAddress(const DeviceAddress *device_address) {
+  MS_EXCEPTION_IF_NULL(device_address);
+  if (device_address->GetPtr() == nullptr && device_address->GetSize() != 0) {
+    MS_LOG(EXCEPTION) << "The device address of planned graph has no memory, size: " << device_address->GetSize();
+  }
+  return std::make_shared<kernel::Address>(const_cast<void *>(device_address->GetPtr()), device_address->GetSize());
+}
+}  // namespace
+
 void CPUDeviceContext::PreprocessBeforeRunGraph(const KernelGraphPtr &graph) const {
   MS_EXCEPTION_IF_NULL(graph);
   // Remove reorder after PS feature finish adapting push/pull in auto_monad.
   auto execution_order = graph->execution_order();
   AnfAlgo::ReorderPosteriorExecList(NOT_NULL(&execution_order));
   graph->set_execution_order(execution_order);
+
+  if (graph->is_executing_sink() && !IsSomasPlanSupported(graph)) {
+    MS_LOG(INFO) << "The memory of graph " << graph->graph_id() << " can't be planned, it runs by kernel actors.";
+    graph->set_is_executing_sink(false);
+  }
+}
+
+bool CPUDeviceContext::IsExecutingSink(const KernelGraphPtr &) const { return IsSomasPlanEnabled(); }
+
+void CPUDeviceContext::PlanGraphMemory(const KernelGraphPtr &graph) const {
+  MS_EXCEPTION_IF_NULL(graph);
+  MS_EXCEPTION_IF_NULL(mem_manager_);
+  // The graph outputs are handed over to the output tensors after each step, so they stay out of the arena and
+  // 'LaunchGraph' allocates them from the memory pool.
+  auto graph_outputs = AnfAlgo::GetAllOutput(graph->output(), {prim::kPrimTupleGetItem});
+  for (const auto &graph_output : graph_outputs) {
+    auto output_with_index = AnfAlgo::VisitKernelWithReturnType(graph_output, 0, true);
+    const auto &output_node = output_with_index.first;
+    auto index = output_with_index.second;
+    MS_EXCEPTION_IF_NULL(output_node);
+    if (!output_node->isa<CNode>() || !AnfUtils::IsRealKernel(output_node) ||
+        AnfAlgo::OutputAddrExist(output_node, index)) {
+      continue;
+    }
+    auto output_format = AnfAlgo::GetOutputFormat(output_node, index);
+    auto output_type = AnfAlgo::GetOutputDeviceDataType(output_node, index);
+    auto device_address =
+      CreateDeviceAddress(nullptr, AnfAlgo::GetOutputTensorMemSize(output_node, index), output_format, output_type);
+    device_address->set_host_shape(trans::GetRuntimePaddingShape(output_node, index));
+    AnfAlgo::SetOutputAddr(device_address, index, output_node.get());
+  }
+
+  auto somas_plan = std::make_shared<somas::Somas>();
+  if (!somas_plan->Allocate(graph.get())) {
+    MS_LOG(EXCEPTION) << "Somas allocate failed, graph id: " << graph->graph_id();
+  }
+
+  // The graph compiled again releases the arena of the former one.
+  auto iter = graph_mem_arenas_.find(graph->graph_id());
+  if (iter != graph_mem_arenas_.end()) {
+    mem_manager_->FreeMemFromMemPool(iter->second);
+    (void)graph_mem_arenas_.erase(iter);
+  }
+  auto total_size = somas_plan->GetTotalMemSize();
+  if (total_size > 0) {
+    auto base_ptr = mem_manager_->MallocMemFromMemPool(total_size, true);
+    if (base_ptr == nullptr) {
+      MS_LOG(EXCEPTION) << "Malloc the memory arena of graph " << graph->graph_id() << " failed, size: " << total_size;
+    }
+    somas_plan->set_mem_base_addr(static_cast<uint8_t *>(base_ptr));
+    graph_mem_arenas_[graph->graph_id()] = base_ptr;
+  }
+  MS_LOG(INFO) << "Graph " << graph->graph_id() << " plans " << total_size
+               << " bytes for kernel outputs and workspaces, the lifetime lower bound is "
+               << somas_plan->GetLowerBound() << " bytes and the allocation without reuse takes "
+               << somas_plan->GetUpperBound() << " bytes.";
+
+  for (const auto &kernel : graph->execution_order()) {
+    MS_EXCEPTION_IF_NULL(kernel);
+    auto kernel_mod = AnfAlgo::GetKernelMod(kernel);
+    MS_EXCEPTION_IF_NULL(kernel_mod);
+    const auto &output_sizes = kernel_mod->GetOutputSizeList();
+    for (size_t i = 0; i < output_sizes.size(); ++i) {
+      if (output_sizes[i] == 0 || AnfAlgo::OutputAddrExist(kernel, i)) {
+        continue;
+      }
+      auto device_address =
+        CreateDeviceAddress(somas_plan->GetNodeOutputPtr(kernel, i), output_sizes[i],
+                            AnfAlgo::GetOutputFormat(kernel, i), AnfAlgo::GetOutputDeviceDataType(kernel, i));
+      device_address->set_host_shape(trans::GetRuntimePaddingShape(kernel, i));
+      // The arena memory must not be freed or moved away by the actors.
+      device_address->set_is_ptr_persisted(true);
+      AnfAlgo::SetOutputAddr(device_address, i, kernel.get());
+    }
+    const auto &workspace_sizes = kernel_mod->GetWorkspaceSizeList();
+    for (size_t i = 0; i < workspace_sizes.size(); ++i) {
+      if (workspace_sizes[i] == 0) {
+        continue;
+      }
+      auto device_address =
+        CreateDeviceAddress(somas_plan->GetNodeWorkSpacePtr(kernel, i), workspace_sizes[i], "", kTypeUnknown);
+      device_address->set_is_ptr_persisted(true);
+      AnfAlgo::SetWorkspaceAddr(device_address, i, kernel.get());
+    }
+  }
+}
+
+bool CPUDeviceContext::LaunchGraph(const KernelGraphPtr &graph) const {
+  MS_EXCEPTION_IF_NULL(graph);
+  // The weights may take the device addresses of host tensors before launch, the ref outputs follow them.
+  for (const auto &ref_pair : graph->GetRefMap()) {
+    const auto &output_pair = ref_pair.first;
+    const auto &input_pair = ref_pair.second;
+    auto input_addr = AnfAlgo::GetMutableOutputAddr(input_pair.first, input_pair.second, false);
+    if (input_addr != AnfAlgo::GetMutableOutputAddr(output_pair.first, output_pair.second, false)) {
+      AnfAlgo::SetOutputAddr(input_addr, output_pair.second, output_pair.first.get());
+    }
+  }
+
+  for (const auto &kernel : graph->execution_order()) {
+    MS_EXCEPTION_IF_NULL(kernel);
+    std::vector<AddressPtr> inputs;
+    std::vector<AddressPtr> workspaces;
+    std::vector<AddressPtr> outputs;
+    size_t input_num = AnfAlgo::GetInputTensorNum(kernel);
+    for (size_t i = 0; i < input_num; ++i) {
+      (void)inputs.emplace_back(FetchLaunchAddress(AnfAlgo::GetPrevNodeOutputAddr(kernel, i, false)));
+    }
+    auto kernel_mod = AnfAlgo::GetKernelMod(kernel);
+    MS_EXCEPTION_IF_NULL(kernel_mod);
+    for (size_t i = 0; i < kernel_mod->GetWorkspaceSizeList().size(); ++i) {
+      (void)workspaces.emplace_back(FetchLaunchAddress(AnfAlgo::GetWorkspaceAddr(kernel, i)));
+    }
+    size_t output_num = AnfAlgo::GetOutputTensorNum(kernel);
+    for (size_t i = 0; i < output_num; ++i) {
+      auto device_address = AnfAlgo::GetMutableOutputAddr(kernel, i, false);
+      MS_EXCEPTION_IF_NULL(device_address);
+      if (device_address->GetPtr() == nullptr && device_address->GetSize() != 0 &&
+          !AllocateMemory(device_address.get(), device_address->GetSize())) {
+        MS_LOG(ERROR) << "Allocate memory failed, kernel: " << kernel->fullname_with_scope()
+                      << ", size: " << device_address->GetSize();
+        return false;
+      }
+      (void)outputs.emplace_back(FetchLaunchAddress(device_address.get()));
+    }
+    if (!LaunchKernel(kernel, inputs, workspaces, outputs)) {
+      MS_LOG(ERROR) << "Launch kernel failed: " << kernel->fullname_with_scope() << " in graph " << graph->graph_id();
+      return false;
+    }
+  }
+  return true;
 }
 
 bool CPUDeviceContext::LaunchKernel(const CNodePtr &kernel, const std::vector<AddressPtr> &inputs,
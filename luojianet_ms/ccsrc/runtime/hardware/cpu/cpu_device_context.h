@@ -18,6 +18,7 @@
 #define LUOJIANET_MS_CCSRC_RUNTIME_HARDWARE_CPU_CPU_DEVICE_CONTEXT_H_
 
 #include <vector>
+#include <map>
 #include <memory>
 #include <string>
 #include <mutex>
@@ -40,6 +41,9 @@ class CPUDeviceContext : public DeviceContext {
 
   bool AllocateMemory(DeviceAddress *const &address, size_t size) const override;
   void FreeMemory(DeviceAddress *const &address) const override;
+  size_t UsedMemStatistics() const override;
+  size_t UsedMemPeakStatistics() const override;
+  void ResetUsedMemPeakStatistics() const override;
 
   DeviceAddressPtr CreateDeviceAddress(void *const device_ptr, size_t device_size, const string &format,
                                        TypeId type_id) const override;
@@ -53,6 +57,11 @@ class CPUDeviceContext : public DeviceContext {
   void UpdateDynamicShape(const CNodePtr &kernel) const override;
 
   void PreprocessBeforeRunGraph(const KernelGraphPtr &graph) const override;
+  void PlanGraphMemory(const KernelGraphPtr &graph) const override;
+
+  // The graph is executed as a whole when its memory is planned by somas, see 'PlanGraphMemory'.
+  bool IsExecutingSink(const KernelGraphPtr &graph) const override;
+  bool LaunchGraph(const KernelGraphPtr &graph) const override;
 
   bool LaunchKernel(const CNodePtr &kernel, const std::vector<AddressPtr> &inputs,
                     const std::vector<AddressPtr> &workspace, const std::vector<AddressPtr> &outputs,
@@ -76,6 +85,8 @@ class CPUDeviceContext : public DeviceContext {
 
   mutable std::mutex launch_mutex_;
   std::shared_ptr<MemoryManager> mem_manager_;
+  // The memory arena of each planned graph, all kernel outputs and workspaces of the graph live in it.
+  mutable std::map<uint32_t, void *> graph_mem_arenas_;
   bool initialized_;
 };
 }  // namespace cpu
@@ -16,10 +16,31 @@
  */
 
 #include "runtime/hardware/cpu/ms_collective_comm_lib.h"
+#include <map>
+#include "ir/dtype/type.h"
 
 namespace luojianet_ms {
 namespace device {
 namespace cpu {
+namespace {
+using CollectiveReduceType = luojianet_ms::fl::server::CollectiveReduceType;
+
+bool ToRingReduceType(CollectiveOpReduceType reduce_op, CollectiveReduceType *reduce_type) {
+  static const std::map<CollectiveOpReduceType, CollectiveReduceType> kReduceTypeMap = {
+    {CollectiveOpReduceType::Reduce_Sum, CollectiveReduceType::kSum},
+    {CollectiveOpReduceType::Reduce_Max, CollectiveReduceType::kMax},
+    {CollectiveOpReduceType::Reduce_Min, CollectiveReduceType::kMin},
+    {CollectiveOpReduceType::Reduce_Prod, CollectiveReduceType::kProd}};
+  auto iter = kReduceTypeMap.find(reduce_op);
+  if (iter == kReduceTypeMap.end()) {
+    MS_LOG(ERROR) << "The reduce type " << reduce_op << " is not supported by LuoJiaNet collective communication.";
+    return false;
+  }
+  *reduce_type = iter->second;
+  return true;
+}
+}  // namespace
+
 MsCollectiveCommLib::MsCollectiveCommLib() {
   node_ = std::dynamic_pointer_cast<ps::core::AbstractNode>(ClusterContext::instance()->node());
   // Generate the global group name with node role.
@@ -74,24 +95,79 @@ bool MsCollectiveCommLib::AllGather(const void *send_buff, void *recv_buff, size
   return true;
 }
 
-bool MsCollectiveCommLib::Broadcast(const void *send_buff, void *recv_buff, size_t send_count, TypeId data_type,
-                                    uint32_t root_rank, const std::string &group_name, void *stream) {
+bool MsCollectiveCommLib::AllReduce(const void *send_buff, void *recv_buff, size_t send_count, TypeId data_type,
+                                    CollectiveOpReduceType reduce_op, const std::string &group_name, void *stream) {
   CHECK_IF_NULL(send_buff);
   CHECK_IF_NULL(recv_buff);
   CHECK_IF_NULL(node_);
 
-  if (groups_.count(group_name) == 0) {
-    MS_LOG(ERROR) << "The group " << group_name << " does not exist.";
+  CollectiveReduceType reduce_type = CollectiveReduceType::kSum;
+  CommunicationGroupInfo group_info = {};
+  if (!ToRingReduceType(reduce_op, &reduce_type) || !GetGroupInfo(group_name, &group_info)) {
     return false;
   }
 
-  auto group = groups_[group_name];
+  switch (data_type) {
+    case TypeId::kNumberTypeInt32:
+    case TypeId::kNumberTypeInt:
+      return CollectiveOpsImpl::GetInstance().AllReduce<int32_t>(send_buff, recv_buff, send_count, reduce_type, node_,
+                                                                 group_info);
+    case TypeId::kNumberTypeFloat16:
+      return CollectiveOpsImpl::GetInstance().AllReduce<float16>(send_buff, recv_buff, send_count, reduce_type, node_,
+                                                                 group_info);
+    case TypeId::kNumberTypeFloat32:
+    case TypeId::kNumberTypeFloat:
+      return CollectiveOpsImpl::GetInstance().AllReduce<float>(send_buff, recv_buff, send_count, reduce_type, node_,
+                                                               group_info);
+    default:
+      MS_LOG(ERROR) << "The data type " << TypeIdLabel(data_type) << " of AllReduce is not supported.";
+      return false;
+  }
+  return true;
+}
+
+bool MsCollectiveCommLib::ReduceScatter(const void *send_buff, void *recv_buff, size_t recv_count, TypeId data_type,
+                                        CollectiveOpReduceType reduce_op, const std::string &group_name,
+                                        void *stream) {
+  CHECK_IF_NULL(send_buff);
+  CHECK_IF_NULL(recv_buff);
+  CHECK_IF_NULL(node_);
+
+  CollectiveReduceType reduce_type = CollectiveReduceType::kSum;
   CommunicationGroupInfo group_info = {};
-  group_info.size = group->group_size();
-  group_info.global_rank = global_rank_id_;
-  group_info.group_ranks = group->group_ranks();
-  group_info.global_to_group_ranks = group->global_to_group_ranks();
-  group_info.group_to_global_ranks = group->group_to_global_ranks();
+  if (!ToRingReduceType(reduce_op, &reduce_type) || !GetGroupInfo(group_name, &group_info)) {
+    return false;
+  }
+
+  switch (data_type) {
+    case TypeId::kNumberTypeInt32:
+    case TypeId::kNumberTypeInt:
+      return CollectiveOpsImpl::GetInstance().ReduceScatter<int32_t>(send_buff, recv_buff, recv_count, reduce_type,
+                                                                     node_, group_info);
+    case TypeId::kNumberTypeFloat16:
+      return CollectiveOpsImpl::GetInstance().ReduceScatter<float16>(send_buff, recv_buff, recv_count, reduce_type,
+                                                                     node_, group_info);
+    case TypeId::kNumberTypeFloat32:
+    case TypeId::kNumberTypeFloat:
+      return CollectiveOpsImpl::GetInstance().ReduceScatter<float>(send_buff, recv_buff, recv_count, reduce_type,
+                                                                   node_, group_info);
+    default:
+      MS_LOG(ERROR) << "The data type " << TypeIdLabel(data_type) << " of ReduceScatter is not supported.";
+      return false;
+  }
+  return true;
+}
+
+bool MsCollectiveCommLib::Broadcast(const void *send_buff, void *recv_buff, size_t send_count, TypeId data_type,
+                                    uint32_t root_rank, const std::string &group_name, void *stream) {
+  CHECK_IF_NULL(send_buff);
+  CHECK_IF_NULL(recv_buff);
+  CHECK_IF_NULL(node_);
+
+  CommunicationGroupInfo group_info = {};
+  if (!GetGroupInfo(group_name, &group_info)) {
+    return false;
+  }
 
   switch (data_type) {
     case TypeId::kNumberTypeInt8:
@@ -113,6 +189,23 @@ bool MsCollectiveCommLib::Broadcast(const void *send_buff, void *recv_buff, size
   }
   return true;
 }
+
+bool MsCollectiveCommLib::GetGroupInfo(const std::string &group_name, CommunicationGroupInfo *group_info) {
+  CHECK_IF_NULL(group_info);
+  if (groups_.count(group_name) == 0) {
+    MS_LOG(ERROR) << "The group " << group_name << " does not exist.";
+    return false;
+  }
+
+  auto group = groups_[group_name];
+  CHECK_IF_NULL(group);
+  group_info->size = group->group_size();
+  group_info->global_rank = global_rank_id_;
+  group_info->group_ranks = group->group_ranks();
+  group_info->global_to_group_ranks = group->global_to_group_ranks();
+  group_info->group_to_global_ranks = group->group_to_global_ranks();
+  return true;
+}
 }  // namespace cpu
 }  // namespace device
 }  // namespace luojianet_ms
@@ -50,22 +50,21 @@ class MsCollectiveCommLib : public CollectiveCommunicationLib {
                  const std::string &group_name, void *stream = nullptr) override;
 
   bool AllReduce(const void *send_buff, void *recv_buff, size_t send_count, TypeId data_type,
-                 CollectiveOpReduceType reduce_op, const std::string &group_name, void *stream = nullptr) override {
-    return true;
-  }
+                 CollectiveOpReduceType reduce_op, const std::string &group_name, void *stream = nullptr) override;
 
   bool Broadcast(const void *send_buff, void *recv_buff, size_t send_count, TypeId data_type, uint32_t root_rank,
                  const std::string &group_name, void *stream = nullptr) override;
 
   bool ReduceScatter(const void *send_buff, void *recv_buff, size_t recv_count, TypeId data_type,
-                     CollectiveOpReduceType reduce_op, const std::string &group_name, void *stream = nullptr) override {
-    return true;
-  }
+                     CollectiveOpReduceType reduce_op, const std::string &group_name, void *stream = nullptr) override;
 
  private:
   MsCollectiveCommLib();
   ~MsCollectiveCommLib() override = default;
 
+  // Fill the group information which CollectiveOpsImpl needs for the collectives within a group.
+  bool GetGroupInfo(const std::string &group_name, CommunicationGroupInfo *group_info);
+
   std::shared_ptr<ps::core::AbstractNode> node_;
 };
 }  // namespace cpu
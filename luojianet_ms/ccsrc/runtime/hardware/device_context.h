@@ -74,6 +74,12 @@ class DeviceContext {
   virtual bool AllocateMemory(DeviceAddress *const &address, size_t size) const = 0;
   virtual void FreeMemory(DeviceAddress *const &address) const = 0;
 
+  // The memory in use and its peak of the memory pool. The peak can be restarted from the memory in use to measure the
+  // peak of one step. The default behavior reports nothing.
+  virtual size_t UsedMemStatistics() const { return 0; }
+  virtual size_t UsedMemPeakStatistics() const { return 0; }
+  virtual void ResetUsedMemPeakStatistics() const {}
+
   // Allocate continuous device memory end to end into 'addr_list'.
   // Communication operators may need continuous memory for input and output
   // to optimize the communication performance.
@@ -111,6 +117,9 @@ class DeviceContext {
   virtual void PreprocessBeforeRunGraph(const KernelGraphPtr &graph) const {}
   // Adjust single op kernel graph before run graph, used in PyNative Mode.
   virtual void PreprocessBeforeRunSingleOpGraph(const KernelGraphPtr &graph) const {}
+  // Plan the memory of all kernel outputs and workspaces of the sink graph at once, called after the device addresses
+  // of graph inputs are created. The kernel outputs and workspaces which already have device addresses are kept.
+  virtual void PlanGraphMemory(const KernelGraphPtr &graph) const {}
 
   // Infer kernel shape and update abstract info for dynamic shape kernel.
   virtual void UpdateDynamicShape(const CNodePtr &kernel) const { AnfAlgo::InferShape(kernel); }
@@ -0,0 +1,440 @@
+/**
+ * Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+ * Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "utils/checkpoint_file.h"
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <utility>
+#include "common/thread_pool.h"
+#include "utils/log_adapter.h"
+
+namespace luojianet_ms {
+namespace {
+constexpr char kCheckpointMagic[] = {'L', 'J', 'C', 'K', 'P', 'T', '\0', '\1'};
+constexpr size_t kCheckpointMagicSize = sizeof(kCheckpointMagic);
+constexpr uint32_t kCheckpointVersion = 1;
+constexpr size_t kCheckpointHeaderSize = kCheckpointMagicSize + 2 * sizeof(uint32_t) + 2 * sizeof(uint64_t);
+// The payload range written by one thread is not split smaller than this.
+constexpr size_t kMinWriteRangeSize = 4 * 1024 * 1024;
+constexpr size_t kHashBlockSize = 1024 * 1024;
+constexpr size_t kHashLaneNum = 4;
+constexpr uint64_t kHashPrime1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t kHashPrime2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr uint64_t kHashPrime3 = 0x165667B19E3779F9ULL;
+
+// The same dtype names as the protobuf checkpoint.
+const std::vector<std::pair<std::string, TypeId>> kCheckpointTypes = {
+  {"Int8", kNumberTypeInt8},       {"UInt8", kNumberTypeUInt8},     {"Int16", kNumberTypeInt16},
+  {"UInt16", kNumberTypeUInt16},   {"Int32", kNumberTypeInt32},     {"UInt32", kNumberTypeUInt32},
+  {"Int64", kNumberTypeInt64},     {"UInt64", kNumberTypeUInt64},   {"Float16", kNumberTypeFloat16},
+  {"Float32", kNumberTypeFloat32}, {"Float64", kNumberTypeFloat64}, {"Bool", kNumberTypeBool}};
+
+std::string TypeToName(TypeId type) {
+  for (const auto &item : kCheckpointTypes) {
+    if (item.second == type) {
+      return item.first;
+    }
+  }
+  MS_LOG(EXCEPTION) << "The checkpoint does not support the data type: " << TypeIdLabel(type);
+}
+
+TypeId NameToType(const std::string &name) {
+  for (const auto &item : kCheckpointTypes) {
+    if (item.first == name) {
+      return item.second;
+    }
+  }
+  MS_LOG(EXCEPTION) << "The checkpoint contains the unsupported data type: " << name;
+}
+
+size_t AlignSize(size_t size) { return (size + kCheckpointAlignSize - 1) / kCheckpointAlignSize * kCheckpointAlignSize; }
+
+template <typename T>
+void AppendValue(std::string *buf, T value) {
+  (void)buf->append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+void AppendString(std::string *buf, const std::string &str) {
+  AppendValue<uint32_t>(buf, static_cast<uint32_t>(str.size()));
+  (void)buf->append(str);
+}
+
+uint64_t HashMix(uint64_t hash, uint64_t value) {
+  constexpr int kRotateBits = 31;
+  hash ^= value * kHashPrime2;
+  hash = (hash << kRotateBits) | (hash >> (64 - kRotateBits));
+  return hash * kHashPrime1;
+}
+
+uint64_t HashFinalize(uint64_t hash) {
+  constexpr int kShift1 = 33;
+  constexpr int kShift2 = 29;
+  constexpr int kShift3 = 32;
+  hash ^= hash >> kShift1;
+  hash *= kHashPrime2;
+  hash ^= hash >> kShift2;
+  hash *= kHashPrime3;
+  hash ^= hash >> kShift3;
+  return hash;
+}
+
+// The independent lanes let the multiplications of neighbouring words overlap.
+uint64_t HashBlock(const char *data, size_t size) {
+  uint64_t lanes[kHashLaneNum] = {kHashPrime1, kHashPrime2, kHashPrime3, kHashPrime1 ^ kHashPrime2};
+  constexpr size_t kStripeSize = kHashLaneNum * sizeof(uint64_t);
+  size_t pos = 0;
+  for (; pos + kStripeSize <= size; pos += kStripeSize) {
+    uint64_t words[kHashLaneNum];
+    (void)memcpy(words, data + pos, kStripeSize);
+    for (size_t i = 0; i < kHashLaneNum; ++i) {
+      lanes[i] = HashMix(lanes[i], words[i]);
+    }
+  }
+  uint64_t hash = size;
+  for (size_t i = 0; i < kHashLaneNum; ++i) {
+    hash = HashMix(hash, lanes[i]);
+  }
+  for (; pos < size; pos += sizeof(uint64_t)) {
+    uint64_t word = 0;
+    (void)memcpy(&word, data + pos, std::min(sizeof(uint64_t), size - pos));
+    hash = HashMix(hash, word);
+  }
+  return HashFinalize(hash);
+}
+
+// Reads the values in bounds of buffer, and raises the exception on the damaged file.
+class BufferReader {
+ public:
+  BufferReader(const char *buf, size_t size, const std::string &file_name)
+      : buf_(buf), size_(size), file_name_(file_name) {}
+
+  template <typename T>
+  T ReadValue() {
+    T value;
+    Read(&value, sizeof(T));
+    return value;
+  }
+
+  std::string ReadString() {
+    auto len = ReadValue<uint32_t>();
+    CheckRemain(len);
+    std::string str(buf_ + pos_, len);
+    pos_ += len;
+    return str;
+  }
+
+  size_t pos() const { return pos_; }
+
+ private:
+  void Read(void *dst, size_t len) {
+    CheckRemain(len);
+    (void)memcpy(dst, buf_ + pos_, len);
+    pos_ += len;
+  }
+  void CheckRemain(size_t len) const {
+    if (len > size_ - pos_) {
+      MS_LOG(EXCEPTION) << "The checkpoint file " << file_name_ << " is damaged, its index exceeds the file size.";
+    }
+  }
+
+  const char *buf_;
+  size_t size_;
+  size_t pos_{0};
+  const std::string &file_name_;
+};
+}  // namespace
+
+void SaveCheckpointFile(const std::string &file_name, const std::vector<std::string> &names,
+                        const std::vector<tensor::TensorPtr> &tensors) {
+  if (names.size() != tensors.size()) {
+    MS_LOG(EXCEPTION) << "The number of names " << names.size() << " is not equal to the number of tensors "
+                      << tensors.size();
+  }
+
+  // The payload offsets depend on the index size, which is known before the offsets are filled.
+  std::vector<std::string> dtypes;
+  std::vector<std::pair<size_t, size_t>> payloads;
+  size_t index_size = 0;
+  size_t payload_end = 0;
+  for (size_t i = 0; i < tensors.size(); ++i) {
+    const auto &tensor = tensors[i];
+    MS_EXCEPTION_IF_NULL(tensor);
+    tensor->data_sync();
+    (void)dtypes.emplace_back(TypeToName(tensor->data_type()));
+    index_size += sizeof(uint32_t) * 3 + names[i].size() + dtypes.back().size() +
+                  tensor->shape().size() * sizeof(int64_t) + sizeof(uint64_t) * 2;
+    // The empty payload takes no room, so its offset never goes past the end of the file.
+    size_t payload_offset = tensor->Size() == 0 ? payload_end : AlignSize(payload_end);
+    (void)payloads.emplace_back(payload_offset, tensor->Size());
+    payload_end = payload_offset + tensor->Size();
+  }
+  const size_t data_offset = AlignSize(kCheckpointHeaderSize + index_size);
+
+  std::string index;
+  index.reserve(index_size);
+  for (size_t i = 0; i < tensors.size(); ++i) {
+    AppendString(&index, names[i]);
+    AppendString(&index, dtypes[i]);
+    AppendValue<uint32_t>(&index, static_cast<uint32_t>(tensors[i]->shape().size()));
+    for (auto dim : tensors[i]->shape()) {
+      AppendValue<int64_t>(&index, dim);
+    }
+    AppendValue<uint64_t>(&index, data_offset + payloads[i].first);
+    AppendValue<uint64_t>(&index, payloads[i].second);
+  }
+
+  std::string header(kCheckpointMagic, kCheckpointMagicSize);
+  AppendValue<uint32_t>(&header, kCheckpointVersion);
+  AppendValue<uint32_t>(&header, static_cast<uint32_t>(tensors.size()));
+  AppendValue<uint64_t>(&header, index.size());
+  AppendValue<uint64_t>(&header, data_offset);
+  {
+    std::ofstream ofs(file_name, std::ios::binary | std::ios::trunc);
+    if (!ofs.is_open()) {
+      MS_LOG(EXCEPTION) << "Open the checkpoint file " << file_name << " failed.";
+    }
+    (void)ofs.write(header.data(), static_cast<std::streamsize>(header.size()));
+    (void)ofs.write(index.data(), static_cast<std::streamsize>(index.size()));
+    // The file is extended to its full size before the payloads are written, so that it covers every payload even
+    // if the last ones are empty.
+    std::string padding(data_offset - header.size() - index.size(), '\0');
+    (void)ofs.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+    if (payload_end > 0) {
+      (void)ofs.seekp(static_cast<std::streamoff>(data_offset + payload_end - 1));
+      (void)ofs.put('\0');
+    }
+    if (!ofs.good()) {
+      MS_LOG(EXCEPTION) << "Write the index of checkpoint file " << file_name << " failed.";
+    }
+  }
+
+  // Every thread writes an equal byte range of the payloads through its own file stream.
+  size_t thread_num = common::ThreadPool::GetInstance().GetSyncRunThreadNum();
+  thread_num = std::max<size_t>(1, std::min(thread_num, payload_end / kMinWriteRangeSize));
+  std::atomic_bool write_failed{false};
+  std::vector<common::Task> tasks;
+  for (size_t t = 0; t < thread_num; ++t) {
+    size_t range_begin = payload_end * t / thread_num;
+    size_t range_end = payload_end * (t + 1) / thread_num;
+    (void)tasks.emplace_back([&, range_begin, range_end]() {
+      std::fstream fs(file_name, std::ios::binary | std::ios::in | std::ios::out);
+      if (!fs.is_open()) {
+        write_failed = true;
+        return common::FAIL;
+      }
+      for (size_t i = 0; i < payloads.size(); ++i) {
+        size_t begin = std::max(payloads[i].first, range_begin);
+        size_t end = std::min(payloads[i].first + payloads[i].second, range_end);
+        if (begin >= end) {
+          continue;
+        }
+        auto data = static_cast<const char *>(tensors[i]->data_c()) + (begin - payloads[i].first);
+        (void)fs.seekp(static_cast<std::streamoff>(data_offset + begin));
+        (void)fs.write(data, static_cast<std::streamsize>(end - begin));
+      }
+      if (!fs.good()) {
+        write_failed = true;
+        return common::FAIL;
+      }
+      return common::SUCCESS;
+    });
+  }
+  (void)common::ThreadPool::GetInstance().SyncRun(tasks);
+  if (write_failed) {
+    MS_LOG(EXCEPTION) << "Write the payloads of checkpoint file " << file_name << " failed.";
+  }
+  MS_LOG(INFO) << "Save " << tensors.size() << " tensors of " << payload_end << " bytes into " << file_name << " by "
+               << thread_num << " threads.";
+}
+
+std::vector<uint64_t> HashTensors(const std::vector<tensor::TensorPtr> &tensors) {
+  // The blocks of all tensors are hashed by the threads in turn, and then folded into the hash of every tensor.
+  std::vector<std::pair<size_t, size_t>> blocks;
+  std::vector<size_t> block_begins;
+  for (size_t i = 0; i < tensors.size(); ++i) {
+    MS_EXCEPTION_IF_NULL(tensors[i]);
+    tensors[i]->data_sync();
+    (void)block_begins.emplace_back(blocks.size());
+    for (size_t offset = 0; offset < tensors[i]->Size(); offset += kHashBlockSize) {
+      (void)blocks.emplace_back(i, offset);
+    }
+  }
+  std::vector<uint64_t> block_hashes(blocks.size());
+  size_t thread_num = std::max<size_t>(1, std::min(common::ThreadPool::GetInstance().GetSyncRunThreadNum(),
+                                                   blocks.size()));
+  std::vector<common::Task> tasks;
+  for (size_t t = 0; t < thread_num; ++t) {
+    (void)tasks.emplace_back([&, t]() {
+      for (size_t b = t; b < blocks.size(); b += thread_num) {
+        const auto &tensor = tensors[blocks[b].first];
+        size_t offset = blocks[b].second;
+        block_hashes[b] = HashBlock(static_cast<const char *>(tensor->data_c()) + offset,
+                                    std::min(kHashBlockSize, tensor->Size() - offset));
+      }
+      return common::SUCCESS;
+    });
+  }
+  (void)common::ThreadPool::GetInstance().SyncRun(tasks);
+
+  std::vector<uint64_t> hashes;
+  for (size_t i = 0; i < tensors.size(); ++i) {
+    uint64_t hash = HashMix(kHashPrime3, static_cast<uint64_t>(tensors[i]->data_type()));
+    for (auto dim : tensors[i]->shape()) {
+      hash = HashMix(hash, static_cast<uint64_t>(dim));
+    }
+    size_t block_end = i + 1 < tensors.size() ? block_begins[i + 1] : blocks.size();
+    for (size_t b = block_begins[i]; b < block_end; ++b) {
+      hash = HashMix(hash, block_hashes[b]);
+    }
+    (void)hashes.emplace_back(HashFinalize(hash));
+  }
+  return hashes;
+}
+
+bool IsNativeCheckpointFile(const std::string &file_name) {
+  std::ifstream ifs(file_name, std::ios::binary);
+  if (!ifs.is_open()) {
+    return false;
+  }
+  char magic[kCheckpointMagicSize] = {0};
+  (void)ifs.read(magic, kCheckpointMagicSize);
+  return ifs.gcount() == static_cast<std::streamsize>(kCheckpointMagicSize) &&
+         memcmp(magic, kCheckpointMagic, kCheckpointMagicSize) == 0;
+}
+
+CheckpointReader::CheckpointReader(const std::string &file_name) : file_name_(file_name) {
+#if !defined(_WIN32) && !defined(_WIN64)
+  int fd = open(file_name.c_str(), O_RDONLY);
+  if (fd < 0) {
+    MS_LOG(EXCEPTION) << "Open the checkpoint file " << file_name << " failed.";
+  }
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0) {
+    (void)close(fd);
+    MS_LOG(EXCEPTION) << "Get the size of checkpoint file " << file_name << " failed.";
+  }
+  buf_size_ = static_cast<size_t>(file_stat.st_size);
+  void *buf = mmap(nullptr, buf_size_, PROT_READ, MAP_PRIVATE, fd, 0);
+  (void)close(fd);
+  if (buf == MAP_FAILED) {
+    MS_LOG(EXCEPTION) << "Map the checkpoint file " << file_name << " failed.";
+  }
+  buf_ = static_cast<const char *>(buf);
+#else
+  std::ifstream ifs(file_name, std::ios::binary | std::ios::ate);
+  if (!ifs.is_open()) {
+    MS_LOG(EXCEPTION) << "Open the checkpoint file " << file_name << " failed.";
+  }
+  buf_size_ = static_cast<size_t>(ifs.tellg());
+  auto buf = new char[buf_size_];
+  (void)ifs.seekg(0);
+  (void)ifs.read(buf, static_cast<std::streamsize>(buf_size_));
+  buf_ = buf;
+#endif
+  try {
+    ParseIndex();
+  } catch (const std::exception &) {
+    Release();
+    throw;
+  }
+}
+
+CheckpointReader::~CheckpointReader() { Release(); }
+
+void CheckpointReader::Release() {
+  if (buf_ == nullptr) {
+    return;
+  }
+#if !defined(_WIN32) && !defined(_WIN64)
+  (void)munmap(const_cast<char *>(buf_), buf_size_);
+#else
+  delete[] buf_;
+#endif
+  buf_ = nullptr;
+}
+
+void CheckpointReader::ParseIndex() {
+  BufferReader reader(buf_, buf_size_, file_name_);
+  char magic[kCheckpointMagicSize];
+  for (size_t i = 0; i < kCheckpointMagicSize; ++i) {
+    magic[i] = reader.ReadValue<char>();
+  }
+  if (memcmp(magic, kCheckpointMagic, kCheckpointMagicSize) != 0) {
+    MS_LOG(EXCEPTION) << "The file " << file_name_ << " is not a native checkpoint file.";
+  }
+  auto version = reader.ReadValue<uint32_t>();
+  if (version != kCheckpointVersion) {
+    MS_LOG(EXCEPTION) << "The version " << version << " of checkpoint file " << file_name_
+                      << " is not supported, the supported version is " << kCheckpointVersion;
+  }
+  auto entry_num = reader.ReadValue<uint32_t>();
+  (void)reader.ReadValue<uint64_t>();
+  (void)reader.ReadValue<uint64_t>();
+  for (uint32_t i = 0; i < entry_num; ++i) {
+    auto name = reader.ReadString();
+    Entry entry;
+    entry.type = NameToType(reader.ReadString());
+    auto rank = reader.ReadValue<uint32_t>();
+    for (uint32_t j = 0; j < rank; ++j) {
+      (void)entry.shape.emplace_back(reader.ReadValue<int64_t>());
+    }
+    entry.offset = reader.ReadValue<uint64_t>();
+    entry.size = reader.ReadValue<uint64_t>();
+    if (entry.size > 0 && (entry.offset > buf_size_ || entry.size > buf_size_ - entry.offset)) {
+      MS_LOG(EXCEPTION) << "The checkpoint file " << file_name_ << " is damaged, the payload of " << name
+                        << " exceeds the file size.";
+    }
+    if (!entries_.emplace(name, std::move(entry)).second) {
+      MS_LOG(EXCEPTION) << "The checkpoint file " << file_name_ << " contains the duplicated tensor " << name;
+    }
+    (void)names_.emplace_back(std::move(name));
+  }
+}
+
+const CheckpointReader::Entry &CheckpointReader::FindEntry(const std::string &name) const {
+  auto iter = entries_.find(name);
+  if (iter == entries_.end()) {
+    MS_LOG(EXCEPTION) << "The checkpoint file " << file_name_ << " does not contain the tensor " << name;
+  }
+  return iter->second;
+}
+
+std::string CheckpointReader::GetDtype(const std::string &name) const { return TypeToName(FindEntry(name).type); }
+
+ShapeVector CheckpointReader::GetShape(const std::string &name) const { return FindEntry(name).shape; }
+
+tensor::TensorPtr CheckpointReader::GetTensor(const std::string &name) const {
+  const auto &entry = FindEntry(name);
+  auto tensor = std::make_shared<tensor::Tensor>(entry.type, entry.shape);
+  if (tensor->Size() != entry.size) {
+    MS_LOG(EXCEPTION) << "The checkpoint file " << file_name_ << " is damaged, the payload size " << entry.size
+                      << " of " << name << " does not match its shape.";
+  }
+  if (entry.size > 0) {
+    (void)memcpy(tensor->data_c(), buf_ + entry.offset, entry.size);
+  }
+  return tensor;
+}
+}  // namespace luojianet_ms
@@ -0,0 +1,80 @@
+/**
+ * Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+ * Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LUOJIANET_MS_CCSRC_UTILS_CHECKPOINT_FILE_H_
+#define LUOJIANET_MS_CCSRC_UTILS_CHECKPOINT_FILE_H_
+
+#include <map>
+#include <string>
+#include <vector>
+#include "ir/tensor.h"
+
+namespace luojianet_ms {
+// Native checkpoint file, laid out as: header | index | payloads.
+//  header : magic(8 bytes) | version(uint32) | entry number(uint32) | index size(uint64) | data offset(uint64)
+//  index  : for every tensor, name | dtype name | dims | payload offset(uint64) | payload size(uint64), where the
+//           strings are uint32 length prefixed and the dims are uint32 rank prefixed int64 values
+//  payload: raw tensor data, every payload begins at a multiple of kCheckpointAlignSize
+// The integers are in the byte order of host.
+constexpr size_t kCheckpointAlignSize = 64;
+
+// Write the tensors into the native checkpoint file. The tensors are synchronized to host first, and then the payloads
+// are split into equal byte ranges written by the threads straight from the tensor memory.
+void SaveCheckpointFile(const std::string &file_name, const std::vector<std::string> &names,
+                        const std::vector<tensor::TensorPtr> &tensors);
+
+// Whether the file begins with the magic of native checkpoint, the protobuf checkpoint doesn't.
+bool IsNativeCheckpointFile(const std::string &file_name);
+
+// Content hashes of the tensors, which cover the data type, the shape and the data. The data is hashed in blocks by the
+// threads, and the result doesn't depend on the thread number, so it can be compared between the checkpoints.
+std::vector<uint64_t> HashTensors(const std::vector<tensor::TensorPtr> &tensors);
+
+// Read the native checkpoint file by mapping it into memory, only the index is parsed when opened and the payload of a
+// tensor is copied when it is fetched.
+class CheckpointReader {
+ public:
+  explicit CheckpointReader(const std::string &file_name);
+  ~CheckpointReader();
+  CheckpointReader(const CheckpointReader &) = delete;
+  CheckpointReader &operator=(const CheckpointReader &) = delete;
+
+  // The tensor names in the order of saving.
+  const std::vector<std::string> &names() const { return names_; }
+  std::string GetDtype(const std::string &name) const;
+  ShapeVector GetShape(const std::string &name) const;
+  tensor::TensorPtr GetTensor(const std::string &name) const;
+
+ private:
+  struct Entry {
+    TypeId type{kTypeUnknown};
+    ShapeVector shape;
+    size_t offset{0};
+    size_t size{0};
+  };
+  const Entry &FindEntry(const std::string &name) const;
+  void ParseIndex();
+  void Release();
+
+  std::string file_name_;
+  const char *buf_{nullptr};
+  size_t buf_size_{0};
+  std::vector<std::string> names_;
+  std::map<std::string, Entry> entries_;
+};
+}  // namespace luojianet_ms
+#endif  // LUOJIANET_MS_CCSRC_UTILS_CHECKPOINT_FILE_H_
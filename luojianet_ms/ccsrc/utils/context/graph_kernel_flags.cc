@@ -225,6 +225,7 @@ void GraphKernelFlags::RegisterFlags(std::map<std::string, std::string> *flag_ma
   reg.AddFlag("enable_parallel_fusion", &enable_parallel_fusion, opt_level == OptLevel_3);
   reg.AddFlag("enable_low_precision", &enable_low_precision);
   reg.AddFlag("enable_trans_op_optimize", &enable_trans_op_optimize);
+  reg.AddFlag("enable_cpu_chain_fusion", &enable_cpu_chain_fusion);
 
   // Integer flags
   reg.AddFlag("online_tuning", &online_tuning);
@@ -258,6 +259,7 @@ std::string GraphKernelFlags::DumpAllFlags() const {
   json["enable_parallel_fusion"] = enable_parallel_fusion;
   json["enable_low_precision"] = enable_low_precision;
   json["enable_trans_op_optimize"] = enable_trans_op_optimize;
+  json["enable_cpu_chain_fusion"] = enable_cpu_chain_fusion;
 
   json["opt_level"] = opt_level;
   json["fusion_ops_level"] = fusion_ops_level;
@@ -110,6 +110,13 @@ class GraphKernelFlags {
    */
   bool enable_trans_op_optimize{false};
 
+  /**
+   * Expand and cluster the activation, softmax and loss operators on CPU, so that their chains are fused.
+   *
+   * Experimental feature, disabled by default.
+   */
+  bool enable_cpu_chain_fusion{false};
+
   /**
    * Optimization level, value from 0 to 3.
    * 0: Disable GraphKernel
@@ -18,11 +18,18 @@
 #include "utils/summary/event_writer.h"
 #include <string>
 #include <memory>
+#include <utility>
 #include "utils/log_adapter.h"
 #include "utils/convert_utils.h"
 
 namespace luojianet_ms {
 namespace summary {
+namespace {
+// The queued bytes above which Write blocks the caller.
+constexpr size_t kMaxQueueBytes = 64 << 20;
+// The written bytes after which the file is synced to disk.
+constexpr size_t kSyncBytes = 32 << 20;
+}  // namespace
 
 // implement the EventWriter
 EventWriter::EventWriter(const std::string &file_full_name) : filename_(file_full_name), events_write_count_(0) {
@@ -36,6 +43,7 @@ EventWriter::EventWriter(const std::string &file_full_name) : filename_(file_ful
   }
   // set the event writer status
   status_ = true;
+  write_thread_ = std::thread(&EventWriter::WriteLoop, this);
 }
 
 EventWriter::~EventWriter() {
@@ -63,16 +71,89 @@ bool EventWriter::Open() {
   return result;
 }
 
-// write the event serialization string to file
-void EventWriter::Write(const std::string &event_str) {
+// queue the event serialization string for the write thread
+bool EventWriter::Write(const std::string &event_str) {
   if (event_file_ == nullptr) {
     MS_LOG(ERROR) << "Write failed because file could not be opened.";
-    return;
+    return false;
+  }
+  {
+    std::unique_lock<std::mutex> lock(queue_mutex_);
+    // An event larger than kMaxQueueBytes is still accepted when the queue is empty.
+    written_cv_.wait(lock, [this, &event_str]() {
+      return stop_ || queue_bytes_ == 0 || queue_bytes_ + event_str.size() <= kMaxQueueBytes;
+    });
+    if (stop_) {
+      MS_LOG(ERROR) << "Write failed because the event writer is closed.";
+      return false;
+    }
+    queue_.push_back(event_str);
+    queue_bytes_ += event_str.size();
   }
+  queue_cv_.notify_one();
   events_write_count_++;
-  bool result = WriteRecord(event_str);
-  if (!result) {
-    MS_LOG(ERROR) << "Event write failed.";
+  return true;
+}
+
+void EventWriter::WriteLoop() {
+  size_t unsynced_bytes = 0;
+  while (true) {
+    std::deque<std::string> batch;
+    {
+      std::unique_lock<std::mutex> lock(queue_mutex_);
+      queue_cv_.wait(lock, [this]() { return stop_ || !queue_.empty(); });
+      // The queued events are still written when stopping.
+      if (queue_.empty()) {
+        return;
+      }
+      batch.swap(queue_);
+    }
+    bool result = true;
+    size_t batch_bytes = 0;
+    for (const auto &event_str : batch) {
+      batch_bytes += event_str.size();
+      if (result && !WriteRecord(event_str)) {
+        MS_LOG(ERROR) << "Event write failed.";
+        result = false;
+      }
+    }
+    // Flush the batch once, so that the readers of the file see the whole events.
+    result = result && event_file_->Flush();
+    unsynced_bytes += batch_bytes;
+    if (result && unsynced_bytes >= kSyncBytes) {
+      result = event_file_->Sync();
+      unsynced_bytes = 0;
+    }
+    {
+      std::lock_guard<std::mutex> lock(queue_mutex_);
+      queue_bytes_ -= batch_bytes;
+      write_failed_ = write_failed_ || !result;
+    }
+    written_cv_.notify_all();
+  }
+}
+
+bool EventWriter::WaitForWritten() {
+  std::unique_lock<std::mutex> lock(queue_mutex_);
+  written_cv_.wait(lock, [this]() { return queue_bytes_ == 0; });
+  bool result = !write_failed_;
+  write_failed_ = false;
+  return result;
+}
+
+void EventWriter::StopWriteThread() noexcept {
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    stop_ = true;
+  }
+  queue_cv_.notify_all();
+  written_cv_.notify_all();
+  try {
+    if (write_thread_.joinable()) {
+      write_thread_.join();
+    }
+  } catch (const std::exception &e) {
+    MS_LOG(ERROR) << "Stop the event write thread failed: " << e.what();
   }
 }
 
@@ -86,8 +167,12 @@ bool EventWriter::Flush() {
     MS_LOG(ERROR) << "Can't flush because the event file is null.";
     return false;
   }
+  if (!WaitForWritten()) {
+    MS_LOG(ERROR) << "Failed to write events to file(" << filename_ << ").";
+    return false;
+  }
   // Sync the file
-  if (!event_file_->Flush()) {
+  if (!event_file_->Sync()) {
     MS_LOG(ERROR) << "Failed to sync to file(" << filename_ << "), the event count(" << events_write_count_ << ").";
     return false;
   }
@@ -102,6 +187,7 @@ bool EventWriter::Close() noexcept {
     MS_LOG(INFO) << "The event writer is closed.";
     return result;
   }
+  StopWriteThread();
   if (event_file_ != nullptr) {
     result = event_file_->Close();
     if (!result) {
@@ -121,6 +207,7 @@ bool EventWriter::Shut() noexcept {
   if (!result) {
     MS_LOG(ERROR) << "Flush failed when close the file.";
   }
+  StopWriteThread();
   if (event_file_ != nullptr) {
     bool _close = event_file_->Close();
     if (!_close) {
@@ -18,8 +18,12 @@
 #ifndef SUMMARY_EVENT_WRITER_H_
 #define SUMMARY_EVENT_WRITER_H_
 
+#include <condition_variable>
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 
 #include "pybind11/pybind11.h"
 #include "securec/include/securec.h"
@@ -53,10 +57,12 @@ class EventWriter {
   // Open the file
   bool Open();
 
-  // write the Serialized "event_str" to file
-  void Write(const std::string &event_str);
+  // Queue the Serialized "event_str", which is written to file by the background thread. Blocks while the queued
+  // events exceed kMaxQueueBytes, so a slow disk throttles the caller instead of growing the memory. Returns false
+  // if the event writer is closed.
+  bool Write(const std::string &event_str);
 
-  // Flush the cache to disk
+  // Wait for the queued events to be written, and sync them to disk
   bool Flush();
 
   // close the file
@@ -73,12 +79,29 @@ class EventWriter {
   bool WriteRecord(const std::string &data);
 
  private:
+  // Write the queued events in batches, each batch is flushed once and synced every kSyncBytes.
+  void WriteLoop();
+  // Wait for the queued events to be written, returns false if any of them failed.
+  bool WaitForWritten();
+  void StopWriteThread() noexcept;
+
   // True: valid / False: closed
   bool status_ = false;
   std::shared_ptr<FileSystem> fs_;
   std::string filename_;
   WriteFilePtr event_file_;
   int32_t events_write_count_ = 0;
+
+  // The members below are guarded by queue_mutex_.
+  std::mutex queue_mutex_;
+  std::condition_variable queue_cv_;
+  std::condition_variable written_cv_;
+  std::deque<std::string> queue_;
+  // The bytes of the events which are queued or being written.
+  size_t queue_bytes_ = 0;
+  bool write_failed_ = false;
+  bool stop_ = false;
+  std::thread write_thread_;
 };
 
 }  // namespace summary
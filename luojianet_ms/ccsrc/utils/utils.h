@@ -470,6 +470,7 @@ constexpr auto kAttrPynativeNextOpName = "next_op";
 constexpr auto kAttrPynativeNextIndex = "next_index";
 constexpr auto kAttrCompileInfo = "compile_info";
 constexpr auto kAttrFusionType = "fusion_type";
+constexpr auto kAttrCpuBf16 = "cpu_bf16";
 constexpr auto kAttrStride = "stride";
 constexpr auto kAttrStrides = "strides";
 constexpr auto kAttrKernelSize = "kernel_size";
@@ -55,7 +55,9 @@ bool ActorWorker::RunQueueActorTask() {
   if (actor == nullptr) {
     return false;
   }
+  auto busy_begin = BusyTimeBegin();
   actor->Run();
+  BusyTimeEnd(busy_begin);
   return true;
 }
 
@@ -165,6 +167,7 @@ int ActorThreadPool::CreateThreads(size_t actor_thread_num, size_t all_thread_nu
     workers_.push_back(worker);
     THREAD_INFO("create actor thread[%zu]", i);
   }
+  SetActorThreadNum(actor_thread_num_);
   size_t kernel_thread_num = all_thread_num - actor_thread_num_;
   if (kernel_thread_num > 0) {
     return ThreadPool::CreateThreads(kernel_thread_num, core_list);
@@ -19,9 +19,102 @@
 #include <unistd.h>
 #endif
 #include "thread/threadpool.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <string>
 #include "thread/core_affinity.h"
 
 namespace luojianet_ms {
+namespace {
+struct WorkerRange {
+  const ThreadPool *pool{nullptr};
+  int begin{0};
+  int end{0};
+};
+thread_local WorkerRange local_worker_range;
+
+constexpr int kRangeShift = 32;
+constexpr uint64_t kRangeMask = 0xFFFFFFFFULL;
+
+uint64_t PackRange(int begin, int end) {
+  return (static_cast<uint64_t>(begin) << kRangeShift) | static_cast<uint64_t>(static_cast<uint32_t>(end));
+}
+
+// the owner of a range takes its first id
+bool TakeFront(std::atomic<uint64_t> *range, int *task_id) {
+  uint64_t packed = range->load();
+  while (true) {
+    int begin = static_cast<int>(packed >> kRangeShift);
+    int end = static_cast<int>(packed & kRangeMask);
+    if (begin >= end) {
+      return false;
+    }
+    if (range->compare_exchange_weak(packed, PackRange(begin + 1, end))) {
+      *task_id = begin;
+      return true;
+    }
+  }
+}
+
+// others steal its last id, so owner and thief only meet on the final one
+bool StealBack(std::atomic<uint64_t> *range, int *task_id) {
+  uint64_t packed = range->load();
+  while (true) {
+    int begin = static_cast<int>(packed >> kRangeShift);
+    int end = static_cast<int>(packed & kRangeMask);
+    if (begin >= end) {
+      return false;
+    }
+    if (range->compare_exchange_weak(packed, PackRange(begin, end - 1))) {
+      *task_id = end - 1;
+      return true;
+    }
+  }
+}
+
+bool NextTaskId(Task *task, int index, int *task_id) {
+  if (TakeFront(&task->ranges[index], task_id)) {
+    return true;
+  }
+  for (int i = 1; i < task->range_num; ++i) {
+    if (StealBack(&task->ranges[(index + i) % task->range_num], task_id)) {
+      (void)++task->stolen;
+      return true;
+    }
+  }
+  return false;
+}
+
+void RunStealingTask(Task *task, int index) {
+  float per_scale = kMaxScale / task->task_num;
+  int task_id = 0;
+  while (NextTaskId(task, index, &task_id)) {
+    float lhs_scale = task_id * per_scale;
+    float rhs_scale = task_id == task->task_num - 1 ? kMaxScale : (task_id + 1) * per_scale;
+    task->status |= task->func(task->content, task_id, lhs_scale, rhs_scale);
+    (void)++task->finished;
+  }
+}
+
+void ReleaseStealingTask(Task *task) {
+  if (--task->ref_count == 0) {
+    delete task;
+  }
+}
+
+bool WorkStealingFromEnv() {
+  auto env = std::getenv("MINDRT_WORK_STEALING");
+  return env != nullptr && (std::string(env) == "1" || std::string(env) == "true");
+}
+
+uint64_t NowUs() {
+  return static_cast<uint64_t>(
+    std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count());
+}
+}  // namespace
+
 Worker::~Worker() {
   {
     std::lock_guard<std::mutex> _l(mutex_);
@@ -92,17 +185,43 @@ void Worker::Run() {
 }
 
 bool Worker::RunLocalKernelTask() {
-  Task *task = task_.load(std::memory_order_consume);
+  Task *task = task_.load(std::memory_order_acquire);
   if (task == nullptr) {
     return false;
   }
   int task_id = task_id_.load(std::memory_order_consume);
+  auto busy_begin = BusyTimeBegin();
+  if (task->ranges != nullptr) {
+    // task_id is the index of the range this worker owns
+    RunStealingTask(task, task_id);
+    BusyTimeEnd(busy_begin);
+    task_.store(nullptr, std::memory_order_relaxed);
+    ReleaseStealingTask(task);
+    return true;
+  }
   task->status |= task->func(task->content, task_id, lhs_scale_, rhs_scale_);
+  BusyTimeEnd(busy_begin);
   task_.store(nullptr, std::memory_order_relaxed);
   (void)++task->finished;
   return true;
 }
 
+uint64_t Worker::BusyTimeBegin() {
+  // a kernel task run by an actor thread inside its actor task is nested, only the outermost span is timed
+  if (busy_depth_++ > 0 || !profiling_) {
+    return 0;
+  }
+  return NowUs();
+}
+
+void Worker::BusyTimeEnd(uint64_t begin) {
+  --busy_depth_;
+  if (begin == 0) {
+    return;
+  }
+  busy_time_ += NowUs() - begin;
+}
+
 void Worker::YieldAndDeactive() {
   // deactivate this worker only on the first entry
   if (spin_count_ == 0) {
@@ -127,7 +246,7 @@ void Worker::Active(Task *task, int task_id) {
   {
     std::lock_guard<std::mutex> _l(mutex_);
     task_id_.store(task_id, std::memory_order_relaxed);
-    task_.store(task, std::memory_order_relaxed);
+    task_.store(task, std::memory_order_release);
     status_ = kThreadBusy;
   }
   cond_var_.notify_one();
@@ -147,6 +266,8 @@ bool Worker::available() {
   return status_.compare_exchange_strong(expected, kThreadHeld);
 }
 
+ThreadPool::ThreadPool() : work_stealing_(WorkStealingFromEnv()) {}
+
 ThreadPool::~ThreadPool() {
   for (auto &worker : workers_) {
     delete worker;
@@ -193,6 +314,10 @@ int ThreadPool::ParallelLaunch(const Func &func, Content content, int task_num)
     return THREAD_OK;
   }
 
+  if (work_stealing_) {
+    return ParallelLaunchWithStealing(func, content, task_num);
+  }
+
   // distribute task to the KernelThread and the idle ActorThread,
   // if the task num is greater than the KernelThread num
   THREAD_DEBUG("launch: %d", task_num);
@@ -211,6 +336,45 @@ int ThreadPool::ParallelLaunch(const Func &func, Content content, int task_num)
   return THREAD_OK;
 }
 
+int ThreadPool::ParallelLaunchWithStealing(const Func &func, Content content, int task_num) const {
+  THREAD_DEBUG("launch with stealing: %d", task_num);
+  int sum_frequency = 0;
+  std::vector<Worker *> assigned = ClaimAvailableWorkers(task_num - 1, &sum_frequency);
+  int range_num = static_cast<int>(assigned.size()) + 1;
+  auto task = new (std::nothrow) Task(func, content);
+  if (task != nullptr) {
+    task->ranges.reset(new (std::nothrow) std::atomic<uint64_t>[range_num]);
+  }
+  if (task == nullptr || task->ranges == nullptr) {
+    THREAD_ERROR("malloc task of work stealing failed");
+    delete task;
+    // the claimed workers find no task and turn idle again
+    for (auto worker : assigned) {
+      worker->Active();
+    }
+    return THREAD_ERROR;
+  }
+  // the calling thread owns range 0, every participant starts with an equal share of the ids
+  task->task_num = task_num;
+  task->range_num = range_num;
+  for (int i = 0; i < task->range_num; ++i) {
+    task->ranges[i].store(PackRange(task_num * i / task->range_num, task_num * (i + 1) / task->range_num));
+  }
+  task->ref_count = task->range_num;
+  for (size_t i = 0; i < assigned.size(); ++i) {
+    assigned[i]->Active(task, static_cast<int>(i) + 1);
+  }
+  RunStealingTask(task, 0);
+  // workers that wake up late find nothing left and only drop their reference, no need to wait for them
+  while (task->finished != task_num) {
+    std::this_thread::yield();
+  }
+  int status = task->status;
+  stolen_task_num_ += static_cast<uint64_t>(task->stolen);
+  ReleaseStealingTask(task);
+  return status == THREAD_OK ? THREAD_OK : THREAD_ERROR;
+}
+
 void ThreadPool::SyncRunTask(Task *task, int start_num, int task_num) const {
   // run task sequentially
   // if the current thread is not the actor thread
@@ -228,22 +392,10 @@ void ThreadPool::DistributeTask(Task *task, int task_num) const {
   Worker *curr = CurrentWorker();
   // if the current thread isn't nullptr, that is the curr is a ActorThread,
   // then assign (task_num - 1) tasks to workers, and run the last one by itself
-  int count = 0;
   int num_assigned = curr != nullptr ? task_num - 1 : task_num;
   int sum_frequency = 0;
-  std::vector<Worker *> assigned;
-  int num = static_cast<int>(workers_.size()) - 1;
-  int offset = 0;
-  if (!occupied_actor_thread_) {
-    offset = static_cast<int>(actor_thread_num_);
-  }
-  for (int i = num; i >= offset && count < num_assigned; --i) {
-    if (workers_[i]->available()) {
-      assigned.push_back(workers_[i]);
-      sum_frequency += workers_[i]->frequency();
-      count++;
-    }
-  }
+  std::vector<Worker *> assigned = ClaimAvailableWorkers(num_assigned, &sum_frequency);
+  int count = static_cast<int>(assigned.size());
   // when there are not enough free threads,
   // distribute other tasks to the master thread
   if (curr != nullptr) {
@@ -261,6 +413,26 @@ void ThreadPool::DistributeTask(Task *task, int task_num) const {
   ActiveWorkers(assigned, task, task_num, curr);
 }
 
+std::vector<Worker *> ThreadPool::ClaimAvailableWorkers(int max_num, int *sum_frequency) const {
+  std::vector<Worker *> assigned;
+  int num = static_cast<int>(workers_.size()) - 1;
+  int offset = 0;
+  if (!occupied_actor_thread_) {
+    offset = static_cast<int>(actor_thread_num_);
+  }
+  if (local_worker_range.pool == this) {
+    offset = static_cast<int>(actor_thread_num_) + local_worker_range.begin;
+    num = std::min(num, static_cast<int>(actor_thread_num_) + local_worker_range.end - 1);
+  }
+  for (int i = num; i >= offset && static_cast<int>(assigned.size()) < max_num; --i) {
+    if (workers_[i]->available()) {
+      assigned.push_back(workers_[i]);
+      *sum_frequency += workers_[i]->frequency();
+    }
+  }
+  return assigned;
+}
+
 void ThreadPool::CalculateScales(const std::vector<Worker *> &assigned, int sum_frequency) const {
   // divide task according to computing power(core frequency)
   float lhs_scale = 0;
@@ -295,6 +467,37 @@ void ThreadPool::ActiveWorkers() const {
   }
 }
 
+void ThreadPool::SetWorkerProfiling(bool profiling) const {
+  for (auto &worker : workers_) {
+    worker->set_profiling(profiling);
+  }
+}
+
+std::vector<uint64_t> ThreadPool::WorkerBusyTime() const {
+  std::vector<uint64_t> busy_time;
+  for (auto &worker : workers_) {
+    busy_time.push_back(worker->busy_time());
+  }
+  return busy_time;
+}
+
+void ThreadPool::SetWorkerRangeOfCurrentThread(int begin, int end) const {
+  if (begin < 0) {
+    local_worker_range.pool = nullptr;
+    return;
+  }
+  local_worker_range.pool = this;
+  local_worker_range.begin = begin;
+  local_worker_range.end = end > begin ? end : begin;
+}
+
+size_t ThreadPool::GetKernelThreadNumOfCurrentThread() const {
+  if (local_worker_range.pool != this) {
+    return kernel_thread_num_;
+  }
+  return static_cast<size_t>(local_worker_range.end - local_worker_range.begin) + 1;
+}
+
 Worker *ThreadPool::CurrentWorker() const {
   for (const auto &worker : workers_) {
     if (worker->thread_id() == std::this_thread::get_id()) {
@@ -53,6 +53,15 @@ typedef struct Task {
   Content content;
   std::atomic_int finished{0};
   std::atomic_int status{THREAD_OK};  // return status, RET_OK
+  // work stealing only: task ids are kept as one range [begin, end) per participant, packed begin << 32 | end,
+  // the owner takes ids from the front and idle participants steal from the back.
+  // such a task lives on the heap and is freed by whichever participant drops the last reference
+  std::unique_ptr<std::atomic<uint64_t>[]> ranges;
+  int range_num{0};
+  int task_num{0};
+  std::atomic_int ref_count{0};
+  // ids run by another participant than the owner of their range, counted before they run
+  std::atomic_int stolen{0};
 } Task;
 
 class Worker {
@@ -82,6 +91,10 @@ class Worker {
 
   std::thread::id thread_id() const { return thread_.get_id(); }
 
+  // microseconds spent running tasks, only counted while profiling is on
+  void set_profiling(bool profiling) { profiling_ = profiling; }
+  uint64_t busy_time() const { return busy_time_; }
+
 #ifdef _WIN32
   uint64_t core_id() { return core_id_; }
 #elif defined(BIND_CORE)
@@ -94,6 +107,8 @@ class Worker {
   void Run();
   void YieldAndDeactive();
   void WaitUntilActive();
+  uint64_t BusyTimeBegin();
+  void BusyTimeEnd(uint64_t begin);
 
   bool alive_{true};
   std::thread thread_;
@@ -115,6 +130,10 @@ class Worker {
   int frequency_{kDefaultFrequency};
   int spin_count_{0};
   int max_spin_count_{kMinSpinCount};
+  std::atomic_bool profiling_{false};
+  std::atomic<uint64_t> busy_time_{0};
+  // nesting depth of the timed spans, only touched by the thread of this worker
+  int busy_depth_{0};
 };
 
 class ThreadPool {
@@ -129,6 +148,11 @@ class ThreadPool {
   int SetProcessAffinity(BindMode bind_mode) const;
 
   int ParallelLaunch(const Func &func, Content content, int task_num) const;
+  // launches from the calling thread only take kernel workers [begin, end), counted after the actor threads,
+  // so branches running at the same time do not compete for cores. a negative begin lifts the limit
+  void SetWorkerRangeOfCurrentThread(int begin, int end) const;
+  // threads a launch from the calling thread can use, the calling thread included when a worker range is set
+  size_t GetKernelThreadNumOfCurrentThread() const;
   void DisableOccupiedActorThread() { occupied_actor_thread_ = false; }
   void SetActorThreadNum(size_t actor_thread_num) { actor_thread_num_ = actor_thread_num; }
   void SetKernelThreadNum(size_t kernel_thread_num) { kernel_thread_num_ = kernel_thread_num; }
@@ -138,9 +162,19 @@ class ThreadPool {
   void SetMaxSpinCount(int spin_count);
   void SetMinSpinCount(int spin_count);
   void ActiveWorkers() const;
+  void SetWorkerProfiling(bool profiling) const;
+  std::vector<uint64_t> WorkerBusyTime() const;
+  // let idle threads steal task ids of a launch instead of binding each id to one thread,
+  // also switched on by the environment variable MINDRT_WORK_STEALING=1.
+  // an id is never split further: kernels compute their slice from the id and the task num they launched,
+  // so a launch gets finer chunks only by using more ids than threads
+  void SetWorkStealing(bool work_stealing) { work_stealing_ = work_stealing; }
+  bool work_stealing() const { return work_stealing_; }
+  // task ids stolen over all the launches with work stealing
+  uint64_t stolen_task_num() const { return stolen_task_num_; }
 
  protected:
-  ThreadPool() = default;
+  ThreadPool();
 
   int CreateThreads(size_t thread_num, const std::vector<int> &core_list);
 
@@ -149,6 +183,8 @@ class ThreadPool {
   void SyncRunTask(Task *task, int start_num, int task_num) const;
 
   void DistributeTask(Task *task, int task_num) const;
+  int ParallelLaunchWithStealing(const Func &func, Content content, int task_num) const;
+  std::vector<Worker *> ClaimAvailableWorkers(int max_num, int *sum_frequency) const;
   void CalculateScales(const std::vector<Worker *> &workers, int sum_frequency) const;
   void ActiveWorkers(const std::vector<Worker *> &workers, Task *task, int task_num, const Worker *curr) const;
 
@@ -162,6 +198,8 @@ class ThreadPool {
   bool occupied_actor_thread_{true};
   int max_spin_count_{kDefaultSpinCount};
   int min_spin_count_{kMinSpinCount};
+  bool work_stealing_{false};
+  mutable std::atomic<uint64_t> stolen_task_num_{0};
 };
 }  // namespace luojianet_ms
 #endif  // LUOJIANET_MS_CORE_MINDRT_RUNTIME_THREADPOOL_H_
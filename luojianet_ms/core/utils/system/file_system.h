@@ -30,6 +30,9 @@
 #include "utils/system/base.h"
 #include "utils/log_adapter.h"
 #include "debug/common.h"
+#if defined(SYSTEM_ENV_POSIX)
+#include <unistd.h>
+#endif
 
 namespace luojianet_ms {
 namespace system {
@@ -192,7 +195,16 @@ class PosixWriteFile : public WriteFile {
     return true;
   }
 
-  bool Sync() override { return Flush(); }
+  bool Sync() override {
+    if (!Flush()) {
+      return false;
+    }
+    if (fsync(fileno(file_)) != 0) {
+      MS_LOG(ERROR) << "File(" << file_name_ << ") IO ERROR. " << ErrnoToString(errno);
+      return false;
+    }
+    return true;
+  }
 
  private:
   FILE *file_;
@@ -256,6 +256,30 @@ class MS_API LiteSession {
   /// \param[in] new optimizer params
   /// \return STATUS as an error code of the set operation, STATUS is defined in errorcode.h
   virtual int SetOptimizerParams(const std::vector<tensor::MSTensor *> &params) { return luojianet_ms::lite::RET_ERROR; }
+
+  /// \brief Plan the activation memory into one arena at CompileGraph, it must be called before CompileGraph.
+  ///
+  /// \param[in] enable Define whether to plan the activation memory.
+  ///
+  /// \return STATUS as an error code, RET_NOT_SUPPORT if the session can't plan the memory.
+  virtual int SetMemoryPlan(bool enable) { return luojianet_ms::lite::RET_NOT_SUPPORT; }
+
+  /// \brief Get the activation arena size planned at CompileGraph.
+  ///
+  /// \param[out] planned_size Define bytes of the arena shared by all planned tensors.
+  /// \param[out] naive_size Define bytes needed if every planned tensor had its own memory.
+  ///
+  /// \return STATUS as an error code, RET_NOT_SUPPORT if the graph is not statically planned.
+  virtual int GetMemoryPlanInfo(size_t *planned_size, size_t *naive_size) {
+    return luojianet_ms::lite::RET_NOT_SUPPORT;
+  }
+
+  /// \brief Get how long each thread of the thread pool spent running tasks, counting starts at the first call.
+  ///
+  /// \param[out] busy_time Define microseconds spent running tasks by each thread.
+  ///
+  /// \return STATUS as an error code, RET_NOT_SUPPORT if the session has no thread pool.
+  virtual int GetThreadBusyTime(Vector<uint64_t> *busy_time) { return luojianet_ms::lite::RET_NOT_SUPPORT; }
 };
 }  // namespace session
 }  // namespace luojianet_ms
@@ -57,6 +57,14 @@ static const char *const kMSCache = "ms_cache";
 static const char *const kMSCacheModelPath = "cache_model_path";
 static const char *const kMSCacheVocabSize = "vocab_size";
 static const char *const kMSCacheDeviceSize = "device_cache_size";
+// static memory plan
+static const char *const kMemoryPlan = "memory_plan";
+static const char *const kMemoryPlanEnable = "enable";
+// model load
+static const char *const kModelLoad = "model_load";
+static const char *const kModelLoadMmap = "mmap";
+static const char *const kModelLoadPackCache = "pack_cache";
+static const char *const kPackWeightCacheSuffix = ".packcache";
 }  // namespace lite
 }  // namespace luojianet_ms
 
@@ -24,6 +24,7 @@
 #include <fcntl.h>
 #include <unistd.h>
 #include <dirent.h>
+#include <sys/mman.h>
 #endif
 
 #include <cstdlib>
@@ -193,6 +194,51 @@ char *ReadFile(const char *file, size_t *size) {
   return buf.release();
 }
 
+char *MmapFile(const char *file, size_t *size) {
+#ifdef _WIN32
+  MS_LOG(ERROR) << "Mmap model file is not supported on windows.";
+  return nullptr;
+#else
+  if (file == nullptr) {
+    MS_LOG(ERROR) << "File path is nullptr";
+    return nullptr;
+  }
+  MS_ASSERT(size != nullptr);
+  std::string real_path = RealPath(file);
+  if (real_path.empty()) {
+    MS_LOG(DEBUG) << "File path not regular: " << file;
+    return nullptr;
+  }
+  auto fd = open(real_path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    MS_LOG(ERROR) << "Open file failed: " << real_path;
+    return nullptr;
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+    MS_LOG(ERROR) << "Get size of file failed: " << real_path;
+    close(fd);
+    return nullptr;
+  }
+  *size = static_cast<size_t>(st.st_size);
+  auto buf = mmap(nullptr, *size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (buf == MAP_FAILED) {
+    MS_LOG(ERROR) << "Mmap file failed: " << real_path;
+    return nullptr;
+  }
+  return reinterpret_cast<char *>(buf);
+#endif
+}
+
+void UnmapFile(char *buf, size_t size) {
+#ifndef _WIN32
+  if (buf != nullptr && munmap(buf, size) != 0) {
+    MS_LOG(WARNING) << "Unmap file failed.";
+  }
+#endif
+}
+
 std::string RealPath(const char *path) {
   if (path == nullptr) {
     MS_LOG(ERROR) << "path is nullptr";
@@ -44,6 +44,11 @@ char *ReadFileSegment(const std::string &file, int64_t offset, int64_t len);
 
 char *ReadFile(const char *file, size_t *size);
 
+// map file read-only shared with page cache, writes are private copy-on-write
+char *MmapFile(const char *file, size_t *size);
+
+void UnmapFile(char *buf, size_t size);
+
 std::string RealPath(const char *path);
 
 int CreateOutputDir(std::string *dir);
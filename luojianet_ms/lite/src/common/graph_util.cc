@@ -94,5 +94,17 @@ bool IsPackedOp(int op_type) {
                                               schema::PrimitiveType_MatMulFusion};
   return IsContain(packed_ops, op_type);
 }
+
+bool IsElementwiseOp(int op_type) {
+  static const std::vector<int> elementwise_ops = {
+    schema::PrimitiveType_Activation, schema::PrimitiveType_Abs,       schema::PrimitiveType_Cos,
+    schema::PrimitiveType_Sin,        schema::PrimitiveType_ExpFusion, schema::PrimitiveType_Log,
+    schema::PrimitiveType_Sqrt,       schema::PrimitiveType_Rsqrt,     schema::PrimitiveType_Square,
+    schema::PrimitiveType_Neg,        schema::PrimitiveType_Floor,     schema::PrimitiveType_Ceil,
+    schema::PrimitiveType_Round,      schema::PrimitiveType_AddFusion, schema::PrimitiveType_SubFusion,
+    schema::PrimitiveType_MulFusion,  schema::PrimitiveType_DivFusion, schema::PrimitiveType_Maximum,
+    schema::PrimitiveType_Minimum};
+  return IsContain(elementwise_ops, op_type);
+}
 }  // namespace lite
 }  // namespace luojianet_ms
@@ -35,6 +35,9 @@ using NODE_ID = std::string;
 // only support op_type from current schema
 bool IsPackedOp(int op_type);
 
+// op reads and writes element i only, so its output may overwrite a same-shape input
+bool IsElementwiseOp(int op_type);
+
 std::vector<size_t> GetGraphInputNodes(const lite::Model *model);
 
 std::vector<size_t> GetGraphOutputNodes(const lite::Model *model);
@@ -331,6 +331,15 @@ Status Model::UpdateFeatureMaps(const std::vector<MSTensor> &new_weights) {
   return impl_->UpdateFeatureMaps(new_weights);
 }
 
+Status Model::GetMemoryPlanInfo(size_t *planned_size, size_t *naive_size) const {
+  if ((impl_ == nullptr) || (impl_->session_ == nullptr)) {
+    MS_LOG(ERROR) << "Model is null.";
+    return kLiteUninitializedObj;
+  }
+  auto ret = impl_->session_->GetMemoryPlanInfo(planned_size, naive_size);
+  return static_cast<StatusCode>(ret);
+}
+
 std::vector<MSTensor> Model::GetOptimizerParams() const {
   std::vector<MSTensor> empty;
   if (impl_ == nullptr) {
@@ -29,6 +29,8 @@
 #endif
 
 namespace luojianet_ms::lite {
+class PackWeightCache;
+
 struct InnerContext : public Context {
  public:
   InnerContext() { InitDeviceFp16(); }
@@ -79,6 +81,12 @@ struct InnerContext : public Context {
 
   void SetAllLinkInfo(const std::unordered_map<void *, std::set<void *>> &all_link_info);
 
+  // const weights are still in the mapped model file, pack them at first run instead of at compile
+  bool lazy_pack_weight_ = false;
+
+  // packed weights shared through the sidecar next to the model, owned by the session
+  PackWeightCache *pack_weight_cache_ = nullptr;
+
  private:
   bool IsAllDeviceTypeValid() const;
 
@@ -107,7 +107,11 @@ int LiteModel::ConvertAttrToTensors() {
 
 void LiteModel::Free() {
   if (this->buf != nullptr) {
-    delete[](this->buf);
+    if (buf_mmapped_) {
+      UnmapFile(this->buf, this->buf_size_);
+    } else {
+      delete[](this->buf);
+    }
     this->buf = nullptr;
   }
   auto nodes_size = this->all_nodes_.size();
@@ -34,6 +34,7 @@
 #include "src/common/graph_util.h"
 #include "src/common/tensor_util.h"
 #include "src/common/file_utils.h"
+#include "src/common/common.h"
 #include "src/lite_model.h"
 #include "src/weight_decoder.h"
 #include "src/runtime/runtime_allocator.h"
@@ -1252,9 +1253,28 @@ int LiteSession::RuntimeAllocatorValid() {
   MS_LOG(DEBUG) << "support runtime allocator.";
   return RET_OK;
 #endif
+  if (IsMemoryPlanEnabled()) {
+    MS_LOG(DEBUG) << "runtime allocator enabled by config.";
+    return RET_OK;
+  }
   return RET_ERROR;
 }
 
+bool LiteSession::IsMemoryPlanEnabled() const {
+  if (memory_plan_) {
+    return true;
+  }
+  if (config_info_ == nullptr) {
+    return false;
+  }
+  auto section_iter = config_info_->find(kMemoryPlan);
+  if (section_iter == config_info_->end()) {
+    return false;
+  }
+  auto enable_iter = section_iter->second.find(kMemoryPlanEnable);
+  return enable_iter != section_iter->second.end() && enable_iter->second == "true";
+}
+
 void LiteSession::RuntimeAllocatorInitGraphOutput() {
   AllocatorPtr default_allocator = context_->allocator;
   for (auto graph_out : isolate_graph_output_map_) {
@@ -1271,6 +1291,44 @@ void LiteSession::RuntimeAllocatorInitGraphOutput() {
   return;
 }
 
+lite::Tensor *LiteSession::RuntimeAllocatorInplaceInput(
+  const kernel::LiteKernel *kernel, const std::unordered_map<lite::Tensor *, int> &tensor_ref_count,
+  const std::unordered_map<size_t, int> &data_ref_count) {
+  /* in-place aliasing changes which buffers outputs live in, so it only follows the memory plan config */
+  if (!IsMemoryPlanEnabled()) {
+    return nullptr;
+  }
+  if (!IsElementwiseOp(static_cast<int>(kernel->type())) || kernel->out_tensors().size() != 1) {
+    return nullptr;
+  }
+  auto out_tensor = kernel->out_tensors().front();
+  if (out_tensor->allocator() != context_->allocator) {
+    return nullptr;
+  }
+  for (auto in_tensor : kernel->in_tensors()) {
+    /* broadcast inputs are read at other indexes than the one being written */
+    if (in_tensor->shape() != out_tensor->shape()) {
+      return nullptr;
+    }
+  }
+  for (auto in_tensor : kernel->in_tensors()) {
+    /* the same shape in another format, such as NC4HW4 and NHWC, puts the elements at other offsets */
+    if (in_tensor->allocator() != runtime_allocator_ || in_tensor->data_type() != out_tensor->data_type() ||
+        in_tensor->format() != out_tensor->format() || in_tensor->Size() != out_tensor->Size() ||
+        IsContain(outputs_, in_tensor)) {
+      continue;
+    }
+    /* this kernel must be the last reader of the whole block */
+    auto tensor_iter = tensor_ref_count.find(in_tensor);
+    auto data_iter = data_ref_count.find(runtime_allocator_->GetBlockId(in_tensor));
+    if (tensor_iter != tensor_ref_count.end() && tensor_iter->second == 1 && data_iter != data_ref_count.end() &&
+        data_iter->second == 1) {
+      return in_tensor;
+    }
+  }
+  return nullptr;
+}
+
 void LiteSession::RuntimeAllocatorInitSubgraph() {
   AllocatorPtr default_allocator = context_->allocator;
   std::unordered_map<lite::Tensor *, int> tensor_ref_count;
@@ -1290,15 +1348,15 @@ void LiteSession::RuntimeAllocatorInitSubgraph() {
         in_tensor->set_allocator(src_t->allocator());
         if (src_t->allocator() == runtime_allocator_) {
           tensor_ref_count[in_tensor] = in_tensor->init_ref_count();
-          data_ref_count[runtime_allocator_->GetOffsetMap().at(src_t)] += in_tensor->init_ref_count();
-          runtime_allocator_->SetDataOffset(in_tensor, runtime_allocator_->GetOffsetMap().at(src_t));
+          data_ref_count[runtime_allocator_->GetBlockId(src_t)] += in_tensor->init_ref_count();
+          runtime_allocator_->ShareTensorData(in_tensor, src_t);
         }
       } else {
         if (in_tensor->allocator() == default_allocator) {
           in_tensor->set_allocator(runtime_allocator_);
           runtime_allocator_->MallocTensorData(in_tensor);
           tensor_ref_count[in_tensor] = in_tensor->init_ref_count();
-          data_ref_count[runtime_allocator_->GetOffsetMap().at(in_tensor)] = in_tensor->init_ref_count();
+          data_ref_count[runtime_allocator_->GetBlockId(in_tensor)] = in_tensor->init_ref_count();
         }
       }
 
@@ -1307,10 +1365,10 @@ void LiteSession::RuntimeAllocatorInitSubgraph() {
       }
 
       tensor_ref_count[src_t]--;
-      data_ref_count[runtime_allocator_->GetOffsetMap().at(src_t)]--;
+      data_ref_count[runtime_allocator_->GetBlockId(src_t)]--;
 
       if (tensor_ref_count[src_t] <= 0) {
-        if (data_ref_count[runtime_allocator_->GetOffsetMap().at(src_t)] <= 0) {
+        if (data_ref_count[runtime_allocator_->GetBlockId(src_t)] <= 0) {
           runtime_allocator_->FreeTensorData(src_t);
         }
       }
@@ -1318,27 +1376,37 @@ void LiteSession::RuntimeAllocatorInitSubgraph() {
 
     auto kernel_list = reinterpret_cast<kernel::SubGraphKernel *>(subgraph)->nodes();
     for (auto kernel : kernel_list) {
+      /* elementwise kernel may write its output over the input it reads for the last time */
+      auto inplace_tensor = RuntimeAllocatorInplaceInput(kernel, tensor_ref_count, data_ref_count);
+
       /* malloc for output */
       for (auto tensor : kernel->out_tensors()) {
         if (tensor->allocator() != default_allocator) {
           continue;
         }
         tensor->set_allocator(runtime_allocator_);
+        if (inplace_tensor != nullptr) {
+          runtime_allocator_->ShareTensorData(tensor, inplace_tensor);
+          tensor_ref_count[inplace_tensor] = 0;
+          tensor_ref_count[tensor] = tensor->init_ref_count();
+          data_ref_count[runtime_allocator_->GetBlockId(tensor)] = tensor->init_ref_count();
+          continue;
+        }
         runtime_allocator_->MallocTensorData(tensor);
         tensor_ref_count[tensor] = tensor->init_ref_count();
-        data_ref_count[runtime_allocator_->GetOffsetMap().at(tensor)] = tensor->init_ref_count();
+        data_ref_count[runtime_allocator_->GetBlockId(tensor)] = tensor->init_ref_count();
       }
 
       /* free input after run */
       for (auto tensor : kernel->in_tensors()) {
-        if (tensor->allocator() != runtime_allocator_) {
+        if (tensor->allocator() != runtime_allocator_ || tensor == inplace_tensor) {
           continue;
         }
         tensor_ref_count[tensor]--;
-        data_ref_count[runtime_allocator_->GetOffsetMap().at(tensor)]--;
+        data_ref_count[runtime_allocator_->GetBlockId(tensor)]--;
 
         if (tensor_ref_count[tensor] <= 0 && tensor->allocator() == runtime_allocator_) {
-          if (data_ref_count[runtime_allocator_->GetOffsetMap().at(tensor)] <= 0) {
+          if (data_ref_count[runtime_allocator_->GetBlockId(tensor)] <= 0) {
             runtime_allocator_->FreeTensorData(tensor);
           }
         }
@@ -1371,6 +1439,38 @@ int LiteSession::RuntimeAllocatorInit() {
     MS_LOG(ERROR) << "using optimize allocator failed.";
     return ret;
   }
+  MS_LOG(INFO) << "Static memory plan: planned " << runtime_allocator_->planned_size() << " bytes, naive "
+               << runtime_allocator_->naive_size() << " bytes, lower bound " << runtime_allocator_->lower_bound_size()
+               << " bytes.";
+  return RET_OK;
+}
+
+int LiteSession::GetMemoryPlanInfo(size_t *planned_size, size_t *naive_size) {
+  if (planned_size == nullptr || naive_size == nullptr) {
+    return RET_NULL_PTR;
+  }
+  if (runtime_allocator_ == nullptr || RuntimeAllocatorValid() != RET_OK) {
+    return RET_NOT_SUPPORT;
+  }
+  *planned_size = runtime_allocator_->planned_size();
+  *naive_size = runtime_allocator_->naive_size();
+  return RET_OK;
+}
+
+int LiteSession::GetThreadBusyTime(Vector<uint64_t> *busy_time) {
+  if (busy_time == nullptr) {
+    return RET_NULL_PTR;
+  }
+  auto thread_pool = context_ == nullptr ? nullptr : context_->thread_pool();
+  if (thread_pool == nullptr) {
+    return RET_NOT_SUPPORT;
+  }
+  // workers only time their tasks once asked, so the first call starts counting
+  thread_pool->SetWorkerProfiling(true);
+  busy_time->clear();
+  for (auto time : thread_pool->WorkerBusyTime()) {
+    busy_time->push_back(time);
+  }
   return RET_OK;
 }
 
@@ -1593,26 +1693,92 @@ int lite::LiteSession::LoadModelAndCompileByBuf(const char *model_buf, luojianet
   return RET_OK;
 }
 
+char *lite::LiteSession::LoadModelByMmap(const std::string &file, size_t *size) {
+  auto model_buf = lite::MmapFile(file.c_str(), size);
+  if (model_buf == nullptr) {
+    return nullptr;
+  }
+  flatbuffers::Verifier verify(reinterpret_cast<const uint8_t *>(model_buf), *size);
+  if (lite::LiteModel::VersionVerify(&verify) == SCHEMA_INVALID) {
+    MS_LOG(INFO) << "The model file is not a mslite model, mmap is not used.";
+    lite::UnmapFile(model_buf, *size);
+    return nullptr;
+  }
+  return model_buf;
+}
+
 int lite::LiteSession::LoadModelAndCompileByPath(const std::string &model_path, luojianet_ms::ModelType model_type) {
   size_t model_size;
-  auto model_buf = LoadModelByPath(model_path, model_type, &model_size);
+  const char *model_buf = nullptr;
+  bool use_mmap = IsModelLoadOptionEnabled(kModelLoadMmap);
+  if (use_mmap) {
+    model_buf = LoadModelByMmap(model_path, &model_size);
+    use_mmap = model_buf != nullptr;
+  }
+  if (model_buf == nullptr) {
+    model_buf = LoadModelByPath(model_path, model_type, &model_size);
+  }
   if (model_buf == nullptr) {
     MS_LOG(ERROR) << "Read model file failed";
     return RET_ERROR;
   }
+  if (IsModelLoadOptionEnabled(kModelLoadPackCache)) {
+    InitPackWeightCache(model_path, model_buf, model_size);
+  }
   auto *model = lite::ImportFromBuffer(model_buf, model_size, true);
   if (model == nullptr) {
     MS_LOG(ERROR) << "Import model failed";
+    if (use_mmap) {
+      lite::UnmapFile(const_cast<char *>(model_buf), model_size);
+    }
     return RET_ERROR;
   }
 
   (reinterpret_cast<lite::LiteModel *>(model))->set_keep_model_buf(true);
+  (reinterpret_cast<lite::LiteModel *>(model))->set_buf_mmapped(use_mmap);
+  // a sidecar being recorded needs every weight packed during compile
+  bool recording = pack_weight_cache_ != nullptr && !pack_weight_cache_->loaded();
+  context_->lazy_pack_weight_ = use_mmap && !recording;
   auto ret = CompileGraph(model);
   if (ret != lite::RET_OK) {
     MS_LOG(ERROR) << "Compile model failed";
     return RET_ERROR;
   }
+  if (recording) {
+    SavePackWeightCache(model_path);
+  }
   set_model(model);
   return RET_OK;
 }
+
+bool lite::LiteSession::IsModelLoadOptionEnabled(const char *option) const {
+  if (config_info_ == nullptr) {
+    return false;
+  }
+  auto section_iter = config_info_->find(kModelLoad);
+  if (section_iter == config_info_->end()) {
+    return false;
+  }
+  auto option_iter = section_iter->second.find(option);
+  return option_iter != section_iter->second.end() && option_iter->second == "true";
+}
+
+void lite::LiteSession::InitPackWeightCache(const std::string &model_path, const char *model_buf, size_t model_size) {
+  pack_weight_cache_ = std::make_unique<PackWeightCache>();
+  model_fingerprint_ = PackWeightCache::Fingerprint(model_buf, model_size);
+  auto ret = pack_weight_cache_->Load(model_path + kPackWeightCacheSuffix, model_fingerprint_);
+  if (ret == RET_OK) {
+    MS_LOG(INFO) << "Use packed weights from " << model_path << kPackWeightCacheSuffix;
+  }
+  context_->pack_weight_cache_ = pack_weight_cache_.get();
+}
+
+void lite::LiteSession::SavePackWeightCache(const std::string &model_path) {
+  if (pack_weight_cache_->record_num() > 0) {
+    (void)pack_weight_cache_->Save(model_path + kPackWeightCacheSuffix, model_fingerprint_);
+  }
+  // kernels keep their own packed weights, the recorded copies are only needed for the file
+  context_->pack_weight_cache_ = nullptr;
+  pack_weight_cache_.reset();
+}
 }  // namespace luojianet_ms
@@ -30,6 +30,7 @@
 #include "src/lite_model.h"
 #include "src/inner_context.h"
 #include "src/runtime/runtime_allocator.h"
+#include "src/runtime/pack_weight_cache.h"
 #include "schema/model_generated.h"
 #include "src/executor.h"
 #include "src/tensor.h"
@@ -62,6 +63,8 @@ class LiteSession : public session::LiteSession {
                                               size_t *size, luojianet_ms::ModelType model_type);
   static const char *LoadModelByPath(const std::string &file, luojianet_ms::ModelType model_type, size_t *size);
 
+  static char *LoadModelByMmap(const std::string &file, size_t *size);
+
   virtual int Init(InnerContext *context);
 
   void BindThread(bool if_bind) override;
@@ -103,6 +106,13 @@ class LiteSession : public session::LiteSession {
 
   const std::vector<Tensor *> &GetTensors() const { return this->tensors_; }
 
+  int SetMemoryPlan(bool enable) override {
+    memory_plan_ = enable;
+    return RET_OK;
+  }
+  int GetMemoryPlanInfo(size_t *planned_size, size_t *naive_size) override;
+  int GetThreadBusyTime(Vector<uint64_t> *busy_time) override;
+
  protected:
   static void ConvertTensorsQuantParam(const schema::Tensor *src_tensor, lite::Tensor *dst_tensor);
 
@@ -169,8 +179,17 @@ class LiteSession : public session::LiteSession {
   int RuntimeAllocatorSetData();
   void RuntimeAllocatorInitGraphOutput();
   void RuntimeAllocatorInitSubgraph();
+  lite::Tensor *RuntimeAllocatorInplaceInput(const kernel::LiteKernel *kernel,
+                                             const std::unordered_map<lite::Tensor *, int> &tensor_ref_count,
+                                             const std::unordered_map<size_t, int> &data_ref_count);
+  bool IsMemoryPlanEnabled() const;
+  bool IsModelLoadOptionEnabled(const char *option) const;
+  void InitPackWeightCache(const std::string &model_path, const char *model_buf, size_t model_size);
+  void SavePackWeightCache(const std::string &model_path);
   virtual int RuntimeAllocatorValid();
   RuntimeAllocatorPtr runtime_allocator_ = nullptr;
+  std::unique_ptr<PackWeightCache> pack_weight_cache_ = nullptr;
+  uint64_t model_fingerprint_ = 0;
 
  protected:
   InnerContext *context_ = nullptr;
@@ -207,6 +226,7 @@ class LiteSession : public session::LiteSession {
   int delegate_device_type_ = -1;  // -1: not specified; 0: CPU; 1: GPU; 2: NPU
   std::map<std::string, TypeId> *execution_plan_ = nullptr;
   const std::map<std::string, std::map<std::string, std::string>> *config_info_ = nullptr;
+  bool memory_plan_ = false;
 };
 }  // namespace lite
 }  // namespace luojianet_ms
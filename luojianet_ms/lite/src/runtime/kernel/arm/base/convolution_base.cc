@@ -19,6 +19,7 @@
 #include <cfloat>
 #include "schema/model_generated.h"
 #include "src/kernel_registry.h"
+#include "src/runtime/pack_weight_cache.h"
 
 using luojianet_ms::lite::KernelRegistrar;
 using luojianet_ms::lite::RET_ERROR;
@@ -48,7 +49,9 @@ void ConvolutionBaseCPUKernel::FreeAlignedData(void **ptr) {
 }
 
 ConvolutionBaseCPUKernel::~ConvolutionBaseCPUKernel() {
-  if (addr_map.find(reinterpret_cast<uintptr_t>(packed_weight_)) != addr_map.end()) {
+  if (packed_weight_from_cache_) {
+    packed_weight_ = nullptr;
+  } else if (addr_map.find(reinterpret_cast<uintptr_t>(packed_weight_)) != addr_map.end()) {
     FreeAlignedData(reinterpret_cast<void **>(&packed_weight_));
   } else if (!op_parameter_->is_train_session_) {
     if (packed_weight_ != nullptr) {
@@ -151,16 +154,70 @@ int ConvolutionBaseCPUKernel::InitConvWeightBias() {
     MS_ASSERT(in_tensors_.size() == kInputSize1);
   }
   if (!op_parameter_->is_train_session_) {
-    if (origin_weight_ != nullptr) {
-      PackWeight();
-    } else {
+    if (origin_weight_ == nullptr) {
       is_repack_ = true;
       MS_LOG(WARNING) << "The weight is nullptr, will pack in runtime.";
+    } else if (LoadPackedWeightFromCache()) {
+      MS_LOG(DEBUG) << "Convolution op " << this->name() << " uses the packed weight from cache.";
+    } else if (IsLazyPack()) {
+      is_repack_ = true;
+      MS_LOG(DEBUG) << "The weight is in mapped model file, will pack in runtime.";
+    } else {
+      PackWeight();
+      RecordPackedWeight();
     }
   }
   return RET_OK;
 }
 
+std::string ConvolutionBaseCPUKernel::PackedWeightCacheKey() const {
+  auto layout = PackedWeightLayout();
+  if (layout.empty() || packed_weight_size_ == 0) {
+    return "";
+  }
+  return this->name() + "|" + layout + "|" + lite::PackWeightCache::IsaTag();
+}
+
+bool ConvolutionBaseCPUKernel::LoadPackedWeightFromCache() {
+  if (ctx_ == nullptr || ctx_->pack_weight_cache_ == nullptr || !ctx_->pack_weight_cache_->loaded()) {
+    return false;
+  }
+  auto key = PackedWeightCacheKey();
+  if (key.empty()) {
+    return false;
+  }
+  auto cached = ctx_->pack_weight_cache_->Find(key, packed_weight_size_);
+  if (cached == nullptr) {
+    return false;
+  }
+  if (addr_map.find(reinterpret_cast<uintptr_t>(packed_weight_)) != addr_map.end()) {
+    FreeAlignedData(&packed_weight_);
+  } else if (packed_weight_ != nullptr) {
+    free(packed_weight_);
+  }
+  packed_weight_ = cached;
+  packed_weight_from_cache_ = true;
+  return true;
+}
+
+void ConvolutionBaseCPUKernel::RecordPackedWeight() {
+  if (ctx_ == nullptr || ctx_->pack_weight_cache_ == nullptr || ctx_->pack_weight_cache_->loaded()) {
+    return;
+  }
+  auto key = PackedWeightCacheKey();
+  if (key.empty() || packed_weight_ == nullptr) {
+    return;
+  }
+  (void)ctx_->pack_weight_cache_->Record(key, packed_weight_, packed_weight_size_);
+}
+
+bool ConvolutionBaseCPUKernel::IsLazyPack() const {
+  // only weight read straight from the model buffer stays valid until the first run
+  auto weight_tensor = in_tensors_.at(kWeightIndex);
+  return ctx_ != nullptr && ctx_->lazy_pack_weight_ && !weight_tensor->own_data() &&
+         origin_weight_ == weight_tensor->data();
+}
+
 int ConvolutionBaseCPUKernel::RepackWeight() {
   if (origin_weight_ == nullptr && in_tensors_.at(kWeightIndex)->data() == nullptr) {
     MS_LOG(ERROR) << "Convolution op " << this->name() << " weight data is nullptr.";
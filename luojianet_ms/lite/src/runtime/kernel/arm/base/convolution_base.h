@@ -75,9 +75,17 @@ class ConvolutionBaseCPUKernel : public InnerKernel {
 
   virtual int MallocWeightBiasData() { return RET_OK; }
   virtual void PackWeight() {}
+  // tiling of packed_weight_ beyond the isa, empty means the packed weight is not cached
+  virtual std::string PackedWeightLayout() const { return ""; }
   bool IsRepack() { return is_repack_; }
+  bool IsLazyPack() const;
+  std::string PackedWeightCacheKey() const;
+  bool LoadPackedWeightFromCache();
+  void RecordPackedWeight();
   std::unordered_map<uintptr_t, void *> addr_map;
   void *packed_weight_ = nullptr;
+  size_t packed_weight_size_ = 0;
+  bool packed_weight_from_cache_ = false;  // points into the mapped sidecar, do not free
   void *bias_data_ = nullptr;
   const InnerContext *ctx_ = nullptr;
   ConvParameter *conv_param_ = nullptr;
@@ -199,6 +199,8 @@ void ConvolutionCPUKernel::PackWeight() {
 #endif
 }
 
+std::string ConvolutionCPUKernel::PackedWeightLayout() const { return "conv_col" + std::to_string(OC_BLOCK); }
+
 int ConvolutionCPUKernel::MallocWeightBiasData() {
   auto filter_tensor = in_tensors_.at(kWeightIndex);
   int32_t in_channel = filter_tensor->Channel();
@@ -217,6 +219,7 @@ int ConvolutionCPUKernel::MallocWeightBiasData() {
       return RET_ERROR;
     }
     memset(packed_weight_, 0, pack_weight_size * sizeof(float));
+    packed_weight_size_ = pack_weight_size * sizeof(float);
   }
 
   if (bias_data_ == nullptr) {
@@ -19,6 +19,7 @@
 #define LUOJIANET_MS_LITE_SRC_RUNTIME_KERNEL_ARM_FP32_CONVOLUTION_FP32_H_
 
 #include <vector>
+#include <string>
 #include "src/inner_kernel.h"
 #include "nnacl/op_base.h"
 #include "src/runtime/kernel/arm/base/convolution_base.h"
@@ -41,6 +42,7 @@ class ConvolutionCPUKernel : public ConvolutionBaseCPUKernel {
  protected:
   int MallocWeightBiasData() override;
   void PackWeight() override;
+  std::string PackedWeightLayout() const override;
   void FreeTmpBuffer() {
     if (packed_input_ != nullptr) {
       ctx_->allocator->Free(packed_input_);
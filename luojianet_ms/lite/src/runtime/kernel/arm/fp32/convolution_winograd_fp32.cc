@@ -188,6 +188,10 @@ int ConvolutionWinogradCPUKernel::Run() {
   return ret;
 }
 
+std::string ConvolutionWinogradCPUKernel::PackedWeightLayout() const {
+  return "winograd_unit" + std::to_string(input_unit_) + "_oc" + std::to_string(oc_block_);
+}
+
 int ConvolutionWinogradCPUKernel::MallocWeightBiasData() {
   auto filter_tensor = in_tensors_.at(kWeightIndex);
   int in_channel = filter_tensor->Channel();
@@ -216,6 +220,7 @@ int ConvolutionWinogradCPUKernel::MallocWeightBiasData() {
       }
     }
     memset(packed_weight_, 0, trans_matrix_data_size);
+    packed_weight_size_ = trans_matrix_data_size;
   }
 
   float matrix_a[64];
@@ -19,6 +19,7 @@
 #define LUOJIANET_MS_LITE_SRC_RUNTIME_KERNEL_ARM_FP32_CONVOLUTION_WINOGRAD_FP32_H_
 
 #include <vector>
+#include <string>
 #include "src/inner_kernel.h"
 #include "nnacl/fp32/winograd_transform.h"
 #include "nnacl/base/minimal_filtering_generator.h"
@@ -46,6 +47,7 @@ class ConvolutionWinogradCPUKernel : public ConvolutionBaseCPUKernel {
  private:
   int MallocWeightBiasData() override;
   void PackWeight() override;
+  std::string PackedWeightLayout() const override;
   void FreeTmpBuffer() {
     if (trans_input_ != nullptr) {
       ctx_->allocator->Free(trans_input_);
@@ -54,6 +54,14 @@ int DeConvolutionCPUKernel::ReSize() {
   return RET_OK;
 }
 
+std::string DeConvolutionCPUKernel::PackedWeightLayout() const {
+#ifdef ENABLE_AVX
+  return "deconv_cx";
+#else
+  return "deconv_c8";
+#endif
+}
+
 int DeConvolutionCPUKernel::MallocWeightBiasData() {
   auto weight_tensor = in_tensors_.at(kWeightIndex);
   auto input_channel = weight_tensor->Batch();
@@ -68,6 +76,7 @@ int DeConvolutionCPUKernel::MallocWeightBiasData() {
       MS_LOG(ERROR) << "deconv malloc packed_weight_ error!";
       return RET_ERROR;
     }
+    packed_weight_size_ = pack_weight_size;
   }
 
   bias_data_ = MallocAlignedData(C32NUM, output_aligned_size * sizeof(float));
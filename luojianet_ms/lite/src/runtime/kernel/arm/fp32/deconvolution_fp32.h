@@ -20,6 +20,7 @@
 
 #include <float.h>
 #include <vector>
+#include <string>
 #include "src/inner_kernel.h"
 #include "src/kernel_registry.h"
 #include "include/errorcode.h"
@@ -50,6 +51,7 @@ class DeConvolutionCPUKernel : public ConvolutionBaseCPUKernel {
   int InitParam();
   int MallocWeightBiasData() override;
   void PackWeight() override;
+  std::string PackedWeightLayout() const override;
 
  private:
   MatMulParameter *matmul_param_ = nullptr;
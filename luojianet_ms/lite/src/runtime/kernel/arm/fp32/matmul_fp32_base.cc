@@ -19,6 +19,7 @@
 #include <algorithm>
 #include "nnacl/fp32/matmul_fp32.h"
 #include "nnacl/fp32/pack_fp32.h"
+#include "src/runtime/pack_weight_cache.h"
 #ifdef ENABLE_AVX512
 #include "nnacl/fp32/matmul_avx512_fp32.h"
 #endif
@@ -202,7 +203,7 @@ void MatmulFp32BaseCPUKernel::FreeResizeBufA() {
 }
 
 void MatmulFp32BaseCPUKernel::FreeResizeBufB() {
-  if (!op_parameter_->is_train_session_ && b_pack_ptr_ != nullptr && is_pack_) {
+  if (!op_parameter_->is_train_session_ && b_pack_ptr_ != nullptr && is_pack_ && !b_pack_from_cache_) {
     ms_context_->allocator->Free(b_pack_ptr_);
   }
   b_pack_ptr_ = nullptr;
@@ -371,6 +372,9 @@ int MatmulFp32BaseCPUKernel::Prepare() {
   if (params_->b_const_) {
     auto b_tensor = in_tensors_[1];
     CHECK_NULL_RETURN(b_tensor);
+    if (LoadMatrixBFromCache()) {
+      return RET_OK;
+    }
     if (InitBufferB() != RET_OK) {
       return RET_ERROR;
     }
@@ -378,10 +382,41 @@ int MatmulFp32BaseCPUKernel::Prepare() {
       MS_LOG(ERROR) << "InitMatrixB failed!";
       return RET_ERROR;
     }
+    auto cache = static_cast<const lite::InnerContext *>(this->ms_context_)->pack_weight_cache_;
+    auto key = PackedMatrixBCacheKey();
+    if (cache != nullptr && !cache->loaded() && !key.empty()) {
+      (void)cache->Record(key, b_pack_ptr_, static_cast<size_t>(matrix_b_pack_size_) * sizeof(float));
+    }
   }
   return RET_OK;
 }
 
+std::string MatmulFp32BaseCPUKernel::PackedMatrixBCacheKey() const {
+  if (op_parameter_->is_train_session_ || matrix_b_pack_size_ <= 0) {
+    return "";
+  }
+  return this->name() + "|matmul_col" + std::to_string(col_tile_) + (params_->b_transpose_ ? "_t" : "_n") + "|" +
+         lite::PackWeightCache::IsaTag();
+}
+
+bool MatmulFp32BaseCPUKernel::LoadMatrixBFromCache() {
+  auto cache = static_cast<const lite::InnerContext *>(this->ms_context_)->pack_weight_cache_;
+  if (cache == nullptr || !cache->loaded() || b_pack_ptr_ != nullptr) {
+    return false;
+  }
+  auto key = PackedMatrixBCacheKey();
+  if (key.empty()) {
+    return false;
+  }
+  auto cached = cache->Find(key, static_cast<size_t>(matrix_b_pack_size_) * sizeof(float));
+  if (cached == nullptr) {
+    return false;
+  }
+  b_pack_ptr_ = reinterpret_cast<float *>(cached);
+  b_pack_from_cache_ = true;
+  return true;
+}
+
 int MatmulFp32BaseCPUKernel::ReSize() {
   ResizeParameter();
   matrix_a_pack_size_ = a_batch_ * params_->row_align_ * params_->deep_;
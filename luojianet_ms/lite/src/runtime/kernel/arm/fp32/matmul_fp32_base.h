@@ -19,6 +19,7 @@
 #define LUOJIANET_MS_LITE_SRC_RUNTIME_KERNEL_ARM_FP32_MATMUL_FP32_BASE_H_
 
 #include <vector>
+#include <string>
 #include "src/inner_kernel.h"
 #include "nnacl/matmul_parameter.h"
 #include "include/errorcode.h"
@@ -72,6 +73,8 @@ class MatmulFp32BaseCPUKernel : public InnerKernel {
   int CalBroadCastBiasDataElements();
   int InitTmpOutBuffer();
   void GetThreadCuttingPolicy();
+  std::string PackedMatrixBCacheKey() const;
+  bool LoadMatrixBFromCache();
 
  protected:
   MatMulParameter *params_ = nullptr;
@@ -100,6 +103,7 @@ class MatmulFp32BaseCPUKernel : public InnerKernel {
   MatrixPackFun matrix_a_pack_fun_ = nullptr;
   MatrixPackFun matrix_b_pack_fun_ = nullptr;
   bool batch_split_ = false;
+  bool b_pack_from_cache_ = false;  // points into the mapped sidecar, do not free
   bool out_need_aligned_ = false;
   int col_step_ = 0;
 #if defined(ENABLE_AVX) || defined(ENABLE_AVX512)
@@ -0,0 +1,235 @@
+/**
+ * Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+ * Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "src/runtime/pack_weight_cache.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include "include/errorcode.h"
+#include "src/common/file_utils.h"
+#include "src/common/log_adapter.h"
+
+namespace luojianet_ms::lite {
+namespace {
+constexpr uint32_t kPackCacheMagic = 0x4350534d;  // "MSPC"
+// version 2 fingerprints the whole model, sidecars keyed by the head and tail of it are rebuilt
+constexpr uint32_t kPackCacheVersion = 2;
+constexpr size_t kPackCacheAlign = 64;
+constexpr uint64_t kFnvOffset = 14695981039346656037ULL;
+constexpr uint64_t kFnvPrime = 1099511628211ULL;
+constexpr size_t kHashLanes = 4;
+constexpr uint64_t kLaneMul = 0x9E3779B97F4A7C15ULL;
+constexpr uint64_t kLaneMix = 0xC2B2AE3D27D4EB4FULL;
+constexpr int kLaneRotate = 31;
+
+struct PackCacheHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint64_t fingerprint;
+  uint64_t entry_num;
+};
+
+size_t AlignUp(size_t value) { return (value + kPackCacheAlign - 1) / kPackCacheAlign * kPackCacheAlign; }
+
+uint64_t Fnv1a(uint64_t hash, const char *buf, size_t size) {
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= static_cast<uint8_t>(buf[i]);
+    hash *= kFnvPrime;
+  }
+  return hash;
+}
+
+uint64_t MixWord(uint64_t lane, uint64_t word) {
+  lane ^= word * kLaneMul;
+  lane = (lane << kLaneRotate) | (lane >> (64 - kLaneRotate));
+  return lane * kLaneMix;
+}
+
+// hash 8 byte words in independent lanes, which runs at memory speed on models of hundreds of MB
+uint64_t HashContent(uint64_t hash, const char *buf, size_t size) {
+  uint64_t lanes[kHashLanes] = {hash, hash ^ kLaneMul, hash ^ kLaneMix, hash ^ kFnvPrime};
+  constexpr size_t kStride = kHashLanes * sizeof(uint64_t);
+  size_t pos = 0;
+  for (; pos + kStride <= size; pos += kStride) {
+    uint64_t words[kHashLanes];
+    memcpy(words, buf + pos, kStride);
+    for (size_t i = 0; i < kHashLanes; ++i) {
+      lanes[i] = MixWord(lanes[i], words[i]);
+    }
+  }
+  for (size_t i = 0; i < kHashLanes; ++i) {
+    hash = Fnv1a(hash, reinterpret_cast<const char *>(&lanes[i]), sizeof(lanes[i]));
+  }
+  return Fnv1a(hash, buf + pos, size - pos);
+}
+
+template <typename T>
+bool ReadValue(const char *buf, size_t buf_size, size_t *pos, T *value) {
+  if (*pos > buf_size || buf_size - *pos < sizeof(T)) {
+    return false;
+  }
+  memcpy(value, buf + *pos, sizeof(T));
+  *pos += sizeof(T);
+  return true;
+}
+}  // namespace
+
+PackWeightCache::~PackWeightCache() {
+  if (mapped_buf_ != nullptr) {
+    UnmapFile(mapped_buf_, mapped_size_);
+    mapped_buf_ = nullptr;
+  }
+}
+
+const char *PackWeightCache::IsaTag() {
+#if defined(ENABLE_AVX512)
+  return "avx512";
+#elif defined(ENABLE_AVX)
+  return "avx";
+#elif defined(ENABLE_SSE)
+  return "sse";
+#elif defined(ENABLE_ARM64)
+  return "neon64";
+#elif defined(ENABLE_ARM32)
+  return "neon32";
+#else
+  return "c";
+#endif
+}
+
+uint64_t PackWeightCache::Fingerprint(const char *buf, size_t size) {
+  uint64_t hash = Fnv1a(kFnvOffset, reinterpret_cast<const char *>(&size), sizeof(size));
+  if (buf == nullptr) {
+    return hash;
+  }
+  // a retrained model keeps its size and often its head and tail, so every byte of the weights is hashed
+  return HashContent(hash, buf, size);
+}
+
+int PackWeightCache::Load(const std::string &path, uint64_t fingerprint) {
+  if (mapped_buf_ != nullptr) {
+    MS_LOG(ERROR) << "Pack weight cache is already loaded.";
+    return RET_ERROR;
+  }
+  std::ifstream probe(path);
+  if (!probe.good()) {
+    MS_LOG(INFO) << "Pack weight cache " << path << " does not exist.";
+    return RET_NO_CHANGE;
+  }
+  probe.close();
+  size_t size = 0;
+  auto buf = MmapFile(path.c_str(), &size);
+  if (buf == nullptr) {
+    return RET_ERROR;
+  }
+  size_t pos = 0;
+  PackCacheHeader header;
+  if (!ReadValue(buf, size, &pos, &header) || header.magic != kPackCacheMagic ||
+      header.version != kPackCacheVersion || header.fingerprint != fingerprint) {
+    MS_LOG(WARNING) << "Pack weight cache " << path << " does not match the model, it is ignored.";
+    UnmapFile(buf, size);
+    return RET_ERROR;
+  }
+  index_.clear();
+  for (uint64_t i = 0; i < header.entry_num; ++i) {
+    uint32_t key_len = 0;
+    uint64_t offset = 0;
+    uint64_t data_size = 0;
+    if (!ReadValue(buf, size, &pos, &key_len) || key_len > size - pos) {
+      break;
+    }
+    std::string key(buf + pos, key_len);
+    pos += key_len;
+    if (!ReadValue(buf, size, &pos, &offset) || !ReadValue(buf, size, &pos, &data_size) || offset > size ||
+        data_size > size - offset) {
+      break;
+    }
+    index_[key] = std::make_pair(static_cast<size_t>(offset), static_cast<size_t>(data_size));
+  }
+  if (index_.size() != header.entry_num) {
+    MS_LOG(WARNING) << "Pack weight cache " << path << " is damaged, it is ignored.";
+    index_.clear();
+    UnmapFile(buf, size);
+    return RET_ERROR;
+  }
+  mapped_buf_ = buf;
+  mapped_size_ = size;
+  return RET_OK;
+}
+
+void *PackWeightCache::Find(const std::string &key, size_t size) const {
+  if (mapped_buf_ == nullptr) {
+    return nullptr;
+  }
+  auto iter = index_.find(key);
+  if (iter == index_.end() || iter->second.second != size) {
+    return nullptr;
+  }
+  return mapped_buf_ + iter->second.first;
+}
+
+int PackWeightCache::Record(const std::string &key, const void *data, size_t size) {
+  if (data == nullptr || size == 0) {
+    return RET_PARAM_INVALID;
+  }
+  auto src = reinterpret_cast<const char *>(data);
+  records_[key] = std::vector<char>(src, src + size);
+  return RET_OK;
+}
+
+int PackWeightCache::Save(const std::string &path, uint64_t fingerprint) const {
+  PackCacheHeader header = {kPackCacheMagic, kPackCacheVersion, fingerprint, records_.size()};
+  size_t index_size = sizeof(header);
+  for (auto &record : records_) {
+    index_size += sizeof(uint32_t) + record.first.size() + sizeof(uint64_t) + sizeof(uint64_t);
+  }
+  // write aside and rename, so sessions starting concurrently never map a half written sidecar
+  std::string tmp_path = path + ".tmp";
+  std::ofstream ofs(tmp_path, std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!ofs.good()) {
+    MS_LOG(WARNING) << "Open " << tmp_path << " for pack weight cache failed.";
+    return RET_ERROR;
+  }
+  ofs.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  uint64_t offset = AlignUp(index_size);
+  for (auto &record : records_) {
+    auto key_len = static_cast<uint32_t>(record.first.size());
+    uint64_t data_size = record.second.size();
+    ofs.write(reinterpret_cast<const char *>(&key_len), sizeof(key_len));
+    ofs.write(record.first.data(), key_len);
+    ofs.write(reinterpret_cast<const char *>(&offset), sizeof(offset));
+    ofs.write(reinterpret_cast<const char *>(&data_size), sizeof(data_size));
+    offset = AlignUp(offset + data_size);
+  }
+  const char padding[kPackCacheAlign] = {0};
+  size_t written = index_size;
+  for (auto &record : records_) {
+    ofs.write(padding, AlignUp(written) - written);
+    ofs.write(record.second.data(), record.second.size());
+    written = AlignUp(written) + record.second.size();
+  }
+  ofs.close();
+  if (!ofs.good() || std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+    MS_LOG(WARNING) << "Write pack weight cache " << path << " failed.";
+    (void)std::remove(tmp_path.c_str());
+    return RET_ERROR;
+  }
+  MS_LOG(INFO) << "Write " << records_.size() << " packed weights to " << path;
+  return RET_OK;
+}
+}  // namespace luojianet_ms::lite
@@ -0,0 +1,61 @@
+/**
+ * Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+ * Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LUOJIANET_MS_LITE_SRC_RUNTIME_PACK_WEIGHT_CACHE_H_
+#define LUOJIANET_MS_LITE_SRC_RUNTIME_PACK_WEIGHT_CACHE_H_
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace luojianet_ms::lite {
+/* Sidecar file of weights already packed by cpu kernels, stored next to the model.
+ * Layout: header | index (key, offset, size) | payloads, each payload aligned to 64 bytes.
+ * A session either maps an existing sidecar and hands the payloads to kernels, or records what the
+ * kernels packed during compile and writes the sidecar once the graph is compiled. */
+class PackWeightCache {
+ public:
+  PackWeightCache() = default;
+  ~PackWeightCache();
+
+  // map the sidecar, fails when it is missing, damaged or made for another model
+  int Load(const std::string &path, uint64_t fingerprint);
+  int Save(const std::string &path, uint64_t fingerprint) const;
+
+  // returns nullptr when the key is absent or was packed with another size
+  void *Find(const std::string &key, size_t size) const;
+  int Record(const std::string &key, const void *data, size_t size);
+
+  bool loaded() const { return mapped_buf_ != nullptr; }
+  size_t record_num() const { return records_.size(); }
+
+  static uint64_t Fingerprint(const char *buf, size_t size);
+  // the packed layouts differ between instruction sets, the tag keeps sidecars from being shared across them
+  static const char *IsaTag();
+
+ private:
+  char *mapped_buf_ = nullptr;
+  size_t mapped_size_ = 0;
+  std::unordered_map<std::string, std::pair<size_t, size_t>> index_;
+  std::map<std::string, std::vector<char>> records_;
+};
+}  // namespace luojianet_ms::lite
+
+#endif  // LUOJIANET_MS_LITE_SRC_RUNTIME_PACK_WEIGHT_CACHE_H_
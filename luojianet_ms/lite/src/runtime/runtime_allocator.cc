@@ -16,6 +16,10 @@
  */
 
 #include "src/runtime/runtime_allocator.h"
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include "src/common/log_adapter.h"
 
 namespace luojianet_ms {
 RuntimeAllocator::RuntimeAllocator(size_t aligned_size) {
@@ -31,58 +35,130 @@ RuntimeAllocator::~RuntimeAllocator() {
 }
 
 void *RuntimeAllocator::MallocOptData() {
+  if (Plan() != lite::RET_OK) {
+    return nullptr;
+  }
   if (data_ == nullptr) {
     data_ = malloc(total_size_);
   }
   return data_;
 }
 
-size_t RuntimeAllocator::FindMinFree(size_t size) {
-  size_t min_size = total_size_ + 1;
-  size_t min_addr = total_size_ + 1;
-  for (auto const &itr : free_list_) {
-    if (itr.second >= size && min_size > itr.second) {
-      min_size = itr.second;
-      min_addr = itr.first;
-    }
-  }
-  return min_addr;
+void RuntimeAllocator::MallocTensorData(lite::Tensor *tensor) {
+  MemBlock block;
+  block.size = AlignSize(tensor->Size());
+  block.start = event_++;
+  block.end = SIZE_MAX;
+  block_map_[tensor] = blocks_.size();
+  blocks_.push_back(block);
+  planned_ = false;
 }
 
 void RuntimeAllocator::FreeTensorData(lite::Tensor *tensor) {
-  size_t offset = offset_map_[tensor];
-  free_list_[offset] = used_list_[offset];
-  used_list_.erase(offset);
+  auto iter = block_map_.find(tensor);
+  if (iter == block_map_.end()) {
+    return;
+  }
+  blocks_[iter->second].end = event_++;
+  planned_ = false;
+}
 
-  size_t length = free_list_[offset];
+void RuntimeAllocator::ShareTensorData(lite::Tensor *dst, lite::Tensor *src) {
+  auto id = block_map_.at(src);
+  blocks_[id].size = std::max(blocks_[id].size, AlignSize(dst->Size()));
+  block_map_[dst] = id;
+  planned_ = false;
+}
 
-  size_t post_offset = offset + length;
-  auto post_iter = free_list_.find(post_offset);
-  if (post_iter != free_list_.end()) {
-    size_t post_length = post_iter->second;
-    free_list_[offset] = length + post_length;
-    free_list_.erase(post_offset);
+size_t RuntimeAllocator::FindBestFit(const MemBlock &block, const std::vector<size_t> &placed) const {
+  /* only blocks alive at the same time constrain the offset */
+  std::vector<const MemBlock *> conflicts;
+  for (auto id : placed) {
+    auto &other = blocks_[id];
+    if (other.start < block.end && block.start < other.end) {
+      conflicts.push_back(&other);
+    }
   }
+  std::sort(conflicts.begin(), conflicts.end(),
+            [](const MemBlock *a, const MemBlock *b) { return a->offset < b->offset; });
 
-  auto pre_iter = free_list_.lower_bound(offset);
-  if (pre_iter != free_list_.begin()) {
-    pre_iter--;
-    size_t pre_offset = pre_iter->first;
-    if ((pre_offset + free_list_[pre_offset]) == offset) {
-      free_list_[pre_offset] = free_list_[pre_offset] + length;
-      free_list_.erase(offset);
+  size_t best_offset = SIZE_MAX;
+  size_t best_gap = SIZE_MAX;
+  size_t prev_end = 0;
+  for (auto other : conflicts) {
+    if (other->offset > prev_end) {
+      size_t gap = other->offset - prev_end;
+      if (gap >= block.size && gap < best_gap) {
+        best_gap = gap;
+        best_offset = prev_end;
+      }
     }
+    prev_end = std::max(prev_end, other->offset + other->size);
   }
+  return best_offset == SIZE_MAX ? prev_end : best_offset;
 }
 
-void RuntimeAllocator::SetDataOffset(lite::Tensor *tensor, size_t offset) {
-  offset_map_[tensor] = offset;
-  return;
+int RuntimeAllocator::Plan() {
+  if (planned_) {
+    return lite::RET_OK;
+  }
+  if (data_ != nullptr) {
+    MS_LOG(ERROR) << "Arena has been allocated, can not plan again.";
+    return lite::RET_ERROR;
+  }
+
+  /* live bytes per event, the max of it is the lower bound of any plan */
+  std::vector<int64_t> delta(event_ + 1, 0);
+  naive_size_ = 0;
+  for (auto &block : blocks_) {
+    naive_size_ += block.size;
+    delta[block.start] += static_cast<int64_t>(block.size);
+    if (block.end != SIZE_MAX) {
+      delta[block.end] -= static_cast<int64_t>(block.size);
+    }
+  }
+  int64_t live = 0;
+  lower_bound_size_ = 0;
+  for (auto d : delta) {
+    live += d;
+    lower_bound_size_ = std::max(lower_bound_size_, static_cast<size_t>(live));
+  }
+
+  /* greedy by size: the largest blocks are placed first, each into the tightest gap left by its neighbours */
+  std::vector<size_t> order(blocks_.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+    if (blocks_[a].size != blocks_[b].size) {
+      return blocks_[a].size > blocks_[b].size;
+    }
+    return blocks_[a].start < blocks_[b].start;
+  });
+
+  total_size_ = 0;
+  std::vector<size_t> placed;
+  placed.reserve(blocks_.size());
+  for (auto id : order) {
+    auto &block = blocks_[id];
+    block.offset = FindBestFit(block, placed);
+    total_size_ = std::max(total_size_, block.offset + block.size);
+    placed.push_back(id);
+  }
+
+  offset_map_.clear();
+  for (auto &iter : block_map_) {
+    offset_map_[iter.first] = blocks_[iter.second].offset;
+  }
+  planned_ = true;
+  return lite::RET_OK;
 }
 
 void RuntimeAllocator::Clear(AllocatorPtr default_allocator) {
   total_size_ = 0;
-  for (auto iter : offset_map_) {
+  naive_size_ = 0;
+  lower_bound_size_ = 0;
+  event_ = 0;
+  planned_ = false;
+  for (auto iter : block_map_) {
     iter.first->set_allocator(default_allocator);
     iter.first->set_data(nullptr);
   }
@@ -90,35 +166,8 @@ void RuntimeAllocator::Clear(AllocatorPtr default_allocator) {
     free(data_);
     data_ = nullptr;
   }
+  blocks_.clear();
+  block_map_.clear();
   offset_map_.clear();
-  free_list_.clear();
-  used_list_.clear();
-}
-
-void RuntimeAllocator::MallocTensorData(lite::Tensor *tensor) {
-  size_t size = tensor->Size();
-  size_t offset = FindMinFree(size);
-
-  if (offset > total_size_) {
-    if (free_list_.empty()) {
-      offset = total_size_;
-    } else {
-      offset = free_list_.rbegin()->first;
-      if (offset + free_list_[offset] < total_size_) {
-        offset = total_size_;
-      } else {
-        free_list_.erase(offset);
-      }
-    }
-    total_size_ = offset + size;
-  } else {
-    if (free_list_[offset] > size) {
-      free_list_[offset + size] = free_list_[offset] - size;
-    }
-    free_list_.erase(offset);
-  }
-
-  used_list_[offset] = size;
-  offset_map_[tensor] = offset;
 }
 }  // namespace luojianet_ms
@@ -20,12 +20,16 @@
 
 #include <memory>
 #include <map>
+#include <vector>
 #include <unordered_map>
 #include "include/api/allocator.h"
 #include "include/errorcode.h"
 #include "src/tensor.h"
 
 namespace luojianet_ms {
+/* Tensors are recorded as blocks in execution order while the graph is walked once at compile time.
+ * The arena offsets are solved afterwards (greedy-by-size, best-fit), so the plan sees every lifetime
+ * instead of only the allocations made so far. */
 class RuntimeAllocator : public Allocator {
  public:
   explicit RuntimeAllocator(size_t aligned_size = 32);
@@ -40,22 +44,42 @@ class RuntimeAllocator : public Allocator {
   int DecRefCount(void *ptr, int ref_count) override { return 0; }
 
  public:
-  void SetDataOffset(lite::Tensor *tensor, size_t offset);
   void MallocTensorData(lite::Tensor *tensor);
   void FreeTensorData(lite::Tensor *tensor);
+  void ShareTensorData(lite::Tensor *dst, lite::Tensor *src);
+  size_t GetBlockId(lite::Tensor *tensor) const { return block_map_.at(tensor); }
+  int Plan();
   void *MallocOptData();
   const std::unordered_map<lite::Tensor *, size_t> &GetOffsetMap() const { return offset_map_; }
   void Clear(AllocatorPtr default_allocator);
 
+  /* arena size chosen by the planner */
+  size_t planned_size() const { return total_size_; }
+  /* arena size if every block had its own memory */
+  size_t naive_size() const { return naive_size_; }
+  /* max bytes alive at the same time, no plan can go below it */
+  size_t lower_bound_size() const { return lower_bound_size_; }
+
  private:
-  size_t FindMinFree(size_t size);
+  struct MemBlock {
+    size_t size = 0;
+    size_t offset = 0;
+    size_t start = 0; /* event index of malloc */
+    size_t end = 0;   /* event index of free, SIZE_MAX if never freed */
+  };
+  size_t AlignSize(size_t size) const { return (size + aligned_size_ - 1) / aligned_size_ * aligned_size_; }
+  size_t FindBestFit(const MemBlock &block, const std::vector<size_t> &placed) const;
 
  private:
   void *data_ = nullptr;
   size_t total_size_ = 0;
-  std::unordered_map<lite::Tensor *, size_t> offset_map_;
-  std::map<size_t, size_t> free_list_; /* offset, size */
-  std::map<size_t, size_t> used_list_; /* offset, size */
+  size_t naive_size_ = 0;
+  size_t lower_bound_size_ = 0;
+  size_t event_ = 0;
+  bool planned_ = false;
+  std::vector<MemBlock> blocks_;
+  std::unordered_map<lite::Tensor *, size_t> block_map_;  /* tensor, block id */
+  std::unordered_map<lite::Tensor *, size_t> offset_map_; /* tensor, offset in arena */
 };
 
 using RuntimeAllocatorPtr = std::shared_ptr<RuntimeAllocator>;
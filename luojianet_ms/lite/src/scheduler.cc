@@ -257,6 +257,7 @@ int Scheduler::SchedulePreProcess() {
     auto search_sub_graph =
       SearchSubGraph(context_, src_model_, src_tensors_, &op_parameters_, &graph_output_node_indexes_);
     search_sub_graph.SubGraphSplit();
+    branch_worker_ranges_ = search_sub_graph.worker_ranges();
 #else
     MS_LOG(ERROR) << unsupport_auto_parallel_log;
     return RET_NOT_SUPPORT;
@@ -1200,6 +1201,11 @@ kernel::LiteKernel *Scheduler::SchedulePartialToKernel(const lite::Model::Node *
     return {};
   }
   subgraph_kernel->set_name("subgraph_" + std::to_string(subgraph_index));
+  auto range_iter = branch_worker_ranges_.find(subgraph_index);
+  if (range_iter != branch_worker_ranges_.end() && subgraph_kernel->subgraph_type() != kernel::kNotSubGraph) {
+    reinterpret_cast<kernel::SubGraphKernel *>(subgraph_kernel)
+      ->set_worker_range(range_iter->second.first, range_iter->second.second);
+  }
   return subgraph_kernel;
 }
 
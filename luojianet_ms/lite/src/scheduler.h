@@ -178,6 +178,8 @@ class Scheduler {
   int schema_version_ = SCHEMA_VERSION::SCHEMA_CUR;
   std::map<std::string, TypeId> *execution_plan_ = nullptr;
   const std::map<std::string, std::map<std::string, std::string>> *config_info_ = nullptr;
+  // kernel workers reserved for each branch the parallel split produced, keyed by subgraph index
+  std::map<int, std::pair<int, int>> branch_worker_ranges_;
 };
 }  // namespace luojianet_ms::lite
 
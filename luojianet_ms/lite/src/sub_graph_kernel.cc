@@ -212,15 +212,24 @@ int CpuSubGraph::Prepare() {
 
 int CpuSubGraph::Execute(const KernelCallBack &before, const KernelCallBack &after) {
   MS_ASSERT(this->Context()->allocator.get() != nullptr);
+  auto thread_pool = this->Context()->thread_pool();
+  bool limit_workers = worker_begin_ >= 0 && thread_pool != nullptr;
+  if (limit_workers) {
+    thread_pool->SetWorkerRangeOfCurrentThread(worker_begin_, worker_end_);
+  }
 
+  auto ret = RET_OK;
   for (auto *kernel : nodes_) {
     MS_ASSERT(kernel != nullptr);
-    auto ret = kernel->Execute(before, after);
+    ret = kernel->Execute(before, after);
     if (ret != RET_OK) {
       MS_LOG(ERROR) << "run kernel failed, name: " << kernel->name();
-      return ret;
+      break;
     }
   }
-  return RET_OK;
+  if (limit_workers) {
+    thread_pool->SetWorkerRangeOfCurrentThread(-1, -1);
+  }
+  return ret;
 }
 }  // namespace luojianet_ms::kernel
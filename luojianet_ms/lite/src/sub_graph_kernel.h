@@ -110,6 +110,12 @@ class SubGraphKernel : public LiteKernel {
 
   void SetSchemaVersion(int schema_version) { schema_version_ = schema_version; }
 
+  // kernel workers of the thread pool this subgraph runs on when it is a branch executed in parallel
+  void set_worker_range(int begin, int end) {
+    worker_begin_ = begin;
+    worker_end_ = end;
+  }
+
  protected:
   std::vector<LiteKernel *> nodes_{};
   // entry nodes in nodes
@@ -118,6 +124,8 @@ class SubGraphKernel : public LiteKernel {
   std::vector<LiteKernel *> out_nodes_{};
   luojianet_ms::lite::Executor *executor_ = nullptr;
   int schema_version_ = lite::SCHEMA_VERSION::SCHEMA_CUR;
+  int worker_begin_ = -1;
+  int worker_end_ = -1;
 };
 
 class CpuSubGraph : public SubGraphKernel {
@@ -16,6 +16,7 @@
  */
 
 #include "src/sub_graph_split.h"
+#include <cmath>
 #include <cstdlib>
 #include <utility>
 #include <algorithm>
@@ -30,6 +31,7 @@
 #include "nnacl/pooling_parameter.h"
 #include "include/model.h"
 #include "nnacl/base/conv_common_base.h"
+#include "nnacl/matmul_parameter.h"
 
 namespace {
 constexpr const int kMaxDepth = 2048;
@@ -37,8 +39,8 @@ constexpr const int kMaxDepth = 2048;
 
 namespace luojianet_ms::lite {
 size_t CommConvMul(std::vector<int> weight_shape, std::vector<int> output_shape) {
-  size_t cost = output_shape[NHWC_N] * output_shape[NHWC_H] * output_shape[NHWC_W] * output_shape[NHWC_C] *
-                weight_shape[NHWC_H] * weight_shape[NHWC_W] * weight_shape[NHWC_C];
+  size_t cost = static_cast<size_t>(output_shape[NHWC_N]) * output_shape[NHWC_H] * output_shape[NHWC_W] *
+                output_shape[NHWC_C] * weight_shape[NHWC_H] * weight_shape[NHWC_W] * weight_shape[NHWC_C];
   return cost;
 }
 
@@ -48,11 +50,22 @@ size_t WinogradConvMul() {
 }
 
 size_t CommConvdwMul(std::vector<int> weight_shape, std::vector<int> output_shape) {
-  size_t cost = static_cast<size_t>(output_shape[NHWC_N] * output_shape[NHWC_H] * output_shape[NHWC_W] *
-                                    output_shape[NHWC_C] * weight_shape[NHWC_H] * weight_shape[NHWC_W]);
+  size_t cost = static_cast<size_t>(output_shape[NHWC_N]) * output_shape[NHWC_H] * output_shape[NHWC_W] *
+                output_shape[NHWC_C] * weight_shape[NHWC_H] * weight_shape[NHWC_W];
   return cost;
 }
 
+size_t ShapeElementsNum(const std::vector<int> &shape) {
+  size_t num = 1;
+  for (auto dim : shape) {
+    if (dim < 0) {
+      return 0;
+    }
+    num *= static_cast<size_t>(dim);
+  }
+  return num;
+}
+
 size_t WinogradConvDwMul() {
   /* winograd convdw */
   return 0;
@@ -122,24 +135,25 @@ bool SearchSubGraph::CheckIsParallelSubGraph(const std::vector<Subgraph> &subgra
   return true;
 }
 
-void SearchSubGraph::dfs(int i, int n, int current_sum, int except_value, int *min_value, std::vector<bool> *tmp_group,
-                         std::vector<bool> *cor_group, std::vector<Subgraph> *sub_graphs) {
+void SearchSubGraph::dfs(int i, int n, int64_t current_sum, int64_t except_value, int64_t *min_value,
+                         std::vector<bool> *tmp_group, std::vector<bool> *cor_group,
+                         std::vector<Subgraph> *sub_graphs) {
   if (i > kMaxDepth) {
     return;
   }
   if (i == n) {
-    if (abs(except_value - current_sum) < *min_value) {
+    if (std::llabs(except_value - current_sum) < *min_value) {
       for (int j = 0; j < n; j++) {
         cor_group->at(j) = tmp_group->at(j);
       }
     }
-    *min_value = MSMIN(*min_value, abs(except_value - current_sum));
+    *min_value = MSMIN(*min_value, std::llabs(except_value - current_sum));
     return;
   }
 
   {
     tmp_group->at(i) = true;
-    int next_sum = current_sum + sub_graphs->at(i).cost_.cost();
+    int64_t next_sum = current_sum + sub_graphs->at(i).cost_.cost();
     dfs(i + 1, n, next_sum, except_value, min_value, tmp_group, cor_group, sub_graphs);
   }
 
@@ -197,6 +211,41 @@ SearchSubGraph::CostModel SearchSubGraph::CalculateConv2DFusion(const Model::Nod
   return cost;
 }
 
+SearchSubGraph::CostModel SearchSubGraph::CalculateMatMul(const Model::Node *node) {
+  CostModel cost;
+  std::vector<uint32_t> inputs = node->input_indices_;
+  std::vector<uint32_t> outputs = node->output_indices_;
+  std::vector<int> a_shape = src_tensors_->at(inputs[0])->shape();
+  std::vector<int> b_shape = src_tensors_->at(inputs[1])->shape();
+  if (a_shape.empty() || b_shape.size() < kDefaultSubGraphSize) {
+    return cost;
+  }
+
+  size_t deep = 0;
+  if (GetPrimitiveType(node->primitive_, SCHEMA_VERSION::SCHEMA_CUR) == schema::PrimitiveType_FullConnection) {
+    /* weight of full connection is [col, deep] */
+    deep = static_cast<size_t>(b_shape.back());
+  } else {
+    auto param = reinterpret_cast<MatMulParameter *>(op_parameters_->at(outputs[0]));
+    deep = static_cast<size_t>(param->a_transpose_ ? a_shape[a_shape.size() - kDefaultSubGraphSize] : a_shape.back());
+  }
+  cost.mul_cost_ = ShapeElementsNum(src_tensors_->at(outputs[0])->shape()) * deep;
+  return cost;
+}
+
+SearchSubGraph::CostModel SearchSubGraph::CalculateConv2dTranspose(const Model::Node *node) {
+  CostModel cost;
+  std::vector<uint32_t> inputs = node->input_indices_;
+  std::vector<int> weight_shape = src_tensors_->at(inputs[1])->shape();
+  if (weight_shape.size() != DIMENSION_4D || weight_shape[NHWC_N] <= 0) {
+    return cost;
+  }
+  /* every input element is scattered to kernel_h * kernel_w * output_channel outputs */
+  cost.mul_cost_ = ShapeElementsNum(src_tensors_->at(inputs[0])->shape()) * ShapeElementsNum(weight_shape) /
+                   static_cast<size_t>(weight_shape[NHWC_N]);
+  return cost;
+}
+
 const schema::Primitive *SearchSubGraph::CreatePartialPrimitive(int64_t subgraph_index) {
   flatbuffers::FlatBufferBuilder fbb(1024);
   auto val_offset = schema::CreatePartialFusion(fbb, subgraph_index);
@@ -230,6 +279,12 @@ void SearchSubGraph::ConvertSubGraphToModel(std::vector<Subgraph> *sub_graphs) {
     DeviceType device_type = subgraph.device_;
     size_t thread_num = subgraph.thread_;
     int new_sub_index = static_cast<int>(model_->sub_graphs_.size());
+    if (major_dt_ == DT_CPU && device_type == DT_CPU) {
+      /* the actor thread of each branch runs one task itself, the rest go to disjoint kernel workers */
+      int major_workers = static_cast<int>(major_thread_) - 1;
+      int begin = subgraph.tid_ == 0 ? 0 : major_workers;
+      worker_ranges_[new_sub_index] = std::make_pair(begin, begin + static_cast<int>(thread_num) - 1);
+    }
     int partial_index = static_cast<int>(model_->all_nodes_.size());
     int particial_replace_index = partial_index;
 
@@ -692,13 +747,14 @@ void SearchSubGraph::InitSubgraphRuntimeInfo(std::vector<Subgraph> *sub_graphs)
   tmp_group.resize(sub_graphs->size());
   cor_group.resize(sub_graphs->size());
 
-  int except_value = static_cast<int>(total_cost_ * kDefaultGpu); /* major device responsible for 50% calculation */
-  int min_value = INT32_MAX;
+  /* major device responsible for 50% calculation */
+  auto except_value = static_cast<int64_t>(static_cast<double>(total_cost_) * kDefaultGpu);
+  int64_t min_value = INT64_MAX;
 
   dfs(0, static_cast<int>(sub_graphs->size()), 0, except_value, &min_value, &tmp_group, &cor_group, sub_graphs);
 
   /* make bigger half using major_dt_ */
-  int true_value = 0;
+  int64_t true_value = 0;
   for (size_t i = 0; i < sub_graphs->size(); i++) {
     if (cor_group.at(i)) {
       true_value += sub_graphs->at(i).cost_.cost();
@@ -707,6 +763,15 @@ void SearchSubGraph::InitSubgraphRuntimeInfo(std::vector<Subgraph> *sub_graphs)
 
   if (true_value < except_value) {
     (void)std::transform(cor_group.begin(), cor_group.end(), cor_group.begin(), [](bool value) { return !value; });
+    true_value = static_cast<int64_t>(total_cost_) - true_value;
+  }
+
+  if (major_dt_ == DT_CPU && minor_dt_ == DT_CPU && total_cost_ > 0 && context_->thread_num_ > 1) {
+    /* both halves share the cpu, give each a share of the cores that follows its flops */
+    auto thread_num = static_cast<size_t>(context_->thread_num_);
+    auto major_thread = static_cast<size_t>(std::lround(static_cast<double>(thread_num) * true_value / total_cost_));
+    major_thread_ = std::min(std::max(major_thread, static_cast<size_t>(1)), thread_num - 1);
+    minor_thread_ = thread_num - major_thread_;
   }
 
   for (size_t i = 0; i < sub_graphs->size(); i++) {
@@ -778,12 +843,19 @@ void SearchSubGraph::CalculateCostModel(std::vector<Subgraph> *sub_graphs) {
     std::vector<uint32_t> nodes = subgraph.nodes_;
     for (uint32_t node_index : nodes) {
       CostModel cost;
-      cost.io_cost_ = 0;
-      cost.mul_cost_ = 1;
-
       Model::Node *node = model_->all_nodes_[node_index];
-      if (GetPrimitiveType(node->primitive_, SCHEMA_VERSION::SCHEMA_CUR) == schema::PrimitiveType_Conv2DFusion) {
+      auto type = GetPrimitiveType(node->primitive_, SCHEMA_VERSION::SCHEMA_CUR);
+      if (type == schema::PrimitiveType_Conv2DFusion) {
         cost = CalculateConv2DFusion(node);
+      } else if (type == schema::PrimitiveType_MatMulFusion || type == schema::PrimitiveType_FullConnection) {
+        cost = CalculateMatMul(node);
+      } else if (type == schema::PrimitiveType_Conv2dTransposeFusion) {
+        cost = CalculateConv2dTranspose(node);
+      }
+      if (cost.mul_cost_ == 0) {
+        /* memory bound node, counted by the elements it writes */
+        cost.io_cost_ = std::max(ShapeElementsNum(src_tensors_->at(node->output_indices_.at(0))->shape()),
+                                 static_cast<size_t>(1));
       }
 
       subgraph.cost_ = subgraph.cost_ + cost;
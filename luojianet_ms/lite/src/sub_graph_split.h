@@ -23,6 +23,7 @@
 #include <map>
 #include <set>
 #include <unordered_map>
+#include <utility>
 #include "include/model.h"
 #include "src/lite_kernel.h"
 #include "src/lite_model.h"
@@ -64,7 +65,7 @@ class SearchSubGraph {
       result.io_cost_ = this->io_cost_ - cost.io_cost_;
       return result;
     }
-    int cost() { return io_cost_ + mul_cost_; }
+    int64_t cost() { return static_cast<int64_t>(io_cost_ + mul_cost_); }
     void empty() {
       io_cost_ = 0;
       mul_cost_ = 0;
@@ -89,6 +90,8 @@ class SearchSubGraph {
 
  public:
   void SubGraphSplit();
+  /* kernel worker range [begin, end) of each cpu branch split out of the main graph, keyed by subgraph index */
+  const std::map<int, std::pair<int, int>> &worker_ranges() const { return worker_ranges_; }
 
  private: /* split by output */
   void SubGraphSplitByOutput();
@@ -130,7 +133,9 @@ class SearchSubGraph {
 
  private: /* public cost-model func  */
   CostModel CalculateConv2DFusion(const Model::Node *node);
-  void dfs(int i, int n, int current_sum, int except_value, int *min_value, std::vector<bool> *tmp_group,
+  CostModel CalculateMatMul(const Model::Node *node);
+  CostModel CalculateConv2dTranspose(const Model::Node *node);
+  void dfs(int i, int n, int64_t current_sum, int64_t except_value, int64_t *min_value, std::vector<bool> *tmp_group,
            std::vector<bool> *cor_group, std::vector<Subgraph> *sub_graphs);
 
  private:
@@ -149,6 +154,7 @@ class SearchSubGraph {
   size_t minor_thread_;
   size_t total_cost_ = 0;
   bool offline_parallel_enable_ = false;
+  std::map<int, std::pair<int, int>> worker_ranges_;
 };
 }  // namespace luojianet_ms::lite
 
@@ -0,0 +1,283 @@
+/**
+ * Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+ * Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "schema/inner/model_generated.h"
+#include "common/common_test.h"
+#include "include/context.h"
+#include "include/errorcode.h"
+#include "src/common/common.h"
+#include "src/common/file_utils.h"
+#include "src/lite_session.h"
+
+namespace luojianet_ms {
+namespace {
+constexpr int kPixelNum = 4;
+constexpr int kInChannel = 4;
+constexpr int kOutChannel = 2;
+using ConfigInfo = std::map<std::string, std::map<std::string, std::string>>;
+
+// a 1x1 convolution of a 1x2x2x4 input with all weights 1
+std::string BuildConvModel() {
+  auto meta_graph = std::make_unique<schema::MetaGraphT>();
+  meta_graph->name = "graph";
+  auto node = std::make_unique<schema::CNodeT>();
+  node->inputIndex = {0, 1};
+  node->outputIndex = {2};
+  node->primitive = std::make_unique<schema::PrimitiveT>();
+  node->primitive->value.type = schema::PrimitiveType_Conv2DFusion;
+  auto primitive = new schema::Conv2DFusionT;
+  primitive->pad_mode = schema::PadMode_SAME;
+  primitive->in_channel = kInChannel;
+  primitive->out_channel = kOutChannel;
+  primitive->group = 1;
+  primitive->format = schema::Format_NHWC;
+  primitive->stride = std::vector<int64_t>{1, 1};
+  primitive->kernel_size = std::vector<int64_t>{1, 1};
+  primitive->dilation = std::vector<int64_t>{1, 1};
+  node->primitive->value.value = primitive;
+  node->name = "conv";
+  meta_graph->nodes.emplace_back(std::move(node));
+  meta_graph->inputIndex = {0};
+  meta_graph->outputIndex = {2};
+
+  auto input = std::make_unique<schema::TensorT>();
+  input->nodeType = lite::NodeType_Parameter;
+  input->format = schema::Format_NHWC;
+  input->dataType = TypeId::kNumberTypeFloat32;
+  input->dims = {1, 2, 2, kInChannel};
+  input->offset = -1;
+  meta_graph->allTensors.emplace_back(std::move(input));
+
+  auto weight = std::make_unique<schema::TensorT>();
+  weight->nodeType = lite::NodeType_ValueNode;
+  weight->format = schema::Format_KHWC;
+  weight->dataType = TypeId::kNumberTypeFloat32;
+  weight->dims = {kOutChannel, 1, 1, kInChannel};
+  std::vector<float> weight_data(kOutChannel * kInChannel, 1.0f);
+  weight->data.resize(weight_data.size() * sizeof(float));
+  memcpy(weight->data.data(), weight_data.data(), weight->data.size());
+  weight->offset = -1;
+  meta_graph->allTensors.emplace_back(std::move(weight));
+
+  auto output = std::make_unique<schema::TensorT>();
+  output->nodeType = lite::NodeType_Parameter;
+  output->format = schema::Format_NHWC;
+  output->dataType = TypeId::kNumberTypeFloat32;
+  output->dims = {1, 2, 2, kOutChannel};
+  output->offset = -1;
+  meta_graph->allTensors.emplace_back(std::move(output));
+
+  flatbuffers::FlatBufferBuilder builder(1024);
+  auto offset = schema::MetaGraph::Pack(builder, meta_graph.get());
+  builder.Finish(offset);
+  return std::string(reinterpret_cast<char *>(builder.GetBufferPointer()), builder.GetSize());
+}
+
+void WriteFile(const std::string &path, const std::string &content) {
+  std::ofstream ofs(path, std::ios::binary);
+  ofs.write(content.data(), static_cast<std::streamsize>(content.size()));
+}
+
+// address ranges [begin, end) of the mappings of the file, as listed in /proc/self/maps
+std::vector<std::pair<uintptr_t, uintptr_t>> FileMappings(const std::string &real_path) {
+  std::vector<std::pair<uintptr_t, uintptr_t>> mappings;
+  std::ifstream maps("/proc/self/maps");
+  std::string line;
+  while (std::getline(maps, line)) {
+    if (line.size() < real_path.size() ||
+        line.compare(line.size() - real_path.size(), real_path.size(), real_path) != 0) {
+      continue;
+    }
+    uintptr_t begin = 0;
+    uintptr_t end = 0;
+    char dash = 0;
+    std::istringstream range(line);
+    range >> std::hex >> begin >> dash >> end;
+    mappings.emplace_back(begin, end);
+  }
+  return mappings;
+}
+
+bool IsMappedFrom(const void *addr, const std::string &real_path) {
+  auto address = reinterpret_cast<uintptr_t>(addr);
+  for (const auto &mapping : FileMappings(real_path)) {
+    if (address >= mapping.first && address < mapping.second) {
+      return true;
+    }
+  }
+  return false;
+}
+
+lite::LiteSession *CreateSessionByPath(const std::string &path, const ConfigInfo *config_info) {
+  lite::Context context;
+  context.thread_num_ = 1;
+  auto session = reinterpret_cast<lite::LiteSession *>(session::LiteSession::CreateSession(&context));
+  if (session == nullptr) {
+    return nullptr;
+  }
+  session->SetConfigInfo(config_info);
+  if (session->LoadModelAndCompileByPath(path, luojianet_ms::ModelType::kMindIR_Opt) != lite::RET_OK) {
+    delete session;
+    return nullptr;
+  }
+  return session;
+}
+
+lite::Tensor *ConvWeight(lite::LiteSession *session) {
+  for (auto tensor : session->GetTensors()) {
+    if (tensor->IsConst() && tensor->data() != nullptr) {
+      return tensor;
+    }
+  }
+  return nullptr;
+}
+
+// runs the session on the input 1, 2, ..., 16 and returns the output
+std::vector<float> RunConv(lite::LiteSession *session) {
+  auto inputs = session->GetInputs();
+  if (inputs.size() != 1) {
+    return {};
+  }
+  auto input_data = reinterpret_cast<float *>(inputs.front()->MutableData());
+  for (int i = 0; i < kPixelNum * kInChannel; ++i) {
+    input_data[i] = static_cast<float>(i + 1);
+  }
+  if (session->RunGraph() != lite::RET_OK) {
+    return {};
+  }
+  auto outputs = session->GetOutputs();
+  if (outputs.size() != 1) {
+    return {};
+  }
+  auto output = outputs.begin()->second;
+  auto output_data = reinterpret_cast<float *>(output->MutableData());
+  return std::vector<float>(output_data, output_data + output->ElementsNum());
+}
+
+// the output of RunConv when every weight is weight_value
+std::vector<float> ExpectedConv(float weight_value) {
+  std::vector<float> expected;
+  for (int pixel = 0; pixel < kPixelNum; ++pixel) {
+    float sum = 0;
+    for (int c = 0; c < kInChannel; ++c) {
+      sum += static_cast<float>(pixel * kInChannel + c + 1);
+    }
+    expected.insert(expected.end(), kOutChannel, sum * weight_value);
+  }
+  return expected;
+}
+
+void FillWeight(lite::Tensor *weight, float value) {
+  auto data = reinterpret_cast<float *>(weight->data());
+  for (int i = 0; i < weight->ElementsNum(); ++i) {
+    data[i] = value;
+  }
+}
+}  // namespace
+
+class MmapModelLoadTest : public luojianet_ms::CommonTest {
+ public:
+  MmapModelLoadTest() = default;
+};
+
+TEST_F(MmapModelLoadTest, MmapFileMatchesRead) {
+  std::string path = "./mmap_model_load_file.bin";
+  std::string content(10000, 0);
+  for (size_t i = 0; i < content.size(); ++i) {
+    content[i] = static_cast<char>(i % 251);
+  }
+  WriteFile(path, content);
+  auto real_path = lite::RealPath(path.c_str());
+  size_t size = 0;
+  char *buf = lite::MmapFile(path.c_str(), &size);
+  ASSERT_NE(buf, nullptr);
+  ASSERT_EQ(size, content.size());
+  ASSERT_EQ(std::string(buf, size), content);
+  ASSERT_TRUE(IsMappedFrom(buf, real_path));
+  // writes stay in the private copy
+  buf[0] = 100;
+  size_t read_size = 0;
+  std::unique_ptr<char[]> read_buf(lite::ReadFile(path.c_str(), &read_size));
+  ASSERT_NE(read_buf, nullptr);
+  ASSERT_EQ(std::string(read_buf.get(), read_size), content);
+  lite::UnmapFile(buf, size);
+  ASSERT_TRUE(FileMappings(real_path).empty());
+  ASSERT_EQ(lite::MmapFile("./mmap_model_load_absent.bin", &size), nullptr);
+  (void)std::remove(path.c_str());
+}
+
+TEST_F(MmapModelLoadTest, LazyPackReadsMappedWeight) {
+  std::string path = "./mmap_model_load_lazy.ms";
+  WriteFile(path, BuildConvModel());
+  auto real_path = lite::RealPath(path.c_str());
+  ConfigInfo config_info = {{lite::kModelLoad, {{lite::kModelLoadMmap, "true"}}}};
+  auto session = CreateSessionByPath(path, &config_info);
+  ASSERT_NE(session, nullptr);
+  auto weight = ConvWeight(session);
+  ASSERT_NE(weight, nullptr);
+  ASSERT_FALSE(weight->own_data());
+  ASSERT_TRUE(IsMappedFrom(weight->data(), real_path));
+  // the weight is packed at the first run, so it still sees a change after compile
+  FillWeight(weight, 2.0f);
+  ASSERT_EQ(RunConv(session), ExpectedConv(2.0f));
+  // packed once, later changes are not seen any more
+  FillWeight(weight, 3.0f);
+  ASSERT_EQ(RunConv(session), ExpectedConv(2.0f));
+  // the model is freed with the session and unmaps the file
+  delete session;
+  ASSERT_TRUE(FileMappings(real_path).empty());
+  // the writes went to the private copy, the file still holds the weights 1
+  session = CreateSessionByPath(path, nullptr);
+  ASSERT_NE(session, nullptr);
+  ASSERT_EQ(RunConv(session), ExpectedConv(1.0f));
+  delete session;
+  (void)std::remove(path.c_str());
+}
+
+TEST_F(MmapModelLoadTest, ReadModelPacksAtCompile) {
+  std::string path = "./mmap_model_load_read.ms";
+  WriteFile(path, BuildConvModel());
+  auto real_path = lite::RealPath(path.c_str());
+  auto session = CreateSessionByPath(path, nullptr);
+  ASSERT_NE(session, nullptr);
+  auto weight = ConvWeight(session);
+  ASSERT_NE(weight, nullptr);
+  ASSERT_TRUE(FileMappings(real_path).empty());
+  FillWeight(weight, 2.0f);
+  ASSERT_EQ(RunConv(session), ExpectedConv(1.0f));
+  delete session;
+  (void)std::remove(path.c_str());
+}
+
+TEST_F(MmapModelLoadTest, NonFlatbufferFileIsNotMapped) {
+  std::string path = "./mmap_model_load_invalid.ms";
+  WriteFile(path, std::string(1000, 7));
+  auto real_path = lite::RealPath(path.c_str());
+  size_t size = 0;
+  ASSERT_EQ(lite::LiteSession::LoadModelByMmap(path, &size), nullptr);
+  ASSERT_TRUE(FileMappings(real_path).empty());
+  (void)std::remove(path.c_str());
+}
+}  // namespace luojianet_ms
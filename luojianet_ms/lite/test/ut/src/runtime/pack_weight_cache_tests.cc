@@ -0,0 +1,97 @@
+/**
+ * Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+ * Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstdio>
+#include <cstdint>
+#include <vector>
+#include "common/common_test.h"
+#include "include/errorcode.h"
+#include "src/runtime/pack_weight_cache.h"
+
+namespace luojianet_ms {
+class PackWeightCacheTest : public luojianet_ms::CommonTest {
+ public:
+  PackWeightCacheTest() = default;
+};
+
+TEST_F(PackWeightCacheTest, SaveAndLoad) {
+  std::string path = "./pack_weight_cache_test.packcache";
+  std::vector<char> model(1000, 7);
+  auto fingerprint = lite::PackWeightCache::Fingerprint(model.data(), model.size());
+  std::vector<float> conv_weight = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f};
+  std::vector<float> matmul_weight(100, 0.5f);
+  {
+    lite::PackWeightCache cache;
+    ASSERT_EQ(cache.Load(path + ".absent", fingerprint), lite::RET_NO_CHANGE);
+    ASSERT_EQ(cache.Record("conv|conv_col8|c", conv_weight.data(), conv_weight.size() * sizeof(float)), lite::RET_OK);
+    ASSERT_EQ(cache.Record("fc|matmul_col8_t|c", matmul_weight.data(), matmul_weight.size() * sizeof(float)),
+              lite::RET_OK);
+    ASSERT_EQ(cache.Save(path, fingerprint), lite::RET_OK);
+  }
+
+  lite::PackWeightCache cache;
+  ASSERT_EQ(cache.Load(path, fingerprint), lite::RET_OK);
+  ASSERT_TRUE(cache.loaded());
+  auto conv = reinterpret_cast<float *>(cache.Find("conv|conv_col8|c", conv_weight.size() * sizeof(float)));
+  ASSERT_NE(conv, nullptr);
+  ASSERT_EQ(reinterpret_cast<uintptr_t>(conv) % 64, 0);
+  ASSERT_EQ(0, CompareOutputData(conv, conv_weight.data(), conv_weight.size(), 0));
+  auto fc = reinterpret_cast<float *>(cache.Find("fc|matmul_col8_t|c", matmul_weight.size() * sizeof(float)));
+  ASSERT_NE(fc, nullptr);
+  ASSERT_EQ(0, CompareOutputData(fc, matmul_weight.data(), matmul_weight.size(), 0));
+  // other tiling or size is a miss
+  ASSERT_EQ(cache.Find("conv|conv_col16|c", conv_weight.size() * sizeof(float)), nullptr);
+  ASSERT_EQ(cache.Find("conv|conv_col8|c", sizeof(float)), nullptr);
+  (void)std::remove(path.c_str());
+}
+
+TEST_F(PackWeightCacheTest, RejectOtherModel) {
+  std::string path = "./pack_weight_cache_mismatch.packcache";
+  std::vector<char> model(1000, 7);
+  std::vector<float> weight(16, 1.0f);
+  {
+    lite::PackWeightCache cache;
+    ASSERT_EQ(cache.Record("conv|conv_col8|c", weight.data(), weight.size() * sizeof(float)), lite::RET_OK);
+    ASSERT_EQ(cache.Save(path, lite::PackWeightCache::Fingerprint(model.data(), model.size())), lite::RET_OK);
+  }
+  model[model.size() - 1] = 8;
+  lite::PackWeightCache cache;
+  ASSERT_EQ(cache.Load(path, lite::PackWeightCache::Fingerprint(model.data(), model.size())), lite::RET_ERROR);
+  ASSERT_FALSE(cache.loaded());
+  ASSERT_EQ(cache.Find("conv|conv_col8|c", weight.size() * sizeof(float)), nullptr);
+  (void)std::remove(path.c_str());
+}
+
+TEST_F(PackWeightCacheTest, RejectRetrainedWeights) {
+  std::string path = "./pack_weight_cache_retrained.packcache";
+  // a retrained model of the same size with the same head and tail, only two bytes in the middle of the weights
+  // differ, the size leaves 13 bytes after the last 32 byte stride so both hash paths of the content run
+  std::vector<char> model(4 * 1024 * 1024 + 13, 7);
+  std::vector<float> weight(16, 1.0f);
+  {
+    lite::PackWeightCache cache;
+    ASSERT_EQ(cache.Record("conv|conv_col8|c", weight.data(), weight.size() * sizeof(float)), lite::RET_OK);
+    ASSERT_EQ(cache.Save(path, lite::PackWeightCache::Fingerprint(model.data(), model.size())), lite::RET_OK);
+  }
+  model[model.size() / 2] = 8;
+  model[model.size() / 2 + 1] = 9;
+  lite::PackWeightCache cache;
+  ASSERT_EQ(cache.Load(path, lite::PackWeightCache::Fingerprint(model.data(), model.size())), lite::RET_ERROR);
+  ASSERT_FALSE(cache.loaded());
+  ASSERT_EQ(cache.Find("conv|conv_col8|c", weight.size() * sizeof(float)), nullptr);
+  (void)std::remove(path.c_str());
+}
+}  // namespace luojianet_ms
@@ -0,0 +1,91 @@
+/**
+ * Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+ * Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "common/common_test.h"
+#include "src/runtime/runtime_allocator.h"
+
+namespace luojianet_ms {
+class RuntimeAllocatorTest : public luojianet_ms::CommonTest {
+ public:
+  RuntimeAllocatorTest() = default;
+};
+
+TEST_F(RuntimeAllocatorTest, PlanReuseFreedBlock) {
+  lite::Tensor t0(kNumberTypeFloat32, {64});
+  lite::Tensor t1(kNumberTypeFloat32, {16});
+  lite::Tensor t2(kNumberTypeFloat32, {64});
+  lite::Tensor t3(kNumberTypeFloat32, {16});
+
+  /* t0 -> t1 -> t2 -> t3, every tensor dies after its consumer */
+  RuntimeAllocator allocator;
+  allocator.MallocTensorData(&t0);
+  allocator.MallocTensorData(&t1);
+  allocator.FreeTensorData(&t0);
+  allocator.MallocTensorData(&t2);
+  allocator.FreeTensorData(&t1);
+  allocator.MallocTensorData(&t3);
+  allocator.FreeTensorData(&t2);
+  allocator.FreeTensorData(&t3);
+  ASSERT_EQ(allocator.Plan(), lite::RET_OK);
+
+  ASSERT_EQ(allocator.naive_size(), 640);
+  ASSERT_EQ(allocator.lower_bound_size(), 320);
+  ASSERT_EQ(allocator.planned_size(), 320);
+  auto offsets = allocator.GetOffsetMap();
+  ASSERT_EQ(offsets.at(&t0), offsets.at(&t2));
+  ASSERT_EQ(offsets.at(&t1), offsets.at(&t3));
+  ASSERT_NE(offsets.at(&t0), offsets.at(&t1));
+}
+
+TEST_F(RuntimeAllocatorTest, PlanBestFitGap) {
+  lite::Tensor big(kNumberTypeFloat32, {256});
+  lite::Tensor left(kNumberTypeFloat32, {128});
+  lite::Tensor right(kNumberTypeFloat32, {128});
+  lite::Tensor small(kNumberTypeFloat32, {32});
+  lite::Tensor tail(kNumberTypeFloat32, {64});
+
+  RuntimeAllocator allocator;
+  allocator.MallocTensorData(&left);
+  allocator.MallocTensorData(&right);
+  allocator.FreeTensorData(&left);
+  allocator.FreeTensorData(&right);
+  allocator.MallocTensorData(&big);
+  allocator.MallocTensorData(&small);
+  allocator.MallocTensorData(&tail);
+  allocator.FreeTensorData(&big);
+  allocator.FreeTensorData(&small);
+  allocator.FreeTensorData(&tail);
+  ASSERT_EQ(allocator.Plan(), lite::RET_OK);
+
+  /* nothing alive next to left and right, they must fold into the space of big */
+  ASSERT_EQ(allocator.planned_size(), 1024 + 128 + 256);
+  ASSERT_EQ(allocator.planned_size(), allocator.lower_bound_size());
+}
+
+TEST_F(RuntimeAllocatorTest, ShareTensorData) {
+  lite::Tensor in(kNumberTypeFloat32, {32});
+  lite::Tensor out(kNumberTypeFloat32, {32});
+
+  RuntimeAllocator allocator;
+  allocator.MallocTensorData(&in);
+  allocator.ShareTensorData(&out, &in);
+  allocator.FreeTensorData(&out);
+  ASSERT_EQ(allocator.GetBlockId(&in), allocator.GetBlockId(&out));
+  ASSERT_NE(allocator.MallocOptData(), nullptr);
+  ASSERT_EQ(allocator.planned_size(), 128);
+  ASSERT_EQ(allocator.GetOffsetMap().at(&in), allocator.GetOffsetMap().at(&out));
+}
+}  // namespace luojianet_ms
@@ -0,0 +1,225 @@
+/**
+ * Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+ * Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "thread/threadpool.h"
+
+namespace luojianet_ms {
+namespace {
+constexpr int kThreadNum = 4;
+constexpr int kTaskNum = 64;
+constexpr int kLoopCount = 20;
+constexpr int kHeavyTaskNum = kTaskNum / 8;
+constexpr int kLightWork = 2000;
+constexpr int kHeavyWork = 200000;
+constexpr auto kIdleWait = std::chrono::milliseconds(50);
+constexpr auto kBlockTimeout = std::chrono::seconds(10);
+
+struct ImbalancedWork {
+  std::vector<std::atomic_int> runs = std::vector<std::atomic_int>(kTaskNum);
+  std::atomic<double> sink{0};
+};
+
+// the first eighth of the ids are a hundred times heavier, like nms or roi align over a few crowded tiles,
+// so they all fall into the range of the calling thread
+int RunImbalancedTask(void *content, int task_id, float lhs_scale, float rhs_scale) {
+  auto work = static_cast<ImbalancedWork *>(content);
+  work->runs[task_id]++;
+  int steps = task_id < kHeavyTaskNum ? kHeavyWork : kLightWork;
+  double sum = 0;
+  for (int i = 0; i < steps; ++i) {
+    sum += std::sqrt(static_cast<double>(i));
+  }
+  work->sink = sum;
+  return 0;
+}
+
+double LaunchImbalanced(ThreadPool *pool, ImbalancedWork *work) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kLoopCount; ++i) {
+    if (pool->ParallelLaunch(RunImbalancedTask, work, kTaskNum) != THREAD_OK) {
+      return -1;
+    }
+  }
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+struct BlockingWork {
+  std::atomic_int finished{0};
+  std::atomic_bool timed_out{false};
+};
+
+// id 0 returns only when every other id is done, so whoever runs it can't run the rest of its own range
+int RunBlockingTask(void *content, int task_id, float lhs_scale, float rhs_scale) {
+  auto work = static_cast<BlockingWork *>(content);
+  if (task_id == 0) {
+    auto deadline = std::chrono::steady_clock::now() + kBlockTimeout;
+    while (work->finished != kTaskNum - 1) {
+      if (std::chrono::steady_clock::now() > deadline) {
+        work->timed_out = true;
+        break;
+      }
+      std::this_thread::yield();
+    }
+    return 0;
+  }
+  work->finished++;
+  return 0;
+}
+
+struct ThreadRecord {
+  std::mutex mutex;
+  std::set<std::thread::id> ids;
+  std::atomic<double> sink{0};
+};
+
+// records the threads a launch runs on
+int RecordThreadTask(void *content, int task_id, float lhs_scale, float rhs_scale) {
+  auto record = static_cast<ThreadRecord *>(content);
+  double sum = 0;
+  for (int i = 0; i < kLightWork; ++i) {
+    sum += std::sqrt(static_cast<double>(i));
+  }
+  record->sink = sum;
+  std::lock_guard<std::mutex> lock(record->mutex);
+  record->ids.insert(std::this_thread::get_id());
+  return 0;
+}
+
+// launches from a branch thread limited to the kernel workers [begin, end), like a parallel cpu subgraph
+void LaunchInRange(ThreadPool *pool, int begin, int end, ThreadRecord *record, int *ret) {
+  pool->SetWorkerRangeOfCurrentThread(begin, end);
+  for (int i = 0; i < kLoopCount && *ret == THREAD_OK; ++i) {
+    *ret = pool->ParallelLaunch(RecordThreadTask, record, kTaskNum);
+  }
+  pool->SetWorkerRangeOfCurrentThread(-1, -1);
+}
+}  // namespace
+
+class ThreadPoolTest : public luojianet_ms::CommonTest {
+ public:
+  ThreadPoolTest() = default;
+};
+
+TEST_F(ThreadPoolTest, WorkStealingRunsEveryTaskOnce) {
+  std::unique_ptr<ThreadPool> pool(ThreadPool::CreateThreadPool(kThreadNum));
+  ASSERT_NE(pool, nullptr);
+  pool->SetWorkStealing(true);
+  ImbalancedWork work;
+  ASSERT_GE(LaunchImbalanced(pool.get(), &work), 0);
+  for (auto &runs : work.runs) {
+    ASSERT_EQ(runs.load(), kLoopCount);
+  }
+  auto failed = [](void *, int task_id, float, float) { return task_id == kTaskNum - 1 ? 1 : 0; };
+  ASSERT_EQ(pool->ParallelLaunch(failed, nullptr, kTaskNum), THREAD_ERROR);
+}
+
+TEST_F(ThreadPoolTest, WorkStealingTakesIdsOfABlockedThread) {
+  std::unique_ptr<ThreadPool> pool(ThreadPool::CreateThreadPool(kThreadNum));
+  ASSERT_NE(pool, nullptr);
+  if (pool->thread_num() <= 1) {
+    return;
+  }
+  pool->SetWorkStealing(true);
+  // let the new workers turn idle, so that the launch can claim them
+  std::this_thread::sleep_for(kIdleWait);
+  BlockingWork work;
+  ASSERT_EQ(pool->ParallelLaunch(RunBlockingTask, &work, kTaskNum), THREAD_OK);
+  // the range of the thread blocked in id 0 holds more ids, only the other threads can have run them
+  ASSERT_FALSE(work.timed_out);
+  ASSERT_EQ(work.finished.load(), kTaskNum - 1);
+  ASSERT_GT(pool->stolen_task_num(), 0u);
+}
+
+TEST_F(ThreadPoolTest, WorkerRangeLimitsTheLaunch) {
+  std::unique_ptr<ThreadPool> pool(ThreadPool::CreateThreadPool(kThreadNum));
+  ASSERT_NE(pool, nullptr);
+  auto default_num = pool->GetKernelThreadNum();
+  ASSERT_EQ(pool->GetKernelThreadNumOfCurrentThread(), default_num);
+  std::this_thread::sleep_for(kIdleWait);
+  // one kernel worker besides the calling thread
+  pool->SetWorkerRangeOfCurrentThread(0, 1);
+  ASSERT_EQ(pool->GetKernelThreadNumOfCurrentThread(), 2u);
+  ThreadRecord record;
+  ASSERT_EQ(pool->ParallelLaunch(RecordThreadTask, &record, kTaskNum), THREAD_OK);
+  ASSERT_LE(record.ids.size(), 2u);
+  // an empty range leaves the launch to the calling thread
+  pool->SetWorkerRangeOfCurrentThread(2, 2);
+  ASSERT_EQ(pool->GetKernelThreadNumOfCurrentThread(), 1u);
+  ThreadRecord alone;
+  ASSERT_EQ(pool->ParallelLaunch(RecordThreadTask, &alone, kTaskNum), THREAD_OK);
+  ASSERT_EQ(alone.ids, std::set<std::thread::id>{std::this_thread::get_id()});
+  // the range belongs to the thread which set it
+  size_t other_num = 0;
+  std::thread other([&pool, &other_num]() { other_num = pool->GetKernelThreadNumOfCurrentThread(); });
+  other.join();
+  ASSERT_EQ(other_num, default_num);
+  pool->SetWorkerRangeOfCurrentThread(-1, -1);
+  ASSERT_EQ(pool->GetKernelThreadNumOfCurrentThread(), default_num);
+}
+
+TEST_F(ThreadPoolTest, DisjointWorkerRangesDontShareThreads) {
+  std::unique_ptr<ThreadPool> pool(ThreadPool::CreateThreadPool(kThreadNum));
+  ASSERT_NE(pool, nullptr);
+  std::this_thread::sleep_for(kIdleWait);
+  // two branches launching at the same time, the major one on workers 0 and 1, the minor one on worker 2
+  ThreadRecord major;
+  ThreadRecord minor;
+  int major_ret = THREAD_OK;
+  int minor_ret = THREAD_OK;
+  std::thread major_branch(LaunchInRange, pool.get(), 0, 2, &major, &major_ret);
+  std::thread minor_branch(LaunchInRange, pool.get(), 2, 3, &minor, &minor_ret);
+  major_branch.join();
+  minor_branch.join();
+  ASSERT_EQ(major_ret, THREAD_OK);
+  ASSERT_EQ(minor_ret, THREAD_OK);
+  ASSERT_LE(major.ids.size(), 3u);
+  ASSERT_LE(minor.ids.size(), 2u);
+  for (const auto &id : minor.ids) {
+    ASSERT_EQ(major.ids.count(id), 0u);
+  }
+}
+
+// micro benchmark of an imbalanced launch, static split against work stealing
+TEST_F(ThreadPoolTest, ImbalancedWorkloadBenchmark) {
+  std::unique_ptr<ThreadPool> pool(ThreadPool::CreateThreadPool(kThreadNum));
+  ASSERT_NE(pool, nullptr);
+  ImbalancedWork static_work;
+  pool->SetWorkStealing(false);
+  auto static_time = LaunchImbalanced(pool.get(), &static_work);
+  ImbalancedWork stealing_work;
+  pool->SetWorkStealing(true);
+  ASSERT_EQ(pool->stolen_task_num(), 0u);
+  auto stealing_time = LaunchImbalanced(pool.get(), &stealing_work);
+  ASSERT_GE(static_time, 0);
+  ASSERT_GE(stealing_time, 0);
+  // the heavy ids all start in the range of the calling thread, the idle workers have to take them over
+  if (pool->thread_num() > 1) {
+    ASSERT_GT(pool->stolen_task_num(), 0u);
+  }
+  std::cout << "threads " << pool->thread_num() << ", tasks " << kTaskNum << " x " << kLoopCount
+            << ": static " << static_time << " ms, work stealing " << stealing_time << " ms, stolen "
+            << pool->stolen_task_num() << " ids" << std::endl;
+}
+}  // namespace luojianet_ms
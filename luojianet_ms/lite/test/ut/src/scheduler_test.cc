@@ -15,9 +15,15 @@
  * limitations under the License.
  */
 
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
 #include "common/common_test.h"
 #include "schema/inner/model_generated.h"
 #include "src/lite_session.h"
+#include "src/sub_graph_kernel.h"
+#include "thread/threadpool.h"
 #include "ir/dtype/type_id.h"
 #include "include/version.h"
 
@@ -29,6 +35,120 @@ using luojianet_ms::lite::Tensor;
 using luojianet_ms::schema::PrimitiveType_Abs;
 using luojianet_ms::TypeId::kNumberTypeFloat32;
 
+namespace {
+constexpr int kBranchRow = 8;
+constexpr int kBranchDeep = 64;
+constexpr int kBranchThreadNum = 4;
+
+// input -> abs -> abs -> {MatMulFusion "first", MatMulFusion "second"} -> two graph outputs, the weights are all 1
+luojianet_ms::lite::Model *BuildTwoBranchModel(int first_col, int second_col) {
+  auto meta_graph = std::make_shared<luojianet_ms::schema::MetaGraphT>();
+  meta_graph->name = "graph";
+  meta_graph->version = luojianet_ms::lite::Version();
+  auto add_tensor = [&meta_graph](std::vector<int> dims, bool is_weight) {
+    auto tensor = std::make_unique<luojianet_ms::schema::TensorT>();
+    tensor->nodeType = is_weight ? luojianet_ms::lite::NodeType_ValueNode : luojianet_ms::lite::NodeType_Parameter;
+    tensor->format = luojianet_ms::schema::Format_NHWC;
+    tensor->dataType = luojianet_ms::TypeId::kNumberTypeFloat32;
+    tensor->dims = dims;
+    tensor->offset = -1;
+    if (is_weight) {
+      std::vector<float> data(dims[0] * dims[1], 1.0f);
+      tensor->data.resize(data.size() * sizeof(float));
+      ::memcpy(tensor->data.data(), data.data(), tensor->data.size());
+    }
+    meta_graph->allTensors.emplace_back(std::move(tensor));
+    return static_cast<uint32_t>(meta_graph->allTensors.size() - 1);
+  };
+  auto add_node = [&meta_graph](const std::string &name, std::vector<uint32_t> inputs, uint32_t output,
+                                bool is_matmul) {
+    auto node = std::make_unique<luojianet_ms::schema::CNodeT>();
+    node->inputIndex = inputs;
+    node->outputIndex = {output};
+    node->primitive = std::make_unique<luojianet_ms::schema::PrimitiveT>();
+    if (is_matmul) {
+      node->primitive->value.type = luojianet_ms::schema::PrimitiveType_MatMulFusion;
+      node->primitive->value.value = new luojianet_ms::schema::MatMulFusionT;
+    } else {
+      node->primitive->value.type = luojianet_ms::schema::PrimitiveType_Abs;
+      node->primitive->value.value = new luojianet_ms::schema::AbsT;
+    }
+    node->name = name;
+    meta_graph->nodes.emplace_back(std::move(node));
+  };
+  // a node fed by the graph input ends the search for a branch, so the branches hang off a stem of two nodes
+  auto input = add_tensor({kBranchRow, kBranchDeep}, false);
+  auto stem0 = add_tensor({kBranchRow, kBranchDeep}, false);
+  auto stem1 = add_tensor({kBranchRow, kBranchDeep}, false);
+  auto first_weight = add_tensor({kBranchDeep, first_col}, true);
+  auto first_output = add_tensor({kBranchRow, first_col}, false);
+  auto second_weight = add_tensor({kBranchDeep, second_col}, true);
+  auto second_output = add_tensor({kBranchRow, second_col}, false);
+  add_node("stem0", {input}, stem0, false);
+  add_node("stem1", {stem0}, stem1, false);
+  add_node("first", {stem1, first_weight}, first_output, true);
+  add_node("second", {stem1, second_weight}, second_output, true);
+  meta_graph->inputIndex = {input};
+  meta_graph->outputIndex = {first_output, second_output};
+  flatbuffers::FlatBufferBuilder builder(1024);
+  auto offset = luojianet_ms::schema::MetaGraph::Pack(builder, meta_graph.get());
+  builder.Finish(offset);
+  luojianet_ms::schema::FinishMetaGraphBuffer(builder, offset);
+  size_t size = builder.GetSize();
+  const char *content = reinterpret_cast<char *>(builder.GetBufferPointer());
+  return luojianet_ms::lite::Model::Import(content, size);
+}
+
+// compiles the model with the subgraph parallel on 4 cpu threads and runs it once, returns for each MatMulFusion
+// kernel its thread num and the kernel workers its branch was limited to while it ran
+void RunTwoBranchModel(luojianet_ms::lite::Model *model, std::map<std::string, int> *thread_num,
+                       std::map<std::string, size_t> *worker_num) {
+  auto context = new InnerContext();
+  context->thread_num_ = kBranchThreadNum;
+  context->enable_parallel_ = true;
+  ASSERT_EQ(luojianet_ms::lite::RET_OK, context->Init());
+  auto lite_session = new LiteSession();
+  ASSERT_EQ(luojianet_ms::lite::RET_OK, lite_session->Init(context));
+  ASSERT_EQ(luojianet_ms::lite::RET_OK, lite_session->CompileGraph(model));
+  for (auto kernel : lite_session->get_kernels()) {
+    if (kernel->subgraph_type() == luojianet_ms::kernel::kNotSubGraph) {
+      continue;
+    }
+    for (auto node : reinterpret_cast<luojianet_ms::kernel::SubGraphKernel *>(kernel)->nodes()) {
+      if (node->type() == luojianet_ms::schema::PrimitiveType_MatMulFusion) {
+        (*thread_num)[node->name()] = node->op_parameter()->thread_num_;
+      }
+    }
+  }
+  for (auto input : lite_session->GetInputs()) {
+    auto data = reinterpret_cast<float *>(input->MutableData());
+    for (int i = 0; i < input->ElementsNum(); ++i) {
+      data[i] = -1.0f;
+    }
+  }
+  std::mutex mutex;
+  auto thread_pool = context->thread_pool();
+  luojianet_ms::KernelCallBack before = [&](const std::vector<luojianet_ms::tensor::MSTensor *> &,
+                                            const std::vector<luojianet_ms::tensor::MSTensor *> &,
+                                            const luojianet_ms::CallBackParam &param) {
+    if (param.node_type == "MatMulFusion") {
+      std::lock_guard<std::mutex> lock(mutex);
+      (*worker_num)[param.node_name] = thread_pool->GetKernelThreadNumOfCurrentThread();
+    }
+    return true;
+  };
+  ASSERT_EQ(luojianet_ms::lite::RET_OK, lite_session->RunGraph(before, nullptr));
+  // every output element sums kBranchDeep times |-1| * 1
+  for (auto &output : lite_session->GetOutputs()) {
+    auto data = reinterpret_cast<float *>(output.second->MutableData());
+    for (int i = 0; i < output.second->ElementsNum(); ++i) {
+      ASSERT_EQ(data[i], static_cast<float>(kBranchDeep));
+    }
+  }
+  delete lite_session;
+}
+}  // namespace
+
 class SchedulerTest : public luojianet_ms::CommonTest {
  public:
   SchedulerTest() = default;
@@ -441,3 +561,35 @@ TEST_F(SchedulerTest, TestScheduleInt32OpToFp16Subgraph) {
   ASSERT_EQ(luojianet_ms::lite::RET_OK, lite_session->CompileGraph(model));
   ASSERT_EQ(1, lite_session->get_kernels().size());
 }
+
+TEST_F(SchedulerTest, TestParallelBranchThreadsFollowCost) {
+  // the flops of a branch are kBranchRow * col * kBranchDeep, the heavy branch takes 3/4 of the cost whether it comes
+  // first or second, so it gets 3 of the 4 threads, runs 1 task on its actor thread and 2 on its kernel workers
+  for (bool heavy_first : {true, false}) {
+    auto model = BuildTwoBranchModel(heavy_first ? 48 : 16, heavy_first ? 16 : 48);
+    ASSERT_NE(model, nullptr);
+    std::map<std::string, int> thread_num;
+    std::map<std::string, size_t> worker_num;
+    RunTwoBranchModel(model, &thread_num, &worker_num);
+    std::string heavy = heavy_first ? "first" : "second";
+    std::string light = heavy_first ? "second" : "first";
+    ASSERT_EQ(thread_num[heavy], 3);
+    ASSERT_EQ(thread_num[light], 1);
+    ASSERT_EQ(worker_num[heavy], 3u);
+    ASSERT_EQ(worker_num[light], 1u);
+    delete model;
+  }
+}
+
+TEST_F(SchedulerTest, TestParallelBranchThreadsOfEqualCost) {
+  auto model = BuildTwoBranchModel(32, 32);
+  ASSERT_NE(model, nullptr);
+  std::map<std::string, int> thread_num;
+  std::map<std::string, size_t> worker_num;
+  RunTwoBranchModel(model, &thread_num, &worker_num);
+  ASSERT_EQ(thread_num["first"], 2);
+  ASSERT_EQ(thread_num["second"], 2);
+  ASSERT_EQ(worker_num["first"], 2u);
+  ASSERT_EQ(worker_num["second"], 2u);
+  delete model;
+}
@@ -0,0 +1,131 @@
+/**
+ * Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+ * Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "include/errorcode.h"
+#include "tools/benchmark/layer_profiler.h"
+
+namespace luojianet_ms {
+namespace {
+std::string ReadText(const std::string &path) {
+  std::ifstream ifs(path);
+  std::stringstream ss;
+  ss << ifs.rdbuf();
+  return ss.str();
+}
+
+std::vector<std::string> Lines(const std::string &text) {
+  std::vector<std::string> lines;
+  std::stringstream ss(text);
+  std::string line;
+  while (std::getline(ss, line)) {
+    lines.push_back(line);
+  }
+  return lines;
+}
+
+size_t CountOf(const std::string &text, const std::string &pattern) {
+  size_t count = 0;
+  for (auto pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1)) {
+    count++;
+  }
+  return count;
+}
+
+// conv writes a (100 bytes) which relu reads, relu writes the graph output b (50 bytes)
+void RunTwoKernels(lite::LayerProfiler *profiler) {
+  profiler->KernelBegin("conv", "Conv2DFusion", {{"in", 40}});
+  profiler->KernelEnd("conv", {{"a", 100}});
+  profiler->KernelBegin("relu\"1", "Activation", {{"a", 100}});
+  profiler->KernelEnd("relu\"1", {{"b", 50}});
+}
+}  // namespace
+
+class LayerProfilerTest : public luojianet_ms::CommonTest {
+ public:
+  LayerProfilerTest() = default;
+};
+
+TEST_F(LayerProfilerTest, WriteTraceAndCsv) {
+  std::string trace_path = "./layer_profiler_test.json";
+  std::string csv_path = "./layer_profiler_test.csv";
+  lite::LayerProfiler profiler;
+  ASSERT_EQ(profiler.Init("CYCLE"), lite::RET_OK);
+  // a warm up or accuracy run outside RunBegin/RunEnd is not recorded
+  RunTwoKernels(&profiler);
+  for (int i = 0; i < 2; i++) {
+    profiler.RunBegin();
+    RunTwoKernels(&profiler);
+    profiler.RunEnd({10, 20});
+  }
+  // kernels of another actor thread get their own track
+  profiler.RunBegin();
+  std::thread actor([&profiler]() {
+    profiler.KernelBegin("conv", "Conv2DFusion", {{"in", 40}});
+    profiler.KernelEnd("conv", {{"a", 100}});
+  });
+  actor.join();
+  profiler.RunEnd({});
+  ASSERT_EQ(profiler.WriteChromeTrace(trace_path), lite::RET_OK);
+  ASSERT_EQ(profiler.WriteCsv(csv_path), lite::RET_OK);
+
+  auto trace = ReadText(trace_path);
+  ASSERT_EQ(trace.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["), 0u);
+  ASSERT_EQ(trace.substr(trace.size() - 4), "\n]}\n");
+  ASSERT_EQ(CountOf(trace, "\"cat\":\"run\""), 3u);
+  ASSERT_EQ(CountOf(trace, "\"cat\":\"Conv2DFusion\""), 3u);
+  ASSERT_EQ(CountOf(trace, "\"name\":\"relu\\\"1\""), 2u);
+  ASSERT_EQ(CountOf(trace, "\"tid\":1,"), 1u);
+  ASSERT_EQ(CountOf(trace, "\"thread busy percent\""), 2u);
+  // live bytes are estimated from the first run only
+  ASSERT_EQ(CountOf(trace, "\"est_live_bytes\":100"), 1u);
+  ASSERT_EQ(CountOf(trace, "\"est_live_bytes\":150"), 1u);
+
+  auto lines = Lines(ReadText(csv_path));
+  ASSERT_GE(lines.size(), 3u);
+  std::string header = "opName,opType,calledTimes,avg(ms),min(ms),max(ms),percent,outputBytes,estLiveBytes,atEstPeak";
+  ASSERT_EQ(lines[0].substr(0, header.size()), header);
+  ASSERT_EQ(lines[1].find("conv,Conv2DFusion,3,"), 0u);
+  ASSERT_NE(lines[1].find(",100,100,0"), std::string::npos);
+  ASSERT_EQ(lines[2].find("\"relu\"\"1\",Activation,2,"), 0u);
+  ASSERT_NE(lines[2].find(",50,150,1"), std::string::npos);
+  std::vector<std::string> tail(lines.begin() + 3, lines.end());
+  ASSERT_GE(tail.size(), 6u);
+  ASSERT_EQ(tail[0], "");
+  ASSERT_EQ(tail[1], "thread,busy(ms),idle(ms),busy(%)");
+  ASSERT_EQ(tail[2].find("thread_0,0.020,"), 0u);
+  ASSERT_EQ(tail[3].find("thread_1,0.040,"), 0u);
+  ASSERT_EQ(tail.back(), "estPeakLiveBytes,150");
+  (void)std::remove(trace_path.c_str());
+  (void)std::remove(csv_path.c_str());
+}
+
+TEST_F(LayerProfilerTest, WriteFailsOnBadPath) {
+  lite::LayerProfiler profiler;
+  ASSERT_EQ(profiler.Init("CACHE"), lite::RET_OK);
+  profiler.RunBegin();
+  RunTwoKernels(&profiler);
+  profiler.RunEnd({});
+  ASSERT_EQ(profiler.WriteChromeTrace("./layer_profiler_absent_dir/trace.json"), lite::RET_ERROR);
+  ASSERT_EQ(profiler.WriteCsv("./layer_profiler_absent_dir/trace.csv"), lite::RET_ERROR);
+}
+}  // namespace luojianet_ms
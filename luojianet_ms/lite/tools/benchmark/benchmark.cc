@@ -515,12 +515,21 @@ int Benchmark::MarkPerformance() {
   uint64_t time_max = 0;
   uint64_t time_avg = 0;
 
+  Vector<uint64_t> busy_begin;
+  Vector<uint64_t> busy_end;
+  if (flags_->layer_profiling_) {
+    (void)session_->GetThreadBusyTime(&busy_end);
+  }
   for (int i = 0; i < flags_->loop_count_; i++) {
     auto inputs = session_->GetInputs();
     for (auto tensor : inputs) {
       tensor->MutableData();  // prepare data
     }
     session_->BindThread(true);
+    if (flags_->layer_profiling_) {
+      busy_begin = busy_end;
+      layer_profiler_.RunBegin();
+    }
     auto start = GetTimeUs();
     auto status = session_->RunGraph(before_call_back_, after_call_back_);
     if (status != RET_OK) {
@@ -530,6 +539,15 @@ int Benchmark::MarkPerformance() {
     }
 
     auto end = GetTimeUs();
+    if (flags_->layer_profiling_) {
+      std::vector<uint64_t> run_busy;
+      if (session_->GetThreadBusyTime(&busy_end) == RET_OK && busy_end.size() == busy_begin.size()) {
+        for (size_t t = 0; t < busy_end.size(); t++) {
+          run_busy.push_back(busy_end[t] - busy_begin[t]);
+        }
+      }
+      layer_profiler_.RunEnd(run_busy);
+    }
     auto time = end - start;
     time_min = std::min(time_min, time);
     time_max = std::max(time_max, time);
@@ -542,6 +560,11 @@ int Benchmark::MarkPerformance() {
     const std::vector<std::string> per_op_type = {"opType", "avg(ms)", "percent", "calledTimes", "opTotalTime"};
     PrintResult(per_op_name, op_times_by_name_);
     PrintResult(per_op_type, op_times_by_type_);
+  } else if (flags_->layer_profiling_) {
+    auto status = WriteLayerProfilingResult();
+    if (status != RET_OK) {
+      return status;
+    }
 #ifdef ENABLE_ARM64
   } else if (flags_->perf_profiling_) {
     if (flags_->perf_event_ == "CACHE") {
@@ -691,6 +714,10 @@ int Benchmark::RunBenchmark() {
     gl_runtime_.Init();
   }
 #endif
+  if (flags_->enable_mmap_) {
+    MS_LOG(WARNING) << "enableMmap needs MSLITE_API_TYPE=NEW, the model file is read instead.";
+    std::cerr << "enableMmap needs MSLITE_API_TYPE=NEW, the model file is read instead." << std::endl;
+  }
   MS_LOG(INFO) << "start reading model file";
   std::cout << "start reading model file" << std::endl;
   size_t size = 0;
@@ -725,6 +752,11 @@ int Benchmark::RunBenchmark() {
     std::cout << "CreateSession failed while running ", model_name.c_str();
     return RET_ERROR;
   }
+  if (flags_->enable_memory_plan_ && session_->SetMemoryPlan(true) != RET_OK) {
+    MS_LOG(ERROR) << "SetMemoryPlan failed while running " << model_name.c_str();
+    std::cerr << "SetMemoryPlan failed while running " << model_name.c_str() << std::endl;
+    return RET_ERROR;
+  }
   ret = session_->CompileGraph(model.get());
   if (ret != RET_OK) {
     MS_LOG(ERROR) << "CompileGraph failed while running ", model_name.c_str();
@@ -745,6 +777,12 @@ int Benchmark::RunBenchmark() {
   ms_inputs_ = session_->GetInputs();
   ms_outputs_ = session_->GetOutputs();
   auto end_prepare_time = GetTimeUs();
+  size_t planned_size = 0;
+  size_t naive_size = 0;
+  if (session_->GetMemoryPlanInfo(&planned_size, &naive_size) == RET_OK) {
+    MS_LOG(INFO) << "PlannedMemory = " << planned_size << " bytes, NaiveMemory = " << naive_size << " bytes";
+    std::cout << "PlannedMemory = " << planned_size << " bytes, NaiveMemory = " << naive_size << " bytes" << std::endl;
+  }
   MS_LOG(INFO) << "PrepareTime = " << static_cast<float>(end_prepare_time - start_prepare_time) / kNumUsPerMs << " ms";
   std::cout << "PrepareTime = " << static_cast<float>(end_prepare_time - start_prepare_time) / kNumUsPerMs << " ms"
             << std::endl;
@@ -930,6 +968,36 @@ int Benchmark::InitPerfProfilingCallbackParameter() {
   return RET_OK;
 }
 
+int Benchmark::InitLayerProfilingCallbackParameter() {
+  auto ret = layer_profiler_.Init(flags_->perf_event_);
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "Init layer profiler failed.";
+    return ret;
+  }
+  auto tensor_infos = [](const std::vector<luojianet_ms::tensor::MSTensor *> &tensors) {
+    std::vector<LayerProfiler::TensorInfo> infos;
+    for (auto tensor : tensors) {
+      if (tensor != nullptr) {
+        infos.emplace_back(tensor->tensor_name(), tensor->Size());
+      }
+    }
+    return infos;
+  };
+  before_call_back_ = [&, tensor_infos](const std::vector<luojianet_ms::tensor::MSTensor *> &before_inputs,
+                                        const std::vector<luojianet_ms::tensor::MSTensor *> &before_outputs,
+                                        const CallBackParam &call_param) {
+    layer_profiler_.KernelBegin(call_param.node_name, call_param.node_type, tensor_infos(before_inputs));
+    return true;
+  };
+  after_call_back_ = [&, tensor_infos](const std::vector<luojianet_ms::tensor::MSTensor *> &after_inputs,
+                                       const std::vector<luojianet_ms::tensor::MSTensor *> &after_outputs,
+                                       const CallBackParam &call_param) {
+    layer_profiler_.KernelEnd(call_param.node_name, tensor_infos(after_outputs));
+    return true;
+  };
+  return RET_OK;
+}
+
 namespace {
 template <typename T>
 std::string DataToString(void *data, size_t data_number, size_t print_len = 40) {
@@ -83,6 +83,8 @@ class MS_API Benchmark : public BenchmarkBase {
 
   int InitPerfProfilingCallbackParameter() override;
 
+  int InitLayerProfilingCallbackParameter() override;
+
   int InitDumpTensorDataCallbackParameter() override;
 
   int InitPrintTensorDataCallbackParameter() override;
@@ -376,6 +376,8 @@ int BenchmarkBase::InitCallbackParameter() {
     ret = InitTimeProfilingCallbackParameter();
   } else if (flags_->perf_profiling_) {
     ret = InitPerfProfilingCallbackParameter();
+  } else if (flags_->layer_profiling_) {
+    ret = InitLayerProfilingCallbackParameter();
   } else if (flags_->print_tensor_data_) {
     ret = InitPrintTensorDataCallbackParameter();
   } else if (flags_->dump_tensor_data_) {
@@ -384,6 +386,23 @@ int BenchmarkBase::InitCallbackParameter() {
   return ret;
 }
 
+int BenchmarkBase::InitLayerProfilingCallbackParameter() {
+  MS_LOG(ERROR) << "Layer profiling is not supported by this api.";
+  return RET_NOT_SUPPORT;
+}
+
+int BenchmarkBase::WriteLayerProfilingResult() {
+  auto trace_file = flags_->layer_profiling_file_ + ".json";
+  auto csv_file = flags_->layer_profiling_file_ + ".csv";
+  if (layer_profiler_.WriteChromeTrace(trace_file) != RET_OK || layer_profiler_.WriteCsv(csv_file) != RET_OK) {
+    MS_LOG(ERROR) << "Write layer profiling result failed.";
+    std::cerr << "Write layer profiling result failed." << std::endl;
+    return RET_ERROR;
+  }
+  std::cout << "Layer profiling result is saved to : " << trace_file << " and " << csv_file << std::endl;
+  return RET_OK;
+}
+
 int BenchmarkBase::Init() {
   MS_CHECK_FALSE(this->flags_ == nullptr, RET_ERROR);
   MS_LOG(INFO) << "ModelPath = " << this->flags_->model_file_;
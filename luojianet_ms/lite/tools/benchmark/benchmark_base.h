@@ -42,6 +42,7 @@
 #include "ir/dtype/type_id.h"
 #include "schema/model_generated.h"
 #include "nnacl/op_base.h"
+#include "tools/benchmark/layer_profiler.h"
 
 namespace luojianet_ms::lite {
 #define BENCHMARK_LOG_ERROR(str)   \
@@ -127,11 +128,22 @@ class MS_API BenchmarkFlags : public virtual FlagParser {
     AddFlag(&BenchmarkFlags::num_threads_, "numThreads", "Run threads number", 2);
     AddFlag(&BenchmarkFlags::enable_fp16_, "enableFp16", "Enable float16", false);
     AddFlag(&BenchmarkFlags::enable_parallel_, "enableParallel", "Enable subgraph parallel : true | false", false);
+    AddFlag(&BenchmarkFlags::enable_memory_plan_, "enableMemoryPlan",
+            "Plan activation memory into one arena at compile time : true | false", false);
+    AddFlag(&BenchmarkFlags::enable_pack_cache_, "enablePackCache",
+            "Load packed weights from <modelFile>.packcache, write it at first run : true | false", false);
+    AddFlag(&BenchmarkFlags::enable_mmap_, "enableMmap",
+            "Map the model file and pack conv weights at the first run, MSLITE_API_TYPE=NEW only : true | false",
+            false);
     AddFlag(&BenchmarkFlags::warm_up_loop_count_, "warmUpLoopCount", "Run warm up loop", 3);
     AddFlag(&BenchmarkFlags::time_profiling_, "timeProfiling", "Run time profiling", false);
     AddFlag(&BenchmarkFlags::perf_profiling_, "perfProfiling",
             "Perf event profiling(only instructions statics enabled currently)", false);
     AddFlag(&BenchmarkFlags::perf_event_, "perfEvent", "CYCLE|CACHE|STALL", "CYCLE");
+    AddFlag(&BenchmarkFlags::layer_profiling_, "layerProfiling",
+            "Record time, memory, thread load and perf events of every layer as chrome trace and csv", false);
+    AddFlag(&BenchmarkFlags::layer_profiling_file_, "layerProfilingFile",
+            "Path prefix of layer profiling results, <prefix>.json and <prefix>.csv", "./layer_profiling");
     // MarkAccuracy
     AddFlag(&BenchmarkFlags::benchmark_data_file_, "benchmarkDataFile", "Benchmark data file path", "");
     AddFlag(&BenchmarkFlags::benchmark_data_type_, "benchmarkDataType",
@@ -169,6 +181,9 @@ class MS_API BenchmarkFlags : public virtual FlagParser {
   bool enable_gl_texture_ = false;
 #endif
   bool enable_parallel_ = false;
+  bool enable_memory_plan_ = false;
+  bool enable_pack_cache_ = false;
+  bool enable_mmap_ = false;
   int warm_up_loop_count_ = 3;
   // MarkAccuracy
   std::string benchmark_data_file_;
@@ -183,6 +198,8 @@ class MS_API BenchmarkFlags : public virtual FlagParser {
   bool time_profiling_ = false;
   bool perf_profiling_ = false;
   std::string perf_event_ = "CYCLE";
+  bool layer_profiling_ = false;
+  std::string layer_profiling_file_ = "./layer_profiling";
   bool dump_tensor_data_ = false;
   bool print_tensor_data_ = false;
 };
@@ -224,6 +241,10 @@ class MS_API BenchmarkBase {
 
   virtual int InitPerfProfilingCallbackParameter() = 0;
 
+  virtual int InitLayerProfilingCallbackParameter();
+
+  int WriteLayerProfilingResult();
+
   virtual int InitDumpTensorDataCallbackParameter() = 0;
 
   virtual int InitPrintTensorDataCallbackParameter() = 0;
@@ -422,6 +443,7 @@ class MS_API BenchmarkBase {
   float op_cost_total_ = 0.0f;
   std::map<std::string, std::pair<int, float>> op_times_by_type_;
   std::map<std::string, std::pair<int, float>> op_times_by_name_;
+  LayerProfiler layer_profiler_;
 #ifndef BENCHMARK_CLIP_JSON
   // dump data
   nlohmann::json dump_cfg_json_;
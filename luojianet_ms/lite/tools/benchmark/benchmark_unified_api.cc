@@ -249,6 +249,16 @@ void BenchmarkUnifiedApi::UpdateConfigInfo() {
 #define WIPE_DEEP_CONFIG_VOCAB_SIZE "100"
 #define WIPE_DEEP_CONFIG_DEVICE_CACHE_SIZE "40"
 
+  if (flags_->enable_memory_plan_) {
+    ms_model_.UpdateConfig(kMemoryPlan, std::make_pair(kMemoryPlanEnable, "true"));
+  }
+  if (flags_->enable_pack_cache_) {
+    ms_model_.UpdateConfig(kModelLoad, std::make_pair(kModelLoadPackCache, "true"));
+  }
+  if (flags_->enable_mmap_) {
+    ms_model_.UpdateConfig(kModelLoad, std::make_pair(kModelLoadMmap, "true"));
+  }
+
   auto env = std::getenv("BENCHMARK_UPDATE_CONFIG_ENV");
   if (env == nullptr) {
     return;
@@ -640,12 +650,19 @@ int BenchmarkUnifiedApi::MarkPerformance() {
   std::vector<MSTensor> outputs;
 
   for (int i = 0; i < flags_->warm_up_loop_count_; i++) {
+    auto start = GetTimeUs();
     auto status = ms_model_.Predict(ms_inputs_for_api_, &outputs);
     if (status != kSuccess) {
       MS_LOG(ERROR) << "Inference error ";
       std::cerr << "Inference error " << std::endl;
       return RET_ERROR;
     }
+    // the first run also packs the weights deferred by mmap loading
+    if (i == 0) {
+      auto first_run_time = (GetTimeUs() - start) / kFloatMSEC;
+      MS_LOG(INFO) << "FirstRunTime = " << first_run_time << " ms";
+      std::cout << "FirstRunTime = " << first_run_time << " ms" << std::endl;
+    }
   }
 
   MS_LOG(INFO) << "Running benchmark loops...";
@@ -659,6 +676,9 @@ int BenchmarkUnifiedApi::MarkPerformance() {
     for (auto tensor : inputs) {
       tensor.MutableData();  // prepare data
     }
+    if (flags_->layer_profiling_) {
+      layer_profiler_.RunBegin();
+    }
     auto start = GetTimeUs();
     auto status = ms_model_.Predict(ms_inputs_for_api_, &outputs, ms_before_call_back_, ms_after_call_back_);
     if (status != kSuccess) {
@@ -668,6 +688,10 @@ int BenchmarkUnifiedApi::MarkPerformance() {
     }
 
     auto end = GetTimeUs();
+    if (flags_->layer_profiling_) {
+      // the model api does not reach the thread pool, thread load needs MSLITE_API_TYPE=OLD
+      layer_profiler_.RunEnd({});
+    }
     auto time = end - start;
     time_min = std::min(time_min, time);
     time_max = std::max(time_max, time);
@@ -679,6 +703,11 @@ int BenchmarkUnifiedApi::MarkPerformance() {
     const std::vector<std::string> per_op_type = {"opType", "avg(ms)", "percent", "calledTimes", "opTotalTime"};
     PrintResult(per_op_name, op_times_by_name_);
     PrintResult(per_op_type, op_times_by_type_);
+  } else if (flags_->layer_profiling_) {
+    auto status = WriteLayerProfilingResult();
+    if (status != RET_OK) {
+      return status;
+    }
 #ifdef ENABLE_ARM64
   } else if (flags_->perf_profiling_) {
     if (flags_->perf_event_ == "CACHE") {
@@ -882,6 +911,12 @@ int BenchmarkUnifiedApi::RunBenchmark() {
   ms_inputs_for_api_ = ms_model_.GetInputs();
   ms_outputs_for_api_ = ms_model_.GetOutputs();
   auto end_prepare_time = GetTimeUs();
+  size_t planned_size = 0;
+  size_t naive_size = 0;
+  if (ms_model_.GetMemoryPlanInfo(&planned_size, &naive_size) == kSuccess) {
+    MS_LOG(INFO) << "PlannedMemory = " << planned_size << " bytes, NaiveMemory = " << naive_size << " bytes";
+    std::cout << "PlannedMemory = " << planned_size << " bytes, NaiveMemory = " << naive_size << " bytes" << std::endl;
+  }
   MS_LOG(INFO) << "PrepareTime = " << ((end_prepare_time - start_prepare_time) / kFloatMSEC) << " ms";
   std::cout << "PrepareTime = " << ((end_prepare_time - start_prepare_time) / kFloatMSEC) << " ms" << std::endl;
 
@@ -963,6 +998,34 @@ int BenchmarkUnifiedApi::InitTimeProfilingCallbackParameter() {
   return RET_OK;
 }
 
+int BenchmarkUnifiedApi::InitLayerProfilingCallbackParameter() {
+  auto ret = layer_profiler_.Init(flags_->perf_event_);
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "Init layer profiler failed.";
+    return ret;
+  }
+  auto tensor_infos = [](const std::vector<luojianet_ms::MSTensor> &tensors) {
+    std::vector<LayerProfiler::TensorInfo> infos;
+    for (auto &tensor : tensors) {
+      infos.emplace_back(tensor.Name(), tensor.DataSize());
+    }
+    return infos;
+  };
+  ms_before_call_back_ = [&, tensor_infos](const std::vector<luojianet_ms::MSTensor> &before_inputs,
+                                           const std::vector<luojianet_ms::MSTensor> &before_outputs,
+                                           const MSCallBackParam &call_param) {
+    layer_profiler_.KernelBegin(call_param.node_name, call_param.node_type, tensor_infos(before_inputs));
+    return true;
+  };
+  ms_after_call_back_ = [&, tensor_infos](const std::vector<luojianet_ms::MSTensor> &after_inputs,
+                                          const std::vector<luojianet_ms::MSTensor> &after_outputs,
+                                          const MSCallBackParam &call_param) {
+    layer_profiler_.KernelEnd(call_param.node_name, tensor_infos(after_outputs));
+    return true;
+  };
+  return RET_OK;
+}
+
 int BenchmarkUnifiedApi::InitPerfProfilingCallbackParameter() {
 #ifndef ENABLE_ARM64
   MS_LOG(ERROR) << "Only support perf_profiling on arm64.";
@@ -89,6 +89,8 @@ class MS_API BenchmarkUnifiedApi : public BenchmarkBase {
 
   int InitPerfProfilingCallbackParameter() override;
 
+  int InitLayerProfilingCallbackParameter() override;
+
   int InitDumpTensorDataCallbackParameter() override;
 
   int InitPrintTensorDataCallbackParameter() override;
@@ -0,0 +1,450 @@
+/**
+ * Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+ * Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "tools/benchmark/layer_profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <unordered_map>
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#include "include/errorcode.h"
+#include "src/common/log_adapter.h"
+
+namespace luojianet_ms::lite {
+namespace {
+constexpr double kUsPerMs = 1000.0;
+constexpr double kPercent = 100.0;
+
+std::string JsonEscape(const std::string &str) {
+  std::string escaped;
+  for (auto c : str) {
+    if (c == '"' || c == '\\') {
+      escaped.push_back('\\');
+      escaped.push_back(c);
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      escaped.push_back(' ');
+    } else {
+      escaped.push_back(c);
+    }
+  }
+  return escaped;
+}
+
+std::string CsvEscape(const std::string &str) {
+  if (str.find_first_of(",\"\n") == std::string::npos) {
+    return str;
+  }
+  std::string escaped = "\"";
+  for (auto c : str) {
+    if (c == '"') {
+      escaped.push_back('"');
+    }
+    escaped.push_back(c);
+  }
+  return escaped + "\"";
+}
+
+#if defined(__linux__)
+// counts the calling thread on any cpu
+int OpenPerfEvent(uint64_t config, int group_fd) {
+  struct perf_event_attr attr;
+  memset(&attr, 0, sizeof(struct perf_event_attr));
+  attr.type = PERF_TYPE_HARDWARE;
+  attr.size = sizeof(struct perf_event_attr);
+  attr.config = config;
+  attr.disabled = group_fd == -1 ? 1 : 0;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_GROUP;
+  return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, group_fd, 0));
+}
+
+void ClosePerfEvents(std::vector<int> *fds) {
+  for (auto fd : *fds) {
+    (void)close(fd);
+  }
+  fds->clear();
+}
+
+std::vector<int> OpenPerfEvents(const std::vector<uint64_t> &configs) {
+  std::vector<int> fds;
+  for (auto config : configs) {
+    auto fd = OpenPerfEvent(config, fds.empty() ? -1 : fds.front());
+    if (fd == -1) {
+      ClosePerfEvents(&fds);
+      return fds;
+    }
+    fds.push_back(fd);
+  }
+  // counters keep running and kernels take deltas, so kernels of parallel subgraphs on one thread nest safely
+  if (!fds.empty()) {
+    (void)ioctl(fds.front(), PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    (void)ioctl(fds.front(), PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  }
+  return fds;
+}
+#endif
+}  // namespace
+
+LayerProfiler::~LayerProfiler() {
+#if defined(__linux__)
+  for (auto &fds : perf_fds_) {
+    ClosePerfEvents(&fds.second);
+  }
+#endif
+  perf_fds_.clear();
+}
+
+int LayerProfiler::Init(const std::string &perf_event) {
+  start_ = NowUs();
+#if defined(__linux__)
+  std::vector<uint64_t> configs;
+  if (perf_event == "CACHE") {
+    configs = {PERF_COUNT_HW_CACHE_REFERENCES, PERF_COUNT_HW_CACHE_MISSES};
+    counter_names_ = {"cache_ref", "cache_miss"};
+  } else if (perf_event == "STALL") {
+    configs = {PERF_COUNT_HW_STALLED_CYCLES_FRONTEND, PERF_COUNT_HW_STALLED_CYCLES_BACKEND};
+    counter_names_ = {"stall_frontend", "stall_backend"};
+  } else {
+    configs = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS};
+    counter_names_ = {"cycles", "instructions"};
+  }
+  // the calling thread opens its counters up front to find out whether the system allows them at all
+  auto fds = OpenPerfEvents(configs);
+  if (fds.empty()) {
+    MS_LOG(WARNING) << "Open perf event " << perf_event
+                    << " failed, layer profiling goes on without hardware counters.";
+    counter_names_.clear();
+    return RET_OK;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  perf_configs_ = configs;
+  perf_fds_[std::this_thread::get_id()] = fds;
+#else
+  MS_LOG(INFO) << "Hardware counters are only supported on linux, perf event " << perf_event << " is ignored.";
+#endif
+  return RET_OK;
+}
+
+uint64_t LayerProfiler::NowUs() const {
+  return static_cast<uint64_t>(
+    std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count());
+}
+
+size_t LayerProfiler::ThreadIndex() {
+  auto iter = thread_index_.find(std::this_thread::get_id());
+  if (iter != thread_index_.end()) {
+    return iter->second;
+  }
+  auto index = thread_index_.size();
+  thread_index_[std::this_thread::get_id()] = index;
+  return index;
+}
+
+const std::vector<int> &LayerProfiler::ThreadCounters() {
+  auto iter = perf_fds_.find(std::this_thread::get_id());
+  if (iter != perf_fds_.end()) {
+    return iter->second;
+  }
+  std::vector<int> fds;
+#if defined(__linux__)
+  if (!perf_configs_.empty()) {
+    fds = OpenPerfEvents(perf_configs_);
+    if (fds.empty()) {
+      MS_LOG(WARNING) << "Open perf events on a new thread failed, its kernels go without hardware counters.";
+    }
+  }
+#endif
+  return perf_fds_.emplace(std::this_thread::get_id(), fds).first->second;
+}
+
+bool LayerProfiler::ReadCounters(uint64_t *values) {
+#if defined(__linux__)
+  if (perf_configs_.empty()) {
+    return false;
+  }
+  auto &fds = ThreadCounters();
+  if (fds.empty()) {
+    return false;
+  }
+  struct {
+    uint64_t nr;
+    uint64_t values[kLayerProfilerCounterNum];
+  } result;
+  if (read(fds.front(), &result, sizeof(result)) != static_cast<ssize_t>(sizeof(result))) {
+    return false;
+  }
+  for (size_t i = 0; i < kLayerProfilerCounterNum; ++i) {
+    values[i] = result.values[i];
+  }
+  return true;
+#else
+  return false;
+#endif
+}
+
+void LayerProfiler::RunBegin() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  RunEvent run;
+  run.begin = NowUs();
+  runs_.push_back(run);
+  running_ = true;
+}
+
+void LayerProfiler::RunEnd(const std::vector<uint64_t> &busy_time) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!running_) {
+    return;
+  }
+  running_ = false;
+  runs_.back().duration = NowUs() - runs_.back().begin;
+  runs_.back().busy_time = busy_time;
+}
+
+void LayerProfiler::KernelBegin(const std::string &name, const std::string &type,
+                                const std::vector<TensorInfo> &inputs) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!running_) {
+    return;
+  }
+  KernelEvent event;
+  event.name = name;
+  event.type = type;
+  for (auto &input : inputs) {
+    event.inputs.push_back(input.first);
+  }
+  event.tid = ThreadIndex();
+  event.run = runs_.size() - 1;
+  event.has_counters = ReadCounters(event.counters);
+  event.begin = NowUs();
+  pending_[name] = kernels_.size();
+  kernels_.push_back(std::move(event));
+}
+
+void LayerProfiler::KernelEnd(const std::string &name, const std::vector<TensorInfo> &outputs) {
+  auto end = NowUs();
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = pending_.find(name);
+  if (iter == pending_.end()) {
+    return;
+  }
+  auto &event = kernels_.at(iter->second);
+  pending_.erase(iter);
+  event.duration = end - event.begin;
+  event.outputs = outputs;
+  uint64_t counters[kLayerProfilerCounterNum] = {0};
+  if (event.has_counters && ReadCounters(counters)) {
+    for (size_t i = 0; i < kLayerProfilerCounterNum; ++i) {
+      event.counters[i] = counters[i] - event.counters[i];
+    }
+  } else {
+    event.has_counters = false;
+  }
+}
+
+std::vector<size_t> LayerProfiler::EstimatedLiveBytes() const {
+  std::vector<const KernelEvent *> first_run;
+  for (auto &event : kernels_) {
+    if (event.run == 0) {
+      first_run.push_back(&event);
+    }
+  }
+  // a tensor lives from the kernel writing it to the last kernel reading it, graph outputs to the end
+  std::unordered_map<std::string, size_t> last_use;
+  for (size_t i = 0; i < first_run.size(); ++i) {
+    for (auto &input : first_run[i]->inputs) {
+      last_use[input] = i;
+    }
+  }
+  std::vector<size_t> live(first_run.size(), 0);
+  for (size_t i = 0; i < first_run.size(); ++i) {
+    for (auto &output : first_run[i]->outputs) {
+      auto iter = last_use.find(output.first);
+      auto last = (iter == last_use.end() || iter->second < i) ? first_run.size() - 1 : iter->second;
+      for (size_t j = i; j <= last; ++j) {
+        live[j] += output.second;
+      }
+    }
+  }
+  return live;
+}
+
+int LayerProfiler::WriteChromeTrace(const std::string &path) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::ofstream ofs(path, std::ios::out | std::ios::trunc);
+  if (!ofs.good()) {
+    MS_LOG(ERROR) << "Open " << path << " failed.";
+    return RET_ERROR;
+  }
+  auto live = EstimatedLiveBytes();
+  ofs << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+  ofs << R"({"name":"process_name","ph":"M","pid":0,"args":{"name":"benchmark"}})";
+  for (size_t i = 0; i < runs_.size(); ++i) {
+    auto &run = runs_[i];
+    ofs << ",\n"
+        << R"({"name":"run_)" << i << R"(","cat":"run","ph":"X","pid":0,"tid":"graph","ts":)" << run.begin - start_
+        << ",\"dur\":" << run.duration << "}";
+    if (run.busy_time.empty()) {
+      continue;
+    }
+    ofs << ",\n" << R"({"name":"thread busy percent","ph":"C","pid":0,"ts":)" << run.begin - start_ << ",\"args\":{";
+    for (size_t t = 0; t < run.busy_time.size(); ++t) {
+      auto percent = run.duration == 0 ? 0.0 : kPercent * run.busy_time[t] / run.duration;
+      ofs << (t == 0 ? "" : ",") << "\"thread_" << t << "\":" << std::fixed << std::setprecision(1) << percent;
+    }
+    ofs << "}}";
+  }
+  size_t first_run_index = 0;
+  for (auto &event : kernels_) {
+    size_t output_bytes = 0;
+    for (auto &output : event.outputs) {
+      output_bytes += output.second;
+    }
+    ofs << ",\n"
+        << R"({"name":")" << JsonEscape(event.name) << R"(","cat":")" << JsonEscape(event.type)
+        << R"(","ph":"X","pid":0,"tid":)" << event.tid << ",\"ts\":" << event.begin - start_
+        << ",\"dur\":" << event.duration << ",\"args\":{\"run\":" << event.run << ",\"output_bytes\":" << output_bytes;
+    if (event.run == 0 && first_run_index < live.size()) {
+      ofs << ",\"est_live_bytes\":" << live[first_run_index++];
+    }
+    if (event.has_counters) {
+      for (size_t i = 0; i < counter_names_.size(); ++i) {
+        ofs << ",\"" << counter_names_[i] << "\":" << event.counters[i];
+      }
+    }
+    ofs << "}}";
+  }
+  ofs << "\n]}\n";
+  ofs.close();
+  if (!ofs.good()) {
+    MS_LOG(ERROR) << "Write " << path << " failed.";
+    return RET_ERROR;
+  }
+  return RET_OK;
+}
+
+int LayerProfiler::WriteCsv(const std::string &path) const {
+  struct Summary {
+    std::string type;
+    size_t order = 0;
+    size_t calls = 0;
+    uint64_t total = 0;
+    uint64_t min = UINT64_MAX;
+    uint64_t max = 0;
+    size_t output_bytes = 0;
+    size_t est_live_bytes = 0;
+    size_t counter_calls = 0;
+    uint64_t counters[kLayerProfilerCounterNum] = {0};
+  };
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto live = EstimatedLiveBytes();
+  size_t peak = live.empty() ? 0 : *std::max_element(live.begin(), live.end());
+  std::map<std::string, Summary> summaries;
+  uint64_t kernel_total = 0;
+  size_t first_run_index = 0;
+  for (auto &event : kernels_) {
+    auto iter = summaries.find(event.name);
+    if (iter == summaries.end()) {
+      iter = summaries.emplace(event.name, Summary()).first;
+      iter->second.type = event.type;
+      iter->second.order = summaries.size();
+    }
+    auto &summary = iter->second;
+    summary.calls++;
+    summary.total += event.duration;
+    summary.min = std::min(summary.min, event.duration);
+    summary.max = std::max(summary.max, event.duration);
+    kernel_total += event.duration;
+    if (event.run == 0) {
+      summary.output_bytes = 0;
+      for (auto &output : event.outputs) {
+        summary.output_bytes += output.second;
+      }
+      summary.est_live_bytes = first_run_index < live.size() ? live[first_run_index++] : 0;
+    }
+    if (event.has_counters) {
+      summary.counter_calls++;
+      for (size_t i = 0; i < kLayerProfilerCounterNum; ++i) {
+        summary.counters[i] += event.counters[i];
+      }
+    }
+  }
+  std::vector<std::pair<std::string, const Summary *>> ordered;
+  for (auto &summary : summaries) {
+    ordered.emplace_back(summary.first, &summary.second);
+  }
+  std::sort(ordered.begin(), ordered.end(),
+            [](const auto &a, const auto &b) { return a.second->order < b.second->order; });
+
+  std::ofstream ofs(path, std::ios::out | std::ios::trunc);
+  if (!ofs.good()) {
+    MS_LOG(ERROR) << "Open " << path << " failed.";
+    return RET_ERROR;
+  }
+  ofs << std::fixed << std::setprecision(3);
+  ofs << "opName,opType,calledTimes,avg(ms),min(ms),max(ms),percent,outputBytes,estLiveBytes,atEstPeak";
+  for (auto &name : counter_names_) {
+    ofs << ",avg_" << name;
+  }
+  ofs << "\n";
+  for (auto &item : ordered) {
+    auto &summary = *item.second;
+    ofs << CsvEscape(item.first) << "," << CsvEscape(summary.type) << "," << summary.calls << ","
+        << summary.total / kUsPerMs / summary.calls << "," << summary.min / kUsPerMs << "," << summary.max / kUsPerMs
+        << "," << (kernel_total == 0 ? 0.0 : kPercent * summary.total / kernel_total) << "," << summary.output_bytes
+        << "," << summary.est_live_bytes << "," << (peak > 0 && summary.est_live_bytes == peak ? 1 : 0);
+    for (size_t i = 0; i < counter_names_.size(); ++i) {
+      ofs << "," << (summary.counter_calls == 0 ? 0 : summary.counters[i] / summary.counter_calls);
+    }
+    ofs << "\n";
+  }
+
+  // thread pool load over all profiled runs
+  uint64_t run_total = 0;
+  std::vector<uint64_t> busy_total;
+  for (auto &run : runs_) {
+    run_total += run.duration;
+    busy_total.resize(std::max(busy_total.size(), run.busy_time.size()), 0);
+    for (size_t t = 0; t < run.busy_time.size(); ++t) {
+      busy_total[t] += run.busy_time[t];
+    }
+  }
+  if (!busy_total.empty()) {
+    ofs << "\nthread,busy(ms),idle(ms),busy(%)\n";
+    for (size_t t = 0; t < busy_total.size(); ++t) {
+      auto idle = run_total > busy_total[t] ? run_total - busy_total[t] : 0;
+      ofs << "thread_" << t << "," << busy_total[t] / kUsPerMs << "," << idle / kUsPerMs << ","
+          << (run_total == 0 ? 0.0 : kPercent * busy_total[t] / run_total) << "\n";
+    }
+  }
+  ofs << "\nestPeakLiveBytes," << peak << "\n";
+  ofs.close();
+  if (!ofs.good()) {
+    MS_LOG(ERROR) << "Write " << path << " failed.";
+    return RET_ERROR;
+  }
+  return RET_OK;
+}
+}  // namespace luojianet_ms::lite
@@ -0,0 +1,100 @@
+/**
+ * Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+ * Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LUOJIANET_MS_LITE_TOOLS_BENCHMARK_LAYER_PROFILER_H_
+#define LUOJIANET_MS_LITE_TOOLS_BENCHMARK_LAYER_PROFILER_H_
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace luojianet_ms::lite {
+constexpr size_t kLayerProfilerCounterNum = 2;
+
+/* Collects per kernel events from the benchmark callbacks and writes them as a chrome trace
+ * (chrome://tracing or perfetto) and a csv summary. Callbacks may come from several actor threads
+ * when subgraphs run in parallel, so every entry point is guarded. Only kernels between RunBegin and
+ * RunEnd are recorded, warm up and accuracy runs are left out. */
+class LayerProfiler {
+ public:
+  // name and bytes of a kernel input or output
+  using TensorInfo = std::pair<std::string, size_t>;
+
+  LayerProfiler() = default;
+  ~LayerProfiler();
+
+  // perf_event is CYCLE, CACHE or STALL, hardware counters are skipped when the system refuses them. The counters
+  // are opened per thread on its first kernel and only count that thread, so a kernel which splits its work over
+  // the pool counts the share of the thread calling it.
+  int Init(const std::string &perf_event);
+
+  void RunBegin();
+  // busy_time holds microseconds each pool thread spent on tasks during this run, it may be empty
+  void RunEnd(const std::vector<uint64_t> &busy_time);
+  void KernelBegin(const std::string &name, const std::string &type, const std::vector<TensorInfo> &inputs);
+  void KernelEnd(const std::string &name, const std::vector<TensorInfo> &outputs);
+
+  int WriteChromeTrace(const std::string &path) const;
+  int WriteCsv(const std::string &path) const;
+  std::vector<std::string> counter_names() const { return counter_names_; }
+
+ private:
+  struct KernelEvent {
+    std::string name;
+    std::string type;
+    std::vector<std::string> inputs;
+    std::vector<TensorInfo> outputs;
+    uint64_t begin = 0;
+    uint64_t duration = 0;
+    size_t tid = 0;
+    size_t run = 0;
+    bool has_counters = false;
+    uint64_t counters[kLayerProfilerCounterNum] = {0};
+  };
+  struct RunEvent {
+    uint64_t begin = 0;
+    uint64_t duration = 0;
+    std::vector<uint64_t> busy_time;
+  };
+
+  uint64_t NowUs() const;
+  size_t ThreadIndex();
+  // opens the counters of the calling thread the first time, an empty vector means it has none
+  const std::vector<int> &ThreadCounters();
+  bool ReadCounters(uint64_t *values);
+  // Estimated activation bytes alive while each kernel of the first run executes: the sum of the output tensor
+  // sizes over their lifetimes seen in that run. It is not what the allocator holds, which reuses, aligns and
+  // pools the buffers, and it leaves out workspaces and weights.
+  std::vector<size_t> EstimatedLiveBytes() const;
+
+  mutable std::mutex mutex_;
+  uint64_t start_ = 0;
+  std::vector<KernelEvent> kernels_;
+  std::map<std::string, size_t> pending_;
+  std::vector<RunEvent> runs_;
+  std::map<std::thread::id, size_t> thread_index_;
+  bool running_ = false;
+  std::vector<uint64_t> perf_configs_;
+  std::map<std::thread::id, std::vector<int>> perf_fds_;  // group leader first
+  std::vector<std::string> counter_names_;
+};
+}  // namespace luojianet_ms::lite
+#endif  // LUOJIANET_MS_LITE_TOOLS_BENCHMARK_LAYER_PROFILER_H_
@@ -973,6 +973,15 @@ def set_ps_context(**kwargs):
         enable_ssl (bool): Set PS SSL mode enabled or disabled. Default: False.
         client_password (str): Password to decrypt the secret key stored in the client certificate. Default: ''.
         server_password (str): Password to decrypt the secret key stored in the server certificate. Default: ''.
+        embedding_cache_size (int): The row number of the host embedding cache of each embedding table on the
+                                    worker, 0 means the cache is disabled. Default: 0.
+        embedding_cache_policy (str): The eviction policy of the host embedding cache, 'LRU' or 'LFU'.
+                                      Default: 'LRU'.
+        embedding_cache_staleness (int): The number of lookups a row fetched from the server is reused for by the
+                                         host embedding cache. The rows updated on a worker are written through to
+                                         the servers at once, but the other workers keep using their cached copies
+                                         of these rows for up to this number of lookups. Set it to 0 if all the
+                                         workers must see the latest rows. Default: 0.
 
     Raises:
         ValueError: If input key is not the attribute in parameter server training mode context.
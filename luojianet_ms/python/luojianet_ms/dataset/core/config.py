@@ -411,24 +411,38 @@ def load(file):
     _config.load(file)
 
 
-def set_enable_autotune(enable):
+def set_enable_autotune(enable, json_filepath=None):
     """
     Set the default state of AutoTune flag. If it is True, will facilitate users to improve
     performance for a given workload by automatically finding the better settings for data pipeline.
 
     Args:
         enable (bool): Whether to use AutoTune feature when running data pipeline.
+        json_filepath (str, optional): The JSON file to save the tuned config to when AutoTune finishes.
+            If the file exists when the pipeline starts and it was saved for the same pipeline, AutoTune starts
+            from the config in it, so that the next run converges faster. Default: None, not to save the config.
 
     Raises:
         TypeError: If enable is not a boolean data type.
+        TypeError: If json_filepath is not a str.
+        ValueError: If the directory of json_filepath does not exist.
 
     Examples:
-        >>> # Enable AutoTune
-        >>> ds.config.set_enable_autotune(True)
+        >>> # Enable AutoTune and save the tuned config to a file
+        >>> ds.config.set_enable_autotune(True, "/path/to/autotune_out.json")
     """
     if not isinstance(enable, bool):
         raise TypeError("enable must be of type bool.")
+    if json_filepath is None:
+        json_filepath = ""
+    elif not isinstance(json_filepath, str):
+        raise TypeError("json_filepath must be of type str.")
+    else:
+        json_filepath = os.path.realpath(json_filepath)
+        if not os.path.isdir(os.path.dirname(json_filepath)):
+            raise ValueError("The directory of json_filepath does not exist: {}".format(json_filepath))
     _config.set_enable_autotune(enable)
+    _config.set_autotune_config_path(json_filepath)
 
 
 def get_enable_autotune():
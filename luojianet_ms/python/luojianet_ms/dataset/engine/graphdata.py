@@ -29,7 +29,7 @@ from luojianet_ms._c_dataengine import OutputFormat as Format
 from .validators import check_gnn_graphdata, check_gnn_get_all_nodes, check_gnn_get_all_edges, \
     check_gnn_get_nodes_from_edges, check_gnn_get_edges_from_nodes, check_gnn_get_all_neighbors, \
     check_gnn_get_sampled_neighbors, check_gnn_get_neg_sampled_neighbors, check_gnn_get_node_feature, \
-    check_gnn_get_edge_feature, check_gnn_random_walk
+    check_gnn_get_edge_feature, check_gnn_random_walk, check_gnn_save_graph_store
 
 
 class SamplingStrategy(IntEnum):
@@ -67,7 +67,8 @@ class GraphData:
     Reads the graph dataset used for GNN training from the shared file and database.
 
     Args:
-        dataset_file (str): One of file names in the dataset.
+        dataset_file (str): One of file names in the dataset, or the graph store file saved by `save_graph_store`,
+            which is mapped into memory instead of being parsed.
         num_parallel_workers (int, optional): Number of workers to process the dataset in parallel
             (default=None).
         working_mode (str, optional): Set working mode, now supports 'local'/'client'/'server' (default='local').
@@ -470,6 +471,28 @@ class GraphData:
             raise Exception("This method is not supported when working mode is server.")
         return self._graph_data.graph_info()
 
+    @check_gnn_save_graph_store
+    def save_graph_store(self, file_name):
+        """
+        Save the graph into a graph store file, where the neighbors are kept in CSR form and the features are kept
+        in columns. The file can be used as `dataset_file` of GraphData in local mode and loads much faster than
+        the original dataset.
+
+        Args:
+            file_name (str): Path of the graph store file.
+
+        Examples:
+            >>> graph_dataset.save_graph_store("/path/to/graph_store_file")
+            >>> graph_dataset = ds.GraphData(dataset_file="/path/to/graph_store_file")
+
+        Raises:
+            TypeError: If `file_name` is not str.
+            RuntimeError: If the features can't be stored in columns.
+        """
+        if self._working_mode != 'local':
+            raise Exception("This method is only supported when working mode is local.")
+        self._graph_data.save_graph_store(file_name)
+
     @check_gnn_random_walk
     def random_walk(self, target_nodes, meta_path, step_home_param=1.0, step_away_param=1.0, default_node=-1):
         """
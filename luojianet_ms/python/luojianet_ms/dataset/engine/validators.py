@@ -1501,6 +1501,19 @@ def check_gnn_graphdata(method):
     return new_method
 
 
+def check_gnn_save_graph_store(method):
+    """A wrapper that wraps a parameter checker around the GNN `save_graph_store` function."""
+
+    @wraps(method)
+    def new_method(self, *args, **kwargs):
+        [file_name], _ = parse_user_args(method, *args, **kwargs)
+        type_check(file_name, (str,), "file_name")
+
+        return method(self, *args, **kwargs)
+
+    return new_method
+
+
 def check_gnn_get_all_nodes(method):
     """A wrapper that wraps a parameter checker around the GNN `get_all_nodes` function."""
 
@@ -1054,9 +1054,15 @@ class GroupNorm(Module):
         self.square = F.square
         self.reduce_sum = P.ReduceSum(keep_dims=True)
         self.sqrt = P.Sqrt()
+        # the CPU backend has a fused kernel, other targets keep the decomposed computation
+        self.use_fused = context.get_context("device_target") == "CPU"
+        self.group_norm = P.GroupNorm(self.num_groups, self.eps)
 
     def _cal_output(self, x):
         """calculate groupnorm output"""
+        if self.use_fused:
+            _channel_check(self.shape(x)[1], self.num_channels, self.cls_name)
+            return self.group_norm(x, self.gamma, self.beta)[0]
         batch, channel, height, width = self.shape(x)
         _channel_check(channel, self.num_channels, self.cls_name)
         x = self.reshape(x, (batch, self.num_groups, -1))
@@ -42,6 +42,13 @@ bprop_getters = BpropRegistry()
 bprops = BpropRegistry()
 
 
+def inherit_cpu_bf16(prim, *grad_prims):
+    """The gradient primitives of a primitive computing in bfloat16 on cpu compute in bfloat16 too."""
+    if prim.attrs.get("cpu_bf16", False):
+        for grad_prim in grad_prims:
+            grad_prim.add_prim_attr("cpu_bf16", True)
+
+
 def get_bprop_fn(prim):
     """get bprop function by primitive obj or prim name for c++"""
     out = bprop_getters.get(prim, None)
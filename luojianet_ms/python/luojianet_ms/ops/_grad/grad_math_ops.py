@@ -25,7 +25,7 @@ from .. import operations as P
 from ..operations import _grad_ops as G
 from ..composite.multitype_ops.zeros_like_impl import zeros_like
 from ..functional import broadcast_gradient_args, reduced_shape, tuple_div
-from .grad_base import bprop_getters
+from .grad_base import bprop_getters, inherit_cpu_bf16
 from ..primitive import constexpr
 from ..composite.multitype_ops import _constexpr_utils as const_utils
 from ..operations._inner_ops import DynamicStitch, DynamicBroadcastGradientArgs, DynamicBroadcastTo
@@ -176,6 +176,7 @@ def bprop_matmul(self):
                     transpose_b=(ta or (not tb)))
     mul2 = P.MatMul(transpose_a=((not ta) or tb),
                     transpose_b=(ta and tb))
+    inherit_cpu_bf16(self, mul1, mul2)
 
     def bprop(x, w, out, dout):
         if ta:
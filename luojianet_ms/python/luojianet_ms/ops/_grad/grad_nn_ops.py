@@ -17,7 +17,7 @@
 """Define the grad rules of neural network related operations."""
 from luojianet_ms.ops.primitive import constexpr
 from luojianet_ms.ops.operations import nn_ops as nps
-from .grad_base import bprop_getters
+from .grad_base import bprop_getters, inherit_cpu_bf16
 from .. import functional as F
 from .. import operations as P
 from ...common import dtype as mstype
@@ -52,6 +52,7 @@ def get_bprop_conv2d(self):
         self.out_channel, self.kernel_size, self.pad_mode, self.pad, self.pad_list, mode=self.mode,
         dilation=self.dilation, stride=self.stride, group=self.group, data_format=self.format
     )
+    inherit_cpu_bf16(self, input_grad, filter_grad)
     get_shape = P.Shape()
     get_dyn_shape = P.DynamicShape()
 
@@ -730,6 +731,18 @@ def get_bprop_layer_norm(self):
     return bprop
 
 
+@bprop_getters.register(P.GroupNorm)
+def get_bprop_group_norm(self):
+    """Grad definition for `GroupNorm` operation."""
+    group_norm_grad = G.GroupNormGrad(self.num_groups, self.epsilon)
+
+    def bprop(x, gamma, beta, out, dout):
+        dx, d_gamma, d_beta = group_norm_grad(x, dout[0], out[2], out[1], gamma)
+        return dx, d_gamma, d_beta
+
+    return bprop
+
+
 @bprop_getters.register(G.LayerNormGrad)
 def get_bprop_layer_norm_grad(self):
     """Grad definition for `LayerNormGrad` operation."""
@@ -1112,6 +1125,7 @@ def get_bprop_conv2d_backprop_input(self):
         out_channel, self.kernel_size, pad_mode=self.pad_mode.lower(), pad=self.pad,
         dilation=self.dilation, stride=self.stride, group=self.group, data_format=self.format
     )
+    inherit_cpu_bf16(self, filter_grad, input_grad)
     get_shape = P.Shape()
     get_dyn_shape = P.DynamicShape()
 
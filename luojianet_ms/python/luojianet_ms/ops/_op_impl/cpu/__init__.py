@@ -49,6 +49,8 @@ from .hswish_grad import _hswish_grad_cpu
 from .is_finite import _is_finite_cpu
 from .layer_norm import _layer_norm_cpu
 from .layer_norm_grad import _layer_norm_grad_cpu
+from .group_norm import _group_norm_cpu
+from .group_norm_grad import _group_norm_grad_cpu
 from .minimum import _minimum_cpu
 from .minimum_grad import _minimum_grad_cpu
 from .equal_count import _equal_count_cpu
@@ -1191,6 +1191,31 @@ class LayerNormGradGrad(PrimitiveWithInfer):
         return x, dy, gamma
 
 
+class GroupNormGrad(PrimitiveWithInfer):
+    """
+    Computes the gradients of GroupNorm.
+
+    Args:
+        num_groups (int): The number of groups to be divided along the channel dimension.
+        epsilon (float): A value added to the denominator for numerical stability. Default: 1e-5.
+
+    Returns:
+        tuple[Tensor], tuple of 3 values (the gradients of groupnorm input, gamma, beta).
+    """
+
+    @prim_attr_register
+    def __init__(self, num_groups, epsilon=1e-5):
+        """Initialize GroupNormGrad."""
+        validator.check_positive_int(num_groups, "num_groups", self.name)
+        validator.check_value_type('epsilon', epsilon, [float], self.name)
+
+    def infer_shape(self, x, dy, variance, mean, gamma):
+        return x, gamma, gamma
+
+    def infer_dtype(self, x, dy, variance, mean, gamma):
+        return x, gamma, gamma
+
+
 class LogSoftmaxGrad(Primitive):
     """Computes gradient for the Log Softmax activation."""
 
@@ -4524,13 +4524,16 @@ class NMSWithMask(PrimitiveWithInfer):
     Args:
         iou_threshold (float): Specifies the threshold of overlap boxes with respect to
             IOU. Default: 0.5.
+        max_output_size (int): The maximum number of boxes kept, the rest are masked out. -1 means no limit.
+            Only supported on CPU. Default: -1.
 
     Inputs:
         - **bboxes** (Tensor) - The shape of tensor is :math:`(N, 5)`. Input bounding boxes.
           `N` is the number of input bounding boxes. Every bounding box
           contains 5 values, the first 4 values are the coordinates(x0, y0, x1, y1) of bounding box which
           represents the point of top-left and bottom-right, and the last value is the score of this bounding box.
-          The data type must be float16 or float32.
+          The data type must be float16 or float32. Only on CPU the shape can also be :math:`(B, N, 5)`, every one
+          of the `B` groups of boxes, e.g. the boxes of one class, is suppressed on its own.
 
     Outputs:
         tuple[Tensor], tuple of three tensors, they are selected_boxes, selected_idx and selected_mask.
@@ -4542,10 +4545,13 @@ class NMSWithMask(PrimitiveWithInfer):
         - **selected_mask** (Tensor) - The shape of tensor is :math:`(N,)`. A mask list of
           valid output bounding boxes.
 
+        With a :math:`(B, N, 5)` input the outputs get the leading dimension `B` as well.
+
     Raises:
         ValueError: If the `iou_threshold` is not a float number, or if the first dimension
             of input Tensor is less than or equal to 0, or if the data type of the input
             Tensor is not float16 or float32.
+        ValueError: If `max_output_size` is not -1 or `bboxes` is not 2-D when `device_target` is not CPU.
 
     Supported Platforms:
         ``Ascend`` ``GPU`` ``CPU``
@@ -4564,19 +4570,26 @@ class NMSWithMask(PrimitiveWithInfer):
     """
 
     @prim_attr_register
-    def __init__(self, iou_threshold=0.5):
+    def __init__(self, iou_threshold=0.5, max_output_size=-1):
         """Initialize NMSWithMask"""
         validator.check_value_type("iou_threshold", iou_threshold, [float], self.name)
+        validator.check_int(max_output_size, -1, Rel.GE, "max_output_size", self.name)
         self.init_prim_io_names(inputs=['bboxes'], outputs=['selected_boxes', 'selected_idx', 'selected_mask'])
         self.is_ge = context.get_context("enable_ge")
 
     def infer_shape(self, bboxes_shape):
         cls_name = self.name
-        validator.check_equal_int(len(bboxes_shape), 2, "bboxes rank", cls_name)
-        validator.check_positive_int(bboxes_shape[0], "bboxes.shape[0]", cls_name)
-        validator.check_equal_int(bboxes_shape[1], 5, "bboxes.shape[1]", cls_name)
-        num = bboxes_shape[0]
-        return bboxes_shape, (num,), (num,)
+        # only the cpu kernel limits the output size and suppresses batched boxes
+        if context.get_context("device_target") != "CPU":
+            if self.max_output_size != -1:
+                raise ValueError(f"For '{cls_name}', 'max_output_size' is only supported on CPU, "
+                                 f"but got {self.max_output_size}.")
+            validator.check_equal_int(len(bboxes_shape), 2, "bboxes rank", cls_name)
+        validator.check_int_range(len(bboxes_shape), 2, 3, Rel.INC_BOTH, "bboxes rank", cls_name)
+        validator.check_positive_int(bboxes_shape[-2], "bboxes.shape[-2]", cls_name)
+        validator.check_equal_int(bboxes_shape[-1], 5, "bboxes.shape[-1]", cls_name)
+        mask_shape = tuple(bboxes_shape[:-1])
+        return bboxes_shape, mask_shape, mask_shape
 
     def infer_dtype(self, bboxes_dtype):
         validator.check_tensor_dtype_valid("bboxes", bboxes_dtype, [mstype.float16, mstype.float32], self.name)
@@ -3221,6 +3221,77 @@ class LayerNorm(Primitive):
         validator.check_value_type('epsilon', epsilon, [float], self.name)
 
 
+class GroupNorm(PrimitiveWithInfer):
+    r"""
+    Applies the Group Normalization to the input tensor.
+
+    The channels of `input_x` are divided into `num_groups` groups, and every group of each sample is normalized
+    with its own mean and variance. GroupNorm is described in the paper
+    `Group Normalization <https://arxiv.org/pdf/1803.08494.pdf>`_.
+
+    .. math::
+        y = \frac{x - mean}{\sqrt{variance + \epsilon}} * \gamma + \beta
+
+    where :math:`\gamma` is scale, :math:`\beta` is bias, :math:`\epsilon` is epsilon.
+
+    Args:
+        num_groups (int): The number of groups to be divided along the channel dimension.
+        epsilon (float): A value added to the denominator for numerical stability. Default: 1e-5.
+
+    Inputs:
+        - **input_x** (Tensor) - Tensor of shape :math:`(N, C, \ldots)`. The data type must be float16 or float32.
+        - **gamma** (Tensor) - Tensor of shape :math:`(C,)`. The learnable parameter `gamma` as the scale on norm.
+        - **beta** (Tensor) - Tensor of shape :math:`(C,)`. The learnable parameter `beta` as the bias on norm.
+
+    Outputs:
+        tuple[Tensor], tuple of 3 tensors, the normalized input and the statistics of each group.
+
+        - **output_x** (Tensor) - The normalized input, has the same type and shape as the `input_x`.
+        - **mean** (Tensor) - Tensor of shape :math:`(N, num\_groups)`.
+        - **variance** (Tensor) - Tensor of shape :math:`(N, num\_groups)`.
+
+    Raises:
+        TypeError: If `num_groups` is not an int.
+        TypeError: If `epsilon` is not a float.
+        ValueError: If `num_groups` is less than 1 or `C` is not divided by `num_groups`.
+
+    Supported Platforms:
+        ``CPU``
+
+    Examples:
+        >>> input_x = Tensor(np.array([[[1, 2], [3, 4]], [[1, 2], [3, 4]]]), luojianet_ms.float32)
+        >>> gamma = Tensor(np.ones([2]), luojianet_ms.float32)
+        >>> beta = Tensor(np.zeros([2]), luojianet_ms.float32)
+        >>> group_norm = ops.GroupNorm(num_groups=1)
+        >>> output, mean, variance = group_norm(input_x, gamma, beta)
+        >>> print(mean)
+        [[2.5]
+         [2.5]]
+    """
+
+    @prim_attr_register
+    def __init__(self, num_groups, epsilon=1e-5):
+        """Initialize GroupNorm."""
+        validator.check_positive_int(num_groups, "num_groups", self.name)
+        validator.check_value_type('epsilon', epsilon, [float], self.name)
+
+    def infer_shape(self, x_shape, gamma_shape, beta_shape):
+        validator.check_int(len(x_shape), 2, Rel.GE, "rank of input_x", self.name)
+        channel = x_shape[1]
+        if channel % self.num_groups != 0:
+            raise ValueError(f"For '{self.name}', the channel of 'input_x' should be divided by 'num_groups', "
+                             f"but got channel: {channel}, 'num_groups': {self.num_groups}.")
+        validator.check("gamma shape", gamma_shape, "expected shape", [channel], Rel.EQ, self.name)
+        validator.check("beta shape", beta_shape, "expected shape", [channel], Rel.EQ, self.name)
+        stat_shape = [x_shape[0], self.num_groups]
+        return x_shape, stat_shape, stat_shape
+
+    def infer_dtype(self, x_dtype, gamma_dtype, beta_dtype):
+        args = {"input_x": x_dtype, "gamma": gamma_dtype, "beta": beta_dtype}
+        validator.check_tensors_dtypes_same_and_valid(args, [mstype.float16, mstype.float32], self.name)
+        return x_dtype, x_dtype, x_dtype
+
+
 class L2Normalize(PrimitiveWithInfer):
     r"""
     L2 Normalization Operator.
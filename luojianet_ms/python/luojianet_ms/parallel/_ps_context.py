@@ -72,7 +72,10 @@ _set_ps_context_func_map = {
     "dp_delta": ps_context().set_dp_delta,
     "dp_norm_clip": ps_context().set_dp_norm_clip,
     "encrypt_type": ps_context().set_encrypt_type,
-    "http_url_prefix": ps_context().set_http_url_prefix
+    "http_url_prefix": ps_context().set_http_url_prefix,
+    "embedding_cache_size": ps_context().set_embedding_cache_size,
+    "embedding_cache_policy": ps_context().set_embedding_cache_policy,
+    "embedding_cache_staleness": ps_context().set_embedding_cache_staleness
 }
 
 _get_ps_context_func_map = {
@@ -113,7 +116,10 @@ _get_ps_context_func_map = {
     "server_password": ps_context().server_password,
     "scheduler_manage_port": ps_context().scheduler_manage_port,
     "config_file_path": ps_context().config_file_path,
-    "http_url_prefix": ps_context().http_url_prefix
+    "http_url_prefix": ps_context().http_url_prefix,
+    "embedding_cache_size": ps_context().embedding_cache_size,
+    "embedding_cache_policy": ps_context().embedding_cache_policy,
+    "embedding_cache_staleness": ps_context().embedding_cache_staleness
 }
 
 _check_positive_int_keys = ["server_num", "scheduler_port", "fl_server_port",
@@ -121,7 +127,7 @@ _check_positive_int_keys = ["server_num", "scheduler_port", "fl_server_port",
                             "fl_iteration_num", "client_epoch_num", "client_batch_size", "cipher_time_window",
                             "reconstruct_secrets_threshold"]
 
-_check_non_negative_int_keys = ["worker_num"]
+_check_non_negative_int_keys = ["worker_num", "embedding_cache_size", "embedding_cache_staleness"]
 
 _check_positive_float_keys = ["update_model_ratio", "client_learning_rate"]
 
@@ -163,6 +169,15 @@ def _set_ps_context(**kwargs):
         enable_ssl (bool): Set PS SSL mode enabled or disabled. Default: False.
         client_password (str): Password to decrypt the secret key stored in the client certificate. Default: ''.
         server_password (str): Password to decrypt the secret key stored in the server certificate. Default: ''.
+        embedding_cache_size (int): The row number of the host embedding cache of each embedding table on the
+                                    worker, 0 means the cache is disabled. Default: 0.
+        embedding_cache_policy (str): The eviction policy of the host embedding cache, 'LRU' or 'LFU'.
+                                      Default: 'LRU'.
+        embedding_cache_staleness (int): The number of lookups a row fetched from the server is reused for by the
+                                         host embedding cache. The rows updated on a worker are written through to
+                                         the servers at once, but the other workers keep using their cached copies
+                                         of these rows for up to this number of lookups. Set it to 0 if all the
+                                         workers must see the latest rows. Default: 0.
 
     Raises:
         ValueError: If input key is not the attribute in parameter server training mode context.
@@ -25,9 +25,10 @@ from .amp import build_train_network
 from .loss_scale_manager import LossScaleManager, FixedLossScaleManager, DynamicLossScaleManager
 from .serialization import save_checkpoint, load_checkpoint, load_param_into_net, export, load, parse_print,\
     build_searched_strategy, merge_sliced_parameter, load_distributed_checkpoint, async_ckpt_thread_status,\
-    restore_group_info_list
+    restore_group_info_list, convert_checkpoint
 
 __all__ = ["Model", "DatasetHelper", "amp", "connect_network_with_dataset", "build_train_network", "LossScaleManager",
            "FixedLossScaleManager", "DynamicLossScaleManager", "save_checkpoint", "load_checkpoint",
            "load_param_into_net", "export", "load", "parse_print", "build_searched_strategy", "merge_sliced_parameter",
-           "load_distributed_checkpoint", "async_ckpt_thread_status", "restore_group_info_list"]
+           "load_distributed_checkpoint", "async_ckpt_thread_status", "restore_group_info_list",
+           "convert_checkpoint"]
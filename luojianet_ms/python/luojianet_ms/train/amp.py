@@ -21,6 +21,7 @@ from ..common import dtype as mstype
 from ..nn.wrap.cell_wrapper import _VirtualDatasetCell, _TrainPipelineAccuStepCell
 from ..nn.wrap.loss_scale import _TrainPipelineWithLossScaleCell
 from ..ops import functional as F
+from ..ops import operations as P
 from ..parallel._utils import _get_parallel_mode, _get_pipeline_stages
 from .loss_scale_manager import DynamicLossScaleManager, LossScaleManager
 from ..context import ParallelMode
@@ -56,11 +57,23 @@ def _do_keep_batchnorm_fp32(network):
         network.cell_list = list(network.cells())
 
 
+def _do_cpu_bf16_compute(network):
+    """Let the convolution and matmul primitives of the network and their gradients compute in bfloat16 on cpu."""
+    for _, cell in network.cells_and_names():
+        for prim in cell._primitives.values():  # pylint: disable=protected-access
+            if isinstance(prim, (P.Conv2D, P.Conv2DBackpropInput, P.MatMul)):
+                prim.add_prim_attr("cpu_bf16", True)
+
+
 _config_level = {
     "O0": {
         "keep_batchnorm_fp32": False,
         "cast_model_type": mstype.float32,
         "loss_scale_manager": None},
+    "O1": {
+        "keep_batchnorm_fp32": False,
+        "cast_model_type": mstype.float32,
+        "loss_scale_manager": None},
     "O2": {
         "keep_batchnorm_fp32": True,
         "cast_model_type": mstype.float16,
@@ -91,19 +104,21 @@ def _check_kwargs(key_words):
 def _check_level(level, boost_level):
     """Check level."""
     if not isinstance(level, str):
-        raise TypeError("The argument `level` must be a string in ['O0', 'O2', 'O3', 'auto'], \
+        raise TypeError("The argument `level` must be a string in ['O0', 'O1', 'O2', 'O3', 'auto'], \
                          but got type {}.".format(type(level)))
-    validator.check('level', level, "", ['O0', 'O2', 'O3', 'auto'], Rel.IN)
+    validator.check('level', level, "", ['O0', 'O1', 'O2', 'O3', 'auto'], Rel.IN)
     validator.check('boost_level', boost_level, "", ['O0', 'O1', 'O2'], Rel.IN)
 
+    device_target = context.get_context('device_target')
     if level == "auto":
-        device_target = context.get_context('device_target')
         if device_target == "GPU":
             level = "O2"
         elif device_target == "Ascend":
             level = "O3"
         else:
-            raise ValueError("Level `auto` only support when `device_target` is GPU or Ascend.")
+            level = "O1"
+    if level == "O1" and device_target != "CPU":
+        raise ValueError("Level `O1` only support when `device_target` is CPU.")
 
     enable_boost = False
     if boost_level in ["O1", "O2"]:
@@ -145,18 +160,23 @@ def build_train_network(network, optimizer, loss_fn=None, level='O0', boost_leve
         loss_fn (Union[None, Module]): Definition of the loss_fn. If None, the `network` should have the loss inside.
             Default: None.
         optimizer (Optimizer): Optimizer to update the Parameter.
-        level (str): Supports ["O0", "O2", "O3", "auto"]. Default: "O0".
+        level (str): Supports ["O0", "O1", "O2", "O3", "auto"]. Default: "O0".
 
             - O0: Do not change.
+            - O1: Keep the network and its parameters in float32, the Conv2D, Conv2DBackpropInput and MatMul
+              primitives of the cells in `network` and their gradients compute in bfloat16 with float32
+              accumulation. Only supported on CPU, the kernels stay in float32 when the processor has no fast
+              bfloat16 instructions.
             - O2: Cast network to float16, keep batchnorm and `loss_fn` (if set) run in float32,
               using dynamic loss scale.
             - O3: Cast network to float16, with additional property `keep_batchnorm_fp32=False` .
             - auto: Set to level to recommended level in different devices. Set level to O2 on GPU, Set
-              level to O3 Ascend. The recommended level is chosen by the export experience, cannot
-              always general. User should specify the level for special network.
+              level to O3 Ascend, set level to O1 on CPU. The recommended level is chosen by the export experience,
+              cannot always general. User should specify the level for special network.
 
-            O2 is recommended on GPU, O3 is recommended on Ascend. Property of `keep_batchnorm_fp32`, `cast_model_type`
-            and `loss_scale_manager` determined by `level` setting may be overwritten by settings in `kwargs`.
+            O2 is recommended on GPU, O3 is recommended on Ascend, O1 is recommended on CPU. Property of
+            `keep_batchnorm_fp32`, `cast_model_type` and `loss_scale_manager` determined by `level` setting may be
+            overwritten by settings in `kwargs`.
 
         boost_level (str): Option for argument `level` in `luojianet_ms.boost` , level for boost mode
             training. Supports ["O0", "O1", "O2"]. Default: "O0".
@@ -177,8 +197,7 @@ def build_train_network(network, optimizer, loss_fn=None, level='O0', boost_leve
         loss_scale_manager (Union[None, LossScaleManager]): If None, not scale the loss, otherwise scale the loss by
             `LossScaleManager` . If set, the `level` setting will take no effect on this property.
     Raises:
-        ValueError: Auto mixed precision only supported on device GPU and Ascend. If device is CPU, a `ValueError`
-            exception will be raised.
+        ValueError: Level `O1` is only supported on device CPU.
         ValueError: If device is CPU, property `loss_scale_manager` only can be set as `None` or `FixedLossScaleManager`
             (with property `drop_overflow_update=False` ), or a `ValueError` exception will be raised.
     """
@@ -190,6 +209,9 @@ def build_train_network(network, optimizer, loss_fn=None, level='O0', boost_leve
     _check_kwargs(kwargs)
     config = dict(_config_level[level], **kwargs)
 
+    if level == "O1":
+        _do_cpu_bf16_compute(network)
+
     if config["cast_model_type"] == mstype.float16:
         network.to_float(mstype.float16)
 
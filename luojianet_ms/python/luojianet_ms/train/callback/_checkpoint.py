@@ -25,7 +25,7 @@ from luojianet_ms import log as logger
 from luojianet_ms import nn
 from luojianet_ms._checkparam import Validator
 from luojianet_ms.train._utils import _make_directory
-from luojianet_ms.train.serialization import save_checkpoint, _save_graph
+from luojianet_ms.train.serialization import save_checkpoint, _save_graph, _load_delta_manifest, DELTA_MANIFEST_SUFFIX
 from luojianet_ms.parallel._ps_context import _is_role_pserver, _get_ps_mode_rank
 from luojianet_ms.parallel._cell_wrapper import destroy_allgather_cell
 from ._callback import Callback, set_cur_net
@@ -96,6 +96,11 @@ class CheckpointConfig:
         enc_mode (str): This parameter is valid only when enc_key is not set to None. Specifies the encryption
                         mode, currently supports 'AES-GCM' and 'AES-CBC'. Default: 'AES-GCM'.
         exception_save (bool): Whether to save the current checkpoint when an exception occurs. Default: False.
+        delta_save (bool): Whether to save the checkpoints in the delta format, where only the parameters changed
+            since the previous checkpoint are saved. It can't be used with `enc_key`. Default: False.
+        delta_compact_interval (int): In the delta format, every `delta_compact_interval` checkpoints begin with
+            a checkpoint saving all the parameters, so the older checkpoints are no longer needed and can be removed
+            by the keep strategy. The checkpoints still needed by the later ones are kept. Default: 10.
 
     Raises:
         ValueError: If input parameter is not the correct type.
@@ -147,7 +152,9 @@ class CheckpointConfig:
                  append_info=None,
                  enc_key=None,
                  enc_mode='AES-GCM',
-                 exception_save=False):
+                 exception_save=False,
+                 delta_save=False,
+                 delta_compact_interval=10):
 
         if save_checkpoint_steps is not None:
             save_checkpoint_steps = Validator.check_non_negative_int(save_checkpoint_steps)
@@ -191,6 +198,10 @@ class CheckpointConfig:
         self._append_dict = self._handle_append_info(append_info)
         self._enc_key = Validator.check_isinstance('enc_key', enc_key, (type(None), bytes))
         self._enc_mode = Validator.check_isinstance('enc_mode', enc_mode, str)
+        self._delta_save = Validator.check_bool(delta_save)
+        self._delta_compact_interval = Validator.check_positive_int(delta_compact_interval)
+        if self._delta_save and self._enc_key is not None:
+            raise ValueError("For 'CheckpointConfig', the 'delta_save' can't be used with 'enc_key'.")
 
     @property
     def save_checkpoint_steps(self):
@@ -237,6 +248,16 @@ class CheckpointConfig:
         """Get the value of _enc_mode"""
         return self._enc_mode
 
+    @property
+    def delta_save(self):
+        """Get the value of _delta_save"""
+        return self._delta_save
+
+    @property
+    def delta_compact_interval(self):
+        """Get the value of _delta_compact_interval"""
+        return self._delta_compact_interval
+
     @property
     def append_dict(self):
         """Get the value of append_dict."""
@@ -342,6 +363,7 @@ class ModelCheckpoint(Callback):
         self._append_step_num = self._append_dict["step_num"] if "step_num" in self._append_dict else 0
         self._graph_saved = False
         self._need_flush_from_cache = True
+        self._delta_save_num = 0
 
     def step_end(self, run_context):
         """
@@ -417,15 +439,16 @@ class ModelCheckpoint(Callback):
                 + str(step_num_in_epoch) + ".ckpt"
             # update checkpoint file list.
             self._manager.update_ckpoint_filelist(self._directory, self._prefix)
+            delta_base = self._get_delta_base()
             # keep checkpoint files number equal max number.
             if self._config.keep_checkpoint_max and 0 < self._config.keep_checkpoint_max <= self._manager.ckpoint_num:
-                self._manager.remove_oldest_ckpoint_file()
+                self._manager.remove_oldest_ckpoint_file(delta_base)
             elif self._config.keep_checkpoint_per_n_minutes and self._config.keep_checkpoint_per_n_minutes > 0:
                 self._cur_time_for_keep = time.time()
                 if (self._cur_time_for_keep - self._last_time_for_keep) \
                         < self._config.keep_checkpoint_per_n_minutes * 60:
                     self._manager.keep_one_ckpoint_per_minutes(self._config.keep_checkpoint_per_n_minutes,
-                                                               self._cur_time_for_keep)
+                                                               self._cur_time_for_keep, delta_base)
 
             # generate the new checkpoint file and rename it.
             global _save_dir
@@ -442,11 +465,28 @@ class ModelCheckpoint(Callback):
             if "step_num" in self._append_dict:
                 self._append_dict["step_num"] = self._append_step_num + cb_params.cur_step_num
             network = self._config.saved_network if self._config.saved_network is not None else cb_params.train_network
-            save_checkpoint(network, cur_file, self._config.integrated_save, self._config.async_save,
-                            self._append_dict, self._config.enc_key, self._config.enc_mode)
+            if self._config.delta_save:
+                save_checkpoint(network, cur_file, self._config.integrated_save, self._config.async_save,
+                                self._append_dict, ckpt_format="delta", delta_base=delta_base)
+                self._delta_save_num += 1
+            else:
+                save_checkpoint(network, cur_file, self._config.integrated_save, self._config.async_save,
+                                self._append_dict, self._config.enc_key, self._config.enc_mode)
 
             self._latest_ckpt_file_name = cur_file
 
+    def _get_delta_base(self):
+        """Get the base of next delta checkpoint, it is None when all the parameters should be saved."""
+        if not self._config.delta_save or self._delta_save_num % self._config.delta_compact_interval == 0:
+            return None
+        # the base file and its manifest are written at the end of asynchronous saving
+        for thread in threading.enumerate():
+            if thread.getName() == "asyn_save_ckpt":
+                thread.join()
+        if not os.path.isfile(self._latest_ckpt_file_name):
+            return None
+        return self._latest_ckpt_file_name
+
     def _flush_from_cache(self, cb_params):
         """Flush cache data to host if tensor is cache enable."""
         has_cache_params = False
@@ -480,6 +520,17 @@ class CheckpointManager:
         """Get the number of the related checkpoint files managed here."""
         return len(self._ckpoint_filelist)
 
+    def _is_delta_referenced(self, file_name):
+        """Whether the other delta checkpoint files refer to the tensors saved in the checkpoint file."""
+        base_name = os.path.basename(file_name)
+        for ckpt_file in self._ckpoint_filelist:
+            if ckpt_file == file_name:
+                continue
+            manifest = _load_delta_manifest(ckpt_file)
+            if manifest and any(item["file"] == base_name for item in manifest["tensors"].values()):
+                return True
+        return False
+
     def update_ckpoint_filelist(self, directory, prefix):
         """Update the checkpoint file list."""
         self._ckpoint_filelist = []
@@ -493,21 +544,34 @@ class CheckpointManager:
 
     def remove_ckpoint_file(self, file_name):
         """Remove the specified checkpoint file from this checkpoint manager and also from the directory."""
+        if self._is_delta_referenced(file_name):
+            logger.info("The checkpoint file %s is kept, since the later delta checkpoints depend on it.", file_name)
+            return
         try:
             os.chmod(file_name, stat.S_IWRITE)
             os.remove(file_name)
             self._ckpoint_filelist.remove(file_name)
+            manifest_file = file_name + DELTA_MANIFEST_SUFFIX
+            if os.path.isfile(manifest_file):
+                os.chmod(manifest_file, stat.S_IWRITE)
+                os.remove(manifest_file)
         except OSError:
             logger.warning("OSError, failed to remove the older ckpt file %s.", file_name)
         except ValueError:
             logger.warning("ValueError, failed to remove the older ckpt file %s.", file_name)
 
-    def remove_oldest_ckpoint_file(self):
-        """Remove the oldest checkpoint file from this checkpoint manager and also from the directory."""
+    def remove_oldest_ckpoint_file(self, keep_file=None):
+        """
+        Remove the oldest checkpoint file from this checkpoint manager and also from the directory. The files
+        depended on by the delta checkpoints and the `keep_file` are skipped.
+        """
         ckpoint_files = sorted(self._ckpoint_filelist, key=os.path.getmtime)
-        self.remove_ckpoint_file(ckpoint_files[0])
+        for ckpoint_file in ckpoint_files:
+            if ckpoint_file != keep_file and not self._is_delta_referenced(ckpoint_file):
+                self.remove_ckpoint_file(ckpoint_file)
+                return
 
-    def keep_one_ckpoint_per_minutes(self, minutes, cur_time):
+    def keep_one_ckpoint_per_minutes(self, minutes, cur_time, keep_file=None):
         """Only keep the latest one ckpt file per minutes, remove other files generated in [last_time, cur_time]."""
         del_list = []
         oldest_file = ''
@@ -522,6 +586,6 @@ class CheckpointManager:
                     oldest_file = ck_file
 
         for mv_file in del_list:
-            if mv_file == oldest_file:
+            if mv_file in (oldest_file, keep_file):
                 continue
             self.remove_ckpoint_file(mv_file)
@@ -30,7 +30,7 @@ from luojianet_ms import log as logger
 from luojianet_ms import context
 from luojianet_ms.common.tensor import Tensor
 from luojianet_ms.common.parameter import Parameter
-from luojianet_ms.train.summary.summary_record import SummaryRecord, process_export_options
+from luojianet_ms.train.summary.summary_record import SummaryRecord, process_export_options, process_compress_options
 from luojianet_ms.train.summary.enums import PluginEnum, ModeEnum
 from luojianet_ms.train.callback import Callback, ModelCheckpoint
 from luojianet_ms.train import lineage_pb2
@@ -166,6 +166,10 @@ class SummaryCollector(Callback):
 
               - npy: export tensor as npy file.
 
+        compress_options (Union[None, dict]): Downsample and quantize the image and tensor summaries before they are
+            written. See `SummaryRecord` for the supported keys. Default: None, it means that the data is recorded
+            at full resolution.
+
     Raises:
         ValueError: If the parameter value is not expected.
         TypeError: If the parameter type is not expected.
@@ -225,7 +229,8 @@ class SummaryCollector(Callback):
                  custom_lineage_data=None,
                  collect_tensor_freq=None,
                  max_file_size=None,
-                 export_options=None):
+                 export_options=None,
+                 compress_options=None):
 
         if security.enable_security():
             raise ValueError('The Summary is not supported, please without `-s on` and recompile source.')
@@ -246,6 +251,7 @@ class SummaryCollector(Callback):
         self._max_file_size = max_file_size
 
         self._export_options = process_export_options(export_options)
+        self._compress_options = process_compress_options(compress_options)
 
         self._check_action(keep_default_action)
 
@@ -278,7 +284,8 @@ class SummaryCollector(Callback):
         self._record = SummaryRecord(log_dir=self._summary_dir,
                                      max_file_size=self._max_file_size,
                                      raise_exception=False,
-                                     export_options=self._export_options)
+                                     export_options=self._export_options,
+                                     compress_options=self._compress_options)
         self._first_step, self._dataset_sink_mode = True, True
         return self
 
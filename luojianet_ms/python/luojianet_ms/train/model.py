@@ -137,16 +137,17 @@ class Model:
                              :func: `mindindex.nn.metric.set_indexes` is recommended instead of `eval_indexes`.
                              Default: None.
         amp_level (str): Option for argument `level` in :func:`luojianet_ms.build_train_network`, level for mixed
-            precision training. Supports ["O0", "O2", "O3", "auto"]. Default: "O0".
+            precision training. Supports ["O0", "O1", "O2", "O3", "auto"]. Default: "O0".
 
             - O0: Do not change.
+            - O1: Keep network in float32, the convolution and matmul kernels compute in bfloat16, only on CPU.
             - O2: Cast network to float16, keep batchnorm run in float32, using dynamic loss scale.
             - O3: Cast network to float16, the batchnorm is also cast to float16, loss scale will not be used.
             - auto: Set level to recommended level in different devices. Set level to O2 on GPU, set
-              level to O3 on Ascend. The recommended level is chosen by the export experience, not applicable to all
-              scenarios. User should specify the level for special network.
+              level to O3 on Ascend, set level to O1 on CPU. The recommended level is chosen by the export experience,
+              not applicable to all scenarios. User should specify the level for special network.
 
-            O2 is recommended on GPU, O3 is recommended on Ascend.
+            O2 is recommended on GPU, O3 is recommended on Ascend, O1 is recommended on CPU.
             The batchnorm strategy can be changed by `keep_batchnorm_fp32` settings in `kwargs`. `keep_batchnorm_fp32`
             must be a bool. The loss scale strategy can be changed by `loss_scale_manager` setting in `kwargs`.
             `loss_scale_manager` should be a subclass of :class:`luojianet_ms.LossScaleManager`.
@@ -239,7 +240,7 @@ class Model:
             raise ValueError("For 'Model', the '**kwargs' argument should be empty when network is a GraphCell.")
 
     def _process_amp_args(self, kwargs):
-        if self._amp_level in ["O0", "O3"]:
+        if self._amp_level in ["O0", "O1", "O3"]:
             self._keep_bn_fp32 = False
         if 'keep_batchnorm_fp32' in kwargs:
             self._keep_bn_fp32 = kwargs['keep_batchnorm_fp32']
@@ -53,6 +53,7 @@ from luojianet_ms.parallel._tensor import _reshape_param_data
 from luojianet_ms.parallel._tensor import _reshape_param_data_with_weight
 from luojianet_ms.parallel._utils import _infer_rank_list, _remove_repeated_slices
 from .._c_expression import load_mindir, _encrypt, _decrypt, _is_cipher_file
+from .._c_expression import _save_checkpoint_file, _is_native_checkpoint_file, _hash_tensors, CheckpointReader_
 
 tensor_to_ms_type = {"Int8": mstype.int8, "UInt8": mstype.uint8, "Int16": mstype.int16, "UInt16": mstype.uint16,
                      "Int32": mstype.int32, "UInt32": mstype.uint32, "Int64": mstype.int64, "UInt64": mstype.uint64,
@@ -70,6 +71,8 @@ SLICE_SIZE = 512 * 1024
 PROTO_LIMIT_SIZE = 1024 * 1024 * 2
 TOTAL_SAVE = 1024 * 1024
 PARAMETER_SPLIT_SIZE = 1024 * 1024 * 1024
+# the manifest of delta checkpoint is saved beside it, with the name of checkpoint file and this suffix
+DELTA_MANIFEST_SUFFIX = ".manifest"
 
 
 def _special_process_par(par, new_par):
@@ -208,8 +211,40 @@ def _exec_save(ckpt_file_name, data_list, enc_key=None, enc_mode="AES-GCM"):
         raise e
 
 
-def save_checkpoint(save_obj, ckpt_file_name, integrated_save=True,
-                    async_save=False, append_dict=None, enc_key=None, enc_mode="AES-GCM"):
+def _exec_save_native(ckpt_file_name, names, tensors):
+    """Execute the process of saving native checkpoint into file."""
+    try:
+        with _ckpt_mutex:
+            if os.path.exists(ckpt_file_name):
+                os.remove(ckpt_file_name)
+            _save_checkpoint_file(ckpt_file_name, names, tensors)
+        os.chmod(ckpt_file_name, stat.S_IRUSR)
+
+    except BaseException as e:
+        logger.critical("Failed to save the checkpoint file %s. Maybe don't have the permission to write files, "
+                        "or the disk space is insufficient and so on.", ckpt_file_name)
+        raise e
+
+
+def _exec_save_delta(ckpt_file_name, names, tensors, manifest):
+    """Execute the process of saving delta checkpoint and its manifest into files."""
+    _exec_save_native(ckpt_file_name, names, tensors)
+    manifest_file = ckpt_file_name + DELTA_MANIFEST_SUFFIX
+    try:
+        with _ckpt_mutex:
+            if os.path.exists(manifest_file):
+                os.remove(manifest_file)
+            with open(manifest_file, "w") as f:
+                json.dump(manifest, f)
+        os.chmod(manifest_file, stat.S_IRUSR)
+
+    except BaseException as e:
+        logger.critical("Failed to save the manifest of checkpoint file %s.", ckpt_file_name)
+        raise e
+
+
+def save_checkpoint(save_obj, ckpt_file_name, integrated_save=True, async_save=False, append_dict=None,
+                    enc_key=None, enc_mode="AES-GCM", ckpt_format="protobuf", delta_base=None):
     """
     Save checkpoint to a specified file.
 
@@ -227,10 +262,22 @@ def save_checkpoint(save_obj, ckpt_file_name, integrated_save=True,
                                       is not required. Default: None.
         enc_mode (str): This parameter is valid only when enc_key is not set to None. Specifies the encryption
                         mode, currently supports 'AES-GCM' and 'AES-CBC'. Default: 'AES-GCM'.
+        ckpt_format (str): The format of checkpoint file, supports 'protobuf' and 'native'. The 'native' format
+                           keeps an index of the tensors and their raw data aligned in the file, it is saved by
+                           multiple threads and loaded lazily, without the 2GB limit of protobuf. It doesn't
+                           support encryption. The 'delta' format is the native format, and only the tensors
+                           changed since the checkpoint `delta_base` are saved, with a manifest file recording the
+                           content hashes and the files of all the tensors. Default: 'protobuf'.
+        delta_base (Union[None, str]): The base checkpoint file of the 'delta' format, which should be saved in the
+                                       'delta' format in the same directory. If it is None, all the tensors are
+                                       saved, and the checkpoint can be the base of the later ones. Default: None.
 
     Raises:
         TypeError: If the parameter save_obj is not `nn.Module` or list type. And if the parameter
                    `integrated_save` and `async_save` are not bool type.
+        ValueError: If `ckpt_format` is 'native' or 'delta' and `enc_key` is set.
+        ValueError: If `delta_base` is set and `ckpt_format` is not 'delta', or `delta_base` is not a delta
+                    checkpoint in the same directory.
 
     Examples:
         >>> from luojianet_ms import save_checkpoint
@@ -247,6 +294,14 @@ def save_checkpoint(save_obj, ckpt_file_name, integrated_save=True,
     append_dict = _check_append_dict(append_dict)
     enc_key = Validator.check_isinstance('enc_key', enc_key, (type(None), bytes))
     enc_mode = Validator.check_isinstance('enc_mode', enc_mode, str)
+    ckpt_format = Validator.check_string(ckpt_format, ["protobuf", "native", "delta"], "ckpt_format",
+                                         "save_checkpoint")
+    if ckpt_format != "protobuf" and enc_key is not None:
+        raise ValueError(f"For 'save_checkpoint', the {ckpt_format} checkpoint format does not support encryption, "
+                         f"please set 'ckpt_format' to 'protobuf' when 'enc_key' is set.")
+    if delta_base is not None and ckpt_format != "delta":
+        raise ValueError(f"For 'save_checkpoint', the argument 'delta_base' can only be set when 'ckpt_format' is "
+                         f"'delta', but got 'ckpt_format' {ckpt_format}.")
 
     logger.info("Execute the process of saving checkpoint files.")
 
@@ -275,6 +330,15 @@ def save_checkpoint(save_obj, ckpt_file_name, integrated_save=True,
             append_info_list.append({"name": k_name, "data": Tensor(value)})
             save_obj.extend(append_info_list)
 
+    if ckpt_format == "native":
+        _save_native_checkpoint(save_obj, os.path.realpath(ckpt_file_name), async_save)
+        logger.info("Saving checkpoint process is finished.")
+        return
+    if ckpt_format == "delta":
+        _save_delta_checkpoint(save_obj, os.path.realpath(ckpt_file_name), delta_base, async_save)
+        logger.info("Saving checkpoint process is finished.")
+        return
+
     data_list = {}
     with _ckpt_mutex:
         for param in save_obj:
@@ -305,6 +369,82 @@ def save_checkpoint(save_obj, ckpt_file_name, integrated_save=True,
     logger.info("Saving checkpoint process is finished.")
 
 
+def _save_native_checkpoint(save_obj, ckpt_file_name, async_save):
+    """Save the data list into native checkpoint file, the tensor data is written without serialization."""
+    names = []
+    tensors = []
+    with _ckpt_mutex:
+        for param in save_obj:
+            if isinstance(param["data"], Parameter):
+                param["data"].init_data()
+            names.append(param["name"])
+            tensors.append(param["data"])
+    if async_save:
+        tensors = [Tensor(tensor.asnumpy().copy(), tensor.dtype) for tensor in tensors]
+        thr = Thread(target=_exec_save_native, args=(ckpt_file_name, names, tensors), name="asyn_save_ckpt")
+        thr.start()
+    else:
+        _exec_save_native(ckpt_file_name, names, tensors)
+
+
+def _load_delta_manifest(ckpt_file_name):
+    """Load the manifest of delta checkpoint, it is None if the checkpoint is not saved in the delta format."""
+    manifest_file = ckpt_file_name + DELTA_MANIFEST_SUFFIX
+    if not os.path.isfile(manifest_file):
+        return None
+    with open(manifest_file, "r") as f:
+        return json.load(f)
+
+
+def _save_delta_checkpoint(save_obj, ckpt_file_name, delta_base, async_save):
+    """Save the tensors changed since the base checkpoint, the unchanged ones refer to the files holding them."""
+    names = []
+    tensors = []
+    with _ckpt_mutex:
+        for param in save_obj:
+            if isinstance(param["data"], Parameter):
+                param["data"].init_data()
+            names.append(param["name"])
+            tensors.append(param["data"])
+        hashes = _hash_tensors(tensors)
+
+    base_tensors = {}
+    base_name = None
+    if delta_base is not None:
+        delta_base = os.path.realpath(delta_base)
+        if delta_base == ckpt_file_name or os.path.dirname(delta_base) != os.path.dirname(ckpt_file_name):
+            raise ValueError(f"For 'save_checkpoint', the 'delta_base' should be another checkpoint file in the same "
+                             f"directory, but got {delta_base}.")
+        base_manifest = _load_delta_manifest(delta_base)
+        if base_manifest is None:
+            raise ValueError(f"For 'save_checkpoint', the 'delta_base' {delta_base} is not saved in the delta format.")
+        base_tensors = base_manifest["tensors"]
+        base_name = os.path.basename(delta_base)
+
+    file_name = os.path.basename(ckpt_file_name)
+    manifest_tensors = {}
+    changed_names = []
+    changed_tensors = []
+    for name, tensor, hash_value in zip(names, tensors, hashes):
+        hash_str = "{:016x}".format(hash_value)
+        if name in base_tensors and base_tensors[name]["hash"] == hash_str:
+            manifest_tensors[name] = base_tensors[name]
+        else:
+            manifest_tensors[name] = {"hash": hash_str, "file": file_name}
+            changed_names.append(name)
+            changed_tensors.append(tensor)
+    manifest = {"base": base_name, "tensors": manifest_tensors}
+    logger.info("The delta checkpoint %s saves %d of %d tensors.", ckpt_file_name, len(changed_names), len(names))
+
+    if async_save:
+        changed_tensors = [Tensor(tensor.asnumpy().copy(), tensor.dtype) for tensor in changed_tensors]
+        thr = Thread(target=_exec_save_delta, args=(ckpt_file_name, changed_names, changed_tensors, manifest),
+                     name="asyn_save_ckpt")
+        thr.start()
+    else:
+        _exec_save_delta(ckpt_file_name, changed_names, changed_tensors, manifest)
+
+
 def _check_param_prefix(filter_prefix, param_name):
     """Checks whether the prefix of parameter name matches the given filter_prefix."""
     for prefix in filter_prefix:
@@ -399,6 +539,11 @@ def load_checkpoint(ckpt_file_name, net=None, strict_load=False, filter_prefix=N
     """
     Load checkpoint info from a specified file.
 
+    Both the protobuf and the native checkpoint files are supported, the format is detected from the file. The
+    native checkpoint file is mapped into memory and only the parameters not filtered are read. The tensors of delta
+    checkpoint are read from the checkpoint files recorded in its manifest, which should be kept in the same
+    directory.
+
     Args:
         ckpt_file_name (str): Checkpoint file name.
         net (Module): The network where the parameters will be loaded. Default: None
@@ -431,6 +576,15 @@ def load_checkpoint(ckpt_file_name, net=None, strict_load=False, filter_prefix=N
     dec_key = Validator.check_isinstance('dec_key', dec_key, (type(None), bytes))
     dec_mode = Validator.check_isinstance('dec_mode', dec_mode, str)
     logger.info("Execute the process of loading checkpoint files.")
+    if dec_key is None and _is_native_checkpoint_file(ckpt_file_name):
+        parameter_dict = _load_native_checkpoint(ckpt_file_name, filter_prefix)
+        if not parameter_dict:
+            raise ValueError(f"The loaded parameter dict is empty after filtering, please check whether "
+                             f"'filter_prefix' was set to filter out all parameters.")
+        if net is not None:
+            load_param_into_net(net, parameter_dict, strict_load)
+        return parameter_dict
+
     checkpoint_list = Checkpoint()
 
     try:
@@ -500,6 +654,62 @@ def load_checkpoint(ckpt_file_name, net=None, strict_load=False, filter_prefix=N
     return parameter_dict
 
 
+def _load_native_checkpoint(ckpt_file_name, filter_prefix):
+    """Load the parameters from native or delta checkpoint file, the filtered parameters are not read."""
+    parameter_dict = {}
+    try:
+        readers = {}
+        manifest = _load_delta_manifest(ckpt_file_name)
+        if manifest is None:
+            readers[ckpt_file_name] = CheckpointReader_(ckpt_file_name)
+            tensor_files = {name: ckpt_file_name for name in readers[ckpt_file_name].names()}
+        else:
+            ckpt_dir = os.path.dirname(ckpt_file_name)
+            tensor_files = {name: os.path.join(ckpt_dir, item["file"]) for name, item in manifest["tensors"].items()}
+        for name, file_name in tensor_files.items():
+            if filter_prefix is not None and _check_param_prefix(filter_prefix, name):
+                continue
+            if file_name not in readers:
+                if not os.path.isfile(file_name):
+                    raise ValueError(f"The checkpoint file {file_name} holding the parameter {name} is missing.")
+                readers[file_name] = CheckpointReader_(file_name)
+            parameter_dict[name] = Parameter(Tensor(readers[file_name].get_tensor(name)), name=name)
+        logger.info("Loading checkpoint files process is finished.")
+    except BaseException as e:
+        logger.critical("Failed to load the checkpoint file '%s'.", ckpt_file_name)
+        raise ValueError(e.__str__() + "\nFailed to load the checkpoint file {}.".format(ckpt_file_name))
+    return parameter_dict
+
+
+def convert_checkpoint(src_ckpt_file, dst_ckpt_file, dst_format="native"):
+    """
+    Convert the checkpoint file between the protobuf, the native and the delta formats.
+
+    Converting a delta checkpoint to the native format compacts it, the result doesn't depend on the earlier
+    checkpoint files any more.
+
+    Args:
+        src_ckpt_file (str): The source checkpoint file name, its format is detected from the file.
+        dst_ckpt_file (str): The destination checkpoint file name. If the file name already exists, it will be
+                             overwritten.
+        dst_format (str): The format of destination checkpoint file, supports 'protobuf', 'native' and 'delta'.
+                          The destination delta checkpoint saves all the tensors. Default: 'native'.
+
+    Raises:
+        ValueError: If the source checkpoint file is incorrect or `dst_format` is not supported.
+
+    Examples:
+        >>> from luojianet_ms import convert_checkpoint
+        >>>
+        >>> convert_checkpoint("./checkpoint/LeNet5-1_32.ckpt", "./checkpoint/LeNet5-1_32_native.ckpt")
+    """
+    dst_format = Validator.check_string(dst_format, ["protobuf", "native", "delta"], "dst_format",
+                                        "convert_checkpoint")
+    parameter_dict = load_checkpoint(src_ckpt_file)
+    save_obj = [{"name": name, "data": param} for name, param in parameter_dict.items()]
+    save_checkpoint(save_obj, dst_ckpt_file, ckpt_format=dst_format)
+
+
 def _check_checkpoint_param(ckpt_file_name, filter_prefix=None):
     """Check function load_checkpoint's parameter."""
     if not isinstance(ckpt_file_name, str):
@@ -21,6 +21,8 @@ import threading
 import time
 from collections import defaultdict
 
+import numpy as np
+
 from luojianet_ms import log as logger
 from luojianet_ms.nn import Module
 
@@ -40,6 +42,11 @@ _summary_tensor_cache = {}
 _DEFAULT_EXPORT_OPTIONS = {
     'tensor_format': {'npy', None},
 }
+_DEFAULT_COMPRESS_OPTIONS = {
+    'image_max_size': (int, type(None)),
+    'tensor_max_size': (int, type(None)),
+    'quantize': (bool,),
+}
 
 
 def _cache_summary_tensor_data(summary):
@@ -92,6 +99,54 @@ def process_export_options(export_options):
     return export_options
 
 
+def process_compress_options(compress_options):
+    """Check the keys and values of the compress options."""
+    if compress_options is None:
+        return None
+
+    check_value_type('compress_options', compress_options, [dict, type(None)])
+
+    unexpected_params = set(compress_options) - set(_DEFAULT_COMPRESS_OPTIONS)
+    if unexpected_params:
+        raise ValueError(f'For `compress_options` the keys {unexpected_params} are unsupported, '
+                         f'expect the follow keys: {list(_DEFAULT_COMPRESS_OPTIONS.keys())}')
+
+    for key, value in compress_options.items():
+        check_value_type(key, value, list(_DEFAULT_COMPRESS_OPTIONS.get(key)))
+        if key.endswith('_max_size') and value is not None:
+            Validator.check_positive_int(value, key)
+
+    return compress_options
+
+
+def _compress_summary_value(plugin, np_value, compress_options):
+    """
+    Downsample and quantize the image or tensor summary value, before it is sent to the writer process.
+
+    The last two dimensions, which are the height and width of an image, are sampled by an integer stride so that
+    they are not larger than the max size. Images are quantized to uint8 like the image summary does, and float
+    tensors are cast to float16 unless a finite value is out of the float16 range, which would turn into inf.
+    """
+    if compress_options is None or plugin not in (PluginEnum.IMAGE.value, PluginEnum.TENSOR.value):
+        return np_value
+
+    max_size = compress_options.get(f'{plugin}_max_size')
+    if max_size is not None and np_value.ndim >= 2:
+        stride = max(-(-np_value.shape[-2] // max_size), -(-np_value.shape[-1] // max_size))
+        if stride > 1:
+            np_value = np.ascontiguousarray(np_value[..., ::stride, ::stride])
+
+    if compress_options.get('quantize'):
+        if plugin == PluginEnum.IMAGE.value and np_value.dtype != np.uint8:
+            scale_factor = 255 if np.max(np_value) <= 1 and np.min(np_value) >= 0 else 1
+            np_value = (np_value.astype(np.float32) * scale_factor).astype(np.uint8)
+        elif plugin == PluginEnum.TENSOR.value and np_value.dtype in (np.float32, np.float64):
+            finite_value = np_value[np.isfinite(np_value)]
+            if finite_value.size == 0 or np.max(np.abs(finite_value)) <= np.finfo(np.float16).max:
+                np_value = np_value.astype(np.float16)
+    return np_value
+
+
 class SummaryRecord:
     """
     SummaryRecord is used to record the summary data and lineage data.
@@ -128,6 +183,17 @@ class SummaryRecord:
 
               - npy: export tensor as npy file.
 
+        compress_options (Union[None, dict]): Downsample and quantize the image and tensor summaries before they are
+            written, which reduces the cost of recording large images and feature maps. Default: None, it means
+            that the data is recorded at full resolution.
+
+            - image_max_size (Union[int, None]): The maximum height and width of the image summaries, larger images
+              are downsampled by an integer stride. Default: None.
+            - tensor_max_size (Union[int, None]): The maximum size of the last two dimensions of the tensor
+              summaries, larger tensors are downsampled by an integer stride. Default: None.
+            - quantize (bool): Whether to quantize the image summaries to uint8 and the float tensor summaries to
+              float16. Default: False.
+
     Raises:
         TypeError: If the parameter type is incorrect.
 
@@ -146,7 +212,8 @@ class SummaryRecord:
     """
 
     def __init__(self, log_dir, file_prefix="events", file_suffix="_MS",
-                 network=None, max_file_size=None, raise_exception=False, export_options=None):
+                 network=None, max_file_size=None, raise_exception=False, export_options=None,
+                 compress_options=None):
 
         if security.enable_security():
             raise ValueError('The Summary is not supported, please without `-s on` and recompile source.')
@@ -186,6 +253,7 @@ class SummaryRecord:
         self.file_info['file_path'] = os.path.join(log_path, self.file_info.get('file_name'))
 
         self._export_options = process_export_options(export_options)
+        self._compress_options = process_compress_options(compress_options)
         export_dir = ''
         if self._export_options is not None:
             export_dir = "export_{}".format(time_second)
@@ -270,7 +338,7 @@ class SummaryRecord:
                 raise ValueError(f'{repr(name)} is not a valid tag name.')
             if not isinstance(value, Tensor):
                 raise TypeError(f'Expect the value to be Tensor, but got {type(value).__name__}')
-            np_value = _check_to_numpy(plugin, value)
+            np_value = _compress_summary_value(plugin, _check_to_numpy(plugin, value), self._compress_options)
             if name in {item['tag'] for item in self._data_pool[plugin]}:
                 entry = repr(f'{name}/{plugin}')
                 logger.warning(f'{entry} has duplicate values. Only the newest one will be recorded.')
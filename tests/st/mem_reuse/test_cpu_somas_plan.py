@@ -0,0 +1,120 @@
+# Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+# Copyright 2021, 2022 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+import os
+import re
+import subprocess
+import sys
+
+import numpy as np
+import pytest
+
+import luojianet_ms.context as context
+import luojianet_ms.nn as nn
+from luojianet_ms import Tensor
+from luojianet_ms.nn import TrainOneStepCell, WithLossCell
+from luojianet_ms.nn.optim import Momentum
+from luojianet_ms.ops import operations as P
+
+context.set_context(mode=context.GRAPH_MODE, device_target="CPU")
+
+
+class ConvNet(nn.Module):
+    def __init__(self):
+        super(ConvNet, self).__init__()
+        conv_weight = Tensor(np.linspace(-0.1, 0.1, 8 * 3 * 3 * 3).reshape(8, 3, 3, 3).astype(np.float32))
+        fc_weight = Tensor(np.linspace(-0.05, 0.05, 10 * 8 * 8 * 8).reshape(10, 8 * 8 * 8).astype(np.float32))
+        self.conv1 = nn.Conv2d(3, 8, 3, pad_mode="same", weight_init=conv_weight)
+        self.conv2 = nn.Conv2d(8, 8, 3, pad_mode="same", weight_init=Tensor(np.full((8, 8, 3, 3), 0.01, np.float32)))
+        self.relu = nn.ReLU()
+        self.add = P.Add()
+        self.flatten = nn.Flatten()
+        self.fc = nn.Dense(8 * 8 * 8, 10, weight_init=fc_weight)
+
+    def call(self, x):
+        x = self.relu(self.conv1(x))
+        x = self.add(self.relu(self.conv2(x)), x)
+        return self.fc(self.flatten(x))
+
+
+def train(steps):
+    net = ConvNet()
+    optimizer = Momentum(net.trainable_params(), learning_rate=0.1, momentum=0.9)
+    criterion = nn.SoftmaxCrossEntropyWithLogits(sparse=True, reduction='mean')
+    train_network = TrainOneStepCell(WithLossCell(net, criterion), optimizer)
+    train_network.set_train()
+    data = Tensor(np.sin(np.arange(4 * 3 * 8 * 8)).reshape(4, 3, 8, 8).astype(np.float32))
+    label = Tensor(np.array([1, 3, 5, 7]).astype(np.int32))
+    return [train_network(data, label).asnumpy() for _ in range(steps)]
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_cpu_somas_plan():
+    """
+    Feature: somas memory planning of cpu graphs.
+    Description: train the same network with and without the planned memory arena.
+    Expectation: the losses of every step are the same.
+    """
+    expect = train(5)
+    os.environ["MS_DEV_CPU_SOMAS"] = "1"
+    try:
+        losses = train(5)
+    finally:
+        del os.environ["MS_DEV_CPU_SOMAS"]
+    assert np.allclose(losses, expect, rtol=1e-5, atol=1e-6)
+    assert losses[-1] < losses[0]
+
+
+def run_and_read_memory_logs(somas):
+    """Train in a subprocess, return the plans and the first step peak of the largest actor set from the logs."""
+    env = dict(os.environ, GLOG_v="1", MS_DEV_CPU_SOMAS=somas)
+    result = subprocess.run([sys.executable, os.path.abspath(__file__)], env=env, stdout=subprocess.PIPE,
+                            stderr=subprocess.STDOUT, universal_newlines=True, check=True)
+    plans = re.findall(r"Graph (\d+) plans (\d+) bytes for kernel outputs and workspaces, the lifetime lower bound "
+                       r"is (\d+) bytes and the allocation without reuse takes (\d+) bytes", result.stdout)
+    peaks = re.findall(r"Actor set \S+ takes a measured memory peak of (\d+) bytes on CPU\S* above the \d+ bytes",
+                       result.stdout)
+    assert peaks
+    return plans, max(int(peak) for peak in peaks)
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_cpu_somas_plan_memory():
+    """
+    Feature: somas memory planning of cpu graphs.
+    Description: train the network with and without the planned memory arena in subprocesses, and read the memory
+        logs, the first step peak of every actor set is measured above the memory in use before the step.
+    Expectation: the arena reuses memory, it is between the lifetime lower bound and the size without reuse, it is
+        not larger than the first step peak of the dynamic allocation, and the planned step allocates less than the
+        dynamic one.
+    """
+    plans, planned_step_peak = run_and_read_memory_logs("1")
+    _, dynamic_step_peak = run_and_read_memory_logs("")
+    assert plans
+    _, planned, lower_bound, upper_bound = max(plans, key=lambda plan: int(plan[1]))
+    print("cpu somas arena: {} bytes, lower bound: {} bytes, without reuse: {} bytes, first step peak with the "
+          "arena: {} bytes, first step peak of the dynamic allocation: {} bytes".format(
+              planned, lower_bound, upper_bound, planned_step_peak, dynamic_step_peak))
+    assert int(lower_bound) <= int(planned) < int(upper_bound)
+    assert int(planned) <= dynamic_step_peak
+    assert planned_step_peak < dynamic_step_peak
+
+
+if __name__ == "__main__":
+    train(1)
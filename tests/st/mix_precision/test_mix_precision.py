@@ -180,3 +180,40 @@ def test_sit_auto_mix_precision_model_o2():
     model_pynative.train(1, dataset2, dataset_sink_mode=False)
     out_pynative = model_pynative.predict(Tensor(input_data))
     allclose_nparray(out_graph.asnumpy(), out_pynative.asnumpy(), 0.001, 0.001)
+
+
+def cpu_has_bf16():
+    """Whether the processor has the bfloat16 instructions oneDNN uses for the O1 kernels."""
+    if not os.path.exists("/proc/cpuinfo"):
+        return False
+    with open("/proc/cpuinfo", 'r') as f:
+        flags = f.read()
+    return re.search(r"\b(avx512_bf16|amx_bf16)\b", flags) is not None
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+@pytest.mark.skipif(not cpu_has_bf16(), reason="The processor has no bfloat16 instructions.")
+def test_sit_auto_mix_precision_train_o1_cpu():
+    """
+    Feature: auto mixed precision level O1 on cpu.
+    Description: train the same network with level O0 and O1, conv and matmul compute in bfloat16 with O1.
+    Expectation: only the O1 network is marked to compute in bfloat16, the parameters stay float32, and the losses
+        are rounded differently but match within bfloat16 precision.
+    """
+    context.set_context(mode=context.GRAPH_MODE, device_target="CPU")
+    input_data = np.sin(np.arange(8 * 3 * 16 * 16)).reshape(8, 3, 16, 16).astype(np.float32)
+    label_data = np.eye(10)[np.arange(8)].astype(np.float32)
+    losses = {}
+    for level in ("O0", "O1"):
+        net = Net(3, 10)
+        opt = nn.Momentum(params=net.trainable_params(), learning_rate=0.001, momentum=0.9)
+        loss = nn.SoftmaxCrossEntropyWithLogits(sparse=False, reduction='mean')
+        train_network = amp.build_train_network(net, opt, loss, level=level)
+        assert net.conv.conv2d.attrs.get("cpu_bf16", False) == (level == "O1")
+        losses[level] = [train_network(Tensor(input_data), Tensor(label_data)).asnumpy() for _ in range(3)]
+        assert all(param.dtype == dtype.float32 for param in net.trainable_params())
+    # bitwise equal losses would mean the float32 primitives ran
+    assert not np.array_equal(losses["O0"], losses["O1"])
+    assert np.allclose(losses["O0"], losses["O1"], 0.01, 0.01)
@@ -0,0 +1,188 @@
+# Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+# Copyright 2021, 2022 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+import os
+import re
+import subprocess
+import sys
+import time
+
+import numpy as np
+import pytest
+
+import luojianet_ms.context as context
+import luojianet_ms.nn as nn
+from luojianet_ms import Tensor
+from luojianet_ms.nn import TrainOneStepCell, WithLossCell
+from luojianet_ms.nn.optim import Momentum
+from luojianet_ms.ops import operations as P
+
+context.set_context(mode=context.GRAPH_MODE, device_target="CPU")
+
+
+class Branch(nn.Module):
+    def __init__(self, scale):
+        super(Branch, self).__init__()
+        self.conv1 = nn.Conv2d(3, 16, 3, pad_mode="same",
+                               weight_init=Tensor(np.full((16, 3, 3, 3), 0.02 * scale, np.float32)))
+        self.conv2 = nn.Conv2d(16, 16, 3, pad_mode="same",
+                               weight_init=Tensor(np.full((16, 16, 3, 3), 0.01 * scale, np.float32)))
+        self.relu = nn.ReLU()
+
+    def call(self, x):
+        return self.relu(self.conv2(self.relu(self.conv1(x))))
+
+
+class SiameseNet(nn.Module):
+    def __init__(self):
+        super(SiameseNet, self).__init__()
+        self.left = Branch(1.0)
+        self.right = Branch(-0.5)
+        self.concat = P.Concat(axis=1)
+        self.flatten = nn.Flatten()
+        fc_weight = Tensor(np.linspace(-0.01, 0.01, 10 * 32 * 32 * 32).reshape(10, 32 * 32 * 32).astype(np.float32))
+        self.fc = nn.Dense(32 * 32 * 32, 10, weight_init=fc_weight)
+
+    def call(self, x, y):
+        return self.fc(self.flatten(self.concat((self.left(x), self.right(y)))))
+
+
+class SiameseWithLoss(nn.Module):
+    def __init__(self, net, criterion):
+        super(SiameseWithLoss, self).__init__()
+        self.net = net
+        self.criterion = criterion
+
+    def call(self, x, y, label):
+        return self.criterion(self.net(x, y), label)
+
+
+def train(steps):
+    net = SiameseNet()
+    optimizer = Momentum(net.trainable_params(), learning_rate=0.01, momentum=0.9)
+    criterion = nn.SoftmaxCrossEntropyWithLogits(sparse=True, reduction='mean')
+    train_network = TrainOneStepCell(SiameseWithLoss(net, criterion), optimizer)
+    train_network.set_train()
+    x = Tensor(np.sin(np.arange(4 * 3 * 32 * 32)).reshape(4, 3, 32, 32).astype(np.float32))
+    y = Tensor(np.cos(np.arange(4 * 3 * 32 * 32)).reshape(4, 3, 32, 32).astype(np.float32))
+    label = Tensor(np.array([1, 3, 5, 7]).astype(np.int32))
+    return [train_network(x, y, label).asnumpy() for _ in range(steps)]
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_cpu_parallel_branch_partition():
+    """
+    Feature: kernel threads partition of the cpu kernels in parallel branches.
+    Description: train a two branch network with and without partitioning the kernel threads between branches.
+    Expectation: the losses of every step are the same.
+    """
+    expect = train(5)
+    os.environ["MS_DEV_CPU_KERNEL_PARTITION"] = "1"
+    try:
+        losses = train(5)
+    finally:
+        del os.environ["MS_DEV_CPU_KERNEL_PARTITION"]
+    assert np.allclose(losses, expect, rtol=1e-5, atol=1e-6)
+    assert losses[-1] < losses[0]
+
+
+def run_in_subprocess(partition, *args, glog_v="1"):
+    env = dict(os.environ, GLOG_v=glog_v, MS_DEV_CPU_KERNEL_PARTITION=partition)
+    result = subprocess.run([sys.executable, os.path.abspath(__file__), *args], env=env, stdout=subprocess.PIPE,
+                            stderr=subprocess.STDOUT, universal_newlines=True, check=True)
+    return result.stdout
+
+
+def run_and_read_partition(partition):
+    """Train in a subprocess and collect the kernel threads ranges assigned together from the logs."""
+    stdout = run_in_subprocess(partition)
+    groups = []
+    for name, cost, begin, end in re.findall(r"The kernel actor: (\S+) of depth: \d+ with cost: (\d+) uses the "
+                                             r"kernel threads \[(\d+), (\d+)\)", stdout):
+        # the kernels of one depth take the ranges one after another from the first kernel thread
+        if int(begin) == 0:
+            groups.append([])
+        groups[-1].append((int(begin), int(end), int(cost), name))
+    return groups
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_cpu_parallel_branch_thread_ranges():
+    """
+    Feature: kernel threads partition of the cpu kernels in parallel branches.
+    Description: train a two branch network in a subprocess, and read the kernel threads ranges from the logs.
+    Expectation: the convolutions of both branches split the kernel threads into disjoint ranges, the most costly
+        one takes the most threads, and nothing is partitioned by default.
+    """
+    assert not run_and_read_partition("")
+    groups = run_and_read_partition("1")
+    assert any("Conv2D" in name for ranges in groups for _, _, _, name in ranges)
+    for ranges in groups:
+        assert len(ranges) >= 2
+        # the ranges are assigned by the cost in descending order, and are disjoint
+        for prev, cur in zip(ranges, ranges[1:]):
+            assert prev[1] == cur[0]
+            assert prev[2] >= cur[2]
+        thread_nums = [end - begin for begin, end, _, _ in ranges]
+        assert thread_nums[0] == max(thread_nums)
+
+
+def measure_step_time(steps):
+    """Train and return the median latency of the steps after the first one, which includes compiling."""
+    net = SiameseNet()
+    optimizer = Momentum(net.trainable_params(), learning_rate=0.01, momentum=0.9)
+    criterion = nn.SoftmaxCrossEntropyWithLogits(sparse=True, reduction='mean')
+    train_network = TrainOneStepCell(SiameseWithLoss(net, criterion), optimizer)
+    train_network.set_train()
+    x = Tensor(np.sin(np.arange(32 * 3 * 32 * 32)).reshape(32, 3, 32, 32).astype(np.float32))
+    y = Tensor(np.cos(np.arange(32 * 3 * 32 * 32)).reshape(32, 3, 32, 32).astype(np.float32))
+    label = Tensor(np.arange(32).astype(np.int32) % 10)
+    train_network(x, y, label).asnumpy()
+    latencies = []
+    for _ in range(steps):
+        start = time.perf_counter()
+        train_network(x, y, label).asnumpy()
+        latencies.append(time.perf_counter() - start)
+    return float(np.median(latencies))
+
+
+@pytest.mark.level1
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_cpu_parallel_branch_step_latency():
+    """
+    Feature: kernel threads partition of the cpu kernels in parallel branches.
+    Description: measure the median step latency of the two branch network with the partition off and on, each in
+        its own process.
+    Expectation: both latencies are measured and printed, the partition doesn't make the step much slower.
+    """
+    latency = {}
+    for partition in ("0", "1"):
+        stdout = run_in_subprocess(partition, "latency", glog_v="2")
+        latency[partition] = float(re.findall(r"step latency: ([\d.]+) ms", stdout)[-1])
+    print("cpu parallel branch step latency, partition off: {:.3f} ms, on: {:.3f} ms".format(latency["0"],
+                                                                                           latency["1"]))
+    assert latency["1"] < latency["0"] * 1.5
+
+
+if __name__ == "__main__":
+    if len(sys.argv) > 1 and sys.argv[1] == "latency":
+        print("step latency: {:.3f} ms".format(measure_step_time(20) * 1000))
+    else:
+        train(1)
@@ -0,0 +1,120 @@
+# Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+# Copyright 2021, 2022 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+import numpy as np
+import pytest
+
+import luojianet_ms.context as context
+import luojianet_ms.nn as nn
+from luojianet_ms import Tensor
+from luojianet_ms.ops import operations as P
+from luojianet_ms.ops.operations import _grad_ops as G
+
+context.set_context(mode=context.GRAPH_MODE, device_target="CPU")
+
+
+class GroupNormNet(nn.Module):
+    def __init__(self, num_groups, epsilon):
+        super(GroupNormNet, self).__init__()
+        self.norm = P.GroupNorm(num_groups, epsilon)
+
+    def call(self, x, gamma, beta):
+        return self.norm(x, gamma, beta)
+
+
+class GroupNormGradNet(nn.Module):
+    def __init__(self, num_groups, epsilon):
+        super(GroupNormGradNet, self).__init__()
+        self.norm_grad = G.GroupNormGrad(num_groups, epsilon)
+
+    def call(self, x, dy, var, mean, gamma):
+        return self.norm_grad(x, dy, var, mean, gamma)
+
+
+def GroupNormReference(x, dy, gamma, beta, num_groups, epsilon):
+    n, c = x.shape[0], x.shape[1]
+    param_shape = (1, c) + (1,) * (len(x.shape) - 2)
+    x_g = x.reshape(n, num_groups, -1).astype(np.float64)
+    dy_g = dy.reshape(n, num_groups, -1).astype(np.float64)
+    gamma_g = np.broadcast_to(gamma.reshape(param_shape), x.shape).reshape(n, num_groups, -1)
+    mean = np.mean(x_g, axis=2, keepdims=True)
+    var = np.var(x_g, axis=2, keepdims=True)
+    rstd = 1.0 / np.sqrt(var + epsilon)
+    x_hat = (x_g - mean) * rstd
+    y = x_hat.reshape(x.shape) * gamma.reshape(param_shape) + beta.reshape(param_shape)
+
+    dx_hat = dy_g * gamma_g
+    num = x_g.shape[2]
+    dx = rstd / num * (num * dx_hat - np.sum(dx_hat, axis=2, keepdims=True) -
+                       x_hat * np.sum(dx_hat * x_hat, axis=2, keepdims=True))
+    reduce_axis = tuple(i for i in range(len(x.shape)) if i != 1)
+    dg = np.sum(dy * x_hat.reshape(x.shape), axis=reduce_axis)
+    db = np.sum(dy, axis=reduce_axis)
+    return y, mean.reshape(n, num_groups), var.reshape(n, num_groups), dx.reshape(x.shape), dg, db
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_groupnorm():
+    num_groups = 4
+    epsilon = 1e-5
+    x_np = np.random.randn(8, 32, 16, 16).astype(np.float32)
+    dy_np = np.random.randn(8, 32, 16, 16).astype(np.float32)
+    gamma_np = np.random.randn(32).astype(np.float32)
+    beta_np = np.random.randn(32).astype(np.float32)
+    y_np, mean_np, var_np, dx_np, dg_np, db_np = GroupNormReference(x_np, dy_np, gamma_np, beta_np, num_groups,
+                                                                    epsilon)
+
+    net = GroupNormNet(num_groups, epsilon)
+    y_ms, mean_ms, var_ms = net(Tensor(x_np), Tensor(gamma_np), Tensor(beta_np))
+    assert np.allclose(y_ms.asnumpy(), y_np, atol=1e-4)
+    assert np.allclose(mean_ms.asnumpy(), mean_np, atol=1e-4)
+    assert np.allclose(var_ms.asnumpy(), var_np, atol=1e-4)
+
+    grad_net = GroupNormGradNet(num_groups, epsilon)
+    dx_ms, dg_ms, db_ms = grad_net(Tensor(x_np), Tensor(dy_np), var_ms, mean_ms, Tensor(gamma_np))
+    assert np.allclose(dx_ms.asnumpy(), dx_np, atol=1e-4)
+    assert np.allclose(dg_ms.asnumpy(), dg_np, atol=1e-3)
+    assert np.allclose(db_ms.asnumpy(), db_np, atol=1e-3)
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_groupnorm_fp16():
+    num_groups = 2
+    epsilon = 1e-5
+    x_np = np.random.randn(2, 6, 7, 5).astype(np.float16)
+    gamma_np = np.random.randn(6).astype(np.float16)
+    beta_np = np.random.randn(6).astype(np.float16)
+    y_np, mean_np, var_np, _, _, _ = GroupNormReference(x_np, x_np, gamma_np, beta_np, num_groups, epsilon)
+
+    net = GroupNormNet(num_groups, epsilon)
+    y_ms, mean_ms, var_ms = net(Tensor(x_np), Tensor(gamma_np), Tensor(beta_np))
+    assert np.allclose(y_ms.asnumpy(), y_np, rtol=1e-2, atol=1e-2)
+    assert np.allclose(mean_ms.asnumpy(), mean_np, rtol=1e-2, atol=1e-2)
+    assert np.allclose(var_ms.asnumpy(), var_np, rtol=1e-2, atol=1e-2)
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_nn_groupnorm_uses_fused_kernel():
+    x_np = np.random.randn(2, 8, 6, 6).astype(np.float32)
+    net = nn.GroupNorm(2, 8)
+    y_np, _, _, _, _, _ = GroupNormReference(x_np, x_np, np.ones(8, np.float32), np.zeros(8, np.float32), 2, 1e-5)
+    assert np.allclose(net(Tensor(x_np)).asnumpy(), y_np, atol=1e-4)
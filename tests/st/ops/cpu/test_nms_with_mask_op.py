@@ -108,3 +108,44 @@ def test_nms_with_mask_edge_case_3():
     sel_rows, sel_score = runMSRun(nms_op3, bbox3)
     np.testing.assert_almost_equal(sel_rows, expected_bbox)
     np.testing.assert_almost_equal(sel_score, expected_score)
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_nms_with_mask_max_output_size():
+    context.set_context(mode=context.GRAPH_MODE, device_target="CPU")
+    nms_op = P.NMSWithMask(0.3, max_output_size=2)
+    bbox = [[12, 4, 33, 17, 0.6], [20, 11, 38, 23, 0.1], [20, 10, 45, 26, 0.9], [15, 17, 35, 38, 0.5],
+            [10, 20, 30, 40, 0.4], [35, 35, 89, 90, 0.8]]
+    expected_bbox = np.array([[20., 10., 45., 26.],
+                              [35., 35., 89., 90.]])
+    expected_score = np.array([0.9, 0.8])
+
+    sel_rows, sel_score = runMSRun(nms_op, bbox)
+    np.testing.assert_almost_equal(sel_rows, expected_bbox)
+    np.testing.assert_almost_equal(sel_score, expected_score)
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_nms_with_mask_batched():
+    context.set_context(mode=context.GRAPH_MODE, device_target="CPU")
+    nms_op = P.NMSWithMask(0.5)
+    count = 500
+    classes = []
+    for _ in range(3):
+        box = np.random.randint(1, 100, size=(count, 4))
+        box[:, 2] = box[:, 0] + box[:, 2]
+        box[:, 3] = box[:, 1] + box[:, 3]
+        classes.append(np.hstack((box, np.random.rand(count, 1))).astype(np.float32))
+    batched_box, batched_idx, batched_mask = nms_op(Tensor(np.stack(classes)))
+    assert batched_box.shape == (3, count, 5)
+    assert batched_idx.shape == (3, count)
+    # every class is suppressed on its own, the same as running them one by one
+    for i, bbox in enumerate(classes):
+        box, idx, mask = nms_op(Tensor(bbox))
+        np.testing.assert_array_almost_equal(batched_box.asnumpy()[i], box.asnumpy())
+        np.testing.assert_array_equal(batched_idx.asnumpy()[i], idx.asnumpy())
+        np.testing.assert_array_equal(batched_mask.asnumpy()[i], mask.asnumpy())
@@ -23,6 +23,35 @@ from luojianet_ms.ops.operations import _grad_ops as G
 context.set_context(mode=context.GRAPH_MODE, device_target="CPU")
 
 
+def interpolation_weights(out_size, in_size, align_corners):
+    """Source rows or columns of every output position, as computed by ComputeInterpolationWeights."""
+    if align_corners and out_size > 1:
+        scale = np.float32((in_size - 1) / (out_size - 1))
+    else:
+        scale = np.float32(in_size / out_size)
+    pos = np.arange(out_size, dtype=np.float32) * scale
+    lower = np.floor(pos).astype(np.int64)
+    upper = np.minimum(np.ceil(pos).astype(np.int64), in_size - 1)
+    lerp = pos - np.floor(pos)
+    return lower, upper, lerp
+
+
+def resize_bilinear_grad_np(dy, x_shape, align_corners):
+    """Reference of the scalar ResizeBilinearGrad CPU kernel, which scatters every dy element into dx."""
+    dy = dy.astype(np.float64)
+    y_lower, y_upper, y_lerp = interpolation_weights(dy.shape[2], x_shape[2], align_corners)
+    x_lower, x_upper, x_lerp = interpolation_weights(dy.shape[3], x_shape[3], align_corners)
+    dx = np.zeros(x_shape, np.float64)
+    for h in range(dy.shape[2]):
+        for w in range(dy.shape[3]):
+            value = dy[:, :, h, w]
+            dx[:, :, y_lower[h], x_lower[w]] += value * (1 - y_lerp[h]) * (1 - x_lerp[w])
+            dx[:, :, y_lower[h], x_upper[w]] += value * (1 - y_lerp[h]) * x_lerp[w]
+            dx[:, :, y_upper[h], x_lower[w]] += value * y_lerp[h] * (1 - x_lerp[w])
+            dx[:, :, y_upper[h], x_upper[w]] += value * y_lerp[h] * x_lerp[w]
+    return dx
+
+
 class ResizeBilinearGradAlignCornerT(nn.Module):
     def __init__(self):
         super(ResizeBilinearGradAlignCornerT, self).__init__()
@@ -82,3 +111,24 @@ def test_ResizeBilinearGradAlignCornerF():
     rnn = ResizeBilinearGradAlignCornerF()
     output = rnn(Tensor(dy), Tensor(orign_image))
     assert np.all(output.asnumpy() == expect)
+
+
+def test_ResizeBilinearGradWidePlanes():
+    """
+    Feature: ResizeBilinearGrad CPU kernel.
+    Description: dy of several planes wider than the SIMD width, from up and down sampling with and without
+        align_corners, in float32 and float16.
+    Expectation: dx matches the reference of the scalar kernel.
+    """
+    np.random.seed(1)
+    x = np.zeros((2, 3, 5, 37), np.float32)
+    for dy_shape in [(2, 3, 11, 83), (2, 3, 3, 13), (2, 3, 5, 70)]:
+        dy = np.random.rand(*dy_shape).astype(np.float32)
+        for align_corners in [False, True]:
+            expect = resize_bilinear_grad_np(dy, x.shape, align_corners)
+            net = ResizeBilinearGradAlignCornerT() if align_corners else ResizeBilinearGradAlignCornerF()
+            output = net(Tensor(dy), Tensor(x)).asnumpy()
+            assert np.allclose(output, expect, rtol=1e-5, atol=1e-5)
+            output = net(Tensor(dy.astype(np.float16)), Tensor(x.astype(np.float16))).asnumpy()
+            assert output.dtype == np.float16
+            assert np.allclose(output, expect, rtol=2e-3, atol=2e-2)
@@ -22,6 +22,28 @@ from luojianet_ms import nn
 context.set_context(mode=context.GRAPH_MODE, device_target="CPU")
 
 
+def interpolation_weights(out_size, in_size, align_corners):
+    """Source rows or columns of every output position, as computed by ComputeInterpolationWeights."""
+    if align_corners and out_size > 1:
+        scale = np.float32((in_size - 1) / (out_size - 1))
+    else:
+        scale = np.float32(in_size / out_size)
+    pos = np.arange(out_size, dtype=np.float32) * scale
+    lower = np.floor(pos).astype(np.int64)
+    upper = np.minimum(np.ceil(pos).astype(np.int64), in_size - 1)
+    lerp = pos - np.floor(pos)
+    return lower, upper, lerp
+
+
+def resize_bilinear_np(x, size, align_corners):
+    """Reference of the scalar NCHW ResizeBilinear CPU kernel."""
+    x = x.astype(np.float64)
+    y_lower, y_upper, y_lerp = interpolation_weights(size[0], x.shape[2], align_corners)
+    x_lower, x_upper, x_lerp = interpolation_weights(size[1], x.shape[3], align_corners)
+    rows = x[:, :, y_lower, :] * (1 - y_lerp)[:, None] + x[:, :, y_upper, :] * y_lerp[:, None]
+    return rows[:, :, :, x_lower] * (1 - x_lerp) + rows[:, :, :, x_upper] * x_lerp
+
+
 class NetResizeBilinear(nn.Module):
     def __init__(self, size=None, align_corner=False):
         super(NetResizeBilinear, self).__init__()
@@ -546,3 +568,24 @@ def test_resize_nn_grayscale_align_corners_float(datatype=np.float32):
     diff = output.asnumpy() - expected_output.asnumpy()
     assert np.all(abs(diff) < error)
     assert np.all(abs(diff_align) < error)
+
+
+def test_resize_bilinear_wide_planes():
+    """
+    Feature: ResizeBilinear CPU kernel.
+    Description: several planes wider than the SIMD width, resized up and down with and without align_corners,
+        in float32 and float16.
+    Expectation: the output matches the reference of the scalar kernel.
+    """
+    np.random.seed(1)
+    x = np.random.rand(2, 3, 5, 37).astype(np.float32)
+    for size in [(11, 83), (3, 13), (5, 70), (9, 37)]:
+        for align_corners in [False, True]:
+            expect = resize_bilinear_np(x, size, align_corners)
+            net = NetResizeBilinear(size, align_corners)
+            output = net(Tensor(x)).asnumpy()
+            assert output.dtype == np.float32
+            assert np.allclose(output, expect, rtol=1e-5, atol=1e-6)
+            output = net(Tensor(x.astype(np.float16))).asnumpy()
+            assert output.dtype == np.float16
+            assert np.allclose(output, expect, rtol=1e-3, atol=2e-3)
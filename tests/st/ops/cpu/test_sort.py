@@ -159,3 +159,21 @@ def test_sort3d_float32():
 @pytest.mark.env_onecard
 def test_sort3d_descending_float32():
     sort_3d(True, np.float32)
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_sort_huge_axis_float32():
+    """
+    Feature: sort the huge axis with all the kernel threads.
+    Description: sort the long axis with many equal values in ascending and descending order.
+    Expectation: the equal values keep the order of their indices as the stable sort.
+    """
+    context.set_context(mode=context.GRAPH_MODE, device_target="CPU")
+    np.random.seed(0)
+    x_numpy = np.random.randint(0, 100, (100000, 2)).astype(np.float32)
+    for descending in (False, True):
+        output, indices = SortNet(0, descending)(Tensor(x_numpy))
+        expected_indices = np.argsort(-x_numpy if descending else x_numpy, axis=0, kind='stable')
+        np.testing.assert_array_equal(indices.asnumpy(), expected_indices)
+        np.testing.assert_array_equal(output.asnumpy(), np.take_along_axis(x_numpy, expected_indices, axis=0))
@@ -81,3 +81,22 @@ def test_topk():
     k = 40960
     ms_output = P.TopK(False)(Tensor(x_np), k)
     assert np.allclose(ms_output[0].asnumpy(), x_np)
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_topk_huge_axis():
+    """
+    Feature: select the top k of huge axis with all the kernel threads.
+    Description: select the top k of one long row with many equal values.
+    Expectation: the equal values keep the order of their indices as the stable sort.
+    """
+    context.set_context(mode=context.GRAPH_MODE, device_target="CPU")
+    np.random.seed(0)
+    x_np = np.random.randint(0, 1000, (1, 200000)).astype(np.float32)
+    expected_indices = np.argsort(-x_np, axis=-1, kind='stable')
+    for k in (100, 150000):
+        ms_output = P.TopK(True)(Tensor(x_np), k)
+        np.testing.assert_array_equal(ms_output[1].asnumpy(), expected_indices[..., 0:k])
+        np.testing.assert_array_equal(ms_output[0].asnumpy(), np.take_along_axis(x_np, expected_indices[..., 0:k], -1))
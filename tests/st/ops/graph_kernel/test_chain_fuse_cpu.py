@@ -0,0 +1,101 @@
+# Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+# Copyright 2021, 2022 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+import os
+import shutil
+import tempfile
+import numpy as np
+import pytest
+import luojianet_ms.context as context
+import luojianet_ms.nn as nn
+from luojianet_ms import Tensor
+from luojianet_ms.nn import TrainOneStepCell, WithLossCell
+from luojianet_ms.nn.optim import Momentum
+import luojianet_ms.ops.operations as P
+
+
+class Net(nn.Module):
+    def __init__(self):
+        super(Net, self).__init__()
+        self.bn = nn.BatchNorm2d(8)
+        self.relu = nn.ReLU()
+        self.add = P.Add()
+        self.mean = P.ReduceMean(keep_dims=False)
+        self.fc = nn.Dense(8, 10, weight_init=Tensor(np.linspace(-0.1, 0.1, 80).reshape(10, 8).astype(np.float32)))
+
+    def call(self, x):
+        y = self.add(self.relu(self.bn(x)), x)
+        return self.fc(self.mean(y, (2, 3)))
+
+
+def train(enable_graph_kernel, steps, graph_kernel_flags=""):
+    context.set_context(enable_graph_kernel=enable_graph_kernel, graph_kernel_flags=graph_kernel_flags)
+    net = Net()
+    criterion = nn.SoftmaxCrossEntropyWithLogits(sparse=False, reduction='mean')
+    optimizer = Momentum(net.trainable_params(), learning_rate=0.1, momentum=0.9)
+    train_network = TrainOneStepCell(WithLossCell(net, criterion), optimizer)
+    train_network.set_train()
+    data = Tensor(np.cos(np.arange(4 * 8 * 16 * 16)).reshape(4, 8, 16, 16).astype(np.float32))
+    label = Tensor(np.eye(10)[[1, 3, 5, 7]].astype(np.float32))
+    return [train_network(data, label).asnumpy() for _ in range(steps)]
+
+
+def graph_kernel_names(save_graphs_path):
+    """Collect the names of the graph kernels in the ir dumped after the last graph kernel pass."""
+    ir_files = []
+    for root, _, files in os.walk(save_graphs_path):
+        if os.path.basename(root) == "graph_kernel":
+            ir_files += [os.path.join(root, f) for f in files if f.endswith(".ir")]
+    assert ir_files
+    # the graph kernel ir files are prefixed by the global id of the pass
+    last_ir = max(ir_files, key=os.path.basename)
+    with open(last_ir, "r") as f:
+        return [line.split(":", 1)[1].strip() for line in f if line.startswith("graph_kernel :")]
+
+
+def train_and_dump(steps, graph_kernel_flags):
+    save_graphs_path = tempfile.mkdtemp()
+    context.set_context(save_graphs=True, save_graphs_path=save_graphs_path)
+    try:
+        losses = train(True, steps, graph_kernel_flags)
+        return losses, graph_kernel_names(save_graphs_path)
+    finally:
+        context.set_context(save_graphs=False, graph_kernel_flags="")
+        shutil.rmtree(save_graphs_path, ignore_errors=True)
+
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_chain_fuse_cpu():
+    """
+    Feature: fuse the activation and loss chains of a network into graph kernels on cpu.
+    Description: train a BatchNorm-ReLU-Add block with a softmax cross entropy loss without graph kernel, with graph
+        kernel, and with graph kernel plus the cpu chain fusion.
+    Expectation: the losses of every step match, and only the chain fusion puts ReluGrad and the loss into graph
+        kernels.
+    """
+    context.set_context(mode=context.GRAPH_MODE, device_target="CPU")
+    expect = train(False, 5)
+    output, base_kernels = train_and_dump(5, "")
+    fused_output, fused_kernels = train_and_dump(5, "--enable_cpu_chain_fusion=true")
+    assert np.allclose(expect, output, rtol=1.e-4, atol=1.e-4)
+    assert np.allclose(expect, fused_output, rtol=1.e-4, atol=1.e-4)
+
+    chain_ops = ("ReluGrad", "SoftmaxCrossEntropyWithLogits")
+    for op in chain_ops:
+        assert not [name for name in base_kernels if op in name]
+        assert [name for name in fused_kernels if op in name]
@@ -122,3 +122,29 @@ def test_logsoftmax_asend():
 def test_logsoftmaxgrad_asend():
     context.set_context(mode=context.GRAPH_MODE, enable_graph_kernel=True, device_target="Ascend")
     test_logsoftmaxgrad()
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_logsoftmax_cpu():
+    """
+    Feature: expand LogSoftmax into a graph kernel on cpu.
+    Description: run LogSoftmax with graph kernel enabled.
+    Expectation: the result match with numpy result.
+    """
+    context.set_context(mode=context.GRAPH_MODE, enable_graph_kernel=True, device_target="CPU",
+                        graph_kernel_flags="--enable_cpu_chain_fusion=true")
+    test_logsoftmax()
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_logsoftmaxgrad_cpu():
+    """
+    Feature: expand LogSoftmaxGrad into a graph kernel on cpu.
+    Description: run LogSoftmaxGrad with graph kernel enabled.
+    Expectation: the result match with numpy result.
+    """
+    context.set_context(mode=context.GRAPH_MODE, enable_graph_kernel=True, device_target="CPU",
+                        graph_kernel_flags="--enable_cpu_chain_fusion=true")
+    test_logsoftmaxgrad()
@@ -63,3 +63,16 @@ def test_softmax_gpu():
 def test_softmax_ascend():
     context.set_context(mode=context.GRAPH_MODE, device_target="Ascend")
     test_softmax([2, 32, 48, 64], np.float32)
+
+@pytest.mark.level0
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_softmax_cpu():
+    """
+    Feature: expand Softmax into a graph kernel on cpu.
+    Description: run Softmax with and without graph kernel.
+    Expectation: the results are the same.
+    """
+    context.set_context(mode=context.GRAPH_MODE, device_target="CPU",
+                        graph_kernel_flags="--enable_cpu_chain_fusion=true")
+    test_softmax([4, 32, 48], np.float32)
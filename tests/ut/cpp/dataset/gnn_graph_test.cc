@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include <algorithm>
+#include <cstdio>
 #include <string>
 #include <map>
 #include <memory>
@@ -21,6 +22,7 @@
 
 #include "common/common.h"
 #include "gtest/gtest.h"
+#include "minddata/dataset/core/global_context.h"
 #include "minddata/dataset/util/status.h"
 #include "minddata/dataset/engine/gnn/node.h"
 #include "minddata/dataset/engine/gnn/graph_data_impl.h"
@@ -408,3 +410,128 @@ TEST_F(MindDataTestGNNGraph, TestRandomWalkDefaults) {
   EXPECT_TRUE(s.IsOk());
   EXPECT_TRUE(walk_path->shape().ToString() == "<33,60>");
 }
+
+TEST_F(MindDataTestGNNGraph, TestParallelSampling) {
+  uint32_t original_seed = GlobalContext::config_manager()->seed();
+  GlobalContext::config_manager()->set_seed(130);
+  std::string path = "data/mindrecord/testGraphData/sns";
+  GraphDataImpl graph(path, 1);
+  GraphDataImpl parallel_graph(path, 4);
+  EXPECT_TRUE(graph.Init().IsOk());
+  EXPECT_TRUE(parallel_graph.Init().IsOk());
+
+  MetaInfo meta_info;
+  Status s = graph.GetMetaInfo(&meta_info);
+  EXPECT_TRUE(s.IsOk());
+  std::shared_ptr<Tensor> nodes;
+  s = graph.GetAllNodes(meta_info.node_type[0], &nodes);
+  EXPECT_TRUE(s.IsOk());
+  // Enough nodes to be split into several blocks
+  std::vector<NodeIdType> node_list;
+  for (int i = 0; i < 8; ++i) {
+    for (auto itr = nodes->begin<NodeIdType>(); itr != nodes->end<NodeIdType>(); ++itr) {
+      node_list.push_back(*itr);
+    }
+  }
+
+  // The results with the same seed don't depend on the number of workers
+  std::shared_ptr<Tensor> neighbors;
+  std::shared_ptr<Tensor> parallel_neighbors;
+  s = graph.GetSampledNeighbors(node_list, {3, 2}, {meta_info.node_type[0], meta_info.node_type[0]},
+                                SamplingStrategy::kRandom, &neighbors);
+  EXPECT_TRUE(s.IsOk());
+  s = parallel_graph.GetSampledNeighbors(node_list, {3, 2}, {meta_info.node_type[0], meta_info.node_type[0]},
+                                         SamplingStrategy::kRandom, &parallel_neighbors);
+  EXPECT_TRUE(s.IsOk());
+  EXPECT_EQ(neighbors->shape().ToString(), "<264,10>");
+  EXPECT_EQ(neighbors->ToString(), parallel_neighbors->ToString());
+
+  std::shared_ptr<Tensor> neg_neighbors;
+  std::shared_ptr<Tensor> parallel_neg_neighbors;
+  s = graph.GetNegSampledNeighbors(node_list, 3, meta_info.node_type[0], &neg_neighbors);
+  EXPECT_TRUE(s.IsOk());
+  s = parallel_graph.GetNegSampledNeighbors(node_list, 3, meta_info.node_type[0], &parallel_neg_neighbors);
+  EXPECT_TRUE(s.IsOk());
+  EXPECT_EQ(neg_neighbors->shape().ToString(), "<264,4>");
+  EXPECT_EQ(neg_neighbors->ToString(), parallel_neg_neighbors->ToString());
+
+  std::vector<NodeType> meta_path(10, 1);
+  std::shared_ptr<Tensor> walk_path;
+  std::shared_ptr<Tensor> parallel_walk_path;
+  s = graph.RandomWalk(node_list, meta_path, 2.0, 0.5, -1, &walk_path);
+  EXPECT_TRUE(s.IsOk());
+  s = parallel_graph.RandomWalk(node_list, meta_path, 2.0, 0.5, -1, &parallel_walk_path);
+  EXPECT_TRUE(s.IsOk());
+  EXPECT_EQ(walk_path->shape().ToString(), "<264,11>");
+  EXPECT_EQ(walk_path->ToString(), parallel_walk_path->ToString());
+  GlobalContext::config_manager()->set_seed(original_seed);
+}
+
+TEST_F(MindDataTestGNNGraph, TestGraphStore) {
+  std::string path = "data/mindrecord/testGraphData/testdata";
+  GraphDataImpl graph(path, 1);
+  Status s = graph.Init();
+  EXPECT_TRUE(s.IsOk());
+  std::string store_file = "gnn_graph_store_test";
+  s = graph.SaveGraphStore(store_file);
+  EXPECT_TRUE(s.IsOk());
+
+  GraphDataImpl graph_store(store_file, 1);
+  s = graph_store.Init();
+  EXPECT_TRUE(s.IsOk());
+
+  MetaInfo meta_info;
+  MetaInfo store_meta_info;
+  EXPECT_TRUE(graph.GetMetaInfo(&meta_info).IsOk());
+  EXPECT_TRUE(graph_store.GetMetaInfo(&store_meta_info).IsOk());
+  EXPECT_EQ(meta_info.node_type, store_meta_info.node_type);
+  EXPECT_EQ(meta_info.edge_type, store_meta_info.edge_type);
+  EXPECT_EQ(meta_info.node_num, store_meta_info.node_num);
+  EXPECT_EQ(meta_info.edge_num, store_meta_info.edge_num);
+  EXPECT_EQ(meta_info.node_feature_type, store_meta_info.node_feature_type);
+  EXPECT_EQ(meta_info.edge_feature_type, store_meta_info.edge_feature_type);
+
+  std::shared_ptr<Tensor> nodes;
+  std::shared_ptr<Tensor> store_nodes;
+  EXPECT_TRUE(graph.GetAllNodes(meta_info.node_type[0], &nodes).IsOk());
+  EXPECT_TRUE(graph_store.GetAllNodes(meta_info.node_type[0], &store_nodes).IsOk());
+  EXPECT_EQ(nodes->ToString(), store_nodes->ToString());
+  std::vector<NodeIdType> node_list(nodes->begin<NodeIdType>(), nodes->end<NodeIdType>());
+
+  std::shared_ptr<Tensor> neighbors;
+  std::shared_ptr<Tensor> store_neighbors;
+  EXPECT_TRUE(graph.GetAllNeighbors(node_list, meta_info.node_type[1], OutputFormat::kNormal, &neighbors).IsOk());
+  EXPECT_TRUE(
+    graph_store.GetAllNeighbors(node_list, meta_info.node_type[1], OutputFormat::kNormal, &store_neighbors).IsOk());
+  EXPECT_EQ(neighbors->ToString(), store_neighbors->ToString());
+
+  TensorRow features;
+  TensorRow store_features;
+  EXPECT_TRUE(graph.GetNodeFeature(nodes, meta_info.node_feature_type, &features).IsOk());
+  EXPECT_TRUE(graph_store.GetNodeFeature(nodes, meta_info.node_feature_type, &store_features).IsOk());
+  EXPECT_EQ(features.size(), store_features.size());
+  for (size_t i = 0; i < features.size(); ++i) {
+    EXPECT_EQ(features[i]->ToString(), store_features[i]->ToString());
+  }
+
+  std::shared_ptr<Tensor> edges;
+  EXPECT_TRUE(graph.GetAllEdges(meta_info.edge_type[0], &edges).IsOk());
+  features.clear();
+  store_features.clear();
+  EXPECT_TRUE(graph.GetEdgeFeature(edges, meta_info.edge_feature_type, &features).IsOk());
+  EXPECT_TRUE(graph_store.GetEdgeFeature(edges, meta_info.edge_feature_type, &store_features).IsOk());
+  EXPECT_EQ(features.size(), store_features.size());
+  for (size_t i = 0; i < features.size(); ++i) {
+    EXPECT_EQ(features[i]->ToString(), store_features[i]->ToString());
+  }
+
+  std::vector<std::pair<NodeIdType, NodeIdType>> src_dst_list = {{101, 201}, {103, 207}, {108, 208},
+                                                                 {110, 201}, {204, 105}, {208, 108}};
+  std::shared_ptr<Tensor> store_edges;
+  EXPECT_TRUE(graph_store.GetEdgesFromNodes(src_dst_list, &store_edges).IsOk());
+  EXPECT_EQ(store_edges->ToString(), "Tensor (shape: <6>, Type: int32)\n[1,9,17,19,31,37]");
+
+  s = graph_store.SaveGraphStore(store_file);
+  EXPECT_TRUE(s.ToString().find("is the dataset file being used") != std::string::npos);
+  (void)std::remove(store_file.c_str());
+}
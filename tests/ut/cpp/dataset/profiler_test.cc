@@ -32,8 +32,9 @@ class MindDataTestProfiler : public UT::DatasetOpTesting {
     std::string pipeline_file = "./pipeline_profiling_" + std::to_string(file_id) + ".json";
     std::string cpu_util_file = "./minddata_cpu_utilization_" + std::to_string(file_id) + ".json";
     std::string dataset_iterator_file = "./dataset_iterator_profiling_" + std::to_string(file_id) + ".txt";
+    std::string trace_file = "./dataset_trace_" + std::to_string(file_id) + ".json";
     if (remove(pipeline_file.c_str()) == 0 && remove(cpu_util_file.c_str()) == 0 &&
-        remove(dataset_iterator_file.c_str()) == 0) {
+        remove(dataset_iterator_file.c_str()) == 0 && remove(trace_file.c_str()) == 0) {
       return Status::OK();
     } else {
       RETURN_STATUS_UNEXPECTED("Error deleting profiler files");
@@ -21,6 +21,7 @@
 #include <atomic>
 #include <chrono>
 #include <random>
+#include <thread>
 #include "utils/log_adapter.h"
 
 using namespace luojianet_ms::dataset;
@@ -264,3 +265,35 @@ TEST_F(MindDataTestQueue, TestResize2) {
   queue.Reset();
   ASSERT_EQ(0, queue.size());
 }
+
+// Feature: Test the blocked time accounting of the queue.
+// Description: Block the producer on a full queue, and then the consumer on an empty queue.
+// Expectation: The time is accumulated only when the caller is actually blocked.
+TEST_F(MindDataTestQueue, TestBlockedTime) {
+  const auto delay = std::chrono::milliseconds(50);
+  const uint64_t min_blocked_us = 40000;
+  Queue<int> que(1);
+  TaskGroup vg;
+  EXPECT_OK(vg.CreateAsyncTask("Producer", [&que, delay, min_blocked_us]() -> Status {
+    TaskManager::FindMe()->Post();
+    RETURN_IF_NOT_OK(que.Add(1));
+    CHECK_FAIL_RETURN_UNEXPECTED(que.push_blocked_time() == 0, "Add to a queue with room should not block.");
+    // Blocked until the consumer wakes up and pops
+    RETURN_IF_NOT_OK(que.Add(2));
+    CHECK_FAIL_RETURN_UNEXPECTED(que.push_blocked_time() >= min_blocked_us, "Blocked time of Add is not counted.");
+    std::this_thread::sleep_for(delay);
+    return que.Add(3);
+  }));
+  EXPECT_OK(vg.CreateAsyncTask("Consumer", [&que, delay]() -> Status {
+    TaskManager::FindMe()->Post();
+    std::this_thread::sleep_for(delay);
+    int value = 0;
+    for (int i = 0; i < 3; ++i) {
+      RETURN_IF_NOT_OK(que.PopFront(&value));
+    }
+    return Status::OK();
+  }));
+  EXPECT_OK(vg.join_all(Task::WaitFlag::kBlocking));
+  EXPECT_OK(vg.GetTaskErrorIfAny());
+  EXPECT_GE(que.pop_blocked_time(), min_blocked_us);
+}
@@ -0,0 +1,142 @@
+/**
+ * Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+ * Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <sys/stat.h>
+#include <unistd.h>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "debug/data_dump/e2e_dump_writer.h"
+#include "debug/data_dump/npy_header.h"
+
+namespace luojianet_ms {
+namespace {
+constexpr size_t kRingSize = 4096;
+
+std::string ReadFile(const std::string &path) {
+  std::ifstream ifs(path, std::ios::in | std::ios::binary);
+  if (!ifs.is_open()) {
+    return "";
+  }
+  std::stringstream buffer;
+  buffer << ifs.rdbuf();
+  return buffer.str();
+}
+
+std::vector<uint8_t> MakeTensor(size_t len, size_t seed) {
+  std::vector<uint8_t> data(len);
+  for (size_t i = 0; i < len; ++i) {
+    data[i] = static_cast<uint8_t>((i * 31 + seed * 7) % 251);
+  }
+  return data;
+}
+
+std::string ExpectedFile(const std::vector<uint8_t> &data) {
+  ShapeVector shape = {static_cast<int64_t>(data.size())};
+  return GenerateNpyHeader(shape, kNumberTypeUInt8) + std::string(data.begin(), data.end());
+}
+}  // namespace
+
+class TestE2eDumpWriter : public UT::Common {
+ public:
+  TestE2eDumpWriter() = default;
+  virtual ~TestE2eDumpWriter() = default;
+
+  void SetUp() override {
+    dir_ = "/tmp/e2e_dump_writer_test_" + std::to_string(getpid());
+    (void)mkdir(dir_.c_str(), S_IRWXU);
+  }
+
+  void TearDown() override {
+    for (const auto &file : files_) {
+      (void)unlink(file.c_str());
+      (void)rmdir(file.c_str());
+    }
+    (void)rmdir(dir_.c_str());
+  }
+
+  std::string FilePath(const std::string &name) {
+    files_.push_back(dir_ + "/" + name + ".npy");
+    return dir_ + "/" + name;
+  }
+
+  bool Dump(E2eDumpWriter *writer, const std::string &filename, const std::vector<uint8_t> &data) {
+    ShapeVector shape = {static_cast<int64_t>(data.size())};
+    return writer->DumpToFile(filename, data.data(), data.size(), shape, kNumberTypeUInt8);
+  }
+
+  std::string dir_;
+  std::vector<std::string> files_;
+};
+
+// The files wrap around the small ring many times, while the writers finish them out of order. Every file must be
+// complete once Flush returns, so the room of a file is never reused before it is saved.
+TEST_F(TestE2eDumpWriter, AllFilesSavedAfterFlush) {
+  E2eDumpWriter writer(kRingSize, 2);
+  constexpr size_t kStepNum = 3;
+  constexpr size_t kFileNum = 40;
+  for (size_t step = 0; step < kStepNum; ++step) {
+    std::vector<std::string> filenames;
+    std::vector<std::vector<uint8_t>> tensors;
+    for (size_t i = 0; i < kFileNum; ++i) {
+      // one of the tensors is larger than the ring, and is saved synchronously
+      size_t len = i == kFileNum / 2 ? kRingSize * 2 : (i * 97 + step * 13) % 1500 + 1;
+      filenames.push_back(FilePath("step" + std::to_string(step) + "_" + std::to_string(i)));
+      tensors.push_back(MakeTensor(len, step * kFileNum + i));
+      ASSERT_TRUE(Dump(&writer, filenames.back(), tensors.back()));
+    }
+    ASSERT_TRUE(writer.Flush());
+    for (size_t i = 0; i < kFileNum; ++i) {
+      EXPECT_EQ(ReadFile(filenames[i] + ".npy"), ExpectedFile(tensors[i]));
+    }
+  }
+}
+
+TEST_F(TestE2eDumpWriter, ReportWriteFailure) {
+  E2eDumpWriter writer(kRingSize, 2);
+  // a directory with the name of the file can't be opened for writing by the writer threads
+  auto busy = FilePath("busy");
+  ASSERT_EQ(mkdir((busy + ".npy").c_str(), S_IRWXU), 0);
+  auto good = FilePath("good");
+  EXPECT_TRUE(Dump(&writer, busy, MakeTensor(100, 0)));
+  EXPECT_TRUE(Dump(&writer, good, MakeTensor(100, 1)));
+  EXPECT_FALSE(writer.Flush());
+  EXPECT_EQ(ReadFile(good + ".npy"), ExpectedFile(MakeTensor(100, 1)));
+
+  // the failure is reported once
+  EXPECT_TRUE(Dump(&writer, good, MakeTensor(200, 2)));
+  EXPECT_TRUE(writer.Flush());
+  EXPECT_EQ(ReadFile(good + ".npy"), ExpectedFile(MakeTensor(200, 2)));
+}
+
+TEST_F(TestE2eDumpWriter, RejectBadParameters) {
+  E2eDumpWriter writer(kRingSize, 2);
+  auto data = MakeTensor(100, 0);
+  ShapeVector shape = {100};
+  EXPECT_FALSE(writer.DumpToFile("", data.data(), data.size(), shape, kNumberTypeUInt8));
+  EXPECT_FALSE(writer.DumpToFile(dir_ + "/null", nullptr, data.size(), shape, kNumberTypeUInt8));
+  EXPECT_FALSE(writer.DumpToFile(dir_ + "/empty", data.data(), 0, shape, kNumberTypeUInt8));
+
+  // the directory of the file can't be created under a regular file
+  auto plain = FilePath("plain");
+  ASSERT_TRUE(Dump(&writer, plain, data));
+  ASSERT_TRUE(writer.Flush());
+  EXPECT_FALSE(Dump(&writer, plain + ".npy/sub/file", data));
+  EXPECT_TRUE(writer.Flush());
+}
+}  // namespace luojianet_ms
@@ -0,0 +1,113 @@
+/**
+ * Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+ * Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cmath>
+#include <limits>
+#include <vector>
+#include "common/common_test.h"
+#include "debug/debugger/tensor_summary.h"
+
+namespace luojianet_ms {
+namespace {
+// TensorStatistics splits tensors larger than this into chunks of at least this many elements, one per thread.
+constexpr size_t kElementsPerChunk = 10000;
+constexpr size_t kChunkNum = 4;
+}  // namespace
+
+class TestTensorSummary : public UT::Common {
+ public:
+  TestTensorSummary() {}
+};
+
+/// Feature: statistics of the debugger tensor summary.
+/// Description: a float tensor split into 4 chunks with different finite values in each chunk, a NaN in the first
+/// chunk, +Inf and -Inf in the second, and a third chunk which has no finite element at all.
+/// Expectation: the counts add up over the chunks, min and max skip the non-finite elements and the avg is the mean
+/// of the finite elements, i.e. every chunk is weighted by its finite element count.
+TEST_F(TestTensorSummary, test_TensorStatisticsNanInfAcrossChunks) {
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  const float inf = std::numeric_limits<float>::infinity();
+  std::vector<float> data(kElementsPerChunk * kChunkNum);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<float>(i / kElementsPerChunk + 1);
+  }
+  data[0] = nan;
+  data[kElementsPerChunk + 1] = inf;
+  data[kElementsPerChunk + 2] = inf;
+  data[kElementsPerChunk + 3] = -inf;
+  for (size_t i = 2 * kElementsPerChunk; i < 3 * kElementsPerChunk; ++i) {
+    data[i] = (i % 2 == 0) ? nan : -inf;
+  }
+  data[3 * kElementsPerChunk] = -5.0f;
+  data[3 * kElementsPerChunk + 1] = 0.0f;
+
+  double sum = 0.0;
+  size_t finite_num = 0;
+  for (auto value : data) {
+    if (std::isfinite(value)) {
+      sum += value;
+      ++finite_num;
+    }
+  }
+
+  TensorSummary<float> summary(data.data(), nullptr, data.size(), 0);
+  summary.TensorStatistics(DT_FLOAT32);
+  EXPECT_EQ(summary.count(), static_cast<int>(data.size()));
+  EXPECT_EQ(summary.nan_count(), static_cast<int>(1 + kElementsPerChunk / 2));
+  EXPECT_EQ(summary.pos_inf_count(), 2);
+  EXPECT_EQ(summary.neg_inf_count(), static_cast<int>(1 + kElementsPerChunk / 2));
+  EXPECT_EQ(summary.zero_count(), 1);
+  EXPECT_EQ(summary.neg_zero_count(), 1);
+  EXPECT_EQ(summary.pos_zero_count(), static_cast<int>(finite_num - 2));
+  EXPECT_DOUBLE_EQ(summary.min_value(), -5.0);
+  EXPECT_DOUBLE_EQ(summary.max_value(), 4.0);
+  EXPECT_NEAR(summary.avg_value(), sum / finite_num, 1e-9);
+}
+
+/// Feature: statistics of the debugger tensor summary.
+/// Description: the same values summarized chunk by chunk in a single thread and by the chunked threads, with one
+/// NaN or +Inf in every chunk.
+/// Expectation: both give the same statistics.
+TEST_F(TestTensorSummary, test_TensorStatisticsSingleThreadMatchesChunks) {
+  std::vector<float> data(kElementsPerChunk * kChunkNum);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<float>(i % 97) - 48.5f;
+  }
+  for (size_t chunk = 0; chunk < kChunkNum; ++chunk) {
+    data[chunk * kElementsPerChunk + chunk * 7] = (chunk % 2 == 0) ? std::numeric_limits<float>::quiet_NaN()
+                                                                  : std::numeric_limits<float>::infinity();
+  }
+
+  TensorSummary<float> chunked(data.data(), nullptr, data.size(), 0);
+  chunked.TensorStatistics(DT_FLOAT32);
+  double avg = 0.0;
+  int nan_count = 0;
+  int pos_inf_count = 0;
+  for (size_t offset = 0; offset < data.size(); offset += kElementsPerChunk) {
+    TensorSummary<float> single(data.data() + offset, nullptr, kElementsPerChunk, 0);
+    single.TensorStatistics(DT_FLOAT32);
+    avg += single.avg_value();
+    nan_count += single.nan_count();
+    pos_inf_count += single.pos_inf_count();
+  }
+  EXPECT_EQ(chunked.nan_count(), nan_count);
+  EXPECT_EQ(chunked.pos_inf_count(), pos_inf_count);
+  // every chunk above holds kElementsPerChunk - 1 finite elements, so their mean is the plain avg of the chunks
+  EXPECT_NEAR(chunked.avg_value(), avg / kChunkNum, 1e-9);
+  EXPECT_DOUBLE_EQ(chunked.min_value(), -48.5);
+  EXPECT_DOUBLE_EQ(chunked.max_value(), 47.5);
+}
+}  // namespace luojianet_ms
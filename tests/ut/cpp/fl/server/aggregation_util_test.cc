@@ -0,0 +1,101 @@
+/**
+ * Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+ * Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cmath>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "fl/server/kernel/aggregation_util.h"
+
+namespace luojianet_ms {
+namespace fl {
+namespace server {
+namespace kernel {
+namespace {
+// Several blocks of the thread pool and a tail.
+constexpr size_t kElementNum = 4 * static_cast<size_t>(kAggregationBlockSize) + 13;
+constexpr size_t kClientNum = 16;
+}  // namespace
+
+class TestAggregationUtil : public UT::Common {
+ public:
+  TestAggregationUtil() = default;
+  ~TestAggregationUtil() override = default;
+
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+// Accumulate the float32, float16 and int8 uploads and divide the sum.
+TEST_F(TestAggregationUtil, AccumulateAndDivide) {
+  std::vector<float> weight(kElementNum, 0.0f);
+  std::vector<float> fp32_data(kElementNum);
+  std::vector<float16> fp16_data(kElementNum);
+  std::vector<int8_t> int8_data(kElementNum);
+  for (size_t i = 0; i < kElementNum; i++) {
+    fp32_data[i] = static_cast<float>(i % 7);
+    fp16_data[i] = float16(static_cast<float>(i % 5));
+    int8_data[i] = static_cast<int8_t>(static_cast<int32_t>(i % 11) - 5);
+  }
+  const float scale = 0.5f;
+  const int32_t zero_point = 1;
+  const size_t data_size = 4;
+  AccumulateData(weight.data(), fp32_data.data(), kElementNum);
+  AccumulateFp16Data(weight.data(), fp16_data.data(), kElementNum);
+  AccumulateInt8Data(weight.data(), int8_data.data(), kElementNum, scale, zero_point);
+  DivideData(weight.data(), kElementNum, data_size);
+  for (size_t i = 0; i < kElementNum; i++) {
+    float expect = (fp32_data[i] + static_cast<float>(fp16_data[i]) +
+                    static_cast<float>(static_cast<int32_t>(int8_data[i]) - zero_point) * scale) /
+                   data_size;
+    ASSERT_NEAR(weight[i], expect, 1e-6);
+  }
+}
+
+// Simulate the clients uploading concurrently, each of them accumulates into the weight under the lock like
+// FedAvgKernel does.
+TEST_F(TestAggregationUtil, ConcurrentClients) {
+  std::vector<float> weight(kElementNum, 0.0f);
+  std::vector<std::vector<float>> uploads(kClientNum, std::vector<float>(kElementNum));
+  for (size_t client = 0; client < kClientNum; client++) {
+    for (size_t i = 0; i < kElementNum; i++) {
+      uploads[client][i] = static_cast<float>((i + client) % 3);
+    }
+  }
+  std::mutex weight_mutex;
+  std::vector<std::thread> clients;
+  for (size_t client = 0; client < kClientNum; client++) {
+    clients.emplace_back([&, client]() {
+      std::unique_lock<std::mutex> lock(weight_mutex);
+      AccumulateData(weight.data(), uploads[client].data(), kElementNum);
+    });
+  }
+  for (auto &client : clients) {
+    client.join();
+  }
+  for (size_t i = 0; i < kElementNum; i++) {
+    float expect = 0.0f;
+    for (size_t client = 0; client < kClientNum; client++) {
+      expect += uploads[client][i];
+    }
+    ASSERT_FLOAT_EQ(weight[i], expect);
+  }
+}
+}  // namespace kernel
+}  // namespace server
+}  // namespace fl
+}  // namespace luojianet_ms
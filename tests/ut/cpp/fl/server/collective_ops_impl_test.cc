@@ -0,0 +1,174 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "fl/server/collective_ops_impl.h"
+#include "ps/constants.h"
+#include "ps/core/scheduler_node.h"
+#include "ps/core/worker_node.h"
+#include "utils/ms_utils.h"
+
+namespace luojianet_ms {
+namespace fl {
+namespace server {
+namespace {
+constexpr uint32_t kRankNum = 3;
+// Enough elements for every chunk to be sent in several ring segments.
+constexpr size_t kElementNum = 3 * (kRingSegmentBytes / sizeof(float)) + 7;
+
+// Ask the kernel for a free port on the loopback interface, so that parallel test runs don't collide.
+uint16_t GetFreePort() {
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  if (fd < 0) {
+    return 0;
+  }
+  sockaddr_in addr = {};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = 0;
+  socklen_t len = sizeof(addr);
+  uint16_t port = 0;
+  if (bind(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) == 0 &&
+      getsockname(fd, reinterpret_cast<sockaddr *>(&addr), &len) == 0) {
+    port = ntohs(addr.sin_port);
+  }
+  (void)close(fd);
+  return port;
+}
+
+// The port of the scheduler, chosen before the processes are forked.
+uint16_t scheduler_port = 0;
+
+void SetClusterEnv(const std::string &role) {
+  common::SetEnv(ps::kEnvRole, role.c_str());
+  common::SetEnv(ps::kEnvWorkerNum, std::to_string(kRankNum).c_str());
+  common::SetEnv(ps::kEnvPServerNum, "0");
+  common::SetEnv(ps::kEnvSchedulerHost, "127.0.0.1");
+  common::SetEnv(ps::kEnvSchedulerPort, std::to_string(scheduler_port).c_str());
+  ps::PSContext::instance()->SetPSEnable(true);
+}
+
+int RunScheduler() {
+  SetClusterEnv(ps::kEnvRoleOfScheduler);
+  ps::core::SchedulerNode node;
+  if (!node.Start() || !node.Finish()) {
+    return 1;
+  }
+  return node.Stop() ? 0 : 1;
+}
+
+// Run the collectives on one rank and check the results, the return value is the exit code of the process.
+int RunRank() {
+  SetClusterEnv(ps::kEnvRoleOfWorker);
+  auto node = std::make_shared<ps::core::WorkerNode>();
+  if (!node->Start()) {
+    return 1;
+  }
+  uint32_t rank = node->rank_id();
+  CommunicationGroupInfo group_info = {};
+  group_info.size = kRankNum;
+  group_info.global_rank = rank;
+  for (uint32_t i = 0; i < kRankNum; i++) {
+    group_info.group_ranks.push_back(i);
+    group_info.global_to_group_ranks[i] = i;
+    group_info.group_to_global_ranks[i] = i;
+  }
+
+  int result = 0;
+  std::vector<float> input(kElementNum);
+  std::vector<float> output(kElementNum);
+  for (size_t i = 0; i < kElementNum; i++) {
+    input[i] = static_cast<float>((i % 100) * (rank + 1));
+  }
+  if (!CollectiveOpsImpl::GetInstance().AllReduce<float>(input.data(), output.data(), kElementNum,
+                                                         CollectiveReduceType::kSum, node, group_info)) {
+    result = 2;
+  }
+  for (size_t i = 0; i < kElementNum && result == 0; i++) {
+    float expect = static_cast<float>((i % 100) * kRankNum * (kRankNum + 1) / 2);
+    if (std::fabs(output[i] - expect) > 1e-5) {
+      result = 3;
+    }
+  }
+
+  size_t recv_count = kElementNum / kRankNum + 1;
+  std::vector<float16> fp16_input(recv_count * kRankNum, float16(1.0f));
+  std::vector<float16> fp16_output(recv_count);
+  if (result == 0 &&
+      !CollectiveOpsImpl::GetInstance().ReduceScatter<float16>(fp16_input.data(), fp16_output.data(), recv_count,
+                                                               CollectiveReduceType::kSum, node, group_info)) {
+    result = 4;
+  }
+  for (size_t i = 0; i < recv_count && result == 0; i++) {
+    if (static_cast<float>(fp16_output[i]) != static_cast<float>(kRankNum)) {
+      result = 5;
+    }
+  }
+  if (!node->Finish() || !node->Stop()) {
+    result = result == 0 ? 1 : result;
+  }
+  return result;
+}
+}  // namespace
+
+class TestCollectiveOpsImpl : public UT::Common {
+ public:
+  TestCollectiveOpsImpl() = default;
+  ~TestCollectiveOpsImpl() override = default;
+
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+// Launch a scheduler and kRankNum workers as processes on the loopback interface and run the ring collectives.
+TEST_F(TestCollectiveOpsImpl, RingAllReduceAndReduceScatterOnLoopback) {
+  scheduler_port = GetFreePort();
+  ASSERT_NE(scheduler_port, 0);
+  std::vector<pid_t> pids;
+  pid_t pid = fork();
+  ASSERT_GE(pid, 0);
+  if (pid == 0) {
+    _exit(RunScheduler());
+  }
+  pids.push_back(pid);
+  for (uint32_t i = 0; i < kRankNum; i++) {
+    pid = fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+      _exit(RunRank());
+    }
+    pids.push_back(pid);
+  }
+  for (auto child : pids) {
+    int status = 0;
+    ASSERT_EQ(waitpid(child, &status, 0), child);
+    ASSERT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+  }
+}
+}  // namespace server
+}  // namespace fl
+}  // namespace luojianet_ms
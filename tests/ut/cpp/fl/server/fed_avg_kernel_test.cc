@@ -0,0 +1,348 @@
+/**
+ * Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+ * Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "ir/func_graph.h"
+#include "ir/param_info.h"
+#include "fl/server/common.h"
+#include "fl/server/collective_ops_impl.h"
+#include "fl/server/parameter_aggregator.h"
+#include "fl/server/kernel/round/round_kernel.h"
+#include "ps/core/server_node.h"
+#include "ps/ps_context.h"
+#include "utils/utils.h"
+#define private public
+#include "fl/server/executor.h"
+#include "fl/server/kernel/round/update_model_kernel.h"
+#undef private
+
+namespace luojianet_ms {
+namespace fl {
+namespace server {
+namespace {
+constexpr size_t kWeightNum = 257;
+constexpr float kScale = 0.5f;
+constexpr int32_t kZeroPoint = 1;
+
+// The weights uploaded by three clients in float32, float16 and int8, which are multiplied by their data sizes.
+struct ClientWeights {
+  ClientWeights() : fp32(kWeightNum), fp16(kWeightNum), int8(kWeightNum) {
+    for (size_t i = 0; i < kWeightNum; i++) {
+      fp32[i] = static_cast<float>(i % 7) * 2;
+      fp16[i] = float16(static_cast<float>(i % 5) * 3);
+      int8[i] = static_cast<int8_t>(static_cast<int32_t>(i % 11) - 5);
+    }
+  }
+
+  // The federated average of the three uploads.
+  std::vector<float> Average(size_t total_data_size) const {
+    std::vector<float> average(kWeightNum);
+    for (size_t i = 0; i < kWeightNum; i++) {
+      float sum = fp32[i] + static_cast<float>(fp16[i]) + static_cast<float>(int8[i] - kZeroPoint) * kScale;
+      average[i] = sum / total_data_size;
+    }
+    return average;
+  }
+
+  std::vector<float> fp32;
+  std::vector<float16> fp16;
+  std::vector<int8_t> int8;
+};
+
+UploadData MakeUploadData(const std::string &key, void *weight, size_t weight_size, size_t *data_size) {
+  UploadData upload_data;
+  upload_data[key] = Address(weight, weight_size);
+  upload_data[kNewDataSize] = Address(data_size, sizeof(size_t));
+  return upload_data;
+}
+
+void ExpectWeight(const AddressPtr &weight, const std::vector<float> &expect) {
+  ASSERT_NE(weight, nullptr);
+  ASSERT_EQ(weight->size, expect.size() * sizeof(float));
+  const float *data = reinterpret_cast<const float *>(weight->addr);
+  for (size_t i = 0; i < expect.size(); i++) {
+    EXPECT_NEAR(data[i], expect[i], 1e-5);
+  }
+}
+}  // namespace
+
+class TestFedAvgKernel : public UT::Common {
+ public:
+  TestFedAvgKernel() = default;
+  ~TestFedAvgKernel() override = default;
+
+  // A single server counts and averages the uploads in-process, so the collectives never go through the network.
+  void SetUp() override {
+    ps::PSContext::instance()->set_server_mode(ps::kServerModeFL);
+    ps::PSContext::instance()->set_server_num(1);
+    CollectiveOpsImpl::GetInstance().Initialize(std::make_shared<ps::core::ServerNode>());
+  }
+  void TearDown() override { ps::PSContext::instance()->set_server_num(0); }
+
+  // Create the aggregator of an optimizer kernel with the weight, the counter is named after the weight so each test
+  // should use a different one.
+  std::shared_ptr<ParameterAggregator> CreateAggregator(const std::string &weight_name, size_t threshold_count,
+                                                        size_t weight_num = kWeightNum) {
+    auto graph = std::make_shared<FuncGraph>();
+    graphs_.push_back(graph);
+    auto weight = graph->add_parameter();
+    ShapeVector shape = {static_cast<int64_t>(weight_num)};
+    weight->set_name(weight_name);
+    weight->set_abstract(std::make_shared<abstract::AbstractTensor>(kFloat32, shape));
+    weight->set_default_param(std::make_shared<tensor::Tensor>(kNumberTypeFloat32, shape));
+    weight->set_param_info(std::make_shared<ParamInfo>());
+    auto cnode = graph->NewCNode({NewValueNode(std::make_shared<Primitive>(kApplyMomentumOpName)), weight});
+    auto aggregator = std::make_shared<ParameterAggregator>();
+    if (!aggregator->Init(cnode, threshold_count)) {
+      return nullptr;
+    }
+    return aggregator;
+  }
+
+  std::vector<FuncGraphPtr> graphs_;
+};
+
+// The float32, float16 and int8 uploads are accumulated, and the weight is averaged once the threshold is reached.
+TEST_F(TestFedAvgKernel, AggregateCompressedUploads) {
+  auto aggregator = CreateAggregator("fed_avg.compressed", 3);
+  ASSERT_NE(aggregator, nullptr);
+  ClientWeights weights;
+  schema::QuantParam quant_param(kScale, kZeroPoint);
+  std::vector<size_t> data_sizes = {2, 3, 5};
+
+  auto fp32_data = MakeUploadData(kNewWeight, weights.fp32.data(), kWeightNum * sizeof(float), &data_sizes[0]);
+  EXPECT_TRUE(aggregator->AggregateUploadData(fp32_data));
+  auto fp16_data = MakeUploadData(kNewWeightFp16, weights.fp16.data(), kWeightNum * sizeof(float16), &data_sizes[1]);
+  EXPECT_TRUE(aggregator->AggregateUploadData(fp16_data));
+  EXPECT_FALSE(aggregator->IsAggregationDone());
+  auto int8_data = MakeUploadData(kNewWeightInt8, weights.int8.data(), kWeightNum * sizeof(int8_t), &data_sizes[2]);
+  int8_data[kQuantParam] = Address(&quant_param, sizeof(schema::QuantParam));
+  EXPECT_TRUE(aggregator->AggregateUploadData(int8_data));
+  EXPECT_TRUE(aggregator->IsAggregationDone());
+  ExpectWeight(aggregator->GetWeight(), weights.Average(10));
+
+  // The weight of the last iteration is cleared by the first upload of the next one.
+  aggregator->ResetAggregationStatus();
+  EXPECT_FALSE(aggregator->IsAggregationDone());
+  for (size_t i = 0; i < data_sizes.size(); i++) {
+    EXPECT_TRUE(aggregator->AggregateUploadData(fp32_data));
+  }
+  EXPECT_TRUE(aggregator->IsAggregationDone());
+  std::vector<float> expect(kWeightNum);
+  for (size_t i = 0; i < kWeightNum; i++) {
+    expect[i] = weights.fp32[i] * 3 / (data_sizes[0] * 3);
+  }
+  ExpectWeight(aggregator->GetWeight(), expect);
+  aggregator->ResetAggregationStatus();
+}
+
+// The invalid uploads are rejected without being counted or accumulated.
+TEST_F(TestFedAvgKernel, RejectInvalidUploads) {
+  auto aggregator = CreateAggregator("fed_avg.invalid", 2);
+  ASSERT_NE(aggregator, nullptr);
+  ClientWeights weights;
+  schema::QuantParam quant_param(kScale, kZeroPoint);
+  size_t data_size = 4;
+
+  // The size of the weight doesn't match the one of the parameter.
+  auto fp32_data = MakeUploadData(kNewWeight, weights.fp32.data(), (kWeightNum - 1) * sizeof(float), &data_size);
+  EXPECT_FALSE(aggregator->AggregateUploadData(fp32_data));
+  auto fp16_data = MakeUploadData(kNewWeightFp16, weights.fp16.data(), kWeightNum * sizeof(float), &data_size);
+  EXPECT_FALSE(aggregator->AggregateUploadData(fp16_data));
+  auto int8_data = MakeUploadData(kNewWeightInt8, weights.int8.data(), kWeightNum * sizeof(int8_t) + 1, &data_size);
+  int8_data[kQuantParam] = Address(&quant_param, sizeof(schema::QuantParam));
+  EXPECT_FALSE(aggregator->AggregateUploadData(int8_data));
+
+  // The int8 weight can't be dequantized without a valid quant_param.
+  int8_data = MakeUploadData(kNewWeightInt8, weights.int8.data(), kWeightNum * sizeof(int8_t), &data_size);
+  EXPECT_FALSE(aggregator->AggregateUploadData(int8_data));
+  int8_data[kQuantParam] = Address(&quant_param, sizeof(float));
+  EXPECT_FALSE(aggregator->AggregateUploadData(int8_data));
+  int8_data[kQuantParam] = Address(nullptr, sizeof(schema::QuantParam));
+  EXPECT_FALSE(aggregator->AggregateUploadData(int8_data));
+
+  // The data size is missing or invalid, or no weight is uploaded.
+  fp32_data = MakeUploadData(kNewWeight, weights.fp32.data(), kWeightNum * sizeof(float), &data_size);
+  auto no_data_size = fp32_data;
+  (void)no_data_size.erase(kNewDataSize);
+  EXPECT_FALSE(aggregator->AggregateUploadData(no_data_size));
+  auto invalid_data_size = fp32_data;
+  invalid_data_size[kNewDataSize] = Address(&data_size, sizeof(uint32_t));
+  EXPECT_FALSE(aggregator->AggregateUploadData(invalid_data_size));
+  auto no_weight = fp32_data;
+  (void)no_weight.erase(kNewWeight);
+  EXPECT_FALSE(aggregator->AggregateUploadData(no_weight));
+  EXPECT_FALSE(aggregator->IsAggregationDone());
+
+  EXPECT_TRUE(aggregator->AggregateUploadData(fp32_data));
+  EXPECT_FALSE(aggregator->IsAggregationDone());
+  EXPECT_TRUE(aggregator->AggregateUploadData(fp32_data));
+  EXPECT_TRUE(aggregator->IsAggregationDone());
+  std::vector<float> expect(kWeightNum);
+  for (size_t i = 0; i < kWeightNum; i++) {
+    expect[i] = weights.fp32[i] * 2 / (data_size * 2);
+  }
+  ExpectWeight(aggregator->GetWeight(), expect);
+  aggregator->ResetAggregationStatus();
+}
+
+// The feature map of the updateModel request is parsed to the upload data of each weight, which is aggregated
+// straight from the request.
+TEST_F(TestFedAvgKernel, ParseFeatureMap) {
+  ClientWeights weights;
+  schema::QuantParam quant_param(kScale, kZeroPoint);
+  auto build_request = [&](FBBuilder *fbb, bool with_quant_param, bool with_empty_data) {
+    std::vector<uint16_t> fp16_bits(kWeightNum);
+    for (size_t i = 0; i < kWeightNum; i++) {
+      fp16_bits[i] = weights.fp16[i].int_value();
+    }
+    std::vector<flatbuffers::Offset<schema::FeatureMap>> feature_maps;
+    feature_maps.push_back(
+      schema::CreateFeatureMap(*fbb, fbb->CreateString("fp32.weight"), fbb->CreateVector(weights.fp32)));
+    feature_maps.push_back(
+      schema::CreateFeatureMap(*fbb, fbb->CreateString("fp16.weight"), 0, fbb->CreateVector(fp16_bits)));
+    feature_maps.push_back(schema::CreateFeatureMap(*fbb, fbb->CreateString("int8.weight"), 0, 0,
+                                                    fbb->CreateVector(weights.int8),
+                                                    with_quant_param ? &quant_param : nullptr));
+    if (with_empty_data) {
+      feature_maps.push_back(schema::CreateFeatureMap(*fbb, fbb->CreateString("empty.weight")));
+    }
+    auto fbs_feature_maps = fbb->CreateVector(feature_maps);
+    schema::RequestUpdateModelBuilder req_builder(*fbb);
+    req_builder.add_feature_map(fbs_feature_maps);
+    fbb->Finish(req_builder.Finish());
+    return flatbuffers::GetRoot<schema::RequestUpdateModel>(fbb->GetBufferPointer());
+  };
+  kernel::UpdateModelKernel update_model_kernel;
+
+  FBBuilder fbb;
+  auto feature_map = update_model_kernel.ParseFeatureMap(build_request(&fbb, true, false));
+  ASSERT_EQ(feature_map.size(), 3);
+  ASSERT_EQ(feature_map["fp32.weight"].count(kNewWeight), 1);
+  EXPECT_EQ(feature_map["fp32.weight"][kNewWeight].size, kWeightNum * sizeof(float));
+  ASSERT_EQ(feature_map["fp16.weight"].count(kNewWeightFp16), 1);
+  EXPECT_EQ(feature_map["fp16.weight"][kNewWeightFp16].size, kWeightNum * sizeof(float16));
+  ASSERT_EQ(feature_map["int8.weight"].count(kNewWeightInt8), 1);
+  EXPECT_EQ(feature_map["int8.weight"][kNewWeightInt8].size, kWeightNum * sizeof(int8_t));
+  ASSERT_EQ(feature_map["int8.weight"].count(kQuantParam), 1);
+  auto parsed_quant_param = reinterpret_cast<const schema::QuantParam *>(feature_map["int8.weight"][kQuantParam].addr);
+  ASSERT_NE(parsed_quant_param, nullptr);
+  EXPECT_EQ(parsed_quant_param->scale(), kScale);
+  EXPECT_EQ(parsed_quant_param->zero_point(), kZeroPoint);
+
+  auto aggregator = CreateAggregator("fed_avg.parsed", 3);
+  ASSERT_NE(aggregator, nullptr);
+  // The three parsed weights are aggregated into one parameter, as if they were uploaded by three clients.
+  size_t data_size = 2;
+  for (auto &weight : feature_map) {
+    weight.second[kNewDataSize] = Address(&data_size, sizeof(size_t));
+    EXPECT_TRUE(aggregator->AggregateUploadData(weight.second));
+  }
+  EXPECT_TRUE(aggregator->IsAggregationDone());
+  ExpectWeight(aggregator->GetWeight(), weights.Average(data_size * 3));
+  aggregator->ResetAggregationStatus();
+
+  // The int8 weight without quant_param and the weight without data fail the whole request.
+  FBBuilder no_quant_param_fbb;
+  EXPECT_TRUE(update_model_kernel.ParseFeatureMap(build_request(&no_quant_param_fbb, false, false)).empty());
+  FBBuilder empty_data_fbb;
+  EXPECT_TRUE(update_model_kernel.ParseFeatureMap(build_request(&empty_data_fbb, true, true)).empty());
+  EXPECT_TRUE(update_model_kernel.ParseFeatureMap(nullptr).empty());
+}
+
+// Benchmark of the upload path: kBenchClientNum client threads send kBenchRoundNum updateModel requests each, which
+// go through the same steps as UpdateModelKernel::UpdateModel, ParseFeatureMap and Executor::HandleModelUpdate for
+// every weight, and the throughput of the uploaded weights is reported. The requests don't go through the http
+// server. Run it with --gtest_also_run_disabled_tests --gtest_filter=*DISABLED_UploadThroughput.
+TEST_F(TestFedAvgKernel, DISABLED_UploadThroughput) {
+  constexpr size_t kBenchWeightNum = 4;
+  constexpr size_t kBenchWeightSize = 1 << 20;
+  constexpr size_t kBenchClientNum = 8;
+  constexpr size_t kBenchRoundNum = 4;
+  auto &executor = Executor::GetInstance();
+  std::vector<std::string> names;
+  for (size_t i = 0; i < kBenchWeightNum; i++) {
+    names.push_back("fed_avg.bench" + std::to_string(i));
+    auto aggregator = CreateAggregator(names.back(), kBenchClientNum * kBenchRoundNum, kBenchWeightSize);
+    ASSERT_NE(aggregator, nullptr);
+    executor.param_aggrs_[names.back()] = aggregator;
+    (void)executor.parameter_mutex_[names.back()];
+  }
+
+  // Client c uploads c + 1 for every element with data size 1.
+  std::vector<std::shared_ptr<FBBuilder>> requests;
+  for (size_t client = 0; client < kBenchClientNum; client++) {
+    auto fbb = std::make_shared<FBBuilder>();
+    std::vector<float> data(kBenchWeightSize, static_cast<float>(client + 1));
+    std::vector<flatbuffers::Offset<schema::FeatureMap>> feature_maps;
+    for (auto &name : names) {
+      feature_maps.push_back(schema::CreateFeatureMap(*fbb, fbb->CreateString(name), fbb->CreateVector(data)));
+    }
+    auto fbs_feature_maps = fbb->CreateVector(feature_maps);
+    schema::RequestUpdateModelBuilder req_builder(*fbb);
+    req_builder.add_feature_map(fbs_feature_maps);
+    fbb->Finish(req_builder.Finish());
+    requests.push_back(fbb);
+  }
+
+  std::vector<size_t> failures(kBenchClientNum, 0);
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> clients;
+  for (size_t client = 0; client < kBenchClientNum; client++) {
+    clients.emplace_back([&, client]() {
+      kernel::UpdateModelKernel update_model_kernel;
+      size_t data_size = 1;
+      for (size_t round = 0; round < kBenchRoundNum; round++) {
+        auto request = flatbuffers::GetRoot<schema::RequestUpdateModel>(requests[client]->GetBufferPointer());
+        auto feature_map = update_model_kernel.ParseFeatureMap(request);
+        failures[client] += kBenchWeightNum - feature_map.size();
+        for (auto &weight : feature_map) {
+          weight.second[kNewDataSize] = Address(&data_size, sizeof(size_t));
+          failures[client] += executor.HandleModelUpdate(weight.first, weight.second) ? 0 : 1;
+        }
+      }
+    });
+  }
+  for (auto &client : clients) {
+    client.join();
+  }
+  double cost = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  double bytes = static_cast<double>(kBenchClientNum * kBenchRoundNum * kBenchWeightNum * kBenchWeightSize) *
+                 sizeof(float);
+  std::cout << "UpdateModel of " << kBenchClientNum << " clients uploaded " << bytes / (1 << 20) << " MB in "
+            << cost * 1000 << " ms, " << bytes / (1 << 20) / cost << " MB/s." << std::endl;
+
+  for (size_t client = 0; client < kBenchClientNum; client++) {
+    EXPECT_EQ(failures[client], 0u);
+  }
+  std::vector<float> expect(kBenchWeightSize, static_cast<float>(kBenchClientNum + 1) / 2);
+  for (auto &name : names) {
+    EXPECT_TRUE(executor.param_aggrs_[name]->IsAggregationDone());
+    ExpectWeight(executor.param_aggrs_[name]->GetWeight(), expect);
+    executor.param_aggrs_[name]->ResetAggregationStatus();
+    (void)executor.param_aggrs_.erase(name);
+  }
+}
+}  // namespace server
+}  // namespace fl
+}  // namespace luojianet_ms
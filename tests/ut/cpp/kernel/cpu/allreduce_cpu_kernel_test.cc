@@ -0,0 +1,208 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "distributed/cluster/cluster_context.h"
+#include "distributed/constants.h"
+#include "ps/ps_context.h"
+#include "utils/ms_utils.h"
+#define private public
+#define protected public
+#include "backend/kernel_compiler/cpu/allreduce_cpu_kernel.h"
+#include "runtime/hardware/cpu/ms_collective_comm_lib.h"
+#undef private
+#undef protected
+
+namespace luojianet_ms {
+namespace kernel {
+namespace {
+using device::cpu::MsCollectiveCommLib;
+using distributed::cluster::ClusterContext;
+constexpr uint32_t kRankNum = 3;
+constexpr size_t kElementNum = 1000003;
+
+uint16_t GetFreePort() {
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  if (fd < 0) {
+    return 0;
+  }
+  sockaddr_in addr = {};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = 0;
+  socklen_t len = sizeof(addr);
+  uint16_t port = 0;
+  if (bind(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) == 0 &&
+      getsockname(fd, reinterpret_cast<sockaddr *>(&addr), &len) == 0) {
+    port = ntohs(addr.sin_port);
+  }
+  (void)close(fd);
+  return port;
+}
+
+uint16_t scheduler_port = 0;
+
+// Build the cluster the same way as distributed::Initialize does, with the environment of the given role.
+bool InitCluster(const std::string &role) {
+  common::SetEnv(distributed::kEnvRole, role.c_str());
+  common::SetEnv(distributed::kEnvWorkerNum, std::to_string(kRankNum).c_str());
+  common::SetEnv(distributed::kEnvServerNum, "0");
+  common::SetEnv(distributed::kEnvSchedulerHost, "127.0.0.1");
+  common::SetEnv(distributed::kEnvSchedulerPort, std::to_string(scheduler_port).c_str());
+  ps::PSContext::instance()->SetPSEnable(true);
+  return ClusterContext::instance()->Initialize();
+}
+
+int RunScheduler() {
+  if (!InitCluster(distributed::kEnvRoleOfScheduler)) {
+    return 1;
+  }
+  return ClusterContext::instance()->Finalize() ? 0 : 1;
+}
+
+AddressPtr CreateKernelAddress(void *addr, size_t size) {
+  auto kernel_addr = std::make_shared<Address>();
+  kernel_addr->addr = addr;
+  kernel_addr->size = size;
+  return kernel_addr;
+}
+
+// Launch the AllReduce CPU kernel and the host ReduceScatter on one rank, the return value is the exit code.
+int RunRank() {
+  if (!InitCluster(distributed::kEnvRoleOfWorker)) {
+    return 1;
+  }
+  auto node = std::dynamic_pointer_cast<ps::core::AbstractNode>(ClusterContext::instance()->node());
+  if (node == nullptr) {
+    return 1;
+  }
+  uint32_t rank = node->rank_id();
+  auto &comm_lib = MsCollectiveCommLib::GetInstance();
+  std::vector<uint32_t> ranks;
+  for (uint32_t i = 0; i < kRankNum; i++) {
+    ranks.push_back(i);
+  }
+  if (!comm_lib.Initialize(rank, kRankNum) || !comm_lib.CreateCommunicationGroup(comm_lib.global_group_name(), ranks)) {
+    return 2;
+  }
+
+  int result = 0;
+  AllReduceCPUKernel sum_kernel;
+  sum_kernel.kernel_name_ = "AllReduce";
+  sum_kernel.dtype_ = kNumberTypeFloat32;
+  sum_kernel.reduce_op_ = device::CollectiveOpReduceType::Reduce_Sum;
+  sum_kernel.group_name_ = comm_lib.global_group_name();
+  std::vector<float> input(kElementNum);
+  std::vector<float> output(kElementNum);
+  for (size_t i = 0; i < kElementNum; i++) {
+    input[i] = static_cast<float>((i % 100) * (rank + 1));
+  }
+  if (!sum_kernel.Launch({CreateKernelAddress(input.data(), kElementNum * sizeof(float))}, {},
+                         {CreateKernelAddress(output.data(), kElementNum * sizeof(float))})) {
+    result = 3;
+  }
+  for (size_t i = 0; i < kElementNum && result == 0; i++) {
+    float expect = static_cast<float>((i % 100) * kRankNum * (kRankNum + 1) / 2);
+    if (std::fabs(output[i] - expect) > 1e-5) {
+      result = 4;
+    }
+  }
+
+  AllReduceCPUKernel max_kernel;
+  max_kernel.kernel_name_ = "AllReduce";
+  max_kernel.dtype_ = kNumberTypeInt32;
+  max_kernel.reduce_op_ = device::CollectiveOpReduceType::Reduce_Max;
+  max_kernel.group_name_ = comm_lib.global_group_name();
+  std::vector<int32_t> int_input = {static_cast<int32_t>(rank), -static_cast<int32_t>(rank), 7};
+  std::vector<int32_t> int_output(int_input.size());
+  size_t int_size = int_input.size() * sizeof(int32_t);
+  if (result == 0 && !max_kernel.Launch({CreateKernelAddress(int_input.data(), int_size)}, {},
+                                        {CreateKernelAddress(int_output.data(), int_size)})) {
+    result = 5;
+  }
+  if (result == 0 && int_output != std::vector<int32_t>({static_cast<int32_t>(kRankNum - 1), 0, 7})) {
+    result = 6;
+  }
+
+  // The host ReduceScatter kernel runs the same call when the process is not launched by OpenMPI.
+  size_t recv_count = kElementNum / kRankNum + 1;
+  std::vector<float> scatter_input(recv_count * kRankNum, 1.0f);
+  std::vector<float> scatter_output(recv_count);
+  if (result == 0 && !comm_lib.ReduceScatter(scatter_input.data(), scatter_output.data(), recv_count,
+                                             kNumberTypeFloat32, device::CollectiveOpReduceType::Reduce_Sum,
+                                             comm_lib.global_group_name())) {
+    result = 7;
+  }
+  for (size_t i = 0; i < recv_count && result == 0; i++) {
+    if (scatter_output[i] != static_cast<float>(kRankNum)) {
+      result = 8;
+    }
+  }
+  if (!ClusterContext::instance()->Finalize()) {
+    result = result == 0 ? 1 : result;
+  }
+  return result;
+}
+}  // namespace
+
+class TestAllReduceCPUKernel : public UT::Common {
+ public:
+  TestAllReduceCPUKernel() = default;
+  ~TestAllReduceCPUKernel() override = default;
+
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+// Build a cluster of a scheduler and kRankNum workers on the loopback interface and launch the CPU collective kernels
+// on the LuoJiaNet collective communication library.
+TEST_F(TestAllReduceCPUKernel, LaunchOnLoopbackCluster) {
+  scheduler_port = GetFreePort();
+  ASSERT_NE(scheduler_port, 0);
+  std::vector<pid_t> pids;
+  pid_t pid = fork();
+  ASSERT_GE(pid, 0);
+  if (pid == 0) {
+    _exit(RunScheduler());
+  }
+  pids.push_back(pid);
+  for (uint32_t i = 0; i < kRankNum; i++) {
+    pid = fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+      _exit(RunRank());
+    }
+    pids.push_back(pid);
+  }
+  for (auto child : pids) {
+    int status = 0;
+    ASSERT_EQ(waitpid(child, &status, 0), child);
+    ASSERT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+  }
+}
+}  // namespace kernel
+}  // namespace luojianet_ms
@@ -0,0 +1,232 @@
+/**
+ * Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+ * Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "ps/ps_cache/embedding_host_cache.h"
+
+namespace luojianet_ms {
+namespace ps {
+namespace {
+constexpr size_t kEmbeddingSize = 4;
+
+// The value of the row of id on the server.
+std::vector<float> ServerRow(int id, float offset = 0.0f) {
+  std::vector<float> row(kEmbeddingSize);
+  for (size_t i = 0; i < kEmbeddingSize; ++i) {
+    row[i] = static_cast<float>(id) * 10 + i + offset;
+  }
+  return row;
+}
+
+std::vector<float> ServerRows(const std::vector<int> &ids, float offset = 0.0f) {
+  std::vector<float> rows;
+  for (auto id : ids) {
+    auto row = ServerRow(id, offset);
+    rows.insert(rows.end(), row.begin(), row.end());
+  }
+  return rows;
+}
+
+// Look up the ids, and insert the missed rows from the server like the worker does.
+std::vector<size_t> LookupAndFill(EmbeddingHostCache *cache, const std::vector<int> &ids, float offset = 0.0f) {
+  std::vector<float> output(ids.size() * kEmbeddingSize);
+  std::vector<size_t> misses;
+  cache->Lookup(ids.data(), ids.size(), output.data(), &misses);
+  std::vector<int> miss_ids;
+  for (auto pos : misses) {
+    miss_ids.push_back(ids[pos]);
+  }
+  cache->Insert(miss_ids, ServerRows(miss_ids, offset).data());
+  return misses;
+}
+}  // namespace
+
+class TestEmbeddingHostCache : public UT::Common {
+ public:
+  TestEmbeddingHostCache() = default;
+  virtual ~TestEmbeddingHostCache() = default;
+
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+TEST_F(TestEmbeddingHostCache, LookupAndStaleness) {
+  EmbeddingHostCache cache(8, kEmbeddingSize, 1, CreateEmbeddingCachePolicy("LRU"), nullptr);
+  std::vector<int> ids = {1, 2, 3, 1};
+  EXPECT_EQ(LookupAndFill(&cache, ids).size(), 4);
+
+  std::vector<float> output(ids.size() * kEmbeddingSize);
+  std::vector<size_t> misses;
+  cache.NextStep();
+  cache.Lookup(ids.data(), ids.size(), output.data(), &misses);
+  EXPECT_TRUE(misses.empty());
+  EXPECT_EQ(output, ServerRows(ids));
+
+  // The rows fetched from the server expire after max_staleness steps.
+  cache.NextStep();
+  cache.Lookup(ids.data(), ids.size(), output.data(), &misses);
+  EXPECT_EQ(misses.size(), 4);
+  EXPECT_EQ(cache.hit_count(), 4);
+  EXPECT_EQ(cache.miss_count(), 8);
+}
+
+TEST_F(TestEmbeddingHostCache, EvictionPolicy) {
+  EmbeddingHostCache lru(8, kEmbeddingSize, 100, CreateEmbeddingCachePolicy("LRU"), nullptr);
+  EmbeddingHostCache lfu(8, kEmbeddingSize, 100, CreateEmbeddingCachePolicy("LFU"), nullptr);
+  std::vector<int> ids = {0, 1, 2, 3, 4, 5, 6, 7};
+  (void)LookupAndFill(&lru, ids);
+  (void)LookupAndFill(&lfu, ids);
+  // Row 0 is the most frequently used one, and row 7 is the most recently used one.
+  for (size_t i = 0; i < 3; ++i) {
+    (void)LookupAndFill(&lru, {0});
+    (void)LookupAndFill(&lfu, {0});
+  }
+  (void)LookupAndFill(&lru, {1, 2, 3, 4, 5, 6, 7});
+  (void)LookupAndFill(&lfu, {1, 2, 3, 4, 5, 6, 7});
+  EXPECT_EQ(LookupAndFill(&lru, {8}).size(), 1);
+  EXPECT_EQ(LookupAndFill(&lfu, {8}).size(), 1);
+  EXPECT_EQ(LookupAndFill(&lru, {0}).size(), 1);
+  EXPECT_EQ(LookupAndFill(&lfu, {0}).size(), 0);
+  EXPECT_EQ(lru.eviction_count(), 2);
+  EXPECT_EQ(lfu.eviction_count(), 1);
+  EXPECT_EQ(CreateEmbeddingCachePolicy("FIFO"), nullptr);
+}
+
+TEST_F(TestEmbeddingHostCache, WriteBack) {
+  std::mutex server_mutex;
+  std::map<int, std::vector<float>> server;
+  auto write_back = [&](const std::vector<int> &ids, const std::vector<float> &values) {
+    std::lock_guard<std::mutex> lock(server_mutex);
+    for (size_t i = 0; i < ids.size(); ++i) {
+      server[ids[i]] = std::vector<float>(values.begin() + i * kEmbeddingSize,
+                                          values.begin() + (i + 1) * kEmbeddingSize);
+    }
+    return true;
+  };
+  EmbeddingHostCache cache(4, kEmbeddingSize, 0, CreateEmbeddingCachePolicy("LRU"), write_back);
+  std::vector<int> ids = {0, 1, 2, 3};
+  cache.Update(ids, ServerRows(ids, 0.5f).data());
+
+  // The updated rows are always valid, and aren't overwritten by the rows fetched from the server.
+  cache.NextStep();
+  std::vector<float> output(ids.size() * kEmbeddingSize);
+  std::vector<size_t> misses;
+  cache.Lookup(ids.data(), ids.size(), output.data(), &misses);
+  EXPECT_TRUE(misses.empty());
+  cache.Insert(ids, ServerRows(ids).data());
+  cache.Lookup(ids.data(), ids.size(), output.data(), &misses);
+  EXPECT_EQ(output, ServerRows(ids, 0.5f));
+
+  // Evicting the updated rows writes them back.
+  (void)LookupAndFill(&cache, {4, 5});
+  EXPECT_EQ(cache.eviction_count(), 2);
+  EXPECT_TRUE(cache.Flush());
+  EXPECT_EQ(server.size(), 4);
+  for (auto id : ids) {
+    EXPECT_EQ(server[id], ServerRow(id, 0.5f));
+  }
+}
+
+TEST_F(TestEmbeddingHostCache, RetryFailedWriteBack) {
+  std::mutex server_mutex;
+  std::map<int, std::vector<float>> server;
+  std::atomic<bool> reachable{false};
+  auto write_back = [&](const std::vector<int> &ids, const std::vector<float> &values) {
+    if (!reachable) {
+      return false;
+    }
+    std::lock_guard<std::mutex> lock(server_mutex);
+    for (size_t i = 0; i < ids.size(); ++i) {
+      server[ids[i]] = std::vector<float>(values.begin() + i * kEmbeddingSize,
+                                          values.begin() + (i + 1) * kEmbeddingSize);
+    }
+    return true;
+  };
+  EmbeddingHostCache cache(4, kEmbeddingSize, 0, CreateEmbeddingCachePolicy("LRU"), write_back);
+  std::vector<int> ids = {0, 1, 2, 3};
+  cache.Update(ids, ServerRows(ids, 0.5f).data());
+  (void)LookupAndFill(&cache, {4, 5});
+  EXPECT_EQ(cache.eviction_count(), 2);
+  EXPECT_FALSE(cache.Flush());
+  EXPECT_EQ(cache.write_back_count(), 0);
+
+  // The rows which failed to be written back are still served by the cache instead of the stale ones on the server.
+  std::vector<float> output(ids.size() * kEmbeddingSize);
+  std::vector<size_t> misses;
+  cache.Lookup(ids.data(), ids.size(), output.data(), &misses);
+  EXPECT_TRUE(misses.empty());
+  EXPECT_EQ(output, ServerRows(ids, 0.5f));
+
+  // They are written back once the server is reachable.
+  reachable = true;
+  EXPECT_TRUE(cache.Flush());
+  EXPECT_EQ(server.size(), 4);
+  for (auto id : ids) {
+    EXPECT_EQ(server[id], ServerRow(id, 0.5f));
+  }
+}
+
+TEST_F(TestEmbeddingHostCache, ConcurrentLookup) {
+  constexpr size_t kThreadNum = 8;
+  constexpr int kIdNum = 256;
+  EmbeddingHostCache cache(64, kEmbeddingSize, 1000, CreateEmbeddingCachePolicy("LFU"), nullptr);
+  std::vector<std::thread> threads;
+  std::vector<bool> results(kThreadNum, true);
+  for (size_t t = 0; t < kThreadNum; ++t) {
+    threads.emplace_back([&, t]() {
+      std::vector<int> ids(16);
+      std::vector<float> output(ids.size() * kEmbeddingSize);
+      std::vector<size_t> misses;
+      for (int round = 0; round < 500; ++round) {
+        for (size_t i = 0; i < ids.size(); ++i) {
+          ids[i] = static_cast<int>((t * 7 + round * 13 + i * i) % kIdNum);
+        }
+        cache.Lookup(ids.data(), ids.size(), output.data(), &misses);
+        size_t miss_index = 0;
+        for (size_t i = 0; i < ids.size(); ++i) {
+          if (miss_index < misses.size() && misses[miss_index] == i) {
+            ++miss_index;
+            continue;
+          }
+          auto expect = ServerRow(ids[i]);
+          if (!std::equal(expect.begin(), expect.end(), output.begin() + i * kEmbeddingSize)) {
+            results[t] = false;
+          }
+        }
+        std::vector<int> miss_ids;
+        for (auto pos : misses) {
+          miss_ids.push_back(ids[pos]);
+        }
+        cache.Insert(miss_ids, ServerRows(miss_ids).data());
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  for (size_t t = 0; t < kThreadNum; ++t) {
+    EXPECT_TRUE(results[t]);
+  }
+  EXPECT_EQ(cache.hit_count() + cache.miss_count(), kThreadNum * 500 * 16);
+  EXPECT_GT(cache.hit_rate(), 0.0);
+}
+}  // namespace ps
+}  // namespace luojianet_ms
@@ -0,0 +1,132 @@
+/**
+ * Copyright 2021, 2022 LuoJiaNET Research and Development Group, Wuhan University
+ * Copyright 2021, 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+#include "common/common_test.h"
+#define private public
+#include "utils/summary/event_writer.h"
+#undef private
+
+namespace luojianet_ms {
+namespace summary {
+namespace {
+// The same limit as in event_writer.cc.
+constexpr size_t kMaxQueueBytes = 64 << 20;
+constexpr size_t kEventBytes = 3 << 20;
+constexpr size_t kEventNum = 32;
+
+// The events differ in their size and content, so that a lost or reordered event is detected.
+std::string MakeEvent(size_t index) { return std::string(kEventBytes + index, static_cast<char>('a' + index % 26)); }
+
+// Parse the records of the summary file, returns false if a record is truncated or its crc doesn't match.
+bool ReadRecords(const std::string &file_name, std::vector<std::string> *records) {
+  std::ifstream ifs(file_name, std::ios::binary);
+  std::string content((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+  size_t offset = 0;
+  constexpr size_t kHeaderBytes = sizeof(uint64_t) + sizeof(uint32_t);
+  while (offset < content.size()) {
+    if (content.size() - offset < kHeaderBytes) {
+      return false;
+    }
+    uint64_t data_len = 0;
+    (void)memcpy(&data_len, content.data() + offset, sizeof(uint64_t));
+    uint32_t crc = system::Crc32c::GetMaskCrc32cValue(content.data() + offset, sizeof(uint64_t));
+    if (crc != system::DecodeFixed32(content.data() + offset + sizeof(uint64_t))) {
+      return false;
+    }
+    offset += kHeaderBytes;
+    if (content.size() - offset < data_len + sizeof(uint32_t)) {
+      return false;
+    }
+    std::string data = content.substr(offset, data_len);
+    crc = system::Crc32c::GetMaskCrc32cValue(data.data(), data.size());
+    if (crc != system::DecodeFixed32(content.data() + offset + data_len)) {
+      return false;
+    }
+    offset += data_len + sizeof(uint32_t);
+    records->push_back(std::move(data));
+  }
+  return true;
+}
+
+void ExpectAllEvents(const std::string &file_name) {
+  std::vector<std::string> records;
+  ASSERT_TRUE(ReadRecords(file_name, &records));
+  ASSERT_EQ(records.size(), kEventNum);
+  for (size_t i = 0; i < kEventNum; ++i) {
+    EXPECT_TRUE(records[i] == MakeEvent(i)) << "record " << i << " doesn't match";
+  }
+}
+}  // namespace
+
+class TestEventWriter : public UT::Common {
+ public:
+  TestEventWriter() {}
+};
+
+/// Feature: summary event writer.
+/// Description: write 96MB of events, more than the 64MB queue limit, then flush and shut the writer, and write
+/// once more after it is shut.
+/// Expectation: the queued bytes never exceed the limit, every event is on disk in order after Flush and Shut, and
+/// the write after Shut fails.
+TEST_F(TestEventWriter, test_WritePastQueueLimitThenShut) {
+  std::string file_name = "./event_writer_test_shut.summary";
+  // The summary writer of python creates the file before the event writer opens it.
+  std::ofstream(file_name).close();
+  {
+    EventWriter writer(file_name);
+    for (size_t i = 0; i < kEventNum; ++i) {
+      ASSERT_TRUE(writer.Write(MakeEvent(i)));
+      std::lock_guard<std::mutex> lock(writer.queue_mutex_);
+      EXPECT_LE(writer.queue_bytes_, kMaxQueueBytes);
+    }
+    EXPECT_EQ(writer.GetWriteEventCount(), static_cast<int32_t>(kEventNum));
+    ASSERT_TRUE(writer.Flush());
+    ExpectAllEvents(file_name);
+    ASSERT_TRUE(writer.Shut());
+    EXPECT_FALSE(writer.Write(MakeEvent(0)));
+  }
+  ExpectAllEvents(file_name);
+  (void)std::remove(file_name.c_str());
+}
+
+/// Feature: summary event writer.
+/// Description: write 96MB of events and close the writer without flushing, then write once more.
+/// Expectation: Close writes out the queued events in order, and the write after Close fails.
+TEST_F(TestEventWriter, test_CloseWritesQueuedEvents) {
+  std::string file_name = "./event_writer_test_close.summary";
+  // The summary writer of python creates the file before the event writer opens it.
+  std::ofstream(file_name).close();
+  {
+    EventWriter writer(file_name);
+    for (size_t i = 0; i < kEventNum; ++i) {
+      ASSERT_TRUE(writer.Write(MakeEvent(i)));
+    }
+    ASSERT_TRUE(writer.Close());
+    EXPECT_FALSE(writer.Write(MakeEvent(0)));
+    EXPECT_EQ(writer.GetWriteEventCount(), static_cast<int32_t>(kEventNum));
+  }
+  ExpectAllEvents(file_name);
+  (void)std::remove(file_name.c_str());
+}
+}  // namespace summary
+}  // namespace luojianet_ms
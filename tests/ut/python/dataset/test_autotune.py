@@ -16,6 +16,8 @@
 """
 Testing Autotune support in DE
 """
+import json
+import os
 import numpy as np
 import pytest
 import luojianet_ms._c_dataengine as cde
@@ -205,6 +207,41 @@ class TestAutotuneWithProfiler:
 
         ds.config.set_enable_autotune(False)
 
+    def test_autotune_save_config(self, tmp_path):
+        """
+        Feature: Autotuning
+        Description: test saving the tuned config of a simple pipeline, and starting from it in the next run
+        Expectation: the config of every op is saved to the json file, and the next run succeeds with it
+        """
+        config_file = os.path.join(str(tmp_path), "autotune_out.json")
+        ds.config.set_enable_autotune(True, config_file)
+
+        source = [(np.array([x]),) for x in range(1024)]
+        data1 = ds.GeneratorDataset(source, ["data"])
+        data1 = data1.shuffle(64)
+        data1 = data1.batch(32)
+
+        itr = data1.create_dict_iterator(num_epochs=1)
+        for _ in itr:
+            pass
+        del itr
+
+        with open(config_file) as f:
+            config = json.load(f)
+        op_types = [op["op_type"] for op in config["op_info"]]
+        assert "GeneratorOp" in op_types
+        for op in config["op_info"]:
+            assert op["prefetch_size"] > 0
+
+        # start from the saved config
+        itr = data1.create_dict_iterator(num_epochs=1)
+        num_rows = 0
+        for _ in itr:
+            num_rows += 1
+        assert num_rows == 32
+
+        ds.config.set_enable_autotune(False)
+
     def test_autotune_config(self):
         """
         Feature: Autotuning
@@ -221,6 +258,14 @@ class TestAutotuneWithProfiler:
         with pytest.raises(TypeError):
             ds.config.set_enable_autotune(1)
 
+        with pytest.raises(TypeError):
+            ds.config.set_enable_autotune(True, 1)
+
+        with pytest.raises(ValueError):
+            ds.config.set_enable_autotune(True, "/nonexistent_dir/autotune_out.json")
+        autotune_state = ds.config.get_enable_autotune()
+        assert autotune_state is False
+
         autotune_interval = ds.config.get_autotune_interval()
         assert autotune_interval == 0
 
@@ -308,6 +308,39 @@ def test_graphdata_getedgesfromnodes():
     assert edges.tolist() == [1, 9, 31, 17, 20, 40]
 
 
+def test_graphdata_save_graph_store(tmp_path):
+    """
+    Test save graph store and load the graph from it
+    """
+    logger.info('test save_graph_store.\n')
+    g = ds.GraphData(DATASET_FILE)
+    store_file = str(tmp_path / "graph_store")
+    g.save_graph_store(store_file)
+    g_store = ds.GraphData(store_file)
+    graph_info = g.graph_info()
+    assert g_store.graph_info() == graph_info
+
+    nodes = g.get_all_nodes(1)
+    assert g_store.get_all_nodes(1).tolist() == nodes.tolist()
+    assert g_store.get_all_neighbors(nodes, 2).tolist() == g.get_all_neighbors(nodes, 2).tolist()
+    nodes[5] = -1
+    expect = g.get_node_feature(nodes, graph_info['node_feature_type'])
+    features = g_store.get_node_feature(nodes, graph_info['node_feature_type'])
+    for expect_feature, feature in zip(expect, features):
+        assert np.array_equal(expect_feature, feature)
+
+    edges = g.get_all_edges(0)
+    assert g_store.get_nodes_from_edges(edges).tolist() == g.get_nodes_from_edges(edges).tolist()
+    expect = g.get_edge_feature(edges, graph_info['edge_feature_type'])
+    features = g_store.get_edge_feature(edges, graph_info['edge_feature_type'])
+    for expect_feature, feature in zip(expect, features):
+        assert np.array_equal(expect_feature, feature)
+
+    nodes_pair_list = [(101, 201), (103, 207), (204, 105), (108, 208), (110, 210), (210, 110)]
+    assert g_store.get_edges_from_nodes(node_list=nodes_pair_list).tolist() == [1, 9, 31, 17, 20, 40]
+    assert g_store.get_sampled_neighbors(nodes[:5].tolist(), [2, 3], [2, 1]).shape == (5, 9)
+
+
 if __name__ == '__main__':
     test_graphdata_getfullneighbor()
     test_graphdata_getnodefeature_input_check()
@@ -163,6 +163,49 @@ class TestMinddataProfilingManager:
         # Confirm CPU util JSON file content, when 5 ops are in the pipeline JSON file
         self.confirm_cpuutil(5, cpu_util_file)
 
+    def test_profiling_span_trace(self, tmp_path):
+        """
+        Generator -> Map -> Batch
+        Confirm the timelines of the workers are saved in Chrome trace format
+        """
+
+        source = [(np.array([x]),) for x in range(1024)]
+        data1 = ds.GeneratorDataset(source, ["data"])
+        data1 = data1.map(operations=[C.TypeCast(mstype.int32)], input_columns=["data"], num_parallel_workers=2)
+        data1 = data1.batch(32)
+
+        for _ in data1:
+            pass
+
+        # Stop MindData Profiling and save output files to current working directory
+        self.md_profiler.stop()
+        self.md_profiler.save(str(tmp_path))
+
+        pipeline_file = str(tmp_path) + "/pipeline_profiling_1.json"
+        trace_file = str(tmp_path) + "/dataset_trace_1.json"
+
+        with open(pipeline_file) as file1:
+            data = json.load(file1)
+            map_info = [op for op in data["op_info"] if op["op_type"] == "MapOp"]
+            assert len(map_info) == 1
+            map_id = map_info[0]["op_id"]
+            assert "push_blocked_time" in map_info[0]["metrics"]["output_queue"]
+            assert "pop_blocked_time" in map_info[0]["metrics"]["output_queue"]
+
+        with open(trace_file) as file1:
+            data = json.load(file1)
+            events = data["traceEvents"]
+            # One process per op in the timelines
+            assert len([e for e in events if e["ph"] == "M"]) == 3
+            compute_spans = [e for e in events if e["ph"] == "X" and e["cat"] == "compute"]
+            assert compute_spans
+            for span in compute_spans:
+                assert span["pid"] == map_id
+                assert span["name"] == "TypeCastOp"
+            # Every row is counted in the summary
+            compute_summary = [s for s in data["span_summary"] if s["category"] == "compute"]
+            assert sum(s["count"] for s in compute_summary) == 1024
+
     def test_profiling_inline_ops_pipeline1(self, tmp_path):
         """
         Test pipeline with inline ops: Concat and EpochCtrl
@@ -16,8 +16,10 @@
 """ test ops """
 import functools
 import numpy as np
+import pytest
 
 import luojianet_ms.nn as nn
+from luojianet_ms import context
 from luojianet_ms import Tensor
 from luojianet_ms.common import dtype as mstype
 from luojianet_ms.common.parameter import Parameter
@@ -665,3 +667,23 @@ def test_exec():
     import luojianet_ms.context as context
     context.set_context(mode=context.GRAPH_MODE)
     return functools.reduce(lambda x, y: x + y, [test_case_math_ops])
+
+
+def test_nms_with_mask_cpu_only_args():
+    """
+    Feature: NMSWithMask max_output_size and batched boxes.
+    Description: infer NMSWithMask with max_output_size or rank 3 boxes on Ascend and on CPU.
+    Expectation: only the CPU target accepts them, the other targets raise ValueError.
+    """
+    device_target = context.get_context("device_target")
+    try:
+        context.set_context(device_target="Ascend")
+        with pytest.raises(ValueError, match="max_output_size"):
+            P.NMSWithMask(max_output_size=2).infer_shape([4, 5])
+        with pytest.raises(ValueError, match="bboxes rank"):
+            P.NMSWithMask().infer_shape([2, 4, 5])
+        assert P.NMSWithMask().infer_shape([4, 5]) == ([4, 5], (4,), (4,))
+        context.set_context(device_target="CPU")
+        assert P.NMSWithMask(max_output_size=2).infer_shape([2, 4, 5]) == ([2, 4, 5], (2, 4), (2, 4))
+    finally:
+        context.set_context(device_target=device_target)
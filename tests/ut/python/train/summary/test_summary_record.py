@@ -22,7 +22,7 @@ import numpy as np
 import pytest
 
 from luojianet_ms.common.tensor import Tensor
-from luojianet_ms.train.summary.summary_record import SummaryRecord
+from luojianet_ms.train.summary.summary_record import SummaryRecord, _compress_summary_value
 from luojianet_ms._c_expression import security
 from tests.security_utils import security_off_wrap
 
@@ -85,6 +85,39 @@ class TestSummaryRecord:
             with SummaryRecord(summary_dir) as sr:
                 sr.record(step)
 
+    @security_off_wrap
+    @pytest.mark.parametrize("compress_options", [{'image_size': 32}, {'image_max_size': 0}, {'quantize': 1}, 32])
+    def test_compress_options_with_invalid_value(self, compress_options):
+        summary_dir = tempfile.mkdtemp(dir=self.base_summary_dir)
+        with pytest.raises((TypeError, ValueError)):
+            with SummaryRecord(summary_dir, compress_options=compress_options):
+                pass
+
+    def test_compress_summary_value(self):
+        """Test downsampling and quantizing the image and tensor summaries."""
+        image = np.random.rand(2, 3, 100, 70).astype(np.float32)
+        compressed = _compress_summary_value('image', image, {'image_max_size': 32, 'quantize': True})
+        assert compressed.shape == (2, 3, 25, 18)
+        assert compressed.dtype == np.uint8
+        compressed = _compress_summary_value('tensor', image, {'tensor_max_size': 50, 'quantize': True})
+        assert compressed.shape == (2, 3, 50, 35)
+        assert compressed.dtype == np.float16
+        assert np.allclose(compressed, image[..., ::2, ::2], atol=1e-3)
+        assert _compress_summary_value('histogram', image, {'tensor_max_size': 32}) is image
+        assert _compress_summary_value('tensor', image, None) is image
+
+    def test_compress_summary_value_out_of_float16_range(self):
+        """Test that the tensor summary is not cast to float16 when a finite value would overflow."""
+        tensor = np.array([[1.0, -7e4], [np.nan, np.inf]], dtype=np.float32)
+        compressed = _compress_summary_value('tensor', tensor, {'quantize': True})
+        assert compressed.dtype == np.float32
+        assert compressed[0, 1] == -7e4
+        tensor = np.array([[1.0, -6e4], [np.nan, np.inf]], dtype=np.float64)
+        compressed = _compress_summary_value('tensor', tensor, {'quantize': True})
+        assert compressed.dtype == np.float16
+        assert np.isnan(compressed[1, 0]) and np.isposinf(compressed[1, 1])
+        assert np.all(np.isfinite(compressed[0]))
+
     @pytest.mark.parametrize("log_dir", './')
     def test_summary_collector_security_on(self, log_dir):
         """Test the summary collector when set security on."""
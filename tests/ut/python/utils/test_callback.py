@@ -32,6 +32,7 @@ from luojianet_ms.nn.optim import Momentum
 from luojianet_ms.train.callback import ModelCheckpoint, RunContext, LossMonitor, _InternalCallbackParam, \
     _CallbackManager, Callback, CheckpointConfig, _set_cur_net, _checkpoint_cb_for_save_op
 from luojianet_ms.train.callback._checkpoint import _chg_ckpt_file_name_if_same_exist
+from luojianet_ms.train.serialization import load_checkpoint, _load_delta_manifest
 
 
 class Net(nn.Module):
@@ -286,6 +287,70 @@ def test_checkpoint_save_ckpt_with_encryption():
         ckpt_cb2.step_end(run_context)
 
 
+def test_checkpoint_save_ckpt_delta(tmp_path):
+    """
+    Feature: Delta checkpoint of ModelCheckpoint.
+    Description: Save the checkpoints in the delta format while only the weight of dense is updated, and keep one.
+    Expectation: The checkpoints depended on are kept, and the latest one loads the current parameters.
+    """
+    train_config = CheckpointConfig(save_checkpoint_steps=1, keep_checkpoint_max=1, delta_save=True,
+                                    delta_compact_interval=3)
+    with pytest.raises(ValueError):
+        CheckpointConfig(delta_save=True, enc_key=secrets.token_bytes(16))
+    ckpt_cb = ModelCheckpoint(prefix="delta", directory=str(tmp_path), config=train_config)
+    net = nn.Dense(16, 4)
+    cb_params = _InternalCallbackParam()
+    cb_params.train_network = net
+    cb_params.epoch_num = 1
+    cb_params.cur_epoch_num = 1
+    cb_params.batch_num = 10
+    run_context = RunContext(cb_params)
+    ckpt_cb.begin(run_context)
+    for step in range(1, 5):
+        net.weight.set_data(Tensor(np.full((4, 16), step, np.float32)))
+        cb_params.cur_step_num = step
+        ckpt_cb.step_end(run_context)
+
+    # the second one is removed, the third one depends on the bias in the first one, the fourth one is full
+    files = sorted(f for f in os.listdir(str(tmp_path)) if f.endswith(".ckpt"))
+    assert files == ["delta-1_1.ckpt", "delta-1_3.ckpt", "delta-1_4.ckpt"]
+    param_dict = load_checkpoint(os.path.join(str(tmp_path), "delta-1_3.ckpt"))
+    assert np.all(param_dict["weight"].asnumpy() == 3)
+    assert np.array_equal(param_dict["bias"].asnumpy(), net.bias.asnumpy())
+
+
+def test_checkpoint_save_ckpt_delta_async(tmp_path):
+    """
+    Feature: Asynchronous delta checkpoint of ModelCheckpoint.
+    Description: Save the last checkpoint while the previous one may still be written by the asynchronous thread.
+    Expectation: The last checkpoint takes the previous one as its base instead of saving all the parameters.
+    """
+    train_config = CheckpointConfig(save_checkpoint_steps=1, keep_checkpoint_max=5, async_save=True,
+                                    delta_save=True, delta_compact_interval=3)
+    ckpt_cb = ModelCheckpoint(prefix="delta", directory=str(tmp_path), config=train_config)
+    net = nn.Dense(16, 4)
+    cb_params = _InternalCallbackParam()
+    cb_params.train_network = net
+    cb_params.epoch_num = 1
+    cb_params.cur_epoch_num = 1
+    cb_params.batch_num = 10
+    run_context = RunContext(cb_params)
+    ckpt_cb.begin(run_context)
+    net.weight.set_data(Tensor(np.full((4, 16), 1, np.float32)))
+    cb_params.cur_step_num = 1
+    ckpt_cb.step_end(run_context)
+    # the end doesn't wait for the saving thread of the first step before choosing the base
+    net.weight.set_data(Tensor(np.full((4, 16), 2, np.float32)))
+    cb_params.cur_step_num = 2
+    ckpt_cb.end(run_context)
+
+    manifest = _load_delta_manifest(os.path.join(str(tmp_path), "delta-1_2.ckpt"))
+    assert manifest["base"] == "delta-1_1.ckpt"
+    assert manifest["tensors"]["bias"]["file"] == "delta-1_1.ckpt"
+    param_dict = load_checkpoint(os.path.join(str(tmp_path), "delta-1_2.ckpt"))
+    assert np.all(param_dict["weight"].asnumpy() == 2)
+
+
 def test_CallbackManager():
     """TestCallbackManager."""
     ck_obj = ModelCheckpoint()
@@ -34,7 +34,7 @@ from luojianet_ms.nn.optim.momentum import Momentum
 from luojianet_ms.ops import operations as P
 from luojianet_ms.train.callback import _CheckpointManager
 from luojianet_ms.train.serialization import save_checkpoint, load_checkpoint, load_param_into_net, \
-     export, _save_graph, load
+     export, _save_graph, load, convert_checkpoint
 from tests.security_utils import security_off_wrap
 from ..ut_filter import non_graph_engine
 
@@ -356,6 +356,87 @@ def test_save_and_load_checkpoint_for_network_with_encryption():
         os.remove(ckpt_path)
 
 
+def test_save_and_load_native_checkpoint():
+    """
+    Feature: Native checkpoint format.
+    Description: Save a list with scalar, empty and int tensors in the native format, and load it with filter.
+    Expectation: The loaded parameters are the same as the saved tensors, and the filtered one is not loaded.
+    """
+    weight = np.random.randn(12, 1024, 3).astype(np.float32)
+    step = np.array([1, 2, 3, 4, 5]).astype(np.int64)
+    parameter_list = [{"name": "weight", "data": Tensor(weight)},
+                      {"name": "step", "data": Tensor(step)},
+                      {"name": "empty", "data": Tensor(np.zeros([0, 3]).astype(np.float16))},
+                      {"name": "filter.bias", "data": Tensor(np.ones([4]).astype(np.float32))}]
+    ckpt_path = os.path.join(_cur_dir, "./native_parameters.ckpt")
+    save_checkpoint(parameter_list, ckpt_path, append_dict={"lr": 0.01, "epoch": 20}, ckpt_format="native")
+    par_dict = load_checkpoint(ckpt_path, filter_prefix="filter")
+
+    assert len(par_dict) == 5
+    assert "filter.bias" not in par_dict
+    assert np.array_equal(par_dict["weight"].data.asnumpy(), weight)
+    assert np.array_equal(par_dict["step"].data.asnumpy(), step)
+    assert par_dict["step"].data.dtype == mstype.int64
+    assert par_dict["empty"].data.shape == (0, 3)
+    assert par_dict["lr"].data.shape == ()
+    assert np.allclose(par_dict["lr"].data.asnumpy(), 0.01)
+    assert int(par_dict["epoch"].data.asnumpy()) == 20
+
+    with pytest.raises(ValueError):
+        save_checkpoint(parameter_list, ckpt_path, enc_key=secrets.token_bytes(16), ckpt_format="native")
+    os.chmod(ckpt_path, stat.S_IWRITE)
+    os.remove(ckpt_path)
+
+
+def test_save_and_load_native_checkpoint_with_empty_tail():
+    """
+    Feature: Native checkpoint format.
+    Description: Save the native checkpoint whose last tensor is empty, and the one whose tensors are all empty.
+    Expectation: Both of the checkpoint files are loaded, and the empty payloads don't exceed the file size.
+    """
+    empty_tail = [{"name": "bias", "data": Tensor(np.ones([5]).astype(np.float32))},
+                  {"name": "empty", "data": Tensor(np.zeros([0, 3]).astype(np.float32))}]
+    all_empty = [{"name": "empty1", "data": Tensor(np.zeros([0]).astype(np.float32))},
+                 {"name": "empty2", "data": Tensor(np.zeros([2, 0]).astype(np.int32))}]
+    ckpt_path = os.path.join(_cur_dir, "./native_empty_parameters.ckpt")
+    for parameter_list in (empty_tail, all_empty):
+        save_checkpoint(parameter_list, ckpt_path, ckpt_format="native")
+        par_dict = load_checkpoint(ckpt_path)
+        assert par_dict.keys() == {param["name"] for param in parameter_list}
+        for param in parameter_list:
+            assert par_dict[param["name"]].data.shape == param["data"].shape
+            assert np.array_equal(par_dict[param["name"]].data.asnumpy(), param["data"].asnumpy())
+        os.chmod(ckpt_path, stat.S_IWRITE)
+        os.remove(ckpt_path)
+
+
+def test_convert_checkpoint_for_network():
+    """
+    Feature: Conversion between the protobuf and the native checkpoint formats.
+    Description: Convert the protobuf checkpoint of network to native and back, and load all of them.
+    Expectation: The parameters loaded from all the checkpoint files are the same.
+    """
+    net = Net()
+    proto_path = "./convert_proto.ckpt"
+    native_path = "./convert_native.ckpt"
+    back_path = "./convert_back.ckpt"
+    save_checkpoint(net, proto_path)
+    convert_checkpoint(proto_path, native_path)
+    convert_checkpoint(native_path, back_path, dst_format="protobuf")
+
+    expect = load_checkpoint(proto_path)
+    for path in (native_path, back_path):
+        par_dict = load_checkpoint(path)
+        assert par_dict.keys() == expect.keys()
+        for name, param in par_dict.items():
+            assert param.data.dtype == expect[name].data.dtype
+            assert np.array_equal(param.data.asnumpy(), expect[name].data.asnumpy())
+    load_param_into_net(net, load_checkpoint(native_path))
+    for path in (proto_path, native_path, back_path):
+        os.chmod(path, stat.S_IWRITE)
+        os.remove(path)
+
+
 class MYNET(nn.Module):
     """ NET definition """
 